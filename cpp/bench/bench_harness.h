@@ -0,0 +1,47 @@
+#pragma once
+
+// Minimal microbenchmark harness: no external dependencies.
+//
+// A benchmark is a function taking the iteration count. The harness grows
+// the count until one run takes at least the minimum time, repeats the
+// measurement, and reports the fastest ns/op (least disturbed by the OS).
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+struct Benchmark {
+    std::string name;
+    std::function<void(uint64_t iterations)> body;
+};
+
+std::vector<Benchmark>& Registry();
+
+struct Registrar {
+    Registrar(const char* name, std::function<void(uint64_t)> body) {
+        Registry().push_back({name, std::move(body)});
+    }
+};
+
+// Keeps the compiler from discarding a computed value.
+template <typename T>
+inline void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    const volatile char* sink = reinterpret_cast<const volatile char*>(&value);
+    (void)*sink;
+#endif
+}
+
+}  // namespace bench
+
+#define BENCH_CONCAT_INNER(a, b) a##b
+#define BENCH_CONCAT(a, b) BENCH_CONCAT_INNER(a, b)
+
+// BENCHMARK("name", [](uint64_t n) { for (uint64_t i = 0; i < n; ++i) { ... } });
+#define BENCHMARK(name, ...) \
+    static ::bench::Registrar BENCH_CONCAT(g_benchRegistrar_, __LINE__)(name, __VA_ARGS__)
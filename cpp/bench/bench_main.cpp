@@ -0,0 +1,110 @@
+// Benchmark runner.
+//
+// Usage: cameraunlock_bench [--filter substring] [--json path] [--min-time-ms N]
+// Prints ns/op per benchmark; --json writes the same results for
+// regression tracking between releases.
+
+#include "bench_harness.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace bench {
+
+std::vector<Benchmark>& Registry() {
+    static std::vector<Benchmark> registry;
+    return registry;
+}
+
+}  // namespace bench
+
+namespace {
+
+struct Result {
+    std::string name;
+    uint64_t iterations;
+    double nsPerOp;
+};
+
+double TimeRun(const bench::Benchmark& b, uint64_t iterations) {
+    auto start = std::chrono::steady_clock::now();
+    b.body(iterations);
+    auto end = std::chrono::steady_clock::now();
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+}
+
+Result Run(const bench::Benchmark& b, double minTimeNs) {
+    // Grow the batch until it is long enough to time reliably
+    uint64_t iterations = 1;
+    double elapsed = TimeRun(b, iterations);
+    while (elapsed < minTimeNs && iterations < (1ull << 40)) {
+        double scale = elapsed > 0.0 ? minTimeNs * 1.2 / elapsed : 10.0;
+        if (scale > 10.0) scale = 10.0;
+        if (scale < 1.5) scale = 1.5;
+        iterations = static_cast<uint64_t>(static_cast<double>(iterations) * scale) + 1;
+        elapsed = TimeRun(b, iterations);
+    }
+
+    // Best of several repetitions
+    double best = elapsed;
+    for (int rep = 0; rep < 4; ++rep) {
+        double t = TimeRun(b, iterations);
+        if (t < best) best = t;
+    }
+    return {b.name, iterations, best / static_cast<double>(iterations)};
+}
+
+void WriteJson(const char* path, const std::vector<Result>& results) {
+    FILE* f = std::fopen(path, "w");
+    if (!f) {
+        std::fprintf(stderr, "cannot write %s\n", path);
+        return;
+    }
+    std::fprintf(f, "{\n  \"benchmarks\": [\n");
+    for (size_t i = 0; i < results.size(); ++i) {
+        std::fprintf(f, "    {\"name\": \"%s\", \"iterations\": %llu, \"ns_per_op\": %.3f}%s\n",
+                     results[i].name.c_str(), static_cast<unsigned long long>(results[i].iterations),
+                     results[i].nsPerOp, i + 1 < results.size() ? "," : "");
+    }
+    std::fprintf(f, "  ]\n}\n");
+    std::fclose(f);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const char* filter = nullptr;
+    const char* jsonPath = nullptr;
+    double minTimeMs = 50.0;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            jsonPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--min-time-ms") == 0 && i + 1 < argc) {
+            minTimeMs = std::atof(argv[++i]);
+        } else {
+            std::fprintf(stderr, "usage: %s [--filter substring] [--json path] [--min-time-ms N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    std::vector<Result> results;
+    std::printf("%-44s %14s %12s\n", "benchmark", "iterations", "ns/op");
+    for (const auto& b : bench::Registry()) {
+        if (filter && b.name.find(filter) == std::string::npos) continue;
+        Result r = Run(b, minTimeMs * 1e6);
+        std::printf("%-44s %14llu %12.2f\n", r.name.c_str(),
+                    static_cast<unsigned long long>(r.iterations), r.nsPerOp);
+        results.push_back(r);
+    }
+
+    if (jsonPath) {
+        WriteJson(jsonPath, results);
+    }
+    return 0;
+}
@@ -0,0 +1,289 @@
+// Hot-path benchmarks for the native core.
+//
+// Inputs vary per iteration so the compiler cannot hoist the work out of
+// the loop; every result goes through DoNotOptimize.
+
+#include "bench_harness.h"
+
+#include "cameraunlock/data/position_data.h"
+#include "cameraunlock/data/tracking_pose.h"
+#include "cameraunlock/discovery/float_classifier.h"
+#include "cameraunlock/hooks/detour_stats.h"
+#include "cameraunlock/math/quat4.h"
+#include "cameraunlock/memory/pattern_scanner.h"
+#include "cameraunlock/processing/pose_interpolator.h"
+#include "cameraunlock/processing/position_interpolator.h"
+#include "cameraunlock/processing/position_processor.h"
+#include "cameraunlock/processing/sample_rate_processor.h"
+#include "cameraunlock/processing/tracking_processor.h"
+#include "cameraunlock/protocol/opentrack_packet.h"
+#include "cameraunlock/rendering/crosshair_projection.h"
+#include "cameraunlock/rendering/gui_marker_compensation.h"
+
+#include <cstring>
+#include <vector>
+
+namespace {
+
+using cameraunlock::math::Quat4;
+using cameraunlock::math::Vec3;
+
+// Cheap per-iteration variation in roughly [-30, 30] degrees
+inline float Wobble(uint64_t i) {
+    return static_cast<float>(static_cast<int>(i % 61) - 30);
+}
+
+void BuildPacket(uint8_t* out, double x, double y, double z, double yaw, double pitch, double roll) {
+    double values[6] = {x, y, z, yaw, pitch, roll};
+    std::memcpy(out, values, sizeof(values));
+}
+
+BENCHMARK("OpenTrackPacket::TryParseAll", [](uint64_t n) {
+    uint8_t packet[48];
+    BuildPacket(packet, 1.0, 2.0, 3.0, 10.0, -5.0, 2.0);
+    cameraunlock::TrackingPose pose;
+    cameraunlock::PositionData position;
+    for (uint64_t i = 0; i < n; ++i) {
+        packet[0] = static_cast<uint8_t>(i);
+        bool ok = cameraunlock::OpenTrackPacket::TryParseAll(packet, sizeof(packet), pose, position);
+        bench::DoNotOptimize(ok);
+        bench::DoNotOptimize(pose);
+    }
+});
+
+BENCHMARK("TrackingProcessor::Process", [](uint64_t n) {
+    cameraunlock::TrackingProcessor processor;
+    processor.SetSmoothing(0.3f);
+    for (uint64_t i = 0; i < n; ++i) {
+        auto pose = processor.Process(Wobble(i), Wobble(i + 7) * 0.5f, Wobble(i + 13) * 0.2f, 0.0069f);
+        bench::DoNotOptimize(pose);
+    }
+});
+
+BENCHMARK("TrackingProcessor::ProcessQuat", [](uint64_t n) {
+    cameraunlock::TrackingProcessor processor;
+    processor.SetSmoothing(0.3f);
+    for (uint64_t i = 0; i < n; ++i) {
+        Quat4 q = processor.ProcessQuat(Wobble(i), Wobble(i + 7) * 0.5f, Wobble(i + 13) * 0.2f, 0.0069f);
+        bench::DoNotOptimize(q);
+    }
+});
+
+BENCHMARK("Quat4::FromYawPitchRoll", [](uint64_t n) {
+    for (uint64_t i = 0; i < n; ++i) {
+        Quat4 q = Quat4::FromYawPitchRoll(Wobble(i), Wobble(i + 7), Wobble(i + 13));
+        bench::DoNotOptimize(q);
+    }
+});
+
+BENCHMARK("Quat4::Slerp", [](uint64_t n) {
+    Quat4 a = Quat4::FromYawPitchRoll(10.0f, 5.0f, 0.0f);
+    Quat4 b = Quat4::FromYawPitchRoll(40.0f, -15.0f, 5.0f);
+    for (uint64_t i = 0; i < n; ++i) {
+        float t = static_cast<float>(i % 100) * 0.01f;
+        Quat4 q = Quat4::Slerp(a, b, t);
+        bench::DoNotOptimize(q);
+    }
+});
+
+BENCHMARK("Quat4::Rotate", [](uint64_t n) {
+    Quat4 q = Quat4::FromYawPitchRoll(25.0f, -10.0f, 5.0f);
+    for (uint64_t i = 0; i < n; ++i) {
+        Vec3 v = q.Rotate(Vec3(Wobble(i), 1.0f, 2.0f));
+        bench::DoNotOptimize(v);
+    }
+});
+
+BENCHMARK("PoseInterpolator::Update", [](uint64_t n) {
+    cameraunlock::PoseInterpolator interp;
+    for (uint64_t i = 0; i < n; ++i) {
+        bool isNew = (i % 4) == 0;  // 60 Hz samples at 240 Hz frames
+        auto pose = interp.Update(Wobble(i / 4), 0.0f, 0.0f, isNew, 1.0f / 240.0f);
+        bench::DoNotOptimize(pose);
+    }
+});
+
+BENCHMARK("PoseInterpolator::UpdateTimestamped", [](uint64_t n) {
+    cameraunlock::PoseInterpolator interp;
+    for (uint64_t i = 0; i < n; ++i) {
+        int64_t renderUs = static_cast<int64_t>(i) * 4167 + 1;
+        int64_t sampleUs = (renderUs / 16667) * 16667 + 1;
+        auto pose = interp.UpdateTimestamped(Wobble(i / 4), 0.0f, 0.0f, sampleUs, renderUs);
+        bench::DoNotOptimize(pose);
+    }
+});
+
+BENCHMARK("SampleRateProcessor::Evaluate", [](uint64_t n) {
+    cameraunlock::SampleRateProcessor stage;
+    // Two processed samples 4 ms apart, as at a 250 Hz tracker
+    for (uint64_t s = 1; s <= 2; ++s) {
+        cameraunlock::TrackingSample sample;
+        sample.yaw = 5.0f * static_cast<float>(s);
+        sample.sequence = s;
+        sample.timestamp_us = static_cast<int64_t>(s) * 4000;
+        stage.OnSample(sample);
+    }
+    for (uint64_t i = 0; i < n; ++i) {
+        cameraunlock::math::Quat4 rotation;
+        stage.Evaluate(4000 + static_cast<int64_t>(i % 4000), rotation);
+        bench::DoNotOptimize(rotation);
+    }
+});
+
+BENCHMARK("PositionInterpolator::Update", [](uint64_t n) {
+    cameraunlock::PositionInterpolator interp;
+    for (uint64_t i = 0; i < n; ++i) {
+        cameraunlock::PositionData raw(Wobble(i / 4) * 0.01f, 0.0f, 0.0f, static_cast<int64_t>(i / 4) + 1);
+        auto pos = interp.Update(raw, 1.0f / 240.0f);
+        bench::DoNotOptimize(pos);
+    }
+});
+
+BENCHMARK("PositionProcessor::Process", [](uint64_t n) {
+    cameraunlock::PositionProcessor processor;
+    Quat4 q = Quat4::FromYawPitchRoll(20.0f, -5.0f, 0.0f);
+    for (uint64_t i = 0; i < n; ++i) {
+        cameraunlock::PositionData raw(Wobble(i) * 0.01f, 0.02f, -0.03f, static_cast<int64_t>(i) + 1);
+        Vec3 v = processor.Process(raw, q, 0.0069f);
+        bench::DoNotOptimize(v);
+    }
+});
+
+BENCHMARK("ProjectCrosshair", [](uint64_t n) {
+    cameraunlock::rendering::CrosshairProjectionParams params;
+    for (uint64_t i = 0; i < n; ++i) {
+        params.yawOffset = Wobble(i);
+        params.pitchOffset = Wobble(i + 7) * 0.5f;
+        params.rollOffset = Wobble(i + 13) * 0.2f;
+        auto pos = cameraunlock::rendering::ProjectCrosshair(params);
+        bench::DoNotOptimize(pos);
+    }
+});
+
+BENCHMARK("FrameProjectionContext + 16 points", [](uint64_t n) {
+    cameraunlock::rendering::CrosshairProjectionParams params;
+    for (uint64_t i = 0; i < n; ++i) {
+        params.yawOffset = Wobble(i);
+        params.pitchOffset = Wobble(i + 7) * 0.5f;
+        params.rollOffset = Wobble(i + 13) * 0.2f;
+        const auto ctx = cameraunlock::rendering::BuildFrameProjectionContext(params);
+        for (int p = 0; p < 16; ++p) {
+            auto pos = cameraunlock::rendering::ProjectNativeScreenPoint(ctx, 100.0f * p, 60.0f * p);
+            bench::DoNotOptimize(pos);
+        }
+    }
+});
+
+BENCHMARK("ComputeGuiMarkerCompensation", [](uint64_t n) {
+    cameraunlock::rendering::GuiMarkerInput in;
+    in.gxNative = 120.0f;
+    in.gyNative = -40.0f;
+    for (uint64_t i = 0; i < n; ++i) {
+        in.yawDeg = Wobble(i);
+        in.pitchDeg = Wobble(i + 7) * 0.5f;
+        in.rollDeg = Wobble(i + 13) * 0.2f;
+        auto out = cameraunlock::rendering::ComputeGuiMarkerCompensation(in);
+        bench::DoNotOptimize(out);
+    }
+});
+
+BENCHMARK("ClassifyMemoryRegion (512 B)", [](uint64_t n) {
+    // Camera-like object: position, quaternion, FOV, then noise
+    alignas(16) float region[128];
+    for (int i = 0; i < 128; ++i) region[i] = static_cast<float>(i * 37 % 1000) * 0.73f;
+    float layout[] = {12.5f, 3.0f, -40.25f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 75.0f};
+    std::memcpy(region, layout, sizeof(layout));
+    for (uint64_t i = 0; i < n; ++i) {
+        region[0] = Wobble(i);
+        auto report = cameraunlock::discovery::ClassifyMemoryRegion(region, sizeof(region));
+        bench::DoNotOptimize(report.group_count);
+    }
+});
+
+int BenchDetour(int x) {
+    return x + 1;
+}
+
+// Wrapper overhead alone: the detour itself is a single add
+void BenchInstrumentedDetour(uint64_t n, uint32_t interval) {
+    using Detour = cameraunlock::hooks::InstrumentedDetour<&BenchDetour>;
+    const uint32_t previous = cameraunlock::hooks::GetDetourSampleInterval();
+    cameraunlock::hooks::SetDetourSampleInterval(interval);
+    for (uint64_t i = 0; i < n; ++i) {
+        bench::DoNotOptimize(Detour::Function(static_cast<int>(i)));
+    }
+    cameraunlock::hooks::SetDetourSampleInterval(previous);
+}
+
+BENCHMARK("InstrumentedDetour (1 in 16 timed)", [](uint64_t n) { BenchInstrumentedDetour(n, 16); });
+
+BENCHMARK("InstrumentedDetour (every call timed)", [](uint64_t n) { BenchInstrumentedDetour(n, 1); });
+
+// Code-like filler so anchor bytes show up as frequent near-misses
+const std::vector<uint8_t>& ScanImage() {
+    static const std::vector<uint8_t> image = [] {
+        static const uint8_t kCommon[] = {0x00, 0x48, 0x8B, 0x89, 0xCC, 0x05, 0x0D, 0xE8};
+        std::vector<uint8_t> data(16u << 20);
+        uint32_t state = 1;
+        for (auto& b : data) {
+            state = state * 1664525u + 1013904223u;
+            b = kCommon[(state >> 24) % sizeof(kCommon)];
+        }
+        return data;
+    }();
+    return image;
+}
+
+const char* const kSignatures[] = {
+    "48 8B 05 ?? ?? ?? ?? 48 85 C0 74 1F", "40 53 48 83 EC 20 8B D9", "F3 0F 10 05 ?? ?? ?? ?? F3 0F 59",
+    "E8 ?? ?? ?? ?? 84 C0 75 0A", "48 89 5C 24 08 57 48 83 EC 30", "0F 28 C1 F3 0F 5C 05",
+    "48 8D 0D ?? ?? ?? ?? E8 ?? ?? ?? ?? 90", "C7 43 ?? 00 00 80 3F", "66 0F 6E C0 0F 5B C0",
+    "41 B8 10 00 00 00 48 8B D3", "FF 15 ?? ?? ?? ?? 85 C0 78", "F3 0F 11 4B 2C",
+    "48 63 41 ?? 4C 8D 05", "0F B6 81 ?? ?? ?? ?? C3", "89 87 ?? ?? ?? ?? EB 07",
+    "83 F8 FF 74 ?? 48 8B 4F", "B9 01 00 00 00 E8", "44 8B 81 ?? ?? ?? ?? 45 85 C0",
+    "0F 29 74 24 20 0F 28 F0", "48 3B C8 0F 84 ?? ?? ?? ?? 8B 51",
+};
+
+BENCHMARK("ScanPatternInRange (16 MB miss)", [](uint64_t n) {
+    const auto& image = ScanImage();
+    const auto base = reinterpret_cast<uintptr_t>(image.data());
+    for (uint64_t i = 0; i < n; ++i) {
+        void* hit = cameraunlock::memory::ScanPatternInRange(base, image.size(), kSignatures[0]);
+        bench::DoNotOptimize(hit);
+    }
+});
+
+BENCHMARK("ScanCompiledParallel (16 MB miss)", [](uint64_t n) {
+    const auto& image = ScanImage();
+    const auto base = reinterpret_cast<uintptr_t>(image.data());
+    cameraunlock::memory::CompiledPattern pattern;
+    cameraunlock::memory::CompilePattern(kSignatures[0], pattern);
+    for (uint64_t i = 0; i < n; ++i) {
+        void* hit = cameraunlock::memory::ScanCompiledParallel(base, image.size(), pattern);
+        bench::DoNotOptimize(hit);
+    }
+});
+
+BENCHMARK("ScanPatternInRange x20 (16 MB)", [](uint64_t n) {
+    const auto& image = ScanImage();
+    const auto base = reinterpret_cast<uintptr_t>(image.data());
+    for (uint64_t i = 0; i < n; ++i) {
+        for (const char* sig : kSignatures) {
+            void* hit = cameraunlock::memory::ScanPatternInRange(base, image.size(), sig);
+            bench::DoNotOptimize(hit);
+        }
+    }
+});
+
+BENCHMARK("PatternBatch x20 (16 MB)", [](uint64_t n) {
+    const auto& image = ScanImage();
+    const auto base = reinterpret_cast<uintptr_t>(image.data());
+    cameraunlock::memory::PatternBatch batch;
+    for (const char* sig : kSignatures) batch.Add(sig);
+    for (uint64_t i = 0; i < n; ++i) {
+        batch.ScanRange(base, image.size());
+        bench::DoNotOptimize(batch.GetFirstMatch(0));
+    }
+});
+
+}  // namespace
@@ -0,0 +1,332 @@
+// End-to-end receive latency over loopback.
+//
+// Usage: cameraunlock_latency_bench [--backend thread|runtime|shared|polling|all]
+//            [--rates 60,250,1000] [--fps N] [--seconds N] [--port N] [--json path]
+//
+// An embedded sender plays OpenTrack at each rate, encoding a sequence
+// number in yaw/pitch and remembering when each packet left sendto. A
+// simulated frame loop reads the receiver the way a game would (Poll()
+// first for the polling receiver) and, for every packet it sees for the
+// first time, records:
+//   arrival  - sendto to the receiver's arrival timestamp (kernel + thread)
+//   visible  - sendto to the frame that first saw it (adds frame sampling)
+// A frame counts as a stale read when a newer packet had been sent at
+// least kStaleGraceUs before it and the frame still saw an older one.
+//
+// Backends are the receive loops in this tree: the UdpReceiver thread, the
+// UdpReceiver on a shared Runtime, the SharedUdpReceiver hub, and
+// PollingUdpReceiver polled per frame.
+
+#include "cameraunlock/protocol/polling_udp_receiver.h"
+#include "cameraunlock/protocol/shared_udp_receiver.h"
+#include "cameraunlock/protocol/udp_receiver.h"
+#include "cameraunlock/protocol/udp_socket.h"
+#include "cameraunlock/runtime/runtime.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t kSendTableSize = 1 << 16;
+constexpr int64_t kStaleGraceUs = 1000;
+constexpr uint16_t kDefaultPort = 14242;
+
+int64_t NowUs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now().time_since_epoch()).count();
+}
+
+// Send times by sequence, written by the sender and read by the frame loop
+struct SendLog {
+    std::atomic<int64_t> sentUs[kSendTableSize] = {};
+    std::atomic<uint32_t> latest{0};
+    std::atomic<int64_t> latestUs{0};
+};
+
+// 1-based sequence split across yaw and pitch so both stay exact as floats
+void EncodeSequence(uint32_t seq, double& yaw, double& pitch) {
+    yaw = static_cast<double>(seq & 0xFFFF);
+    pitch = static_cast<double>(seq >> 16);
+}
+
+uint32_t DecodeSequence(float yaw, float pitch) {
+    return static_cast<uint32_t>(yaw) | (static_cast<uint32_t>(pitch) << 16);
+}
+
+void SenderThread(uint16_t port, int rateHz, int seconds, SendLog& log, std::atomic<bool>& done) {
+    cameraunlock::UdpSocket socket;
+    if (!socket.Open(0)) {
+        std::fprintf(stderr, "sender: cannot open socket\n");
+        done.store(true);
+        return;
+    }
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    const auto period = std::chrono::nanoseconds(1000000000LL / rateHz);
+    const auto end = Clock::now() + std::chrono::seconds(seconds);
+    auto next = Clock::now();
+    for (uint32_t seq = 1; Clock::now() < end; ++seq) {
+        std::this_thread::sleep_until(next);
+        next += period;
+
+        double values[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+        EncodeSequence(seq, values[3], values[4]);
+        const int64_t sent = NowUs();
+        log.sentUs[seq % kSendTableSize].store(sent, std::memory_order_relaxed);
+        log.latestUs.store(sent, std::memory_order_relaxed);
+        log.latest.store(seq, std::memory_order_release);
+        sendto(socket.GetHandle(), reinterpret_cast<const char*>(values), sizeof(values), 0,
+               reinterpret_cast<const sockaddr*>(&addr), sizeof(addr));
+    }
+    done.store(true);
+}
+
+struct Distribution {
+    double p50 = 0, p90 = 0, p99 = 0, p999 = 0, max = 0, mean = 0;
+};
+
+Distribution Summarize(std::vector<double>& values) {
+    Distribution d;
+    if (values.empty()) return d;
+    std::sort(values.begin(), values.end());
+    auto at = [&](double q) { return values[std::min(values.size() - 1, static_cast<size_t>(q * values.size()))]; };
+    d.p50 = at(0.50);
+    d.p90 = at(0.90);
+    d.p99 = at(0.99);
+    d.p999 = at(0.999);
+    d.max = values.back();
+    double sum = 0;
+    for (double v : values) sum += v;
+    d.mean = sum / static_cast<double>(values.size());
+    return d;
+}
+
+struct Result {
+    std::string backend;
+    int rateHz = 0;
+    uint64_t sent = 0;
+    uint64_t seen = 0;
+    uint64_t frames = 0;
+    uint64_t staleFrames = 0;
+    Distribution arrivalUs;
+    Distribution visibleUs;
+};
+
+// Source adapters: Read() is what the frame does each tick
+struct Source {
+    virtual ~Source() = default;
+    virtual bool Start(uint16_t port) = 0;
+    virtual bool Read(cameraunlock::TrackingSample& sample) = 0;
+};
+
+struct ThreadSource : Source {
+    cameraunlock::UdpReceiver receiver;
+    bool Start(uint16_t port) override { return receiver.Start(port); }
+    bool Read(cameraunlock::TrackingSample& sample) override { return receiver.TryGetSample(sample); }
+};
+
+struct RuntimeSource : Source {
+    cameraunlock::Runtime runtime;
+    cameraunlock::UdpReceiver receiver;
+    bool Start(uint16_t port) override { return runtime.Start() && receiver.Start(runtime, port); }
+    bool Read(cameraunlock::TrackingSample& sample) override { return receiver.TryGetSample(sample); }
+    ~RuntimeSource() override {
+        receiver.Stop();
+        runtime.Stop();
+    }
+};
+
+struct SharedSource : Source {
+    cameraunlock::SharedUdpReceiver receiver;
+    bool Start(uint16_t port) override { return receiver.Start(port); }
+    bool Read(cameraunlock::TrackingSample& sample) override { return receiver.TryGetSample(sample); }
+};
+
+struct PollingSource : Source {
+    cameraunlock::PollingUdpReceiver receiver;
+    bool Start(uint16_t port) override { return receiver.Initialize(port); }
+    bool Read(cameraunlock::TrackingSample& sample) override {
+        receiver.Poll();
+        return receiver.TryGetSample(sample);
+    }
+};
+
+Source* MakeSource(const std::string& backend) {
+    if (backend == "thread") return new ThreadSource;
+    if (backend == "runtime") return new RuntimeSource;
+    if (backend == "shared") return new SharedSource;
+    if (backend == "polling") return new PollingSource;
+    return nullptr;
+}
+
+bool RunOne(const std::string& backend, int rateHz, int fps, int seconds, uint16_t port, Result& result) {
+    Source* source = MakeSource(backend);
+    if (!source || !source->Start(port)) {
+        std::fprintf(stderr, "%s: cannot bind port %u\n", backend.c_str(), port);
+        delete source;
+        return false;
+    }
+
+    auto* log = new SendLog;
+    std::atomic<bool> done{false};
+    std::thread sender(SenderThread, port, rateHz, seconds, std::ref(*log), std::ref(done));
+
+    std::vector<double> arrival;
+    std::vector<double> visible;
+    uint32_t lastSeen = 0;
+    const auto framePeriod = std::chrono::nanoseconds(1000000000LL / fps);
+    auto nextFrame = Clock::now();
+    while (!done.load()) {
+        std::this_thread::sleep_until(nextFrame);
+        nextFrame += framePeriod;
+
+        // Newest packet that had time to arrive, from before the read
+        const uint32_t latest = log->latest.load(std::memory_order_acquire);
+        const int64_t latestUs = log->latestUs.load(std::memory_order_relaxed);
+        cameraunlock::TrackingSample sample;
+        const bool have = source->Read(sample);
+        const int64_t now = NowUs();
+        ++result.frames;
+
+        const uint32_t seq = have ? DecodeSequence(sample.yaw, sample.pitch) : 0;
+        if (latest > seq && now - latestUs >= kStaleGraceUs) {
+            ++result.staleFrames;
+        }
+        if (!have || seq == 0 || seq <= lastSeen || seq > latest) continue;
+
+        lastSeen = seq;
+        ++result.seen;
+        const int64_t sent = log->sentUs[seq % kSendTableSize].load(std::memory_order_relaxed);
+        arrival.push_back(static_cast<double>(sample.timestamp_us - sent));
+        visible.push_back(static_cast<double>(now - sent));
+    }
+    sender.join();
+
+    result.backend = backend;
+    result.rateHz = rateHz;
+    result.sent = log->latest.load();
+    result.arrivalUs = Summarize(arrival);
+    result.visibleUs = Summarize(visible);
+    delete log;
+    delete source;
+    return true;
+}
+
+std::vector<int> ParseRates(const char* text) {
+    std::vector<int> rates;
+    for (const char* p = text; *p;) {
+        const int rate = std::atoi(p);
+        if (rate > 0) rates.push_back(rate);
+        const char* comma = std::strchr(p, ',');
+        if (!comma) break;
+        p = comma + 1;
+    }
+    return rates;
+}
+
+void WriteJson(const char* path, const std::vector<Result>& results) {
+    FILE* f = std::fopen(path, "w");
+    if (!f) {
+        std::fprintf(stderr, "cannot write %s\n", path);
+        return;
+    }
+    auto dist = [&](const char* name, const Distribution& d, const char* tail) {
+        std::fprintf(f, "\"%s\": {\"p50\": %.1f, \"p90\": %.1f, \"p99\": %.1f, \"p999\": %.1f, \"max\": %.1f, \"mean\": %.1f}%s",
+                     name, d.p50, d.p90, d.p99, d.p999, d.max, d.mean, tail);
+    };
+    std::fprintf(f, "{\n  \"latency_us\": [\n");
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        std::fprintf(f, "    {\"backend\": \"%s\", \"rate_hz\": %d, \"sent\": %llu, \"seen\": %llu, "
+                        "\"frames\": %llu, \"stale_frames\": %llu, ",
+                     r.backend.c_str(), r.rateHz, static_cast<unsigned long long>(r.sent),
+                     static_cast<unsigned long long>(r.seen), static_cast<unsigned long long>(r.frames),
+                     static_cast<unsigned long long>(r.staleFrames));
+        dist("arrival", r.arrivalUs, ", ");
+        dist("visible", r.visibleUs, "");
+        std::fprintf(f, "}%s\n", i + 1 < results.size() ? "," : "");
+    }
+    std::fprintf(f, "  ]\n}\n");
+    std::fclose(f);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::string backend = "all";
+    std::vector<int> rates = {60, 250, 1000};
+    int fps = 144;
+    int seconds = 5;
+    uint16_t port = kDefaultPort;
+    const char* jsonPath = nullptr;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--backend") == 0 && i + 1 < argc) {
+            backend = argv[++i];
+        } else if (std::strcmp(argv[i], "--rates") == 0 && i + 1 < argc) {
+            rates = ParseRates(argv[++i]);
+        } else if (std::strcmp(argv[i], "--fps") == 0 && i + 1 < argc) {
+            fps = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+            seconds = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--port") == 0 && i + 1 < argc) {
+            port = static_cast<uint16_t>(std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            jsonPath = argv[++i];
+        } else {
+            std::fprintf(stderr,
+                         "usage: %s [--backend thread|runtime|shared|polling|all] [--rates 60,250,1000] "
+                         "[--fps N] [--seconds N] [--port N] [--json path]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (rates.empty() || fps <= 0 || seconds <= 0) {
+        std::fprintf(stderr, "rates, fps and seconds must be positive\n");
+        return 2;
+    }
+
+    std::vector<std::string> backends;
+    if (backend == "all") {
+        backends = {"thread", "runtime", "shared", "polling"};
+    } else if (Source* probe = MakeSource(backend)) {
+        delete probe;
+        backends = {backend};
+    } else {
+        std::fprintf(stderr, "unknown backend %s\n", backend.c_str());
+        return 2;
+    }
+
+    std::vector<Result> results;
+    std::printf("%-8s %6s %8s %8s %7s | %-28s | %-28s\n", "backend", "Hz", "sent", "seen", "stale%",
+                "arrival us p50/p99/max", "visible us p50/p99/max");
+    for (const std::string& b : backends) {
+        for (int rate : rates) {
+            Result r;
+            if (!RunOne(b, rate, fps, seconds, port, r)) return 1;
+            const double stale = r.frames ? 100.0 * static_cast<double>(r.staleFrames) / static_cast<double>(r.frames) : 0.0;
+            std::printf("%-8s %6d %8llu %8llu %6.1f%% | %8.0f %8.0f %10.0f | %8.0f %8.0f %10.0f\n",
+                        r.backend.c_str(), r.rateHz, static_cast<unsigned long long>(r.sent),
+                        static_cast<unsigned long long>(r.seen), stale,
+                        r.arrivalUs.p50, r.arrivalUs.p99, r.arrivalUs.max,
+                        r.visibleUs.p50, r.visibleUs.p99, r.visibleUs.max);
+            results.push_back(r);
+        }
+    }
+
+    if (jsonPath) {
+        WriteJson(jsonPath, results);
+    }
+    return 0;
+}
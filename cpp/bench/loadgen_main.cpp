@@ -0,0 +1,220 @@
+// Synthetic OpenTrack load and fault generator for soak tests.
+//
+// Usage: cameraunlock_loadgen [--host 127.0.0.1] [--port 4242]
+//            [--profile soak.ini | phase options] [--capture-in path]
+//            [--capture-out path] [--seed N] [--loop] [--seconds N]
+//            [--report-ms N]
+// Phase options (one phase when no --profile is given):
+//   --duration-ms --rate --senders --jitter-ms --burst-interval-ms
+//   --burst-hold-ms --loss --reorder --reorder-depth --duplicate
+//   --malformed --out-of-range --motion-hz --extended
+//
+// Sends the schedule in real time to host:port, printing a line of totals
+// every --report-ms. With --capture-out the schedule is written as a
+// capture file as fast as possible instead (all senders merged), so the
+// same adversarial stream can be replayed through ReplaySource.
+// --capture-in takes the clean stream from an existing capture. --seconds
+// stops after that much schedule time, for looped or open-ended runs.
+
+#include "cameraunlock/protocol/capture_file.h"
+#include "cameraunlock/protocol/load_generator.h"
+#include "cameraunlock/protocol/udp_receiver.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+namespace {
+
+using cameraunlock::GeneratedDatagram;
+using cameraunlock::LoadCounters;
+using cameraunlock::LoadGenerator;
+using cameraunlock::LoadPhase;
+
+using Clock = std::chrono::steady_clock;
+
+struct DoubleOption {
+    const char* flag;
+    double LoadPhase::*field;
+};
+
+constexpr DoubleOption kDoubleOptions[] = {
+    {"--rate", &LoadPhase::rateHz},
+    {"--jitter-ms", &LoadPhase::jitterMs},
+    {"--burst-interval-ms", &LoadPhase::burstIntervalMs},
+    {"--burst-hold-ms", &LoadPhase::burstHoldMs},
+    {"--loss", &LoadPhase::loss},
+    {"--reorder", &LoadPhase::reorder},
+    {"--duplicate", &LoadPhase::duplicate},
+    {"--malformed", &LoadPhase::malformed},
+    {"--out-of-range", &LoadPhase::outOfRange},
+    {"--motion-hz", &LoadPhase::motionHz},
+};
+
+void PrintCounters(double seconds, const LoadCounters& c, uint64_t sendErrors, int64_t maxLateUs) {
+    std::printf("%8.1fs  emitted %llu  lost %llu  reordered %llu  duplicated %llu  malformed %llu  "
+                "out-of-range %llu  burst-held %llu  send-errors %llu  max-late %lldus\n",
+                seconds, static_cast<unsigned long long>(c.emitted), static_cast<unsigned long long>(c.lost),
+                static_cast<unsigned long long>(c.reordered), static_cast<unsigned long long>(c.duplicated),
+                static_cast<unsigned long long>(c.malformed), static_cast<unsigned long long>(c.outOfRange),
+                static_cast<unsigned long long>(c.burstHeld), static_cast<unsigned long long>(sendErrors),
+                static_cast<long long>(maxLateUs));
+    std::fflush(stdout);
+}
+
+int Usage(const char* argv0) {
+    std::fprintf(stderr,
+                 "usage: %s [--host ip] [--port N] [--profile path] [--capture-in path] "
+                 "[--capture-out path] [--seed N] [--loop] [--seconds N] [--report-ms N] "
+                 "[--duration-ms N] [--rate HZ] [--senders N] [--jitter-ms MS] "
+                 "[--burst-interval-ms MS] [--burst-hold-ms MS] [--loss P] [--reorder P] "
+                 "[--reorder-depth N] [--duplicate P] [--malformed P] [--out-of-range P] "
+                 "[--motion-hz HZ] [--extended]\n", argv0);
+    return 2;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const char* host = "127.0.0.1";
+    uint16_t port = cameraunlock::UdpReceiver::kDefaultPort;
+    const char* profilePath = nullptr;
+    const char* captureIn = nullptr;
+    const char* captureOut = nullptr;
+    const char* seed = nullptr;
+    bool loop = false;
+    double seconds = 0.0;
+    int reportMs = 1000;
+    LoadPhase phase;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        bool matched = false;
+        for (const DoubleOption& option : kDoubleOptions) {
+            if (std::strcmp(arg, option.flag) == 0 && hasValue) {
+                phase.*option.field = std::atof(argv[++i]);
+                matched = true;
+                break;
+            }
+        }
+        if (matched) continue;
+
+        if (std::strcmp(arg, "--host") == 0 && hasValue) {
+            host = argv[++i];
+        } else if (std::strcmp(arg, "--port") == 0 && hasValue) {
+            port = static_cast<uint16_t>(std::atoi(argv[++i]));
+        } else if (std::strcmp(arg, "--profile") == 0 && hasValue) {
+            profilePath = argv[++i];
+        } else if (std::strcmp(arg, "--capture-in") == 0 && hasValue) {
+            captureIn = argv[++i];
+        } else if (std::strcmp(arg, "--capture-out") == 0 && hasValue) {
+            captureOut = argv[++i];
+        } else if (std::strcmp(arg, "--seed") == 0 && hasValue) {
+            seed = argv[++i];
+        } else if (std::strcmp(arg, "--loop") == 0) {
+            loop = true;
+        } else if (std::strcmp(arg, "--seconds") == 0 && hasValue) {
+            seconds = std::atof(argv[++i]);
+        } else if (std::strcmp(arg, "--report-ms") == 0 && hasValue) {
+            reportMs = std::atoi(argv[++i]);
+        } else if (std::strcmp(arg, "--duration-ms") == 0 && hasValue) {
+            phase.durationMs = std::atoll(argv[++i]);
+        } else if (std::strcmp(arg, "--senders") == 0 && hasValue) {
+            phase.senders = std::atoi(argv[++i]);
+        } else if (std::strcmp(arg, "--reorder-depth") == 0 && hasValue) {
+            phase.reorderDepth = std::atoi(argv[++i]);
+        } else if (std::strcmp(arg, "--extended") == 0) {
+            phase.extended = true;
+        } else {
+            return Usage(argv[0]);
+        }
+    }
+
+    LoadGenerator generator;
+    if (profilePath) {
+        if (!generator.LoadProfile(profilePath)) {
+            std::fprintf(stderr, "cannot load profile %s\n", profilePath);
+            return 1;
+        }
+    } else {
+        generator.AddPhase(phase);
+    }
+    // Command-line settings override the profile's [generator] section
+    if (seed) generator.SetSeed(std::strtoull(seed, nullptr, 0));
+    if (loop) generator.SetLoop(true);
+    loop = loop || generator.IsLooping();
+    if (captureIn && !generator.UseCapture(captureIn)) {
+        std::fprintf(stderr, "cannot read capture %s\n", captureIn);
+        return 1;
+    }
+
+    int senders = 1;
+    bool endless = loop;
+    for (const LoadPhase& p : generator.GetPhases()) {
+        if (p.senders > senders) senders = p.senders;
+        if (p.durationMs == 0) endless = true;
+    }
+    if (captureOut && endless && seconds <= 0.0) {
+        std::fprintf(stderr, "--capture-out needs --seconds for a looped or open-ended schedule\n");
+        return 2;
+    }
+
+    cameraunlock::CaptureWriter writer;
+    cameraunlock::LoadSender sender;
+    if (captureOut) {
+        if (!writer.Open(captureOut)) {
+            std::fprintf(stderr, "cannot write %s\n", captureOut);
+            return 1;
+        }
+    } else if (!sender.Open(host, port, senders)) {
+        std::fprintf(stderr, "cannot open %d sender socket(s) for %s:%u\n", senders, host, port);
+        return 1;
+    }
+
+    const int64_t stopUs = seconds > 0.0 ? static_cast<int64_t>(seconds * 1000000.0) : -1;
+    const int64_t reportUs = static_cast<int64_t>(reportMs > 0 ? reportMs : 1000) * 1000;
+    int64_t nextReportUs = reportUs;
+    int64_t maxLateUs = 0;
+    const auto start = Clock::now();
+
+    generator.Begin();
+    GeneratedDatagram datagram;
+    while (generator.Next(datagram)) {
+        if (stopUs >= 0 && datagram.dueUs >= stopUs) {
+            break;
+        }
+        if (captureOut) {
+            if (!writer.Append(datagram.data, datagram.length, datagram.dueUs)) {
+                std::fprintf(stderr, "write to %s failed\n", captureOut);
+                return 1;
+            }
+            continue;
+        }
+
+        const auto due = start + std::chrono::microseconds(datagram.dueUs);
+        std::this_thread::sleep_until(due);
+        const int64_t lateUs = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - due).count();
+        if (lateUs > maxLateUs) maxLateUs = lateUs;
+        sender.Send(datagram);
+
+        if (datagram.dueUs >= nextReportUs) {
+            PrintCounters(static_cast<double>(datagram.dueUs) / 1000000.0, generator.GetCounters(),
+                          sender.GetSendErrors(), maxLateUs);
+            nextReportUs += reportUs;
+            maxLateUs = 0;
+        }
+    }
+
+    const LoadCounters& totals = generator.GetCounters();
+    if (captureOut) {
+        writer.Close();
+        std::printf("wrote %llu datagrams to %s\n", static_cast<unsigned long long>(writer.GetRecordCount()),
+                    captureOut);
+    }
+    PrintCounters(std::chrono::duration<double>(Clock::now() - start).count(), totals,
+                  sender.GetSendErrors(), maxLateUs);
+    return 0;
+}
@@ -0,0 +1,130 @@
+// Flat C ABI over the native receiver and fused 6DOF processor, for
+// managed mods (P/Invoke from Unity/Mono, BepInEx, MelonLoader, ...).
+//
+// Built as the cameraunlock_capi shared library (CAMERAUNLOCK_BUILD_CAPI).
+// One tracker owns a UdpReceiver (event-driven receive thread) and a
+// HeadPoseProcessor. A frame is one call, cu_tracker_step, which reads the
+// newest sample and writes the processed pose into a caller-owned struct,
+// so the managed side allocates nothing per frame.
+//
+// Every struct is blittable: fixed-width scalars only, booleans as int32,
+// laid out without implicit padding (64-bit fields first). Declare them in
+// C# with [StructLayout(LayoutKind.Sequential)] and the same field order,
+// and pass them by ref/out. Calls use the platform C calling convention
+// (cdecl; CallingConvention.Cdecl on 32-bit Windows).
+//
+// Threading: cu_tracker_step, cu_tracker_set_settings, cu_tracker_recenter
+// and cu_tracker_reset must come from one thread (the game thread). The
+// receive thread runs inside the library. No function throws or aborts:
+// a failure inside the library (e.g. the receive thread can't be created)
+// is caught at the boundary and returned as 0 / NULL, or ignored for void
+// calls. A null tracker is ignored (and reads as "no data").
+
+#pragma once
+
+#include <stdint.h>
+
+#if defined(_WIN32)
+#  if defined(CAMERAUNLOCK_CAPI_BUILD)
+#    define CAMERAUNLOCK_CAPI __declspec(dllexport)
+#  else
+#    define CAMERAUNLOCK_CAPI __declspec(dllimport)
+#  endif
+#else
+#  define CAMERAUNLOCK_CAPI __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Bumped on any change to a struct layout or function signature.
+#define CU_API_VERSION 1
+
+/// cu_frame.flags
+#define CU_FRAME_ROTATION_VALID 0x1u // rotation/euler fields hold a processed pose
+#define CU_FRAME_POSITION_VALID 0x2u // position holds a processed head offset
+#define CU_FRAME_NEW_SAMPLE     0x4u // a tracker sample arrived since the last step
+
+/// cu_frame.receiver_flags
+#define CU_RECEIVER_RUNNING   0x1u // receive thread running
+#define CU_RECEIVER_RECEIVING 0x2u // data within the connection timeout
+#define CU_RECEIVER_REMOTE    0x4u // latest sender is not loopback
+#define CU_RECEIVER_FAILED    0x8u // last bind failed; retrying in the background
+
+typedef struct cu_tracker cu_tracker;
+
+/// Latest raw tracker sample (no recenter or processing).
+typedef struct cu_sample {
+    int64_t timestamp_us;  // steady-clock receive time
+    uint64_t sequence;     // 1-based, 0 = no data yet
+    float yaw, pitch, roll; // degrees
+    float x, y, z;          // meters
+} cu_sample;
+
+/// Output of one cu_tracker_step.
+typedef struct cu_frame {
+    int64_t sample_timestamp_us; // receive time of the sample used
+    int64_t sample_age_us;       // now - sample_timestamp_us
+    uint64_t sequence;           // sequence of the sample used, 0 = none
+    float rot_x, rot_y, rot_z, rot_w; // processed rotation quaternion
+    float yaw, pitch, roll;           // same rotation as YXZ Euler, degrees
+    float pos_x, pos_y, pos_z;        // processed head offset, meters
+    uint32_t flags;                   // CU_FRAME_*
+    uint32_t receiver_flags;          // CU_RECEIVER_*
+} cu_frame;
+
+/// Processor configuration; start from cu_get_default_settings.
+typedef struct cu_settings {
+    float sensitivity_yaw, sensitivity_pitch, sensitivity_roll;
+    int32_t invert_yaw, invert_pitch, invert_roll;
+    float deadzone_yaw, deadzone_pitch, deadzone_roll; // degrees
+    float smoothing;                                   // rotation, 0..1
+    int32_t position_enabled;
+    float position_sensitivity_x, position_sensitivity_y, position_sensitivity_z;
+    float position_limit_x, position_limit_y, position_limit_z, position_limit_z_back; // meters
+    float position_smoothing;
+    int32_t invert_x, invert_y, invert_z;
+    float tracker_pivot_forward;      // meters
+    int32_t interpolation_enabled;
+    float max_extrapolation_fraction;
+} cu_settings;
+
+/// CU_API_VERSION the library was built with; check before use.
+CAMERAUNLOCK_CAPI uint32_t cu_get_api_version(void);
+
+/// Library defaults (matching HeadPoseProcessor).
+CAMERAUNLOCK_CAPI void cu_get_default_settings(cu_settings* out);
+
+/// Returns NULL if out of memory.
+CAMERAUNLOCK_CAPI cu_tracker* cu_tracker_create(void);
+
+/// Stops the receiver and frees the tracker.
+CAMERAUNLOCK_CAPI void cu_tracker_destroy(cu_tracker* tracker);
+
+/// Binds the OpenTrack UDP port (4242 is the usual one) and starts
+/// receiving. Returns 1 if bound immediately; 0 if the port is busy, in
+/// which case it is retried in the background (CU_RECEIVER_FAILED).
+CAMERAUNLOCK_CAPI int32_t cu_tracker_start(cu_tracker* tracker, uint16_t port);
+
+CAMERAUNLOCK_CAPI void cu_tracker_stop(cu_tracker* tracker);
+
+/// Copies the settings; takes effect on the next step.
+CAMERAUNLOCK_CAPI void cu_tracker_set_settings(cu_tracker* tracker, const cu_settings* settings);
+
+/// Runs interpolation, rotation and position processing on the newest
+/// sample. Returns 1 if out holds a valid rotation.
+CAMERAUNLOCK_CAPI int32_t cu_tracker_step(cu_tracker* tracker, float delta_time, cu_frame* out);
+
+/// Copies the newest raw sample. Returns 1 if one exists. Any thread.
+CAMERAUNLOCK_CAPI int32_t cu_tracker_get_sample(const cu_tracker* tracker, cu_sample* out);
+
+/// Makes the current pose the center for rotation and position.
+CAMERAUNLOCK_CAPI void cu_tracker_recenter(cu_tracker* tracker);
+
+/// Clears processing state, including the center.
+CAMERAUNLOCK_CAPI void cu_tracker_reset(cu_tracker* tracker);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "cameraunlock/config/ini_reader.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+
+namespace cameraunlock {
+
+class Runtime;
+
+/// Re-parses an INI file on a background thread when it is written.
+///
+/// Instead of polling IniReader::HasChanged from a timer or the game loop,
+/// the watcher thread sleeps on a directory change notification
+/// (ReadDirectoryChangesW on Windows, inotify on Linux; other platforms
+/// fall back to checking the modification time every kPollIntervalMs).
+/// Events are debounced: editors often truncate, write and rename in a
+/// burst, so the file is only parsed once no further event has arrived for
+/// the debounce period. The parsed file is handed to the reload callback on
+/// the watcher thread, which is expected to build an immutable settings
+/// value and publish it, typically through a SettingsChannel:
+///
+///   watcher.Start(path, [&](const IniReader& ini) {
+///       channel.Publish(LoadSettings(ini));
+///   });
+///
+/// The frame thread then picks the snapshot up with ReadIfChanged and
+/// never touches the file. An unchanged file costs nothing.
+///
+/// The Runtime overload of Start registers the notification with a shared
+/// runtime instead of starting a thread; debouncing then uses a runtime
+/// timer and callbacks run on the runtime thread.
+class ConfigWatcher {
+public:
+    using ReloadCallback = std::function<void(const IniReader&)>;
+    using ErrorCallback = IniReader::ErrorCallback;
+
+    /// Quiet period after the last change event before re-parsing.
+    static constexpr int kDefaultDebounceMs = 250;
+    /// Modification-time check interval where no notification API exists.
+    static constexpr int kPollIntervalMs = 1000;
+
+    ConfigWatcher() = default;
+    ~ConfigWatcher();
+
+    // Non-copyable, non-movable (the watcher thread holds this)
+    ConfigWatcher(const ConfigWatcher&) = delete;
+    ConfigWatcher& operator=(const ConfigWatcher&) = delete;
+    ConfigWatcher(ConfigWatcher&&) = delete;
+    ConfigWatcher& operator=(ConfigWatcher&&) = delete;
+
+    /// Starts watching path. The callback is not invoked for the current
+    /// contents, only after later writes.
+    /// @param path INI file to watch; its directory must exist.
+    /// @param onReload Invoked on the watcher thread with each re-parse.
+    /// @param debounceMs Quiet period before re-parsing.
+    /// @return True if the notification was set up and the thread started.
+    bool Start(const std::string& path, ReloadCallback onReload, int debounceMs = kDefaultDebounceMs);
+
+    /// Starts watching path on a shared Runtime. The runtime must outlive
+    /// the watcher (or Stop() must be called first).
+    bool Start(Runtime& runtime, const std::string& path, ReloadCallback onReload,
+               int debounceMs = kDefaultDebounceMs);
+
+    /// Stops and joins the watcher thread (or unregisters from the
+    /// runtime). A pending debounced reload is
+    /// dropped. Safe to call when not running.
+    void Stop();
+
+    /// True while the watcher thread is running.
+    bool IsRunning() const { return m_running.load(std::memory_order_acquire); }
+
+    /// Successful re-parses since Start.
+    uint64_t GetReloadCount() const { return m_reloadCount.load(std::memory_order_relaxed); }
+
+    /// Sets an error callback for logging. Invoked on the watcher thread;
+    /// set before Start.
+    void SetErrorCallback(ErrorCallback callback) { m_errorCallback = std::move(callback); }
+
+private:
+    enum class WaitResult { Changed, Timeout, Stopped, Error };
+
+    bool Prepare(const std::string& path, ReloadCallback onReload, int debounceMs);
+    bool OpenNotification();
+    void CloseNotification();
+    bool ArmNotification();
+    WaitResult ConsumeEvents();
+    WaitResult Wait(int timeoutMs);
+    void Run();
+    void OnRuntimeEvent();
+    void Reload();
+    void LogError(const char* message) const;
+
+    std::string m_path;
+    std::string m_directory;
+    std::string m_fileName;
+    int m_debounceMs = kDefaultDebounceMs;
+    ReloadCallback m_onReload;
+    ErrorCallback m_errorCallback;
+
+    std::thread m_thread;
+    std::atomic<bool> m_running{false};
+    std::atomic<uint64_t> m_reloadCount{0};
+
+    // Runtime mode; the ids are only touched on the runtime thread
+    Runtime* m_runtime = nullptr;
+    int m_runtimeSource = 0;
+    int m_debounceTimer = 0;
+
+#ifdef _WIN32
+    static constexpr size_t kNotifyBufferSize = 4096;
+
+    std::wstring m_fileNameWide;
+    HANDLE m_directoryHandle = INVALID_HANDLE_VALUE;
+    HANDLE m_changeEvent = nullptr;
+    HANDLE m_stopEvent = nullptr;
+    OVERLAPPED m_overlapped = {};
+    alignas(DWORD) char m_notifyBuffer[kNotifyBufferSize];
+    bool m_readPending = false;
+#else
+    int m_notifyFd = -1;
+    int m_pipe[2] = {-1, -1};
+    time_t m_lastModTime = 0;
+#endif
+};
+
+}  // namespace cameraunlock
@@ -1,8 +1,10 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <cstdint>
 #include <functional>
+#include <vector>
 
 #ifdef _WIN32
 #include <Windows.h>
@@ -11,6 +13,12 @@
 namespace cameraunlock {
 
 /// Generic INI file reader with type-safe reading methods.
+/// The file is read and indexed once by Open()/Reload(); the Read* methods
+/// are lookups in that index and never touch the disk. Parsing follows
+/// GetPrivateProfileString on every platform: section and key names are
+/// case-insensitive, names and values are trimmed, one pair of matching
+/// quotes around a value is removed, and the first occurrence of a key
+/// wins. Only lines starting with ';' are comments.
 /// Supports hot-reload detection via file modification time.
 class IniReader {
 public:
@@ -26,11 +34,15 @@ public:
     IniReader(IniReader&&) = default;
     IniReader& operator=(IniReader&&) = default;
 
-    /// Opens an INI file for reading.
+    /// Opens an INI file and reads it into memory.
     /// @param path Path to the INI file.
-    /// @return True if the file exists and was opened successfully.
+    /// @return True if the file exists and was read successfully.
     bool Open(const std::string& path);
 
+    /// Re-reads the open file, e.g. after HasChanged() reported a write.
+    /// Keeps the previous contents if the file can't be read.
+    bool Reload();
+
     /// Closes the current file.
     void Close();
 
@@ -40,10 +52,15 @@ public:
     /// Returns true if a file is currently open.
     bool IsOpen() const { return !m_path.empty(); }
 
+    /// Number of key=value entries indexed.
+    size_t GetEntryCount() const { return m_entries.size(); }
+
     /// Checks if the file has been modified since last Open() or RefreshModTime().
     bool HasChanged() const;
 
-    /// Updates the stored modification time to the current file time.
+    /// Re-reads the file and updates the stored modification time, so the
+    /// HasChanged() / RefreshModTime() / Read*() pattern sees new values.
+    /// Same as Reload().
     void RefreshModTime();
 
     /// Sets an error callback for logging.
@@ -95,9 +112,24 @@ public:
                           float minValue, float maxValue, float defaultValue = 0.0f) const;
 
 private:
+    struct Entry {
+        std::string_view section;
+        std::string_view key;
+        std::string_view value;
+    };
+
+    bool Load(const std::string& path);
+    void Index();
+    void StampModTime();
+    const Entry* Find(std::string_view section, std::string_view key) const;
+    // NUL-terminated copy of a non-empty value, for the numeric parsers
+    bool CopyValue(const char* section, const char* key, char* out, size_t outSize) const;
     void LogError(const char* message) const;
 
     std::string m_path;
+    // File contents; entries view into it. A vector so moves keep the views valid.
+    std::vector<char> m_text;
+    std::vector<Entry> m_entries;  // sorted by section, key (case-insensitive)
     ErrorCallback m_errorCallback;
 
 #ifdef _WIN32
@@ -27,6 +27,89 @@ private:
 #pragma warning(pop)
 #endif
 
+/// One coherent 6DOF tracker sample: rotation and position from the same
+/// packet, plus when it arrived and its publication sequence number.
+/// Extended packets also carry the sender's capture time, mapped onto the
+/// local clock (source_us); filters that run on timestamps should prefer
+/// it, as it is free of network and scheduling jitter.
+/// Sources that recenter on their writer thread (UdpReceiver) also stamp
+/// the center in effect for this sample, so the raw pose and its offset
+/// are always read together.
+struct TrackingSample {
+    float yaw = 0.0f;              // degrees
+    float pitch = 0.0f;
+    float roll = 0.0f;
+    float x = 0.0f;                // meters
+    float y = 0.0f;
+    float z = 0.0f;
+    int64_t timestamp_us = 0;      // steady-clock receive time (microseconds)
+    uint64_t sequence = 0;         // 1-based publication count, 0 = no data
+    int64_t source_us = 0;         // sender capture time on the steady clock, 0 = unknown
+    float center_yaw = 0.0f;       // recenter offset in effect (degrees), 0 if unused
+    float center_pitch = 0.0f;
+    float center_roll = 0.0f;
+
+    bool IsValid() const { return sequence != 0; }
+
+    /// Best estimate of when the pose was measured: source_us if the packet
+    /// carried it, else the receive time.
+    int64_t MeasurementUs() const { return source_us != 0 ? source_us : timestamp_us; }
+};
+
+/// Single-writer, multi-reader publication slot for TrackingSample.
+/// Uses a two-copy seqlock (latch): the writer updates one copy while readers
+/// are steered to the other, so a reader never waits on a writer that was
+/// preempted mid-update and only retries if a full publish lands inside its
+/// read window. All operations are lock-free.
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4324)  // structure was padded due to alignment specifier
+#endif
+class alignas(64) SharedTrackingSample {
+public:
+    /// Publishes a new sample. Assigns the next sequence number (overwriting
+    /// sample.sequence). Must only be called from one thread at a time.
+    void Publish(const TrackingSample& sample);
+
+    /// Reads the latest published sample.
+    /// @return False if nothing has been published since the last Reset.
+    bool TryGet(TrackingSample& out) const;
+
+    /// Sequence number of the latest published sample (0 = none).
+    uint64_t GetSequence() const { return m_published.load(std::memory_order_acquire); }
+
+    /// Clears the published sample. Writer-side operation.
+    void Reset();
+
+private:
+    struct Slot {
+        std::atomic<float> yaw{0.0f};
+        std::atomic<float> pitch{0.0f};
+        std::atomic<float> roll{0.0f};
+        std::atomic<float> x{0.0f};
+        std::atomic<float> y{0.0f};
+        std::atomic<float> z{0.0f};
+        std::atomic<int64_t> timestamp_us{0};
+        std::atomic<uint64_t> sequence{0};
+        std::atomic<int64_t> source_us{0};
+        std::atomic<float> center_yaw{0.0f};
+        std::atomic<float> center_pitch{0.0f};
+        std::atomic<float> center_roll{0.0f};
+
+        void Store(const TrackingSample& s);
+        void Load(TrackingSample& s) const;
+    };
+
+    void Write(const TrackingSample& sample);
+
+    std::atomic<uint32_t> m_latch{0};
+    std::atomic<uint64_t> m_published{0};
+    Slot m_slots[2];
+};
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
 /// Immutable 3DOF tracking pose with timestamp.
 struct TrackingPose {
     float yaw = 0.0f;
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include "cameraunlock/data/tracking_pose.h"
+
+namespace cameraunlock {
+
+/// Lock-free history of the most recent tracker samples.
+/// Single producer (the receive thread) that never blocks: once the ring is
+/// full the oldest sample is overwritten. Each slot carries its own version,
+/// so a consumer that falls more than kCapacity samples behind skips the
+/// overwritten entries instead of returning torn data.
+class TrackingSampleRing {
+public:
+    /// Number of samples retained (~64-250 ms at 120-500 Hz).
+    static constexpr size_t kCapacity = 32;
+
+    /// Appends a sample, overwriting the oldest when full. Producer only.
+    void Push(const TrackingSample& sample);
+
+    /// Copies samples pushed after `cursor`, oldest first, and advances
+    /// `cursor` past the newest one. If more than maxCount are pending, only
+    /// the newest maxCount are returned. Start with cursor = 0.
+    /// @return Number of samples written to out.
+    size_t ReadSince(uint64_t& cursor, TrackingSample* out, size_t maxCount) const;
+
+    /// Total number of samples pushed since the last Reset.
+    uint64_t GetHead() const { return m_head.load(std::memory_order_acquire); }
+
+    /// Discards all samples. Only valid while the producer is stopped.
+    void Reset();
+
+private:
+    struct Slot {
+        // 2n while slot holds push #n, 2n-1 while it is being written.
+        std::atomic<uint64_t> version{0};
+        std::atomic<float> yaw{0.0f};
+        std::atomic<float> pitch{0.0f};
+        std::atomic<float> roll{0.0f};
+        std::atomic<float> x{0.0f};
+        std::atomic<float> y{0.0f};
+        std::atomic<float> z{0.0f};
+        std::atomic<int64_t> timestamp_us{0};
+        std::atomic<uint64_t> sequence{0};
+        std::atomic<int64_t> source_us{0};
+        std::atomic<float> center_yaw{0.0f};
+        std::atomic<float> center_pitch{0.0f};
+        std::atomic<float> center_roll{0.0f};
+    };
+
+    bool TryRead(uint64_t index, TrackingSample& out) const;
+
+    std::atomic<uint64_t> m_head{0};
+    Slot m_slots[kCapacity];
+};
+
+}  // namespace cameraunlock
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+namespace cameraunlock {
+
+/// Receives one formatted line. Called on the log drain thread only, so
+/// sinks are serialized with each other but not with the producer.
+using LogWriteFn = void (*)(void* context, int level, const char* message);
+
+namespace async_log_detail {
+struct Record;
+
+Record* Begin(LogWriteFn write, void* context, int level, const char* format);
+void Commit(Record* record);
+
+void PutSigned(Record& record, long long value);
+void PutUnsigned(Record& record, unsigned long long value);
+void PutDouble(Record& record, double value);
+void PutPointer(Record& record, const void* value);
+void PutString(Record& record, const char* value);
+
+template <typename T>
+void Put(Record& record, const T& value) {
+    using U = std::decay_t<T>;
+    if constexpr (std::is_same_v<U, std::string>) {
+        PutString(record, value.c_str());
+    } else if constexpr (std::is_same_v<U, const char*> || std::is_same_v<U, char*>) {
+        PutString(record, value);
+    } else if constexpr (std::is_null_pointer_v<U>) {
+        PutPointer(record, nullptr);
+    } else if constexpr (std::is_pointer_v<U>) {
+        PutPointer(record, static_cast<const void*>(value));
+    } else if constexpr (std::is_floating_point_v<U>) {
+        PutDouble(record, static_cast<double>(value));
+    } else if constexpr (std::is_enum_v<U>) {
+        PutSigned(record, static_cast<long long>(value));
+    } else if constexpr (std::is_signed_v<U>) {
+        PutSigned(record, static_cast<long long>(value));
+    } else {
+        static_assert(std::is_integral_v<U>, "unsupported log argument type");
+        PutUnsigned(record, static_cast<unsigned long long>(value));
+    }
+}
+}  // namespace async_log_detail
+
+/// Deferred-formatting log shared by the library's components.
+///
+/// A call copies the format pointer and the raw arguments (strings by
+/// value, truncated to kStringBytes per record) into a ring owned by the
+/// calling thread, with no allocation or formatting; the only lock is the
+/// one taken to wake the drain thread when it is idle. A background
+/// drain thread formats the records printf-style and hands each line to
+/// the sink it was logged with, so the existing callbacks (CameraDiscovery
+/// LogFn, UdpReceiver::SetLog, reframework::SetLogCallback) keep working
+/// but never run on the hot thread.
+///
+/// Each call site (identified by its format string) may log kSiteBurst
+/// lines per kSiteWindowMs on a thread; the rest are counted and reported
+/// on the site's next line. A full ring drops the record and the drop is
+/// reported the same way.
+///
+/// Format strings must be literals (the pointer is kept): the usual
+/// conversions are supported, with `*` widths, but not `%n`.
+/// Components that own a sink context call Flush() before it goes away.
+class AsyncLog {
+public:
+    static constexpr size_t kMaxArgs = 12;
+    static constexpr size_t kStringBytes = 160;
+    static constexpr size_t kRingCapacity = 128;
+    static constexpr size_t kMaxMessageLength = 512;
+    static constexpr uint32_t kSiteBurst = 20;
+    static constexpr int kSiteWindowMs = 1000;
+
+    /// Queues one line for write(context, level, message). Lock-free for
+    /// the caller after the thread's first call (which registers its ring
+    /// and, on the first call in the process, starts the drain thread).
+    template <typename... Args>
+    static void Write(LogWriteFn write, void* context, int level, const char* format, const Args&... args) {
+        static_assert(sizeof...(Args) <= kMaxArgs, "too many log arguments");
+        if (!write || !format) return;
+        async_log_detail::Record* record = async_log_detail::Begin(write, context, level, format);
+        if (!record) return;
+        (async_log_detail::Put(*record, args), ...);
+        async_log_detail::Commit(record);
+    }
+
+    /// Writes everything queued so far before returning. No-op when called
+    /// from a sink.
+    static void Flush();
+
+    /// Stops the drain thread after writing what is queued. For unload;
+    /// later calls are formatted and written on the calling thread. The
+    /// state is never destroyed, so logging from static destructors is safe.
+    static void Shutdown();
+
+    /// Records lost to full rings since startup.
+    static uint64_t GetDroppedCount();
+
+    /// Lines held back by per-site rate limits since startup.
+    static uint64_t GetSuppressedCount();
+};
+
+}  // namespace cameraunlock
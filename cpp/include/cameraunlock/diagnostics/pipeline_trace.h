@@ -0,0 +1,124 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace cameraunlock {
+
+/// Points a sample passes on its way to the screen.
+enum class TraceStage : uint8_t {
+    Arrival,       ///< Datagram reached the socket (kernel timestamp when available)
+    Publish,       ///< Receiver published the parsed sample
+    ProcessBegin,  ///< First TrackingProcessor call for the sample started
+    ProcessEnd,    ///< ...and returned
+    Present,       ///< First Present after the sample was processed
+    Count
+};
+
+/// Intervals between consecutive stages, plus the end-to-end total.
+enum class TraceSpan : uint8_t {
+    Receive,   ///< Arrival -> Publish: parse and publish on the receive thread
+    Wait,      ///< Publish -> ProcessBegin: until the game thread picks it up
+    Process,   ///< ProcessBegin -> ProcessEnd
+    Present,   ///< ProcessEnd -> Present: rest of the frame up to submission
+    Total,     ///< Arrival -> Present
+    Count
+};
+
+/// Distribution of one span over the samples in the trace buffer.
+struct TraceSpanStats {
+    uint64_t count = 0;
+    double p50Us = 0.0;
+    double p90Us = 0.0;
+    double p99Us = 0.0;
+    double maxUs = 0.0;
+    double meanUs = 0.0;
+};
+
+struct PipelineTraceSummary {
+    static constexpr size_t kSpanCount = static_cast<size_t>(TraceSpan::Count);
+
+    uint64_t samples = 0;   ///< Samples in the buffer with at least an arrival
+    TraceSpanStats spans[kSpanCount];
+
+    const TraceSpanStats& Get(TraceSpan span) const { return spans[static_cast<size_t>(span)]; }
+};
+
+/// Fixed-size, lock-free record of when each sample reached each stage.
+///
+/// Samples are keyed by TrackingSample::sequence. The receiver opens a
+/// record at publish (UdpReceiver::SetPipelineTrace), the processor stamps
+/// it (TrackingProcessor::SetPipelineTrace with the TrackingSample
+/// overloads) and the Present hook closes it (the overlays'
+/// SetPipelineTrace, or MarkPresent from a custom hook). Each stage keeps
+/// its first stamp, so a sample processed on several frames reports its
+/// first. All times are steady-clock microseconds
+/// (TrackingPose::CurrentTimestamp).
+///
+/// The buffer holds the last kCapacity samples; slot reuse is not fenced
+/// against a stage stamped kCapacity samples late, which can at worst
+/// misattribute that one stamp. One receiver per trace; stages may run on
+/// different threads, and Summarize/WriteChromeTrace may run on any.
+class PipelineTrace {
+public:
+    static constexpr size_t kCapacity = 1024;
+    static constexpr size_t kStageCount = static_cast<size_t>(TraceStage::Count);
+
+    PipelineTrace() = default;
+
+    // Non-copyable
+    PipelineTrace(const PipelineTrace&) = delete;
+    PipelineTrace& operator=(const PipelineTrace&) = delete;
+
+    /// Receive thread: opens the record for sampleId, replacing the sample
+    /// kCapacity earlier.
+    void BeginSample(uint64_t sampleId, int64_t arrivalUs, int64_t publishUs);
+
+    /// Stamps one stage of sampleId unless it already has a stamp. Ignored if
+    /// the record is gone (or was never opened).
+    void Mark(uint64_t sampleId, TraceStage stage, int64_t us);
+
+    /// Stamps ProcessBegin/ProcessEnd and makes sampleId the one the next
+    /// MarkPresent belongs to.
+    void MarkProcessed(uint64_t sampleId, int64_t beginUs, int64_t endUs);
+
+    /// Present thread: stamps Present on the most recently processed sample.
+    void MarkPresent(int64_t presentUs);
+
+    /// Forgets every record.
+    void Reset();
+
+    /// Percentiles of each span over the records currently held.
+    PipelineTraceSummary Summarize() const;
+
+    /// Writes the held records as a Chrome trace (chrome://tracing,
+    /// Perfetto): one lane per span, one event per sample and span.
+    /// @return False if the file could not be written.
+    bool WriteChromeTrace(const std::string& path) const;
+
+    /// Windows: also emits a TraceLogging event ("CameraUnlock.Pipeline"
+    /// provider, event "Sample") with every stage stamp when a sample is
+    /// presented, so the stages line up with GPU captures in WPA/GPUView.
+    /// @return False where ETW is unavailable.
+    bool SetEtwEnabled(bool enabled);
+
+    static const char* GetSpanName(TraceSpan span);
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> id{0};
+        std::atomic<int64_t> us[kStageCount] = {};
+    };
+
+    // Copies a slot; false if it is empty or changed during the copy
+    bool ReadSlot(size_t index, uint64_t& id, int64_t (&us)[kStageCount]) const;
+    void EmitEtw(uint64_t sampleId) const;
+
+    Slot m_slots[kCapacity];
+    std::atomic<uint64_t> m_lastProcessed{0};
+    std::atomic<bool> m_etw{false};
+};
+
+}  // namespace cameraunlock
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace cameraunlock {
+
+/// Point-in-time copy of ReceiverStats, safe to inspect on any thread.
+struct ReceiverStatsSnapshot {
+    /// Upper bounds (exclusive, microseconds) of the inter-arrival buckets;
+    /// the last bucket is open-ended. Buckets double from 250 us to 128 ms.
+    static constexpr size_t kBucketCount = 11;
+    static constexpr int64_t kBucketUpperUs[kBucketCount - 1] = {
+        250, 500, 1000, 2000, 4000, 8000, 16000, 32000, 64000, 128000
+    };
+
+    uint64_t packets = 0;       // Valid packets published
+    uint64_t malformed = 0;     // Datagrams rejected by the parser
+    uint64_t superseded = 0;    // Published but overwritten before any read
+    uint64_t reordered = 0;     // Extended packets dropped as duplicate or late
+    uint64_t intervals = 0;     // Inter-arrival samples in the histogram
+    uint64_t buckets[kBucketCount] = {};
+
+    double minIntervalMs = 0.0;
+    double meanIntervalMs = 0.0;
+    double p99IntervalMs = 0.0;  // Upper bound of the bucket holding p99 (lower bound if open-ended)
+};
+
+/// Lock-free receive-path counters and inter-arrival histogram.
+/// One writer (the receive thread) updates with relaxed atomics; any thread
+/// may take a Snapshot, whose fields are individually (not mutually) exact.
+class ReceiverStats {
+public:
+    /// Records a valid packet that arrived at arrivalUs (steady_clock).
+    void RecordPacket(int64_t arrivalUs);
+
+    /// Records a datagram that failed to parse.
+    void RecordMalformed() { m_malformed.fetch_add(1, std::memory_order_relaxed); }
+
+    /// Records a published sample that was replaced before being read.
+    void RecordSuperseded() { m_superseded.fetch_add(1, std::memory_order_relaxed); }
+
+    /// Records an extended packet dropped because its sequence number was
+    /// not newer than the last one published.
+    void RecordReordered() { m_reordered.fetch_add(1, std::memory_order_relaxed); }
+
+    /// Copies the current counters and derives min/mean/p99 interval.
+    ReceiverStatsSnapshot Snapshot() const;
+
+    /// Clears all counters. Writer-side; call while the receiver is stopped.
+    void Reset();
+
+private:
+    static size_t BucketFor(int64_t intervalUs);
+
+    std::atomic<uint64_t> m_packets{0};
+    std::atomic<uint64_t> m_malformed{0};
+    std::atomic<uint64_t> m_superseded{0};
+    std::atomic<uint64_t> m_reordered{0};
+    std::atomic<uint64_t> m_intervals{0};
+    std::atomic<uint64_t> m_intervalSumUs{0};
+    std::atomic<int64_t> m_minIntervalUs{0};
+    std::atomic<uint64_t> m_buckets[ReceiverStatsSnapshot::kBucketCount] = {};
+
+    // Writer-thread only
+    int64_t m_lastArrivalUs = 0;
+};
+
+}  // namespace cameraunlock
@@ -1,11 +1,15 @@
 #pragma once
 
+#include <cameraunlock/diagnostics/async_log.h>
 #include <cameraunlock/memory/rtti_vtable.h>
+#include <cameraunlock/discovery/discovery_result.h>
 #include <cameraunlock/discovery/float_classifier.h>
+#include <cameraunlock/discovery/probe_stats.h>
 
 #include <atomic>
 #include <cstdint>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace cameraunlock::discovery {
@@ -28,17 +32,6 @@ struct CalibrationPulse {
     bool active;
 };
 
-// Discovered camera rotation offsets
-struct CameraOffsets {
-    size_t yaw_offset;       // byte offset from instance base
-    size_t pitch_offset;
-    size_t roll_offset;
-    float yaw_sign;          // +1 or -1
-    float pitch_sign;
-    float roll_sign;
-    bool valid;
-};
-
 struct DiscoveryConfig {
     void* module;                              // game module handle
     std::vector<std::string> candidate_names;  // RTTI class names to try
@@ -46,7 +39,18 @@ struct DiscoveryConfig {
     float calibration_deg  = 5.0f;             // rotation to inject per axis
     int pulse_frames       = 15;               // frames to hold each pulse
     int settle_frames      = 10;               // frames to wait between pulses
-    int instance_size      = 512;              // bytes to analyze/snapshot
+    int instance_size      = 512;              // bytes to analyze/snapshot (up to kMaxInstanceSize)
+    int heatmap_frames     = 60;               // frames to watch candidate instances before analysis (0 = none)
+    bool background_scan   = true;             // run RTTI/vtable scans on a worker thread
+    std::string result_path;                   // remembered result for warm starts ("" = always probe)
+};
+
+// How far discovery has got, for an overlay or log line
+struct DiscoveryProgress {
+    Phase phase;
+    float phase_fraction;    // 0..1 within the current phase
+    float overall_fraction;  // 0..1 across the whole run
+    const char* label;       // short description of the current step
 };
 
 using LogFn = void(*)(const char* msg);
@@ -56,6 +60,11 @@ constexpr int kMaxCandidates = 4;
 constexpr int kMaxVfuncsPerCandidate = 8;
 constexpr int kMaxProbeSlots = kMaxCandidates * kMaxVfuncsPerCandidate;
 
+// Layout analysis: largest object snapshot, and how many of the winning
+// vfunc's distinct this pointers are watched for changing fields
+constexpr int kMaxInstanceSize = 4096;
+constexpr int kMaxWatchedInstances = 4;
+
 class CameraDiscovery {
 public:
     CameraDiscovery();
@@ -64,6 +73,7 @@ public:
     void Start(const DiscoveryConfig& config);
     Phase Advance();
     Phase GetPhase() const { return m_phase; }
+    DiscoveryProgress GetProgress() const;
 
     // Vfunc probe callback — each probe detour calls this
     void ReportVfuncCall(int slot, void* this_ptr);
@@ -78,13 +88,16 @@ public:
     void* GetActiveVfuncTarget() const { return m_activeTarget; }
     void* GetInstancePointer() const { return reinterpret_cast<void*>(m_instance.load()); }
 
-    void SetLogCallback(LogFn fn) { m_log = fn; }
+    // Lines are formatted and passed to fn on the AsyncLog drain thread
+    void SetLogCallback(LogFn fn) {
+        AsyncLog::Flush();
+        m_log = fn;
+    }
     void Cleanup();
 
     // Probe detour originals — public so template detours can access them
     static uintptr_t(__fastcall* s_originals[kMaxProbeSlots])(void*, void*, void*, void*);
-    static std::atomic<int> s_callCounts[kMaxProbeSlots];
-    static std::atomic<uintptr_t> s_lastThis[kMaxProbeSlots];
+    static ProbeSlotCounters s_probeCounters[kMaxProbeSlots];
     static CameraDiscovery* s_instance;
 
     // Calibration injection — probe detours apply this after calling original
@@ -95,17 +108,36 @@ public:
     static std::atomic<int> s_calibInjectedThisFrame;  // guard: only inject once per frame
 
 private:
-    void Log(const char* fmt, ...);
+    template <typename... Args>
+    void Log(const char* fmt, const Args&... args) {
+        if (m_log) AsyncLog::Write(&CameraDiscovery::WriteLog, this, 0, fmt, args...);
+    }
+    static void WriteLog(void* context, int level, const char* message);
     Phase RunFindVtables();
+    void ScanCandidates();
+    Phase FinishFindVtables();
+    void JoinScan();
     Phase RunProbing();
     Phase RunAnalyzeLayout();
+    bool WatchInstances();
+    uintptr_t PickWatchedInstance();
     Phase RunCalibrating();
 
+    bool TryWarmStart();
+    void SaveResult();
+
+    bool HookSlot(int candidate, int vfunc);
     void InstallProbeHooks();
     void RemoveProbeHooks();
 
     DiscoveryConfig m_config;
     Phase m_phase = Phase::Idle;
+
+    // Module build the result file is keyed by
+    uintptr_t m_imageBase = 0;
+    memory::ModuleIdentity m_identity;
+    bool m_hasIdentity = false;
+    bool m_warmStart = false;   // result came from the file, not this run
     LogFn m_log = nullptr;
 
     // Vtable discovery results
@@ -115,8 +147,15 @@ private:
     };
     std::vector<CandidateInfo> m_candidates;
 
+    // Background scan state. The worker owns m_candidates until
+    // m_scanDone is set; the game thread only polls until then.
+    std::thread m_scanThread;
+    std::atomic<bool> m_scanDone{false};
+    std::atomic<int> m_scanStep{0};     // names looked up so far, -1 = building index
+
     // Probing state
     int m_probeFrameCount = 0;
+    ProbeRateTracker m_probeRates;
     int m_activeSlot = -1;
     void* m_activeTarget = nullptr;
 
@@ -125,6 +164,14 @@ private:
 
     // Layout analysis
     LayoutReport m_layout{};
+    struct WatchedInstance {
+        uintptr_t address;
+        FloatChangeHeatmap heatmap;
+    };
+    std::vector<WatchedInstance> m_watched;
+    std::vector<float> m_snapshot;  // scratch copy of one instance
+    int m_watchFrame = 0;
+    int m_snapshotSize = 0;         // bytes copied per instance
 
     // Calibration state
     enum class CalibAxis { Yaw, Pitch, Roll, Done };
@@ -142,8 +189,7 @@ private:
 // During calibration, the winning slot also injects rotation pulses.
 template<int Slot>
 static uintptr_t __fastcall ProbeDetour(void* thisPtr, void* a2, void* a3, void* a4) {
-    CameraDiscovery::s_callCounts[Slot].fetch_add(1, std::memory_order_relaxed);
-    CameraDiscovery::s_lastThis[Slot].store(reinterpret_cast<uintptr_t>(thisPtr), std::memory_order_relaxed);
+    CameraDiscovery::s_probeCounters[Slot].Record(thisPtr);
     uintptr_t ret = CameraDiscovery::s_originals[Slot](thisPtr, a2, a3, a4);
 
     // Calibration injection — apply rotation pulse after game processes (once per frame)
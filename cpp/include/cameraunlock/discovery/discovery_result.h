@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cameraunlock/discovery/float_classifier.h>
+#include <cameraunlock/memory/module_sections.h>
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+namespace cameraunlock::discovery {
+
+// Discovered camera rotation offsets
+struct CameraOffsets {
+    size_t yaw_offset;       // byte offset from instance base
+    size_t pitch_offset;
+    size_t roll_offset;
+    float yaw_sign;          // +1 or -1
+    float pitch_sign;
+    float roll_sign;
+    bool valid;
+};
+
+// What a finished discovery run found, stored module-relative so it
+// survives ASLR. A warm start re-validates the class and vtable against the
+// live image before trusting any of it
+struct DiscoveryResult {
+    std::string class_name;   // winning RTTI class (undecorated)
+    int vfunc_index = -1;     // winning vfunc within that class's vtable
+    uint32_t vtable_rva = 0;  // vfunc[0] of the class's vtable
+    uint32_t vfunc_rva = 0;   // the winning function itself
+    CameraOffsets offsets{};
+    LayoutReport layout{};
+};
+
+// Write result for the module build identified by id
+// Returns false on I/O failure or if the offsets aren't valid
+bool SaveDiscoveryResult(const std::string& path, const memory::ModuleIdentity& id,
+                         const DiscoveryResult& result);
+
+// Read a result written for exactly this build
+// Returns false if the file is missing, truncated, malformed or was
+// written for another build; out is only modified on success
+bool LoadDiscoveryResult(const std::string& path, const memory::ModuleIdentity& id,
+                         DiscoveryResult& out);
+
+} // namespace cameraunlock::discovery
@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <cstddef>
+#include <vector>
 
 namespace cameraunlock::discovery {
 
@@ -22,15 +23,72 @@ struct FloatGroup {
 };
 
 struct LayoutReport {
-    static constexpr int kMaxGroups = 32;
+    static constexpr int kMaxGroups = 128;  // enough for a fully packed 4 KB object
     FloatGroup groups[kMaxGroups];
     int group_count;
 };
 
+// Per-float test results from ComputeFloatMasks, one bit per test
+constexpr uint16_t kFloatPlausible  = 1u << 0;   // finite and |f| < 1e10
+constexpr uint16_t kFloatAngleRange = 1u << 1;   // |f| <= 360
+constexpr uint16_t kFloatBelow360   = 1u << 2;   // |f| < 360
+constexpr uint16_t kFloatNonZero    = 1u << 3;   // |f| > 0.001
+constexpr uint16_t kFloatNonTrivial = 1u << 4;   // neither ~0 nor ~±1 (matrix basis values)
+constexpr uint16_t kFloatAboveHalf  = 1u << 5;   // |f| > 0.5
+constexpr uint16_t kFloatLarge      = 1u << 6;   // |f| > 1
+constexpr uint16_t kFloatWorldRange = 1u << 7;   // |f| < 100000
+constexpr uint16_t kFloatIsOne      = 1u << 8;   // |f - 1| < 0.001
+constexpr uint16_t kFloatFovRange   = 1u << 9;   // 20 <= f <= 150
+constexpr uint16_t kFloatUnitQuat   = 1u << 10;  // f[i..i+3] has squared length within 0.01 of 1
+
+// Run every per-float test the classifier needs in one pass, 8 floats at
+// a time with AVX2 (4 with SSE2). masks must hold count entries.
+void ComputeFloatMasks(const float* floats, size_t count, uint16_t* masks);
+
 // Classify floats in a raw memory region.
 // Reads float values at 4-byte alignment, identifies groups.
-// region: must be readable (caller ensures via SEH if needed)
-// size: bytes to scan (should be <= ~512 to stay within one allocation)
+// region: must be readable (caller ensures via SEH if needed, or passes a copy)
+// size: bytes to scan; camera objects of several KB are fine
 LayoutReport ClassifyMemoryRegion(const void* region, size_t size);
 
+// One float that differs between two snapshots
+struct FloatChange {
+    size_t index;   // float index (byte offset / 4)
+    float before;
+    float after;
+};
+
+// Append every float whose |after - before| exceeds min_delta to out, in
+// index order, with a single vectorized pass. Returns the number found.
+size_t DiffFloatSnapshots(const float* before, const float* after, size_t count, float min_delta,
+                          std::vector<FloatChange>& out);
+
+// How often each float of one object changes across many frames
+// Feed it a snapshot of the same object every frame; fields that move
+// with the camera light up, constants and padding stay cold.
+class FloatChangeHeatmap {
+public:
+    void Reset(size_t float_count, float min_delta = 0.0f);
+
+    // First call only primes the baseline; later calls count changes
+    // against the previous snapshot
+    void AddSnapshot(const float* floats);
+
+    size_t GetFloatCount() const { return m_previous.size(); }
+    int GetFrameCount() const { return m_frames; }
+    uint32_t GetChangeCount(size_t index) const { return index < m_counts.size() ? m_counts[index] : 0; }
+    float GetChangeFrequency(size_t index) const;
+
+    // Most recent snapshot (empty until the first AddSnapshot)
+    const float* GetLatest() const { return m_primed ? m_previous.data() : nullptr; }
+
+private:
+    std::vector<float> m_previous;
+    std::vector<uint32_t> m_counts;
+    std::vector<uint32_t> m_changed;  // scratch: indices changed this frame
+    float m_minDelta = 0.0f;
+    int m_frames = 0;
+    bool m_primed = false;
+};
+
 } // namespace cameraunlock::discovery
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace cameraunlock::discovery {
+
+// Counters for one probed vfunc, written from whatever game threads call
+// it. Each slot fills exactly one cache line so detours for different
+// slots running on different cores never share a line; the per-frame
+// bookkeeping happens on the game thread instead.
+struct alignas(64) ProbeSlotCounters {
+    static constexpr int kMaxInstances = 6;
+
+    std::atomic<uint32_t> calls{0};
+    std::atomic<uint32_t> instance_overflow{0};  // distinct instances beyond kMaxInstances
+    std::atomic<uintptr_t> last_this{0};
+    std::atomic<uintptr_t> instances[kMaxInstances] = {};
+
+    // Hot path: one relaxed increment, plus a set insert only when the
+    // caller's this differs from the previous call's
+    void Record(void* this_ptr) {
+        calls.fetch_add(1, std::memory_order_relaxed);
+        const uintptr_t p = reinterpret_cast<uintptr_t>(this_ptr);
+        if (last_this.load(std::memory_order_relaxed) == p) return;
+        last_this.store(p, std::memory_order_relaxed);
+        for (auto& slot : instances) {
+            uintptr_t seen = slot.load(std::memory_order_relaxed);
+            if (seen == p) return;
+            if (seen == 0 && slot.compare_exchange_strong(seen, p, std::memory_order_relaxed)) return;
+            if (seen == p) return;
+        }
+        instance_overflow.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void Reset() {
+        calls.store(0, std::memory_order_relaxed);
+        instance_overflow.store(0, std::memory_order_relaxed);
+        last_this.store(0, std::memory_order_relaxed);
+        for (auto& slot : instances) slot.store(0, std::memory_order_relaxed);
+    }
+
+    int GetInstanceCount() const {
+        int n = 0;
+        for (const auto& slot : instances) {
+            if (slot.load(std::memory_order_relaxed) != 0) ++n;
+        }
+        return n;
+    }
+};
+
+// Per-frame view of one slot over the probe window
+struct ProbeSlotSummary {
+    uint32_t total_calls = 0;
+    int frames = 0;              // frames sampled
+    int active_frames = 0;       // frames with at least one call
+    float mean_per_frame = 0;    // over all sampled frames
+    float mean_per_active = 0;   // over frames that had calls
+    uint32_t max_per_frame = 0;
+    int instance_count = 0;      // distinct this pointers seen
+    bool instance_overflow = false;
+    uintptr_t last_this = 0;
+
+    float Coverage() const { return frames > 0 ? static_cast<float>(active_frames) / frames : 0.0f; }
+};
+
+// Builds per-frame call histograms by diffing the slot counters once per
+// game frame (on the game thread, so the detours stay a single increment)
+class ProbeRateTracker {
+public:
+    void Reset(int slot_count, int expected_frames);
+
+    // Record calls made since the previous SampleFrame
+    void SampleFrame(const ProbeSlotCounters* counters);
+
+    int GetFrameCount() const { return m_frames; }
+
+    // Calls recorded for one slot in one sampled frame
+    uint32_t GetFrameCalls(int slot, int frame) const;
+
+    ProbeSlotSummary Summarize(int slot, const ProbeSlotCounters& counters) const;
+
+private:
+    int m_slots = 0;
+    int m_frames = 0;
+    std::vector<uint32_t> m_previous;   // counter value at last sample
+    std::vector<uint32_t> m_perFrame;   // frame-major: [frame * slots + slot]
+};
+
+// Winner selection thresholds
+struct ProbeSelectionCriteria {
+    float min_coverage = 0.8f;       // share of frames the vfunc must run in
+    float min_per_active = 0.9f;     // camera updates run ~1-2x per frame...
+    float max_per_active = 8.0f;     // ...utility functions run far more often
+    int max_instances = 2;           // a camera vfunc sees one or two objects
+};
+
+// Pick the probe slot that behaves like a per-frame camera update
+// Slots are grouped by candidate class (slots_per_candidate each, most
+// specific class first); the first class with a slot meeting the criteria
+// wins, choosing its slot closest to 1 call per frame on few instances.
+// With no qualifying slot the best-scoring called slot overall is used.
+// Returns -1 if nothing was called.
+int SelectProbeWinner(const ProbeSlotSummary* summaries, int slot_count, int slots_per_candidate,
+                      const ProbeSelectionCriteria& criteria = {});
+
+static_assert(sizeof(ProbeSlotCounters) == 64, "probe counters should fill one cache line");
+
+} // namespace cameraunlock::discovery
@@ -0,0 +1,240 @@
+#pragma once
+
+// Detour overhead instrumentation
+// Has no MinHook dependency, so it builds into the core library; the
+// HookManager wrappers in hook_manager.h install instrumented detours and
+// expose the report
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define CAMERAUNLOCK_DETOUR_TSC 1
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+namespace cameraunlock::hooks {
+
+// Detour timestamp: rdtsc on x86 (invariant TSC on anything a game runs
+// on), steady_clock (QPC on Windows) elsewhere. Units are only meaningful
+// through the calibration in CollectDetourStats
+inline uint64_t ReadDetourClock() {
+#ifdef CAMERAUNLOCK_DETOUR_TSC
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+// Counters one thread writes for one hook. Each fills a cache line so
+// detours running on different threads never share one
+struct alignas(64) DetourThreadSlot {
+    std::atomic<uint64_t> calls{0};
+    std::atomic<uint64_t> sampled_calls{0};
+    std::atomic<uint64_t> total_ticks{0};  // whole detour, original included
+    std::atomic<uint64_t> self_ticks{0};   // detour minus original and nested detours
+};
+
+// Sum over a hook's thread slots
+struct DetourTotals {
+    uint64_t calls = 0;
+    uint64_t sampled_calls = 0;
+    uint64_t total_ticks = 0;
+    uint64_t self_ticks = 0;
+};
+
+// Call counts and sampled timings for one detour
+// Threads are spread over kThreadSlots slots; more threads than that share
+// slots, which stays correct and only costs contention
+class DetourStats {
+public:
+    static constexpr int kThreadSlots = 8;
+
+    DetourStats() = default;
+    DetourStats(const DetourStats&) = delete;
+    DetourStats& operator=(const DetourStats&) = delete;
+
+    DetourThreadSlot& GetSlot(int slot) { return m_slots[slot]; }
+
+    DetourTotals GetTotals() const;
+
+    // Clears the counters; calls in flight may land on either side
+    void Reset();
+
+private:
+    DetourThreadSlot m_slots[kThreadSlots];
+};
+
+class DetourScope;
+
+namespace detail {
+
+// Calls between timed ones per thread; 0 counts calls without timing
+extern std::atomic<uint32_t> g_detourSampleInterval;
+
+struct DetourThreadState {
+    int slot = -1;                     // this thread's slot in every DetourStats
+    uint32_t countdown = 0;            // calls until the next timed one
+    DetourScope* current = nullptr;    // innermost instrumented detour
+};
+
+inline thread_local DetourThreadState t_detourThread;
+
+int AcquireDetourThreadSlot();
+
+class OriginalTimer;
+
+} // namespace detail
+
+// Times one detour invocation; construct it first thing in the detour
+// Every call is counted. Whether it is timed is decided at the outermost
+// instrumented detour on the thread and inherited by the ones it calls,
+// so a timed detour's self time never includes an untimed child
+class DetourScope {
+public:
+    explicit DetourScope(DetourStats& stats) {
+        auto& t = detail::t_detourThread;
+        if (t.slot < 0) t.slot = detail::AcquireDetourThreadSlot();
+        m_slot = &stats.GetSlot(t.slot);
+        m_slot->calls.fetch_add(1, std::memory_order_relaxed);
+
+        m_parent = t.current;
+        if (m_parent) {
+            m_timed = m_parent->m_timed;
+        } else {
+            const uint32_t interval = detail::g_detourSampleInterval.load(std::memory_order_relaxed);
+            if (interval != 0 && t.countdown-- == 0) {
+                t.countdown = interval - 1;
+                m_timed = true;
+            }
+        }
+        t.current = this;
+        if (m_timed) m_start = ReadDetourClock();
+    }
+
+    ~DetourScope() {
+        detail::t_detourThread.current = m_parent;
+        if (!m_timed) return;
+
+        const uint64_t total = ReadDetourClock() - m_start;
+        const uint64_t self = total > m_excluded ? total - m_excluded : 0;
+        m_slot->sampled_calls.fetch_add(1, std::memory_order_relaxed);
+        m_slot->total_ticks.fetch_add(total, std::memory_order_relaxed);
+        m_slot->self_ticks.fetch_add(self, std::memory_order_relaxed);
+        if (m_parent) m_parent->m_excluded += total;
+    }
+
+    DetourScope(const DetourScope&) = delete;
+    DetourScope& operator=(const DetourScope&) = delete;
+
+private:
+    friend class detail::OriginalTimer;
+
+    DetourThreadSlot* m_slot = nullptr;
+    DetourScope* m_parent = nullptr;
+    uint64_t m_start = 0;
+    uint64_t m_excluded = 0;  // ticks spent in the original and nested detours
+    bool m_timed = false;
+};
+
+namespace detail {
+
+// Times a trampoline call for the innermost timed detour
+class OriginalTimer {
+public:
+    OriginalTimer() : m_scope(t_detourThread.current) {
+        if (!m_scope || !m_scope->m_timed) {
+            m_scope = nullptr;
+            return;
+        }
+        m_excluded = m_scope->m_excluded;
+        m_start = ReadDetourClock();
+    }
+
+    // Detours nested inside the original are already in its span, so it
+    // replaces whatever they added instead of adding to it
+    ~OriginalTimer() {
+        if (m_scope) m_scope->m_excluded = m_excluded + (ReadDetourClock() - m_start);
+    }
+
+    OriginalTimer(const OriginalTimer&) = delete;
+    OriginalTimer& operator=(const OriginalTimer&) = delete;
+
+private:
+    DetourScope* m_scope;
+    uint64_t m_start = 0;
+    uint64_t m_excluded = 0;
+};
+
+} // namespace detail
+
+// Calls the trampoline from inside an instrumented detour, keeping the
+// game's own work out of the detour's self time
+template <typename Fn, typename... Args>
+decltype(auto) CallOriginal(Fn original, Args&&... args) {
+    detail::OriginalTimer timer;
+    return original(std::forward<Args>(args)...);
+}
+
+// Wraps a detour function with a DetourScope. Function has the detour's
+// signature and is what gets installed; Stats() is its counters
+//   static void Detour(void* camera, float dt) { ...; CallOriginal(g_original, camera, dt); }
+//   HookManager::Instance().CreateInstrumentedHook<&Detour>(target, "CameraUpdate", &g_original);
+// Plain (x64) calling convention only.
+template <auto Detour>
+struct InstrumentedDetour;
+
+template <typename R, typename... Args, R (*Detour)(Args...)>
+struct InstrumentedDetour<Detour> {
+    static R Function(Args... args) {
+        DetourScope scope(Stats());
+        return Detour(std::forward<Args>(args)...);
+    }
+
+    static DetourStats& Stats() {
+        static DetourStats stats;
+        return stats;
+    }
+};
+
+// One hook's line in the report
+struct HookStats {
+    std::string name;
+    void* target = nullptr;
+    uint64_t calls = 0;           // since the last reset
+    uint64_t sampled_calls = 0;   // calls that were timed
+    double mean_total_us = 0;     // per timed call, original included
+    double mean_self_us = 0;      // per timed call, the detour's own cost
+    double self_us = 0;           // estimated over all calls since the reset
+    double self_percent = 0;      // self_us as a share of wall time since the reset
+};
+
+// Name a hook's counters for the report; registering again renames it
+void RegisterDetourStats(DetourStats& stats, const char* name, void* target);
+
+// Snapshot of every registered hook, highest self time first
+std::vector<HookStats> CollectDetourStats();
+
+// Zero every registered hook's counters and restart the wall clock
+void ResetDetourStats();
+
+// Time one call in interval per thread (default 16); 1 times every call,
+// 0 only counts calls
+void SetDetourSampleInterval(uint32_t interval);
+uint32_t GetDetourSampleInterval();
+
+// Fixed-width table of a report, one hook per line
+std::string FormatHookStats(const std::vector<HookStats>& stats);
+
+static_assert(sizeof(DetourThreadSlot) == 64, "detour counters should fill one cache line");
+
+} // namespace cameraunlock::hooks
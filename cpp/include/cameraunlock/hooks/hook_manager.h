@@ -3,7 +3,11 @@
 // Hook manager requires MinHook library to be linked
 // Include this header only when MinHook is available
 
+#include <cameraunlock/hooks/detour_stats.h>
+
+#include <unordered_set>
 #include <vector>
+#include <cstddef>
 #include <cstdint>
 
 namespace cameraunlock::hooks {
@@ -48,15 +52,46 @@ public:
     // original: receives address of trampoline to call original function
     HookStatus CreateHook(void* target, void* detour, void** original);
 
+    // Create a hook whose detour runs inside InstrumentedDetour, listed
+    // under name in GetHookStats
+    // The detour should call the trampoline through CallOriginal so the
+    // game's own work stays out of its self time
+    template <auto Detour>
+    HookStatus CreateInstrumentedHook(void* target, const char* name, void** original) {
+        HookStatus status =
+            CreateHook(target, reinterpret_cast<void*>(&InstrumentedDetour<Detour>::Function), original);
+        if (status == HookStatus::Ok) {
+            RegisterDetourStats(InstrumentedDetour<Detour>::Stats(), name, target);
+        }
+        return status;
+    }
+
     // Remove a previously created hook
+    // Inside a batch the removal is deferred until Commit
     HookStatus RemoveHook(void* target);
 
     // Enable a created hook
+    // Inside a batch this only queues the change
     HookStatus EnableHook(void* target);
 
     // Disable an enabled hook
+    // Inside a batch this only queues the change
     HookStatus DisableHook(void* target);
 
+    // Start a batch of enable/disable/remove calls
+    // Every MinHook enable or disable suspends all other threads of the
+    // process; a batch applies the whole set in one suspension pass.
+    // Batches nest; only the outermost Commit applies.
+    HookStatus BeginBatch();
+
+    // Apply everything queued since the outermost BeginBatch, then
+    // perform deferred removals (which no longer need a suspension since
+    // the hooks are disabled by then)
+    HookStatus Commit();
+
+    // Check if a batch is open
+    bool IsBatching() const { return m_batchDepth > 0; }
+
     // Enable all created hooks
     HookStatus EnableAllHooks();
 
@@ -72,6 +107,13 @@ public:
     // Get number of tracked hooks
     size_t GetHookCount() const { return m_hooks.size(); }
 
+    // Calls and cost of every instrumented hook, highest self time first
+    // FormatHookStats turns it into a table for the log
+    std::vector<HookStats> GetHookStats() const { return CollectDetourStats(); }
+
+    // Zero the instrumented hooks' counters
+    void ResetHookStats() { ResetDetourStats(); }
+
     // Non-copyable
     HookManager(const HookManager&) = delete;
     HookManager& operator=(const HookManager&) = delete;
@@ -81,7 +123,9 @@ private:
     ~HookManager() = default;
 
     bool m_initialized = false;
-    std::vector<void*> m_hooks;
+    int m_batchDepth = 0;
+    std::unordered_set<void*> m_hooks;
+    std::vector<void*> m_pendingRemovals;
 };
 
 // RAII hook guard - automatically removes hook on destruction
@@ -100,6 +144,16 @@ public:
     // Create and enable hook
     HookStatus Create(void* target, void* detour, void** original);
 
+    // Create and enable an instrumented hook (see CreateInstrumentedHook)
+    template <auto Detour>
+    HookStatus CreateInstrumented(void* target, const char* name, void** original) {
+        HookStatus status = Create(target, reinterpret_cast<void*>(&InstrumentedDetour<Detour>::Function), original);
+        if (status == HookStatus::Ok) {
+            RegisterDetourStats(InstrumentedDetour<Detour>::Stats(), name, target);
+        }
+        return status;
+    }
+
     // Check if hook is valid
     bool IsValid() const { return m_target != nullptr; }
     explicit operator bool() const { return IsValid(); }
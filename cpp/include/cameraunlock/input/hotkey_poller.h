@@ -2,18 +2,54 @@
 
 #include <functional>
 #include <atomic>
+#include <cstdint>
 #include <thread>
 #include <chrono>
+#include <future>
 #include <mutex>
 #include <vector>
+#include "cameraunlock/runtime/settings_channel.h"
+#include "cameraunlock/runtime/thread_scheduling.h"
+
+namespace cameraunlock {
+class Runtime;
+}
 
 namespace cameraunlock::input {
 
 // Callback type for hotkey events
 using HotkeyCallback = std::function<void()>;
 
+// Modifier keys a hotkey can require (either side counts)
+namespace Modifier {
+    constexpr uint32_t None = 0;
+    constexpr uint32_t Ctrl = 1u << 0;
+    constexpr uint32_t Shift = 1u << 1;
+    constexpr uint32_t Alt = 1u << 2;
+    constexpr uint32_t Win = 1u << 3;
+}
+
+// How the background thread learns about key presses
+enum class HotkeyBackend {
+    None,           // Not started (or driven by Poll() from the game loop)
+    Polling,        // GetAsyncKeyState every poll interval
+    KeyboardHook    // WH_KEYBOARD_LL: key-down edges as they happen, no idle wakeups
+};
+
 // Thread-based hotkey polling system for Windows
-// Polls keyboard state at regular intervals and fires callbacks on key press
+// Polls keyboard state at regular intervals and fires callbacks on key press,
+// or, with StartKeyboardHook(), receives key events from a low-level keyboard
+// hook. Raw Input is not used: a process gets one raw keyboard target, so
+// registering ours would take keyboard input away from games that use it.
+//
+// Registration is copy-on-write: every Set*/Add/Remove call rebuilds an
+// immutable binding table and publishes it through a SettingsChannel. The
+// reading side (the poll or hook thread, or the game loop calling Poll())
+// keeps its own copy and only looks at the channel's version each poll, so
+// it takes no locks. Key state and edges are tracked per distinct key, and
+// a hotkey with modifiers fires on its key's down edge while all of its
+// modifiers are held. When several hotkeys on one key match, only the ones
+// requiring the most modifiers fire (Ctrl+F10 doesn't also fire F10).
 class HotkeyPoller {
 public:
     HotkeyPoller() = default;
@@ -35,15 +71,39 @@ public:
     void SetRecenterKey(int vkCode, HotkeyCallback callback);
 
     // Add a generic hotkey with callback
+    // modifiers: Modifier flags that must be held (e.g., Modifier::Ctrl | Modifier::Shift)
     // Returns an ID that can be used to remove the hotkey
-    int AddHotkey(int vkCode, HotkeyCallback callback);
+    int AddHotkey(int vkCode, HotkeyCallback callback, uint32_t modifiers = Modifier::None);
 
     // Remove a hotkey by ID
     void RemoveHotkey(int id);
 
     // Start the polling thread
     // pollIntervalMs: polling interval in milliseconds (default 16ms = ~60Hz)
-    bool Start(int pollIntervalMs = 16);
+    // scheduling: priority/affinity/MMCSS for the polling thread
+    bool Start(int pollIntervalMs = 16, const ThreadSchedulingOptions& scheduling = {});
+
+    // Start the event-driven backend: a thread with a WH_KEYBOARD_LL hook
+    // that sleeps in GetMessage and fires callbacks on the key-down edge.
+    // Callbacks run on the hook thread and must be quick: Windows waits on
+    // the hook for every keystroke system-wide, and removes hooks that
+    // exceed LowLevelHooksTimeout.
+    // Returns false if the hook could not be installed (or off Windows).
+    bool StartKeyboardHook(const ThreadSchedulingOptions& scheduling = {});
+
+    // Same backends on a shared Runtime instead of an own thread: polling
+    // runs from a periodic runtime timer, and the hook is installed on the
+    // runtime thread, whose loop pumps the messages it needs. Callbacks run
+    // on the runtime thread. One hook-backed poller per runtime.
+    // The runtime must outlive the poller (or Stop() must be called first).
+    bool Start(Runtime& runtime, int pollIntervalMs = 16);
+    bool StartKeyboardHook(Runtime& runtime);
+
+    // Backend of the running thread
+    HotkeyBackend GetBackend() const { return m_backend.load(); }
+
+    // Which scheduling settings took effect on the last started thread
+    ThreadSchedulingResult GetSchedulingResult() const { return m_schedulingResult.Get(); }
 
     // Stop the polling thread
     void Stop();
@@ -60,37 +120,65 @@ public:
     int GetRecenterKeyCode() const { return m_recenterKey.load(); }
 
     // For game-loop based polling (alternative to background thread)
-    // Call this once per frame instead of using Start()
+    // Call this once per frame, from one thread, instead of using Start().
+    // Does nothing while a background backend is running.
     void Poll();
 
+    // Feed a key event from another input source (e.g., a WndProc hook
+    // seeing WM_KEYDOWN/WM_KEYUP). Same threading rules as Poll().
+    void ProcessKeyEvent(int vkCode, bool down);
+
 private:
+    struct HotkeyEntry {
+        int id;
+        int vkCode;
+        uint32_t modifiers;
+        HotkeyCallback callback;
+    };
+
+    // Immutable once published
+    struct HotkeyTable {
+        std::vector<HotkeyEntry> bindings;
+        std::vector<uint8_t> keys;  // Distinct keys to sample, modifiers included
+    };
+
     void PollLoop();
-    void CheckKey(int vkCode, std::atomic<bool>& keyDown, const HotkeyCallback& callback);
+    void HookLoop(std::promise<bool>& started);
+    void PollKeys();
+    void OnKeyEvent(int vkCode, bool down);
+    void FireKeyDown(int vkCode);
+    uint32_t HeldModifiers() const;
+    void ResetKeyState();
+    bool InstallHook();
+    void RemoveHook();
+    void PublishLocked();
+    void MoveFrom(HotkeyPoller& other);
 
     std::thread m_thread;
     std::atomic<bool> m_stopFlag{false};
     std::atomic<bool> m_running{false};
     std::atomic<int> m_pollInterval{16};
-
-    // Built-in toggle/recenter keys
+    std::atomic<HotkeyBackend> m_backend{HotkeyBackend::None};
+    ThreadSchedulingSlot m_schedulingResult;
+    std::atomic<unsigned long> m_hookThreadId{0};
+    Runtime* m_runtime = nullptr;
+    int m_runtimeTimer = 0;
+    void* m_hook = nullptr;  // HHOOK; hook thread only
+
+    // Writer side: the registry the table is built from
+    std::mutex m_registryMutex;
+    HotkeyEntry m_toggle{0, 0, Modifier::None, {}};
+    HotkeyEntry m_recenter{0, 0, Modifier::None, {}};
+    std::vector<HotkeyEntry> m_hotkeys;
+    int m_nextHotkeyId = 1;
     std::atomic<int> m_toggleKey{0};
     std::atomic<int> m_recenterKey{0};
-    std::atomic<bool> m_toggleKeyDown{false};
-    std::atomic<bool> m_recenterKeyDown{false};
-    HotkeyCallback m_toggleCallback;
-    HotkeyCallback m_recenterCallback;
-    std::mutex m_callbackMutex;
+    SettingsChannel<HotkeyTable> m_table;
 
-    // Generic hotkeys
-    struct HotkeyEntry {
-        int id;
-        int vkCode;
-        bool keyDown;
-        HotkeyCallback callback;
-    };
-    std::vector<HotkeyEntry> m_hotkeys;
-    std::mutex m_hotkeyMutex;
-    int m_nextHotkeyId = 1;
+    // Reader side: only the thread currently polling touches these
+    HotkeyTable m_active;
+    uint64_t m_activeVersion = 1;
+    bool m_keyDown[256] = {};
 };
 
 // Common virtual key codes for convenience
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace cameraunlock {
+namespace math {
+
+/// Polynomial approximations of the transcendentals used per frame.
+/// Max absolute error over the documented domain (float evaluation):
+///   SinCos  |x| <= 1000 rad    < 1e-7    (~6e-6 deg)
+///   Exp     x in [-87, 88]     < 1e-7 relative
+///   Acos    x in [-1, 1]       < 5e-7 rad (~3e-5 deg)
+/// Tracker noise is ~1e-4 deg, so these are visually indistinguishable
+/// from the std:: versions. Inputs outside the domain are clamped (Exp,
+/// Acos) or lose accuracy gradually (SinCos).
+namespace fast {
+
+/// Sine and cosine of x (radians) in one range reduction.
+inline void SinCos(float x, float& s, float& c) {
+    // Reduce to r in [-pi/4, pi/4] with quadrant q. pi/2 is split in three
+    // parts (Cody-Waite, cephes constants) whose leading parts have few
+    // mantissa bits, so each product with qf is exact.
+    constexpr float kTwoOverPi = 0.636619772367581343f;
+    constexpr float kPiOver2A = 1.5703125f;
+    constexpr float kPiOver2B = 4.837512969970703125e-4f;
+    constexpr float kPiOver2C = 7.54978995489188216e-8f;
+
+    float qf = std::nearbyint(x * kTwoOverPi);
+    float r = ((x - qf * kPiOver2A) - qf * kPiOver2B) - qf * kPiOver2C;
+    int q = static_cast<int>(qf) & 3;
+
+    // Taylor series, truncation error < 2e-9 on [-pi/4, pi/4]
+    float r2 = r * r;
+    float sr = r + r * r2 * (-1.66666667e-1f + r2 * (8.33333333e-3f + r2 * (-1.98412698e-4f + r2 * 2.75573192e-6f)));
+    float cr = 1.0f + r2 * (-0.5f + r2 * (4.16666667e-2f + r2 * (-1.38888889e-3f + r2 * (2.48015873e-5f + r2 * -2.75573192e-7f))));
+
+    switch (q) {
+        case 0: s = sr;  c = cr;  break;
+        case 1: s = cr;  c = -sr; break;
+        case 2: s = -sr; c = -cr; break;
+        default: s = -cr; c = sr; break;
+    }
+}
+
+inline float Sin(float x) { float s, c; SinCos(x, s, c); return s; }
+inline float Cos(float x) { float s, c; SinCos(x, s, c); return c; }
+
+/// e^x, clamped to the normal float range.
+inline float Exp(float x) {
+    constexpr float kLog2e = 1.44269504088896341f;
+    constexpr float kLn2Hi = 6.9313812256e-01f;  // fdlibm split, exact products
+    constexpr float kLn2Lo = 9.0580006145e-06f;
+
+    if (x < -87.0f) x = -87.0f;
+    if (x > 88.0f) x = 88.0f;
+
+    // x = k*ln2 + r, r in [-ln2/2, ln2/2]; e^x = 2^k * e^r
+    float kf = std::nearbyint(x * kLog2e);
+    float r = (x - kf * kLn2Hi) - kf * kLn2Lo;
+
+    float p = 1.0f + r * (1.0f + r * (0.5f + r * (1.66666667e-1f + r * (4.16666667e-2f +
+              r * (8.33333333e-3f + r * (1.38888889e-3f + r * 1.98412698e-4f))))));
+
+    int32_t bits = (static_cast<int32_t>(kf) + 127) << 23;
+    float scale;
+    std::memcpy(&scale, &bits, sizeof(scale));
+    return p * scale;
+}
+
+/// Arc cosine in radians, input clamped to [-1, 1].
+/// Abramowitz & Stegun 4.4.46.
+inline float Acos(float x) {
+    bool negative = x < 0.0f;
+    float a = negative ? -x : x;
+    if (a > 1.0f) a = 1.0f;
+
+    float p = 1.5707963050f + a * (-0.2145988016f + a * (0.0889789874f + a * (-0.0501743046f +
+              a * (0.0308918810f + a * (-0.0170881256f + a * (0.0066700901f + a * -0.0012624911f))))));
+    float result = std::sqrt(1.0f - a) * p;
+    return negative ? 3.14159265358979323846f - result : result;
+}
+
+/// Tangent of x (radians) as sin/cos.
+inline float Tan(float x) { float s, c; SinCos(x, s, c); return s / c; }
+
+}  // namespace fast
+
+/// Per-frame transcendentals used by Quat4, the smoothing utilities and the
+/// rendering projection helpers. Resolves to math::fast when the library is
+/// built with CAMERAUNLOCK_FAST_MATH (CMake option of the same name, which
+/// also defines it for consumers so every translation unit agrees), and to
+/// the std:: functions otherwise.
+namespace trig {
+
+#if defined(CAMERAUNLOCK_FAST_MATH) && CAMERAUNLOCK_FAST_MATH
+inline constexpr bool kFastMath = true;
+inline void SinCos(float x, float& s, float& c) { fast::SinCos(x, s, c); }
+inline float Sin(float x) { return fast::Sin(x); }
+inline float Cos(float x) { return fast::Cos(x); }
+inline float Tan(float x) { return fast::Tan(x); }
+inline float Exp(float x) { return fast::Exp(x); }
+inline double Exp(double x) { return static_cast<double>(fast::Exp(static_cast<float>(x))); }
+inline float Acos(float x) { return fast::Acos(x); }
+#else
+inline constexpr bool kFastMath = false;
+inline void SinCos(float x, float& s, float& c) { s = std::sin(x); c = std::cos(x); }
+inline float Sin(float x) { return std::sin(x); }
+inline float Cos(float x) { return std::cos(x); }
+inline float Tan(float x) { return std::tan(x); }
+inline float Exp(float x) { return std::exp(x); }
+inline double Exp(double x) { return std::exp(x); }
+inline float Acos(float x) { return std::acos(x); }
+#endif
+
+}  // namespace trig
+
+}  // namespace math
+}  // namespace cameraunlock
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cmath>
+#include "cameraunlock/math/fast_math.h"
+#include "cameraunlock/math/simd_config.h"
 #include "cameraunlock/math/vec3.h"
 
 namespace cameraunlock {
@@ -8,7 +10,9 @@ namespace math {
 
 /// Immutable-style quaternion for rotation representation (xyzw component order).
 /// Port of CameraUnlock.Core.Data.Quat4 (C#).
-struct Quat4 {
+/// 16-byte aligned so the SIMD backend (simd_config.h) can load it as one
+/// vector; the size and member layout are the same in every build.
+struct alignas(16) Quat4 {
     float x = 0.0f;
     float y = 0.0f;
     float z = 0.0f;
@@ -25,11 +29,32 @@ struct Quat4 {
     Quat4 Inverse() const { return Quat4(-x, -y, -z, w); }
 
     float Dot(const Quat4& other) const {
+#if defined(CAMERAUNLOCK_SIMD_SSE)
+        __m128 m = _mm_mul_ps(Load(), other.Load());
+        __m128 shuf = _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1));
+        __m128 sums = _mm_add_ps(m, shuf);
+        shuf = _mm_movehl_ps(shuf, sums);
+        return _mm_cvtss_f32(_mm_add_ss(sums, shuf));
+#elif defined(CAMERAUNLOCK_SIMD_NEON)
+        return vaddvq_f32(vmulq_f32(Load(), other.Load()));
+#else
         return x * other.x + y * other.y + z * other.z + w * other.w;
+#endif
     }
 
     /// Rotates a vector by this quaternion: q * v * q^-1 (optimized).
     Vec3 Rotate(const Vec3& v) const {
+#if defined(CAMERAUNLOCK_SIMD_SSE) || defined(CAMERAUNLOCK_SIMD_NEON)
+        // v' = v + w*t + q.xyz x t, with t = 2 * (q.xyz x v)
+        Vec4 q = Load();
+        Vec4 vv = Set(v.x, v.y, v.z, 0.0f);
+        Vec4 t = Cross(q, vv);
+        t = Add(t, t);
+        Vec4 r = Add(Add(vv, Mul(Splat(w), t)), Cross(q, t));
+        alignas(16) float out[4];
+        Store(out, r);
+        return Vec3(out[0], out[1], out[2]);
+#else
         float x2 = x + x;
         float y2 = y + y;
         float z2 = z + z;
@@ -49,26 +74,82 @@ struct Quat4 {
             (xy2 + wz2) * v.x + (1.0f - xx2 - zz2) * v.y + (yz2 - wx2) * v.z,
             (xz2 - wy2) * v.x + (yz2 + wx2) * v.y + (1.0f - xx2 - yy2) * v.z
         );
+#endif
     }
 
     /// Multiplies two quaternions: this * b.
     Quat4 Multiply(const Quat4& b) const {
+#if defined(CAMERAUNLOCK_SIMD_SSE) || defined(CAMERAUNLOCK_SIMD_NEON)
+        // this * b = w*b + x*(bw,-bz,by,-bx) + y*(bz,bw,-bx,-by) + z*(-by,bx,bw,-bz)
+        Vec4 vb = b.Load();
+        Vec4 r = Mul(Splat(w), vb);
+        r = Add(r, Mul(Mul(Splat(x), SwizzleWZYX(vb)), Set(1.0f, -1.0f, 1.0f, -1.0f)));
+        r = Add(r, Mul(Mul(Splat(y), SwizzleZWXY(vb)), Set(1.0f, 1.0f, -1.0f, -1.0f)));
+        r = Add(r, Mul(Mul(Splat(z), SwizzleYXWZ(vb)), Set(-1.0f, 1.0f, 1.0f, -1.0f)));
+        Quat4 out;
+        out.StoreFrom(r);
+        return out;
+#else
         return Quat4(
             w * b.x + x * b.w + y * b.z - z * b.y,
             w * b.y - x * b.z + y * b.w + z * b.x,
             w * b.z + x * b.y - y * b.x + z * b.w,
             w * b.w - x * b.x - y * b.y - z * b.z
         );
+#endif
     }
 
     Quat4 operator*(const Quat4& b) const { return Multiply(b); }
 
     /// Returns a unit-length copy of this quaternion.
     Quat4 Normalized() const {
-        float len = std::sqrt(x * x + y * y + z * z + w * w);
+        float len = std::sqrt(Dot(*this));
         if (len < 1e-6f) return Identity();
         float inv = 1.0f / len;
+#if defined(CAMERAUNLOCK_SIMD_SSE) || defined(CAMERAUNLOCK_SIMD_NEON)
+        Quat4 out;
+        out.StoreFrom(Mul(Load(), Splat(inv)));
+        return out;
+#else
         return Quat4(x * inv, y * inv, z * inv, w * inv);
+#endif
+    }
+
+    /// Returns the rotation vector (axis * angle, radians) of this unit
+    /// quaternion, taking the shorter of q and -q. Inverse of FromRotationVector.
+    Vec3 ToRotationVector() const {
+        float sign = w < 0.0f ? -1.0f : 1.0f;
+        float vx = x * sign, vy = y * sign, vz = z * sign;
+        float sinHalf = std::sqrt(vx * vx + vy * vy + vz * vz);
+        if (sinHalf < 1e-6f) {
+            return Vec3(2.0f * vx, 2.0f * vy, 2.0f * vz);  // Small-angle limit
+        }
+        float k = 2.0f * std::atan2(sinHalf, w * sign) / sinHalf;
+        return Vec3(vx * k, vy * k, vz * k);
+    }
+
+    /// Creates a quaternion rotating by |v| radians about v.
+    static Quat4 FromRotationVector(const Vec3& v) {
+        float angle = v.Magnitude();
+        if (angle < 1e-6f) {
+            return Quat4(0.5f * v.x, 0.5f * v.y, 0.5f * v.z, 1.0f).Normalized();
+        }
+        float half = 0.5f * angle;
+        float sinHalf, cosHalf;
+        trig::SinCos(half, sinHalf, cosHalf);
+        float s = sinHalf / angle;
+        return Quat4(v.x * s, v.y * s, v.z * s, cosHalf);
+    }
+
+    /// Rotated basis vectors (columns of the rotation matrix) in the
+    /// Vec3::Right/Up/Forward convention. No trigonometry involved.
+    void ToBasis(Vec3& right, Vec3& up, Vec3& forward) const {
+        float xx = x * x, yy = y * y, zz = z * z;
+        float xy = x * y, xz = x * z, yz = y * z;
+        float wx = w * x, wy = w * y, wz = w * z;
+        right = Vec3(1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy));
+        up = Vec3(2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx));
+        forward = Vec3(2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy));
     }
 
     /// Creates a quaternion from YXZ Euler angles (yaw, pitch, roll in degrees).
@@ -79,12 +160,10 @@ struct Quat4 {
         float halfPitch = pitchDeg * kDegToRad * 0.5f;
         float halfRoll = rollDeg * kDegToRad * 0.5f;
 
-        float sy = std::sin(halfYaw);
-        float cy = std::cos(halfYaw);
-        float sp = std::sin(halfPitch);
-        float cp = std::cos(halfPitch);
-        float sr = std::sin(halfRoll);
-        float cr = std::cos(halfRoll);
+        float sy, cy, sp, cp, sr, cr;
+        trig::SinCos(halfYaw, sy, cy);
+        trig::SinCos(halfPitch, sp, cp);
+        trig::SinCos(halfRoll, sr, cr);
 
         return Quat4(
             cy * sp * cr + sy * cp * sr,
@@ -116,6 +195,9 @@ struct Quat4 {
         }
     }
 
+    /// Quaternion dot product above which Slerp falls back to nlerp.
+    static constexpr float kSlerpNlerpThreshold = 0.9995f;
+
     /// Spherical linear interpolation. Takes the shortest path through quaternion space.
     /// Matches C# QuaternionUtils.Slerp.
     static Quat4 Slerp(const Quat4& a, const Quat4& b, float t) {
@@ -128,8 +210,9 @@ struct Quat4 {
             dot = -dot;
         }
 
-        // Near-identical quaternions: normalized lerp to avoid division by ~0
-        if (dot > 0.9995f) {
+        // Near-identical quaternions: normalized lerp avoids division by ~0.
+        // At this threshold nlerp deviates from SLERP by < 6e-5 degrees.
+        if (dot > kSlerpNlerpThreshold) {
             return Quat4(
                 a.x + t * (sign * b.x - a.x),
                 a.y + t * (sign * b.y - a.y),
@@ -138,11 +221,11 @@ struct Quat4 {
             ).Normalized();
         }
 
-        float theta = std::acos(dot);
-        float sinTheta = std::sin(theta);
+        float theta = trig::Acos(dot);
+        float sinTheta = trig::Sin(theta);
         float invSinTheta = 1.0f / sinTheta;
-        float wa = std::sin((1.0f - t) * theta) * invSinTheta;
-        float wb = sign * std::sin(t * theta) * invSinTheta;
+        float wa = trig::Sin((1.0f - t) * theta) * invSinTheta;
+        float wb = sign * trig::Sin(t * theta) * invSinTheta;
 
         return Quat4(
             wa * a.x + wb * b.x,
@@ -151,6 +234,53 @@ struct Quat4 {
             wa * a.w + wb * b.w
         );
     }
+
+#if defined(CAMERAUNLOCK_SIMD_SSE) || defined(CAMERAUNLOCK_SIMD_NEON)
+private:
+    // Thin wrappers so the operations above read the same on both backends.
+#if defined(CAMERAUNLOCK_SIMD_SSE)
+    using Vec4 = __m128;
+    Vec4 Load() const { return _mm_load_ps(&x); }
+    void StoreFrom(Vec4 v) { _mm_store_ps(&x, v); }
+    static void Store(float* out, Vec4 v) { _mm_store_ps(out, v); }
+    static Vec4 Set(float a, float b, float c, float d) { return _mm_setr_ps(a, b, c, d); }
+    static Vec4 Splat(float a) { return _mm_set1_ps(a); }
+    static Vec4 Add(Vec4 a, Vec4 b) { return _mm_add_ps(a, b); }
+    static Vec4 Sub(Vec4 a, Vec4 b) { return _mm_sub_ps(a, b); }
+    static Vec4 Mul(Vec4 a, Vec4 b) { return _mm_mul_ps(a, b); }
+    static Vec4 SwizzleWZYX(Vec4 v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 1, 2, 3)); }
+    static Vec4 SwizzleZWXY(Vec4 v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)); }
+    static Vec4 SwizzleYXWZ(Vec4 v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)); }
+    static Vec4 SwizzleYZXW(Vec4 v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 0, 2, 1)); }
+    static Vec4 SwizzleZXYW(Vec4 v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 1, 0, 2)); }
+#else
+    using Vec4 = float32x4_t;
+    Vec4 Load() const { return vld1q_f32(&x); }
+    void StoreFrom(Vec4 v) { vst1q_f32(&x, v); }
+    static void Store(float* out, Vec4 v) { vst1q_f32(out, v); }
+    static Vec4 Set(float a, float b, float c, float d) {
+        alignas(16) const float lanes[4] = {a, b, c, d};
+        return vld1q_f32(lanes);
+    }
+    static Vec4 Splat(float a) { return vdupq_n_f32(a); }
+    static Vec4 Add(Vec4 a, Vec4 b) { return vaddq_f32(a, b); }
+    static Vec4 Sub(Vec4 a, Vec4 b) { return vsubq_f32(a, b); }
+    static Vec4 Mul(Vec4 a, Vec4 b) { return vmulq_f32(a, b); }
+    static Vec4 SwizzleYXWZ(Vec4 v) { return vrev64q_f32(v); }
+    static Vec4 SwizzleZWXY(Vec4 v) { return vextq_f32(v, v, 2); }
+    static Vec4 SwizzleWZYX(Vec4 v) { return SwizzleZWXY(vrev64q_f32(v)); }
+    static Vec4 SwizzleYZXW(Vec4 v) {
+        Vec4 r = vextq_f32(v, v, 1);                      // (y, z, w, x)
+        r = vsetq_lane_f32(vgetq_lane_f32(v, 0), r, 2);   // (y, z, x, x)
+        return vsetq_lane_f32(vgetq_lane_f32(v, 3), r, 3);
+    }
+    static Vec4 SwizzleZXYW(Vec4 v) { return SwizzleYZXW(SwizzleYZXW(v)); }
+#endif
+    // Cross product of the xyz lanes; the w lane cancels to zero.
+    static Vec4 Cross(Vec4 a, Vec4 b) {
+        return Sub(Mul(SwizzleYZXW(a), SwizzleZXYW(b)), Mul(SwizzleZXYW(a), SwizzleYZXW(b)));
+    }
+#endif
 };
 
 }  // namespace math
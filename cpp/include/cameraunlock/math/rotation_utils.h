@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cmath>
+#include "cameraunlock/math/fast_math.h"
 
 namespace cameraunlock::math {
 
@@ -36,7 +37,9 @@ inline void RotateAroundAxis(const float v[3], const float k[3],
 // Rotate vector v around axis k by angle in radians
 inline void RotateAroundAxis(const float v[3], const float k[3],
                              float angleRad, float out[3]) {
-    RotateAroundAxis(v, k, std::cos(angleRad), std::sin(angleRad), out);
+    float sinAngle, cosAngle;
+    trig::SinCos(angleRad, sinAngle, cosAngle);
+    RotateAroundAxis(v, k, cosAngle, sinAngle, out);
 }
 
 // Double precision versions
@@ -0,0 +1,20 @@
+#pragma once
+
+/// Compile-time SIMD backend selection for the math types.
+///
+/// Defining CAMERAUNLOCK_SIMD=1 (CMake option of the same name) enables the
+/// vector paths in Quat4 on targets that have a supported instruction set:
+///   CAMERAUNLOCK_SIMD_SSE   x86/x64 with SSE2 (baseline on x64)
+///   CAMERAUNLOCK_SIMD_NEON  AArch64 NEON
+/// Other targets, and builds without the option, use the scalar code. Both
+/// paths share one public API and memory layout.
+
+#if defined(CAMERAUNLOCK_SIMD) && CAMERAUNLOCK_SIMD
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CAMERAUNLOCK_SIMD_SSE 1
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define CAMERAUNLOCK_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+#endif
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cmath>
+#include "cameraunlock/math/fast_math.h"
 
 namespace cameraunlock {
 namespace math {
@@ -31,7 +32,7 @@ inline double CalculateSmoothingFactor(double smoothing, double delta_time) {
 
     // Map smoothing 0->50 speed, 1->0.1 speed
     double smoothing_speed = Lerp(50.0, 0.1, smoothing);
-    return 1.0 - std::exp(-smoothing_speed * delta_time);
+    return 1.0 - trig::Exp(-smoothing_speed * delta_time);
 }
 
 inline float CalculateSmoothingFactor(float smoothing, float delta_time) {
@@ -39,7 +40,7 @@ inline float CalculateSmoothingFactor(float smoothing, float delta_time) {
         return 1.0f;
     }
     float smoothing_speed = Lerp(50.0f, 0.1f, smoothing);
-    return 1.0f - std::exp(-smoothing_speed * delta_time);
+    return 1.0f - trig::Exp(-smoothing_speed * delta_time);
 }
 
 /// Applies smoothing to a single value.
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace cameraunlock::memory {
+
+// PE section characteristics (IMAGE_SCN_*), duplicated here so the
+// parser builds and can be tested without Windows headers
+constexpr uint32_t kSectionCode = 0x00000020;
+constexpr uint32_t kSectionInitializedData = 0x00000040;
+constexpr uint32_t kSectionUninitializedData = 0x00000080;
+constexpr uint32_t kSectionExecute = 0x20000000;
+constexpr uint32_t kSectionRead = 0x40000000;
+constexpr uint32_t kSectionWrite = 0x80000000;
+
+// One section of a mapped PE image
+struct ModuleSection {
+    char name[9];              // NUL-terminated, up to 8 characters
+    uintptr_t base;            // mapped address (image base + VirtualAddress)
+    size_t size;               // mapped size, clamped to the image
+    uint32_t characteristics;  // kSection* flags
+};
+
+// Which sections a scan covers
+// A section matches when its name equals `name` (if set), it has every
+// `required` flag and none of the `excluded` ones
+struct SectionFilter {
+    std::string_view name;
+    uint32_t required = 0;
+    uint32_t excluded = 0;
+
+    static SectionFilter Named(std::string_view section_name) { return {section_name, 0, 0}; }
+    static SectionFilter Executable() { return {{}, kSectionExecute, 0}; }
+    // .rdata-style sections: readable, not writable, not code
+    static SectionFilter ReadOnlyData() { return {{}, kSectionRead, kSectionWrite | kSectionExecute}; }
+    // Initialized non-code data (.data and .rdata), where RTTI lives
+    static SectionFilter InitializedData() { return {{}, kSectionInitializedData, kSectionExecute}; }
+};
+
+// Identifies one build of a module, for caching scan results
+// header_hash covers the mapped PE headers, which change with any relink
+// even when the linker leaves TimeDateStamp and CheckSum unset. ImageBase
+// is left out since the loader rewrites it on every ASLR relocation
+struct ModuleIdentity {
+    uint32_t time_date_stamp = 0;
+    uint32_t size_of_image = 0;
+    uint32_t checksum = 0;
+    uint32_t header_hash = 0;
+
+    bool operator==(const ModuleIdentity& other) const {
+        return time_date_stamp == other.time_date_stamp && size_of_image == other.size_of_image &&
+               checksum == other.checksum && header_hash == other.header_hash;
+    }
+    bool operator!=(const ModuleIdentity& other) const { return !(*this == other); }
+};
+
+bool SectionMatches(const ModuleSection& section, const SectionFilter& filter);
+
+// Parse the section table of a PE image mapped at base
+// size bounds every header read; sections are returned in address order
+// Returns false if the headers are missing or malformed
+bool GetImageSections(uintptr_t base, size_t size, std::vector<ModuleSection>& out);
+
+// Same for a loaded module handle
+bool GetModuleSections(void* module, std::vector<ModuleSection>& out);
+
+// Read the identity of a PE image mapped at base
+// Returns false if the headers are missing or malformed
+bool GetImageIdentity(uintptr_t base, size_t size, ModuleIdentity& out);
+
+} // namespace cameraunlock::memory
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+
+#include "cameraunlock/memory/pattern_scanner.h"
+
+namespace cameraunlock::memory {
+
+// Byte pattern parsed, validated and anchored at compile time
+// Build one with CU_PATTERN; it converts to PatternView, so every scan
+// overload taking a PatternView accepts it without parsing or allocating
+template <size_t N>
+struct StaticPattern {
+    uint8_t bytes[N] = {};
+    uint8_t care[N] = {};  // 0xFF = must match, 0x00 = wildcard
+    size_t anchor = 0;
+    size_t second = 0;
+    bool has_anchor = false;
+
+    static constexpr size_t kLength = N;
+
+    constexpr operator PatternView() const {
+        return {bytes, care, N, anchor, second, has_anchor};
+    }
+};
+
+namespace pattern_detail {
+
+constexpr bool IsSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+constexpr int HexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+} // namespace pattern_detail
+
+// Number of bytes in a "48 8B 05 ?? ??" pattern, or 0 if it's malformed
+// Same grammar as the runtime parser: whitespace-separated hex byte
+// pairs, with ? or ?? for a wildcard byte
+constexpr size_t CountPatternBytes(std::string_view pattern) {
+    size_t count = 0;
+    size_t i = 0;
+    while (i < pattern.size()) {
+        if (pattern_detail::IsSpace(pattern[i])) {
+            ++i;
+            continue;
+        }
+        if (pattern[i] == '?') {
+            ++i;
+            if (i < pattern.size() && pattern[i] == '?') ++i;
+        } else {
+            if (i + 1 >= pattern.size()) return 0;
+            if (pattern_detail::HexValue(pattern[i]) < 0 || pattern_detail::HexValue(pattern[i + 1]) < 0) return 0;
+            i += 2;
+        }
+        ++count;
+    }
+    return count;
+}
+
+// N must come from CountPatternBytes on the same string
+template <size_t N>
+constexpr StaticPattern<N> MakeStaticPattern(std::string_view pattern) {
+    static_assert(N > 0, "malformed byte pattern: expected hex byte pairs and ?? wildcards");
+
+    StaticPattern<N> out{};
+    size_t count = 0;
+    size_t i = 0;
+    while (i < pattern.size() && count < N) {
+        if (pattern_detail::IsSpace(pattern[i])) {
+            ++i;
+            continue;
+        }
+        if (pattern[i] == '?') {
+            ++i;
+            if (i < pattern.size() && pattern[i] == '?') ++i;
+            out.bytes[count] = 0;
+            out.care[count] = 0x00;
+        } else {
+            out.bytes[count] = static_cast<uint8_t>(pattern_detail::HexValue(pattern[i]) * 16 +
+                                                    pattern_detail::HexValue(pattern[i + 1]));
+            out.care[count] = 0xFF;
+            i += 2;
+        }
+        ++count;
+    }
+
+    ChoosePatternAnchors(out.bytes, out.care, N, out.anchor, out.second, out.has_anchor);
+    return out;
+}
+
+} // namespace cameraunlock::memory
+
+// Compile-time pattern literal; a malformed string fails the build
+//   static constexpr auto kGetCamera = CU_PATTERN("48 8B 05 ?? ?? ?? ?? 48 85 C0");
+//   void* hit = cameraunlock::memory::ScanPattern(module, kGetCamera);
+#define CU_PATTERN(literal)                                                                  \
+    ([]() constexpr {                                                                        \
+        constexpr auto cu_pattern_ = ::cameraunlock::memory::MakeStaticPattern<              \
+            ::cameraunlock::memory::CountPatternBytes(literal)>(literal);                    \
+        return cu_pattern_;                                                                  \
+    }())
@@ -3,6 +3,9 @@
 #include <cstdint>
 #include <cstddef>
 #include <string_view>
+#include <vector>
+
+#include "cameraunlock/memory/module_sections.h"
 
 #ifdef _WIN32
 #include <Windows.h>
@@ -14,7 +17,8 @@ namespace cameraunlock::memory {
 // Returns false if module is null or info cannot be retrieved
 bool GetModuleRange(void* module, uintptr_t& base, size_t& size);
 
-// Scan for byte pattern in module
+// Scan for byte pattern in module, on the calling thread
+// Safe from DllMain; see ScanPatternParallel for large images off the loader lock
 // Pattern uses ?? for wildcards, e.g., "48 8B 05 ?? ?? ?? ??"
 // Returns nullptr if pattern not found
 void* ScanPattern(void* module, std::string_view pattern);
@@ -26,12 +30,196 @@ void* ScanPattern(void* module, std::string_view pattern);
 void* ScanPatternMask(void* module, const uint8_t* pattern, const char* mask, size_t length);
 
 // Scan for byte pattern in a specific memory range
+// Candidates are located by searching for the pattern's two rarest
+// non-wildcard bytes (AVX2 when the CPU has it, otherwise SSE2 or memchr)
+// and then verified with a masked compare; results match a byte-by-byte scan
 // Returns nullptr if pattern not found
 void* ScanPatternInRange(uintptr_t base, size_t size, std::string_view pattern);
 
 // Scan for byte pattern with explicit mask in a specific memory range
 void* ScanPatternMaskInRange(uintptr_t base, size_t size, const uint8_t* pattern, const char* mask, size_t length);
 
+// Rough frequency rank of a byte value in x64 code and data: higher means
+// more common, so a worse anchor. Padding, REX prefixes and the usual mov /
+// lea / call opcodes dominate; everything else is treated as equally rare.
+constexpr int PatternByteCommonness(uint8_t b) {
+    switch (b) {
+        case 0x00: return 10;
+        case 0xFF: case 0xCC: return 9;
+        case 0x48: return 8;
+        case 0x8B: case 0x89: return 7;
+        case 0x0F: case 0x4C: case 0x24: case 0x44: return 6;
+        case 0xE8: case 0x8D: case 0x85: case 0xC0: case 0x01: case 0x90: return 5;
+        case 0x83: case 0x49: case 0x74: case 0x75: case 0xC3: case 0x41: return 4;
+        default: return 0;
+    }
+}
+
+// Pick the rarest fixed byte as the anchor and the next rarest (preferring
+// a different value, so the pair filters better) as the second anchor
+// constexpr so literal patterns get their anchors at compile time
+constexpr void ChoosePatternAnchors(const uint8_t* bytes, const uint8_t* care, size_t length,
+                                    size_t& anchor, size_t& second, bool& has_anchor) {
+    has_anchor = false;
+    anchor = 0;
+    int bestScore = 0;
+    for (size_t i = 0; i < length; ++i) {
+        if (!care[i]) continue;
+        const int score = PatternByteCommonness(bytes[i]);
+        if (!has_anchor || score < bestScore) {
+            anchor = i;
+            bestScore = score;
+            has_anchor = true;
+        }
+    }
+
+    second = anchor;
+    if (!has_anchor) return;
+    int secondScore = 0;
+    bool haveSecond = false;
+    for (size_t i = 0; i < length; ++i) {
+        if (!care[i] || i == anchor) continue;
+        int score = PatternByteCommonness(bytes[i]) * 2;
+        if (bytes[i] == bytes[anchor]) score += 1;
+        if (!haveSecond || score < secondScore) {
+            second = i;
+            secondScore = score;
+            haveSecond = true;
+        }
+    }
+}
+
+// Non-owning view of a prepared pattern: the bytes, a byte-wide care
+// mask for vector compares, and the two anchor positions searched for to
+// find candidates. Every scan runs on this, so scanning allocates nothing.
+struct PatternView {
+    const uint8_t* bytes = nullptr;
+    const uint8_t* care = nullptr;  // 0xFF = must match, 0x00 = wildcard
+    size_t length = 0;
+    size_t anchor = 0;
+    size_t second = 0;
+    bool has_anchor = false;  // false when every byte is a wildcard
+};
+
+// Pattern compiled at runtime; see pattern_literal.h for literals
+// compiled at build time
+struct CompiledPattern {
+    std::vector<uint8_t> bytes;
+    std::vector<uint8_t> care;  // 0xFF = must match, 0x00 = wildcard
+    size_t anchor = 0;
+    size_t second = 0;
+    bool has_anchor = false;  // false when every byte is a wildcard
+
+    size_t Length() const { return bytes.size(); }
+
+    operator PatternView() const {
+        return {bytes.data(), care.data(), bytes.size(), anchor, second, has_anchor};
+    }
+};
+
+// Compile a "48 8B 05 ?? ??" style pattern; returns false if it doesn't parse
+bool CompilePattern(std::string_view pattern, CompiledPattern& out);
+
+// Compile an explicit pattern/mask pair; returns false if length is zero
+bool CompilePatternMask(const uint8_t* pattern, const char* mask, size_t length, CompiledPattern& out);
+
+// Scan a range for an already compiled pattern
+// Returns nullptr if pattern not found
+void* ScanCompiledInRange(uintptr_t base, size_t size, const PatternView& pattern);
+
+// Overloads for prepared patterns, e.g. ScanPattern(module, CU_PATTERN("48 8B 05 ?? ?? ?? ??"))
+void* ScanPattern(void* module, const PatternView& pattern);
+void* ScanPatternInRange(uintptr_t base, size_t size, const PatternView& pattern);
+
+// Work splitting for large scans
+struct ParallelScanOptions {
+    unsigned max_threads = 0;             // 0 = hardware threads, capped at 4
+    size_t chunk_size = 4u << 20;         // candidate bytes per work item
+    size_t min_parallel_size = 16u << 20; // smaller ranges scan on the calling thread
+};
+
+// Scan a range split into chunks across a few worker threads
+// Chunks are handed out in address order and skipped once an earlier match
+// exists, so the result is always the lowest-address match
+// Starts and joins the workers on every call: never call it (or the other
+// *Parallel scans) from DllMain, where joining under the loader lock deadlocks
+void* ScanCompiledParallel(uintptr_t base, size_t size, const PatternView& pattern,
+                           const ParallelScanOptions& options = {});
+
+// Opt-in parallel versions of ScanPattern, for an init thread scanning a
+// large image
+void* ScanPatternParallel(void* module, std::string_view pattern, const ParallelScanOptions& options = {});
+void* ScanPatternParallel(void* module, const PatternView& pattern, const ParallelScanOptions& options = {});
+
+// Scan only the sections of a mapped PE image selected by filter, on the
+// calling thread
+// Returns the lowest-address match, or nullptr if none or the headers
+// can't be parsed
+void* ScanImageSections(uintptr_t image_base, size_t image_size, const SectionFilter& filter,
+                        std::string_view pattern);
+void* ScanImageSections(uintptr_t image_base, size_t image_size, const SectionFilter& filter,
+                        const PatternView& pattern);
+
+// Same, splitting large sections across worker threads (see ScanCompiledParallel)
+void* ScanImageSectionsParallel(uintptr_t image_base, size_t image_size, const SectionFilter& filter,
+                                std::string_view pattern, const ParallelScanOptions& options = {});
+void* ScanImageSectionsParallel(uintptr_t image_base, size_t image_size, const SectionFilter& filter,
+                                const PatternView& pattern, const ParallelScanOptions& options = {});
+
+// Same for a loaded module, e.g. SectionFilter::Executable() for code
+// signatures or SectionFilter::Named(".rdata")
+void* ScanPatternInSections(void* module, const SectionFilter& filter, std::string_view pattern);
+void* ScanPatternInSections(void* module, const SectionFilter& filter, const PatternView& pattern);
+
+// Resolves many signatures in one pass over an image
+// Patterns are bucketed by anchor byte; each position of the range is
+// tested once against the set of anchors, so cost scales with the image
+// size rather than image size times pattern count
+class PatternBatch {
+public:
+    // Register a pattern
+    // Returns its index, or -1 if it doesn't parse or has no fixed bytes
+    // (an all-wildcard pattern matches everywhere and can't be bucketed)
+    int Add(std::string_view pattern);
+    int AddMask(const uint8_t* pattern, const char* mask, size_t length);
+    int Add(const PatternView& pattern);
+
+    // Remove all patterns and results
+    void Clear();
+
+    size_t GetPatternCount() const { return m_entries.size(); }
+
+    // Scan once for every registered pattern, replacing previous results
+    // Match counts and first matches are always recorded; collect_all
+    // additionally keeps every match address
+    void ScanRange(uintptr_t base, size_t size, bool collect_all = false);
+
+    // Scan a loaded module; returns false if its range can't be retrieved
+    bool ScanModule(void* module, bool collect_all = false);
+
+    // Lowest matching address, or nullptr
+    void* GetFirstMatch(size_t index) const;
+
+    // Number of matches; anything but 1 usually means a stale or
+    // ambiguous signature
+    size_t GetMatchCount(size_t index) const;
+
+    // Every match in address order (empty unless scanned with collect_all)
+    const std::vector<void*>& GetMatches(size_t index) const;
+
+private:
+    struct Entry {
+        CompiledPattern pattern;
+        void* first = nullptr;
+        size_t count = 0;
+        std::vector<void*> matches;
+    };
+
+    int AddCompiled(CompiledPattern&& pattern);
+
+    std::vector<Entry> m_entries;
+};
+
 // Resolve RIP-relative address from an instruction
 // instruction: pointer to the start of the instruction containing the RIP-relative offset
 // offset_position: byte offset within instruction where the 32-bit displacement starts
@@ -41,7 +229,11 @@ void* ResolveRIPRelative(void* instruction, int offset_position, int instruction
 
 // Scan for RTTI class name and return pointer to complete object locator
 // Useful for finding class instances via their type info
+// Only initialized data sections are searched when the headers parse
 // class_name should be the mangled name, e.g., ".?AVGuiCrosshairData@@"
 void* FindRTTIDescriptor(void* module, std::string_view class_name);
 
+// Same for a mapped image given by range
+void* FindRTTIDescriptorInImage(uintptr_t image_base, size_t image_size, std::string_view class_name);
+
 } // namespace cameraunlock::memory
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "cameraunlock/memory/rtti_vtable.h"
+
+namespace cameraunlock::memory {
+
+// One RTTI type found in the image
+struct RttiClass {
+    std::string name;                // mangled, e.g. ".?AVCCustomCamera@@"
+    uintptr_t type_descriptor = 0;
+    std::vector<uintptr_t> cols;     // CompleteObjectLocators referencing the descriptor
+    std::vector<uintptr_t> vtables;  // vfunc[0] of the vtable using each COL (parallel to cols)
+};
+
+// Every MSVC x64 RTTI class of a module, indexed in one pass
+// Building walks the data sections once for TypeDescriptor names and
+// .rdata once for vtable slots pointing at a self-validating COL; after
+// that, class lookups are hash lookups instead of full-image scans each
+class RttiIndex {
+public:
+    // Index a loaded module; returns false if its range can't be retrieved
+    bool Build(void* module);
+
+    // Index an image given by range; sections are used when the headers
+    // parse, otherwise the whole range is walked
+    bool BuildImage(uintptr_t image_base, size_t image_size);
+
+    void Clear();
+
+    // Lookup by mangled name (".?AVFoo@@")
+    const RttiClass* FindMangled(std::string_view mangled_name) const;
+
+    // Lookup by undecorated name ("Foo"), as a class first and then a struct
+    const RttiClass* FindClass(std::string_view class_name) const;
+
+    // Classes whose mangled name contains fragment, in name order
+    // Walks the name list, not the image
+    size_t FindContaining(std::string_view fragment, std::vector<const RttiClass*>& out) const;
+
+    // Vtable for a COL address, or 0
+    uintptr_t GetVtableForCol(uintptr_t col) const;
+
+    // Like FindVtableFromRTTI, but prefers the complete object's primary
+    // vtable (COL offset 0) over secondary-base vtables
+    // Reads up to max_vfuncs entries, stopping at the first non-module address
+    bool FindVtable(std::string_view class_name, VtableInfo& info, int max_vfuncs = 8) const;
+
+    size_t GetClassCount() const { return m_classes.size(); }
+    const std::vector<RttiClass>& GetClasses() const { return m_classes; }
+
+private:
+    uintptr_t m_base = 0;
+    size_t m_size = 0;
+    std::vector<RttiClass> m_classes;                        // sorted by name
+    std::unordered_map<std::string_view, size_t> m_byName;   // views into m_classes names
+    std::unordered_map<uint32_t, uint32_t> m_colToVtable;    // COL RVA -> vtable RVA
+};
+
+} // namespace cameraunlock::memory
@@ -4,6 +4,8 @@
 #include <cstddef>
 #include <string_view>
 
+#include "cameraunlock/memory/signature_cache.h"
+
 namespace cameraunlock::memory {
 
 // Maximum vtable entries to read
@@ -30,4 +32,18 @@ bool FindVtableFromRTTI(void* module, std::string_view class_name,
 bool FindVtableFromTypeDescriptor(void* module, void* type_descriptor,
                                   VtableInfo& info, int max_vfuncs = 8);
 
+// Re-read a remembered vtable without scanning
+// vtable: absolute address of vfunc[0], e.g. a stored RVA rebased onto module
+// Returns true if slot -1 still points at a COL whose self-reference and
+// type descriptor name match class_name, and at least one vfunc is in range
+bool ReadVtableAt(void* module, uintptr_t vtable, std::string_view class_name,
+                  VtableInfo& info, int max_vfuncs = 8);
+
+// Cached variant over the cache's bound image
+// A warm start re-validates the remembered vtable (slot -1 points at a COL
+// whose self-reference and type descriptor name still match) instead of
+// scanning; on a miss the descriptor lookup goes through the cache too.
+bool FindVtableFromRTTI(SignatureCache& cache, std::string_view class_name,
+                        VtableInfo& info, int max_vfuncs = 8);
+
 } // namespace cameraunlock::memory
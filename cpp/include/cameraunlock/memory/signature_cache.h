@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "cameraunlock/memory/module_sections.h"
+
+namespace cameraunlock::memory {
+
+// Remembers resolved addresses across launches, keyed by module build
+// Entries are stored as RVAs in a small text file next to the mod and are
+// re-validated against the live image before use, so a stale or corrupt
+// file can only cost a rescan, never a wrong address
+class SignatureCache {
+public:
+    // What an entry resolves; part of the key so the same text used as a
+    // pattern and as a class name can't collide
+    enum class EntryKind : char {
+        Pattern = 'P',
+        RttiDescriptor = 'R',
+        Vtable = 'V',
+    };
+
+    // Bind to a loaded module and load path if it was written for the same
+    // build (TimeDateStamp, SizeOfImage, CheckSum and a header hash)
+    // Returns false if the module's headers can't be read; lookups then
+    // pass straight through to a scan and nothing is cached
+    bool Open(const std::string& path, void* module);
+
+    // Same for an image given by range
+    bool OpenImage(const std::string& path, uintptr_t image_base, size_t image_size);
+
+    // Write the file if anything changed since Open
+    // Returns false on I/O failure
+    bool Save();
+
+    // Cached ScanPattern over the whole image
+    void* ScanPattern(std::string_view pattern);
+
+    // Cached FindRTTIDescriptor
+    void* FindRTTIDescriptor(std::string_view class_name);
+
+    // Raw access for other resolvers (e.g. vtables, see rtti_vtable.h)
+    // Lookup doesn't validate; the caller must check the address still
+    // holds what it expects and Erase the entry if not
+    bool Lookup(EntryKind kind, std::string_view key, uintptr_t& address) const;
+    void Store(EntryKind kind, std::string_view key, uintptr_t address);
+    void Erase(EntryKind kind, std::string_view key);
+
+    // Whether the module identity could be read
+    bool IsBound() const { return m_bound; }
+
+    // Whether Open found a file written for this exact build
+    bool WasLoaded() const { return m_loaded; }
+
+    const ModuleIdentity& GetIdentity() const { return m_identity; }
+    uintptr_t GetImageBase() const { return m_base; }
+    size_t GetImageSize() const { return m_size; }
+
+    // Lookups answered from the cache vs. resolved by scanning
+    size_t GetHitCount() const { return m_hits; }
+    size_t GetMissCount() const { return m_misses; }
+    size_t GetEntryCount() const { return m_entries.size(); }
+
+private:
+    static uint64_t HashKey(EntryKind kind, std::string_view key);
+    void Load();
+
+    std::string m_path;
+    uintptr_t m_base = 0;
+    size_t m_size = 0;
+    ModuleIdentity m_identity;
+    bool m_bound = false;
+    bool m_loaded = false;
+    bool m_dirty = false;
+    std::unordered_map<uint64_t, uint32_t> m_entries;  // key hash -> RVA
+    size_t m_hits = 0;
+    size_t m_misses = 0;
+};
+
+} // namespace cameraunlock::memory
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstdint>
+#include "cameraunlock/data/position_settings.h"
+#include "cameraunlock/data/tracking_pose.h"
+#include "cameraunlock/math/quat4.h"
+#include "cameraunlock/math/vec3.h"
+#include "cameraunlock/processing/center_offset_manager.h"
+#include "cameraunlock/processing/sample_interpolator.h"
+
+namespace cameraunlock {
+
+/// Output of one HeadPoseProcessor::Step.
+struct HeadPoseFrame {
+    enum Flags : uint32_t {
+        kRotationValid = 1u << 0,  // rotation/euler fields hold a processed pose
+        kPositionValid = 1u << 1,  // position field holds a processed offset
+        kNewSample = 1u << 2       // a tracker sample arrived since the last step
+    };
+
+    math::Quat4 rotation;          // processed rotation (sensitivity applied)
+    float yaw = 0.0f;              // same rotation as YXZ Euler, degrees
+    float pitch = 0.0f;
+    float roll = 0.0f;
+    math::Vec3 position;           // processed head offset, meters
+    uint32_t flags = 0;
+
+    bool IsRotationValid() const { return (flags & kRotationValid) != 0; }
+    bool IsPositionValid() const { return (flags & kPositionValid) != 0; }
+    bool IsNewSample() const { return (flags & kNewSample) != 0; }
+};
+
+/// Fused 6DOF per-frame pipeline: interpolation, rotation processing and
+/// position processing in one call over one contiguous state block.
+///
+/// Equivalent to chaining PoseInterpolator + PositionInterpolator ->
+/// TrackingProcessor -> PositionProcessor, except the interpolators share
+/// one sample-interval estimate and each frame's smoothing coefficients
+/// are computed once (a single exp() when rotation and position smoothing
+/// match).
+///
+///   UdpReceiver::TryGetSample -> HeadPoseProcessor::Step -> Camera
+class HeadPoseProcessor {
+public:
+    HeadPoseProcessor() = default;
+
+    /// Runs the full chain for one frame.
+    /// @param sample Latest tracker sample (repeated samples are detected by sequence).
+    /// @param delta_time Frame delta time in seconds.
+    /// @return Packed result; flags are clear while no valid sample exists.
+    HeadPoseFrame Step(const TrackingSample& sample, float delta_time);
+
+    /// Uses the current (interpolated) raw pose as the new center for both
+    /// rotation and position.
+    void Recenter();
+
+    /// Resets all state including the center.
+    void Reset();
+
+    // Rotation configuration
+    void SetSensitivity(const SensitivitySettings& sensitivity) { m_sensitivity = sensitivity; }
+    void SetDeadzone(const DeadzoneSettings& deadzone) { m_deadzone = deadzone; }
+    void SetSmoothing(float smoothing) { m_rotationSmoothing = smoothing; }
+    const SensitivitySettings& GetSensitivity() const { return m_sensitivity; }
+    const DeadzoneSettings& GetDeadzone() const { return m_deadzone; }
+    float GetSmoothing() const { return m_rotationSmoothing; }
+
+    // Position configuration
+    void SetPositionSettings(const PositionSettings& settings) { m_positionSettings = settings; }
+    const PositionSettings& GetPositionSettings() const { return m_positionSettings; }
+    void SetPositionEnabled(bool enabled) { m_positionEnabled = enabled; }
+    bool IsPositionEnabled() const { return m_positionEnabled; }
+    float GetTrackerPivotForward() const { return m_trackerPivotForward; }
+    void SetTrackerPivotForward(float value) { m_trackerPivotForward = value; }
+
+    // Interpolation configuration
+    void SetInterpolationEnabled(bool enabled) { m_interpolationEnabled = enabled; }
+    bool IsInterpolationEnabled() const { return m_interpolationEnabled; }
+    float GetMaxExtrapolationFraction() const { return m_maxExtrapolationFraction; }
+    void SetMaxExtrapolationFraction(float value) { m_maxExtrapolationFraction = value; }
+
+private:
+    using Interpolator = SampleInterpolator<6>;  // yaw, pitch, roll, x, y, z
+
+    // State — kept together so a step touches a handful of cache lines
+    Interpolator m_interpolator;
+    Interpolator::Value m_lastRaw{};
+    CenterOffsetManager m_rotationCenter;
+    math::Vec3 m_positionCenter;
+    math::Quat4 m_smoothedQuat;
+    math::Vec3 m_smoothedPosition;
+    uint64_t m_lastSequence = 0;
+    bool m_hasSmoothedValue = false;
+    bool m_hasRaw = false;
+
+    // Configuration
+    SensitivitySettings m_sensitivity = SensitivitySettings::Default();
+    DeadzoneSettings m_deadzone = DeadzoneSettings::None();
+    PositionSettings m_positionSettings;
+    float m_rotationSmoothing = 0.0f;
+    float m_trackerPivotForward = 0.15f;
+    float m_maxExtrapolationFraction = 0.5f;
+    bool m_positionEnabled = true;
+    bool m_interpolationEnabled = true;
+};
+
+}  // namespace cameraunlock
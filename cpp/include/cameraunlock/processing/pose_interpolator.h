@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstdint>
+#include "cameraunlock/processing/sample_interpolator.h"
+
 namespace cameraunlock {
 
 /// Return type for PoseInterpolator — interpolated rotation values in degrees.
@@ -27,6 +30,11 @@ public:
     /// on high-refresh displays (e.g. 240 Hz).
     float max_extrapolation_fraction = 0.5f;
 
+    /// Render delay for UpdateTimestamped(), in microseconds. Output trails
+    /// the render clock by this much so it is normally bracketed by two
+    /// real samples; one tracker period (default: 60 Hz) is sufficient.
+    int64_t render_delay_us = 16667;
+
     PoseInterpolator() = default;
 
     /// Update with the latest raw pose and frame timing.
@@ -38,98 +46,37 @@ public:
     /// @return Smoothly interpolated pose.
     inline InterpolatedPose Update(float yaw, float pitch, float roll,
                                    bool is_new_sample, float delta_time) {
-        m_timeSinceLastNewSample += delta_time;
-
-        if (is_new_sample) {
-            if (!m_hasFirstSample) {
-                // Very first sample — park at this position
-                m_fromYaw = yaw;    m_fromPitch = pitch;    m_fromRoll = roll;
-                m_toYaw = yaw;      m_toPitch = pitch;      m_toRoll = roll;
-                m_progress = 1.0f;
-                m_timeSinceLastNewSample = 0.0f;
-                m_hasFirstSample = true;
-                return {yaw, pitch, roll};
-            }
-
-            // Update sample interval estimate (EMA)
-            if (m_timeSinceLastNewSample > kMinSampleInterval) {
-                if (!m_hasSecondSample) {
-                    m_sampleInterval = m_timeSinceLastNewSample;
-                    m_hasSecondSample = true;
-                } else {
-                    m_sampleInterval += (m_timeSinceLastNewSample - m_sampleInterval) * kIntervalBlend;
-                }
-                if (m_sampleInterval < kMinSampleInterval) m_sampleInterval = kMinSampleInterval;
-                if (m_sampleInterval > kMaxSampleInterval) m_sampleInterval = kMaxSampleInterval;
-            }
-
-            // Capture current interpolated (possibly extrapolated) position as new start point
-            float maxP = 1.0f + max_extrapolation_fraction;
-            float t = m_progress < 0.0f ? 0.0f : (m_progress > maxP ? maxP : m_progress);
-            m_fromYaw   = m_fromYaw   + (m_toYaw   - m_fromYaw)   * t;
-            m_fromPitch = m_fromPitch + (m_toPitch - m_fromPitch) * t;
-            m_fromRoll  = m_fromRoll  + (m_toRoll  - m_fromRoll)  * t;
-
-            // New sample becomes the target
-            m_toYaw = yaw;    m_toPitch = pitch;    m_toRoll = roll;
-            m_progress = 0.0f;
-            m_timeSinceLastNewSample = 0.0f;
-        }
+        auto out = m_interpolator.Update({yaw, pitch, roll}, is_new_sample, delta_time,
+                                         max_extrapolation_fraction);
+        return {out[0], out[1], out[2]};
+    }
 
-        if (!m_hasFirstSample) {
+    /// Timestamp-driven update: renders at render_us - render_delay_us over
+    /// recent samples instead of estimating the sample interval from frame
+    /// deltas. Both timestamps share one clock (e.g. the sample's receive
+    /// timestamp and the frame's present time, steady_clock microseconds).
+    /// Passing the same sample_us again only re-renders.
+    /// @param sample_us Receive time of this pose.
+    /// @param render_us Render time of the current frame.
+    /// @return Interpolated (or briefly extrapolated) pose.
+    inline InterpolatedPose UpdateTimestamped(float yaw, float pitch, float roll,
+                                              int64_t sample_us, int64_t render_us) {
+        m_interpolator.AddSample({yaw, pitch, roll}, sample_us);
+        Interpolator::Value out;
+        if (!m_interpolator.Evaluate(render_us, render_delay_us, max_extrapolation_fraction, out)) {
             return {yaw, pitch, roll};
         }
-
-        // Advance interpolation
-        m_progress += delta_time / m_sampleInterval;
-
-        // Allow extrapolation past 1.0 to maintain velocity continuity,
-        // bounded to avoid runaway prediction on direction reversals.
-        float maxPt = 1.0f + max_extrapolation_fraction;
-        float pt = m_progress > maxPt ? maxPt : (m_progress < 0.0f ? 0.0f : m_progress);
-
-        float outYaw   = m_fromYaw   + (m_toYaw   - m_fromYaw)   * pt;
-        float outPitch = m_fromPitch + (m_toPitch - m_fromPitch) * pt;
-        float outRoll  = m_fromRoll  + (m_toRoll  - m_fromRoll)  * pt;
-
-        return {outYaw, outPitch, outRoll};
+        return {out[0], out[1], out[2]};
     }
 
     /// Resets all interpolation state. Call on recenter, scene transitions, or tracking re-enable.
     inline void Reset() {
-        m_fromYaw = 0.0f;    m_fromPitch = 0.0f;    m_fromRoll = 0.0f;
-        m_toYaw = 0.0f;      m_toPitch = 0.0f;      m_toRoll = 0.0f;
-        m_progress = 0.0f;
-        m_sampleInterval = kDefaultSampleInterval;
-        m_timeSinceLastNewSample = 0.0f;
-        m_hasFirstSample = false;
-        m_hasSecondSample = false;
+        m_interpolator.Reset();
     }
 
 private:
-    // EMA blend factor for sample interval estimation
-    static constexpr float kIntervalBlend = 0.3f;
-    // Default until we observe real samples
-    static constexpr float kDefaultSampleInterval = 1.0f / 60.0f;
-    // Bounds for sample interval estimate
-    static constexpr float kMinSampleInterval = 0.001f;
-    static constexpr float kMaxSampleInterval = 0.2f;
-
-    // Interpolation segment: lerp from → to
-    float m_fromYaw = 0.0f, m_fromPitch = 0.0f, m_fromRoll = 0.0f;
-    float m_toYaw = 0.0f, m_toPitch = 0.0f, m_toRoll = 0.0f;
-
-    // Progress within current segment (0 = at from, 1 = at to)
-    float m_progress = 0.0f;
-
-    // EMA-smoothed estimate of time between tracker samples
-    float m_sampleInterval = kDefaultSampleInterval;
-
-    // Accumulated wall time since last new sample arrived
-    float m_timeSinceLastNewSample = 0.0f;
-
-    bool m_hasFirstSample = false;
-    bool m_hasSecondSample = false;
+    using Interpolator = SampleInterpolator<3>;
+    Interpolator m_interpolator;
 };
 
 }  // namespace cameraunlock
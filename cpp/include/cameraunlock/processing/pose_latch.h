@@ -0,0 +1,65 @@
+#pragma once
+
+#include "cameraunlock/data/tracking_pose.h"
+#include "cameraunlock/protocol/tracking_source.h"
+
+namespace cameraunlock {
+
+/// Rotation change between the sample a frame was rendered with and the
+/// freshest one, in degrees (source space, before any processing).
+struct LatchedPoseDelta {
+    float yaw = 0.0f;
+    float pitch = 0.0f;
+    float roll = 0.0f;
+    int64_t rendered_timestamp_us = 0; ///< receive time of the frame's sample
+    int64_t latest_timestamp_us = 0;   ///< receive time of the freshest sample
+    bool valid = false;                ///< false: apply nothing
+
+    /// True if newer data arrived after the frame's pose was read.
+    bool IsLate() const { return valid && latest_timestamp_us != rendered_timestamp_us; }
+};
+
+/// Late-latch bookkeeping for overlay geometry.
+/// The game thread registers the raw sample its camera used for the frame
+/// being built; the Present hook then asks for the change since, so overlay
+/// elements drawn there can be corrected by the sub-frame delta instead of
+/// lagging one or two frames. Working on raw samples (no recenter offset)
+/// keeps the delta stable across a recenter.
+/// Single writer (the game thread) and lock-free reads from any thread.
+class PoseLatch {
+public:
+    /// Default limit on each delta axis, in degrees; a larger jump (tracker
+    /// reconnect, stale frame) is clamped rather than applied whole.
+    static constexpr float kDefaultMaxDelta = 15.0f;
+
+    PoseLatch() = default;
+    explicit PoseLatch(const ITrackingSource* source) : m_source(source) {}
+
+    /// Source to read the freshest sample from. Not owned.
+    void SetSource(const ITrackingSource* source) { m_source = source; }
+
+    void SetMaxDelta(float degrees) { m_maxDelta = degrees; }
+
+    /// Game thread: registers the sample the camera was built from.
+    void SetRenderedSample(const TrackingSample& sample);
+
+    /// Game thread: reads the source's latest sample, registers it as this
+    /// frame's pose and returns it, replacing an early TryGetSample.
+    /// @return False if the source has no data (nothing is registered).
+    bool CaptureFrameSample(TrackingSample& sample);
+
+    /// Present: freshest sample minus the registered one, wrapped to
+    /// +-180 and clamped to the max delta. Zero (and valid) when no newer
+    /// sample has arrived.
+    LatchedPoseDelta Latch() const;
+
+    /// Forget the registered frame, e.g. while the camera isn't tracked.
+    void Reset() { m_rendered.Reset(); }
+
+private:
+    const ITrackingSource* m_source = nullptr;
+    SharedTrackingSample m_rendered;
+    float m_maxDelta = kDefaultMaxDelta;
+};
+
+}  // namespace cameraunlock
@@ -6,6 +6,7 @@
 #include "cameraunlock/math/quat4.h"
 #include "cameraunlock/math/smoothing_utils.h"
 #include "cameraunlock/math/angle_utils.h"
+#include "cameraunlock/runtime/settings_channel.h"
 
 namespace cameraunlock {
 
@@ -21,12 +22,24 @@ public:
     const PositionSettings& GetSettings() const { return m_settings; }
     void SetSettings(const PositionSettings& settings) { m_settings = settings; }
 
+    /// Binds a settings channel for thread-safe live tuning; Process adopts
+    /// the newest published PositionSettings (one acquire load when
+    /// unchanged). Pass nullptr to unbind.
+    void SetSettingsChannel(const SettingsChannel<PositionSettings>* channel) {
+        m_settingsChannel = channel;
+        m_settingsVersion = 0;
+    }
+
     float GetTrackerPivotForward() const { return m_trackerPivotForward; }
     void SetTrackerPivotForward(float value) { m_trackerPivotForward = value; }
 
     /// Processes a raw position through the full pipeline.
     math::Vec3 Process(const PositionData& raw, const math::Quat4& processed_rotation_q,
                        float delta_time) {
+        if (m_settingsChannel) {
+            m_settingsChannel->ReadIfChanged(m_settingsVersion, m_settings);
+        }
+
         if (!raw.IsValid()) {
             return math::Vec3::Zero();
         }
@@ -101,6 +114,8 @@ public:
 private:
     PositionSettings m_settings;
     float m_trackerPivotForward = 0.15f;
+    const SettingsChannel<PositionSettings>* m_settingsChannel = nullptr;
+    uint64_t m_settingsVersion = 0;
 
     math::Vec3 m_center;
     math::Vec3 m_smoothedPosition;
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+#include "cameraunlock/math/quat4.h"
+#include "cameraunlock/math/vec3.h"
+
+namespace cameraunlock {
+
+/// Rotation filter selectable on TrackingProcessor.
+enum class RotationFilterMode {
+    Exponential,       // Frame-rate independent SLERP smoothing (default)
+    OneEuro,           // Velocity-adaptive cutoff: smooth when still, fast when moving
+    ConstantVelocity   // Kalman filter on orientation + angular velocity
+};
+
+/// One Euro filter parameters (Casiez et al. 2012), in rotation terms.
+struct OneEuroSettings {
+    float min_cutoff_hz = 1.0f;         // Cutoff at rest; lower = less jitter
+    float beta = 2.0f;                  // Cutoff increase per rad/s of head speed
+    float derivative_cutoff_hz = 1.0f;  // Cutoff for the velocity estimate
+};
+
+/// Constant-velocity Kalman parameters.
+struct ConstantVelocitySettings {
+    float process_noise = 50.0f;          // Angular acceleration spectral density, (rad/s^2)^2 * s
+    float measurement_noise = 1.0e-5f;    // Tracker orientation noise variance, rad^2
+};
+
+/// Quaternion filter that estimates angular velocity and predicts forward.
+/// Feed timestamped measurements with Update(), then ask for the orientation
+/// at a target time (e.g. expected display time) with Predict(). Velocity
+/// is kept in the body frame, so prediction is q * exp(omega * dt).
+class PredictiveFilter {
+public:
+    /// Prediction horizon cap; beyond this extrapolation overshoots.
+    static constexpr float kDefaultMaxPredictionSeconds = 0.05f;
+
+    void SetMode(RotationFilterMode mode) { m_mode = mode; Reset(); }
+    RotationFilterMode GetMode() const { return m_mode; }
+
+    void SetOneEuroSettings(const OneEuroSettings& settings) { m_oneEuro = settings; }
+    void SetConstantVelocitySettings(const ConstantVelocitySettings& settings) { m_constantVelocity = settings; }
+    void SetMaxPrediction(float seconds) { m_maxPredictionSeconds = seconds; }
+
+    const OneEuroSettings& GetOneEuroSettings() const { return m_oneEuro; }
+    const ConstantVelocitySettings& GetConstantVelocitySettings() const { return m_constantVelocity; }
+    float GetMaxPrediction() const { return m_maxPredictionSeconds; }
+
+    /// Clears all state; the next measurement initializes the filter.
+    void Reset();
+
+    /// Incorporates a measurement taken at timestamp_us (steady_clock).
+    /// Repeated or older timestamps are ignored.
+    void Update(const math::Quat4& measurement, int64_t timestamp_us);
+
+    /// Filtered orientation extrapolated to target_us (clamped to
+    /// [last measurement, last measurement + max prediction]).
+    math::Quat4 Predict(int64_t target_us) const;
+
+    /// Filtered orientation at the last measurement time.
+    const math::Quat4& GetFiltered() const { return m_filtered; }
+
+    /// Estimated body-frame angular velocity (rad/s).
+    const math::Vec3& GetAngularVelocity() const { return m_velocity; }
+
+    bool HasValue() const { return m_initialized; }
+    int64_t GetLastTimestamp() const { return m_lastTimestampUs; }
+
+private:
+    void UpdateOneEuro(const math::Quat4& measurement, float dt);
+    void UpdateConstantVelocity(const math::Quat4& measurement, float dt);
+
+    RotationFilterMode m_mode = RotationFilterMode::OneEuro;
+    OneEuroSettings m_oneEuro;
+    ConstantVelocitySettings m_constantVelocity;
+    float m_maxPredictionSeconds = kDefaultMaxPredictionSeconds;
+
+    math::Quat4 m_filtered;
+    math::Quat4 m_lastMeasurement;
+    math::Vec3 m_velocity;
+    int64_t m_lastTimestampUs = 0;
+    bool m_initialized = false;
+
+    // Kalman covariance for [angle, angular velocity], shared by all axes
+    float m_p00 = 0.0f;
+    float m_p01 = 0.0f;
+    float m_p11 = 0.0f;
+};
+
+}  // namespace cameraunlock
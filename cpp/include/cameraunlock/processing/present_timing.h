@@ -0,0 +1,87 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace cameraunlock {
+
+/// Frame pacing observed at the swap chain, in microseconds.
+struct PresentTimingEstimate {
+    int64_t last_present_us = 0;    ///< steady-clock time of the latest Present call
+    int64_t frame_interval_us = 0;  ///< median Present-to-Present interval, 0 = unknown
+    int64_t scanout_latency_us = 0; ///< median Present-to-vblank latency, 0 = unknown
+};
+
+/// Present-interval sampler for display-time prediction.
+/// The Present hook records when each frame was submitted and, where the
+/// swap chain reports frame statistics, the vblank that frame was scanned
+/// out at. From those it keeps the median frame interval and the median
+/// present-to-scanout latency, so the processing layer can predict the
+/// pose for the moment the next frame reaches the screen instead of
+/// extrapolating by the last frame's delta time:
+///   processor.ProcessPredicted(s.yaw, s.pitch, s.roll, s.timestamp_us,
+///                              sampler.PredictNextDisplayTime())
+/// All times are steady-clock microseconds, the same base as
+/// TrackingSample::timestamp_us.
+/// Single writer (the Present thread) and lock-free reads from any thread.
+class PresentTimingSampler {
+public:
+    /// Presents (and intervals) kept for the median.
+    static constexpr size_t kHistory = 32;
+    /// Scanout latencies kept for the median.
+    static constexpr size_t kLatencyHistory = 16;
+    /// Longer gaps (loading screens, alt-tab) aren't frame intervals.
+    static constexpr int64_t kMaxIntervalUs = 250000;
+
+    /// Present thread: a frame was presented at present_us. present_id is
+    /// the swap chain's present count for it (GetLastPresentCount), or 0
+    /// if unknown; only identified presents can be matched to a scanout.
+    void RecordPresent(int64_t present_us, uint32_t present_id = 0);
+
+    /// Present thread: the present with this id reached the screen at the
+    /// vblank at scanout_us (GetFrameStatistics PresentCount/SyncQPCTime).
+    /// Ignored unless the present is still in the history and the latency
+    /// is plausible; repeated reports of the same present count once.
+    void RecordScanout(uint32_t present_id, int64_t scanout_us);
+
+    /// Writer-side: forget all history, e.g. after a swap chain resize.
+    void Reset();
+
+    /// Current estimate. The fields are read independently, so one taken
+    /// during a Present may mix two consecutive updates.
+    PresentTimingEstimate GetEstimate() const;
+
+    /// Expected scanout time of the next frame to be presented: the latest
+    /// Present plus whole frame intervals until past now_us, plus the
+    /// scanout latency (zero without frame statistics, which predicts the
+    /// Present time itself). Returns 0 until an interval is known, so
+    /// callers can fall back to delta-time extrapolation.
+    int64_t PredictNextDisplayTime(int64_t now_us) const;
+
+    /// PredictNextDisplayTime at the current steady-clock time.
+    int64_t PredictNextDisplayTime() const;
+
+private:
+    void PublishInterval();
+
+    // Writer-only history
+    int64_t m_presentUs[kHistory] = {};
+    uint32_t m_presentIds[kHistory] = {};
+    int64_t m_intervalUs[kHistory] = {};
+    int64_t m_latencyUs[kLatencyHistory] = {};
+    size_t m_presentNext = 0;
+    size_t m_presentCount = 0;
+    size_t m_intervalNext = 0;
+    size_t m_intervalCount = 0;
+    size_t m_latencyNext = 0;
+    size_t m_latencyCount = 0;
+    uint32_t m_lastScanoutId = 0;
+
+    // Published estimate
+    std::atomic<int64_t> m_lastPresent{0};
+    std::atomic<int64_t> m_interval{0};
+    std::atomic<int64_t> m_latency{0};
+};
+
+}  // namespace cameraunlock
@@ -0,0 +1,200 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace cameraunlock {
+
+/// Linear interpolator over N independent axes, shared by PoseInterpolator
+/// (yaw/pitch/roll) and PositionInterpolator (x/y/z).
+///
+/// Two modes:
+///  - Frame-delta: Update() advances through the current segment by
+///    delta_time / estimated sample interval. Needs only frame timing.
+///  - Timestamp: AddSample() records samples by receive time and Evaluate()
+///    renders at (render time - delay) over a short history. Playback is
+///    exact at any refresh rate because no interval estimate is involved.
+template <size_t N>
+class SampleInterpolator {
+public:
+    using Value = std::array<float, N>;
+
+    /// Samples kept for timestamp mode; enough to cover the render delay at
+    /// high tracker rates.
+    static constexpr size_t kHistorySize = 8;
+
+    /// Frame-delta mode. max_extrapolation_fraction bounds how far past the
+    /// newest sample the segment may continue, in sample intervals.
+    Value Update(const Value& raw, bool is_new_sample, float delta_time,
+                 float max_extrapolation_fraction) {
+        m_timeSinceLastNewSample += delta_time;
+
+        if (is_new_sample) {
+            if (!m_hasFirstSample) {
+                // Very first sample — park at this position
+                m_from = raw;
+                m_to = raw;
+                m_progress = 1.0f;
+                m_timeSinceLastNewSample = 0.0f;
+                m_hasFirstSample = true;
+                return raw;
+            }
+
+            // Update sample interval estimate (EMA)
+            if (m_timeSinceLastNewSample > kMinSampleInterval) {
+                if (!m_hasSecondSample) {
+                    m_sampleInterval = m_timeSinceLastNewSample;
+                    m_hasSecondSample = true;
+                } else {
+                    m_sampleInterval += (m_timeSinceLastNewSample - m_sampleInterval) * kIntervalBlend;
+                }
+                if (m_sampleInterval < kMinSampleInterval) m_sampleInterval = kMinSampleInterval;
+                if (m_sampleInterval > kMaxSampleInterval) m_sampleInterval = kMaxSampleInterval;
+            }
+
+            // Capture current interpolated (possibly extrapolated) position as new start point
+            m_from = Lerp(m_from, m_to, ClampProgress(m_progress, max_extrapolation_fraction));
+
+            // New sample becomes the target
+            m_to = raw;
+            m_progress = 0.0f;
+            m_timeSinceLastNewSample = 0.0f;
+        }
+
+        if (!m_hasFirstSample) {
+            return raw;
+        }
+
+        // Advance interpolation
+        m_progress += delta_time / m_sampleInterval;
+
+        // Allow extrapolation past 1.0 to maintain velocity continuity,
+        // bounded to avoid runaway prediction on direction reversals.
+        return Lerp(m_from, m_to, ClampProgress(m_progress, max_extrapolation_fraction));
+    }
+
+    /// Timestamp mode: records a sample received at sample_us. Samples that
+    /// are not newer than the last one are ignored; a gap longer than the
+    /// maximum sample interval restarts the history so playback does not
+    /// glide across a tracking dropout.
+    void AddSample(const Value& raw, int64_t sample_us) {
+        if (m_historyCount > 0) {
+            int64_t newest = m_historyTimes[Index(m_historyCount - 1)];
+            if (sample_us <= newest) {
+                return;
+            }
+            if (sample_us - newest > kMaxSampleIntervalUs) {
+                m_historyCount = 0;
+            }
+        }
+
+        if (m_historyCount == kHistorySize) {
+            m_historyStart = (m_historyStart + 1) % kHistorySize;
+            --m_historyCount;
+        }
+        size_t slot = Index(m_historyCount);
+        m_historyTimes[slot] = sample_us;
+        m_historyValues[slot] = raw;
+        ++m_historyCount;
+    }
+
+    /// Timestamp mode: value at render_us - delay_us. Interpolates between
+    /// the bracketing samples, or extrapolates from the newest two for up to
+    /// max_extrapolation_fraction of their interval. Returns false with no
+    /// history.
+    bool Evaluate(int64_t render_us, int64_t delay_us, float max_extrapolation_fraction,
+                  Value& out) const {
+        if (m_historyCount == 0) {
+            return false;
+        }
+
+        int64_t target = render_us - delay_us;
+        if (m_historyCount == 1 || target <= m_historyTimes[Index(0)]) {
+            out = m_historyValues[Index(0)];
+            return true;
+        }
+
+        for (size_t i = 1; i < m_historyCount; ++i) {
+            int64_t t1 = m_historyTimes[Index(i)];
+            if (target <= t1) {
+                int64_t t0 = m_historyTimes[Index(i - 1)];
+                float t = static_cast<float>(target - t0) / static_cast<float>(t1 - t0);
+                out = Lerp(m_historyValues[Index(i - 1)], m_historyValues[Index(i)], t);
+                return true;
+            }
+        }
+
+        // Past the newest sample: continue the last segment's velocity.
+        size_t last = Index(m_historyCount - 1);
+        size_t prev = Index(m_historyCount - 2);
+        float interval = static_cast<float>(m_historyTimes[last] - m_historyTimes[prev]);
+        float over = static_cast<float>(target - m_historyTimes[last]) / interval;
+        if (over > max_extrapolation_fraction) over = max_extrapolation_fraction;
+        out = Lerp(m_historyValues[prev], m_historyValues[last], 1.0f + over);
+        return true;
+    }
+
+    /// Timestamp of the newest recorded sample, or 0 with no history.
+    int64_t GetNewestSampleTime() const {
+        return m_historyCount > 0 ? m_historyTimes[Index(m_historyCount - 1)] : 0;
+    }
+
+    /// Resets both modes.
+    void Reset() {
+        m_from = Value{};
+        m_to = Value{};
+        m_progress = 0.0f;
+        m_sampleInterval = kDefaultSampleInterval;
+        m_timeSinceLastNewSample = 0.0f;
+        m_hasFirstSample = false;
+        m_hasSecondSample = false;
+        m_historyStart = 0;
+        m_historyCount = 0;
+    }
+
+private:
+    // EMA blend factor for sample interval estimation
+    static constexpr float kIntervalBlend = 0.3f;
+    // Default until we observe real samples
+    static constexpr float kDefaultSampleInterval = 1.0f / 60.0f;
+    // Bounds for sample interval estimate
+    static constexpr float kMinSampleInterval = 0.001f;
+    static constexpr float kMaxSampleInterval = 0.2f;
+    static constexpr int64_t kMaxSampleIntervalUs = 200000;
+
+    static Value Lerp(const Value& a, const Value& b, float t) {
+        Value out;
+        for (size_t i = 0; i < N; ++i) {
+            out[i] = a[i] + (b[i] - a[i]) * t;
+        }
+        return out;
+    }
+
+    static float ClampProgress(float progress, float max_extrapolation_fraction) {
+        float maxP = 1.0f + max_extrapolation_fraction;
+        return progress < 0.0f ? 0.0f : (progress > maxP ? maxP : progress);
+    }
+
+    size_t Index(size_t i) const { return (m_historyStart + i) % kHistorySize; }
+
+    // Frame-delta mode: segment lerped from -> to
+    Value m_from{};
+    Value m_to{};
+    // Progress within current segment (0 = at from, 1 = at to)
+    float m_progress = 0.0f;
+    // EMA-smoothed estimate of time between tracker samples
+    float m_sampleInterval = kDefaultSampleInterval;
+    // Accumulated wall time since last new sample arrived
+    float m_timeSinceLastNewSample = 0.0f;
+    bool m_hasFirstSample = false;
+    bool m_hasSecondSample = false;
+
+    // Timestamp mode: oldest-first ring of recent samples
+    std::array<int64_t, kHistorySize> m_historyTimes{};
+    std::array<Value, kHistorySize> m_historyValues{};
+    size_t m_historyStart = 0;
+    size_t m_historyCount = 0;
+};
+
+}  // namespace cameraunlock
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include "cameraunlock/data/tracking_pose.h"
+#include "cameraunlock/math/quat4.h"
+#include "cameraunlock/processing/tracking_processor.h"
+#include "cameraunlock/runtime/spsc_queue.h"
+
+namespace cameraunlock {
+
+/// One pose processed at tracker rate.
+struct ProcessedPose {
+    math::Quat4 rotation;      // processed rotation (sensitivity applied)
+    int64_t timestamp_us = 0;  // measurement time of its sample (TrackingSample::MeasurementUs)
+    uint64_t sequence = 0;     // source sample's sequence, 0 = none
+
+    bool IsValid() const { return sequence != 0; }
+};
+
+/// Runs TrackingProcessor on the receiver's thread at the tracker's sample
+/// rate instead of on the game thread at frame rate.
+///
+/// Filtering per sample makes smoothing and prediction behave the same at
+/// 30 and 144 fps, and takes the SLERP, trig and exp() of the processing
+/// stages out of the frame. The game thread only blends the two newest
+/// processed poses to its render time with a normalized lerp: no trig,
+/// no exp, one short lock-free read.
+///
+///   receiver.SetSampleCallback([&](const TrackingSample& s) { stage.OnSample(s); });
+///   // game thread, each frame:
+///   math::Quat4 rotation;
+///   if (stage.Evaluate(TrackingPose::CurrentTimestamp(), rotation)) ...
+///
+/// Configure GetProcessor() before samples flow; afterwards tune it
+/// through TrackingProcessor::SetSettingsChannel, and recenter or reset
+/// through this class, whose commands the sample thread applies before its
+/// next sample. One thread calls OnSample; one (other) thread issues
+/// commands; any thread may read.
+class SampleRateProcessor {
+public:
+    /// Sample intervals above this are a tracking gap: the filter is not
+    /// stepped across them as one long frame, and Evaluate holds the newest
+    /// pose instead of blending across the gap.
+    static constexpr int64_t kMaxSampleGapUs = 100000;
+
+    /// Pending Recenter/Reset commands before the sample thread runs.
+    static constexpr size_t kCommandCapacity = 16;
+
+    SampleRateProcessor() = default;
+
+    SampleRateProcessor(const SampleRateProcessor&) = delete;
+    SampleRateProcessor& operator=(const SampleRateProcessor&) = delete;
+
+    /// Sample thread (receive or runtime thread): processes one new sample
+    /// and publishes the result. Repeated sequences are ignored.
+    void OnSample(const TrackingSample& sample);
+
+    /// Game thread: processed rotation at render_us - render delay.
+    /// Interpolates between the two newest processed poses, or extrapolates
+    /// past the newest by up to the max extrapolation fraction of their
+    /// interval, then holds.
+    /// @return False until a sample has been processed.
+    bool Evaluate(int64_t render_us, math::Quat4& rotation) const;
+
+    /// Newest processed pose, without blending.
+    /// @return False until a sample has been processed.
+    bool TryGetLatest(ProcessedPose& pose) const;
+
+    /// Queues a recenter on the current smoothed pose; takes effect on the
+    /// next sample. @return False if the command queue is full.
+    bool Recenter();
+
+    /// Queues a reset of the filter state and center.
+    /// @return False if the command queue is full.
+    bool Reset();
+
+    /// Evaluate's render delay. 0 (default) extrapolates from the newest
+    /// pose; about one tracker interval interpolates instead, trading that
+    /// much latency for no overshoot. Game thread.
+    void SetRenderDelayUs(int64_t delay_us) { m_renderDelayUs = delay_us; }
+    int64_t GetRenderDelayUs() const { return m_renderDelayUs; }
+
+    /// How far past the newest pose Evaluate may extrapolate, in intervals
+    /// between the two newest poses. Game thread.
+    void SetMaxExtrapolationFraction(float fraction) { m_maxExtrapolationFraction = fraction; }
+    float GetMaxExtrapolationFraction() const { return m_maxExtrapolationFraction; }
+
+    /// The processor run on the sample thread (see class comment).
+    TrackingProcessor& GetProcessor() { return m_processor; }
+
+private:
+    enum class Command : uint8_t { Recenter, Reset };
+
+    // Newest and previous pose, published together
+    struct PosePair {
+        ProcessedPose latest;
+        ProcessedPose previous;
+    };
+
+    struct Slot {
+        std::atomic<float> latest[4] = {};    // x, y, z, w
+        std::atomic<float> previous[4] = {};
+        std::atomic<int64_t> latest_us{0};
+        std::atomic<int64_t> previous_us{0};
+        std::atomic<uint64_t> latest_sequence{0};
+        std::atomic<uint64_t> previous_sequence{0};
+
+        void Store(const PosePair& pair);
+        void Load(PosePair& pair) const;
+    };
+
+    void ApplyCommands();
+    void Publish(const PosePair& pair);
+    bool TryRead(PosePair& pair) const;
+
+    // Sample thread only
+    TrackingProcessor m_processor;
+    PosePair m_pair;
+    int64_t m_lastSampleUs = 0;
+
+    SpscQueue<Command, kCommandCapacity> m_commands;
+
+    // Two-copy latch, as in SharedTrackingSample
+    std::atomic<uint32_t> m_latch{0};
+    Slot m_slots[2];
+
+    // Game thread configuration
+    int64_t m_renderDelayUs = 0;
+    float m_maxExtrapolationFraction = 0.5f;
+};
+
+}  // namespace cameraunlock
@@ -0,0 +1,222 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include "cameraunlock/data/tracking_pose.h"
+#include "cameraunlock/math/deadzone_utils.h"
+#include "cameraunlock/math/quat4.h"
+#include "cameraunlock/math/smoothing_utils.h"
+#include "cameraunlock/processing/center_offset_manager.h"
+#include "cameraunlock/processing/predictive_filter.h"
+
+namespace cameraunlock {
+
+/// Representation a pipeline stage reads and writes.
+enum class PipelineDomain { Euler, Quaternion };
+
+/// Per-call state threaded through the stages. Euler fields are degrees.
+struct PipelineState {
+    float yaw = 0.0f;
+    float pitch = 0.0f;
+    float roll = 0.0f;
+    math::Quat4 rotation;
+    float delta_time = 0.0f;
+    int64_t sample_us = 0;
+    int64_t target_us = 0;
+};
+
+/// Built-in stages for TrackingPipeline. A stage is any type with
+///   static constexpr PipelineDomain kDomain;
+///   void Apply(PipelineState& state);
+///   void Reset();
+/// Stages in the Euler domain read/write yaw/pitch/roll, quaternion stages
+/// read/write rotation; the pipeline converts only where adjacent stages
+/// disagree.
+namespace pipeline {
+
+/// Subtracts the recenter offset (see TrackingProcessor step 1).
+struct CenterOffset {
+    static constexpr PipelineDomain kDomain = PipelineDomain::Euler;
+    CenterOffsetManager center;
+
+    void Apply(PipelineState& s) { center.ApplyOffset(s.yaw, s.pitch, s.roll); }
+    void Reset() { center.Reset(); }
+};
+
+/// Per-axis deadzone (see TrackingProcessor step 2).
+struct Deadzone {
+    static constexpr PipelineDomain kDomain = PipelineDomain::Euler;
+    DeadzoneSettings settings = DeadzoneSettings::None();
+
+    void Apply(PipelineState& s) {
+        s.yaw = static_cast<float>(math::ApplyDeadzone(s.yaw, settings.yaw));
+        s.pitch = static_cast<float>(math::ApplyDeadzone(s.pitch, settings.pitch));
+        s.roll = static_cast<float>(math::ApplyDeadzone(s.roll, settings.roll));
+    }
+    void Reset() {}
+};
+
+/// Frame-rate independent SLERP smoothing (see TrackingProcessor step 3).
+struct SlerpSmooth {
+    static constexpr PipelineDomain kDomain = PipelineDomain::Quaternion;
+    float smoothing = 0.0f;
+
+    void Apply(PipelineState& s) {
+        if (!m_hasValue) {
+            m_smoothed = s.rotation;
+            m_hasValue = true;
+        } else {
+            float t = static_cast<float>(math::CalculateSmoothingFactor(
+                math::GetEffectiveSmoothing(smoothing), static_cast<double>(s.delta_time)));
+            m_smoothed = math::Quat4::Slerp(m_smoothed, s.rotation, t);
+        }
+        s.rotation = m_smoothed;
+    }
+    void Reset() {
+        m_smoothed = math::Quat4::Identity();
+        m_hasValue = false;
+    }
+
+private:
+    math::Quat4 m_smoothed;
+    bool m_hasValue = false;
+};
+
+/// One Euro / constant-velocity filter with prediction to target_us.
+struct Predict {
+    static constexpr PipelineDomain kDomain = PipelineDomain::Quaternion;
+    PredictiveFilter filter;
+
+    void Apply(PipelineState& s) {
+        if (!filter.HasValue() || s.sample_us > filter.GetLastTimestamp()) {
+            filter.Update(s.rotation, s.sample_us);
+        }
+        s.rotation = filter.Predict(s.target_us);
+    }
+    void Reset() { filter.Reset(); }
+};
+
+/// Per-axis sensitivity and inversion (see TrackingProcessor step 4).
+struct Sensitivity {
+    static constexpr PipelineDomain kDomain = PipelineDomain::Euler;
+    SensitivitySettings settings = SensitivitySettings::Default();
+
+    void Apply(PipelineState& s) {
+        s.yaw *= settings.invert_yaw ? -settings.yaw : settings.yaw;
+        s.pitch *= settings.invert_pitch ? -settings.pitch : settings.pitch;
+        s.roll *= settings.invert_roll ? -settings.roll : settings.roll;
+    }
+    void Reset() {}
+};
+
+}  // namespace pipeline
+
+/// Compile-time composed alternative to TrackingProcessor: only the listed
+/// stages run, in order, and the whole chain inlines into one function.
+/// Use when the configuration is known at build time, e.g.
+///
+///   TrackingPipeline<pipeline::CenterOffset, pipeline::SlerpSmooth> p;
+///   p.Get<pipeline::SlerpSmooth>().smoothing = 0.3f;
+///   TrackingPose pose = p.Process(yaw, pitch, roll, dt);
+///
+/// TrackingProcessor remains the runtime-configured pipeline.
+template <typename... Stages>
+class TrackingPipeline {
+public:
+    /// Runs the stages on raw Euler input (degrees).
+    TrackingPose Process(float yaw, float pitch, float roll, float delta_time) {
+        PipelineState s = Run(yaw, pitch, roll, delta_time, AdvanceClock(delta_time));
+        ToDomain<kOutputDomain, PipelineDomain::Euler>(s);
+        return TrackingPose(s.yaw, s.pitch, s.roll);
+    }
+
+    /// Same as Process but returns a quaternion, skipping the final Euler
+    /// decomposition when the last stage already works on quaternions.
+    math::Quat4 ProcessQuat(float yaw, float pitch, float roll, float delta_time) {
+        PipelineState s = Run(yaw, pitch, roll, delta_time, AdvanceClock(delta_time));
+        ToDomain<kOutputDomain, PipelineDomain::Quaternion>(s);
+        return s.rotation;
+    }
+
+    /// Timestamped variant for pipelines containing pipeline::Predict.
+    TrackingPose ProcessPredicted(float yaw, float pitch, float roll,
+                                  int64_t sample_us, int64_t target_us) {
+        float dt = m_clockUs != 0 ? static_cast<float>(sample_us - m_clockUs) * 1e-6f : 0.0f;
+        if (sample_us > m_clockUs) m_clockUs = sample_us;
+        PipelineState s = Run(yaw, pitch, roll, dt, sample_us, target_us);
+        ToDomain<kOutputDomain, PipelineDomain::Euler>(s);
+        return TrackingPose(s.yaw, s.pitch, s.roll);
+    }
+
+    /// Access to a stage's settings and state (each stage type may appear once).
+    template <typename Stage>
+    Stage& Get() { return std::get<Stage>(m_stages); }
+
+    template <typename Stage>
+    const Stage& Get() const { return std::get<Stage>(m_stages); }
+
+    /// Resets every stage.
+    void Reset() {
+        std::apply([](auto&... stage) { (stage.Reset(), ...); }, m_stages);
+        m_clockUs = 0;
+    }
+
+private:
+    static constexpr PipelineDomain LastDomain() {
+        PipelineDomain d = PipelineDomain::Euler;
+        ((d = Stages::kDomain), ...);
+        return d;
+    }
+    static constexpr PipelineDomain kOutputDomain = LastDomain();
+
+    template <PipelineDomain From, PipelineDomain To>
+    static void ToDomain(PipelineState& s) {
+        if constexpr (From == PipelineDomain::Euler && To == PipelineDomain::Quaternion) {
+            s.rotation = math::Quat4::FromYawPitchRoll(s.yaw, s.pitch, s.roll);
+        } else if constexpr (From == PipelineDomain::Quaternion && To == PipelineDomain::Euler) {
+            s.rotation.ToEulerYXZ(s.yaw, s.pitch, s.roll);
+        }
+    }
+
+    int64_t AdvanceClock(float delta_time) {
+        m_clockUs += static_cast<int64_t>(static_cast<double>(delta_time) * 1e6);
+        return m_clockUs;
+    }
+
+    PipelineState Run(float yaw, float pitch, float roll, float delta_time, int64_t now_us) {
+        return Run(yaw, pitch, roll, delta_time, now_us, now_us);
+    }
+
+    PipelineState Run(float yaw, float pitch, float roll, float delta_time,
+                      int64_t sample_us, int64_t target_us) {
+        PipelineState s;
+        s.yaw = yaw;
+        s.pitch = pitch;
+        s.roll = roll;
+        s.delta_time = delta_time;
+        s.sample_us = sample_us;
+        s.target_us = target_us;
+        RunFrom<0, PipelineDomain::Euler>(s);
+        return s;
+    }
+
+    template <size_t I, PipelineDomain Current>
+    void RunFrom(PipelineState& s) {
+        if constexpr (I < sizeof...(Stages)) {
+            using Stage = std::tuple_element_t<I, std::tuple<Stages...>>;
+            ToDomain<Current, Stage::kDomain>(s);
+            std::get<I>(m_stages).Apply(s);
+            RunFrom<I + 1, Stage::kDomain>(s);
+        }
+    }
+
+    std::tuple<Stages...> m_stages;
+    int64_t m_clockUs = 0;
+};
+
+/// TrackingProcessor's default chain as a compile-time pipeline.
+using StandardTrackingPipeline = TrackingPipeline<pipeline::CenterOffset, pipeline::Deadzone,
+                                                  pipeline::SlerpSmooth, pipeline::Sensitivity>;
+
+}  // namespace cameraunlock
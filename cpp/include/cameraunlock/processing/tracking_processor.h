@@ -1,13 +1,23 @@
 #pragma once
 
 #include "cameraunlock/data/tracking_pose.h"
+#include "cameraunlock/diagnostics/pipeline_trace.h"
 #include "cameraunlock/math/quat4.h"
 #include "cameraunlock/processing/center_offset_manager.h"
+#include "cameraunlock/processing/predictive_filter.h"
+#include "cameraunlock/runtime/settings_channel.h"
 
 namespace cameraunlock {
 
+/// Hot-reloadable TrackingProcessor configuration (see SetSettingsChannel).
+struct TrackingProcessorSettings {
+    SensitivitySettings sensitivity = SensitivitySettings::Default();
+    DeadzoneSettings deadzone = DeadzoneSettings::None();
+    float smoothing = 0.0f;
+};
+
 /// Complete tracking data processing pipeline.
-/// Pipeline: raw -> offset -> deadzone -> smooth -> sensitivity
+/// Pipeline: raw -> offset -> deadzone -> smooth/filter -> [predict] -> sensitivity
 class TrackingProcessor {
 public:
     TrackingProcessor() = default;
@@ -20,6 +30,37 @@ public:
     /// @return Processed pose.
     TrackingPose Process(float yaw, float pitch, float roll, float delta_time);
 
+    /// Processes a timestamped sample and predicts the pose at target_us,
+    /// compensating for tracker-to-display latency. Timestamps share one
+    /// clock (e.g. TrackingSample::timestamp_us and the expected frame
+    /// present time). Calling again with the same sample_us only re-predicts.
+    /// @param sample_us Time the sample was measured, in microseconds.
+    /// @param target_us Time the pose will be displayed, in microseconds.
+    TrackingPose ProcessPredicted(float yaw, float pitch, float roll,
+                                  int64_t sample_us, int64_t target_us);
+
+    /// Process on a receiver sample (raw values; recenter through this
+    /// processor), stamping the sample's PipelineTrace record if one is set.
+    TrackingPose Process(const TrackingSample& sample, float delta_time);
+
+    /// ProcessPredicted on a receiver sample, predicting from its
+    /// MeasurementUs (the sender's clock-corrected capture time for extended
+    /// packets, else the receive time); stamps the sample's PipelineTrace record if one is set.
+    TrackingPose ProcessPredicted(const TrackingSample& sample, int64_t target_us);
+
+    /// Quaternion-native variant of Process for engines that consume
+    /// rotations directly: skips the Euler decomposition of the output.
+    /// Sensitivity and inversion scale the rotation vector (pitch = X,
+    /// yaw = Y, roll = Z), which matches Process exactly for single-axis
+    /// motion and closely for compound motion. With unit sensitivity and
+    /// no inversion the filtered quaternion is returned untouched.
+    /// The result can feed PositionProcessor::Process directly.
+    math::Quat4 ProcessQuat(float yaw, float pitch, float roll, float delta_time);
+
+    /// Quaternion-native variant of ProcessPredicted.
+    math::Quat4 ProcessQuatPredicted(float yaw, float pitch, float roll,
+                                     int64_t sample_us, int64_t target_us);
+
     /// Sets the current smoothed pose as the center.
     void Recenter();
 
@@ -34,9 +75,36 @@ public:
     void SetDeadzone(const DeadzoneSettings& deadzone) { m_deadzone = deadzone; }
     void SetSmoothing(float smoothing) { m_smoothingFactor = smoothing; }
 
+    /// Selects the rotation filter. Exponential uses SetSmoothing(); the
+    /// predictive modes use their own settings below. Resets filter state.
+    void SetFilterMode(RotationFilterMode mode);
+    void SetOneEuroSettings(const OneEuroSettings& settings) { m_filter.SetOneEuroSettings(settings); }
+    void SetConstantVelocitySettings(const ConstantVelocitySettings& settings) {
+        m_filter.SetConstantVelocitySettings(settings);
+    }
+    void SetMaxPrediction(float seconds) { m_filter.SetMaxPrediction(seconds); }
+
+    /// Binds a settings channel for thread-safe live tuning: another thread
+    /// publishes TrackingProcessorSettings and each Process* call adopts the
+    /// newest snapshot (one acquire load when unchanged). The Set* calls
+    /// above stay for single-threaded use; a bound channel overrides them
+    /// on its next change. Pass nullptr to unbind.
+    void SetSettingsChannel(const SettingsChannel<TrackingProcessorSettings>* channel) {
+        m_settingsChannel = channel;
+        m_settingsVersion = 0;
+    }
+
+    /// Records ProcessBegin/ProcessEnd for samples passed to the
+    /// TrackingSample overloads. Not owned; nullptr turns tracing off.
+    void SetPipelineTrace(PipelineTrace* trace) { m_trace = trace; }
+
     const SensitivitySettings& GetSensitivity() const { return m_sensitivity; }
     const DeadzoneSettings& GetDeadzone() const { return m_deadzone; }
     float GetSmoothing() const { return m_smoothingFactor; }
+    RotationFilterMode GetFilterMode() const { return m_filterMode; }
+
+    /// Gets the rotation filter (angular velocity, settings).
+    const PredictiveFilter& GetFilter() const { return m_filter; }
 
     /// Gets the center offset manager.
     CenterOffsetManager& GetCenterManager() { return m_centerManager; }
@@ -47,8 +115,21 @@ public:
     }
 
 private:
+    void SyncSettings();
+    math::Quat4 ApplyInputStages(float yaw, float pitch, float roll);
+    math::Quat4 FilterRotation(float yaw, float pitch, float roll, float delta_time);
+    math::Quat4 PredictRotation(float yaw, float pitch, float roll,
+                                int64_t sample_us, int64_t target_us);
+    TrackingPose ApplyOutputStages(const math::Quat4& rotation) const;
+    math::Quat4 ApplySensitivity(const math::Quat4& rotation) const;
+
     CenterOffsetManager m_centerManager;
 
+    // Quaternion filter used by the predictive modes and for extrapolation.
+    PredictiveFilter m_filter;
+    RotationFilterMode m_filterMode = RotationFilterMode::Exponential;
+    int64_t m_syntheticClockUs = 0;  // Drives the filter from Process(delta_time)
+
     // Smoothed rotation as quaternion — SLERP avoids gimbal artifacts
     // that per-axis Euler smoothing can introduce at compound angles.
     math::Quat4 m_smoothedQuat;
@@ -58,6 +139,11 @@ private:
     SensitivitySettings m_sensitivity = SensitivitySettings::Default();
     DeadzoneSettings m_deadzone = DeadzoneSettings::None();
     float m_smoothingFactor = 0.0f;
+
+    const SettingsChannel<TrackingProcessorSettings>* m_settingsChannel = nullptr;
+    uint64_t m_settingsVersion = 0;
+
+    PipelineTrace* m_trace = nullptr;
 };
 
 }  // namespace cameraunlock
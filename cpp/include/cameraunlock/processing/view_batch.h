@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include "cameraunlock/math/quat4.h"
+#include "cameraunlock/math/vec3.h"
+#include "cameraunlock/processing/head_pose_processor.h"
+
+namespace cameraunlock {
+
+/// Per-view transforms relative to the head, in struct-of-arrays form.
+/// Every non-null array holds `count` entries (see ProcessBatch).
+struct ViewBatchInput {
+    // View origin offset in head-local space, meters (required).
+    const float* offset_x = nullptr;
+    const float* offset_y = nullptr;
+    const float* offset_z = nullptr;
+
+    // Signed lateral eye offset along head right, meters: -ipd/2 for the
+    // left eye, +ipd/2 for the right. Null = 0 for every view.
+    const float* eye_offset = nullptr;
+
+    // Fraction of the head rotation the view follows, e.g. a zoomed scope
+    // at 0.25 (scales the rotation angle via normalized lerp from
+    // identity; exact at 0 and 1). Null = 1 for every view.
+    const float* rotation_scale = nullptr;
+
+    // Fixed view rotation applied after the head rotation (xyzw unit
+    // quaternion). All four null = identity.
+    const float* rotation_x = nullptr;
+    const float* rotation_y = nullptr;
+    const float* rotation_z = nullptr;
+    const float* rotation_w = nullptr;
+};
+
+/// Per-view results, struct-of-arrays; each array holds `count` entries.
+struct ViewBatchOutput {
+    float* rotation_x = nullptr;
+    float* rotation_y = nullptr;
+    float* rotation_z = nullptr;
+    float* rotation_w = nullptr;
+    float* position_x = nullptr;
+    float* position_y = nullptr;
+    float* position_z = nullptr;
+};
+
+/// Produces `count` view rotations and positions from one processed head
+/// pose in a single loop. For each view: rotation = scaled(head) * view,
+/// position = head_position + scaled(head).Rotate(offset + eye right).
+/// Optional inputs are resolved before the loop, so its body is
+/// branch-free straight-line float math the compiler can vectorize.
+void ProcessBatch(const math::Quat4& head_rotation, const math::Vec3& head_position,
+                  const ViewBatchInput& views, size_t count, const ViewBatchOutput& out);
+
+/// Convenience overload taking a HeadPoseProcessor frame. An invalid
+/// position is treated as zero; an invalid rotation as identity.
+void ProcessBatch(const HeadPoseFrame& frame, const ViewBatchInput& views, size_t count,
+                  const ViewBatchOutput& out);
+
+}  // namespace cameraunlock
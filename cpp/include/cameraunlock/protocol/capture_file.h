@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace cameraunlock {
+
+/// On-disk layout of a tracking capture (native little-endian):
+///   header: char magic[8] = "CUCAPTR1", uint32 version, uint32 reserved
+///   record: int64 arrival_us (steady_clock), uint16 length, length bytes
+/// Records hold the raw datagram exactly as received, so replay exercises
+/// OpenTrackPacket parsing as well as everything downstream.
+struct CaptureFormat {
+    static constexpr char kMagic[8] = {'C', 'U', 'C', 'A', 'P', 'T', 'R', '1'};
+    static constexpr uint32_t kVersion = 1;
+    static constexpr size_t kHeaderSize = 16;
+    static constexpr size_t kRecordHeaderSize = 10;
+    static constexpr size_t kMaxPayloadSize = 0xFFFF;
+};
+
+/// Appends raw datagrams to a capture file. Buffered; not thread-safe, so
+/// call from the thread that receives.
+class CaptureWriter {
+public:
+    CaptureWriter() = default;
+    ~CaptureWriter();
+
+    // Non-copyable
+    CaptureWriter(const CaptureWriter&) = delete;
+    CaptureWriter& operator=(const CaptureWriter&) = delete;
+
+    /// Creates (truncates) the file and writes the header.
+    /// @return True if the file is ready for Append.
+    bool Open(const std::string& path);
+
+    /// Flushes and closes the file.
+    void Close();
+
+    /// True if Open succeeded and the file has not been closed.
+    bool IsOpen() const { return m_file != nullptr; }
+
+    /// Appends one datagram. Payloads over kMaxPayloadSize are truncated.
+    /// @return False on a write error (the file is closed).
+    bool Append(const void* data, size_t length, int64_t arrivalUs);
+
+    /// Records written since Open.
+    uint64_t GetRecordCount() const { return m_records; }
+
+private:
+    FILE* m_file = nullptr;
+    uint64_t m_records = 0;
+};
+
+}  // namespace cameraunlock
@@ -0,0 +1,260 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <queue>
+#include <string>
+#include <vector>
+#include "cameraunlock/data/position_data.h"
+#include "cameraunlock/data/tracking_pose.h"
+#include "cameraunlock/protocol/replay_source.h"
+#include "cameraunlock/protocol/udp_socket.h"
+
+namespace cameraunlock {
+
+/// One phase of a synthetic OpenTrack stream. Rates are per sender;
+/// probabilities are per nominal datagram.
+struct LoadPhase {
+    /// Phase length, 0 = run until the caller stops.
+    int64_t durationMs = 10000;
+
+    /// Nominal send rate of each sender (ignored when replaying a capture).
+    double rateHz = 250.0;
+
+    /// Independent streams, interleaved evenly within a period, each sent
+    /// from its own source port.
+    int senders = 1;
+
+    /// Extra delay per datagram, uniform in [0, jitterMs].
+    double jitterMs = 0.0;
+
+    /// Every burstIntervalMs, datagrams are held for burstHoldMs and then
+    /// released together (Wi-Fi power-save clumping). 0 = off.
+    double burstIntervalMs = 0.0;
+    double burstHoldMs = 0.0;
+
+    /// Datagrams never sent.
+    double loss = 0.0;
+
+    /// Datagrams delayed by 1..reorderDepth periods, landing behind newer ones.
+    double reorder = 0.0;
+    int reorderDepth = 3;
+
+    /// Datagrams sent twice.
+    double duplicate = 0.0;
+
+    /// Datagrams replaced by ones the parser must reject: empty, truncated
+    /// or short junk.
+    double malformed = 0.0;
+
+    /// Datagrams carrying NaN, infinity, doubles that overflow float, or
+    /// finite but absurd angles (the last kind parses; downstream must cope).
+    double outOfRange = 0.0;
+
+    /// Reference head motion: sinusoids at motionHz, phase-shifted per
+    /// sender and per axis (ignored when replaying a capture).
+    double yawAmplitude = 30.0;    // degrees
+    double pitchAmplitude = 15.0;
+    double rollAmplitude = 5.0;
+    double positionAmplitudeCm = 5.0;
+    double motionHz = 0.5;
+
+    /// Send the 32-byte extended packet (sequence and send time from the
+    /// schedule) instead of OpenTrack's (ignored when replaying a capture).
+    bool extended = false;
+};
+
+enum class DatagramKind : uint8_t {
+    Valid,
+    Duplicate,
+    Malformed,
+    OutOfRange
+};
+
+/// One datagram of the generated schedule.
+struct GeneratedDatagram {
+    static constexpr size_t kMaxSize = 256;
+
+    int64_t dueUs = 0;        // send time, relative to Begin()
+    int64_t sourceUs = 0;     // nominal send time; the pose describes this instant
+    uint64_t sequence = 0;    // 1-based nominal index across all senders
+    uint16_t sender = 0;
+    DatagramKind kind = DatagramKind::Valid;
+    uint16_t length = 0;
+    uint8_t data[kMaxSize] = {};
+};
+
+/// Totals since Begin().
+struct LoadCounters {
+    uint64_t nominal = 0;       // datagrams the clean stream would have had
+    uint64_t emitted = 0;       // datagrams returned by Next (duplicates included)
+    uint64_t lost = 0;
+    uint64_t reordered = 0;
+    uint64_t duplicated = 0;
+    uint64_t malformed = 0;
+    uint64_t outOfRange = 0;
+    uint64_t burstHeld = 0;     // datagrams delayed by a burst hold
+};
+
+/// Deterministic generator of adversarial OpenTrack streams for soak tests.
+///
+/// The schedule is a sequence of phases (from AddPhase or an INI profile),
+/// each a clean stream at rateHz per sender with faults layered on top.
+/// The clean stream is either synthetic reference motion (PoseAt gives the
+/// exact pose for any instant, so output smoothness can be scored) or the
+/// records of a capture file, looped to fill each phase. The same seed and
+/// phases always produce the same datagrams, byte for byte.
+///
+/// Next() returns datagrams in due order with no clock involved, so the
+/// schedule can be sent in real time (LoadSender), written as a capture
+/// (CaptureWriter, dueUs as arrival) or fed straight into a parser.
+class LoadGenerator {
+public:
+    LoadGenerator() = default;
+
+    // Non-copyable
+    LoadGenerator(const LoadGenerator&) = delete;
+    LoadGenerator& operator=(const LoadGenerator&) = delete;
+
+    void SetSeed(uint64_t seed) { m_seed = seed; }
+    uint64_t GetSeed() const { return m_seed; }
+
+    /// Appends a phase to the schedule.
+    void AddPhase(const LoadPhase& phase) { m_phases.push_back(phase); }
+    void ClearPhases() { m_phases.clear(); }
+    const std::vector<LoadPhase>& GetPhases() const { return m_phases; }
+
+    /// Restarts the schedule from the first phase when the last one ends.
+    void SetLoop(bool loop) { m_loop = loop; }
+    bool IsLooping() const { return m_loop; }
+
+    /// Loads a profile, replacing the phases. Sections [phase1], [phase2], ...
+    /// are read in order until one without duration_ms; each starts as a
+    /// copy of the previous phase, so later phases list only what changes.
+    /// Keys match LoadPhase in snake_case (rate_hz, jitter_ms, loss,
+    /// out_of_range, ...). An optional [generator] section sets seed, loop
+    /// and capture (a path, see UseCapture).
+    /// @return True if the file was read and defines at least one phase.
+    bool LoadProfile(const std::string& path);
+
+    /// Takes the clean stream from a capture file instead of synthetic
+    /// motion. Pass an empty path to go back to synthetic motion.
+    /// @return True if the capture holds at least one record.
+    bool UseCapture(const std::string& path);
+
+    /// True if the clean stream comes from a capture.
+    bool IsUsingCapture() const { return m_capture.IsOpen(); }
+
+    /// Resets the schedule to time zero with the current seed and phases.
+    void Begin();
+
+    /// Produces the next datagram in due order.
+    /// @return False once every phase has ended (never when looping, or
+    ///         when the current phase has durationMs 0).
+    bool Next(GeneratedDatagram& out);
+
+    const LoadCounters& GetCounters() const { return m_counters; }
+
+    /// Reference pose of a sender's synthetic motion at sourceUs.
+    static void PoseAt(const LoadPhase& phase, int sender, int64_t sourceUs,
+                       TrackingPose& pose, PositionData& position);
+
+    /// Writes the OpenTrack payload for a pose (position in meters).
+    /// @return Bytes written (48).
+    static size_t EncodePacket(const TrackingPose& pose, const PositionData& position,
+                               uint8_t* out);
+
+    /// Writes the extended payload for a pose (position in meters), stamped
+    /// with the low bits of sequence and sourceUs.
+    /// @return Bytes written (32).
+    static size_t EncodeExtendedPacket(const TrackingPose& pose, const PositionData& position,
+                                       uint64_t sequence, int64_t sourceUs, uint8_t* out);
+
+private:
+    struct Pending {
+        int64_t dueUs;
+        uint64_t order;
+        GeneratedDatagram datagram;
+    };
+    struct Later {
+        bool operator()(const Pending& a, const Pending& b) const {
+            return a.dueUs != b.dueUs ? a.dueUs > b.dueUs : a.order > b.order;
+        }
+    };
+
+    uint64_t Random();
+    double Uniform();
+    bool Chance(double probability);
+
+    bool NextNominal(GeneratedDatagram& out);
+    bool PeekCapture();
+    void Schedule(GeneratedDatagram& datagram);
+    void Push(const GeneratedDatagram& datagram);
+    void Corrupt(GeneratedDatagram& datagram);
+    void Poison(GeneratedDatagram& datagram);
+    void BeginPhase(size_t index, int64_t startUs);
+
+    std::vector<LoadPhase> m_phases;
+    uint64_t m_seed = 1;
+    bool m_loop = false;
+    ReplaySource m_capture;
+
+    // Schedule state
+    uint64_t m_rng = 0;
+    size_t m_phase = 0;
+    bool m_finished = true;
+    int64_t m_phaseStartUs = 0;
+    int64_t m_phaseEndUs = 0;      // INT64_MAX for an open-ended phase
+    int64_t m_periodUs = 0;        // clean interval per sender
+    int64_t m_nextNominalUs = 0;   // due time of the next clean datagram
+    uint64_t m_phaseCount = 0;     // clean datagrams in the current phase
+    uint64_t m_sequence = 0;
+    uint64_t m_order = 0;
+
+    // Capture timeline: records keep their spacing, rebased so the first
+    // lands at m_captureOffsetUs; each wrap adds m_captureSpanUs.
+    int64_t m_captureFirstUs = 0;
+    int64_t m_captureSpanUs = 0;
+    int64_t m_captureGapUs = 0;    // mean record interval
+    int64_t m_captureOffsetUs = 0;
+    const uint8_t* m_peekData = nullptr;
+    size_t m_peekLength = 0;
+    int64_t m_peekUs = 0;
+    std::priority_queue<Pending, std::vector<Pending>, Later> m_pending;
+    LoadCounters m_counters;
+};
+
+/// Sends generated datagrams over UDP, one socket per sender so each
+/// stream has its own source port.
+class LoadSender {
+public:
+    static constexpr int kMaxSenders = 16;
+
+    LoadSender() = default;
+    ~LoadSender() { Close(); }
+
+    // Non-copyable
+    LoadSender(const LoadSender&) = delete;
+    LoadSender& operator=(const LoadSender&) = delete;
+
+    /// Opens the sockets and resolves the destination (IPv4 dotted quad).
+    /// @return True if every socket opened and the address parsed.
+    bool Open(const char* host, uint16_t port, int senders);
+
+    void Close();
+
+    /// Sends one datagram from its sender's socket.
+    /// @return False if the send failed.
+    bool Send(const GeneratedDatagram& datagram);
+
+    /// Datagrams the OS refused (full buffers, unreachable port).
+    uint64_t GetSendErrors() const { return m_sendErrors; }
+
+private:
+    UdpSocket m_sockets[kMaxSenders];
+    int m_senders = 0;
+    sockaddr_in m_target = {};
+    uint64_t m_sendErrors = 0;
+};
+
+}  // namespace cameraunlock
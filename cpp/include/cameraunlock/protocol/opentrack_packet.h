@@ -9,6 +9,15 @@ namespace cameraunlock {
 
 /// OpenTrack packet constants and parsing utilities.
 /// Packet layout: 6 doubles (48 bytes) = X, Y, Z (meters), Yaw, Pitch, Roll (degrees).
+///
+/// Extended layout (our tracker bridge), 32 bytes, little-endian:
+///   0  uint8   magic 'C'
+///   1  uint8   version (1)
+///   2  uint16  sequence number (wraps)
+///   4  uint32  send time, microseconds on the sender's monotonic clock (wraps)
+///   8  float   X, Y, Z (centimeters), Yaw, Pitch, Roll (degrees)
+/// It is told apart by length (OpenTrack never sends less than 48 bytes) and
+/// magic; anything else falls back to the OpenTrack layout.
 struct OpenTrackPacket {
     /// Minimum packet size (6 doubles = 48 bytes).
     static constexpr size_t kMinPacketSize = 48;
@@ -23,6 +32,27 @@ struct OpenTrackPacket {
     static constexpr size_t kPitchOffset = 32;
     static constexpr size_t kRollOffset = 40;
 
+    /// Extended layout constants.
+    static constexpr size_t kExtendedPacketSize = 32;
+    static constexpr uint8_t kExtendedMagic = 0x43;  // 'C'
+    static constexpr uint8_t kExtendedVersion = 1;
+    static constexpr size_t kSequenceOffset = 2;
+    static constexpr size_t kSendTimeOffset = 4;
+    static constexpr size_t kExtendedPoseOffset = 8;
+
+    /// Which layout a datagram parsed as.
+    enum class Format : uint8_t {
+        Invalid,
+        OpenTrack,
+        Extended
+    };
+
+    /// Sender-side fields of an extended packet.
+    struct ExtendedHeader {
+        uint16_t sequence = 0;
+        uint32_t send_us = 0;
+    };
+
     /// Attempts to parse rotation from an OpenTrack packet.
     /// @param data Raw packet data.
     /// @param length Length of the data in bytes.
@@ -44,6 +74,19 @@ struct OpenTrackPacket {
     /// @param position Output position data if successful.
     /// @return True if parsing succeeded.
     static bool TryParseAll(const void* data, size_t length, TrackingPose& pose, PositionData& position);
+
+    /// True if the datagram has the extended packet's length and magic.
+    static bool IsExtended(const void* data, size_t length);
+
+    /// Parses either layout: extended if IsExtended, else TryParseAll.
+    /// @param header Filled in for extended packets only.
+    /// @return The layout parsed, or Format::Invalid.
+    static Format TryParseAny(const void* data, size_t length, TrackingPose& pose, PositionData& position,
+                              ExtendedHeader& header);
+
+    /// Writes an extended packet (position in centimeters, rotation in degrees).
+    static void EncodeExtended(uint8_t out[kExtendedPacketSize], const ExtendedHeader& header,
+                               float x, float y, float z, float yaw, float pitch, float roll);
 };
 
 }  // namespace cameraunlock
@@ -1,7 +1,10 @@
 #pragma once
 
 #include <cstdint>
+#include <string>
 #include "cameraunlock/data/tracking_pose.h"
+#include "cameraunlock/protocol/capture_file.h"
+#include "cameraunlock/protocol/sender_timeline.h"
 #include "cameraunlock/protocol/socket_types.h"
 #include "cameraunlock/protocol/udp_socket.h"
 
@@ -24,6 +27,9 @@ public:
     /// Maximum receive buffer size.
     static constexpr size_t kMaxBufferSize = 256;
 
+    /// Safety limit on datagrams drained by a single Poll().
+    static constexpr int kMaxPacketsPerFrame = 1000;
+
     PollingUdpReceiver() = default;
     ~PollingUdpReceiver();
 
@@ -42,9 +48,13 @@ public:
     void Shutdown();
 
     /// Polls for incoming data (non-blocking).
-    /// Drains all pending packets and keeps only the latest.
+    /// Drains all pending packets (batched where the OS allows) and judges
+    /// each in arrival order: malformed ones are counted in
+    /// GetPacketsMalformed(), late or duplicate extended ones in
+    /// GetPacketsReordered(), and the newest accepted one is published;
+    /// older accepted ones are counted in GetLastPollDiscarded().
     /// Should be called once per frame from the main game loop.
-    /// @return True if new data was received this frame.
+    /// @return True if the latest packet this frame was valid.
     bool Poll();
 
     /// Gets the latest tracking pose (rotation only, with offset applied).
@@ -60,16 +70,34 @@ public:
     /// @return True if valid data is available.
     bool GetRotation(float& yaw, float& pitch, float& roll) const;
 
-    /// Gets the latest position values (in mm, from OpenTrack).
+    /// Gets the latest position values (in meters, converted from OpenTrack cm).
     /// @return True if position data is available.
     bool GetPosition(float& x, float& y, float& z) const;
 
+    /// Gets the latest raw sample (no recenter offset applied). Rotation,
+    /// position, timestamp, and sequence always come from the same packet.
+    /// Lock-free, so other threads may read it while Poll() runs.
+    /// @return True if a sample is available.
+    bool TryGetSample(TrackingSample& sample) const { return m_sample.TryGet(sample); }
+
     /// Sets the current position as the new center point.
     void Recenter();
 
     /// Resets the center offset to zero.
     void ResetOffset();
 
+    /// Records every datagram with its arrival time to a capture file for
+    /// ReplaySource. While capturing, Poll() reads datagrams one at a time
+    /// (instead of batch-draining) so none are skipped unrecorded.
+    /// @return True if the file was opened.
+    bool StartCapture(const std::string& path) { return m_capture.Open(path); }
+
+    /// Closes the capture file.
+    void StopCapture() { m_capture.Close(); }
+
+    /// True if a capture is being written.
+    bool IsCapturing() const { return m_capture.IsOpen(); }
+
     /// True if the receiver is properly initialized.
     bool IsInitialized() const { return m_initialized; }
 
@@ -79,28 +107,44 @@ public:
     /// True if the data source is from a remote (non-localhost) address.
     bool IsRemoteConnection() const { return m_isRemoteConnection; }
 
-    /// Gets statistics about received data.
+    /// Gets statistics about received data. Packets are well-formed
+    /// datagrams only; bytes count every datagram read.
     uint64_t GetPacketsReceived() const { return m_packetsReceived; }
+
+    /// Datagrams that weren't a valid OpenTrack or extended packet.
+    uint64_t GetPacketsMalformed() const { return m_packetsMalformed; }
     uint64_t GetBytesReceived() const { return m_bytesReceived; }
 
+    /// Stale packets skipped in favor of a newer one, in total and by the
+    /// most recent Poll().
+    uint64_t GetPacketsDiscarded() const { return m_packetsDiscarded; }
+    int GetLastPollDiscarded() const { return m_lastPollDiscarded; }
+
+    /// Extended packets dropped because their sequence number was not newer
+    /// than the last one published.
+    uint64_t GetPacketsReordered() const { return m_packetsReordered; }
+
 private:
-    bool ParsePacket(const char* buffer, int bytesReceived);
+    // Per-Poll verdicts and the newest accepted sample
+    struct Selection {
+        PollingUdpReceiver* receiver = nullptr;
+        int64_t arrivalUs = 0;
+        int malformed = 0;
+        int reordered = 0;
+        bool found = false;
+        TrackingSample sample;
+    };
+
+    static bool SelectFilter(void* context, const char* data, int size);
+    bool Select(const char* data, int size, Selection& selection);
+    void ReceiveCapturing(sockaddr_in& senderAddr, int& datagramsRead, uint64_t& bytesRead, Selection& selection);
     int64_t GetCurrentTimeMs() const;
 
     UdpSocket m_socket;
     bool m_initialized = false;
 
-    // Latest received data (rotation in degrees)
-    float m_yaw = 0.0f;
-    float m_pitch = 0.0f;
-    float m_roll = 0.0f;
-    bool m_hasData = false;
-
-    // Latest received position data (in mm)
-    float m_posX = 0.0f;
-    float m_posY = 0.0f;
-    float m_posZ = 0.0f;
-    bool m_hasPosition = false;
+    // Latest received packet (rotation in degrees, position in meters)
+    SharedTrackingSample m_sample;
 
     // Center offset for recentering
     float m_yawOffset = 0.0f;
@@ -112,9 +156,16 @@ private:
     int64_t m_lastReceiveTimeMs = 0;
     bool m_isRemoteConnection = false;
 
+    CaptureWriter m_capture;
+    SenderTimeline m_timeline;
+
     // Statistics
     uint64_t m_packetsReceived = 0;
+    uint64_t m_packetsMalformed = 0;
     uint64_t m_bytesReceived = 0;
+    uint64_t m_packetsDiscarded = 0;
+    int m_lastPollDiscarded = 0;
+    uint64_t m_packetsReordered = 0;
 
     // Receive buffer
     char m_receiveBuffer[kMaxBufferSize];
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "cameraunlock/data/tracking_pose.h"
+#include "cameraunlock/protocol/sender_timeline.h"
+#include "cameraunlock/protocol/tracking_source.h"
+
+namespace cameraunlock {
+
+/// Plays back a capture written by CaptureWriter from a read-only memory
+/// mapping, so even multi-million-sample recordings cost no per-record I/O.
+///
+/// Two modes:
+///  - As fast as possible: call Next() in a loop; samples keep their
+///    recorded arrival timestamps, for deterministic benchmarks/regressions.
+///  - Real time: call BeginRealtime() once, then Update() each frame; the
+///    source behaves like a live receiver (ITrackingSource), with arrival
+///    times rebased onto the current steady_clock timeline.
+class ReplaySource : public ITrackingSource {
+public:
+    /// Matches UdpReceiver so replayed streams report connection the same way.
+    static constexpr int kConnectionTimeoutMs = 500;
+
+    ReplaySource() = default;
+    ~ReplaySource() override;
+
+    // Non-copyable
+    ReplaySource(const ReplaySource&) = delete;
+    ReplaySource& operator=(const ReplaySource&) = delete;
+
+    /// Maps the capture file and validates its header.
+    /// @return True if the file is a readable capture.
+    bool Open(const std::string& path);
+
+    /// Unmaps the file and clears playback state.
+    void Close();
+
+    /// True if a capture is mapped.
+    bool IsOpen() const { return m_data != nullptr; }
+
+    /// Restarts playback from the first record.
+    void Rewind();
+
+    /// True once every record has been consumed.
+    bool IsAtEnd() const { return m_offset >= m_size; }
+
+    /// Reads the next raw record (datagram bytes point into the mapping).
+    /// @return False at end of file or on a truncated record.
+    bool NextRaw(const uint8_t*& data, size_t& length, int64_t& arrivalUs);
+
+    /// Reads the next record that parses as an OpenTrack or extended packet.
+    /// Malformed and late records are skipped and counted. sample.sequence
+    /// counts parsed records.
+    /// @return False at end of file.
+    bool Next(TrackingSample& sample);
+
+    /// Datagrams skipped by Next() because they failed to parse.
+    uint64_t GetMalformedCount() const { return m_malformed; }
+
+    /// Extended packets skipped as duplicate or older than the newest, as
+    /// the live receivers would.
+    uint64_t GetReorderedCount() const { return m_reordered; }
+
+    /// Starts real-time playback: the first record is due at nowUs.
+    void BeginRealtime(int64_t nowUs = TrackingPose::CurrentTimestamp());
+
+    /// Publishes every record due by nowUs (real-time mode).
+    /// @return True if a new sample was published.
+    bool Update(int64_t nowUs = TrackingPose::CurrentTimestamp());
+
+    bool IsReceiving() const override;
+    bool IsRemoteConnection() const override { return false; }
+    bool IsFailed() const override { return m_failed; }
+    int64_t GetLastReceiveTimestamp() const override;
+    bool GetRotation(float& yaw, float& pitch, float& roll) const override;
+    bool GetPosition(float& x, float& y, float& z) const override;
+    bool TryGetSample(TrackingSample& sample) const override { return m_sample.TryGet(sample); }
+    void Recenter() override;
+
+private:
+    bool PeekArrival(int64_t& arrivalUs) const;
+    bool ParseRecord(const uint8_t* data, size_t length, int64_t arrivalUs, TrackingSample& sample);
+
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+    size_t m_offset = 0;
+    void* m_file = nullptr;      // HANDLE on Windows
+    void* m_mapping = nullptr;   // HANDLE on Windows
+    bool m_failed = false;
+
+    uint64_t m_parsed = 0;
+    uint64_t m_malformed = 0;
+    uint64_t m_reordered = 0;
+    SenderTimeline m_timeline;
+
+    // Real-time playback: record time + m_rebaseUs = live time
+    bool m_realtime = false;
+    int64_t m_rebaseUs = 0;
+
+    SharedTrackingSample m_sample;
+    float m_yawOffset = 0.0f;
+    float m_pitchOffset = 0.0f;
+    float m_rollOffset = 0.0f;
+};
+
+}  // namespace cameraunlock
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include "cameraunlock/protocol/opentrack_packet.h"
+
+namespace cameraunlock {
+
+/// Per-receiver view of an extended-packet sender: drops duplicate and
+/// late datagrams by sequence number, and maps the sender's send times onto
+/// the local steady clock.
+///
+/// The clock offset is the minimum of (arrival - send time) over the last
+/// one to two windows of kWindowUs. The least-delayed packet bounds the
+/// clock difference plus the fixed part of the transit time, so mapped
+/// times keep the sender's spacing without network or scheduling jitter,
+/// shifted by that base latency. Restarting the window lets the estimate
+/// follow clock drift. A sender restart (sequence far behind or behind with
+/// a later send time, send time jumping back, or silence longer than
+/// kRestartGapUs) starts over.
+///
+/// Receive-thread only; not thread-safe.
+class SenderTimeline {
+public:
+    static constexpr int64_t kWindowUs = 2000000;
+    static constexpr int64_t kRestartGapUs = 1000000;
+    /// Datagrams less than this many sequence numbers behind the newest are
+    /// late; further behind is a restart.
+    static constexpr int kReorderWindow = 256;
+
+    /// Judges one extended packet that arrived at arrivalUs.
+    /// @param sourceUs Send time on the local clock, set when accepted.
+    /// @return False if the packet is a duplicate or older than the newest
+    ///         (sequence and send time both not ahead).
+    bool Accept(const OpenTrackPacket::ExtendedHeader& header, int64_t arrivalUs, int64_t& sourceUs);
+
+    /// Forgets the sender.
+    void Reset();
+
+    bool HasSender() const { return m_hasSender; }
+
+    /// Local minus sender clock, including the base one-way latency.
+    int64_t GetOffsetUs() const { return m_offsetUs; }
+
+private:
+    void Restart(const OpenTrackPacket::ExtendedHeader& header, int64_t arrivalUs);
+
+    bool m_hasSender = false;
+    uint16_t m_lastSequence = 0;
+    uint32_t m_lastSendRaw = 0;
+    int64_t m_sendUs = 0;          // Unwrapped send time of the newest packet
+    int64_t m_lastArrivalUs = 0;
+    int64_t m_windowStartUs = 0;
+    int64_t m_windowMinUs = 0;
+    int64_t m_previousMinUs = 0;
+    bool m_hasPrevious = false;
+    int64_t m_offsetUs = 0;
+};
+
+}  // namespace cameraunlock
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include "cameraunlock/data/tracking_pose.h"
+#include "cameraunlock/protocol/tracking_source.h"
+
+namespace cameraunlock {
+
+/// Tracking source reading OpenTrack's FreeTrack shared-memory mapping
+/// ("FT_SharedMem", the same block NPClient/FreeTrack games use).
+/// No socket and no thread: Poll() takes one snapshot of the mapping per
+/// frame and every getter serves that snapshot, so rotation and position
+/// always come from the same pose. Select the "freetrack 2.0 enhanced"
+/// output in OpenTrack. Windows (and Wine/Proton) only; on other platforms
+/// Start() fails.
+class SharedMemoryReceiver : public ITrackingSource {
+public:
+    /// Name of the FreeTrack file mapping.
+    static constexpr const char* kMappingName = "FT_SharedMem";
+
+    /// Name of the mutex guarding the mapping. The misspelling is the
+    /// protocol's own.
+    static constexpr const char* kMutexName = "FT_Mutext";
+
+    /// Time without a DataID change before IsReceiving goes false.
+    /// FreeTrack has no per-sample timestamp, so arrival is the time Poll()
+    /// first observes a new DataID.
+    static constexpr int kConnectionTimeoutMs = 500;
+
+    SharedMemoryReceiver() = default;
+    ~SharedMemoryReceiver() override;
+
+    // Non-copyable
+    SharedMemoryReceiver(const SharedMemoryReceiver&) = delete;
+    SharedMemoryReceiver& operator=(const SharedMemoryReceiver&) = delete;
+
+    /// Opens (or creates, if OpenTrack is not running yet) the mapping and
+    /// its mutex.
+    /// @return True if the mapping is available.
+    bool Start();
+
+    /// Unmaps the shared memory and clears tracking state.
+    void Stop();
+
+    /// True if the mapping is open.
+    bool IsRunning() const { return m_view != nullptr; }
+
+    /// Takes this frame's snapshot. Call once per frame from one thread
+    /// (the game thread), before the getters. An unchanged DataID costs one
+    /// load and no syscall. A new pose is copied under the writer's FreeTrack
+    /// mutex, but Poll never waits for it: if OpenTrack holds the mutex the
+    /// previous snapshot is kept and the pose is picked up next frame.
+    /// @return True if a snapshot is available.
+    bool Poll();
+
+    bool IsReceiving() const override;
+    bool IsRemoteConnection() const override { return false; }
+    bool IsFailed() const override { return m_failed; }
+    int64_t GetLastReceiveTimestamp() const override;
+    bool GetRotation(float& yaw, float& pitch, float& roll) const override;
+    bool GetPosition(float& x, float& y, float& z) const override;
+    bool TryGetSample(TrackingSample& sample) const override;
+    void Recenter() override;
+
+private:
+    void* m_mapping = nullptr;
+    void* m_mutex = nullptr;
+    const void* m_view = nullptr;
+    bool m_failed = false;
+    uint32_t m_lastDataId = 0;  // Poll thread only
+
+    // This frame's pose, written by Poll and read lock-free by any thread
+    SharedTrackingSample m_snapshot;
+
+    // Recenter offset (yaw/pitch/roll), published as one unit so a reader
+    // never pairs one recenter's yaw with another's pitch
+    SharedTrackingSample m_center;
+    std::mutex m_centerMutex;  // Serializes Recenter callers
+};
+
+}  // namespace cameraunlock
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include "cameraunlock/data/tracking_pose.h"
+#include "cameraunlock/protocol/tracking_source.h"
+#include "cameraunlock/protocol/udp_receiver.h"
+
+namespace cameraunlock {
+
+/// Process-wide, reference-counted OpenTrack receiver.
+/// Every mod in the process that uses SharedUdpReceiver on the same port
+/// attaches to one hub: the first consumer (the owner) binds the socket and
+/// runs the only receive thread, and all consumers read the sample it
+/// publishes. When the owner stops, the socket is orphaned until a consumer
+/// calls AdoptIfOrphaned(); the getters never bind or start threads, so
+/// they stay cheap and side-effect free on the game thread. This avoids
+/// duplicate threads and the bind-retry loop a second UdpReceiver would
+/// fall into.
+///
+/// On Windows the hub lives in a per-process named mapping, so it is shared
+/// across DLLs that each link their own copy of this library. Elsewhere it
+/// is a static within this copy of the library.
+class SharedUdpReceiver : public ITrackingSource {
+public:
+    SharedUdpReceiver() = default;
+    ~SharedUdpReceiver() override;
+
+    // Non-copyable
+    SharedUdpReceiver(const SharedUdpReceiver&) = delete;
+    SharedUdpReceiver& operator=(const SharedUdpReceiver&) = delete;
+
+    /// Attaches to (or creates) the hub for the port, taking ownership of
+    /// the socket if no other consumer holds it.
+    /// @return True if attached to the hub.
+    bool Start(uint16_t port = UdpReceiver::kDefaultPort);
+
+    /// Detaches from the hub. If this consumer owned the socket, it is
+    /// released for another consumer to adopt.
+    void Stop();
+
+    /// True if attached to a hub.
+    bool IsRunning() const { return m_hub != nullptr; }
+
+    /// True if this consumer currently runs the hub's socket and thread.
+    bool IsOwner() const;
+
+    /// Takes over the socket and receive thread if the owner left. Binds
+    /// and starts a thread when it adopts, so call it from a background or
+    /// housekeeping context (e.g. a Runtime timer or a once-a-second
+    /// check), not from the per-frame read path. Cheap when an owner exists.
+    /// @return True if this consumer is the owner afterwards.
+    bool AdoptIfOrphaned();
+
+    /// Optional logging callback, forwarded to the owned UdpReceiver.
+    void SetLog(std::function<void(const std::string&)> log) { m_log = std::move(log); }
+
+    bool IsReceiving() const override;
+    bool IsRemoteConnection() const override;
+    bool IsFailed() const override;
+    int64_t GetLastReceiveTimestamp() const override;
+    bool GetRotation(float& yaw, float& pitch, float& roll) const override;
+    bool GetPosition(float& x, float& y, float& z) const override;
+
+    /// Latest hub sample, with this consumer's recenter offset in the
+    /// center_* fields (rotation itself stays raw).
+    bool TryGetSample(TrackingSample& sample) const override;
+
+    /// Centers this consumer only; other consumers of the hub keep theirs.
+    void Recenter() override;
+
+    struct Hub;
+
+private:
+    void BecomeOwner();
+
+    Hub* m_hub = nullptr;
+    void* m_mapping = nullptr;
+    uint32_t m_token = 0;
+    uint16_t m_port = UdpReceiver::kDefaultPort;
+    bool m_failed = false;
+    std::function<void(const std::string&)> m_log;
+
+    // Owner-only UdpReceiver, created by Start or AdoptIfOrphaned
+    std::mutex m_ownerMutex;
+    std::unique_ptr<UdpReceiver> m_receiver;
+
+    // Recenter offset (per consumer) in yaw/pitch/roll, published as one
+    // unit so a reader never pairs one recenter's yaw with another's pitch
+    SharedTrackingSample m_center;
+    std::mutex m_centerMutex;  // Serializes Recenter callers
+};
+
+}  // namespace cameraunlock
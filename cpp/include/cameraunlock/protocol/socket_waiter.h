@@ -0,0 +1,57 @@
+#pragma once
+
+#include "cameraunlock/protocol/socket_types.h"
+
+namespace cameraunlock {
+
+/// Blocks a receive thread until its socket is readable or another thread
+/// calls Signal(). Uses WSAEventSelect + WSAWaitForMultipleEvents with a
+/// stop event on Windows and poll() with a self-pipe on POSIX, so an idle
+/// receiver costs no CPU and shutdown does not wait for a poll timeout.
+class SocketWaiter {
+public:
+    enum class WaitResult {
+        Readable,   // Socket has data (or a pending error) to read
+        Signaled,   // Signal() was called
+        Timeout,    // timeoutMs elapsed
+        Error       // Wait failed; the waiter is unusable
+    };
+
+    SocketWaiter() = default;
+    ~SocketWaiter();
+
+    // Non-copyable, non-movable
+    SocketWaiter(const SocketWaiter&) = delete;
+    SocketWaiter& operator=(const SocketWaiter&) = delete;
+    SocketWaiter(SocketWaiter&&) = delete;
+    SocketWaiter& operator=(SocketWaiter&&) = delete;
+
+    /// Associates the waiter with an open non-blocking socket.
+    /// @return True if the wait objects were created.
+    bool Open(SOCKET sock);
+
+    /// Releases the wait objects. The socket itself is not closed.
+    void Close();
+
+    /// True if Open succeeded and Close has not been called.
+    bool IsOpen() const { return m_socket != INVALID_SOCKET; }
+
+    /// Waits for readability or a signal. The signal is sticky: once set,
+    /// every later Wait returns Signaled until Close().
+    /// @param timeoutMs Maximum wait, or -1 to wait indefinitely.
+    WaitResult Wait(int timeoutMs = -1);
+
+    /// Wakes the waiting thread. Safe to call from any thread.
+    void Signal();
+
+private:
+    SOCKET m_socket = INVALID_SOCKET;
+#ifdef _WIN32
+    WSAEVENT m_socketEvent = WSA_INVALID_EVENT;
+    WSAEVENT m_stopEvent = WSA_INVALID_EVENT;
+#else
+    int m_pipe[2] = {-1, -1};
+#endif
+};
+
+}  // namespace cameraunlock
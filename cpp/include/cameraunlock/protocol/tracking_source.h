@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include "cameraunlock/data/tracking_pose.h"
+
+namespace cameraunlock {
+
+/// Common interface for head tracking sources, so a mod can switch between
+/// transports (UDP, shared memory) at runtime.
+/// Port of CameraUnlock.Core.Protocol.ITrackingDataSource (C#).
+class ITrackingSource {
+public:
+    virtual ~ITrackingSource() = default;
+
+    /// True if data has been received within the source's connection timeout.
+    virtual bool IsReceiving() const = 0;
+
+    /// True if the data source is from a remote (non-localhost) address.
+    /// Used to apply baseline smoothing for network latency compensation.
+    virtual bool IsRemoteConnection() const = 0;
+
+    /// True if the data source failed to initialize.
+    virtual bool IsFailed() const = 0;
+
+    /// Arrival time of the latest sample (steady_clock microseconds), 0 if none.
+    virtual int64_t GetLastReceiveTimestamp() const = 0;
+
+    /// Gets the current rotation in degrees with the recenter offset applied.
+    /// @return True if data is available.
+    virtual bool GetRotation(float& yaw, float& pitch, float& roll) const = 0;
+
+    /// Gets the current position in meters.
+    /// @return True if position data is available.
+    virtual bool GetPosition(float& x, float& y, float& z) const = 0;
+
+    /// Gets the latest raw sample (no recenter offset applied).
+    /// @return True if a sample is available.
+    virtual bool TryGetSample(TrackingSample& sample) const = 0;
+
+    /// Sets the current rotation as the new center point.
+    /// Sources that read on demand (shared memory, replay) center on the
+    /// current pose immediately. A source with its own receive thread may
+    /// instead queue the request and center on the next sample it receives
+    /// (UdpReceiver does), so while the tracker is idle or disconnected the
+    /// center does not change until data arrives again.
+    virtual void Recenter() = 0;
+};
+
+}  // namespace cameraunlock
@@ -6,14 +6,28 @@
 #include <thread>
 #include <cstdint>
 #include "cameraunlock/data/tracking_pose.h"
+#include "cameraunlock/data/tracking_sample_ring.h"
+#include "cameraunlock/diagnostics/async_log.h"
+#include "cameraunlock/diagnostics/pipeline_trace.h"
+#include "cameraunlock/diagnostics/receiver_stats.h"
+#include "cameraunlock/protocol/capture_file.h"
+#include "cameraunlock/protocol/sender_timeline.h"
 #include "cameraunlock/protocol/socket_types.h"
+#include "cameraunlock/protocol/socket_waiter.h"
+#include "cameraunlock/protocol/tracking_source.h"
 #include "cameraunlock/protocol/udp_socket.h"
+#include "cameraunlock/runtime/spsc_queue.h"
+#include "cameraunlock/runtime/thread_scheduling.h"
 
 namespace cameraunlock {
 
+class Runtime;
+
 /// UDP receiver for OpenTrack protocol.
-/// Thread-safe with lock-free reads on the game thread.
-class UdpReceiver {
+/// Thread-safe with lock-free reads on the game thread. The receive thread
+/// blocks until a packet arrives or Stop() is called, so it is idle when the
+/// tracker is not sending.
+class UdpReceiver : public ITrackingSource {
 public:
     /// Default OpenTrack UDP port.
     static constexpr uint16_t kDefaultPort = 4242;
@@ -30,7 +44,7 @@ public:
     static constexpr int kRetryLogIntervalMs = 30000;
 
     UdpReceiver() = default;
-    ~UdpReceiver();
+    ~UdpReceiver() override;
 
     // Non-copyable
     UdpReceiver(const UdpReceiver&) = delete;
@@ -41,17 +55,61 @@ public:
     /// kRetryIntervalMs and returns false. The retry thread takes over without
     /// further action from the caller; once it binds successfully the receive
     /// thread starts and IsRunning becomes true.
+    /// @param scheduling Priority/affinity/MMCSS for the receive thread,
+    ///        applied whenever it starts (including after a retry).
     /// @return True if bound and the receive thread started immediately.
-    bool Start(uint16_t port = kDefaultPort);
+    bool Start(uint16_t port = kDefaultPort, const ThreadSchedulingOptions& scheduling = {});
+
+    /// Starts the receiver on a shared Runtime instead of its own threads:
+    /// the socket is registered with the runtime and bind retries run on
+    /// its timers. Sample callbacks run on the runtime thread. The runtime
+    /// must outlive the receiver (or Stop() must be called first).
+    /// @return True if bound immediately; false if retrying as with Start.
+    bool Start(Runtime& runtime, uint16_t port = kDefaultPort);
 
     /// Stops the UDP receiver. Cancels any pending retry, joins both threads,
     /// closes the socket, and clears tracking state.
     void Stop();
 
     /// Optional logging callback for bind failures and retry messages.
-    /// Must be thread-safe: invoked from Start (caller thread) and from the
-    /// background retry thread.
-    void SetLog(std::function<void(const std::string&)> log) { m_log = std::move(log); }
+    /// Messages go through AsyncLog, so the callback runs on the log drain
+    /// thread, never on the receive or retry path. Set before Start.
+    void SetLog(std::function<void(const std::string&)> log) {
+        AsyncLog::Flush();
+        m_log = std::move(log);
+    }
+
+    /// Optional callback invoked on the receive thread after each sample is
+    /// published (sample.sequence is filled in). Must be set before Start and
+    /// must not block.
+    void SetSampleCallback(std::function<void(const TrackingSample&)> callback) {
+        m_sampleCallback = std::move(callback);
+    }
+
+    /// Opens a PipelineTrace record (arrival and publish time) for every
+    /// published sample, keyed by sample.sequence. Not owned; nullptr
+    /// turns tracing off. May be changed while running.
+    void SetPipelineTrace(PipelineTrace* trace) { m_trace.store(trace, std::memory_order_release); }
+
+    /// Opt in to kernel receive timestamps, so sample arrival times exclude
+    /// the receive thread's wake-up latency. Takes effect on the next bind
+    /// (Start or a successful retry). Falls back to steady_clock::now() after
+    /// recvfrom when the OS does not support it.
+    void SetKernelTimestamps(bool enable) { m_wantKernelTimestamps = enable; }
+
+    /// Records every datagram (valid or not) with its arrival time to a
+    /// capture file for ReplaySource. Takes effect when the receive thread
+    /// next starts; the file is closed by Stop(). Empty path disables.
+    void SetCaptureFile(std::string path) { m_capturePath = std::move(path); }
+
+    /// True if the running receive thread is writing a capture.
+    bool IsCapturing() const { return m_capturing.load(std::memory_order_acquire); }
+
+    /// True if the bound socket delivers kernel receive timestamps.
+    bool IsUsingKernelTimestamps() const { return m_kernelTimestamps.load(std::memory_order_acquire); }
+
+    /// Which scheduling settings took effect on the current receive thread.
+    ThreadSchedulingResult GetSchedulingResult() const;
 
     /// True if the receive thread is running.
     bool IsRunning() const { return m_running.load(std::memory_order_acquire); }
@@ -60,61 +118,142 @@ public:
     bool IsRetrying() const { return m_retrying.load(std::memory_order_acquire); }
 
     /// True if data has been received recently.
-    bool IsReceiving() const;
+    bool IsReceiving() const override;
 
     /// True if the data source is from a remote address.
-    bool IsRemoteConnection() const { return m_isRemoteConnection.load(std::memory_order_relaxed); }
+    bool IsRemoteConnection() const override { return m_isRemoteConnection.load(std::memory_order_relaxed); }
 
     /// True if the most recent bind attempt failed. Cleared once retry succeeds.
-    bool IsFailed() const { return m_failed.load(std::memory_order_acquire); }
+    bool IsFailed() const override { return m_failed.load(std::memory_order_acquire); }
 
     /// Timestamp of the last received packet (microseconds since epoch).
     /// Compare across frames to detect new samples for interpolation.
-    int64_t GetLastReceiveTimestamp() const { return m_lastReceiveTimestamp.load(std::memory_order_relaxed); }
+    int64_t GetLastReceiveTimestamp() const override;
+
+    /// Gets the latest raw sample (no recenter offset applied). Rotation,
+    /// position, timestamp, and sequence always come from the same packet;
+    /// center_yaw/pitch/roll hold the offset GetRotation subtracts from it.
+    /// Lock-free; safe to call from any thread.
+    /// @return True if a sample is available.
+    bool TryGetSample(TrackingSample& sample) const override { return ReadSample(sample); }
+
+    /// Copies every sample that arrived since the previous call, oldest first,
+    /// each with its own receive timestamp. Lets interpolators and filters use
+    /// real arrival times when the tracker runs faster than the frame rate.
+    /// Single consumer: call from one thread (typically once per frame).
+    /// @param out Destination array, at least maxCount entries.
+    /// @return Number of samples written. If more than maxCount (or more than
+    ///         TrackingSampleRing::kCapacity) arrived, the oldest are dropped.
+    size_t ReadNewSamples(TrackingSample* out, size_t maxCount);
 
     /// Gets the current rotation values with offset applied.
     /// @return True if data is available.
-    bool GetRotation(float& yaw, float& pitch, float& roll) const;
+    bool GetRotation(float& yaw, float& pitch, float& roll) const override;
 
-    /// Gets the current position values (in mm, from OpenTrack).
+    /// Gets the current position values (in meters, converted from OpenTrack cm).
     /// @return True if position data is available.
-    bool GetPosition(float& x, float& y, float& z) const;
+    bool GetPosition(float& x, float& y, float& z) const override;
 
     /// Sets the current position as the new center point.
-    void Recenter();
+    ///
+    /// Center changes are commands to the receive thread, which applies
+    /// them to the next packet before publishing it; the offset then rides
+    /// in the same coherent sample as the pose, so a reader never pairs a
+    /// pose with a half-updated or newer center. Recenter centers on that
+    /// next packet, so a tracker resuming after a pause centers on where
+    /// the head is now rather than on the stale pose; until a packet
+    /// arrives, GetRotation keeps the old center. The queue holds
+    /// kCommandCapacity commands; call center commands from one thread at a
+    /// time (e.g. the hotkey thread). Stop() discards pending commands.
+    void Recenter() override;
+
+    /// Clears the center offset. @return False if the command queue is full.
+    bool ResetCenter();
+
+    /// Sets an explicit center offset in degrees (e.g. one restored from
+    /// config). @return False if the command queue is full.
+    bool SetCenter(float yaw, float pitch, float roll);
+
+    /// Center commands that can be pending before the receive thread runs.
+    static constexpr size_t kCommandCapacity = 16;
+
+    /// Receive-path counters (packets, malformed, superseded, reordered) and the
+    /// inter-arrival histogram since the last Start. Lock-free.
+    ReceiverStatsSnapshot GetStats() const { return m_stats.Snapshot(); }
 
 private:
+    struct CenterCommand {
+        enum class Kind : uint8_t { Recenter, Reset, Set };
+        Kind kind = Kind::Reset;
+        float yaw = 0.0f;
+        float pitch = 0.0f;
+        float roll = 0.0f;
+    };
+
+    bool ReadSample(TrackingSample& sample) const;
+    bool PushCenterCommand(const CenterCommand& command);
+    void ApplyCenterCommands(TrackingSample& sample);
+    void NoteRead(uint64_t sequence) const;
+
     void ReceiverThread();
     void RetryThread();
     void StartRetryLoop();
     void StartReceiverThread();
+    void PrepareReceive();
+    void DrainSocket();
+    void BindOnRuntime();
+    void ScheduleRuntimeRetry();
+    void RetryOnRuntime();
+
+    template <typename... Args>
+    void Log(const char* format, const Args&... args) {
+        if (m_log) AsyncLog::Write(&UdpReceiver::WriteLog, this, 0, format, args...);
+    }
+    static void WriteLog(void* context, int level, const char* message);
 
     UdpSocket m_socket;
+    SocketWaiter m_waiter;
     std::thread m_thread;
     std::thread m_retryThread;
+    Runtime* m_runtime = nullptr;
+    int m_runtimeSource = 0;  // Runtime thread (or under Runtime::Call)
+    int m_retryTimer = 0;
+    int m_retryAttempts = 0;
     std::atomic<bool> m_running{false};
     std::atomic<bool> m_stopFlag{false};
     std::atomic<bool> m_retrying{false};
     std::atomic<bool> m_failed{false};
     uint16_t m_port{kDefaultPort};
+    bool m_wantKernelTimestamps{false};
+    std::string m_capturePath;
+    CaptureWriter m_capture;  // Receive thread only while running
+    SenderTimeline m_timeline;  // Receive thread only while running
+    std::atomic<bool> m_capturing{false};
+    ThreadSchedulingOptions m_scheduling;
+    std::string m_mmcssTask;  // Owns m_scheduling.mmcssTask across retries
+    ThreadSchedulingSlot m_schedulingResult;
+    std::atomic<bool> m_kernelTimestamps{false};
     std::function<void(const std::string&)> m_log;
+    std::function<void(const TrackingSample&)> m_sampleCallback;
+
+    // Latest packet, published as one coherent sample
+    SharedTrackingSample m_sample;
 
-    // Thread-safe tracking data
-    TrackingData m_trackingData;
+    // Recent packet history for ReadNewSamples
+    TrackingSampleRing m_history;
+    uint64_t m_historyCursor{0};
 
-    // Offset for recentering
-    std::atomic<float> m_yawOffset{0.0f};
-    std::atomic<float> m_pitchOffset{0.0f};
-    std::atomic<float> m_rollOffset{0.0f};
+    // Diagnostics; m_lastReadSequence lets the writer count superseded samples
+    ReceiverStats m_stats;
+    mutable std::atomic<uint64_t> m_lastReadSequence{0};
+    std::atomic<PipelineTrace*> m_trace{nullptr};
 
-    // Position data (mm, from OpenTrack)
-    std::atomic<float> m_posX{0.0f};
-    std::atomic<float> m_posY{0.0f};
-    std::atomic<float> m_posZ{0.0f};
-    std::atomic<bool> m_hasPosition{false};
+    // Recentering: commands in, current center applied by the receive thread
+    SpscQueue<CenterCommand, kCommandCapacity> m_centerCommands;
+    float m_centerYaw = 0.0f;    // Receive thread only while running
+    float m_centerPitch = 0.0f;
+    float m_centerRoll = 0.0f;
 
-    // Timestamp for connection detection
-    std::atomic<int64_t> m_lastReceiveTimestamp{0};
     std::atomic<bool> m_isRemoteConnection{false};
 };
 
@@ -9,6 +9,16 @@ namespace cameraunlock {
 /// Handles WSA init, socket creation, non-blocking mode, binding, and cleanup.
 class UdpSocket {
 public:
+    /// Datagrams fetched per recvmmsg call.
+    static constexpr int kReceiveBatchSize = 16;
+
+    /// Per-datagram scratch size for batched reads.
+    static constexpr int kMaxBatchDatagramSize = 256;
+
+    /// Decides whether ReceiveLatest may keep a datagram. Called once per
+    /// datagram in arrival order, so it may keep state in context.
+    using DatagramFilter = bool (*)(void* context, const char* data, int size);
+
     UdpSocket() = default;
     ~UdpSocket();
 
@@ -25,6 +35,43 @@ public:
     /// Closes the socket and cleans up WSA if needed.
     void Close();
 
+    /// Reads every queued datagram (up to maxDatagrams) and keeps only the
+    /// newest in buffer. Uses recvmmsg batches on Linux so a deep backlog
+    /// costs a few syscalls instead of one per datagram; other platforms fall
+    /// back to a recvfrom loop. Datagrams larger than kMaxBatchDatagramSize
+    /// (or size) are truncated.
+    /// @param sender Receives the newest kept datagram's source address.
+    /// @param datagramsRead Number of datagrams consumed, newest included.
+    /// @param bytesRead Total payload bytes consumed.
+    /// @param accept If set, only datagrams it accepts can be kept, so a
+    ///        malformed newest datagram doesn't hide a valid older one.
+    /// @param context Passed to accept.
+    /// @param datagramsRejected If set, receives the number accept refused.
+    /// @return Size of the newest kept datagram, or 0 if there was none.
+    int ReceiveLatest(char* buffer, int size, sockaddr_in& sender, int maxDatagrams,
+                      int& datagramsRead, uint64_t& bytesRead, DatagramFilter accept = nullptr,
+                      void* context = nullptr, int* datagramsRejected = nullptr);
+
+    /// Opts in to kernel receive timestamps (SO_TIMESTAMPNS / SO_TIMESTAMP
+    /// on POSIX, SIO_TIMESTAMPING on Windows 10+). Call after Open().
+    /// @return True if the OS accepted the request; ReceiveTimestamped then
+    ///         reports when the datagram reached the stack rather than when
+    ///         the receive thread woke up. On Linux the kernel switches
+    ///         stamping on asynchronously when the first socket opts in, so
+    ///         datagrams arriving in the first few milliseconds may carry
+    ///         the read time instead.
+    bool EnableReceiveTimestamps();
+
+    /// True if EnableReceiveTimestamps succeeded on the current socket.
+    bool HasReceiveTimestamps() const { return m_timestamps; }
+
+    /// Receives one datagram along with its arrival time.
+    /// @param arrivalUs Arrival on the steady_clock timeline (microseconds,
+    ///        same base as TrackingPose::CurrentTimestamp). Falls back to the
+    ///        time of the call when no kernel timestamp is available.
+    /// @return Bytes received, or SOCKET_ERROR (WOULDBLOCK when drained).
+    int ReceiveTimestamped(char* buffer, int size, sockaddr_in& sender, int64_t& arrivalUs);
+
     /// Returns the raw socket handle.
     SOCKET GetHandle() const { return m_socket; }
 
@@ -34,6 +81,10 @@ public:
 private:
     SOCKET m_socket = INVALID_SOCKET;
     bool m_wsaInitialized = false;
+    bool m_timestamps = false;
+#ifdef _WIN32
+    void* m_recvMsg = nullptr;  // LPFN_WSARECVMSG
+#endif
 };
 
 }  // namespace cameraunlock
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <reframework/API.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace cameraunlock::reframework {
+
+// Field offsets resolved once from the TDB, for hot-path reads that are a
+// plain pointer-plus-offset load instead of a by-name lookup and
+// get_data_raw per frame.
+//
+// Declare every "type.field" path up front (the type part goes through
+// FindType, so base names like "GUIMaster.<IsPause>k__BackingField" work),
+// then Resolve once at init. With a cache path, offsets are loaded from a
+// small text file when it was written for the same TDB (type, method and
+// field counts plus string pool size) and only re-resolved, and the file
+// rewritten, when that identity changes. Validate re-checks cached offsets
+// against the TDB, for debug builds or a first launch after a patch.
+//
+// Offsets are from the start of the managed object (get_offset_from_base),
+// so they apply to reference-type instances.
+//
+// Example:
+//   FieldOffsetIndex fields;
+//   int pauseField = fields.Add("GUIMaster.<IsPause>k__BackingField");
+//   fields.Resolve(tdb, "cameraunlock_fields.txt");
+//   ...
+//   bool paused = fields.Read<uint8_t>(guiMaster, pauseField) != 0;
+class FieldOffsetIndex {
+public:
+    static constexpr uint32_t kUnresolved = 0xFFFFFFFFu;
+
+    // Declare a path; returns its id. Adding after Resolve leaves it
+    // unresolved until the next Resolve.
+    int Add(const char* path);
+
+    // Resolve every declared path. Returns how many resolved.
+    size_t Resolve(::reframework::API::TDB* tdb, const char* cachePath = nullptr);
+
+    // Re-resolve through the TDB and compare; mismatches are corrected (and
+    // the cache rewritten). Returns the number of entries that differed.
+    size_t Validate(::reframework::API::TDB* tdb);
+
+    uint32_t GetOffset(int id) const {
+        return id >= 0 && static_cast<size_t>(id) < m_entries.size() ? m_entries[id].offset : kUnresolved;
+    }
+    bool IsResolved(int id) const { return GetOffset(id) != kUnresolved; }
+
+    // Address of the field in obj, or nullptr if obj is null or the path
+    // didn't resolve
+    void* Address(const void* obj, int id) const {
+        const uint32_t offset = GetOffset(id);
+        if (!obj || offset == kUnresolved) return nullptr;
+        return const_cast<uint8_t*>(static_cast<const uint8_t*>(obj) + offset);
+    }
+
+    // Field value, or fallback when the address isn't available
+    template <typename T>
+    T Read(const void* obj, int id, T fallback = T{}) const {
+        const void* p = Address(obj, id);
+        if (!p) return fallback;
+        T value;
+        std::memcpy(&value, p, sizeof(T));
+        return value;
+    }
+
+    // Entries answered from the cache file vs. resolved through the TDB
+    size_t GetCacheHits() const { return m_cacheHits; }
+    size_t GetTdbResolves() const { return m_tdbResolves; }
+    size_t GetCount() const { return m_entries.size(); }
+    const char* GetPath(int id) const {
+        return id >= 0 && static_cast<size_t>(id) < m_entries.size() ? m_entries[id].path.c_str() : nullptr;
+    }
+
+private:
+    struct Entry {
+        std::string path;
+        uint32_t offset = kUnresolved;
+    };
+
+    struct TdbIdentity {
+        uint32_t types = 0;
+        uint32_t methods = 0;
+        uint32_t fields = 0;
+        uint32_t strings = 0;
+        bool operator==(const TdbIdentity& o) const {
+            return types == o.types && methods == o.methods && fields == o.fields && strings == o.strings;
+        }
+    };
+
+    static TdbIdentity GetIdentity(::reframework::API::TDB* tdb);
+    static uint32_t ResolveThroughTdb(::reframework::API::TDB* tdb, const std::string& path);
+    bool Load(const TdbIdentity& identity, std::vector<uint32_t>& offsets) const;
+    bool Save(const TdbIdentity& identity) const;
+
+    std::vector<Entry> m_entries;
+    std::string m_cachePath;
+    size_t m_cacheHits = 0;
+    size_t m_tdbResolves = 0;
+};
+
+} // namespace cameraunlock::reframework
@@ -15,16 +15,32 @@ struct MethodCheck {
 // Set the namespace candidates used by FindType/FindSingleton.
 // Default: "app", "app.gui", "app.ropeway", "app.ropeway.gui",
 //          "requiem", "requiem.gui", "chainsaw", "chainsaw.gui"
+// Clears cached types and singleton names.
 void SetNamespaceCandidates(const char* const* candidates, int count);
 
+// Lookups below go through a thread-safe resolution cache keyed by base
+// name, so calling them every frame costs a hash lookup after the first hit.
+// Types and methods are cached for the life of the process (the TDB doesn't
+// change); singleton full names are cached once found and dropped here.
+// Instances are never cached: the game recreates managers, so each call
+// fetches the current one.
+void InvalidateResolutionCache();
+
 // Try to find a type across all namespace candidates.
 ::reframework::API::TypeDefinition* FindType(
     ::reframework::API::TDB* tdb, const char* baseName);
 
 // Try to find a managed singleton across namespace candidates.
-// Returns pointer to a static buffer — valid until next call.
+// Returns the winning full name ("app.ropeway.GameMaster"), interned: the
+// pointer stays valid for the life of the process.
 const char* FindSingleton(const ::reframework::API* api, const char* baseName);
 
+// Current managed singleton instance for a base name (FindSingleton's
+// winner, cached) or a full name. Fetched on every call, so it never
+// outlives a recreated manager; nullptr if it doesn't exist.
+void* FindSingletonInstance(const ::reframework::API* api, const char* baseName);
+void* GetSingletonInstance(const ::reframework::API* api, const char* fullName);
+
 // Try to find a method on a type, trying multiple name variants.
 ::reframework::API::Method* FindMethod(
     ::reframework::API::TypeDefinition* type, const char* names[], int count);
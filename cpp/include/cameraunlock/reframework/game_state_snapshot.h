@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cameraunlock/reframework/game_state_probing.h>
+#include <reframework/API.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace cameraunlock::reframework {
+
+// Which Invoke* helper a probe uses, and so how its result reads back.
+enum class GameStateProbeKind { Bool, Int, Pointer };
+
+// Batched, throttled evaluation of game state probes (pause, menu, cutscene,
+// loading...). Register each resolved MethodCheck once with a refresh
+// interval; the game thread calls Update() once per frame, which invokes
+// only the probes that are due, and any code in the mod reads the cached
+// results lock-free instead of making its own managed calls.
+//
+// A probe that has not run yet reads as its Invoke* fallback (false, 0 or
+// the (void*)1 sentinel). A probe whose invoke faults is disabled, as with
+// a bare MethodCheck, and keeps returning the fallback.
+//
+// Example:
+//   auto& snapshot = GameStateSnapshot::Instance();
+//   s_paused = snapshot.AddProbe(pauseCheck, GameStateProbeKind::Bool, "paused");
+//   s_menu   = snapshot.AddProbe(menuCheck, GameStateProbeKind::Bool, "menu", 100);
+//   ...
+//   snapshot.Update(api, vmCtx);          // pre-frame hook
+//   if (snapshot.GetBool(s_paused)) ...   // anywhere
+class GameStateSnapshot {
+public:
+    static constexpr size_t kMaxProbes = 32;
+
+    // Shared instance for everything linked into this module.
+    static GameStateSnapshot& Instance();
+
+    // Register a probe, refreshed at most every intervalMs (0 = every
+    // Update). The check is copied. Returns the probe id, or -1 if the
+    // table is full.
+    int AddProbe(const MethodCheck& check, GameStateProbeKind kind, const char* label, uint32_t intervalMs = 0);
+
+    // Game thread: run every probe that is due. Probes run in
+    // registration order.
+    void Update(const ::reframework::API* api, void* vmCtx);
+
+    // Make every probe due on the next Update (e.g. after a scene change).
+    void RefreshAll();
+
+    // Log each result as it's refreshed.
+    void SetDiagnostics(bool enabled) { m_diag.store(enabled, std::memory_order_relaxed); }
+
+    // Cached results; any thread. An invalid id reads as the fallback.
+    bool GetBool(int id) const;
+    uint32_t GetInt(int id) const;
+    void* GetPointer(int id) const;
+
+    // True once the probe has run at least once.
+    bool HasResult(int id) const;
+
+    size_t GetProbeCount() const { return m_count.load(std::memory_order_acquire); }
+
+private:
+    struct Probe {
+        MethodCheck check;
+        GameStateProbeKind kind = GameStateProbeKind::Bool;
+        const char* label = nullptr;
+        int64_t intervalUs = 0;
+        int64_t lastRunUs = 0;
+        bool due = true;
+
+        std::atomic<uint64_t> value{0};
+        std::atomic<bool> hasResult{false};
+    };
+
+    const Probe* Find(int id) const;
+
+    std::mutex m_mutex;   // registration vs Update; readers never take it
+    Probe m_probes[kMaxProbes];
+    std::atomic<size_t> m_count{0};
+    std::atomic<bool> m_diag{false};
+};
+
+} // namespace cameraunlock::reframework
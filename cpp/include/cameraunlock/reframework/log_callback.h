@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cameraunlock/diagnostics/async_log.h>
+
 namespace cameraunlock::reframework {
 
 // Log severity levels
@@ -9,10 +11,21 @@ enum class LogLevel { Info = 0, Warning = 1, Error = 2 };
 using LogCallbackFn = void(*)(LogLevel level, const char* message);
 
 // Set the logging callback. Must be called before using any reframework utilities.
-// Pass nullptr to disable logging.
+// Pass nullptr to disable logging. The callback runs on the AsyncLog drain
+// thread, so it no longer needs to be safe to call from a game hook.
 void SetLogCallback(LogCallbackFn fn);
 
-// Internal: call the registered callback (no-op if null).
-void Log(LogLevel level, const char* fmt, ...);
+namespace log_detail {
+bool HasCallback();
+void Deliver(void* context, int level, const char* message);
+}
+
+// Internal: queue a line for the registered callback (no-op if null).
+// Formatting happens on the drain thread; see AsyncLog.
+template <typename... Args>
+void Log(LogLevel level, const char* fmt, const Args&... args) {
+    if (!log_detail::HasCallback()) return;
+    AsyncLog::Write(&log_detail::Deliver, nullptr, static_cast<int>(level), fmt, args...);
+}
 
 } // namespace cameraunlock::reframework
@@ -2,26 +2,66 @@
 
 #include <reframework/API.hpp>
 #include <vector>
+#include <span>
 #include <cstddef>
 #include <cstdint>
+#include <type_traits>
 
 namespace cameraunlock::reframework {
 
 // Shared empty args vector for invoke calls with no parameters.
 const std::vector<void*>& EmptyArgs();
 
-// Read a managed String object (System.String / via.gui) into a narrow buffer.
-// RE Engine managed strings store UTF-16 at offset 0x14.
+// Read a managed String object (System.String / via.gui) into a narrow buffer
+// as UTF-8. RE Engine managed strings store their length at offset 0x10 and
+// UTF-16 at offset 0x14. Output is truncated to fit, never mid-character.
 void ReadManagedString(void* stringPtr, char* out, size_t outSize);
 
-// Invoke a method on a managed object with no arguments, returning the raw pointer.
-void* CallMethod(::reframework::API::Method* method, void* obj);
+// Convert up to `count` UTF-16 code units (stopping early at a NUL) into `out`
+// as UTF-8, always NUL-terminated when `out` is non-empty. Runs of ASCII are
+// converted 8 units at a time. Unpaired surrogates become U+FFFD. Returns the
+// number of bytes written, excluding the terminator.
+size_t Utf16ToUtf8(const char16_t* in, size_t count, std::span<char> out);
 
-// Read element i from a managed System.Array via GetValue(int).
+namespace managed_detail {
+
+template <typename T>
+void* ToArg(T value) {
+    if constexpr (std::is_pointer_v<T>) {
+        return const_cast<void*>(reinterpret_cast<const void*>(value));
+    } else {
+        static_assert(std::is_integral_v<T> || std::is_enum_v<T>,
+                      "managed args are pointers or pointer-sized integers");
+        return (void*)(uintptr_t)value;
+    }
+}
+
+} // namespace managed_detail
+
+// Invoke a method with 0-4 arguments. The argument list lives on the stack and
+// is passed as a span, so no std::vector is built per call. Integers and enums
+// are passed by value in the pointer slot, as REFramework expects.
+template <typename... Args>
+::reframework::InvokeRet Invoke(::reframework::API::Method* method, void* obj, Args... args) {
+    static_assert(sizeof...(Args) <= 4, "Invoke supports up to 4 arguments");
+    void* argv[sizeof...(Args) + 1] = { managed_detail::ToArg(args)... };
+    return method->invoke(reinterpret_cast<::reframework::API::ManagedObject*>(obj),
+                          std::span<void*>(argv, sizeof...(Args)));
+}
+
+// Invoke a method on a managed object, returning the raw pointer.
+template <typename... Args>
+void* CallMethod(::reframework::API::Method* method, void* obj, Args... args) {
+    return Invoke(method, obj, args...).ptr;
+}
+
+// Read element i from a managed System.Array via GetValue(int). The GetValue
+// method is resolved once per array type.
 ::reframework::API::ManagedObject* ArrayGetValue(
     ::reframework::API::ManagedObject* arr, int i);
 
 // Find a method on a type with a specific parameter count (disambiguates overloads).
+// Results, misses included, are cached for the life of the process.
 ::reframework::API::Method* FindMethodByParamCount(
     const char* typeName, const char* methodName, uint32_t paramCount);
 
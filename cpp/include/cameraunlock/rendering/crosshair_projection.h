@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cameraunlock/math/fast_math.h>
 #include <cameraunlock/math/rotation_utils.h>
+#include <cameraunlock/processing/pose_latch.h>
 #include <cmath>
 
 namespace cameraunlock::rendering {
@@ -35,9 +37,11 @@ struct ScreenPosition {
 // Constants
 constexpr float kDegToRad = 0.0174532925f;  // pi / 180
 
-// Project crosshair position based on head tracking and camera state.
-// This computes where the "body aim" direction appears on screen when
-// the camera has been rotated by head tracking.
+// Per-frame projection terms for one head pose: the head-rotated camera
+// basis expressed in the original (pre-head-tracking) camera space, and
+// the perspective scale. Build it once per frame with
+// BuildFrameProjectionContext; every point projected through it then
+// costs a 3x3 transform and one divide instead of fresh sin/cos.
 //
 // The rotation model uses camera-local axes:
 //   Yaw around camera up (0,1,0), Pitch around camera right (0,0,-1).
@@ -45,15 +49,39 @@ constexpr float kDegToRad = 0.0174532925f;  // pi / 180
 // This matches ApplyHeadTrackingRotation in rotation_math.h.
 //
 // Coordinate system: X=forward, Y=up, Z=left (DL2)
-inline ScreenPosition ProjectCrosshair(const CrosshairProjectionParams& params) {
-    ScreenPosition result;
-    result.valid = false;
+struct FrameProjectionContext {
+    // Rotated camera axes in original camera space. The basis is
+    // orthonormal, so its inverse is the transpose: a rotated-frame vector
+    // (d, u, l) is d*forward + u*up + l*left in the original frame.
+    float forward[3] = {1.0f, 0.0f, 0.0f};
+    float up[3]      = {0.0f, 1.0f, 0.0f};
+    float left[3]    = {0.0f, 0.0f, 1.0f};
+
+    // Perspective scale
+    float tanHalfHFov = 1.0f;
+    float tanHalfVFov = 1.0f;
+    float invTanHalfHFov = 1.0f;
+    float invTanHalfVFov = 1.0f;
+    float halfWidth  = 960.0f;
+    float halfHeight = 540.0f;
+
+    // Up collapsed onto forward (looking straight up or down): every
+    // projection returns the screen centre, as ProjectCrosshair always has
+    bool degenerate = false;
+};
+
+inline FrameProjectionContext BuildFrameProjectionContext(const CrosshairProjectionParams& params) {
+    FrameProjectionContext ctx;
 
     // FOV for perspective projection
     float aspectRatio = params.screenWidth / params.screenHeight;
     float hFovRad = params.fovDegrees * kDegToRad;
-    float tanHalfHFov = std::tan(hFovRad / 2.0f);
-    float tanHalfVFov = tanHalfHFov / aspectRatio;
+    ctx.tanHalfHFov = cameraunlock::math::trig::Tan(hFovRad / 2.0f);
+    ctx.tanHalfVFov = ctx.tanHalfHFov / aspectRatio;
+    ctx.invTanHalfHFov = 1.0f / ctx.tanHalfHFov;
+    ctx.invTanHalfVFov = 1.0f / ctx.tanHalfVFov;
+    ctx.halfWidth  = params.screenWidth / 2.0f;
+    ctx.halfHeight = params.screenHeight / 2.0f;
 
     // Match camera hook sign conventions exactly:
     //   yaw = -processedYaw * DEG_TO_RAD
@@ -66,26 +94,27 @@ inline ScreenPosition ProjectCrosshair(const CrosshairProjectionParams& params)
     // Camera space before head tracking: fwd=(1,0,0), up=(0,1,0), right=(0,0,-1)
     // Construct forward from spherical coordinates — matches ApplyHeadTrackingRotation.
     // This ensures yaw and pitch are independent (no arc artifacts).
-    float cosY = std::cos(yawRad), sinY = std::sin(yawRad);
-    float cosP = std::cos(pitchRad), sinP = std::sin(pitchRad);
+    float cosY, sinY, cosP, sinP;
+    cameraunlock::math::trig::SinCos(yawRad, sinY, cosY);
+    cameraunlock::math::trig::SinCos(pitchRad, sinP, cosP);
 
     // fwd = cosP*cosY*forward + cosP*sinY*right - sinP*up
     // In camera space: forward=(1,0,0), up=(0,1,0), right=(0,0,-1)
-    float fwd[3] = {
-        cosP * cosY,        // forward component
-        -sinP,              // vertical component
-        -cosP * sinY        // horizontal component (right = -Z in DL2)
-    };
+    float* fwd = ctx.forward;
+    fwd[0] = cosP * cosY;        // forward component
+    fwd[1] = -sinP;              // vertical component
+    fwd[2] = -cosP * sinY;       // horizontal component (right = -Z in DL2)
 
     // Re-derive up: project origUp=(0,1,0) perpendicular to new fwd
     float origUp[3] = {0.0f, 1.0f, 0.0f};
     float dot = cameraunlock::math::Dot3(fwd, origUp);
-    float newUp[3] = {origUp[0] - fwd[0] * dot, origUp[1] - fwd[1] * dot, origUp[2] - fwd[2] * dot};
+    float* newUp = ctx.up;
+    newUp[0] = origUp[0] - fwd[0] * dot;
+    newUp[1] = origUp[1] - fwd[1] * dot;
+    newUp[2] = origUp[2] - fwd[2] * dot;
     if (cameraunlock::math::Normalize3(newUp) < 0.0001f) {
-        result.x = params.screenWidth / 2.0f;
-        result.y = params.screenHeight / 2.0f;
-        result.valid = true;
-        return result;
+        ctx.degenerate = true;
+        return ctx;
     }
 
     // Roll: rotate up around new fwd
@@ -96,47 +125,99 @@ inline ScreenPosition ProjectCrosshair(const CrosshairProjectionParams& params)
     }
 
     // Left axis of new camera frame
-    float newLeft[3];
-    cameraunlock::math::Cross3(fwd, newUp, newLeft);
+    cameraunlock::math::Cross3(fwd, newUp, ctx.left);
+    return ctx;
+}
 
-    // Body aim = (1,0,0) projected into new camera frame.
-    // Since body = (1,0,0), dot products simplify to [0] components.
-    float bDepth = fwd[0];
-    float bUp    = newUp[0];
-    float bLeft  = newLeft[0];
+// Where a direction given in the original camera space appears on screen
+// in the head-rotated view. Directions behind the camera are pushed just
+// in front of it, so they land far off-screen rather than flipping.
+inline ScreenPosition ProjectDirection(const FrameProjectionContext& ctx, const float dir[3]) {
+    ScreenPosition result;
+    result.x = ctx.halfWidth;
+    result.y = ctx.halfHeight;
+    result.valid = true;
+    if (ctx.degenerate) return result;
 
-    // Prevent division by zero (body aim behind camera)
+    // Direction in the rotated camera frame (basis rows dotted with dir)
+    float bDepth = cameraunlock::math::Dot3(ctx.forward, dir);
+    float bUp    = cameraunlock::math::Dot3(ctx.up, dir);
+    float bLeft  = cameraunlock::math::Dot3(ctx.left, dir);
+
+    // Prevent division by zero (direction behind camera)
     if (bDepth < 0.01f) bDepth = 0.01f;
 
     // NaN check
-    if (bDepth != bDepth || bUp != bUp || bLeft != bLeft) {
-        result.x = params.screenWidth / 2.0f;
-        result.y = params.screenHeight / 2.0f;
-        result.valid = true;
-        return result;
-    }
+    if (bDepth != bDepth || bUp != bUp || bLeft != bLeft) return result;
 
-    // Perspective projection: body aim direction in screen space.
-    float normalizedX = bLeft / (bDepth * tanHalfHFov);
-    float normalizedY = -bUp / (bDepth * tanHalfVFov);
+    // Perspective projection into [-1, 1] screen space
+    const float invDepth = 1.0f / bDepth;
+    float normalizedX = bLeft * invDepth * ctx.invTanHalfHFov;
+    float normalizedY = -bUp * invDepth * ctx.invTanHalfVFov;
 
     // Convert to screen pixels (Y inverted for screen coordinates)
-    float cx = (params.screenWidth / 2.0f) + normalizedX * (params.screenWidth / 2.0f);
-    float cy = (params.screenHeight / 2.0f) - normalizedY * (params.screenHeight / 2.0f);
+    float cx = ctx.halfWidth + normalizedX * ctx.halfWidth;
+    float cy = ctx.halfHeight - normalizedY * ctx.halfHeight;
 
     // Final NaN check
-    if (cx != cx || cy != cy) {
-        cx = params.screenWidth / 2.0f;
-        cy = params.screenHeight / 2.0f;
-    }
+    if (cx != cx || cy != cy) return result;
 
     result.x = cx;
     result.y = cy;
-    result.valid = true;
-
     return result;
 }
 
+// Inverse of ProjectDirection: the original-camera-space direction (not
+// normalized, forward component along the rotated view axis = 1) seen at
+// pixel (x, y) of the head-rotated view.
+inline void UnprojectToDirection(const FrameProjectionContext& ctx, float x, float y, float out[3]) {
+    const float l = (x - ctx.halfWidth) / ctx.halfWidth * ctx.tanHalfHFov;
+    const float u = (y - ctx.halfHeight) / ctx.halfHeight * ctx.tanHalfVFov;
+    for (int i = 0; i < 3; ++i) {
+        out[i] = ctx.forward[i] + u * ctx.up[i] + l * ctx.left[i];
+    }
+}
+
+// Where a point drawn at pixel (nativeX, nativeY) by the game's own,
+// un-head-tracked camera appears in the head-rotated view. For world-
+// anchored markers at any depth (rotation only, no head translation).
+inline ScreenPosition ProjectNativeScreenPoint(const FrameProjectionContext& ctx, float nativeX, float nativeY) {
+    // The native camera's basis is the identity
+    const float dir[3] = {
+        1.0f,
+        (nativeY - ctx.halfHeight) / ctx.halfHeight * ctx.tanHalfVFov,
+        (nativeX - ctx.halfWidth) / ctx.halfWidth * ctx.tanHalfHFov,
+    };
+    return ProjectDirection(ctx, dir);
+}
+
+// Project crosshair position based on head tracking and camera state.
+// This computes where the "body aim" direction appears on screen when
+// the camera has been rotated by head tracking: body aim is the original
+// camera forward, (1,0,0).
+inline ScreenPosition ProjectCrosshair(const FrameProjectionContext& ctx) {
+    const float bodyAim[3] = {1.0f, 0.0f, 0.0f};
+    return ProjectDirection(ctx, bodyAim);
+}
+
+// One-shot form; build a FrameProjectionContext instead when projecting
+// more than one point for the same pose.
+inline ScreenPosition ProjectCrosshair(const CrosshairProjectionParams& params) {
+    return ProjectCrosshair(BuildFrameProjectionContext(params));
+}
+
+// Late latch: move the head offsets by the rotation the tracker reported
+// after the game read its pose, so a reticle projected at Present time
+// matches the freshest sample. `gain` scales the raw delta to the mod's
+// processed offsets (sensitivity); invalid deltas change nothing.
+inline void ApplyLatchedPoseDelta(CrosshairProjectionParams& params, const LatchedPoseDelta& delta,
+                                  float gain = 1.0f) {
+    if (!delta.valid) return;
+    params.yawOffset += delta.yaw * gain;
+    params.pitchOffset += delta.pitch * gain;
+    params.rollOffset += delta.roll * gain;
+}
+
 // Clamp screen position to visible area with margin
 inline void ClampToScreen(ScreenPosition& pos, float screenWidth, float screenHeight, float margin = 10.0f) {
     if (pos.x < margin) pos.x = margin;
@@ -20,28 +20,88 @@
 //   overlay.Install();
 //   ...
 //   overlay.Remove();
-
+//
+// Retained layers: geometry that rarely changes can live in a named layer.
+// Its vertices stay on the GPU and are re-uploaded only when their hash
+// changes; moving a layer only rewrites its offset constant. Passing a
+// content key lets the callback skip rebuilding an unchanged layer:
+//   if (dc.BeginLayer("reticle", reticleVersion, aimX, aimY)) {
+//       dc.DrawCross(0, 0, 12.0f, 0xFFFFFFFF, 1.5f, 4.0f);   // layer-local coords
+//   }
+//   dc.EndLayer();
+//
+// Instanced primitives: with SetInstancedPrimitives(true), lines, dots,
+// rings and rects drawn outside a layer become one 32-byte SDF instance each
+// (overlay_primitives.h) instead of CPU-built triangles, with analytic
+// anti-aliasing. Layers keep using triangles so their retained path is unchanged.
+//
+// Text: dc.DrawString(x, y, "RX 250 Hz", color, 2.0f) draws the embedded
+// 5x7 font (overlay_font.h). Glyphs are ordinary quads in the vertex buffer
+// (or glyph instances when instanced), so a HUD of any length stays in the
+// same single draw; the font table is compiled into the pixel shader.
+//
+// Timing: every frame records the callback's CPU time, the upload's CPU
+// time and (where timestamp queries work) the overlay draw's GPU time.
+// GetTimings() returns rolling min/avg/p99; SetTimingLineVisible(true)
+// draws the same numbers in the top-left corner (overlay_timing.h).
+//
+// Late latch: with SetPoseLatch, the Present hook reads the freshest
+// tracker sample right before the callback and hands the change since the
+// game's registered pose to dc.PoseDelta() (see ApplyLatchedPoseDelta).
+//
+// Display-time prediction: the Present hook timestamps every frame and reads
+// the swap chain's frame statistics where available. GetPresentTiming()
+// returns the sampler, whose PredictNextDisplayTime() is the target time to
+// hand TrackingProcessor::ProcessPredicted.
+
+#include <cameraunlock/rendering/overlay_primitives.h>
+#include <cameraunlock/rendering/overlay_timing.h>
+#include <cameraunlock/processing/pose_latch.h>
+#include <cameraunlock/processing/present_timing.h>
+#include <cameraunlock/diagnostics/pipeline_trace.h>
+
+#include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace cameraunlock::rendering {
 
-// 0xAABBGGRR (D3D11 R8G8B8A8_UNORM with little-endian byte order in memory).
-using Rgba = uint32_t;
-
-// Vertex emitted to the GPU. Pixel coords + packed color.
+// Vertex emitted to the GPU. Pixel coords + packed color, plus font atlas
+// texel coords (overlay_font.h); the default 0,0 is the solid cell.
 struct DX11OverlayVertex {
-    float x;
-    float y;
-    Rgba  color;
+    float    x;
+    float    y;
+    Rgba     color;
+    uint16_t u = 0;
+    uint16_t v = 0;
+};
+static_assert(sizeof(DX11OverlayVertex) == 16, "DX11OverlayVertex matches the input layout");
+
+// One retained layer as the render callback declared it this frame
+struct DX11LayerRecord {
+    std::string name;
+    uint64_t content_key;   // caller's version stamp, 0 = always rebuilt and hashed
+    float offset_x;         // pixel offset applied on the GPU
+    float offset_y;
+    bool kept;              // BeginLayer returned false: last frame's geometry is reused
+    size_t first_vertex;    // range in LayerVerts()
+    size_t vertex_count;
 };
 
 // Drawing context passed to the render callback. Accumulates primitives into
-// CPU-side vectors; the overlay flushes them once per frame.
+// CPU-side vectors; the overlay flushes them once per frame. Primitives drawn
+// outside a layer are uploaded every frame and drawn on top of all layers.
 class DX11DrawContext {
 public:
-    DX11DrawContext(float w, float h) : m_width(w), m_height(h) {}
+    // retained_keys: content keys of layers already on the GPU, so
+    // BeginLayer can tell the callback to skip an unchanged one
+    // instanced: emit SDF primitives instead of triangles outside layers
+    DX11DrawContext(float w, float h, const std::unordered_map<std::string, uint64_t>* retained_keys = nullptr,
+                    bool instanced = false)
+        : m_width(w), m_height(h), m_retainedKeys(retained_keys), m_instanced(instanced) {}
 
     float Width()  const { return m_width;  }
     float Height() const { return m_height; }
@@ -49,21 +109,64 @@ public:
     void DrawLine(float x1, float y1, float x2, float y2, Rgba color, float thickness = 1.0f);
     void DrawRect(float x, float y, float w, float h, Rgba color);
     void DrawDot(float cx, float cy, float radius, Rgba color);
+    void DrawRing(float cx, float cy, float radius, float thickness, Rgba color);
 
     // Crosshair: 4 line segments centred at (cx, cy), each `arm` long with a
     // central `gap` left empty.
     void DrawCross(float cx, float cy, float arm, Rgba color, float thickness = 1.0f, float gap = 0.0f);
 
+    // Text in the embedded 5x7 font, each font texel `scale` pixels square.
+    // '\n' starts a new line. Returns the widest line's width.
+    float DrawString(float x, float y, const char* text, Rgba color, float scale = 1.0f);
+
+    // Start a retained layer; following primitives go into it until
+    // EndLayer or the next BeginLayer. Returns false when content_key is
+    // non-zero and matches what's already on the GPU: the layer is kept
+    // (only the offset applies) and the callback can skip drawing into it.
+    bool BeginLayer(const char* name, uint64_t content_key = 0, float offset_x = 0.0f, float offset_y = 0.0f);
+    void EndLayer();
+
     const std::vector<DX11OverlayVertex>& TriVerts()  const { return m_triVerts;  }
+    const std::vector<DX11OverlayVertex>& LayerVerts() const { return m_layerVerts; }
+    const std::vector<DX11LayerRecord>& Layers() const { return m_layers; }
+    const std::vector<OverlayPrimitive>& Primitives() const { return m_prims; }
+
+    // Head rotation since the game read the pose this frame was rendered
+    // with, latched at Present; invalid without a PoseLatch
+    const LatchedPoseDelta& PoseDelta() const { return m_poseDelta; }
+    void SetPoseDelta(const LatchedPoseDelta& delta) { m_poseDelta = delta; }
 
 private:
+    std::vector<DX11OverlayVertex>& Out() { return m_activeLayer >= 0 ? m_layerVerts : m_triVerts; }
+    bool Instanced() const { return m_instanced && m_activeLayer < 0; }
+
     float m_width;
     float m_height;
     std::vector<DX11OverlayVertex> m_triVerts;  // triangle list
+    std::vector<DX11OverlayVertex> m_layerVerts;  // all layers' triangles, ranges in m_layers
+    std::vector<DX11LayerRecord> m_layers;
+    int m_activeLayer = -1;
+    const std::unordered_map<std::string, uint64_t>* m_retainedKeys;
+    std::vector<OverlayPrimitive> m_prims;  // instanced SDF shapes
+    bool m_instanced;
+    LatchedPoseDelta m_poseDelta;
 };
 
 using DX11RenderCallback = std::function<void(DX11DrawContext&)>;
 
+// How the overlay keeps the game's pipeline state intact around its draw.
+//   SaveRestore     - read back and re-bind the handful of states the overlay
+//                     sets (ContextStateScope). Works everywhere.
+//   DeferredContext - record the draw once into a command list on a deferred
+//                     context and replay it with ExecuteCommandList, letting
+//                     the runtime restore state. The list is re-recorded only
+//                     when the vertex count or a bound resource changes; the
+//                     buffers are DEFAULT usage so replays see new contents.
+enum class DX11StateMode {
+    SaveRestore,
+    DeferredContext,
+};
+
 // Optional diagnostic log sink. Format string is printf-style.
 using DX11LogFn = void (*)(const char* msg);
 void SetDX11OverlayLogger(DX11LogFn fn);
@@ -84,6 +187,33 @@ public:
 
     void SetRenderCallback(DX11RenderCallback cb);
 
+    // Takes effect on the next device (re)initialization; falls back to
+    // SaveRestore if the device can't create a deferred context.
+    void SetStateMode(DX11StateMode mode);
+
+    // Draw shapes as instanced SDF primitives (also on the next device
+    // initialization); falls back to triangles if the shaders don't compile
+    void SetInstancedPrimitives(bool enabled);
+
+    // Rolling min/avg/p99 of the overlay's own cost; GPU times lag a few
+    // frames behind because the queries are never waited on
+    OverlayTimingReport GetTimings() const;
+
+    // Draw the timing summary as a stats line in the top-left corner
+    void SetTimingLineVisible(bool visible);
+
+    // Latch this pose source at Present and pass the delta to the render
+    // callback. Not owned; nullptr turns late latching off.
+    void SetPoseLatch(const PoseLatch* latch);
+
+    // Present interval and scanout latency observed at the hooked swap
+    // chain; readable from any thread
+    const PresentTimingSampler& GetPresentTiming() const;
+
+    // Stamp each Present in this pipeline trace. Not owned; nullptr turns
+    // it off.
+    void SetPipelineTrace(PipelineTrace* trace);
+
     bool IsInstalled() const { return m_hookInstalled; }
 
 private:
@@ -104,8 +234,10 @@ private:
 #include <d3dcompiler.h>
 #include <MinHook.h>
 #include <Windows.h>
+#include <cameraunlock/rendering/dxgi_present_timing.h>
 #include <cstring>
 #include <cmath>
+#include <chrono>
 
 #pragma comment(lib, "d3d11.lib")
 #pragma comment(lib, "dxgi.lib")
@@ -116,13 +248,17 @@ namespace cameraunlock::rendering {
 // ---------- DX11DrawContext ---------------------------------------------------
 
 inline void DX11DrawContext::DrawRect(float x, float y, float w, float h, Rgba color) {
+    if (Instanced()) {
+        m_prims.push_back(MakeRectPrimitive(x, y, w, h, color));
+        return;
+    }
     // Two triangles (CCW with screen-space y-down would be CW; we disable culling so it doesn't matter).
     DX11OverlayVertex v0{x,     y,     color};
     DX11OverlayVertex v1{x + w, y,     color};
     DX11OverlayVertex v2{x + w, y + h, color};
     DX11OverlayVertex v3{x,     y + h, color};
-    m_triVerts.push_back(v0); m_triVerts.push_back(v1); m_triVerts.push_back(v2);
-    m_triVerts.push_back(v0); m_triVerts.push_back(v2); m_triVerts.push_back(v3);
+    Out().push_back(v0); Out().push_back(v1); Out().push_back(v2);
+    Out().push_back(v0); Out().push_back(v2); Out().push_back(v3);
 }
 
 inline void DX11DrawContext::DrawLine(float x1, float y1, float x2, float y2, Rgba color, float thickness) {
@@ -131,6 +267,10 @@ inline void DX11DrawContext::DrawLine(float x1, float y1, float x2, float y2, Rg
     float dx = x2 - x1, dy = y2 - y1;
     float len = std::sqrt(dx*dx + dy*dy);
     if (len < 1e-3f) return;
+    if (Instanced()) {
+        m_prims.push_back(MakeLinePrimitive(x1, y1, x2, y2, color, thickness));
+        return;
+    }
     float nx = -dy / len, ny = dx / len;     // perpendicular
     float t = thickness * 0.5f;
     float ox = nx * t, oy = ny * t;
@@ -139,11 +279,15 @@ inline void DX11DrawContext::DrawLine(float x1, float y1, float x2, float y2, Rg
     DX11OverlayVertex b{x2 - ox, y2 - oy, color};
     DX11OverlayVertex c{x2 + ox, y2 + oy, color};
     DX11OverlayVertex d{x1 + ox, y1 + oy, color};
-    m_triVerts.push_back(a); m_triVerts.push_back(b); m_triVerts.push_back(c);
-    m_triVerts.push_back(a); m_triVerts.push_back(c); m_triVerts.push_back(d);
+    Out().push_back(a); Out().push_back(b); Out().push_back(c);
+    Out().push_back(a); Out().push_back(c); Out().push_back(d);
 }
 
 inline void DX11DrawContext::DrawDot(float cx, float cy, float radius, Rgba color) {
+    if (Instanced()) {
+        m_prims.push_back(MakeCirclePrimitive(cx, cy, radius, color));
+        return;
+    }
     constexpr int kSegments = 16;
     constexpr float kTau = 6.28318530718f;
     DX11OverlayVertex centre{cx, cy, color};
@@ -152,12 +296,79 @@ inline void DX11DrawContext::DrawDot(float cx, float cy, float radius, Rgba colo
         float a1 = (kTau * (i + 1)) / kSegments;
         DX11OverlayVertex p0{cx + std::cos(a0) * radius, cy + std::sin(a0) * radius, color};
         DX11OverlayVertex p1{cx + std::cos(a1) * radius, cy + std::sin(a1) * radius, color};
-        m_triVerts.push_back(centre);
-        m_triVerts.push_back(p0);
-        m_triVerts.push_back(p1);
+        Out().push_back(centre);
+        Out().push_back(p0);
+        Out().push_back(p1);
+    }
+}
+
+inline void DX11DrawContext::DrawRing(float cx, float cy, float radius, float thickness, Rgba color) {
+    if (Instanced()) {
+        m_prims.push_back(MakeRingPrimitive(cx, cy, radius, thickness, color));
+        return;
+    }
+    // Triangle fallback: a strip of quads between the inner and outer edge
+    constexpr int kSegments = 32;
+    constexpr float kTau = 6.28318530718f;
+    const float inner = radius - thickness > 0.0f ? radius - thickness : 0.0f;
+    for (int i = 0; i < kSegments; ++i) {
+        float a0 = (kTau * i) / kSegments;
+        float a1 = (kTau * (i + 1)) / kSegments;
+        float c0 = std::cos(a0), s0 = std::sin(a0), c1 = std::cos(a1), s1 = std::sin(a1);
+        DX11OverlayVertex o0{cx + c0 * radius, cy + s0 * radius, color};
+        DX11OverlayVertex o1{cx + c1 * radius, cy + s1 * radius, color};
+        DX11OverlayVertex i0{cx + c0 * inner,  cy + s0 * inner,  color};
+        DX11OverlayVertex i1{cx + c1 * inner,  cy + s1 * inner,  color};
+        Out().push_back(o0); Out().push_back(o1); Out().push_back(i1);
+        Out().push_back(o0); Out().push_back(i1); Out().push_back(i0);
     }
 }
 
+inline float DX11DrawContext::DrawString(float x, float y, const char* text, Rgba color, float scale) {
+    return LayoutOverlayText(x, y, text, scale, [&](const OverlayGlyphQuad& q) {
+        if (Instanced()) {
+            m_prims.push_back(MakeGlyphPrimitive(q, color));
+            return;
+        }
+        // The quad spans the cell's 5x7 texels; u carries the cell
+        const uint16_t u0 = static_cast<uint16_t>(q.glyph * kOverlayFontCellStride);
+        const uint16_t u1 = static_cast<uint16_t>(u0 + kOverlayFontGlyphWidth);
+        const uint16_t v1 = static_cast<uint16_t>(kOverlayFontGlyphHeight);
+        DX11OverlayVertex v0{q.x,       q.y,       color, u0, 0};
+        DX11OverlayVertex va{q.x + q.w, q.y,       color, u1, 0};
+        DX11OverlayVertex vb{q.x + q.w, q.y + q.h, color, u1, v1};
+        DX11OverlayVertex vc{q.x,       q.y + q.h, color, u0, v1};
+        Out().push_back(v0); Out().push_back(va); Out().push_back(vb);
+        Out().push_back(v0); Out().push_back(vb); Out().push_back(vc);
+    });
+}
+
+inline bool DX11DrawContext::BeginLayer(const char* name, uint64_t content_key, float offset_x, float offset_y) {
+    EndLayer();
+
+    bool kept = false;
+    if (content_key != 0 && m_retainedKeys) {
+        auto it = m_retainedKeys->find(name);
+        kept = it != m_retainedKeys->end() && it->second == content_key;
+    }
+    m_layers.push_back({name, content_key, offset_x, offset_y, kept, m_layerVerts.size(), 0});
+    // A kept layer still collects (and discards) anything drawn into it, so
+    // callers that ignore the return value stay correct
+    m_activeLayer = static_cast<int>(m_layers.size()) - 1;
+    return !kept;
+}
+
+inline void DX11DrawContext::EndLayer() {
+    if (m_activeLayer < 0) return;
+    DX11LayerRecord& layer = m_layers[m_activeLayer];
+    if (layer.kept) {
+        m_layerVerts.resize(layer.first_vertex);
+    } else {
+        layer.vertex_count = m_layerVerts.size() - layer.first_vertex;
+    }
+    m_activeLayer = -1;
+}
+
 inline void DX11DrawContext::DrawCross(float cx, float cy, float arm, Rgba color, float thickness, float gap) {
     if (arm <= gap) return;
     DrawLine(cx - arm, cy, cx - gap, cy, color, thickness);
@@ -174,6 +385,33 @@ inline void DX11DrawContext::DrawCross(float cx, float cy, float arm, Rgba color
 
 namespace detail {
 
+// GPU copy of one retained layer. Each layer has its own constant buffer so
+// moving it rewrites 16 bytes instead of re-uploading vertices.
+struct RetainedLayer {
+    ID3D11Buffer* vb         = nullptr;
+    UINT          capacity   = 0;
+    UINT          count      = 0;
+    uint64_t      hash       = 0;
+    ID3D11Buffer* cb         = nullptr;
+    float         cbOffsetX  = 0;
+    float         cbOffsetY  = 0;
+    UINT          cbWidth    = 0;
+    UINT          cbHeight   = 0;
+};
+
+// One Draw call of the frame: a vertex (or instance) buffer plus the
+// constants to use
+struct OverlayDraw {
+    ID3D11Buffer* vb;
+    ID3D11Buffer* cb;
+    UINT          count;
+    bool          instanced;  // count SDF instances on the primitive shaders
+};
+
+// Timestamp query sets in flight; a set is read back this many frames
+// after it was issued, or skipped if it still hasn't landed
+constexpr UINT kTimingFrames = 4;
+
 struct OverlayState {
     // Hook
     bool hookInstalled = false;
@@ -192,12 +430,45 @@ struct OverlayState {
     ID3D11InputLayout*      inputLayout     = nullptr;
     ID3D11Buffer*           vb              = nullptr;
     UINT                    vbCapacity      = 0;
+    ID3D11Buffer*           cb              = nullptr;   // viewport constants, rewritten on size change only
+    ID3D11VertexShader*     primVS          = nullptr;   // instanced SDF path
+    ID3D11PixelShader*      primPS          = nullptr;
+    ID3D11InputLayout*      primLayout      = nullptr;
+    ID3D11Buffer*           ib              = nullptr;   // OverlayPrimitive instances
+    UINT                    ibCapacity      = 0;
+    UINT                    cbWidth         = 0;
+    UINT                    cbHeight        = 0;
     ID3D11BlendState*       blendState      = nullptr;
     ID3D11RasterizerState*  rasterState     = nullptr;
     ID3D11DepthStencilState* depthState     = nullptr;
     UINT                    backbufferW     = 0;
     UINT                    backbufferH     = 0;
 
+    // DeferredContext mode
+    DX11StateMode           stateMode       = DX11StateMode::SaveRestore;
+    bool                    instancedPrims  = false;     // requested; primVS != nullptr once available
+    ID3D11DeviceContext*    deferred        = nullptr;
+    ID3D11CommandList*      commandList     = nullptr;   // records the draws hashed in listSignature
+    uint64_t                listSignature   = 0;
+
+    // Retained layers, by name; layerKeys mirrors their content keys for
+    // DX11DrawContext::BeginLayer
+    std::unordered_map<std::string, RetainedLayer> layers;
+    std::unordered_map<std::string, uint64_t>      layerKeys;
+    std::vector<OverlayDraw>                       draws;   // this frame's draw list, reused
+
+    // Timing
+    OverlayTimings timings;
+    bool           showTimingLine = false;
+    const PoseLatch* poseLatch = nullptr;
+    PresentTimingSampler presentTiming;
+    PipelineTrace* pipelineTrace = nullptr;
+    ID3D11Query*   gpuDisjoint[kTimingFrames] = {};
+    ID3D11Query*   gpuBegin[kTimingFrames]    = {};
+    ID3D11Query*   gpuEnd[kTimingFrames]      = {};
+    bool           gpuPending[kTimingFrames]  = {};
+    UINT           gpuFrame = 0;
+
     DX11RenderCallback callback;
     DX11LogFn          logFn = nullptr;
     bool               firstPresentLogged = false;
@@ -213,36 +484,65 @@ inline void Log(const char* msg) {
     if (s.logFn) s.logFn(msg);
 }
 
+// Log a D3DCompile / root-signature error blob's text, then release it
+inline void LogErrorBlob(const char* what, ID3DBlob*& err) {
+    if (!err) return;
+    auto& s = State();
+    if (s.logFn) {
+        std::string msg(what);
+        msg += ": ";
+        msg.append(static_cast<const char*>(err->GetBufferPointer()), err->GetBufferSize());
+        // Blobs usually end in a NUL and a newline
+        while (!msg.empty() && (msg.back() == '\0' || msg.back() == '\n' || msg.back() == '\r')) msg.pop_back();
+        s.logFn(msg.c_str());
+    }
+    err->Release();
+    err = nullptr;
+}
+
 // Vertex shader: takes pixel coords, viewport size in cb0, outputs NDC.
-// Pixel shader: passthrough vertex color.
+// Pixel shader: vertex color, masked by the font atlas texel (always lit
+// in the solid cell). Compiled after OverlayFontHLSL().
 inline const char* kOverlayHLSL = R"(
-cbuffer cb : register(b0) { float2 g_invHalfViewport; float2 _pad; };
-struct VSIn  { float2 pos : POSITION; float4 col : COLOR0; };
-struct VSOut { float4 pos : SV_POSITION; float4 col : COLOR0; };
+cbuffer cb : register(b0) { float2 g_invHalfViewport; float2 g_offset; };
+struct VSIn  { float2 pos : POSITION; float4 col : COLOR0; uint2 uv : TEXCOORD0; };
+struct VSOut { float4 pos : SV_POSITION; float4 col : COLOR0; float2 uv : TEXCOORD0; };
 VSOut VSMain(VSIn i) {
     VSOut o;
-    // Pixel (0..W, 0..H) -> NDC (-1..1, 1..-1)
-    o.pos = float4(i.pos.x * g_invHalfViewport.x - 1.0,
-                   1.0 - i.pos.y * g_invHalfViewport.y, 0, 1);
+    // Pixel (0..W, 0..H) -> NDC (-1..1, 1..-1), after the layer offset
+    float2 p = i.pos + g_offset;
+    o.pos = float4(p.x * g_invHalfViewport.x - 1.0,
+                   1.0 - p.y * g_invHalfViewport.y, 0, 1);
     o.col = i.col;
+    o.uv = float2(i.uv);
     return o;
 }
-float4 PSMain(VSOut i) : SV_TARGET { return i.col; }
+float4 PSMain(VSOut i) : SV_TARGET {
+    uint u = (uint)i.uv.x;
+    if (!OverlayFontTexel(u / 8, int2(u % 8, (int)i.uv.y))) discard;
+    return i.col;
+}
 )";
 
-inline bool CompileShaders(ID3D11Device* dev, ID3D11VertexShader** vs, ID3D11PixelShader** ps, ID3D11InputLayout** layout) {
+// Compile a VS/PS pair from HLSL source (after the font table) and build
+// the VS's input layout
+inline bool CompileShaderPair(ID3D11Device* dev, const char* body, const char* vsEntry, const char* psEntry,
+                              const D3D11_INPUT_ELEMENT_DESC* inputDesc, UINT inputCount,
+                              ID3D11VertexShader** vs, ID3D11PixelShader** ps, ID3D11InputLayout** layout) {
+    const std::string source = OverlayFontHLSL() + body;
+    const char* src = source.c_str();
     ID3DBlob* vsBlob = nullptr;
     ID3DBlob* psBlob = nullptr;
     ID3DBlob* err    = nullptr;
 
-    HRESULT hr = D3DCompile(kOverlayHLSL, std::strlen(kOverlayHLSL), nullptr, nullptr, nullptr,
-                            "VSMain", "vs_4_0", 0, 0, &vsBlob, &err);
-    if (err) { err->Release(); err = nullptr; }
+    HRESULT hr = D3DCompile(src, source.size(), nullptr, nullptr, nullptr,
+                            vsEntry, "vs_4_0", 0, 0, &vsBlob, &err);
+    LogErrorBlob("dx11_overlay: vertex shader compile", err);
     if (FAILED(hr)) return false;
 
-    hr = D3DCompile(kOverlayHLSL, std::strlen(kOverlayHLSL), nullptr, nullptr, nullptr,
-                    "PSMain", "ps_4_0", 0, 0, &psBlob, &err);
-    if (err) { err->Release(); err = nullptr; }
+    hr = D3DCompile(src, source.size(), nullptr, nullptr, nullptr,
+                    psEntry, "ps_4_0", 0, 0, &psBlob, &err);
+    LogErrorBlob("dx11_overlay: pixel shader compile", err);
     if (FAILED(hr)) { vsBlob->Release(); return false; }
 
     hr = dev->CreateVertexShader(vsBlob->GetBufferPointer(), vsBlob->GetBufferSize(), nullptr, vs);
@@ -251,17 +551,79 @@ inline bool CompileShaders(ID3D11Device* dev, ID3D11VertexShader** vs, ID3D11Pix
     hr = dev->CreatePixelShader(psBlob->GetBufferPointer(), psBlob->GetBufferSize(), nullptr, ps);
     if (FAILED(hr)) { vsBlob->Release(); psBlob->Release(); return false; }
 
+    hr = dev->CreateInputLayout(inputDesc, inputCount, vsBlob->GetBufferPointer(), vsBlob->GetBufferSize(), layout);
+    vsBlob->Release(); psBlob->Release();
+    return SUCCEEDED(hr);
+}
+
+inline bool CompileShaders(ID3D11Device* dev, ID3D11VertexShader** vs, ID3D11PixelShader** ps, ID3D11InputLayout** layout) {
     D3D11_INPUT_ELEMENT_DESC inputDesc[] = {
         {"POSITION", 0, DXGI_FORMAT_R32G32_FLOAT,    0, 0,  D3D11_INPUT_PER_VERTEX_DATA, 0},
         {"COLOR",    0, DXGI_FORMAT_R8G8B8A8_UNORM,  0, 8,  D3D11_INPUT_PER_VERTEX_DATA, 0},
+        {"TEXCOORD", 0, DXGI_FORMAT_R16G16_UINT,     0, 12, D3D11_INPUT_PER_VERTEX_DATA, 0},
     };
-    hr = dev->CreateInputLayout(inputDesc, 2, vsBlob->GetBufferPointer(), vsBlob->GetBufferSize(), layout);
-    vsBlob->Release(); psBlob->Release();
-    return SUCCEEDED(hr);
+    return CompileShaderPair(dev, kOverlayHLSL, "VSMain", "PSMain", inputDesc, 3, vs, ps, layout);
+}
+
+inline bool CompilePrimitiveShaders(ID3D11Device* dev, ID3D11VertexShader** vs, ID3D11PixelShader** ps,
+                                    ID3D11InputLayout** layout) {
+    // One OverlayPrimitive per instance, no per-vertex data
+    D3D11_INPUT_ELEMENT_DESC inputDesc[] = {
+        {"PRIM_ENDS", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 0,  D3D11_INPUT_PER_INSTANCE_DATA, 1},
+        {"PRIM_SIZE", 0, DXGI_FORMAT_R32_FLOAT,          0, 16, D3D11_INPUT_PER_INSTANCE_DATA, 1},
+        {"COLOR",     0, DXGI_FORMAT_R8G8B8A8_UNORM,     0, 20, D3D11_INPUT_PER_INSTANCE_DATA, 1},
+        {"PRIM_KIND", 0, DXGI_FORMAT_R32_UINT,           0, 24, D3D11_INPUT_PER_INSTANCE_DATA, 1},
+        {"PRIM_SOFT", 0, DXGI_FORMAT_R32_FLOAT,          0, 28, D3D11_INPUT_PER_INSTANCE_DATA, 1},
+    };
+    return CompileShaderPair(dev, kOverlayPrimitiveHLSL, "VSPrim", "PSPrim", inputDesc, 5, vs, ps, layout);
 }
 
 inline void ReleaseDeviceResources();  // forward decl
 
+inline void ReleaseTimingQueries() {
+    auto& s = State();
+    for (UINT i = 0; i < kTimingFrames; ++i) {
+        if (s.gpuDisjoint[i]) { s.gpuDisjoint[i]->Release(); s.gpuDisjoint[i] = nullptr; }
+        if (s.gpuBegin[i])    { s.gpuBegin[i]->Release();    s.gpuBegin[i] = nullptr; }
+        if (s.gpuEnd[i])      { s.gpuEnd[i]->Release();      s.gpuEnd[i] = nullptr; }
+        s.gpuPending[i] = false;
+    }
+}
+
+inline bool CreateTimingQueries() {
+    auto& s = State();
+    D3D11_QUERY_DESC disjoint = {D3D11_QUERY_TIMESTAMP_DISJOINT, 0};
+    D3D11_QUERY_DESC stamp    = {D3D11_QUERY_TIMESTAMP, 0};
+    for (UINT i = 0; i < kTimingFrames; ++i) {
+        if (FAILED(s.device->CreateQuery(&disjoint, &s.gpuDisjoint[i])) ||
+            FAILED(s.device->CreateQuery(&stamp, &s.gpuBegin[i])) ||
+            FAILED(s.device->CreateQuery(&stamp, &s.gpuEnd[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Vertex, instance and constant buffers the overlay rewrites. DYNAMIC and
+// discard-mapped on the immediate context normally; DEFAULT with
+// UpdateSubresource in DeferredContext mode, because a recorded command list
+// only sees a DYNAMIC buffer's new contents if it was discard-mapped on the
+// deferred context itself.
+inline bool CreateOverlayBuffer(UINT bytes, UINT bindFlags, ID3D11Buffer** out,
+                                const D3D11_SUBRESOURCE_DATA* init = nullptr) {
+    auto& s = State();
+    D3D11_BUFFER_DESC bd = {};
+    bd.ByteWidth = bytes;
+    bd.BindFlags = bindFlags;
+    if (s.deferred) {
+        bd.Usage = D3D11_USAGE_DEFAULT;
+    } else {
+        bd.Usage          = D3D11_USAGE_DYNAMIC;
+        bd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+    }
+    return SUCCEEDED(s.device->CreateBuffer(&bd, init, out));
+}
+
 inline bool InitDeviceResources(IDXGISwapChain* swap) {
     auto& s = State();
     // Always start clean — a previous partial init may have left COM objects behind.
@@ -298,14 +660,18 @@ inline bool InitDeviceResources(IDXGISwapChain* swap) {
         ReleaseDeviceResources(); return false;
     }
 
-    // Dynamic vertex buffer
+    // Before any buffer: the mode decides their usage
+    if (s.stateMode == DX11StateMode::DeferredContext) {
+        if (FAILED(s.device->CreateDeferredContext(0, &s.deferred))) {
+            // Not fatal: the immediate context with save/restore still works
+            Log("dx11_overlay: CreateDeferredContext failed, using save/restore");
+            s.deferred = nullptr;
+        }
+    }
+
+    // Per-frame vertex buffer
     s.vbCapacity = 8192;
-    D3D11_BUFFER_DESC bd = {};
-    bd.Usage          = D3D11_USAGE_DYNAMIC;
-    bd.ByteWidth      = sizeof(DX11OverlayVertex) * s.vbCapacity;
-    bd.BindFlags      = D3D11_BIND_VERTEX_BUFFER;
-    bd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
-    if (FAILED(s.device->CreateBuffer(&bd, nullptr, &s.vb))) {
+    if (!CreateOverlayBuffer(sizeof(DX11OverlayVertex) * s.vbCapacity, D3D11_BIND_VERTEX_BUFFER, &s.vb)) {
         Log("dx11_overlay: vertex-buffer create failed");
         ReleaseDeviceResources(); return false;
     }
@@ -342,6 +708,34 @@ inline bool InitDeviceResources(IDXGISwapChain* swap) {
         ReleaseDeviceResources(); return false;
     }
 
+    // Viewport constants live in one buffer for the device's lifetime;
+    // RenderFrame only rewrites it when the back buffer size moves
+    struct CB { float invHalfW; float invHalfH; float offsetX; float offsetY; };
+    CB cbData = { 2.0f / s.backbufferW, 2.0f / s.backbufferH, 0, 0 };
+    D3D11_SUBRESOURCE_DATA cbInit = { &cbData, 0, 0 };
+    if (!CreateOverlayBuffer(sizeof(CB), D3D11_BIND_CONSTANT_BUFFER, &s.cb, &cbInit)) {
+        Log("dx11_overlay: constant buffer create failed");
+        ReleaseDeviceResources(); return false;
+    }
+    s.cbWidth  = s.backbufferW;
+    s.cbHeight = s.backbufferH;
+
+    if (s.instancedPrims) {
+        if (!CompilePrimitiveShaders(s.device, &s.primVS, &s.primPS, &s.primLayout)) {
+            // Not fatal: shapes fall back to triangles
+            Log("dx11_overlay: primitive shader compilation failed, using triangles");
+            if (s.primLayout) { s.primLayout->Release(); s.primLayout = nullptr; }
+            if (s.primPS)     { s.primPS->Release();     s.primPS = nullptr; }
+            if (s.primVS)     { s.primVS->Release();     s.primVS = nullptr; }
+        }
+    }
+
+    if (!CreateTimingQueries()) {
+        // Not fatal: CPU timings are still recorded
+        Log("dx11_overlay: timestamp queries unavailable, no GPU timing");
+        ReleaseTimingQueries();
+    }
+
     s.initialized = true;
     Log("dx11_overlay: device resources initialized");
     return true;
@@ -349,6 +743,21 @@ inline bool InitDeviceResources(IDXGISwapChain* swap) {
 
 inline void ReleaseDeviceResources() {
     auto& s = State();
+    ReleaseTimingQueries();
+    if (s.commandList)  { s.commandList->Release();  s.commandList = nullptr; }
+    if (s.deferred)     { s.deferred->Release();     s.deferred = nullptr; }
+    for (auto& entry : s.layers) {
+        if (entry.second.vb) entry.second.vb->Release();
+        if (entry.second.cb) entry.second.cb->Release();
+    }
+    s.layers.clear();
+    s.layerKeys.clear();  // the callback must rebuild every layer on the new device
+    if (s.cb)           { s.cb->Release();           s.cb = nullptr; }
+    if (s.ib)           { s.ib->Release();           s.ib = nullptr; }
+    s.ibCapacity = 0;
+    if (s.primLayout)   { s.primLayout->Release();   s.primLayout = nullptr; }
+    if (s.primPS)       { s.primPS->Release();       s.primPS = nullptr; }
+    if (s.primVS)       { s.primVS->Release();       s.primVS = nullptr; }
     if (s.depthState)   { s.depthState->Release();   s.depthState = nullptr; }
     if (s.rasterState)  { s.rasterState->Release();  s.rasterState = nullptr; }
     if (s.blendState)   { s.blendState->Release();   s.blendState = nullptr; }
@@ -362,9 +771,10 @@ inline void ReleaseDeviceResources() {
     s.initialized = false;
 }
 
-// Save/restore enough of the immediate context that the game's pipeline isn't
-// disturbed. We touch: IA (layout, VB, topology), VS, PS, RS, OM (RTV, blend,
-// depth), VP. Everything else (HS/DS/GS/CS, SRVs, samplers) is left untouched.
+// Save/restore exactly what DrawOverlay binds, so the game's pipeline isn't
+// disturbed: IA (layout, VB slot 0, topology), VS + its cb0, PS, RS, OM (RTV,
+// blend, depth) and viewport 0. Everything else (HS/DS/GS/CS, SRVs, samplers,
+// scissors, other slots) is never touched and so never read back.
 struct ContextStateScope {
     ID3D11DeviceContext* ctx;
 
@@ -427,77 +837,320 @@ struct ContextStateScope {
     }
 };
 
+// Drop the recorded command list; it holds references to the VBs, CBs and
+// RTV, so it must go whenever one of them is recreated
+inline void InvalidateCommandList() {
+    auto& s = State();
+    if (s.commandList) { s.commandList->Release(); s.commandList = nullptr; }
+    s.listSignature = 0;
+}
+
+// Rewrite the first `bytes` of a buffer made by CreateOverlayBuffer, through
+// whichever path matches its usage
+inline bool UploadBuffer(ID3D11Buffer* buffer, const void* data, size_t bytes) {
+    auto& s = State();
+    D3D11_BUFFER_DESC desc = {};
+    buffer->GetDesc(&desc);
+    if (desc.Usage == D3D11_USAGE_DEFAULT) {
+        // Constant buffers can only be updated whole
+        D3D11_BOX box = {0, 0, 0, static_cast<UINT>(bytes), 1, 1};
+        const bool whole = (desc.BindFlags & D3D11_BIND_CONSTANT_BUFFER) != 0;
+        s.context->UpdateSubresource(buffer, 0, whole ? nullptr : &box, data, 0, 0);
+        return true;
+    }
+    D3D11_MAPPED_SUBRESOURCE mapped = {};
+    if (FAILED(s.context->Map(buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped))) return false;
+    std::memcpy(mapped.pData, data, bytes);
+    s.context->Unmap(buffer, 0);
+    return true;
+}
+
+inline bool WriteViewportConstants(ID3D11Buffer* cb, float offsetX, float offsetY) {
+    auto& s = State();
+    const float data[4] = { 2.0f / s.backbufferW, 2.0f / s.backbufferH, offsetX, offsetY };
+    return UploadBuffer(cb, data, sizeof(data));
+}
+
+// FNV-1a over the vertex bytes; decides whether a rebuilt layer differs
+// from what's already on the GPU
+inline uint64_t HashVertices(const DX11OverlayVertex* verts, size_t count) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(verts);
+    uint64_t h = 0xCBF29CE484222325ull;
+    for (size_t i = 0; i < count * sizeof(DX11OverlayVertex); ++i) {
+        h ^= bytes[i];
+        h *= 0x100000001B3ull;
+    }
+    return h;
+}
+
+// Bring one declared layer's GPU copy up to date and queue its draw
+inline void SyncLayer(const DX11DrawContext& dc, const DX11LayerRecord& rec) {
+    auto& s = State();
+    RetainedLayer& layer = s.layers[rec.name];
+
+    if (!rec.kept) {
+        const DX11OverlayVertex* verts = dc.LayerVerts().data() + rec.first_vertex;
+        const UINT count = static_cast<UINT>(rec.vertex_count);
+        const uint64_t hash = HashVertices(verts, count);
+        if (hash != layer.hash || count != layer.count) {
+            if (count > layer.capacity) {
+                InvalidateCommandList();
+                if (layer.vb) { layer.vb->Release(); layer.vb = nullptr; }
+                layer.capacity = 0;
+                // Round up to 256 verts; layers are small HUD pieces
+                const UINT cap = ((count + 255u) / 256u) * 256u;
+                if (!CreateOverlayBuffer(sizeof(DX11OverlayVertex) * cap, D3D11_BIND_VERTEX_BUFFER, &layer.vb)) {
+                    layer.vb = nullptr;
+                    layer.count = 0;
+                    s.layerKeys.erase(rec.name);
+                    return;
+                }
+                layer.capacity = cap;
+            }
+            if (count > 0 && !UploadBuffer(layer.vb, verts, sizeof(DX11OverlayVertex) * count)) {
+                // Force a rebuild next frame
+                layer.hash = 0;
+                layer.count = 0;
+                s.layerKeys.erase(rec.name);
+                return;
+            }
+            layer.hash = hash;
+            layer.count = count;
+        }
+        if (rec.content_key != 0) {
+            s.layerKeys[rec.name] = rec.content_key;
+        } else {
+            s.layerKeys.erase(rec.name);
+        }
+    }
+
+    if (layer.count == 0) return;
+
+    if (!layer.cb) {
+        if (!CreateOverlayBuffer(16, D3D11_BIND_CONSTANT_BUFFER, &layer.cb)) {
+            layer.cb = nullptr;
+            return;
+        }
+        InvalidateCommandList();
+        layer.cbWidth = 0;  // force the first write
+    }
+    if (layer.cbOffsetX != rec.offset_x || layer.cbOffsetY != rec.offset_y ||
+        layer.cbWidth != s.backbufferW || layer.cbHeight != s.backbufferH) {
+        if (!WriteViewportConstants(layer.cb, rec.offset_x, rec.offset_y)) return;
+        layer.cbOffsetX = rec.offset_x;
+        layer.cbOffsetY = rec.offset_y;
+        layer.cbWidth   = s.backbufferW;
+        layer.cbHeight  = s.backbufferH;
+    }
+
+    s.draws.push_back({layer.vb, layer.cb, layer.count, false});
+}
+
+// Identity of a draw list for the deferred path: which buffers are drawn,
+// in what order, with how many verts. Buffer contents don't matter.
+inline uint64_t DrawListSignature(const std::vector<OverlayDraw>& draws) {
+    uint64_t h = 0xCBF29CE484222325ull;
+    auto mix = [&h](uint64_t v) { h = (h ^ v) * 0x100000001B3ull; };
+    for (const auto& d : draws) {
+        mix(reinterpret_cast<uintptr_t>(d.vb));
+        mix(reinterpret_cast<uintptr_t>(d.cb));
+        mix(d.count);
+        mix(d.instanced ? 1 : 0);
+    }
+    return h | 1;  // never 0, which means "no list"
+}
+
+// Bind the overlay pipeline on ctx and issue the frame's draws
+inline void DrawOverlay(ID3D11DeviceContext* ctx, const std::vector<OverlayDraw>& draws) {
+    auto& s = State();
+
+    D3D11_VIEWPORT vp = {};
+    vp.TopLeftX = 0; vp.TopLeftY = 0;
+    vp.Width    = static_cast<float>(s.backbufferW);
+    vp.Height   = static_cast<float>(s.backbufferH);
+    vp.MinDepth = 0; vp.MaxDepth = 1;
+    ctx->RSSetViewports(1, &vp);
+
+    ctx->OMSetRenderTargets(1, &s.rtv, nullptr);
+
+    ctx->RSSetState(s.rasterState);
+    FLOAT bf[4] = {0,0,0,0};
+    ctx->OMSetBlendState(s.blendState, bf, 0xFFFFFFFFu);
+    ctx->OMSetDepthStencilState(s.depthState, 0);
+
+    // Shaders, layout and topology only change between the triangle and
+    // instanced halves of the list
+    int bound = -1;
+    UINT offset = 0;
+    for (const auto& d : draws) {
+        const int kind = d.instanced ? 1 : 0;
+        if (kind != bound) {
+            ctx->IASetInputLayout(d.instanced ? s.primLayout : s.inputLayout);
+            ctx->IASetPrimitiveTopology(d.instanced ? D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP
+                                                    : D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+            ctx->VSSetShader(d.instanced ? s.primVS : s.vs, nullptr, 0);
+            ctx->PSSetShader(d.instanced ? s.primPS : s.ps, nullptr, 0);
+            bound = kind;
+        }
+        UINT stride = d.instanced ? sizeof(OverlayPrimitive) : sizeof(DX11OverlayVertex);
+        ctx->IASetVertexBuffers(0, 1, &d.vb, &stride, &offset);
+        ctx->VSSetConstantBuffers(0, 1, &d.cb);
+        if (d.instanced) {
+            ctx->DrawInstanced(4, d.count, 0, 0);
+        } else {
+            ctx->Draw(d.count, 0);
+        }
+    }
+}
+
+inline float MicrosecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Record whichever earlier frames' timestamps have landed. Never flushes
+// or waits; a set that isn't ready stays pending for a later frame.
+inline void CollectGpuTimings() {
+    auto& s = State();
+    for (UINT i = 0; i < kTimingFrames; ++i) {
+        if (!s.gpuPending[i]) continue;
+        D3D11_QUERY_DATA_TIMESTAMP_DISJOINT dj = {};
+        if (s.context->GetData(s.gpuDisjoint[i], &dj, sizeof(dj), D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK) continue;
+        UINT64 t0 = 0, t1 = 0;
+        if (s.context->GetData(s.gpuBegin[i], &t0, sizeof(t0), D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK ||
+            s.context->GetData(s.gpuEnd[i], &t1, sizeof(t1), D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK) {
+            continue;
+        }
+        if (!dj.Disjoint && dj.Frequency != 0 && t1 >= t0) {
+            s.timings.gpu.Record(static_cast<float>((t1 - t0) * 1e6 / static_cast<double>(dj.Frequency)));
+        }
+        s.gpuPending[i] = false;
+    }
+}
+
+// Query set for this frame's draw, or -1 when timing is off or the slot's
+// previous set still hasn't come back
+inline int BeginGpuTiming() {
+    auto& s = State();
+    if (!s.gpuDisjoint[0]) return -1;
+    CollectGpuTimings();
+    const UINT slot = s.gpuFrame % kTimingFrames;
+    if (s.gpuPending[slot]) return -1;
+    s.context->Begin(s.gpuDisjoint[slot]);
+    s.context->End(s.gpuBegin[slot]);
+    return static_cast<int>(slot);
+}
+
+inline void EndGpuTiming(int slot) {
+    auto& s = State();
+    if (slot < 0) return;
+    s.context->End(s.gpuEnd[slot]);
+    s.context->End(s.gpuDisjoint[slot]);
+    s.gpuPending[slot] = true;
+    ++s.gpuFrame;
+}
+
 inline void RenderFrame() {
     auto& s = State();
     if (!s.initialized || !s.callback) return;
     if (s.backbufferW == 0 || s.backbufferH == 0) return;
 
-    DX11DrawContext dc(static_cast<float>(s.backbufferW), static_cast<float>(s.backbufferH));
+    DX11DrawContext dc(static_cast<float>(s.backbufferW), static_cast<float>(s.backbufferH), &s.layerKeys,
+                       s.primVS != nullptr);
+    // Latch as late as possible: right before the draws are built
+    if (s.poseLatch) dc.SetPoseDelta(s.poseLatch->Latch());
+    const auto callbackStart = std::chrono::steady_clock::now();
     s.callback(dc);
-    const auto& verts = dc.TriVerts();
-    if (verts.empty()) return;
-
-    UINT needed = static_cast<UINT>(verts.size());
-    if (needed > s.vbCapacity) {
-        // Grow VB. Round up to next 8K block.
-        if (s.vb) { s.vb->Release(); s.vb = nullptr; }
-        UINT newCap = ((needed + 8191u) / 8192u) * 8192u;
-        D3D11_BUFFER_DESC bd = {};
-        bd.Usage          = D3D11_USAGE_DYNAMIC;
-        bd.ByteWidth      = sizeof(DX11OverlayVertex) * newCap;
-        bd.BindFlags      = D3D11_BIND_VERTEX_BUFFER;
-        bd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
-        if (FAILED(s.device->CreateBuffer(&bd, nullptr, &s.vb))) return;
-        s.vbCapacity = newCap;
-    }
-
-    // Upload verts
-    D3D11_MAPPED_SUBRESOURCE mapped = {};
-    if (FAILED(s.context->Map(s.vb, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped))) return;
-    std::memcpy(mapped.pData, verts.data(), sizeof(DX11OverlayVertex) * needed);
-    s.context->Unmap(s.vb, 0);
+    dc.EndLayer();  // close a layer the callback left open
+    s.timings.callback_cpu.Record(MicrosecondsSince(callbackStart));
+    if (s.showTimingLine) DrawOverlayTimingLine(dc, s.timings.Summarize());
 
-    // Build viewport-cb data on the stack each frame so resize is automatic.
-    struct CB { float invHalfW; float invHalfH; float pad0; float pad1; };
-    CB cbData = { 2.0f / s.backbufferW, 2.0f / s.backbufferH, 0, 0 };
-
-    // One transient CB per frame avoids carrying around state for resizes.
-    ID3D11Buffer* cb = nullptr;
-    D3D11_BUFFER_DESC cbDesc = {};
-    cbDesc.Usage          = D3D11_USAGE_IMMUTABLE;
-    cbDesc.ByteWidth      = sizeof(CB);
-    cbDesc.BindFlags      = D3D11_BIND_CONSTANT_BUFFER;
-    D3D11_SUBRESOURCE_DATA cbInit = { &cbData, 0, 0 };
-    if (FAILED(s.device->CreateBuffer(&cbDesc, &cbInit, &cb))) return;
+    const auto uploadStart = std::chrono::steady_clock::now();
 
-    {
-        ContextStateScope save(s.context);
+    // Viewport constants only change with the back buffer size
+    if (s.cbWidth != s.backbufferW || s.cbHeight != s.backbufferH) {
+        if (!WriteViewportConstants(s.cb, 0, 0)) return;
+        s.cbWidth  = s.backbufferW;
+        s.cbHeight = s.backbufferH;
+    }
 
-        D3D11_VIEWPORT vp = {};
-        vp.TopLeftX = 0; vp.TopLeftY = 0;
-        vp.Width    = static_cast<float>(s.backbufferW);
-        vp.Height   = static_cast<float>(s.backbufferH);
-        vp.MinDepth = 0; vp.MaxDepth = 1;
-        s.context->RSSetViewports(1, &vp);
+    // Retained layers first, in declaration order; a static, unmoved layer
+    // costs no upload at all. Layers not declared this frame aren't drawn.
+    s.draws.clear();
+    for (const auto& rec : dc.Layers()) SyncLayer(dc, rec);
 
-        s.context->OMSetRenderTargets(1, &s.rtv, nullptr);
+    // Immediate geometry goes on top and is uploaded every frame
+    const auto& verts = dc.TriVerts();
+    if (!verts.empty()) {
+        UINT needed = static_cast<UINT>(verts.size());
+        if (needed > s.vbCapacity) {
+            // Grow VB. Round up to next 8K block.
+            InvalidateCommandList();
+            if (s.vb) { s.vb->Release(); s.vb = nullptr; }
+            s.vbCapacity = 0;
+            UINT newCap = ((needed + 8191u) / 8192u) * 8192u;
+            if (!CreateOverlayBuffer(sizeof(DX11OverlayVertex) * newCap, D3D11_BIND_VERTEX_BUFFER, &s.vb)) {
+                s.vb = nullptr;
+                return;
+            }
+            s.vbCapacity = newCap;
+        }
+        if (UploadBuffer(s.vb, verts.data(), sizeof(DX11OverlayVertex) * needed)) {
+            s.draws.push_back({s.vb, s.cb, needed, false});
+        }
+    }
 
-        UINT stride = sizeof(DX11OverlayVertex), offset = 0;
-        s.context->IASetInputLayout(s.inputLayout);
-        s.context->IASetVertexBuffers(0, 1, &s.vb, &stride, &offset);
-        s.context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-        s.context->VSSetShader(s.vs, nullptr, 0);
-        s.context->VSSetConstantBuffers(0, 1, &cb);
-        s.context->PSSetShader(s.ps, nullptr, 0);
-        s.context->RSSetState(s.rasterState);
-        FLOAT bf[4] = {0,0,0,0};
-        s.context->OMSetBlendState(s.blendState, bf, 0xFFFFFFFFu);
-        s.context->OMSetDepthStencilState(s.depthState, 0);
+    // SDF primitives last: 32 bytes per shape regardless of its size
+    const auto& prims = dc.Primitives();
+    if (!prims.empty()) {
+        UINT needed = static_cast<UINT>(prims.size());
+        if (needed > s.ibCapacity) {
+            // Round up to next 1K instances
+            InvalidateCommandList();
+            if (s.ib) { s.ib->Release(); s.ib = nullptr; }
+            s.ibCapacity = 0;
+            UINT newCap = ((needed + 1023u) / 1024u) * 1024u;
+            if (!CreateOverlayBuffer(sizeof(OverlayPrimitive) * newCap, D3D11_BIND_VERTEX_BUFFER, &s.ib)) {
+                s.ib = nullptr;
+                return;
+            }
+            s.ibCapacity = newCap;
+        }
+        if (UploadBuffer(s.ib, prims.data(), sizeof(OverlayPrimitive) * needed)) {
+            s.draws.push_back({s.ib, s.cb, needed, true});
+        }
+    }
 
-        s.context->Draw(needed, 0);
+    if (s.draws.empty()) return;
+    s.timings.upload_cpu.Record(MicrosecondsSince(uploadStart));
+
+    const int timingSlot = BeginGpuTiming();
+    if (s.deferred) {
+        // In this mode the buffers are DEFAULT usage, updated above with
+        // UpdateSubresource on the immediate context, so replaying the list
+        // draws this frame's contents. Only the set of buffers and the
+        // vertex counts are baked in.
+        const uint64_t signature = DrawListSignature(s.draws);
+        if (!s.commandList || s.listSignature != signature) {
+            InvalidateCommandList();
+            DrawOverlay(s.deferred, s.draws);
+            if (FAILED(s.deferred->FinishCommandList(FALSE, &s.commandList))) {
+                s.commandList = nullptr;
+                EndGpuTiming(timingSlot);
+                return;
+            }
+            s.listSignature = signature;
+        }
+        // TRUE: the runtime restores the game's immediate-context state
+        s.context->ExecuteCommandList(s.commandList, TRUE);
+        EndGpuTiming(timingSlot);
+        return;
     }
 
-    cb->Release();
+    {
+        ContextStateScope save(s.context);
+        DrawOverlay(s.context, s.draws);
+    }
+    EndGpuTiming(timingSlot);
 }
 
 inline HRESULT __stdcall HookedPresent(IDXGISwapChain* swap, UINT sync, UINT flags) {
@@ -512,7 +1165,10 @@ inline HRESULT __stdcall HookedPresent(IDXGISwapChain* swap, UINT sync, UINT fla
     if (s.initialized) {
         RenderFrame();
     }
-    return s.origPresent(swap, sync, flags);
+    const int64_t presentUs = DxgiPresentTimestamp();
+    const HRESULT hr = s.origPresent(swap, sync, flags);
+    if (SUCCEEDED(hr)) SampleDxgiPresent(swap, presentUs, s.presentTiming, s.pipelineTrace);
+    return hr;
 }
 
 inline HRESULT __stdcall HookedResizeBuffers(IDXGISwapChain* swap, UINT bufferCount, UINT width, UINT height,
@@ -520,9 +1176,14 @@ inline HRESULT __stdcall HookedResizeBuffers(IDXGISwapChain* swap, UINT bufferCo
     auto& s = State();
     if (s.initialized) {
         // Drop view + remaining device-bound buffers; they'll be recreated on next Present.
+        // The command list holds a back-buffer reference too, which would
+        // make ResizeBuffers fail.
+        InvalidateCommandList();
         if (s.rtv) { s.rtv->Release(); s.rtv = nullptr; }
         s.initialized = false;
     }
+    // A mode change can change the refresh rate
+    s.presentTiming.Reset();
     return s.origResize(swap, bufferCount, width, height, format, swapChainFlags);
 }
 
@@ -644,6 +1305,34 @@ inline void DX11Overlay::SetRenderCallback(DX11RenderCallback cb) {
     detail::State().callback = std::move(cb);
 }
 
+inline void DX11Overlay::SetStateMode(DX11StateMode mode) {
+    detail::State().stateMode = mode;
+}
+
+inline void DX11Overlay::SetInstancedPrimitives(bool enabled) {
+    detail::State().instancedPrims = enabled;
+}
+
+inline OverlayTimingReport DX11Overlay::GetTimings() const {
+    return detail::State().timings.Summarize();
+}
+
+inline void DX11Overlay::SetTimingLineVisible(bool visible) {
+    detail::State().showTimingLine = visible;
+}
+
+inline void DX11Overlay::SetPoseLatch(const PoseLatch* latch) {
+    detail::State().poseLatch = latch;
+}
+
+inline const PresentTimingSampler& DX11Overlay::GetPresentTiming() const {
+    return detail::State().presentTiming;
+}
+
+inline void DX11Overlay::SetPipelineTrace(PipelineTrace* trace) {
+    detail::State().pipelineTrace = trace;
+}
+
 #endif // CAMERAUNLOCK_DX11_OVERLAY_IMPLEMENTATION
 // Non-implementation TUs see only the declarations above; method definitions
 // live in the impl TU and resolve at link time.
@@ -0,0 +1,940 @@
+#pragma once
+
+// Native DX12 Overlay
+// Minimal-dep DX12 counterpart of dx11_overlay.h: the same pixel-space
+// primitive API, drawn as instanced SDF shapes (overlay_primitives.h).
+//
+// Design goals:
+//   - No ImGui, no kiero. Hooks go through MinHook like the DX11 overlay.
+//   - Header-only with a single TU defining CAMERAUNLOCK_DX12_NATIVE_OVERLAY_IMPLEMENTATION.
+//   - One root signature (four root constants at b0) and one PSO.
+//   - Nothing allocated per frame once warm: the draw context's vector keeps
+//     its capacity, and instances go into a persistently mapped upload ring
+//     with one segment per back buffer. A segment is reused only after the
+//     fence value signalled for it has completed.
+//   - Timing as in the DX11 overlay: callback and upload CPU time, plus GPU
+//     time from a timestamp pair per back buffer, read once that buffer's
+//     fence has passed (so never waited on beyond the ring's own reuse).
+//   - Text via DrawString: glyph instances in the same draw, reading the
+//     font table compiled into the pixel shader (overlay_font.h).
+//   - Late latch via SetPoseLatch, and Present timing for display-time
+//     prediction via GetPresentTiming, as in the DX11 overlay.
+//
+// Required external dependencies (TU with CAMERAUNLOCK_DX12_NATIVE_OVERLAY_IMPLEMENTATION):
+//   - <d3d12.h>, <dxgi1_4.h>, <d3dcompiler.h>
+//   - <MinHook.h>
+//
+// The command queue is captured from the game's first direct-queue
+// ExecuteCommandLists call, so install before the game renders its first
+// frame (or accept that the overlay starts once a direct queue submits).
+//
+// Example:
+//   DX12NativeOverlay overlay;
+//   overlay.SetRenderCallback([](DX12DrawContext& dc) {
+//       dc.DrawCross(dc.Width()/2, dc.Height()/2, 12.0f, 0xFFFFFFFF, 1.5f, 4.0f);
+//   });
+//   overlay.Install();
+//   ...
+//   overlay.Remove();
+
+#include <cameraunlock/rendering/overlay_primitives.h>
+#include <cameraunlock/rendering/overlay_timing.h>
+#include <cameraunlock/processing/pose_latch.h>
+#include <cameraunlock/processing/present_timing.h>
+#include <cameraunlock/diagnostics/pipeline_trace.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace cameraunlock::rendering {
+
+// Drawing context passed to the render callback. Every shape becomes one
+// OverlayPrimitive; the overlay owns a single context and resets it each
+// frame, so its storage is reused rather than reallocated.
+class DX12DrawContext {
+public:
+    DX12DrawContext() = default;
+
+    // Start a new frame at the given back buffer size; keeps capacity
+    void Reset(float w, float h) {
+        m_width = w;
+        m_height = h;
+        m_prims.clear();
+        m_poseDelta = {};
+    }
+
+    float Width()  const { return m_width;  }
+    float Height() const { return m_height; }
+
+    void DrawLine(float x1, float y1, float x2, float y2, Rgba color, float thickness = 1.0f) {
+        const float dx = x2 - x1, dy = y2 - y1;
+        if (std::sqrt(dx * dx + dy * dy) < 1e-3f) return;
+        m_prims.push_back(MakeLinePrimitive(x1, y1, x2, y2, color, thickness));
+    }
+    void DrawRect(float x, float y, float w, float h, Rgba color) {
+        m_prims.push_back(MakeRectPrimitive(x, y, w, h, color));
+    }
+    void DrawDot(float cx, float cy, float radius, Rgba color) {
+        m_prims.push_back(MakeCirclePrimitive(cx, cy, radius, color));
+    }
+    void DrawRing(float cx, float cy, float radius, float thickness, Rgba color) {
+        m_prims.push_back(MakeRingPrimitive(cx, cy, radius, thickness, color));
+    }
+
+    // Crosshair: 4 line segments centred at (cx, cy), each `arm` long with a
+    // central `gap` left empty.
+    void DrawCross(float cx, float cy, float arm, Rgba color, float thickness = 1.0f, float gap = 0.0f) {
+        if (arm <= gap) return;
+        DrawLine(cx - arm, cy, cx - gap, cy, color, thickness);
+        DrawLine(cx + gap, cy, cx + arm, cy, color, thickness);
+        DrawLine(cx, cy - arm, cx, cy - gap, color, thickness);
+        DrawLine(cx, cy + gap, cx, cy + arm, color, thickness);
+    }
+
+    // Text in the embedded 5x7 font (overlay_font.h), one glyph instance per
+    // visible character, each font texel `scale` pixels square. '\n' starts
+    // a new line. Returns the widest line's width.
+    float DrawString(float x, float y, const char* text, Rgba color, float scale = 1.0f) {
+        return LayoutOverlayText(x, y, text, scale, [&](const OverlayGlyphQuad& q) {
+            m_prims.push_back(MakeGlyphPrimitive(q, color));
+        });
+    }
+
+    const std::vector<OverlayPrimitive>& Primitives() const { return m_prims; }
+
+    // Head rotation since the game read the pose this frame was rendered
+    // with, latched at Present; invalid without a PoseLatch
+    const LatchedPoseDelta& PoseDelta() const { return m_poseDelta; }
+    void SetPoseDelta(const LatchedPoseDelta& delta) { m_poseDelta = delta; }
+
+private:
+    float m_width = 0.0f;
+    float m_height = 0.0f;
+    std::vector<OverlayPrimitive> m_prims;
+    LatchedPoseDelta m_poseDelta;
+};
+
+using DX12RenderCallback = std::function<void(DX12DrawContext&)>;
+
+// Instances one back-buffer segment of the upload ring holds for a frame
+// of `instances` primitives: rounded up to the next 1K so the ring is
+// rebuilt only on real growth
+inline size_t DX12RingSegmentInstances(size_t instances) {
+    return ((instances + 1023u) / 1024u) * 1024u;
+}
+
+// Optional diagnostic log sink.
+using DX12LogFn = void (*)(const char* msg);
+void SetDX12NativeOverlayLogger(DX12LogFn fn);
+
+class DX12NativeOverlay {
+public:
+    DX12NativeOverlay() = default;
+    ~DX12NativeOverlay();
+    DX12NativeOverlay(const DX12NativeOverlay&)            = delete;
+    DX12NativeOverlay& operator=(const DX12NativeOverlay&) = delete;
+
+    // Install the ExecuteCommandLists/Present/ResizeBuffers hooks. Caller
+    // must have already initialized MinHook (MH_Initialize). Returns false
+    // on failure.
+    bool Install();
+
+    // Tear down hooks, wait for the GPU and release D3D12 resources.
+    void Remove();
+
+    void SetRenderCallback(DX12RenderCallback cb);
+
+    // Rolling min/avg/p99 of the overlay's own cost (see DX11Overlay)
+    OverlayTimingReport GetTimings() const;
+    void SetTimingLineVisible(bool visible);
+
+    // Latch this pose source at Present (see DX11Overlay::SetPoseLatch)
+    void SetPoseLatch(const PoseLatch* latch);
+
+    // Present interval and scanout latency (see DX11Overlay::GetPresentTiming)
+    const PresentTimingSampler& GetPresentTiming() const;
+
+    // Stamp each Present in this pipeline trace (see DX11Overlay::SetPipelineTrace)
+    void SetPipelineTrace(PipelineTrace* trace);
+
+    bool IsInstalled() const { return m_hookInstalled; }
+
+private:
+    DX12RenderCallback m_callback;
+    bool m_hookInstalled = false;
+};
+
+#ifdef CAMERAUNLOCK_DX12_NATIVE_OVERLAY_IMPLEMENTATION
+
+// ============================================================================
+// Implementation
+// ============================================================================
+
+} // namespace cameraunlock::rendering
+
+#include <d3d12.h>
+#include <dxgi1_4.h>
+#include <d3dcompiler.h>
+#include <MinHook.h>
+#include <Windows.h>
+#include <cameraunlock/rendering/dxgi_present_timing.h>
+#include <cstring>
+#include <chrono>
+
+#pragma comment(lib, "d3d12.lib")
+#pragma comment(lib, "dxgi.lib")
+#pragma comment(lib, "d3dcompiler.lib")
+
+namespace cameraunlock::rendering {
+
+namespace dx12_native_detail {
+
+// DXGI_MAX_SWAP_CHAIN_BUFFERS; fixed so frame resources never reallocate
+constexpr UINT kMaxBackBuffers = 16;
+
+// What one back buffer index owns. The allocator and ring segment are free
+// to reuse once the queue's fence passes fenceValue.
+struct FrameResources {
+    ID3D12Resource*         backBuffer = nullptr;
+    ID3D12CommandAllocator* allocator  = nullptr;
+    UINT64                  fenceValue = 0;
+    bool                    timed      = false;  // its submission wrote a timestamp pair
+};
+
+struct OverlayState {
+    // Hook
+    bool hookInstalled = false;
+    bool initialized   = false;
+    void* executeTarget       = nullptr;
+    void* presentTarget       = nullptr;
+    void* resizeBuffersTarget = nullptr;
+    void (__stdcall* origExecute)(ID3D12CommandQueue*, UINT, ID3D12CommandList* const*) = nullptr;
+    HRESULT (__stdcall* origPresent)(IDXGISwapChain*, UINT, UINT) = nullptr;
+    HRESULT (__stdcall* origResize)(IDXGISwapChain*, UINT, UINT, UINT, DXGI_FORMAT, UINT) = nullptr;
+
+    // Captured from the game
+    ID3D12CommandQueue* queue = nullptr;   // first direct queue seen; AddRef'd
+
+    // D3D12
+    ID3D12Device*              device        = nullptr;
+    IDXGISwapChain3*           swap3         = nullptr;
+    ID3D12DescriptorHeap*      rtvHeap       = nullptr;
+    UINT                       rtvStride     = 0;
+    ID3D12RootSignature*       rootSignature = nullptr;
+    ID3D12PipelineState*       pso           = nullptr;
+    ID3D12GraphicsCommandList* list          = nullptr;
+    ID3D12Fence*               fence         = nullptr;
+    HANDLE                     fenceEvent    = nullptr;
+    UINT64                     fenceCounter  = 0;
+    FrameResources             frames[kMaxBackBuffers];
+    UINT                       bufferCount   = 0;
+    UINT                       backbufferW   = 0;
+    UINT                       backbufferH   = 0;
+
+    // Upload ring: bufferCount segments of ringInstances each, mapped for
+    // the lifetime of the resource
+    ID3D12Resource*   ring          = nullptr;
+    uint8_t*          ringMapped    = nullptr;
+    size_t            ringInstances = 0;
+
+    // Timing: two timestamps per back buffer, resolved into a persistently
+    // mapped readback buffer at the same index
+    OverlayTimings    timings;
+    bool              showTimingLine     = false;
+    const PoseLatch*  poseLatch          = nullptr;
+    PresentTimingSampler presentTiming;
+    PipelineTrace*    pipelineTrace      = nullptr;
+    ID3D12QueryHeap*  queryHeap          = nullptr;
+    ID3D12Resource*   queryReadback      = nullptr;
+    const UINT64*     queryMapped        = nullptr;
+    UINT64            timestampFrequency = 0;
+
+    DX12DrawContext    context;
+    DX12RenderCallback callback;
+    DX12LogFn          logFn = nullptr;
+    bool               firstPresentLogged = false;
+};
+
+inline OverlayState& State() {
+    static OverlayState s;
+    return s;
+}
+
+inline void Log(const char* msg) {
+    auto& s = State();
+    if (s.logFn) s.logFn(msg);
+}
+
+// Log a D3DCompile / root-signature error blob's text, then release it
+inline void LogErrorBlob(const char* what, ID3DBlob*& err) {
+    if (!err) return;
+    auto& s = State();
+    if (s.logFn) {
+        std::string msg(what);
+        msg += ": ";
+        msg.append(static_cast<const char*>(err->GetBufferPointer()), err->GetBufferSize());
+        // Blobs usually end in a NUL and a newline
+        while (!msg.empty() && (msg.back() == '\0' || msg.back() == '\n' || msg.back() == '\r')) msg.pop_back();
+        s.logFn(msg.c_str());
+    }
+    err->Release();
+    err = nullptr;
+}
+
+// Block until the GPU has finished everything the overlay submitted
+inline void WaitForGpu() {
+    auto& s = State();
+    if (!s.fence || s.fenceCounter == 0) return;
+    if (s.fence->GetCompletedValue() >= s.fenceCounter) return;
+    if (SUCCEEDED(s.fence->SetEventOnCompletion(s.fenceCounter, s.fenceEvent))) {
+        WaitForSingleObject(s.fenceEvent, INFINITE);
+    }
+}
+
+// Block until frame f's last submission has retired
+inline void WaitForFrame(const FrameResources& f) {
+    auto& s = State();
+    if (f.fenceValue == 0 || s.fence->GetCompletedValue() >= f.fenceValue) return;
+    if (SUCCEEDED(s.fence->SetEventOnCompletion(f.fenceValue, s.fenceEvent))) {
+        WaitForSingleObject(s.fenceEvent, INFINITE);
+    }
+}
+
+inline void ReleaseRing() {
+    auto& s = State();
+    if (s.ring) {
+        s.ring->Unmap(0, nullptr);
+        s.ring->Release();
+        s.ring = nullptr;
+    }
+    s.ringMapped = nullptr;
+    s.ringInstances = 0;
+}
+
+// Back buffers and their RTVs; the only swap-chain-sized state
+inline void ReleaseBackBuffers() {
+    auto& s = State();
+    for (UINT i = 0; i < kMaxBackBuffers; ++i) {
+        if (s.frames[i].backBuffer) { s.frames[i].backBuffer->Release(); s.frames[i].backBuffer = nullptr; }
+    }
+}
+
+inline void ReleaseTimingQueries() {
+    auto& s = State();
+    if (s.queryReadback) {
+        const D3D12_RANGE noWrite = {0, 0};
+        s.queryReadback->Unmap(0, &noWrite);
+        s.queryReadback->Release();
+        s.queryReadback = nullptr;
+    }
+    if (s.queryHeap) { s.queryHeap->Release(); s.queryHeap = nullptr; }
+    s.queryMapped = nullptr;
+    s.timestampFrequency = 0;
+    for (UINT i = 0; i < kMaxBackBuffers; ++i) s.frames[i].timed = false;
+}
+
+inline bool CreateTimingQueries() {
+    auto& s = State();
+    if (FAILED(s.queue->GetTimestampFrequency(&s.timestampFrequency)) || s.timestampFrequency == 0) return false;
+
+    D3D12_QUERY_HEAP_DESC qd = {};
+    qd.Type  = D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
+    qd.Count = kMaxBackBuffers * 2;
+    if (FAILED(s.device->CreateQueryHeap(&qd, IID_PPV_ARGS(&s.queryHeap)))) {
+        s.queryHeap = nullptr;
+        return false;
+    }
+
+    D3D12_HEAP_PROPERTIES heap = {};
+    heap.Type = D3D12_HEAP_TYPE_READBACK;
+    D3D12_RESOURCE_DESC rd = {};
+    rd.Dimension        = D3D12_RESOURCE_DIMENSION_BUFFER;
+    rd.Width            = sizeof(UINT64) * kMaxBackBuffers * 2;
+    rd.Height           = 1;
+    rd.DepthOrArraySize = 1;
+    rd.MipLevels        = 1;
+    rd.SampleDesc       = {1, 0};
+    rd.Layout           = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+    if (FAILED(s.device->CreateCommittedResource(&heap, D3D12_HEAP_FLAG_NONE, &rd, D3D12_RESOURCE_STATE_COPY_DEST,
+                                                 nullptr, IID_PPV_ARGS(&s.queryReadback)))) {
+        s.queryReadback = nullptr;
+        return false;
+    }
+    void* mapped = nullptr;
+    if (FAILED(s.queryReadback->Map(0, nullptr, &mapped))) return false;
+    s.queryMapped = static_cast<const UINT64*>(mapped);
+    return true;
+}
+
+inline void ReleaseDeviceResources() {
+    auto& s = State();
+    WaitForGpu();
+    ReleaseTimingQueries();
+    ReleaseRing();
+    ReleaseBackBuffers();
+    for (UINT i = 0; i < kMaxBackBuffers; ++i) {
+        if (s.frames[i].allocator) { s.frames[i].allocator->Release(); s.frames[i].allocator = nullptr; }
+        s.frames[i].fenceValue = 0;
+    }
+    if (s.list)          { s.list->Release();          s.list = nullptr; }
+    if (s.pso)           { s.pso->Release();           s.pso = nullptr; }
+    if (s.rootSignature) { s.rootSignature->Release(); s.rootSignature = nullptr; }
+    if (s.rtvHeap)       { s.rtvHeap->Release();       s.rtvHeap = nullptr; }
+    if (s.fence)         { s.fence->Release();         s.fence = nullptr; }
+    if (s.fenceEvent)    { CloseHandle(s.fenceEvent);  s.fenceEvent = nullptr; }
+    if (s.swap3)         { s.swap3->Release();         s.swap3 = nullptr; }
+    if (s.device)        { s.device->Release();        s.device = nullptr; }
+    s.fenceCounter = 0;
+    s.bufferCount = 0;
+    s.initialized = false;
+}
+
+// Root signature: the viewport constants (b0) as four root constants; no
+// tables, no samplers
+inline bool CreateRootSignature() {
+    auto& s = State();
+    D3D12_ROOT_PARAMETER param = {};
+    param.ParameterType            = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
+    param.Constants.ShaderRegister = 0;
+    param.Constants.RegisterSpace  = 0;
+    param.Constants.Num32BitValues = 4;
+    param.ShaderVisibility         = D3D12_SHADER_VISIBILITY_VERTEX;
+
+    D3D12_ROOT_SIGNATURE_DESC desc = {};
+    desc.NumParameters = 1;
+    desc.pParameters   = &param;
+    desc.Flags         = D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT;
+
+    ID3DBlob* blob = nullptr;
+    ID3DBlob* err  = nullptr;
+    HRESULT hr = D3D12SerializeRootSignature(&desc, D3D_ROOT_SIGNATURE_VERSION_1, &blob, &err);
+    LogErrorBlob("dx12_native_overlay: root signature", err);
+    if (FAILED(hr)) return false;
+    hr = s.device->CreateRootSignature(0, blob->GetBufferPointer(), blob->GetBufferSize(),
+                                       IID_PPV_ARGS(&s.rootSignature));
+    blob->Release();
+    return SUCCEEDED(hr);
+}
+
+// The one PSO: instanced SDF primitives, alpha blended, no depth, no culling
+inline bool CreatePipelineState(DXGI_FORMAT format) {
+    auto& s = State();
+    ID3DBlob* vsBlob = nullptr;
+    ID3DBlob* psBlob = nullptr;
+    ID3DBlob* err    = nullptr;
+    const std::string source = OverlayFontHLSL() + kOverlayPrimitiveHLSL;
+    const char* src = source.c_str();
+
+    HRESULT hr = D3DCompile(src, source.size(), nullptr, nullptr, nullptr,
+                            "VSPrim", "vs_5_0", 0, 0, &vsBlob, &err);
+    LogErrorBlob("dx12_native_overlay: vertex shader compile", err);
+    if (FAILED(hr)) return false;
+
+    hr = D3DCompile(src, source.size(), nullptr, nullptr, nullptr,
+                    "PSPrim", "ps_5_0", 0, 0, &psBlob, &err);
+    LogErrorBlob("dx12_native_overlay: pixel shader compile", err);
+    if (FAILED(hr)) { vsBlob->Release(); return false; }
+
+    // One OverlayPrimitive per instance, no per-vertex data
+    D3D12_INPUT_ELEMENT_DESC inputDesc[] = {
+        {"PRIM_ENDS", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 0,  D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1},
+        {"PRIM_SIZE", 0, DXGI_FORMAT_R32_FLOAT,          0, 16, D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1},
+        {"COLOR",     0, DXGI_FORMAT_R8G8B8A8_UNORM,     0, 20, D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1},
+        {"PRIM_KIND", 0, DXGI_FORMAT_R32_UINT,           0, 24, D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1},
+        {"PRIM_SOFT", 0, DXGI_FORMAT_R32_FLOAT,          0, 28, D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1},
+    };
+
+    D3D12_GRAPHICS_PIPELINE_STATE_DESC pd = {};
+    pd.pRootSignature = s.rootSignature;
+    pd.VS = { vsBlob->GetBufferPointer(), vsBlob->GetBufferSize() };
+    pd.PS = { psBlob->GetBufferPointer(), psBlob->GetBufferSize() };
+    pd.InputLayout = { inputDesc, 5 };
+
+    D3D12_RENDER_TARGET_BLEND_DESC& rt = pd.BlendState.RenderTarget[0];
+    rt.BlendEnable           = TRUE;
+    rt.SrcBlend              = D3D12_BLEND_SRC_ALPHA;
+    rt.DestBlend             = D3D12_BLEND_INV_SRC_ALPHA;
+    rt.BlendOp               = D3D12_BLEND_OP_ADD;
+    rt.SrcBlendAlpha         = D3D12_BLEND_ONE;
+    rt.DestBlendAlpha        = D3D12_BLEND_INV_SRC_ALPHA;
+    rt.BlendOpAlpha          = D3D12_BLEND_OP_ADD;
+    rt.LogicOp               = D3D12_LOGIC_OP_NOOP;
+    rt.RenderTargetWriteMask = D3D12_COLOR_WRITE_ENABLE_ALL;
+
+    pd.RasterizerState.FillMode        = D3D12_FILL_MODE_SOLID;
+    pd.RasterizerState.CullMode        = D3D12_CULL_MODE_NONE;
+    pd.RasterizerState.DepthClipEnable = TRUE;
+    pd.DepthStencilState.DepthEnable   = FALSE;
+    pd.DepthStencilState.StencilEnable = FALSE;
+    pd.SampleMask            = 0xFFFFFFFFu;
+    pd.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
+    pd.NumRenderTargets      = 1;
+    pd.RTVFormats[0]         = format;
+    pd.SampleDesc            = {1, 0};
+
+    hr = s.device->CreateGraphicsPipelineState(&pd, IID_PPV_ARGS(&s.pso));
+    vsBlob->Release(); psBlob->Release();
+    if (FAILED(hr)) {
+        char msg[80];
+        std::snprintf(msg, sizeof(msg), "dx12_native_overlay: CreateGraphicsPipelineState hr=0x%08lX",
+                      static_cast<unsigned long>(hr));
+        Log(msg);
+        s.pso = nullptr;
+        return false;
+    }
+    return true;
+}
+
+// Fetch the swap chain's buffers and write one RTV each
+inline bool AcquireBackBuffers(IDXGISwapChain* swap) {
+    auto& s = State();
+    D3D12_CPU_DESCRIPTOR_HANDLE rtv = s.rtvHeap->GetCPUDescriptorHandleForHeapStart();
+    for (UINT i = 0; i < s.bufferCount; ++i) {
+        if (FAILED(swap->GetBuffer(i, IID_PPV_ARGS(&s.frames[i].backBuffer)))) {
+            s.frames[i].backBuffer = nullptr;
+            return false;
+        }
+        s.device->CreateRenderTargetView(s.frames[i].backBuffer, nullptr, rtv);
+        rtv.ptr += s.rtvStride;
+    }
+    return true;
+}
+
+inline bool InitDeviceResources(IDXGISwapChain* swap) {
+    auto& s = State();
+    if (!s.queue) return false;  // no direct queue seen yet
+
+    if (FAILED(swap->QueryInterface(IID_PPV_ARGS(&s.swap3)))) {
+        s.swap3 = nullptr;
+        Log("dx12_native_overlay: swap chain is not IDXGISwapChain3");
+        return false;
+    }
+    if (FAILED(s.queue->GetDevice(IID_PPV_ARGS(&s.device)))) {
+        s.device = nullptr;
+        ReleaseDeviceResources();
+        return false;
+    }
+
+    DXGI_SWAP_CHAIN_DESC sd = {};
+    if (FAILED(swap->GetDesc(&sd)) || sd.BufferCount == 0 || sd.BufferCount > kMaxBackBuffers) {
+        ReleaseDeviceResources();
+        return false;
+    }
+    s.bufferCount = sd.BufferCount;
+    s.backbufferW = sd.BufferDesc.Width;
+    s.backbufferH = sd.BufferDesc.Height;
+
+    D3D12_DESCRIPTOR_HEAP_DESC hd = {};
+    hd.Type           = D3D12_DESCRIPTOR_HEAP_TYPE_RTV;
+    hd.NumDescriptors = kMaxBackBuffers;
+    if (FAILED(s.device->CreateDescriptorHeap(&hd, IID_PPV_ARGS(&s.rtvHeap)))) {
+        s.rtvHeap = nullptr;
+        ReleaseDeviceResources();
+        return false;
+    }
+    s.rtvStride = s.device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
+
+    if (!CreateRootSignature()) {
+        Log("dx12_native_overlay: root signature creation failed");
+        ReleaseDeviceResources();
+        return false;
+    }
+    if (!CreatePipelineState(sd.BufferDesc.Format)) {
+        Log("dx12_native_overlay: PSO creation failed");
+        ReleaseDeviceResources();
+        return false;
+    }
+
+    for (UINT i = 0; i < kMaxBackBuffers; ++i) {
+        if (FAILED(s.device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT,
+                                                    IID_PPV_ARGS(&s.frames[i].allocator)))) {
+            s.frames[i].allocator = nullptr;
+            ReleaseDeviceResources();
+            return false;
+        }
+    }
+    if (FAILED(s.device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, s.frames[0].allocator, s.pso,
+                                           IID_PPV_ARGS(&s.list)))) {
+        s.list = nullptr;
+        ReleaseDeviceResources();
+        return false;
+    }
+    s.list->Close();
+
+    if (FAILED(s.device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&s.fence)))) {
+        s.fence = nullptr;
+        ReleaseDeviceResources();
+        return false;
+    }
+    s.fenceEvent = CreateEventA(nullptr, FALSE, FALSE, nullptr);
+    if (!s.fenceEvent || !AcquireBackBuffers(swap)) {
+        ReleaseDeviceResources();
+        return false;
+    }
+
+    if (!CreateTimingQueries()) {
+        // Not fatal: CPU timings are still recorded
+        Log("dx12_native_overlay: timestamp queries unavailable, no GPU timing");
+        ReleaseTimingQueries();
+    }
+
+    s.initialized = true;
+    Log("dx12_native_overlay: device resources initialized");
+    return true;
+}
+
+// Make room for `instances` primitives per segment. Growing recreates the
+// ring, which needs every segment idle; it happens only when a frame draws
+// more than any frame before it.
+inline bool EnsureRingCapacity(size_t instances) {
+    auto& s = State();
+    if (instances <= s.ringInstances) return true;
+
+    WaitForGpu();
+    ReleaseRing();
+
+    const size_t perSegment = DX12RingSegmentInstances(instances);
+    D3D12_HEAP_PROPERTIES heap = {};
+    heap.Type = D3D12_HEAP_TYPE_UPLOAD;
+
+    D3D12_RESOURCE_DESC rd = {};
+    rd.Dimension        = D3D12_RESOURCE_DIMENSION_BUFFER;
+    rd.Width            = perSegment * sizeof(OverlayPrimitive) * s.bufferCount;
+    rd.Height           = 1;
+    rd.DepthOrArraySize = 1;
+    rd.MipLevels        = 1;
+    rd.SampleDesc       = {1, 0};
+    rd.Layout           = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+
+    if (FAILED(s.device->CreateCommittedResource(&heap, D3D12_HEAP_FLAG_NONE, &rd,
+                                                 D3D12_RESOURCE_STATE_GENERIC_READ, nullptr,
+                                                 IID_PPV_ARGS(&s.ring)))) {
+        s.ring = nullptr;
+        return false;
+    }
+    const D3D12_RANGE noRead = {0, 0};
+    void* mapped = nullptr;
+    if (FAILED(s.ring->Map(0, &noRead, &mapped))) {
+        s.ring->Release();
+        s.ring = nullptr;
+        return false;
+    }
+    s.ringMapped = static_cast<uint8_t*>(mapped);
+    s.ringInstances = perSegment;
+    return true;
+}
+
+inline void Transition(ID3D12Resource* res, D3D12_RESOURCE_STATES before, D3D12_RESOURCE_STATES after) {
+    D3D12_RESOURCE_BARRIER barrier = {};
+    barrier.Type                   = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+    barrier.Transition.pResource   = res;
+    barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+    barrier.Transition.StateBefore = before;
+    barrier.Transition.StateAfter  = after;
+    State().list->ResourceBarrier(1, &barrier);
+}
+
+inline float MicrosecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Frame `index` has retired: its resolved timestamps are readable
+inline void CollectGpuTiming(UINT index) {
+    auto& s = State();
+    FrameResources& frame = s.frames[index];
+    if (!frame.timed || !s.queryMapped) return;
+    frame.timed = false;
+    const UINT64 t0 = s.queryMapped[index * 2];
+    const UINT64 t1 = s.queryMapped[index * 2 + 1];
+    if (t1 >= t0) {
+        s.timings.gpu.Record(static_cast<float>((t1 - t0) * 1e6 / static_cast<double>(s.timestampFrequency)));
+    }
+}
+
+inline void RenderFrame() {
+    auto& s = State();
+    if (!s.initialized || !s.callback) return;
+    if (s.backbufferW == 0 || s.backbufferH == 0) return;
+
+    const UINT index = s.swap3->GetCurrentBackBufferIndex();
+    if (index >= s.bufferCount) return;
+    FrameResources& frame = s.frames[index];
+
+    s.context.Reset(static_cast<float>(s.backbufferW), static_cast<float>(s.backbufferH));
+    // Latch as late as possible: right before the draws are built
+    if (s.poseLatch) s.context.SetPoseDelta(s.poseLatch->Latch());
+    const auto callbackStart = std::chrono::steady_clock::now();
+    s.callback(s.context);
+    s.timings.callback_cpu.Record(MicrosecondsSince(callbackStart));
+    if (s.showTimingLine) DrawOverlayTimingLine(s.context, s.timings.Summarize());
+
+    const auto& prims = s.context.Primitives();
+    if (prims.empty()) return;
+    const auto uploadStart = std::chrono::steady_clock::now();
+    if (!EnsureRingCapacity(prims.size())) return;
+
+    // The swap chain already throttles to bufferCount frames in flight, so
+    // this wait is normally a no-op
+    WaitForFrame(frame);
+    CollectGpuTiming(index);
+
+    const size_t segmentBytes = s.ringInstances * sizeof(OverlayPrimitive);
+    const size_t segmentOffset = segmentBytes * index;
+    std::memcpy(s.ringMapped + segmentOffset, prims.data(), prims.size() * sizeof(OverlayPrimitive));
+    s.timings.upload_cpu.Record(MicrosecondsSince(uploadStart));
+
+    if (FAILED(frame.allocator->Reset())) return;
+    if (FAILED(s.list->Reset(frame.allocator, s.pso))) return;
+
+    if (s.queryHeap) s.list->EndQuery(s.queryHeap, D3D12_QUERY_TYPE_TIMESTAMP, index * 2);
+    Transition(frame.backBuffer, D3D12_RESOURCE_STATE_PRESENT, D3D12_RESOURCE_STATE_RENDER_TARGET);
+
+    D3D12_CPU_DESCRIPTOR_HANDLE rtv = s.rtvHeap->GetCPUDescriptorHandleForHeapStart();
+    rtv.ptr += static_cast<SIZE_T>(index) * s.rtvStride;
+    s.list->OMSetRenderTargets(1, &rtv, FALSE, nullptr);
+
+    D3D12_VIEWPORT vp = {0.0f, 0.0f, static_cast<float>(s.backbufferW), static_cast<float>(s.backbufferH), 0.0f, 1.0f};
+    D3D12_RECT scissor = {0, 0, static_cast<LONG>(s.backbufferW), static_cast<LONG>(s.backbufferH)};
+    s.list->RSSetViewports(1, &vp);
+    s.list->RSSetScissorRects(1, &scissor);
+
+    s.list->SetGraphicsRootSignature(s.rootSignature);
+    const float constants[4] = { 2.0f / s.backbufferW, 2.0f / s.backbufferH, 0.0f, 0.0f };
+    s.list->SetGraphicsRoot32BitConstants(0, 4, constants, 0);
+
+    D3D12_VERTEX_BUFFER_VIEW view = {};
+    view.BufferLocation = s.ring->GetGPUVirtualAddress() + segmentOffset;
+    view.SizeInBytes    = static_cast<UINT>(prims.size() * sizeof(OverlayPrimitive));
+    view.StrideInBytes  = sizeof(OverlayPrimitive);
+    s.list->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP);
+    s.list->IASetVertexBuffers(0, 1, &view);
+    s.list->DrawInstanced(4, static_cast<UINT>(prims.size()), 0, 0);
+
+    Transition(frame.backBuffer, D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_PRESENT);
+    if (s.queryHeap) {
+        s.list->EndQuery(s.queryHeap, D3D12_QUERY_TYPE_TIMESTAMP, index * 2 + 1);
+        s.list->ResolveQueryData(s.queryHeap, D3D12_QUERY_TYPE_TIMESTAMP, index * 2, 2, s.queryReadback,
+                                 sizeof(UINT64) * index * 2);
+    }
+    if (FAILED(s.list->Close())) return;
+
+    ID3D12CommandList* lists[] = { s.list };
+    s.origExecute(s.queue, 1, lists);
+    if (SUCCEEDED(s.queue->Signal(s.fence, s.fenceCounter + 1))) {
+        frame.fenceValue = ++s.fenceCounter;
+        frame.timed = s.queryHeap != nullptr;
+    }
+}
+
+inline void __stdcall HookedExecuteCommandLists(ID3D12CommandQueue* queue, UINT count,
+                                                ID3D12CommandList* const* lists) {
+    auto& s = State();
+    if (!s.queue && queue) {
+        // Only a direct queue can present; compute and copy queues also
+        // come through this hook
+        D3D12_COMMAND_QUEUE_DESC desc = queue->GetDesc();
+        if (desc.Type == D3D12_COMMAND_LIST_TYPE_DIRECT) {
+            queue->AddRef();
+            s.queue = queue;
+            Log("dx12_native_overlay: direct command queue captured");
+        }
+    }
+    s.origExecute(queue, count, lists);
+}
+
+inline HRESULT __stdcall HookedPresent(IDXGISwapChain* swap, UINT sync, UINT flags) {
+    auto& s = State();
+    if (!s.firstPresentLogged) {
+        s.firstPresentLogged = true;
+        Log("dx12_native_overlay: Present hook fired (first invocation)");
+    }
+    if (!s.initialized) {
+        InitDeviceResources(swap);
+    }
+    if (s.initialized) {
+        RenderFrame();
+    }
+    const int64_t presentUs = DxgiPresentTimestamp();
+    const HRESULT hr = s.origPresent(swap, sync, flags);
+    if (SUCCEEDED(hr)) SampleDxgiPresent(swap, presentUs, s.presentTiming, s.pipelineTrace);
+    return hr;
+}
+
+inline HRESULT __stdcall HookedResizeBuffers(IDXGISwapChain* swap, UINT bufferCount, UINT width, UINT height,
+                                             DXGI_FORMAT format, UINT swapChainFlags) {
+    auto& s = State();
+    if (s.initialized) {
+        // Buffer references must be gone before ResizeBuffers, and the
+        // ring's segment count follows the buffer count, so start over on
+        // the next Present. Resizes are rare enough for a full rebuild.
+        ReleaseDeviceResources();
+    }
+    // A mode change can change the refresh rate
+    s.presentTiming.Reset();
+    return s.origResize(swap, bufferCount, width, height, format, swapChainFlags);
+}
+
+// Get the ID3D12CommandQueue and IDXGISwapChain vtables by spawning a tiny
+// temp device, queue and flip-model swap chain.
+inline bool GetVTables(void**& outQueueVTable, void**& outSwapVTable) {
+    WNDCLASSEXA wc = {};
+    wc.cbSize        = sizeof(wc);
+    wc.style         = CS_HREDRAW | CS_VREDRAW;
+    wc.lpfnWndProc   = DefWindowProcA;
+    wc.hInstance     = GetModuleHandleA(nullptr);
+    wc.lpszClassName = "_CUL_Overlay12Probe";
+    if (!RegisterClassExA(&wc)) {
+        if (GetLastError() != ERROR_CLASS_ALREADY_EXISTS) return false;
+    }
+    HWND hwnd = CreateWindowA("_CUL_Overlay12Probe", "_probe", WS_POPUP, 0, 0, 16, 16,
+                              nullptr, nullptr, wc.hInstance, nullptr);
+    if (!hwnd) return false;
+
+    bool ok = false;
+    IDXGIFactory4*      factory = nullptr;
+    ID3D12Device*       dev     = nullptr;
+    ID3D12CommandQueue* queue   = nullptr;
+    IDXGISwapChain1*    swap    = nullptr;
+
+    if (SUCCEEDED(CreateDXGIFactory1(IID_PPV_ARGS(&factory))) &&
+        SUCCEEDED(D3D12CreateDevice(nullptr, D3D_FEATURE_LEVEL_11_0, IID_PPV_ARGS(&dev)))) {
+        D3D12_COMMAND_QUEUE_DESC qd = {};
+        qd.Type = D3D12_COMMAND_LIST_TYPE_DIRECT;
+        if (SUCCEEDED(dev->CreateCommandQueue(&qd, IID_PPV_ARGS(&queue)))) {
+            DXGI_SWAP_CHAIN_DESC1 scd = {};
+            scd.Width       = 16;
+            scd.Height      = 16;
+            scd.Format      = DXGI_FORMAT_R8G8B8A8_UNORM;
+            scd.SampleDesc  = {1, 0};
+            scd.BufferUsage = DXGI_USAGE_RENDER_TARGET_OUTPUT;
+            scd.BufferCount = 2;
+            scd.SwapEffect  = DXGI_SWAP_EFFECT_FLIP_DISCARD;
+            if (SUCCEEDED(factory->CreateSwapChainForHwnd(queue, hwnd, &scd, nullptr, nullptr, &swap))) {
+                outQueueVTable = *reinterpret_cast<void***>(queue);
+                outSwapVTable  = *reinterpret_cast<void***>(swap);
+                ok = true;
+            }
+        }
+    }
+
+    if (swap)    swap->Release();
+    if (queue)   queue->Release();
+    if (dev)     dev->Release();
+    if (factory) factory->Release();
+    DestroyWindow(hwnd);
+    return ok;
+}
+
+} // namespace dx12_native_detail
+
+inline DX12NativeOverlay::~DX12NativeOverlay() { Remove(); }
+
+inline void SetDX12NativeOverlayLogger(DX12LogFn fn) { dx12_native_detail::State().logFn = fn; }
+
+inline bool DX12NativeOverlay::Install() {
+    auto& s = dx12_native_detail::State();
+    if (s.hookInstalled) return true;
+
+    void** queueVTable = nullptr;
+    void** swapVTable  = nullptr;
+    if (!dx12_native_detail::GetVTables(queueVTable, swapVTable)) {
+        dx12_native_detail::Log("dx12_native_overlay: GetVTables failed (no D3D12 device?)");
+        return false;
+    }
+    dx12_native_detail::Log("dx12_native_overlay: queue and swap chain vtables obtained");
+
+    // ID3D12CommandQueue: ExecuteCommandLists @ 10.
+    // IDXGISwapChain (DXGI 1.0): Present @ 8, ResizeBuffers @ 13.
+    s.executeTarget       = queueVTable[10];
+    s.presentTarget       = swapVTable[8];
+    s.resizeBuffersTarget = swapVTable[13];
+
+    if (MH_CreateHook(s.executeTarget, &dx12_native_detail::HookedExecuteCommandLists,
+                      reinterpret_cast<LPVOID*>(&s.origExecute)) != MH_OK) {
+        dx12_native_detail::Log("dx12_native_overlay: MH_CreateHook(ExecuteCommandLists) failed");
+        return false;
+    }
+    if (MH_CreateHook(s.presentTarget, &dx12_native_detail::HookedPresent,
+                      reinterpret_cast<LPVOID*>(&s.origPresent)) != MH_OK) {
+        dx12_native_detail::Log("dx12_native_overlay: MH_CreateHook(Present) failed");
+        MH_RemoveHook(s.executeTarget);
+        return false;
+    }
+    if (MH_CreateHook(s.resizeBuffersTarget, &dx12_native_detail::HookedResizeBuffers,
+                      reinterpret_cast<LPVOID*>(&s.origResize)) != MH_OK) {
+        dx12_native_detail::Log("dx12_native_overlay: MH_CreateHook(ResizeBuffers) failed");
+        MH_RemoveHook(s.executeTarget);
+        MH_RemoveHook(s.presentTarget);
+        return false;
+    }
+    if (MH_EnableHook(s.executeTarget) != MH_OK ||
+        MH_EnableHook(s.presentTarget) != MH_OK ||
+        MH_EnableHook(s.resizeBuffersTarget) != MH_OK) {
+        dx12_native_detail::Log("dx12_native_overlay: MH_EnableHook failed");
+        MH_RemoveHook(s.executeTarget);
+        MH_RemoveHook(s.presentTarget);
+        MH_RemoveHook(s.resizeBuffersTarget);
+        return false;
+    }
+
+    s.callback      = m_callback;
+    s.hookInstalled = true;
+    m_hookInstalled = true;
+    dx12_native_detail::Log("dx12_native_overlay: hooks enabled");
+    return true;
+}
+
+inline void DX12NativeOverlay::Remove() {
+    auto& s = dx12_native_detail::State();
+    if (!s.hookInstalled) return;
+
+    MH_DisableHook(s.executeTarget);
+    MH_DisableHook(s.presentTarget);
+    MH_DisableHook(s.resizeBuffersTarget);
+    MH_RemoveHook(s.executeTarget);
+    MH_RemoveHook(s.presentTarget);
+    MH_RemoveHook(s.resizeBuffersTarget);
+
+    dx12_native_detail::ReleaseDeviceResources();
+    if (s.queue) { s.queue->Release(); s.queue = nullptr; }
+    s.callback = nullptr;
+    s.hookInstalled = false;
+    m_hookInstalled = false;
+}
+
+// See DX11Overlay::SetRenderCallback: RenderFrame reads the State() copy.
+inline void DX12NativeOverlay::SetRenderCallback(DX12RenderCallback cb) {
+    m_callback = cb;
+    dx12_native_detail::State().callback = std::move(cb);
+}
+
+inline OverlayTimingReport DX12NativeOverlay::GetTimings() const {
+    return dx12_native_detail::State().timings.Summarize();
+}
+
+inline void DX12NativeOverlay::SetTimingLineVisible(bool visible) {
+    dx12_native_detail::State().showTimingLine = visible;
+}
+
+inline void DX12NativeOverlay::SetPoseLatch(const PoseLatch* latch) {
+    dx12_native_detail::State().poseLatch = latch;
+}
+
+inline const PresentTimingSampler& DX12NativeOverlay::GetPresentTiming() const {
+    return dx12_native_detail::State().presentTiming;
+}
+
+inline void DX12NativeOverlay::SetPipelineTrace(PipelineTrace* trace) {
+    dx12_native_detail::State().pipelineTrace = trace;
+}
+
+#endif // CAMERAUNLOCK_DX12_NATIVE_OVERLAY_IMPLEMENTATION
+// Non-implementation TUs see only the declarations above; method definitions
+// live in the impl TU and resolve at link time.
+
+} // namespace cameraunlock::rendering
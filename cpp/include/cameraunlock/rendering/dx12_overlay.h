@@ -5,6 +5,8 @@
 //
 // This is a header-only implementation template for DX12 game overlays.
 // To use, include this header and provide the required dependencies.
+// For crosshair-style primitives without ImGui or kiero, use
+// dx12_native_overlay.h instead.
 //
 // Required external dependencies:
 // - kiero.h / kiero library
@@ -21,6 +23,9 @@
 //   // ...
 //   overlay.Remove();
 
+#include <cameraunlock/rendering/overlay_timing.h>
+
+#include <chrono>
 #include <functional>
 #include <cstdint>
 
@@ -32,6 +37,7 @@
 #include "imgui_impl_win32.h"
 #include "imgui_impl_dx12.h"
 #include "kiero.h"
+#include <cameraunlock/rendering/dxgi_present_timing.h>
 
 #pragma comment(lib, "d3d12.lib")
 #pragma comment(lib, "dxgi.lib")
@@ -155,6 +161,18 @@ public:
     bool IsInstalled() const { return m_hookInstalled; }
     bool IsInitialized() const { return m_initialized; }
 
+    // Rolling min/avg/p99 of the render callback's CPU time. Upload and GPU
+    // times belong to ImGui's backend and aren't measured here; the native
+    // overlay in dx12_native_overlay.h reports all three.
+    OverlayTimingReport GetTimings() const { return m_timings.Summarize(); }
+
+    // Present interval and scanout latency for display-time prediction
+    // (see DX11Overlay::GetPresentTiming)
+    const PresentTimingSampler& GetPresentTiming() const { return m_presentTiming; }
+
+    // Stamp each Present in this pipeline trace (see DX11Overlay::SetPipelineTrace)
+    void SetPipelineTrace(PipelineTrace* trace) { m_pipelineTrace = trace; }
+
 private:
     void CleanupResources() {
         if (m_pBackBuffers) {
@@ -276,7 +294,10 @@ private:
 
         if (m_renderCallback) {
             ImGuiIO& io = ImGui::GetIO();
+            const auto start = std::chrono::steady_clock::now();
             m_renderCallback(io.DisplaySize.x, io.DisplaySize.y);
+            m_timings.callback_cpu.Record(
+                std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - start).count());
         }
 
         ImGui::Render();
@@ -319,7 +340,10 @@ private:
                 s_instance->RenderImGui(pSwapChain);
             }
 
-            return s_instance->m_oPresent(pSwapChain, SyncInterval, Flags);
+            const int64_t presentUs = DxgiPresentTimestamp();
+            const HRESULT hr = s_instance->m_oPresent(pSwapChain, SyncInterval, Flags);
+            if (SUCCEEDED(hr)) SampleDxgiPresent(pSwapChain, presentUs, s_instance->m_presentTiming, s_instance->m_pipelineTrace);
+            return hr;
         }
         return S_OK;
     }
@@ -336,7 +360,10 @@ private:
                 s_instance->RenderImGui(pSwapChain);
             }
 
-            return s_instance->m_oPresent1(pSwapChain, SyncInterval, Flags, pPresentParameters);
+            const int64_t presentUs = DxgiPresentTimestamp();
+            const HRESULT hr = s_instance->m_oPresent1(pSwapChain, SyncInterval, Flags, pPresentParameters);
+            if (SUCCEEDED(hr)) SampleDxgiPresent(pSwapChain, presentUs, s_instance->m_presentTiming, s_instance->m_pipelineTrace);
+            return hr;
         }
         return S_OK;
     }
@@ -351,6 +378,8 @@ private:
                     }
                 }
             }
+            // A mode change can change the refresh rate
+            s_instance->m_presentTiming.Reset();
 
             HRESULT hr = s_instance->m_oResizeBuffers(pSwapChain, BufferCount, Width, Height, NewFormat, SwapChainFlags);
 
@@ -385,6 +414,9 @@ private:
     // Callbacks
     RenderCallback m_renderCallback;
     UpdateCallback m_updateCallback;
+    OverlayTimings m_timings;
+    PresentTimingSampler m_presentTiming;
+    PipelineTrace* m_pipelineTrace = nullptr;
 
     // Original functions
     ExecuteCommandLists_t m_oExecuteCommandLists = nullptr;
@@ -0,0 +1,64 @@
+#pragma once
+
+// Feeds a PresentTimingSampler from a DXGI swap chain.
+//
+// Shared by the overlay Present hooks; include it from their implementation
+// TUs only (it needs <dxgi.h> and <Windows.h>). Call SampleDxgiPresent right
+// after the original Present returns, with the steady-clock time taken just
+// before it. GetLastPresentCount identifies the frame, and GetFrameStatistics
+// (where the swap chain supports it: flip model, or exclusive fullscreen)
+// reports which present reached the screen at which vblank. Statistics that
+// aren't available simply leave the latency unknown. A PipelineTrace, if
+// given, gets the Present stamp for the most recently processed sample.
+
+#include <cameraunlock/diagnostics/pipeline_trace.h>
+#include <cameraunlock/processing/present_timing.h>
+
+#include <dxgi.h>
+#include <Windows.h>
+#include <chrono>
+#include <cstdint>
+
+namespace cameraunlock::rendering {
+
+namespace dxgi_present_detail {
+
+inline int64_t SteadyNowUs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// SyncQPCTime is on the QPC timeline; map it onto steady_clock by its age
+inline int64_t SteadyFromQpc(int64_t qpc) {
+    static const int64_t frequency = [] {
+        LARGE_INTEGER f;
+        QueryPerformanceFrequency(&f);
+        return static_cast<int64_t>(f.QuadPart);
+    }();
+    LARGE_INTEGER now;
+    QueryPerformanceCounter(&now);
+    const int64_t ageUs = (now.QuadPart - qpc) * 1000000 / frequency;
+    return SteadyNowUs() - ageUs;
+}
+
+} // namespace dxgi_present_detail
+
+inline int64_t DxgiPresentTimestamp() {
+    return dxgi_present_detail::SteadyNowUs();
+}
+
+inline void SampleDxgiPresent(IDXGISwapChain* swap, int64_t presentUs, PresentTimingSampler& sampler,
+                              PipelineTrace* trace = nullptr) {
+    if (trace) trace->MarkPresent(presentUs);
+
+    UINT presentId = 0;
+    if (FAILED(swap->GetLastPresentCount(&presentId))) presentId = 0;
+    sampler.RecordPresent(presentUs, presentId);
+
+    DXGI_FRAME_STATISTICS stats = {};
+    if (SUCCEEDED(swap->GetFrameStatistics(&stats)) && stats.SyncQPCTime.QuadPart != 0) {
+        sampler.RecordScanout(stats.PresentCount, dxgi_present_detail::SteadyFromQpc(stats.SyncQPCTime.QuadPart));
+    }
+}
+
+} // namespace cameraunlock::rendering
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include "cameraunlock/math/fast_math.h"
 
 namespace cameraunlock::rendering {
 
@@ -60,6 +63,165 @@ struct GuiMarkerResult {
     bool valid = false;
 };
 
+// Per-marker inputs for GuiMarkerBatch, struct-of-arrays; every non-null
+// array holds `count` entries.
+struct GuiMarkerBatchInput {
+    const float* gxNative = nullptr;  // required, as GuiMarkerInput::gxNative
+    const float* gyNative = nullptr;  // required
+    const float* depth    = nullptr;  // null = the frame's assumedDepth for every marker
+};
+
+// Per-marker results, struct-of-arrays. An invalid marker (behind the
+// head-rotated camera) gets a zero delta and valid = 0.
+struct GuiMarkerBatchOutput {
+    float*   deltaX = nullptr;
+    float*   deltaY = nullptr;
+    uint8_t* valid  = nullptr;  // optional
+};
+
+// The per-frame half of ComputeGuiMarkerCompensation: the rotation
+// basis, focal lengths and position offset depend only on the head pose,
+// FOV and screen, so they're computed once and shared by every marker.
+class GuiMarkerBatch {
+public:
+    GuiMarkerBatch() = default;
+
+    // Takes the frame terms from `frame`; its gxNative/gyNative are ignored
+    // and its assumedDepth is the default marker depth
+    explicit GuiMarkerBatch(const GuiMarkerInput& frame) { Prepare(frame); }
+
+    // Returns false (and every marker comes out invalid) when the FOV is
+    // outside [10, 170] degrees
+    bool Prepare(const GuiMarkerInput& frame) {
+        m_valid = false;
+        if (frame.fovDegY < 10.f || frame.fovDegY > 170.f) return false;
+
+        const float aspect = frame.screenW / frame.screenH;
+        const float halfW  = frame.screenW * 0.5f;
+        const float halfH  = frame.screenH * 0.5f;
+        const float fovY   = frame.fovDegY * kGuiDegToRad;
+        const float tanHalfFovY = cameraunlock::math::trig::Tan(fovY * 0.5f);
+        const float tanHalfFovX = tanHalfFovY * aspect;
+        m_fx = halfW / tanHalfFovX;  // focal length (pixels)
+        m_fy = halfH / tanHalfFovY;
+        m_invFx = 1.0f / m_fx;
+        m_invFy = 1.0f / m_fy;
+
+        // 6DOF position offset (camera-local translation)
+        m_offX =  frame.posX;
+        m_offY = -frame.posY;
+        m_offZ = -frame.posZ;
+        m_depth = frame.assumedDepth;
+
+        // Build rotation matrix R = Ry(y) * Rx(p) * Rz(-r).
+        // Roll is negated per empirical verification (F1/F2/F3 toggle test).
+        const float yawRad   =  frame.yawDeg   * kGuiDegToRad;
+        const float pitchRad =  frame.pitchDeg * kGuiDegToRad;
+        const float rollRad  = -frame.rollDeg  * kGuiDegToRad;
+
+        float sy, cy, sp, cp, sr, cr;
+        cameraunlock::math::trig::SinCos(yawRad, sy, cy);
+        cameraunlock::math::trig::SinCos(pitchRad, sp, cp);
+        cameraunlock::math::trig::SinCos(rollRad, sr, cr);
+
+        // R = Ry * Rx * Rz (expanded)
+        m_r11 = cy*cr + sy*sp*sr;
+        m_r12 = -cy*sr + sy*sp*cr;
+        m_r13 = sy*cp;
+        m_r21 = cp*sr;
+        m_r22 = cp*cr;
+        m_r23 = -sp;
+        m_r31 = -sy*cr + cy*sp*sr;
+        m_r32 = sy*sr + cy*sp*cr;
+        m_r33 = cy*cp;
+
+        m_valid = true;
+        return true;
+    }
+
+    bool IsValid() const { return m_valid; }
+
+    // One marker at native screen position (gx, gy) and the given depth
+    GuiMarkerResult Compute(float gx, float gy, float depth) const {
+        GuiMarkerResult out;
+        if (!m_valid) return out;
+        float dx, dy;
+        out.valid = Solve(gx, gy, depth, dx, dy);
+        if (out.valid) {
+            out.deltaX = dx;
+            out.deltaY = dy;
+        }
+        return out;
+    }
+
+    GuiMarkerResult Compute(float gx, float gy) const { return Compute(gx, gy, m_depth); }
+
+    // `count` markers in one branch-free loop the compiler can vectorize
+    void Compute(const GuiMarkerBatchInput& in, size_t count, const GuiMarkerBatchOutput& out) const {
+        if (!m_valid) {
+            for (size_t i = 0; i < count; ++i) {
+                out.deltaX[i] = 0.f;
+                out.deltaY[i] = 0.f;
+                if (out.valid) out.valid[i] = 0;
+            }
+            return;
+        }
+        if (in.depth) {
+            for (size_t i = 0; i < count; ++i) {
+                float dx, dy;
+                const bool ok = Solve(in.gxNative[i], in.gyNative[i], in.depth[i], dx, dy);
+                out.deltaX[i] = ok ? dx : 0.f;
+                out.deltaY[i] = ok ? dy : 0.f;
+                if (out.valid) out.valid[i] = ok ? 1 : 0;
+            }
+        } else {
+            for (size_t i = 0; i < count; ++i) {
+                float dx, dy;
+                const bool ok = Solve(in.gxNative[i], in.gyNative[i], m_depth, dx, dy);
+                out.deltaX[i] = ok ? dx : 0.f;
+                out.deltaY[i] = ok ? dy : 0.f;
+                if (out.valid) out.valid[i] = ok ? 1 : 0;
+            }
+        }
+    }
+
+private:
+    // Steps 1-5 of ComputeGuiMarkerCompensation for one marker. Computes
+    // through even when the anchor is behind the camera (dividing by a
+    // safe depth) so the loop body has no branches; returns whether the
+    // result is usable.
+    bool Solve(float gx, float gy, float depth, float& dx, float& dy) const {
+        // Camera-space position of the world anchor (meters), offset
+        const float Xc = gx * m_invFx * depth + m_offX;
+        const float Yc = gy * m_invFy * depth + m_offY;
+        const float Zc = depth + m_offZ;
+
+        // Apply R^T (transpose) to (Xc, Yc, Zc). The 3D hook rotates the
+        // camera by R, so in the rotated camera frame a world anchor at
+        // original camera-space P is at R^T * P.
+        const float xR = m_r11*Xc + m_r21*Yc + m_r31*Zc;
+        const float yR = m_r12*Xc + m_r22*Yc + m_r32*Zc;
+        const float zR = m_r13*Xc + m_r23*Yc + m_r33*Zc;
+
+        const bool inFront = zR >= 1e-4f;
+        const float invZ = 1.0f / (inFront ? zR : 1.0f);
+
+        // Clamp to reasonable screen range.
+        constexpr float kMax = 1600.f;
+        dx = std::fmin(std::fmax(xR * invZ * m_fx - gx, -kMax), kMax);
+        dy = std::fmin(std::fmax(yR * invZ * m_fy - gy, -kMax), kMax);
+        return inFront;
+    }
+
+    float m_fx = 0.f, m_fy = 0.f, m_invFx = 0.f, m_invFy = 0.f;
+    float m_offX = 0.f, m_offY = 0.f, m_offZ = 0.f;
+    float m_depth = 2.f;
+    float m_r11 = 1.f, m_r12 = 0.f, m_r13 = 0.f;
+    float m_r21 = 0.f, m_r22 = 1.f, m_r23 = 0.f;
+    float m_r31 = 0.f, m_r32 = 0.f, m_r33 = 1.f;
+    bool m_valid = false;
+};
+
 // Compute the screen-space delta that keeps a world-anchored GUI marker
 // pinned to its target in the head-rotated + head-translated view.
 //
@@ -82,74 +244,11 @@ struct GuiMarkerResult {
 //   - Position X: Xc += posX  (camera right is +X)
 //   - Position Y: Yc -= posY
 //   - Position Z: Zc -= posZ
+//
+// This is the single-marker form of GuiMarkerBatch; prefer the batch when
+// several markers share a frame, so the trig runs once.
 inline GuiMarkerResult ComputeGuiMarkerCompensation(const GuiMarkerInput& in) {
-    GuiMarkerResult out;
-
-    if (in.fovDegY < 10.f || in.fovDegY > 170.f) return out;
-
-    const float aspect = in.screenW / in.screenH;
-    const float halfW  = in.screenW * 0.5f;
-    const float halfH  = in.screenH * 0.5f;
-    const float fovY   = in.fovDegY * kGuiDegToRad;
-    const float tanHalfFovY = std::tan(fovY * 0.5f);
-    const float tanHalfFovX = tanHalfFovY * aspect;
-    const float Fx = halfW / tanHalfFovX;  // focal length (pixels)
-    const float Fy = halfH / tanHalfFovY;
-
-    // Camera-space position of the world anchor (meters).
-    const float depth = in.assumedDepth;
-    float Xc = (in.gxNative / Fx) * depth;
-    float Yc = (in.gyNative / Fy) * depth;
-    float Zc = depth;
-
-    // Apply 6DOF position offset (camera-local translation).
-    Xc += in.posX;
-    Yc -= in.posY;
-    Zc -= in.posZ;
-
-    // Build rotation matrix R = Ry(y) * Rx(p) * Rz(-r).
-    // Roll is negated per empirical verification (F1/F2/F3 toggle test).
-    const float yawRad   =  in.yawDeg   * kGuiDegToRad;
-    const float pitchRad =  in.pitchDeg * kGuiDegToRad;
-    const float rollRad  = -in.rollDeg  * kGuiDegToRad;
-
-    const float sy = std::sin(yawRad),   cy = std::cos(yawRad);
-    const float sp = std::sin(pitchRad), cp = std::cos(pitchRad);
-    const float sr = std::sin(rollRad),  cr = std::cos(rollRad);
-
-    // R = Ry * Rx * Rz (expanded)
-    const float r11 = cy*cr + sy*sp*sr;
-    const float r12 = -cy*sr + sy*sp*cr;
-    const float r13 = sy*cp;
-    const float r21 = cp*sr;
-    const float r22 = cp*cr;
-    const float r23 = -sp;
-    const float r31 = -sy*cr + cy*sp*sr;
-    const float r32 = sy*sr + cy*sp*cr;
-    const float r33 = cy*cp;
-
-    // Apply R^T (transpose) to (Xc, Yc, Zc). The 3D hook rotates the
-    // camera by R, so in the rotated camera frame a world anchor at
-    // original camera-space P is at R^T * P.
-    const float xR = r11*Xc + r21*Yc + r31*Zc;
-    const float yR = r12*Xc + r22*Yc + r32*Zc;
-    const float zR = r13*Xc + r23*Yc + r33*Zc;
-
-    if (zR < 1e-4f) return out;  // behind camera
-
-    const float newX = (xR / zR) * Fx;
-    const float newY = (yR / zR) * Fy;
-
-    // Clamp to reasonable screen range.
-    constexpr float kMax = 1600.f;
-    out.deltaX = newX - in.gxNative;
-    out.deltaY = newY - in.gyNative;
-    if (out.deltaX >  kMax) out.deltaX =  kMax;
-    if (out.deltaX < -kMax) out.deltaX = -kMax;
-    if (out.deltaY >  kMax) out.deltaY =  kMax;
-    if (out.deltaY < -kMax) out.deltaY = -kMax;
-    out.valid = true;
-    return out;
+    return GuiMarkerBatch(in).Compute(in.gxNative, in.gyNative, in.assumedDepth);
 }
 
 // Helper: read FOV from REFramework's InvokeRet union.
@@ -0,0 +1,214 @@
+#pragma once
+
+// Embedded 5x7 bitmap font for overlay text.
+//
+// The atlas is a strip of kOverlayFontGlyphCount cells, kOverlayFontCellStride
+// texels apart: cell 0 is solid, cells 1..95 hold printable ASCII. It is
+// small enough to live in the shaders as an immediate constant table
+// (OverlayFontHLSL), so text needs no texture, sampler or descriptor and
+// draws in the same batch as the other geometry:
+//   - triangle vertices carry atlas texel coordinates; solid geometry leaves
+//     them at 0 and lands in the solid cell
+//   - SDF instances use OverlayPrimitiveKind::Glyph
+// Use integer scales for crisp text; fractional ones draw uneven rows.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace cameraunlock::rendering {
+
+constexpr int kOverlayFontGlyphWidth  = 5;
+constexpr int kOverlayFontGlyphHeight = 7;
+constexpr int kOverlayFontAdvance     = 6;   // pen step per character, in texels
+constexpr int kOverlayFontLineHeight  = 9;   // pen step per '\n'
+constexpr int kOverlayFontCellStride  = 8;   // atlas texels between cells
+constexpr uint32_t kOverlayFontSolidGlyph = 0;
+constexpr uint32_t kOverlayFontGlyphCount = 96;
+
+// Rows top to bottom, bit 4 = leftmost column; ASCII 32..126
+inline constexpr uint8_t kOverlayFont5x7[95][7] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // ' '
+    {0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x04},  // '!'
+    {0x0A, 0x0A, 0x0A, 0x00, 0x00, 0x00, 0x00},  // '"'
+    {0x0A, 0x0A, 0x1F, 0x0A, 0x1F, 0x0A, 0x0A},  // '#'
+    {0x04, 0x0F, 0x14, 0x0E, 0x05, 0x1E, 0x04},  // '$'
+    {0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03},  // '%'
+    {0x0C, 0x12, 0x14, 0x08, 0x15, 0x12, 0x0D},  // '&'
+    {0x04, 0x04, 0x08, 0x00, 0x00, 0x00, 0x00},  // '\''
+    {0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02},  // '('
+    {0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08},  // ')'
+    {0x00, 0x04, 0x15, 0x0E, 0x15, 0x04, 0x00},  // '*'
+    {0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00},  // '+'
+    {0x00, 0x00, 0x00, 0x00, 0x0C, 0x04, 0x08},  // ','
+    {0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00},  // '-'
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C},  // '.'
+    {0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00},  // '/'
+    {0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E},  // '0'
+    {0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E},  // '1'
+    {0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F},  // '2'
+    {0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E},  // '3'
+    {0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02},  // '4'
+    {0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E},  // '5'
+    {0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E},  // '6'
+    {0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08},  // '7'
+    {0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E},  // '8'
+    {0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C},  // '9'
+    {0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00},  // ':'
+    {0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x04, 0x08},  // ';'
+    {0x02, 0x04, 0x08, 0x10, 0x08, 0x04, 0x02},  // '<'
+    {0x00, 0x00, 0x1F, 0x00, 0x1F, 0x00, 0x00},  // '='
+    {0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08},  // '>'
+    {0x0E, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04},  // '?'
+    {0x0E, 0x11, 0x01, 0x0D, 0x15, 0x15, 0x0E},  // '@'
+    {0x0E, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11},  // 'A'
+    {0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E},  // 'B'
+    {0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E},  // 'C'
+    {0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C},  // 'D'
+    {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F},  // 'E'
+    {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10},  // 'F'
+    {0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F},  // 'G'
+    {0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11},  // 'H'
+    {0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E},  // 'I'
+    {0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C},  // 'J'
+    {0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11},  // 'K'
+    {0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F},  // 'L'
+    {0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11},  // 'M'
+    {0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11},  // 'N'
+    {0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E},  // 'O'
+    {0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10},  // 'P'
+    {0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D},  // 'Q'
+    {0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11},  // 'R'
+    {0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E},  // 'S'
+    {0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04},  // 'T'
+    {0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E},  // 'U'
+    {0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04},  // 'V'
+    {0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A},  // 'W'
+    {0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11},  // 'X'
+    {0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04},  // 'Y'
+    {0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F},  // 'Z'
+    {0x0E, 0x08, 0x08, 0x08, 0x08, 0x08, 0x0E},  // '['
+    {0x00, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00},  // '\\'
+    {0x0E, 0x02, 0x02, 0x02, 0x02, 0x02, 0x0E},  // ']'
+    {0x04, 0x0A, 0x11, 0x00, 0x00, 0x00, 0x00},  // '^'
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F},  // '_'
+    {0x08, 0x04, 0x02, 0x00, 0x00, 0x00, 0x00},  // '`'
+    {0x00, 0x00, 0x0E, 0x01, 0x0F, 0x11, 0x0F},  // 'a'
+    {0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x1E},  // 'b'
+    {0x00, 0x00, 0x0E, 0x10, 0x10, 0x11, 0x0E},  // 'c'
+    {0x01, 0x01, 0x0D, 0x13, 0x11, 0x11, 0x0F},  // 'd'
+    {0x00, 0x00, 0x0E, 0x11, 0x1F, 0x10, 0x0E},  // 'e'
+    {0x06, 0x09, 0x08, 0x1C, 0x08, 0x08, 0x08},  // 'f'
+    {0x00, 0x0F, 0x11, 0x11, 0x0F, 0x01, 0x0E},  // 'g'
+    {0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x11},  // 'h'
+    {0x04, 0x00, 0x0C, 0x04, 0x04, 0x04, 0x0E},  // 'i'
+    {0x02, 0x00, 0x06, 0x02, 0x02, 0x12, 0x0C},  // 'j'
+    {0x10, 0x10, 0x12, 0x14, 0x18, 0x14, 0x12},  // 'k'
+    {0x0C, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E},  // 'l'
+    {0x00, 0x00, 0x1A, 0x15, 0x15, 0x11, 0x11},  // 'm'
+    {0x00, 0x00, 0x16, 0x19, 0x11, 0x11, 0x11},  // 'n'
+    {0x00, 0x00, 0x0E, 0x11, 0x11, 0x11, 0x0E},  // 'o'
+    {0x00, 0x00, 0x1E, 0x11, 0x1E, 0x10, 0x10},  // 'p'
+    {0x00, 0x00, 0x0D, 0x13, 0x0F, 0x01, 0x01},  // 'q'
+    {0x00, 0x00, 0x16, 0x19, 0x10, 0x10, 0x10},  // 'r'
+    {0x00, 0x00, 0x0E, 0x10, 0x0E, 0x01, 0x1E},  // 's'
+    {0x08, 0x08, 0x1C, 0x08, 0x08, 0x09, 0x06},  // 't'
+    {0x00, 0x00, 0x11, 0x11, 0x11, 0x13, 0x0D},  // 'u'
+    {0x00, 0x00, 0x11, 0x11, 0x11, 0x0A, 0x04},  // 'v'
+    {0x00, 0x00, 0x11, 0x11, 0x15, 0x15, 0x0A},  // 'w'
+    {0x00, 0x00, 0x11, 0x0A, 0x04, 0x0A, 0x11},  // 'x'
+    {0x00, 0x00, 0x11, 0x11, 0x0F, 0x01, 0x0E},  // 'y'
+    {0x00, 0x00, 0x1F, 0x02, 0x04, 0x08, 0x1F},  // 'z'
+    {0x02, 0x04, 0x04, 0x08, 0x04, 0x04, 0x02},  // '{'
+    {0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04},  // '|'
+    {0x08, 0x04, 0x04, 0x02, 0x04, 0x04, 0x08},  // '}'
+    {0x00, 0x00, 0x08, 0x15, 0x02, 0x00, 0x00},  // '~'
+};
+
+// Atlas cell for a character; unprintable characters draw as '?'
+inline uint32_t OverlayFontGlyphIndex(char c) {
+    const unsigned char u = static_cast<unsigned char>(c);
+    if (u < 32 || u > 126) return '?' - 31;
+    return u - 31;
+}
+
+// Whether texel (col, row) of an atlas cell is lit; the solid cell is lit
+// everywhere inside the glyph box
+inline bool OverlayFontTexel(uint32_t glyph, int col, int row) {
+    if (col < 0 || row < 0 || col >= kOverlayFontGlyphWidth || row >= kOverlayFontGlyphHeight) return false;
+    if (glyph == kOverlayFontSolidGlyph) return true;
+    if (glyph >= kOverlayFontGlyphCount) return false;
+    return (kOverlayFont5x7[glyph - 1][row] >> (kOverlayFontGlyphWidth - 1 - col)) & 1;
+}
+
+// One glyph's screen quad: (x, y) top-left, w x h pixels
+struct OverlayGlyphQuad {
+    float x, y, w, h;
+    uint32_t glyph;
+};
+
+// Lay out text at (x, y) with each font texel `scale` pixels square and call
+// emit(const OverlayGlyphQuad&) for every visible glyph. '\n' starts a new
+// line; spaces advance without a quad. Returns the widest line's width.
+template <typename Emit>
+float LayoutOverlayText(float x, float y, const char* text, float scale, Emit&& emit) {
+    float pen = x;
+    float widest = 0.0f;
+    for (const char* p = text; *p; ++p) {
+        if (*p == '\n') {
+            if (pen - x > widest) widest = pen - x;
+            pen = x;
+            y += kOverlayFontLineHeight * scale;
+            continue;
+        }
+        if (*p != ' ') {
+            emit(OverlayGlyphQuad{pen, y, kOverlayFontGlyphWidth * scale, kOverlayFontGlyphHeight * scale,
+                                  OverlayFontGlyphIndex(*p)});
+        }
+        pen += kOverlayFontAdvance * scale;
+    }
+    return pen - x > widest ? pen - x : widest;
+}
+
+// Width (widest line) and height of text as LayoutOverlayText draws it
+inline void MeasureOverlayText(const char* text, float scale, float* width, float* height) {
+    size_t lines = 1;
+    for (const char* p = text; *p; ++p) lines += *p == '\n';
+    const float w = LayoutOverlayText(0.0f, 0.0f, text, scale, [](const OverlayGlyphQuad&) {});
+    if (width) *width = w;
+    if (height) *height = ((lines - 1) * kOverlayFontLineHeight + kOverlayFontGlyphHeight) * scale;
+}
+
+// HLSL for the font table and its lookup, prepended to the overlay shaders:
+//   bool OverlayFontTexel(uint glyph, int2 texel)
+// Each glyph packs its 35 bits as row * 5 + (4 - col) into a uint2.
+inline std::string OverlayFontHLSL() {
+    std::string src = "static const uint2 g_overlayFont[96] = {\n";
+    char entry[32];
+    for (uint32_t glyph = 0; glyph < kOverlayFontGlyphCount; ++glyph) {
+        uint64_t bits = 0;
+        for (int row = 0; row < kOverlayFontGlyphHeight; ++row) {
+            for (int col = 0; col < kOverlayFontGlyphWidth; ++col) {
+                if (OverlayFontTexel(glyph, col, row)) {
+                    bits |= uint64_t{1} << (row * kOverlayFontGlyphWidth + (kOverlayFontGlyphWidth - 1 - col));
+                }
+            }
+        }
+        std::snprintf(entry, sizeof(entry), "uint2(0x%08Xu,0x%Xu),", static_cast<uint32_t>(bits),
+                      static_cast<uint32_t>(bits >> 32));
+        src += entry;
+        if (glyph % 4 == 3) src += '\n';
+    }
+    src += R"(};
+bool OverlayFontTexel(uint glyph, int2 t) {
+    if (t.x < 0 || t.y < 0 || t.x >= 5 || t.y >= 7 || glyph >= 96) return false;
+    uint bit = (uint)(t.y * 5 + (4 - t.x));
+    uint2 w = g_overlayFont[glyph];
+    return ((bit < 32 ? (w.x >> bit) : (w.y >> (bit - 32))) & 1) != 0;
+}
+)";
+    return src;
+}
+
+} // namespace cameraunlock::rendering
@@ -0,0 +1,225 @@
+#pragma once
+
+// Instanced SDF primitives shared by the native overlay backends.
+//
+// Each shape is one 32-byte OverlayPrimitive instance. The vertex shader
+// expands it to a screen-space quad just large enough to cover the shape
+// plus its anti-aliasing fringe, and the pixel shader evaluates the shape's
+// signed distance to get analytic coverage. A dot costs the same 32 bytes
+// at any radius, and edges stay one pixel soft at any resolution.
+//
+// The CPU functions below mirror the HLSL in kOverlayPrimitiveHLSL exactly;
+// keep the two in step. Glyphs read the font table from overlay_font.h, so
+// the shader source is OverlayFontHLSL() followed by kOverlayPrimitiveHLSL.
+
+#include <cameraunlock/rendering/overlay_font.h>
+
+#include <cmath>
+#include <cstdint>
+
+namespace cameraunlock::rendering {
+
+// 0xAABBGGRR (R8G8B8A8_UNORM with little-endian byte order in memory).
+using Rgba = uint32_t;
+
+enum class OverlayPrimitiveKind : uint32_t {
+    Line   = 0,  // a = start, b = end, size = thickness; butt caps
+    Circle = 1,  // a = centre, size = radius; filled
+    Ring   = 2,  // a = centre, size = outer radius, b.x = ring thickness
+    Rect   = 3,  // a = top-left, b = width/height, size unused; filled
+    Glyph  = 4,  // a = top-left, b = width/height, size = font atlas cell; hard edges
+};
+
+// Pixel-space shape, one GPU instance
+struct OverlayPrimitive {
+    float ax, ay;
+    float bx, by;
+    float size;
+    Rgba color;
+    OverlayPrimitiveKind kind;
+    float softness;  // anti-aliasing width in pixels (1 = crisp)
+};
+static_assert(sizeof(OverlayPrimitive) == 32, "OverlayPrimitive is uploaded as a 32-byte instance");
+
+inline OverlayPrimitive MakeLinePrimitive(float x1, float y1, float x2, float y2, Rgba color, float thickness = 1.0f) {
+    return {x1, y1, x2, y2, thickness, color, OverlayPrimitiveKind::Line, 1.0f};
+}
+
+inline OverlayPrimitive MakeCirclePrimitive(float cx, float cy, float radius, Rgba color) {
+    return {cx, cy, 0.0f, 0.0f, radius, color, OverlayPrimitiveKind::Circle, 1.0f};
+}
+
+inline OverlayPrimitive MakeRingPrimitive(float cx, float cy, float radius, float thickness, Rgba color) {
+    return {cx, cy, thickness, 0.0f, radius, color, OverlayPrimitiveKind::Ring, 1.0f};
+}
+
+inline OverlayPrimitive MakeRectPrimitive(float x, float y, float w, float h, Rgba color) {
+    return {x, y, w, h, 0.0f, color, OverlayPrimitiveKind::Rect, 1.0f};
+}
+
+// b spans the glyph's 5x7 texels; no anti-aliasing fringe, texels are crisp
+inline OverlayPrimitive MakeGlyphPrimitive(const OverlayGlyphQuad& q, Rgba color) {
+    return {q.x, q.y, q.w, q.h, static_cast<float>(q.glyph), color, OverlayPrimitiveKind::Glyph, 0.0f};
+}
+
+// Screen-space box the vertex shader expands the instance to
+struct OverlayPrimitiveBounds {
+    float x0, y0, x1, y1;
+};
+
+inline OverlayPrimitiveBounds GetOverlayPrimitiveBounds(const OverlayPrimitive& p) {
+    const float pad = p.softness;
+    switch (p.kind) {
+        case OverlayPrimitiveKind::Line: {
+            const float r = p.size * 0.5f + pad;
+            return {std::fmin(p.ax, p.bx) - r, std::fmin(p.ay, p.by) - r,
+                    std::fmax(p.ax, p.bx) + r, std::fmax(p.ay, p.by) + r};
+        }
+        case OverlayPrimitiveKind::Circle:
+        case OverlayPrimitiveKind::Ring: {
+            const float r = p.size + pad;
+            return {p.ax - r, p.ay - r, p.ax + r, p.ay + r};
+        }
+        case OverlayPrimitiveKind::Rect:
+        case OverlayPrimitiveKind::Glyph:
+        default:
+            return {p.ax - pad, p.ay - pad, p.ax + p.bx + pad, p.ay + p.by + pad};
+    }
+}
+
+// Distance from (px, py) to a box of half extents (hx, hy) centred on the
+// origin; negative inside
+inline float OverlayBoxDistance(float px, float py, float hx, float hy) {
+    const float qx = std::fabs(px) - hx;
+    const float qy = std::fabs(py) - hy;
+    const float ox = std::fmax(qx, 0.0f);
+    const float oy = std::fmax(qy, 0.0f);
+    return std::sqrt(ox * ox + oy * oy) + std::fmin(std::fmax(qx, qy), 0.0f);
+}
+
+// Signed distance in pixels from (px, py) to the shape's edge; negative
+// inside. A glyph's is its box; OverlayPrimitiveCoverage tests its texels.
+inline float OverlayPrimitiveDistance(const OverlayPrimitive& p, float px, float py) {
+    switch (p.kind) {
+        case OverlayPrimitiveKind::Line: {
+            const float dx = p.bx - p.ax, dy = p.by - p.ay;
+            const float len = std::sqrt(dx * dx + dy * dy);
+            if (len < 1e-3f) return 1e6f;
+            const float ux = dx / len, uy = dy / len;
+            const float rx = px - p.ax, ry = py - p.ay;
+            // Segment-local frame: along the line from its midpoint, and across it
+            const float along = rx * ux + ry * uy - len * 0.5f;
+            const float across = -rx * uy + ry * ux;
+            return OverlayBoxDistance(along, across, len * 0.5f, p.size * 0.5f);
+        }
+        case OverlayPrimitiveKind::Circle: {
+            const float dx = px - p.ax, dy = py - p.ay;
+            return std::sqrt(dx * dx + dy * dy) - p.size;
+        }
+        case OverlayPrimitiveKind::Ring: {
+            const float dx = px - p.ax, dy = py - p.ay;
+            const float halfWidth = p.bx * 0.5f;
+            return std::fabs(std::sqrt(dx * dx + dy * dy) - (p.size - halfWidth)) - halfWidth;
+        }
+        case OverlayPrimitiveKind::Rect:
+        case OverlayPrimitiveKind::Glyph:
+        default: {
+            const float hx = p.bx * 0.5f, hy = p.by * 0.5f;
+            return OverlayBoxDistance(px - (p.ax + hx), py - (p.ay + hy), hx, hy);
+        }
+    }
+}
+
+// Fraction of the pixel centred at (px, py) the shape covers
+inline float OverlayPrimitiveCoverage(const OverlayPrimitive& p, float px, float py) {
+    if (p.kind == OverlayPrimitiveKind::Glyph) {
+        const int col = static_cast<int>(std::floor((px - p.ax) * kOverlayFontGlyphWidth / p.bx));
+        const int row = static_cast<int>(std::floor((py - p.ay) * kOverlayFontGlyphHeight / p.by));
+        return OverlayFontTexel(static_cast<uint32_t>(p.size), col, row) ? 1.0f : 0.0f;
+    }
+    const float soft = p.softness > 1e-3f ? p.softness : 1e-3f;
+    const float c = 0.5f - OverlayPrimitiveDistance(p, px, py) / soft;
+    return c < 0.0f ? 0.0f : (c > 1.0f ? 1.0f : c);
+}
+
+// Shader pair for the instanced path. Draw 4 vertices per instance as a
+// triangle strip with no vertex buffer bound; the instance stream goes in
+// slot 0 (DX11 input layout, per-instance step rate 1).
+// Constant buffer b0 matches the backends' viewport constants.
+inline const char* kOverlayPrimitiveHLSL = R"(
+cbuffer cb : register(b0) { float2 g_invHalfViewport; float2 g_offset; };
+struct PrimIn {
+    float4 ends  : PRIM_ENDS;
+    float  size  : PRIM_SIZE;
+    float4 col   : COLOR0;
+    uint   kind  : PRIM_KIND;
+    float  soft  : PRIM_SOFT;
+    uint   vid   : SV_VertexID;
+};
+struct PrimOut {
+    float4 pos : SV_POSITION;
+    float2 px  : TEXCOORD0;
+    nointerpolation float4 ends : TEXCOORD1;
+    nointerpolation float2 sizeSoft : TEXCOORD2;
+    nointerpolation uint   kind : TEXCOORD3;
+    nointerpolation float4 col : COLOR0;
+};
+PrimOut VSPrim(PrimIn i) {
+    float pad = i.soft;
+    float4 box;
+    if (i.kind == 0) {
+        float r = i.size * 0.5 + pad;
+        box = float4(min(i.ends.xy, i.ends.zw) - r, max(i.ends.xy, i.ends.zw) + r);
+    } else if (i.kind >= 3) {
+        box = float4(i.ends.xy - pad, i.ends.xy + i.ends.zw + pad);
+    } else {
+        float r = i.size + pad;
+        box = float4(i.ends.xy - r, i.ends.xy + r);
+    }
+    float2 corner = float2((i.vid & 1) ? box.z : box.x, (i.vid & 2) ? box.w : box.y);
+    PrimOut o;
+    float2 p = corner + g_offset;
+    o.pos = float4(p.x * g_invHalfViewport.x - 1.0, 1.0 - p.y * g_invHalfViewport.y, 0, 1);
+    o.px = corner;
+    o.ends = i.ends;
+    o.sizeSoft = float2(i.size, max(i.soft, 1e-3));
+    o.kind = i.kind;
+    o.col = i.col;
+    return o;
+}
+float BoxDist(float2 p, float2 h) {
+    float2 q = abs(p) - h;
+    return length(max(q, 0)) + min(max(q.x, q.y), 0);
+}
+float4 PSPrim(PrimOut i) : SV_TARGET {
+    if (i.kind == 4) {
+        int2 t = int2(floor((i.px - i.ends.xy) * float2(5, 7) / i.ends.zw));
+        if (!OverlayFontTexel((uint)i.sizeSoft.x, t)) discard;
+        return i.col;
+    }
+    float d;
+    if (i.kind == 0) {
+        float2 dir = i.ends.zw - i.ends.xy;
+        float len = length(dir);
+        if (len < 1e-3) discard;
+        float2 u = dir / len;
+        float2 r = i.px - i.ends.xy;
+        float along = dot(r, u) - len * 0.5;
+        float across = -r.x * u.y + r.y * u.x;
+        d = BoxDist(float2(along, across), float2(len * 0.5, i.sizeSoft.x * 0.5));
+    } else if (i.kind == 1) {
+        d = length(i.px - i.ends.xy) - i.sizeSoft.x;
+    } else if (i.kind == 2) {
+        float halfWidth = i.ends.z * 0.5;
+        d = abs(length(i.px - i.ends.xy) - (i.sizeSoft.x - halfWidth)) - halfWidth;
+    } else {
+        float2 h = i.ends.zw * 0.5;
+        d = BoxDist(i.px - (i.ends.xy + h), h);
+    }
+    float coverage = saturate(0.5 - d / i.sizeSoft.y);
+    if (coverage <= 0) discard;
+    return float4(i.col.rgb, i.col.a * coverage);
+}
+)";
+
+} // namespace cameraunlock::rendering
@@ -0,0 +1,140 @@
+#pragma once
+
+// Overlay cost instrumentation shared by the native overlay backends.
+//
+// The Present hooks feed three rolling windows each frame: CPU time in the
+// render callback, CPU time spent uploading geometry, and GPU time for the
+// overlay's own draw (timestamp query pairs read back a few frames later,
+// never waited on). Everything is fixed-size so recording costs no
+// allocation. This is the native counterpart of the C# PerformanceMonitor.
+//
+// DrawOverlayTimingLine renders the summary through a draw context with
+// DrawString (DX11DrawContext, DX12DrawContext), using the overlay_font.h
+// glyphs.
+
+#include <cameraunlock/rendering/overlay_primitives.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+namespace cameraunlock::rendering {
+
+// Two seconds at 60 fps
+constexpr size_t kOverlayTimingSamples = 120;
+
+struct OverlayTimingSummary {
+    float min_us;
+    float avg_us;
+    float p99_us;
+    size_t samples;  // 0 = nothing recorded yet; the other fields are 0
+};
+
+// Ring of the last kOverlayTimingSamples durations, in microseconds
+class OverlayTimingWindow {
+public:
+    void Record(float us) {
+        m_samples[m_next] = us;
+        m_next = (m_next + 1) % kOverlayTimingSamples;
+        if (m_count < kOverlayTimingSamples) ++m_count;
+    }
+
+    void Reset() {
+        m_next = 0;
+        m_count = 0;
+    }
+
+    size_t GetSampleCount() const { return m_count; }
+
+    OverlayTimingSummary Summarize() const {
+        OverlayTimingSummary out = {0.0f, 0.0f, 0.0f, m_count};
+        if (m_count == 0) return out;
+
+        float sorted[kOverlayTimingSamples] = {};
+        std::copy(m_samples, m_samples + m_count, sorted);
+        double sum = 0.0;
+        float lo = sorted[0];
+        for (size_t i = 0; i < m_count; ++i) {
+            sum += sorted[i];
+            lo = std::min(lo, sorted[i]);
+        }
+        // Nearest-rank p99: the sample below which 99% of the window falls
+        const size_t rank = (m_count * 99 + 99) / 100 - 1;
+        std::nth_element(sorted, sorted + rank, sorted + m_count);
+
+        out.min_us = lo;
+        out.avg_us = static_cast<float>(sum / m_count);
+        out.p99_us = sorted[rank];
+        return out;
+    }
+
+private:
+    float m_samples[kOverlayTimingSamples] = {};
+    size_t m_next = 0;
+    size_t m_count = 0;
+};
+
+struct OverlayTimingReport {
+    OverlayTimingSummary callback_cpu;
+    OverlayTimingSummary upload_cpu;
+    OverlayTimingSummary gpu;  // samples == 0 when the device has no timestamp queries
+};
+
+struct OverlayTimings {
+    OverlayTimingWindow callback_cpu;
+    OverlayTimingWindow upload_cpu;
+    OverlayTimingWindow gpu;
+
+    void Reset() {
+        callback_cpu.Reset();
+        upload_cpu.Reset();
+        gpu.Reset();
+    }
+
+    OverlayTimingReport Summarize() const {
+        return {callback_cpu.Summarize(), upload_cpu.Summarize(), gpu.Summarize()};
+    }
+};
+
+// "CPU 12/15/40 UP 3/4/9 GPU 20/22/31 US": min/avg/p99 in microseconds for
+// the callback, the upload and the GPU draw; "-" for an empty window.
+// Returns the length written (truncated to out_size - 1).
+inline size_t FormatOverlayTimingLine(const OverlayTimingReport& report, char* out, size_t out_size) {
+    if (!out || out_size == 0) return 0;
+    size_t len = 0;
+    auto append = [&](const char* label, const OverlayTimingSummary& s) {
+        if (len + 1 >= out_size) return;
+        int n;
+        if (s.samples == 0) {
+            n = std::snprintf(out + len, out_size - len, "%s - ", label);
+        } else {
+            n = std::snprintf(out + len, out_size - len, "%s %.0f/%.0f/%.0f ", label,
+                              s.min_us, s.avg_us, s.p99_us);
+        }
+        if (n > 0) len = std::min(len + static_cast<size_t>(n), out_size - 1);
+    };
+    append("CPU", report.callback_cpu);
+    append("UP", report.upload_cpu);
+    append("GPU", report.gpu);
+    if (len + 1 < out_size) {
+        const int n = std::snprintf(out + len, out_size - len, "US");
+        if (n > 0) len = std::min(len + static_cast<size_t>(n), out_size - 1);
+    }
+    return len;
+}
+
+// The stats line in the top-left corner over a dark backing strip
+template <typename DrawContext>
+void DrawOverlayTimingLine(DrawContext& dc, const OverlayTimingReport& report) {
+    char line[96];
+    FormatOverlayTimingLine(report, line, sizeof(line));
+    constexpr float kScale = 2.0f;
+    constexpr float kMargin = 4.0f;
+    float w = 0.0f, h = 0.0f;
+    MeasureOverlayText(line, kScale, &w, &h);
+    dc.DrawRect(0.0f, 0.0f, w + kMargin * 2.0f, h + kMargin * 2.0f, 0xA0000000u);
+    dc.DrawString(kMargin, kMargin, line, 0xFFFFFFFFu, kScale);
+}
+
+} // namespace cameraunlock::rendering
@@ -0,0 +1,174 @@
+#pragma once
+
+#include "cameraunlock/protocol/socket_types.h"
+#include "cameraunlock/runtime/thread_scheduling.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cameraunlock {
+
+/// One background thread shared by a mod's I/O services.
+///
+/// Instead of each service owning a mostly idle thread (UDP receive, bind
+/// retry, hotkey polling, config watching), they register what they wait
+/// on with a Runtime and get callbacks on its thread:
+///   - sockets, called when readable
+///   - wait objects: event HANDLEs on Windows, file descriptors on POSIX
+///     (e.g. the config watcher's change notification)
+///   - one-shot and periodic timers
+///   - posted functions
+/// The loop sleeps in one wait (MsgWaitForMultipleObjects on Windows, poll
+/// on POSIX) with the timeout of the nearest timer, so an idle runtime has
+/// no wakeups. On Windows the loop also pumps the thread's message queue,
+/// which is what low-level keyboard hooks installed on it need.
+///
+/// UdpReceiver, HotkeyPoller and ConfigWatcher have Start overloads taking
+/// a Runtime; the scheduling controls are applied once, to this thread.
+///
+/// Callbacks run on the runtime thread and must not block. Registration is
+/// safe from any thread, including from inside callbacks. Remove()
+/// guarantees the callback is not running and won't run again once it
+/// returns (it waits for the loop when called from another thread).
+class Runtime {
+public:
+    using Callback = std::function<void()>;
+
+    /// Sockets plus wait objects; bounded by the Windows wait limit (64)
+    /// less the loop's own wake event.
+    static constexpr size_t kMaxWaitSources = 62;
+
+    Runtime() = default;
+    ~Runtime();
+
+    // Non-copyable, non-movable (callbacks capture registrations by id)
+    Runtime(const Runtime&) = delete;
+    Runtime& operator=(const Runtime&) = delete;
+    Runtime(Runtime&&) = delete;
+    Runtime& operator=(Runtime&&) = delete;
+
+    /// Starts the runtime thread. Sources added before Start are picked up.
+    /// @return True if running (including when already started).
+    bool Start(const ThreadSchedulingOptions& scheduling = {});
+
+    /// Stops and joins the thread. Registrations are kept, so a later
+    /// Start resumes them. Must not be called from the runtime thread.
+    void Stop();
+
+    /// True while the runtime thread is running.
+    bool IsRunning() const { return m_running.load(std::memory_order_acquire); }
+
+    /// True when called from the runtime thread (i.e. from a callback).
+    bool IsRuntimeThread() const;
+
+    /// Which scheduling settings took effect on the runtime thread.
+    ThreadSchedulingResult GetSchedulingResult() const { return m_schedulingResult.Get(); }
+
+    /// Calls onReadable whenever sock has data (or an error) pending. The
+    /// callback should read until the socket would block.
+    /// @return Registration id, or 0 if the source limit is reached.
+    int AddSocket(SOCKET sock, Callback onReadable);
+
+#ifdef _WIN32
+    /// Calls onSignaled when the event is signaled. A manual-reset event
+    /// must be reset (or re-armed) by the callback.
+    int AddWaitHandle(HANDLE handle, Callback onSignaled);
+#else
+    /// Calls onReadable when fd is readable.
+    int AddWaitHandle(int fd, Callback onReadable);
+#endif
+
+    /// Calls onExpired after delayMs, then every periodMs (0 = once; a
+    /// one-shot timer unregisters itself after firing).
+    /// @return Registration id.
+    int AddTimer(int delayMs, int periodMs, Callback onExpired);
+
+    /// Unregisters a source or timer. Unknown ids are ignored.
+    void Remove(int id);
+
+    /// Runs fn once on the runtime thread.
+    void Post(Callback fn);
+
+    /// Runs fn on the runtime thread and waits for it to finish; inline
+    /// when called from the runtime thread or while the runtime is stopped.
+    /// Services use it to change registrations without racing their own
+    /// callbacks.
+    void Call(Callback fn);
+
+    /// Registered sources and timers (diagnostics).
+    size_t GetRegistrationCount() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    enum class SourceKind { Socket, Handle };
+
+    struct Source {
+        int id;
+        SourceKind kind;
+        SOCKET socket;
+#ifdef _WIN32
+        HANDLE handle;  // The socket's WSAEVENT, or the registered handle
+#else
+        int fd;
+#endif
+        Callback callback;
+        bool removed;
+    };
+
+    struct Timer {
+        int id;
+        Clock::time_point deadline;
+        int periodMs;
+        Callback callback;
+        bool removed;
+    };
+
+    bool OpenWake();
+    void CloseWake();
+    void Wake();
+    void Run();
+    void ApplyPending();
+    int WaitTimeoutMs() const;
+    void WaitAndDispatch(int timeoutMs);
+    void RunTimers();
+    void Compact();
+    void MarkRemoved(int id);
+    void ReleaseSource(Source& source);
+
+    std::thread m_thread;
+    std::atomic<bool> m_running{false};
+    std::atomic<bool> m_stopFlag{false};
+    ThreadSchedulingSlot m_schedulingResult;
+
+    // Runtime thread (or any thread while stopped, under m_mutex)
+    std::vector<Source> m_sources;
+    std::vector<Timer> m_timers;
+
+    // Requests from other threads, applied at the top of each loop pass
+    mutable std::mutex m_mutex;
+    std::condition_variable m_applied;
+    std::vector<Source> m_pendingSources;
+    std::vector<Timer> m_pendingTimers;
+    std::vector<int> m_pendingRemovals;
+    std::vector<Callback> m_posted;
+    uint64_t m_requestGeneration = 0;
+    uint64_t m_appliedGeneration = 0;
+    int m_nextId = 1;
+    size_t m_waitSourceCount = 0;
+    size_t m_timerCount = 0;
+
+#ifdef _WIN32
+    HANDLE m_wakeEvent = nullptr;
+#else
+    int m_wakePipe[2] = {-1, -1};
+#endif
+};
+
+}  // namespace cameraunlock
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace cameraunlock {
+
+/// Publishes immutable, versioned settings snapshots from a config thread
+/// (e.g. INI hot reload) to one per-frame reader without locking the
+/// reader.
+///
+/// Reader cost when nothing changed: one acquire load of the version.
+/// On change the reader copies the new snapshot out under a hazard
+/// pointer; publishers retire replaced snapshots and free them once the
+/// reader no longer holds them. Any number of threads may Publish; exactly
+/// one thread may call ReadIfChanged (the processor's thread). The channel
+/// must outlive its reader.
+template <typename T>
+class SettingsChannel {
+public:
+    explicit SettingsChannel(const T& initial = T{})
+        : m_current(new Node{initial, 1}), m_version(1) {}
+
+    ~SettingsChannel() {
+        delete m_current.load(std::memory_order_relaxed);
+        for (Node* node : m_retired) {
+            delete node;
+        }
+    }
+
+    SettingsChannel(const SettingsChannel&) = delete;
+    SettingsChannel& operator=(const SettingsChannel&) = delete;
+
+    /// Makes value the current snapshot. Returns its version (starts at 1).
+    uint64_t Publish(const T& value) {
+        std::lock_guard<std::mutex> lock(m_publishMutex);
+        uint64_t version = m_version.load(std::memory_order_relaxed) + 1;
+        Node* previous = m_current.exchange(new Node{value, version}, std::memory_order_seq_cst);
+        m_version.store(version, std::memory_order_release);
+
+        m_retired.push_back(previous);
+        Reclaim();
+        return version;
+    }
+
+    /// Latest published version.
+    uint64_t GetVersion() const { return m_version.load(std::memory_order_acquire); }
+
+    /// Reader thread only. If a version newer than seen_version exists,
+    /// copies it to out, updates seen_version and returns true.
+    bool ReadIfChanged(uint64_t& seen_version, T& out) const {
+        if (m_version.load(std::memory_order_acquire) == seen_version) {
+            return false;
+        }
+
+        // Protect the snapshot: announce it, then confirm it is still current
+        // so a publisher that swapped it out will see the hazard.
+        Node* node = m_current.load(std::memory_order_acquire);
+        for (;;) {
+            m_hazard.store(node, std::memory_order_seq_cst);
+            Node* again = m_current.load(std::memory_order_seq_cst);
+            if (again == node) break;
+            node = again;
+        }
+
+        bool changed = node->version != seen_version;
+        if (changed) {
+            out = node->value;
+            seen_version = node->version;
+        }
+        m_hazard.store(nullptr, std::memory_order_release);
+        return changed;
+    }
+
+    /// Snapshots waiting for the reader to let go (diagnostics).
+    size_t GetRetiredCount() const {
+        std::lock_guard<std::mutex> lock(m_publishMutex);
+        return m_retired.size();
+    }
+
+private:
+    struct Node {
+        T value;
+        uint64_t version;
+    };
+
+    // Called with m_publishMutex held.
+    void Reclaim() {
+        Node* inUse = m_hazard.load(std::memory_order_seq_cst);
+        size_t kept = 0;
+        for (Node* node : m_retired) {
+            if (node == inUse) {
+                m_retired[kept++] = node;
+            } else {
+                delete node;
+            }
+        }
+        m_retired.resize(kept);
+    }
+
+    std::atomic<Node*> m_current;
+    std::atomic<uint64_t> m_version;
+    mutable std::atomic<Node*> m_hazard{nullptr};
+
+    mutable std::mutex m_publishMutex;
+    std::vector<Node*> m_retired;
+};
+
+}  // namespace cameraunlock
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace cameraunlock {
+
+/// Bounded single-producer, single-consumer queue for small commands
+/// (e.g. recenter requests from a hotkey thread to a receive thread).
+///
+/// Exactly one thread may TryPush and one thread may TryPop at a time;
+/// both are wait-free and never allocate. The head and tail indices sit on
+/// separate cache lines so the two sides don't contend. Capacity must be a
+/// power of two.
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4324)  // structure was padded due to alignment specifier
+#endif
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+public:
+    static constexpr size_t kCapacity = Capacity;
+
+    SpscQueue() = default;
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /// Producer only. Copies item into the queue.
+    /// @return False if the queue is full; the item is not queued.
+    bool TryPush(const T& item) {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+        m_items[tail & (Capacity - 1)] = item;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Consumer only. Moves the oldest item to out.
+    /// @return False if the queue is empty.
+    bool TryPop(T& out) {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        out = m_items[head & (Capacity - 1)];
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Consumer only. Drops everything queued so far.
+    void Clear() {
+        m_head.store(m_tail.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+    /// Items queued; exact only on the consumer thread, a snapshot elsewhere.
+    size_t GetSize() const {
+        // Head first: it can only catch up to a tail read after it
+        const size_t head = m_head.load(std::memory_order_acquire);
+        return m_tail.load(std::memory_order_acquire) - head;
+    }
+
+private:
+    alignas(64) std::atomic<size_t> m_head{0};  // Written by the consumer
+    alignas(64) std::atomic<size_t> m_tail{0};  // Written by the producer
+    T m_items[Capacity] = {};
+};
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+}  // namespace cameraunlock
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace cameraunlock {
+
+/// Scheduling priority for library-owned worker threads.
+enum class ThreadPriority {
+    Normal,        // Leave as created
+    AboveNormal,   // THREAD_PRIORITY_ABOVE_NORMAL / nice -5
+    Highest,       // THREAD_PRIORITY_HIGHEST / nice -10
+    TimeCritical   // THREAD_PRIORITY_TIME_CRITICAL / SCHED_FIFO
+};
+
+/// Requested scheduling for a worker thread. Defaults change nothing.
+struct ThreadSchedulingOptions {
+    ThreadPriority priority = ThreadPriority::Normal;
+
+    /// Bitmask of allowed logical CPUs (bit n = CPU n), 0 = leave unchanged.
+    uint64_t affinityMask = 0;
+
+    /// MMCSS task name ("Games", "Pro Audio", ...), nullptr = none.
+    /// Windows only; avrt.dll is loaded on demand.
+    const char* mmcssTask = nullptr;
+
+    /// Suggested setting for a receive thread that must not be starved by
+    /// a game saturating every core.
+    static ThreadSchedulingOptions LowLatency() {
+        ThreadSchedulingOptions options;
+        options.priority = ThreadPriority::Highest;
+        options.mmcssTask = "Games";
+        return options;
+    }
+};
+
+/// Outcome of one requested setting.
+enum class SchedulingStatus {
+    NotRequested,
+    Applied,
+    Failed,        // OS refused (e.g. missing CAP_SYS_NICE / privilege)
+    Unsupported,   // Not available on this platform
+    Superseded,    // Priority left to an applied MMCSS registration
+    Pending        // Thread has not applied its settings yet
+};
+
+/// What actually took effect, per setting.
+struct ThreadSchedulingResult {
+    SchedulingStatus priority = SchedulingStatus::NotRequested;
+    SchedulingStatus affinity = SchedulingStatus::NotRequested;
+    SchedulingStatus mmcss = SchedulingStatus::NotRequested;
+
+    /// True if everything requested took effect; false while pending.
+    bool AllApplied() const {
+        auto ok = [](SchedulingStatus s) {
+            return s == SchedulingStatus::NotRequested || s == SchedulingStatus::Applied ||
+                   s == SchedulingStatus::Superseded;
+        };
+        return ok(priority) && ok(affinity) && ok(mmcss);
+    }
+
+    /// True until the thread has applied its settings.
+    bool IsPending() const {
+        return priority == SchedulingStatus::Pending || affinity == SchedulingStatus::Pending ||
+               mmcss == SchedulingStatus::Pending;
+    }
+};
+
+/// Result of a scheduled thread, written by that thread once its settings
+/// are applied and readable from any thread meanwhile.
+class ThreadSchedulingSlot {
+public:
+    /// Marks every setting options requests as Pending.
+    void Reset(const ThreadSchedulingOptions& options);
+
+    void Set(const ThreadSchedulingResult& result);
+    ThreadSchedulingResult Get() const;
+
+private:
+    mutable std::mutex m_mutex;
+    ThreadSchedulingResult m_result;
+};
+
+/// Applies options to the calling thread. An MMCSS registration stays
+/// active until RevertCurrentThreadScheduling (or thread exit). MMCSS sets
+/// the thread priority itself, so a requested priority is only applied when
+/// the registration fails or is unsupported, and reports Superseded otherwise.
+/// @param mmcssHandle Receives the MMCSS handle to pass to the revert call.
+ThreadSchedulingResult ApplyCurrentThreadScheduling(const ThreadSchedulingOptions& options,
+                                                    void*& mmcssHandle);
+
+/// Undoes the MMCSS registration made by ApplyCurrentThreadScheduling.
+void RevertCurrentThreadScheduling(void* mmcssHandle);
+
+/// Starts a thread that applies options before running body and reverts
+/// MMCSS after it returns. Does not wait for the thread, so it is safe to
+/// call under the loader lock.
+/// @param result Reports Pending until the thread has applied its settings,
+///               then what took effect. Must outlive the thread.
+std::thread StartScheduledThread(const ThreadSchedulingOptions& options,
+                                 ThreadSchedulingSlot& result,
+                                 std::function<void()> body);
+
+}  // namespace cameraunlock
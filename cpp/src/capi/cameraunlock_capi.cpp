@@ -0,0 +1,215 @@
+#include "cameraunlock/capi/cameraunlock_capi.h"
+
+#include "cameraunlock/processing/head_pose_processor.h"
+#include "cameraunlock/protocol/udp_receiver.h"
+
+#include <new>
+
+using cameraunlock::HeadPoseFrame;
+using cameraunlock::HeadPoseProcessor;
+using cameraunlock::TrackingSample;
+
+struct cu_tracker {
+    cameraunlock::UdpReceiver receiver;
+    HeadPoseProcessor processor;
+};
+
+// The managed declarations mirror these layouts field for field
+static_assert(sizeof(cu_sample) == 40, "cu_sample layout is part of the ABI");
+static_assert(sizeof(cu_frame) == 72, "cu_frame layout is part of the ABI");
+static_assert(sizeof(cu_settings) == 100, "cu_settings layout is part of the ABI");
+static_assert((CU_FRAME_ROTATION_VALID == HeadPoseFrame::kRotationValid) &&
+              (CU_FRAME_POSITION_VALID == HeadPoseFrame::kPositionValid) &&
+              (CU_FRAME_NEW_SAMPLE == HeadPoseFrame::kNewSample),
+              "cu_frame.flags passes HeadPoseFrame::flags through");
+
+namespace {
+
+uint32_t ReceiverFlags(const cameraunlock::UdpReceiver& receiver) {
+    uint32_t flags = 0;
+    if (receiver.IsRunning()) flags |= CU_RECEIVER_RUNNING;
+    if (receiver.IsReceiving()) flags |= CU_RECEIVER_RECEIVING;
+    if (receiver.IsRemoteConnection()) flags |= CU_RECEIVER_REMOTE;
+    if (receiver.IsFailed()) flags |= CU_RECEIVER_FAILED;
+    return flags;
+}
+
+}  // namespace
+
+extern "C" {
+
+// Every body is wrapped in try/catch: an exception crossing into a managed
+// host terminates the process, so it ends as the call's failure value.
+
+uint32_t cu_get_api_version(void) {
+    return CU_API_VERSION;
+}
+
+void cu_get_default_settings(cu_settings* out) {
+    try {
+        if (!out) return;
+        const HeadPoseProcessor defaults;
+        const cameraunlock::SensitivitySettings& sensitivity = defaults.GetSensitivity();
+        const cameraunlock::DeadzoneSettings& deadzone = defaults.GetDeadzone();
+        const cameraunlock::PositionSettings& position = defaults.GetPositionSettings();
+
+        out->sensitivity_yaw = sensitivity.yaw;
+        out->sensitivity_pitch = sensitivity.pitch;
+        out->sensitivity_roll = sensitivity.roll;
+        out->invert_yaw = sensitivity.invert_yaw ? 1 : 0;
+        out->invert_pitch = sensitivity.invert_pitch ? 1 : 0;
+        out->invert_roll = sensitivity.invert_roll ? 1 : 0;
+        out->deadzone_yaw = deadzone.yaw;
+        out->deadzone_pitch = deadzone.pitch;
+        out->deadzone_roll = deadzone.roll;
+        out->smoothing = defaults.GetSmoothing();
+        out->position_enabled = defaults.IsPositionEnabled() ? 1 : 0;
+        out->position_sensitivity_x = position.sensitivity_x;
+        out->position_sensitivity_y = position.sensitivity_y;
+        out->position_sensitivity_z = position.sensitivity_z;
+        out->position_limit_x = position.limit_x;
+        out->position_limit_y = position.limit_y;
+        out->position_limit_z = position.limit_z;
+        out->position_limit_z_back = position.limit_z_back;
+        out->position_smoothing = position.smoothing;
+        out->invert_x = position.invert_x ? 1 : 0;
+        out->invert_y = position.invert_y ? 1 : 0;
+        out->invert_z = position.invert_z ? 1 : 0;
+        out->tracker_pivot_forward = defaults.GetTrackerPivotForward();
+        out->interpolation_enabled = defaults.IsInterpolationEnabled() ? 1 : 0;
+        out->max_extrapolation_fraction = defaults.GetMaxExtrapolationFraction();
+    } catch (...) {
+    }
+}
+
+cu_tracker* cu_tracker_create(void) {
+    try {
+        return new (std::nothrow) cu_tracker();
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void cu_tracker_destroy(cu_tracker* tracker) {
+    try {
+        if (!tracker) return;
+        tracker->receiver.Stop();
+        delete tracker;
+    } catch (...) {
+    }
+}
+
+int32_t cu_tracker_start(cu_tracker* tracker, uint16_t port) {
+    try {
+        if (!tracker) return 0;
+        return tracker->receiver.Start(port) ? 1 : 0;
+    } catch (...) {
+        return 0;
+    }
+}
+
+void cu_tracker_stop(cu_tracker* tracker) {
+    try {
+        if (tracker) tracker->receiver.Stop();
+    } catch (...) {
+    }
+}
+
+void cu_tracker_set_settings(cu_tracker* tracker, const cu_settings* settings) {
+    try {
+        if (!tracker || !settings) return;
+        HeadPoseProcessor& processor = tracker->processor;
+
+        cameraunlock::SensitivitySettings sensitivity;
+        sensitivity.yaw = settings->sensitivity_yaw;
+        sensitivity.pitch = settings->sensitivity_pitch;
+        sensitivity.roll = settings->sensitivity_roll;
+        sensitivity.invert_yaw = settings->invert_yaw != 0;
+        sensitivity.invert_pitch = settings->invert_pitch != 0;
+        sensitivity.invert_roll = settings->invert_roll != 0;
+        processor.SetSensitivity(sensitivity);
+        processor.SetDeadzone({settings->deadzone_yaw, settings->deadzone_pitch, settings->deadzone_roll});
+        processor.SetSmoothing(settings->smoothing);
+
+        processor.SetPositionEnabled(settings->position_enabled != 0);
+        processor.SetPositionSettings(cameraunlock::PositionSettings(
+            settings->position_sensitivity_x, settings->position_sensitivity_y, settings->position_sensitivity_z,
+            settings->position_limit_x, settings->position_limit_y, settings->position_limit_z,
+            settings->position_limit_z_back, settings->position_smoothing,
+            settings->invert_x != 0, settings->invert_y != 0, settings->invert_z != 0));
+        processor.SetTrackerPivotForward(settings->tracker_pivot_forward);
+        processor.SetInterpolationEnabled(settings->interpolation_enabled != 0);
+        processor.SetMaxExtrapolationFraction(settings->max_extrapolation_fraction);
+    } catch (...) {
+    }
+}
+
+int32_t cu_tracker_step(cu_tracker* tracker, float delta_time, cu_frame* out) {
+    try {
+        if (!out) return 0;
+        *out = cu_frame{};
+        if (!tracker) return 0;
+
+        TrackingSample sample;
+        if (!tracker->receiver.TryGetSample(sample)) sample = TrackingSample{};
+        const HeadPoseFrame frame = tracker->processor.Step(sample, delta_time);
+
+        out->receiver_flags = ReceiverFlags(tracker->receiver);
+        out->flags = frame.flags;
+        if (!sample.IsValid()) return 0;
+
+        out->sample_timestamp_us = sample.timestamp_us;
+        out->sample_age_us = cameraunlock::TrackingPose::CurrentTimestamp() - sample.timestamp_us;
+        out->sequence = sample.sequence;
+        out->rot_x = frame.rotation.x;
+        out->rot_y = frame.rotation.y;
+        out->rot_z = frame.rotation.z;
+        out->rot_w = frame.rotation.w;
+        out->yaw = frame.yaw;
+        out->pitch = frame.pitch;
+        out->roll = frame.roll;
+        out->pos_x = frame.position.x;
+        out->pos_y = frame.position.y;
+        out->pos_z = frame.position.z;
+        return frame.IsRotationValid() ? 1 : 0;
+    } catch (...) {
+        return 0;
+    }
+}
+
+int32_t cu_tracker_get_sample(const cu_tracker* tracker, cu_sample* out) {
+    try {
+        if (!out) return 0;
+        *out = cu_sample{};
+        TrackingSample sample;
+        if (!tracker || !tracker->receiver.TryGetSample(sample)) return 0;
+
+        out->timestamp_us = sample.timestamp_us;
+        out->sequence = sample.sequence;
+        out->yaw = sample.yaw;
+        out->pitch = sample.pitch;
+        out->roll = sample.roll;
+        out->x = sample.x;
+        out->y = sample.y;
+        out->z = sample.z;
+        return 1;
+    } catch (...) {
+        return 0;
+    }
+}
+
+void cu_tracker_recenter(cu_tracker* tracker) {
+    try {
+        if (tracker) tracker->processor.Recenter();
+    } catch (...) {
+    }
+}
+
+void cu_tracker_reset(cu_tracker* tracker) {
+    try {
+        if (tracker) tracker->processor.Reset();
+    } catch (...) {
+    }
+}
+
+}  // extern "C"
@@ -0,0 +1,422 @@
+#include "cameraunlock/config/config_watcher.h"
+#include "cameraunlock/runtime/runtime.h"
+
+#include <chrono>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/inotify.h>
+#endif
+#endif
+
+namespace cameraunlock {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+}  // namespace
+
+ConfigWatcher::~ConfigWatcher() {
+    Stop();
+}
+
+bool ConfigWatcher::Start(const std::string& path, ReloadCallback onReload, int debounceMs) {
+    if (!Prepare(path, std::move(onReload), debounceMs)) {
+        return false;
+    }
+
+    m_running.store(true, std::memory_order_release);
+    m_thread = std::thread(&ConfigWatcher::Run, this);
+    return true;
+}
+
+bool ConfigWatcher::Start(Runtime& runtime, const std::string& path, ReloadCallback onReload, int debounceMs) {
+    if (!Prepare(path, std::move(onReload), debounceMs)) {
+        return false;
+    }
+
+    bool registered = false;
+    m_runtime = &runtime;
+    runtime.Call([&]() {
+#ifdef _WIN32
+        if (ArmNotification()) {
+            m_runtimeSource = runtime.AddWaitHandle(m_changeEvent, [this]() { OnRuntimeEvent(); });
+        }
+#elif defined(__linux__)
+        m_runtimeSource = runtime.AddWaitHandle(m_notifyFd, [this]() { OnRuntimeEvent(); });
+#else
+        m_runtimeSource = runtime.AddTimer(kPollIntervalMs, kPollIntervalMs, [this]() { OnRuntimeEvent(); });
+#endif
+        registered = m_runtimeSource != 0;
+    });
+    if (!registered) {
+        LogError("ConfigWatcher: failed to register with the runtime");
+        m_runtime = nullptr;
+        CloseNotification();
+        return false;
+    }
+
+    m_running.store(true, std::memory_order_release);
+    return true;
+}
+
+bool ConfigWatcher::Prepare(const std::string& path, ReloadCallback onReload, int debounceMs) {
+    if (path.empty() || !onReload) {
+        LogError("ConfigWatcher::Start needs a path and a reload callback");
+        return false;
+    }
+    Stop();
+
+    m_path = path;
+    const size_t slash = path.find_last_of("/\\");
+    m_directory = slash == std::string::npos ? "." : path.substr(0, slash == 0 ? 1 : slash);
+    m_fileName = slash == std::string::npos ? path : path.substr(slash + 1);
+    m_debounceMs = debounceMs > 0 ? debounceMs : 0;
+    m_onReload = std::move(onReload);
+    m_reloadCount.store(0, std::memory_order_relaxed);
+
+    if (!OpenNotification()) {
+        LogError("ConfigWatcher: failed to watch the config directory");
+        CloseNotification();
+        return false;
+    }
+    return true;
+}
+
+void ConfigWatcher::Stop() {
+    if (m_runtime) {
+        Runtime* runtime = m_runtime;
+        runtime->Call([this, runtime]() {
+            runtime->Remove(m_runtimeSource);
+            runtime->Remove(m_debounceTimer);
+            m_runtimeSource = 0;
+            m_debounceTimer = 0;
+        });
+        m_runtime = nullptr;
+    }
+    if (m_thread.joinable()) {
+#ifdef _WIN32
+        SetEvent(m_stopEvent);
+#else
+        const char byte = 1;
+        ssize_t written = write(m_pipe[1], &byte, 1);
+        (void)written;
+#endif
+        m_thread.join();
+    }
+    CloseNotification();
+    m_running.store(false, std::memory_order_release);
+}
+
+void ConfigWatcher::OnRuntimeEvent() {
+    WaitResult result = ConsumeEvents();
+#ifdef _WIN32
+    if (result != WaitResult::Error && !ArmNotification()) {
+        result = WaitResult::Error;
+    }
+#endif
+    if (result == WaitResult::Error) {
+        LogError("ConfigWatcher: change notification failed, watcher stopped");
+        m_runtime->Remove(m_runtimeSource);
+        m_runtimeSource = 0;
+        m_running.store(false, std::memory_order_release);
+        return;
+    }
+    if (result != WaitResult::Changed) {
+        return;
+    }
+
+    // Every event in a save burst restarts the quiet period
+    m_runtime->Remove(m_debounceTimer);
+    m_debounceTimer = m_runtime->AddTimer(m_debounceMs, 0, [this]() {
+        m_debounceTimer = 0;
+        Reload();
+    });
+}
+
+void ConfigWatcher::Run() {
+    bool pending = false;
+    Clock::time_point deadline;
+
+    for (;;) {
+        int timeoutMs = -1;
+        if (pending) {
+            const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now());
+            timeoutMs = remaining.count() > 0 ? static_cast<int>(remaining.count()) : 0;
+        }
+
+        const WaitResult result = Wait(timeoutMs);
+        if (result == WaitResult::Stopped) {
+            break;
+        }
+        if (result == WaitResult::Error) {
+            LogError("ConfigWatcher: change notification failed, watcher stopped");
+            break;
+        }
+        if (result == WaitResult::Changed) {
+            // Every event in a save burst restarts the quiet period
+            pending = true;
+            deadline = Clock::now() + std::chrono::milliseconds(m_debounceMs);
+            continue;
+        }
+        if (pending && Clock::now() >= deadline) {
+            pending = false;
+            Reload();
+        }
+    }
+
+    m_running.store(false, std::memory_order_release);
+}
+
+void ConfigWatcher::Reload() {
+    IniReader ini;
+    ini.SetErrorCallback(m_errorCallback);
+    if (!ini.Open(m_path)) {
+        // Mid-rename or deleted; the write that restores it raises another event
+        LogError("ConfigWatcher: changed config could not be read");
+        return;
+    }
+    m_onReload(ini);
+    m_reloadCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ConfigWatcher::LogError(const char* message) const {
+    if (m_errorCallback) {
+        m_errorCallback(message);
+    }
+}
+
+#ifdef _WIN32
+
+bool ConfigWatcher::OpenNotification() {
+    const int wideLength = MultiByteToWideChar(CP_ACP, 0, m_fileName.c_str(), -1, nullptr, 0);
+    if (wideLength <= 0) {
+        return false;
+    }
+    m_fileNameWide.resize(static_cast<size_t>(wideLength));
+    MultiByteToWideChar(CP_ACP, 0, m_fileName.c_str(), -1, &m_fileNameWide[0], wideLength);
+    m_fileNameWide.resize(static_cast<size_t>(wideLength - 1));
+
+    m_directoryHandle = CreateFileA(
+        m_directory.c_str(),
+        FILE_LIST_DIRECTORY,
+        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED,
+        nullptr);
+    if (m_directoryHandle == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    m_changeEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+    m_stopEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+    return m_changeEvent && m_stopEvent;
+}
+
+void ConfigWatcher::CloseNotification() {
+    if (m_readPending) {
+        // The kernel writes into m_notifyBuffer until the read completes
+        DWORD bytes = 0;
+        CancelIoEx(m_directoryHandle, &m_overlapped);
+        GetOverlappedResult(m_directoryHandle, &m_overlapped, &bytes, TRUE);
+        m_readPending = false;
+    }
+    if (m_directoryHandle != INVALID_HANDLE_VALUE) {
+        CloseHandle(m_directoryHandle);
+        m_directoryHandle = INVALID_HANDLE_VALUE;
+    }
+    if (m_changeEvent) {
+        CloseHandle(m_changeEvent);
+        m_changeEvent = nullptr;
+    }
+    if (m_stopEvent) {
+        CloseHandle(m_stopEvent);
+        m_stopEvent = nullptr;
+    }
+}
+
+bool ConfigWatcher::ArmNotification() {
+    if (m_readPending) {
+        return true;
+    }
+    m_overlapped = {};
+    m_overlapped.hEvent = m_changeEvent;
+    ResetEvent(m_changeEvent);
+    // Saves by rename show up as name changes, in-place saves as writes
+    const DWORD filter = FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE;
+    if (!ReadDirectoryChangesW(m_directoryHandle, m_notifyBuffer, sizeof(m_notifyBuffer), FALSE,
+                               filter, nullptr, &m_overlapped, nullptr)) {
+        return false;
+    }
+    m_readPending = true;
+    return true;
+}
+
+ConfigWatcher::WaitResult ConfigWatcher::Wait(int timeoutMs) {
+    if (!ArmNotification()) {
+        return WaitResult::Error;
+    }
+
+    HANDLE handles[2] = {m_stopEvent, m_changeEvent};
+    const DWORD wait = WaitForMultipleObjects(2, handles, FALSE, timeoutMs < 0 ? INFINITE : static_cast<DWORD>(timeoutMs));
+    if (wait == WAIT_OBJECT_0) {
+        return WaitResult::Stopped;
+    }
+    if (wait == WAIT_TIMEOUT) {
+        return WaitResult::Timeout;
+    }
+    if (wait != WAIT_OBJECT_0 + 1) {
+        return WaitResult::Error;
+    }
+    return ConsumeEvents();
+}
+
+ConfigWatcher::WaitResult ConfigWatcher::ConsumeEvents() {
+    DWORD bytes = 0;
+    if (!m_readPending) {
+        return WaitResult::Timeout;
+    }
+    m_readPending = false;
+    if (!GetOverlappedResult(m_directoryHandle, &m_overlapped, &bytes, FALSE)) {
+        return WaitResult::Error;
+    }
+    if (bytes == 0) {
+        // Buffer overflowed: the events were dropped, assume ours was among them
+        return WaitResult::Changed;
+    }
+
+    bool matched = false;
+    for (DWORD offset = 0;;) {
+        const auto* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(m_notifyBuffer + offset);
+        const int length = static_cast<int>(info->FileNameLength / sizeof(WCHAR));
+        if (CompareStringOrdinal(info->FileName, length, m_fileNameWide.c_str(),
+                                 static_cast<int>(m_fileNameWide.size()), TRUE) == CSTR_EQUAL) {
+            matched = true;
+        }
+        if (info->NextEntryOffset == 0) break;
+        offset += info->NextEntryOffset;
+    }
+    // Other files in the directory keep the current timeout running
+    return matched ? WaitResult::Changed : WaitResult::Timeout;
+}
+
+#else
+
+bool ConfigWatcher::OpenNotification() {
+    if (pipe(m_pipe) != 0) {
+        m_pipe[0] = m_pipe[1] = -1;
+        return false;
+    }
+    fcntl(m_pipe[0], F_SETFL, O_NONBLOCK);
+    fcntl(m_pipe[1], F_SETFL, O_NONBLOCK);
+
+#if defined(__linux__)
+    m_notifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_notifyFd < 0) {
+        return false;
+    }
+    // Saves by rename arrive as IN_MOVED_TO, in-place saves as IN_CLOSE_WRITE
+    const uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_MODIFY;
+    return inotify_add_watch(m_notifyFd, m_directory.c_str(), mask) >= 0;
+#else
+    struct stat st;
+    if (stat(m_directory.c_str(), &st) != 0) {
+        return false;
+    }
+    m_lastModTime = stat(m_path.c_str(), &st) == 0 ? st.st_mtime : 0;
+    return true;
+#endif
+}
+
+void ConfigWatcher::CloseNotification() {
+    if (m_notifyFd >= 0) {
+        close(m_notifyFd);
+        m_notifyFd = -1;
+    }
+    for (int& fd : m_pipe) {
+        if (fd >= 0) {
+            close(fd);
+            fd = -1;
+        }
+    }
+}
+
+ConfigWatcher::WaitResult ConfigWatcher::Wait(int timeoutMs) {
+#if !defined(__linux__)
+    if (timeoutMs < 0 || timeoutMs > kPollIntervalMs) {
+        timeoutMs = kPollIntervalMs;
+    }
+#endif
+
+    pollfd fds[2] = {};
+    fds[0].fd = m_pipe[0];
+    fds[0].events = POLLIN;
+    fds[1].fd = m_notifyFd;
+    fds[1].events = POLLIN;
+    const nfds_t count = m_notifyFd >= 0 ? 2 : 1;
+
+    const int ready = poll(fds, count, timeoutMs);
+    if (ready < 0) {
+        return errno == EINTR ? WaitResult::Timeout : WaitResult::Error;
+    }
+    if (fds[0].revents != 0) {
+        return WaitResult::Stopped;
+    }
+
+#if defined(__linux__)
+    if (ready == 0) {
+        return WaitResult::Timeout;
+    }
+#endif
+    return ConsumeEvents();
+}
+
+bool ConfigWatcher::ArmNotification() {
+    return true;
+}
+
+ConfigWatcher::WaitResult ConfigWatcher::ConsumeEvents() {
+#if defined(__linux__)
+    bool matched = false;
+    alignas(inotify_event) char buffer[4096];
+    for (;;) {
+        const ssize_t bytes = read(m_notifyFd, buffer, sizeof(buffer));
+        if (bytes <= 0) {
+            if (bytes < 0 && errno != EAGAIN && errno != EINTR) {
+                return WaitResult::Error;
+            }
+            break;
+        }
+        for (ssize_t offset = 0; offset < bytes;) {
+            const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            if ((event->mask & IN_Q_OVERFLOW) ||
+                (event->len > 0 && m_fileName == event->name)) {
+                matched = true;
+            }
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+        }
+    }
+    // Other files in the directory keep the current timeout running
+    return matched ? WaitResult::Changed : WaitResult::Timeout;
+#else
+    struct stat st;
+    const time_t modTime = stat(m_path.c_str(), &st) == 0 ? st.st_mtime : 0;
+    if (modTime != 0 && modTime != m_lastModTime) {
+        m_lastModTime = modTime;
+        return WaitResult::Changed;
+    }
+    return WaitResult::Timeout;
+#endif
+}
+
+#endif
+
+}  // namespace cameraunlock
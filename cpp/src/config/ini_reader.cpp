@@ -1,5 +1,6 @@
 #include "cameraunlock/config/ini_reader.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 #include <cstdio>
@@ -11,7 +12,39 @@
 
 namespace cameraunlock {
 
-constexpr size_t kMaxIniValueLength = 1024;
+namespace {
+
+// Files larger than this aren't configs
+constexpr long kMaxIniFileSize = 4 * 1024 * 1024;
+
+// Numbers longer than this can't be valid, so they read as the default
+constexpr size_t kMaxNumberLength = 64;
+
+char LowerAscii(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+// Case-insensitive three-way compare, as the profile APIs match names
+int CompareNoCase(std::string_view a, std::string_view b) {
+    const size_t n = a.size() < b.size() ? a.size() : b.size();
+    for (size_t i = 0; i < n; ++i) {
+        const char ca = LowerAscii(a[i]);
+        const char cb = LowerAscii(b[i]);
+        if (ca != cb) return ca < cb ? -1 : 1;
+    }
+    if (a.size() == b.size()) return 0;
+    return a.size() < b.size() ? -1 : 1;
+}
+
+std::string_view Trim(std::string_view s) {
+    size_t begin = 0;
+    size_t end = s.size();
+    while (begin < end && std::isspace(static_cast<unsigned char>(s[begin]))) begin++;
+    while (end > begin && std::isspace(static_cast<unsigned char>(s[end - 1]))) end--;
+    return s.substr(begin, end - begin);
+}
+
+}  // namespace
 
 bool IniReader::Open(const std::string& path) {
     if (path.empty()) {
@@ -19,26 +52,27 @@ bool IniReader::Open(const std::string& path) {
         return false;
     }
 
-#ifdef _WIN32
-    // Check if file exists
-    DWORD attrs = GetFileAttributesA(path.c_str());
-    if (attrs == INVALID_FILE_ATTRIBUTES) {
+    if (!Load(path)) {
         return false;
     }
-#else
-    struct stat st;
-    if (stat(path.c_str(), &st) != 0) {
-        return false;
-    }
-#endif
 
     m_path = path;
-    RefreshModTime();
+    StampModTime();
+    return true;
+}
+
+bool IniReader::Reload() {
+    if (m_path.empty() || !Load(m_path)) {
+        return false;
+    }
+    StampModTime();
     return true;
 }
 
 void IniReader::Close() {
     m_path.clear();
+    m_text.clear();
+    m_entries.clear();
 #ifdef _WIN32
     m_lastModTime = {};
 #else
@@ -46,6 +80,101 @@ void IniReader::Close() {
 #endif
 }
 
+bool IniReader::Load(const std::string& path) {
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+
+    // One read of the whole file
+    std::vector<char> text;
+    bool ok = fseek(file, 0, SEEK_END) == 0;
+    const long size = ok ? ftell(file) : -1;
+    ok = ok && size >= 0 && size <= kMaxIniFileSize && fseek(file, 0, SEEK_SET) == 0;
+    if (ok) {
+        text.resize(static_cast<size_t>(size));
+        ok = fread(text.data(), 1, text.size(), file) == text.size();
+    }
+    fclose(file);
+
+    if (!ok) {
+        LogError("Failed to read INI file");
+        return false;
+    }
+
+    m_text = std::move(text);
+    Index();
+    return true;
+}
+
+void IniReader::Index() {
+    m_entries.clear();
+
+    std::string_view rest(m_text.data(), m_text.size());
+    // UTF-8 BOM
+    if (rest.size() >= 3 && rest.substr(0, 3) == "\xEF\xBB\xBF") {
+        rest.remove_prefix(3);
+    }
+
+    std::string_view section;
+    bool inSection = false;
+    while (!rest.empty()) {
+        const size_t eol = rest.find('\n');
+        std::string_view line = Trim(rest.substr(0, eol));
+        rest.remove_prefix(eol == std::string_view::npos ? rest.size() : eol + 1);
+
+        if (line.empty() || line[0] == ';') continue;
+
+        if (line[0] == '[') {
+            const size_t close = line.find(']');
+            section = Trim(line.substr(1, close == std::string_view::npos ? std::string_view::npos : close - 1));
+            inSection = true;
+            continue;
+        }
+
+        // Keys before the first section are unreachable through the profile API
+        const size_t eq = line.find('=');
+        if (!inSection || eq == std::string_view::npos) continue;
+
+        std::string_view key = Trim(line.substr(0, eq));
+        std::string_view value = Trim(line.substr(eq + 1));
+        if (key.empty()) continue;
+        if (value.size() >= 2 && (value.front() == '"' || value.front() == '\'') && value.back() == value.front()) {
+            value = value.substr(1, value.size() - 2);
+        }
+        m_entries.push_back({section, key, value});
+    }
+
+    // Stable, so the first occurrence of a duplicate key stays in front
+    std::stable_sort(m_entries.begin(), m_entries.end(), [](const Entry& a, const Entry& b) {
+        const int c = CompareNoCase(a.section, b.section);
+        return c != 0 ? c < 0 : CompareNoCase(a.key, b.key) < 0;
+    });
+}
+
+bool IniReader::CopyValue(const char* section, const char* key, char* out, size_t outSize) const {
+    const Entry* entry = (section && key) ? Find(section, key) : nullptr;
+    if (!entry || entry->value.empty() || entry->value.size() >= outSize) {
+        return false;
+    }
+    memcpy(out, entry->value.data(), entry->value.size());
+    out[entry->value.size()] = '\0';
+    return true;
+}
+
+const IniReader::Entry* IniReader::Find(std::string_view section, std::string_view key) const {
+    auto it = std::lower_bound(m_entries.begin(), m_entries.end(), Entry{section, key, {}},
+        [](const Entry& a, const Entry& b) {
+            const int c = CompareNoCase(a.section, b.section);
+            return c != 0 ? c < 0 : CompareNoCase(a.key, b.key) < 0;
+        });
+    if (it == m_entries.end() || CompareNoCase(it->section, section) != 0 ||
+        CompareNoCase(it->key, key) != 0) {
+        return nullptr;
+    }
+    return &*it;
+}
+
 bool IniReader::HasChanged() const {
     if (m_path.empty()) {
         return false;
@@ -84,6 +213,13 @@ bool IniReader::HasChanged() const {
 }
 
 void IniReader::RefreshModTime() {
+    // The long-standing hot-reload idiom is HasChanged() -> RefreshModTime()
+    // -> Read*(), so this re-reads the file as well. On a failed read the old
+    // contents and time stay, and HasChanged() keeps reporting the change.
+    Reload();
+}
+
+void IniReader::StampModTime() {
     if (m_path.empty()) {
         return;
     }
@@ -111,104 +247,21 @@ void IniReader::RefreshModTime() {
 }
 
 std::string IniReader::ReadString(const char* section, const char* key, const char* defaultValue) const {
-    if (m_path.empty()) {
-        return defaultValue;
+    const Entry* entry = (section && key) ? Find(section, key) : nullptr;
+    if (!entry) {
+        return defaultValue ? defaultValue : "";
     }
-
-#ifdef _WIN32
-    char buffer[kMaxIniValueLength];
-    DWORD result = GetPrivateProfileStringA(
-        section,
-        key,
-        defaultValue,
-        buffer,
-        sizeof(buffer),
-        m_path.c_str());
-
-    if (result == 0 && GetLastError() != ERROR_SUCCESS) {
-        return defaultValue;
-    }
-
-    return std::string(buffer);
-#else
-    // Simple INI parsing for non-Windows platforms
-    FILE* file = fopen(m_path.c_str(), "r");
-    if (!file) {
-        return defaultValue;
-    }
-
-    char line[kMaxIniValueLength];
-    bool inSection = false;
-    std::string sectionStr = std::string("[") + section + "]";
-    std::string keyStr = key;
-
-    while (fgets(line, sizeof(line), file)) {
-        // Trim whitespace
-        char* start = line;
-        while (*start && std::isspace(static_cast<unsigned char>(*start))) start++;
-
-        // Check for section
-        if (*start == '[') {
-            inSection = (strncmp(start, sectionStr.c_str(), sectionStr.length()) == 0);
-            continue;
-        }
-
-        if (!inSection) continue;
-
-        // Parse key=value
-        char* eq = strchr(start, '=');
-        if (!eq) continue;
-
-        // Extract key
-        *eq = '\0';
-        char* keyEnd = eq - 1;
-        while (keyEnd > start && std::isspace(static_cast<unsigned char>(*keyEnd))) *keyEnd-- = '\0';
-
-        if (strcmp(start, key) != 0) continue;
-
-        // Extract value
-        char* value = eq + 1;
-        while (*value && std::isspace(static_cast<unsigned char>(*value))) value++;
-
-        // Remove trailing whitespace and newline. Guard against empty value
-        // (e.g. "key="): stepping back from value would compute `value - 1`,
-        // which is undefined pointer arithmetic before the start of the buffer.
-        size_t valueLen = strlen(value);
-        if (valueLen > 0) {
-            char* valueEnd = value + valueLen - 1;
-            while (valueEnd >= value && (std::isspace(static_cast<unsigned char>(*valueEnd))
-                                         || *valueEnd == '\n' || *valueEnd == '\r')) {
-                *valueEnd = '\0';
-                if (valueEnd == value) break;
-                --valueEnd;
-            }
-        }
-
-        fclose(file);
-        return std::string(value);
-    }
-
-    fclose(file);
-    return defaultValue;
-#endif
+    return std::string(entry->value);
 }
 
 int IniReader::ReadInt(const char* section, const char* key, int defaultValue) const {
-    if (m_path.empty()) {
-        return defaultValue;
-    }
-
-#ifdef _WIN32
-    return GetPrivateProfileIntA(section, key, defaultValue, m_path.c_str());
-#else
-    std::string str = ReadString(section, key, "");
-    if (str.empty()) return defaultValue;
+    char str[kMaxNumberLength];
+    if (!CopyValue(section, key, str, sizeof(str))) return defaultValue;
 
     char* end;
-    long value = strtol(str.c_str(), &end, 10);
-    if (end == str.c_str()) return defaultValue;
+    long value = strtol(str, &end, 10);
+    if (end == str) return defaultValue;
     return static_cast<int>(value);
-#endif
 }
 
 unsigned int IniReader::ReadUInt(const char* section, const char* key, unsigned int defaultValue) const {
@@ -217,22 +270,22 @@ unsigned int IniReader::ReadUInt(const char* section, const char* key, unsigned
 }
 
 int64_t IniReader::ReadInt64(const char* section, const char* key, int64_t defaultValue) const {
-    std::string str = ReadString(section, key, "");
-    if (str.empty()) return defaultValue;
+    char str[kMaxNumberLength];
+    if (!CopyValue(section, key, str, sizeof(str))) return defaultValue;
 
     char* end;
-    int64_t value = strtoll(str.c_str(), &end, 10);
-    if (end == str.c_str()) return defaultValue;
+    int64_t value = strtoll(str, &end, 10);
+    if (end == str) return defaultValue;
     return value;
 }
 
 double IniReader::ReadDouble(const char* section, const char* key, double defaultValue) const {
-    std::string str = ReadString(section, key, "");
-    if (str.empty()) return defaultValue;
+    char str[kMaxNumberLength];
+    if (!CopyValue(section, key, str, sizeof(str))) return defaultValue;
 
     char* end;
-    double value = strtod(str.c_str(), &end);
-    if (end == str.c_str()) return defaultValue;
+    double value = strtod(str, &end);
+    if (end == str) return defaultValue;
     return value;
 }
 
@@ -241,8 +294,9 @@ float IniReader::ReadFloat(const char* section, const char* key, float defaultVa
 }
 
 bool IniReader::ReadBool(const char* section, const char* key, bool defaultValue) const {
-    std::string str = ReadString(section, key, "");
-    if (str.empty()) return defaultValue;
+    const Entry* entry = (section && key) ? Find(section, key) : nullptr;
+    if (!entry || entry->value.empty()) return defaultValue;
+    const std::string_view str = entry->value;
 
     // Handle various boolean representations
     if (str == "1" || str == "true" || str == "True" || str == "TRUE" ||
@@ -258,12 +312,12 @@ bool IniReader::ReadBool(const char* section, const char* key, bool defaultValue
 }
 
 int IniReader::ReadHex(const char* section, const char* key, int defaultValue) const {
-    std::string str = ReadString(section, key, "");
-    if (str.empty()) return defaultValue;
+    char str[kMaxNumberLength];
+    if (!CopyValue(section, key, str, sizeof(str))) return defaultValue;
 
     // Skip "0x" or "0X" prefix if present
-    const char* start = str.c_str();
-    if (str.length() >= 2 && str[0] == '0' && (str[1] == 'x' || str[1] == 'X')) {
+    const char* start = str;
+    if (str[0] == '0' && (str[1] == 'x' || str[1] == 'X')) {
         start += 2;
     }
 
@@ -28,6 +28,80 @@ void TrackingData::Reset() {
     has_data.store(false, std::memory_order_release);
 }
 
+// SharedTrackingSample implementation
+void SharedTrackingSample::Slot::Store(const TrackingSample& s) {
+    yaw.store(s.yaw, std::memory_order_relaxed);
+    pitch.store(s.pitch, std::memory_order_relaxed);
+    roll.store(s.roll, std::memory_order_relaxed);
+    x.store(s.x, std::memory_order_relaxed);
+    y.store(s.y, std::memory_order_relaxed);
+    z.store(s.z, std::memory_order_relaxed);
+    timestamp_us.store(s.timestamp_us, std::memory_order_relaxed);
+    sequence.store(s.sequence, std::memory_order_relaxed);
+    source_us.store(s.source_us, std::memory_order_relaxed);
+    center_yaw.store(s.center_yaw, std::memory_order_relaxed);
+    center_pitch.store(s.center_pitch, std::memory_order_relaxed);
+    center_roll.store(s.center_roll, std::memory_order_relaxed);
+}
+
+void SharedTrackingSample::Slot::Load(TrackingSample& s) const {
+    s.yaw = yaw.load(std::memory_order_relaxed);
+    s.pitch = pitch.load(std::memory_order_relaxed);
+    s.roll = roll.load(std::memory_order_relaxed);
+    s.x = x.load(std::memory_order_relaxed);
+    s.y = y.load(std::memory_order_relaxed);
+    s.z = z.load(std::memory_order_relaxed);
+    s.timestamp_us = timestamp_us.load(std::memory_order_relaxed);
+    s.sequence = sequence.load(std::memory_order_relaxed);
+    s.source_us = source_us.load(std::memory_order_relaxed);
+    s.center_yaw = center_yaw.load(std::memory_order_relaxed);
+    s.center_pitch = center_pitch.load(std::memory_order_relaxed);
+    s.center_roll = center_roll.load(std::memory_order_relaxed);
+}
+
+void SharedTrackingSample::Write(const TrackingSample& sample) {
+    // Odd latch: readers use slot 1 while slot 0 is rewritten.
+    uint32_t latch = m_latch.load(std::memory_order_relaxed);
+    m_latch.store(latch + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    m_slots[0].Store(sample);
+
+    // Even latch: readers use slot 0 while slot 1 catches up.
+    m_latch.store(latch + 2, std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_release);
+    m_slots[1].Store(sample);
+}
+
+void SharedTrackingSample::Publish(const TrackingSample& sample) {
+    TrackingSample s = sample;
+    s.sequence = m_published.load(std::memory_order_relaxed) + 1;
+    Write(s);
+    m_published.store(s.sequence, std::memory_order_release);
+}
+
+bool SharedTrackingSample::TryGet(TrackingSample& out) const {
+    // A retry only happens when a whole Publish completes inside one read,
+    // and the writer's critical section is a dozen stores, so this settles
+    // within a few attempts. Giving up instead would report "no data" for a
+    // sample that exists.
+    for (;;) {
+        uint32_t latch = m_latch.load(std::memory_order_acquire);
+        TrackingSample s;
+        m_slots[latch & 1u].Load(s);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (m_latch.load(std::memory_order_relaxed) == latch) {
+            if (s.sequence == 0) return false;
+            out = s;
+            return true;
+        }
+    }
+}
+
+void SharedTrackingSample::Reset() {
+    Write(TrackingSample{});
+    m_published.store(0, std::memory_order_release);
+}
+
 // TrackingPose implementation
 TrackingPose::TrackingPose(float y, float p, float r)
     : yaw(y), pitch(p), roll(r), timestamp_us(CurrentTimestamp()) {}
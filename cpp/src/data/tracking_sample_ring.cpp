@@ -0,0 +1,87 @@
+#include "cameraunlock/data/tracking_sample_ring.h"
+
+namespace cameraunlock {
+
+void TrackingSampleRing::Push(const TrackingSample& sample) {
+    uint64_t index = m_head.load(std::memory_order_relaxed) + 1;
+    Slot& slot = m_slots[index % kCapacity];
+
+    slot.version.store(index * 2 - 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.yaw.store(sample.yaw, std::memory_order_relaxed);
+    slot.pitch.store(sample.pitch, std::memory_order_relaxed);
+    slot.roll.store(sample.roll, std::memory_order_relaxed);
+    slot.x.store(sample.x, std::memory_order_relaxed);
+    slot.y.store(sample.y, std::memory_order_relaxed);
+    slot.z.store(sample.z, std::memory_order_relaxed);
+    slot.timestamp_us.store(sample.timestamp_us, std::memory_order_relaxed);
+    slot.sequence.store(sample.sequence, std::memory_order_relaxed);
+    slot.source_us.store(sample.source_us, std::memory_order_relaxed);
+    slot.center_yaw.store(sample.center_yaw, std::memory_order_relaxed);
+    slot.center_pitch.store(sample.center_pitch, std::memory_order_relaxed);
+    slot.center_roll.store(sample.center_roll, std::memory_order_relaxed);
+
+    slot.version.store(index * 2, std::memory_order_release);
+    m_head.store(index, std::memory_order_release);
+}
+
+bool TrackingSampleRing::TryRead(uint64_t index, TrackingSample& out) const {
+    const Slot& slot = m_slots[index % kCapacity];
+
+    const uint64_t expected = index * 2;
+    if (slot.version.load(std::memory_order_acquire) != expected) {
+        return false;  // Overwritten by a later push (or being overwritten)
+    }
+
+    out.yaw = slot.yaw.load(std::memory_order_relaxed);
+    out.pitch = slot.pitch.load(std::memory_order_relaxed);
+    out.roll = slot.roll.load(std::memory_order_relaxed);
+    out.x = slot.x.load(std::memory_order_relaxed);
+    out.y = slot.y.load(std::memory_order_relaxed);
+    out.z = slot.z.load(std::memory_order_relaxed);
+    out.timestamp_us = slot.timestamp_us.load(std::memory_order_relaxed);
+    out.sequence = slot.sequence.load(std::memory_order_relaxed);
+    out.source_us = slot.source_us.load(std::memory_order_relaxed);
+    out.center_yaw = slot.center_yaw.load(std::memory_order_relaxed);
+    out.center_pitch = slot.center_pitch.load(std::memory_order_relaxed);
+    out.center_roll = slot.center_roll.load(std::memory_order_relaxed);
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot.version.load(std::memory_order_relaxed) == expected;
+}
+
+size_t TrackingSampleRing::ReadSince(uint64_t& cursor, TrackingSample* out, size_t maxCount) const {
+    const uint64_t head = m_head.load(std::memory_order_acquire);
+    if (head < cursor) {
+        cursor = 0;  // Ring was reset underneath this consumer
+    }
+    if (head == cursor || maxCount == 0) {
+        return 0;
+    }
+
+    uint64_t first = cursor + 1;
+    const uint64_t window = maxCount < kCapacity ? maxCount : kCapacity;
+    if (head - first + 1 > window) {
+        first = head - window + 1;
+    }
+
+    size_t count = 0;
+    for (uint64_t index = first; index <= head; ++index) {
+        if (TryRead(index, out[count])) {
+            ++count;
+        }
+    }
+
+    cursor = head;
+    return count;
+}
+
+void TrackingSampleRing::Reset() {
+    m_head.store(0, std::memory_order_release);
+    for (Slot& slot : m_slots) {
+        slot.version.store(0, std::memory_order_relaxed);
+    }
+}
+
+}  // namespace cameraunlock
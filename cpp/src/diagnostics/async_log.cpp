@@ -0,0 +1,511 @@
+#include "cameraunlock/diagnostics/async_log.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cameraunlock {
+
+namespace async_log_detail {
+
+enum class ArgType : uint8_t { Signed, Unsigned, Double, Pointer, String };
+
+union ArgValue {
+    long long i;
+    unsigned long long u;
+    double d;
+    const void* p;
+    size_t offset;  // Into Record::strings
+};
+
+struct Record {
+    LogWriteFn write;
+    void* context;
+    const char* format;
+    int level;
+    uint32_t suppressed;  // Lines this site held back before this one
+    uint32_t dropped;     // Records this ring lost before this one
+    uint32_t argCount;
+    size_t stringUsed;
+    ArgType types[AsyncLog::kMaxArgs];
+    ArgValue values[AsyncLog::kMaxArgs];
+    char strings[AsyncLog::kStringBytes];
+};
+
+}  // namespace async_log_detail
+
+namespace {
+
+using async_log_detail::ArgType;
+using async_log_detail::ArgValue;
+using async_log_detail::Record;
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t kSiteSlots = 64;
+constexpr size_t kSiteProbes = 8;
+
+struct Site {
+    const char* format = nullptr;
+    int64_t windowStartMs = 0;
+    uint32_t count = 0;
+    uint32_t suppressed = 0;
+};
+
+// Single producer (the owning thread), single consumer (whoever holds the
+// drain lock)
+struct Ring {
+    Record slots[AsyncLog::kRingCapacity];
+    alignas(64) std::atomic<uint64_t> head{0};
+    alignas(64) std::atomic<uint64_t> tail{0};
+    std::atomic<bool> abandoned{false};
+
+    // Producer only
+    Site sites[kSiteSlots];
+    uint32_t pendingDrops = 0;
+};
+
+struct State {
+    std::mutex ringsMutex;
+    std::vector<Ring*> rings;
+    bool threadStarted = false;
+    std::thread thread;
+
+    std::mutex drainMutex;  // Held by the one thread draining
+
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    bool wakePending = false;
+    bool stop = false;
+    std::atomic<bool> sleeping{false};
+    std::atomic<bool> shutdown{false};
+
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> suppressed{0};
+};
+
+// Never destroyed: threads may log during static destruction or unload
+State& GetState() {
+    static State* state = new State;
+    return *state;
+}
+
+struct ThreadRing {
+    Ring* ring = nullptr;
+    ~ThreadRing() {
+        // The drain thread frees it once empty
+        if (ring) ring->abandoned.store(true, std::memory_order_release);
+    }
+};
+
+thread_local ThreadRing t_ring;
+thread_local bool t_draining = false;
+
+void DrainLoop();
+
+Ring* CurrentRing() {
+    if (t_ring.ring) {
+        return t_ring.ring;
+    }
+    Ring* ring = new Ring;
+    State& state = GetState();
+    std::lock_guard<std::mutex> lock(state.ringsMutex);
+    state.rings.push_back(ring);
+    if (!state.threadStarted && !state.shutdown.load(std::memory_order_acquire)) {
+        state.threadStarted = true;
+        state.thread = std::thread(DrainLoop);
+    }
+    t_ring.ring = ring;
+    return ring;
+}
+
+int64_t NowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now().time_since_epoch()).count();
+}
+
+// Returns the site's count of held-back lines if this line may go out, or
+// -1 if it is rate limited
+int64_t AdmitSite(Ring& ring, const char* format) {
+    const size_t start = (reinterpret_cast<uintptr_t>(format) >> 3) % kSiteSlots;
+    for (size_t probe = 0; probe < kSiteProbes; ++probe) {
+        Site& site = ring.sites[(start + probe) % kSiteSlots];
+        if (site.format != format && site.format != nullptr) continue;
+
+        const int64_t now = NowMs();
+        if (site.format == nullptr) {
+            site.format = format;
+            site.windowStartMs = now;
+        } else if (now - site.windowStartMs >= AsyncLog::kSiteWindowMs) {
+            site.windowStartMs = now;
+            site.count = 0;
+        }
+        if (site.count >= AsyncLog::kSiteBurst) {
+            ++site.suppressed;
+            GetState().suppressed.fetch_add(1, std::memory_order_relaxed);
+            return -1;
+        }
+        ++site.count;
+        const uint32_t held = site.suppressed;
+        site.suppressed = 0;
+        return held;
+    }
+    // Table crowded around this slot: let it through unlimited
+    return 0;
+}
+
+// --- Formatting (drain side) ---
+
+long long AsSigned(const Record& r, uint32_t i) {
+    switch (r.types[i]) {
+    case ArgType::Signed: return r.values[i].i;
+    case ArgType::Unsigned: return static_cast<long long>(r.values[i].u);
+    case ArgType::Double: return static_cast<long long>(r.values[i].d);
+    case ArgType::Pointer: return static_cast<long long>(reinterpret_cast<uintptr_t>(r.values[i].p));
+    default: return 0;
+    }
+}
+
+unsigned long long AsUnsigned(const Record& r, uint32_t i) {
+    return r.types[i] == ArgType::Unsigned ? r.values[i].u : static_cast<unsigned long long>(AsSigned(r, i));
+}
+
+double AsDouble(const Record& r, uint32_t i) {
+    switch (r.types[i]) {
+    case ArgType::Double: return r.values[i].d;
+    case ArgType::Unsigned: return static_cast<double>(r.values[i].u);
+    default: return static_cast<double>(AsSigned(r, i));
+    }
+}
+
+const void* AsPointer(const Record& r, uint32_t i) {
+    if (r.types[i] == ArgType::Pointer) return r.values[i].p;
+    return reinterpret_cast<const void*>(static_cast<uintptr_t>(AsUnsigned(r, i)));
+}
+
+const char* AsString(const Record& r, uint32_t i) {
+    if (r.types[i] != ArgType::String) return "(not a string)";
+    return r.values[i].offset == SIZE_MAX ? "(null)" : r.strings + r.values[i].offset;
+}
+
+template <typename V>
+int PrintOne(char* out, size_t cap, const char* spec, const int* stars, int starCount, V value) {
+    switch (starCount) {
+    case 0: return snprintf(out, cap, spec, value);
+    case 1: return snprintf(out, cap, spec, stars[0], value);
+    default: return snprintf(out, cap, spec, stars[0], stars[1], value);
+    }
+}
+
+void Append(size_t size, size_t& pos, int written) {
+    if (written > 0) {
+        pos = std::min(pos + static_cast<size_t>(written), size - 1);
+    }
+}
+
+size_t Render(const Record& r, char* out, size_t size) {
+    size_t pos = 0;
+    uint32_t arg = 0;
+    const char* f = r.format;
+
+    while (*f && pos + 1 < size) {
+        if (*f != '%') {
+            out[pos++] = *f++;
+            continue;
+        }
+        if (f[1] == '%') {
+            out[pos++] = '%';
+            f += 2;
+            continue;
+        }
+
+        // Rebuild the spec with our own length modifier
+        char spec[32];
+        size_t n = 0;
+        int stars[2] = {0, 0};
+        int starCount = 0;
+        bool missing = false;
+        spec[n++] = *f++;
+        while (*f && std::strchr("-+ #0", *f) && n < 20) spec[n++] = *f++;
+        if (*f == '*') {
+            if (arg < r.argCount) stars[starCount++] = static_cast<int>(AsSigned(r, arg++));
+            else missing = true;
+            spec[n++] = *f++;
+        }
+        while (*f >= '0' && *f <= '9' && n < 24) spec[n++] = *f++;
+        if (*f == '.') {
+            spec[n++] = *f++;
+            if (*f == '*') {
+                if (arg < r.argCount) stars[starCount++] = static_cast<int>(AsSigned(r, arg++));
+                else missing = true;
+                spec[n++] = *f++;
+            }
+            while (*f >= '0' && *f <= '9' && n < 28) spec[n++] = *f++;
+        }
+        while (*f && std::strchr("hlLqjzt", *f)) ++f;
+        const char conv = *f;
+        if (!conv) break;
+        ++f;
+        if (missing || arg >= r.argCount || std::strchr("diuoxXcfFeEgGaAps", conv) == nullptr) {
+            continue;  // Missing argument or unsupported (%n): print nothing
+        }
+
+        char* dst = out + pos;
+        const size_t cap = size - pos;
+        if (std::strchr("diuoxX", conv)) {
+            spec[n++] = 'l';
+            spec[n++] = 'l';
+        }
+        spec[n++] = conv;
+        spec[n] = 0;
+
+        switch (conv) {
+        case 'd': case 'i':
+            Append(size, pos, PrintOne(dst, cap, spec, stars, starCount, AsSigned(r, arg)));
+            break;
+        case 'u': case 'o': case 'x': case 'X':
+            Append(size, pos, PrintOne(dst, cap, spec, stars, starCount, AsUnsigned(r, arg)));
+            break;
+        case 'c':
+            Append(size, pos, PrintOne(dst, cap, spec, stars, starCount, static_cast<int>(AsSigned(r, arg))));
+            break;
+        case 'p':
+            Append(size, pos, PrintOne(dst, cap, spec, stars, starCount, AsPointer(r, arg)));
+            break;
+        case 's':
+            Append(size, pos, PrintOne(dst, cap, spec, stars, starCount, AsString(r, arg)));
+            break;
+        default:
+            Append(size, pos, PrintOne(dst, cap, spec, stars, starCount, AsDouble(r, arg)));
+            break;
+        }
+        ++arg;
+    }
+
+    if (r.suppressed > 0) {
+        Append(size, pos, snprintf(out + pos, size - pos, " [%u similar suppressed]", r.suppressed));
+    }
+    if (r.dropped > 0) {
+        Append(size, pos, snprintf(out + pos, size - pos, " [%u earlier lines dropped]", r.dropped));
+    }
+    out[pos] = 0;
+    return pos;
+}
+
+// Caller holds drainMutex. Returns true if anything was written.
+bool DrainAll() {
+    State& state = GetState();
+    std::vector<Ring*> rings;
+    {
+        std::lock_guard<std::mutex> lock(state.ringsMutex);
+        rings = state.rings;
+    }
+
+    const bool wasDraining = t_draining;
+    t_draining = true;
+    bool any = false;
+    char line[AsyncLog::kMaxMessageLength];
+    for (Ring* ring : rings) {
+        uint64_t head = ring->head.load(std::memory_order_relaxed);
+        const uint64_t tail = ring->tail.load(std::memory_order_acquire);
+        for (; head != tail; ++head) {
+            const Record& record = ring->slots[head % AsyncLog::kRingCapacity];
+            Render(record, line, sizeof(line));
+            record.write(record.context, record.level, line);
+            any = true;
+        }
+        ring->head.store(head, std::memory_order_release);
+    }
+    t_draining = wasDraining;
+
+    // An exited thread's ring can go once it is empty
+    std::lock_guard<std::mutex> lock(state.ringsMutex);
+    for (auto it = state.rings.begin(); it != state.rings.end();) {
+        Ring* ring = *it;
+        if (ring->abandoned.load(std::memory_order_acquire) &&
+            ring->head.load(std::memory_order_relaxed) == ring->tail.load(std::memory_order_acquire)) {
+            it = state.rings.erase(it);
+            delete ring;
+        } else {
+            ++it;
+        }
+    }
+    return any;
+}
+
+bool AnyPending() {
+    State& state = GetState();
+    std::lock_guard<std::mutex> lock(state.ringsMutex);
+    for (Ring* ring : state.rings) {
+        if (ring->head.load(std::memory_order_relaxed) != ring->tail.load(std::memory_order_seq_cst)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void DrainLoop() {
+    State& state = GetState();
+    t_draining = true;
+    for (;;) {
+        {
+            std::lock_guard<std::mutex> lock(state.drainMutex);
+            DrainAll();
+        }
+
+        std::unique_lock<std::mutex> lock(state.wakeMutex);
+        if (state.stop) break;
+        // Paired with the producer's tail store then sleeping load: either
+        // we see its record here or it sees us asleep and wakes us
+        state.sleeping.store(true, std::memory_order_seq_cst);
+        if (!AnyPending()) {
+            state.wake.wait(lock, [&] { return state.wakePending || state.stop; });
+        }
+        state.wakePending = false;
+        state.sleeping.store(false, std::memory_order_relaxed);
+    }
+
+    std::lock_guard<std::mutex> lock(state.drainMutex);
+    DrainAll();
+}
+
+}  // namespace
+
+namespace async_log_detail {
+
+Record* Begin(LogWriteFn write, void* context, int level, const char* format) {
+    Ring* ring = CurrentRing();
+
+    const int64_t held = AdmitSite(*ring, format);
+    if (held < 0) {
+        return nullptr;
+    }
+
+    const uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+    if (tail - ring->head.load(std::memory_order_acquire) >= AsyncLog::kRingCapacity) {
+        ++ring->pendingDrops;
+        GetState().dropped.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    Record* record = &ring->slots[tail % AsyncLog::kRingCapacity];
+    record->write = write;
+    record->context = context;
+    record->format = format;
+    record->level = level;
+    record->suppressed = static_cast<uint32_t>(held);
+    record->dropped = ring->pendingDrops;
+    record->argCount = 0;
+    record->stringUsed = 0;
+    ring->pendingDrops = 0;
+    return record;
+}
+
+void Commit(Record*) {
+    Ring* ring = t_ring.ring;
+    State& state = GetState();
+    ring->tail.fetch_add(1, std::memory_order_seq_cst);
+
+    if (state.shutdown.load(std::memory_order_acquire)) {
+        AsyncLog::Flush();
+        return;
+    }
+    if (state.sleeping.load(std::memory_order_seq_cst)) {
+        {
+            std::lock_guard<std::mutex> lock(state.wakeMutex);
+            state.wakePending = true;
+        }
+        state.wake.notify_one();
+    }
+}
+
+void PutSigned(Record& record, long long value) {
+    if (record.argCount >= AsyncLog::kMaxArgs) return;
+    record.types[record.argCount] = ArgType::Signed;
+    record.values[record.argCount++].i = value;
+}
+
+void PutUnsigned(Record& record, unsigned long long value) {
+    if (record.argCount >= AsyncLog::kMaxArgs) return;
+    record.types[record.argCount] = ArgType::Unsigned;
+    record.values[record.argCount++].u = value;
+}
+
+void PutDouble(Record& record, double value) {
+    if (record.argCount >= AsyncLog::kMaxArgs) return;
+    record.types[record.argCount] = ArgType::Double;
+    record.values[record.argCount++].d = value;
+}
+
+void PutPointer(Record& record, const void* value) {
+    if (record.argCount >= AsyncLog::kMaxArgs) return;
+    record.types[record.argCount] = ArgType::Pointer;
+    record.values[record.argCount++].p = value;
+}
+
+void PutString(Record& record, const char* value) {
+    if (record.argCount >= AsyncLog::kMaxArgs) return;
+    record.types[record.argCount] = ArgType::String;
+    ArgValue& slot = record.values[record.argCount++];
+    if (!value) {
+        slot.offset = SIZE_MAX;
+        return;
+    }
+    // Strings share the record's buffer; later ones are truncated first
+    const size_t room = AsyncLog::kStringBytes - record.stringUsed;
+    if (room == 0) {
+        slot.offset = AsyncLog::kStringBytes - 1;  // The previous terminator
+        return;
+    }
+    const size_t length = strnlen(value, room - 1);
+    slot.offset = record.stringUsed;
+    std::memcpy(record.strings + record.stringUsed, value, length);
+    record.strings[record.stringUsed + length] = 0;
+    record.stringUsed += length + 1;
+}
+
+}  // namespace async_log_detail
+
+void AsyncLog::Flush() {
+    if (t_draining) return;
+    std::lock_guard<std::mutex> lock(GetState().drainMutex);
+    DrainAll();
+}
+
+void AsyncLog::Shutdown() {
+    State& state = GetState();
+    state.shutdown.store(true, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(state.wakeMutex);
+        state.stop = true;
+    }
+    state.wake.notify_one();
+
+    std::thread thread;
+    {
+        std::lock_guard<std::mutex> lock(state.ringsMutex);
+        thread.swap(state.thread);
+    }
+    if (thread.joinable()) {
+        if (thread.get_id() == std::this_thread::get_id()) {
+            thread.detach();  // Called from a sink; the loop exits on return
+        } else {
+            thread.join();
+        }
+    }
+    Flush();
+}
+
+uint64_t AsyncLog::GetDroppedCount() {
+    return GetState().dropped.load(std::memory_order_relaxed);
+}
+
+uint64_t AsyncLog::GetSuppressedCount() {
+    return GetState().suppressed.load(std::memory_order_relaxed);
+}
+
+}  // namespace cameraunlock
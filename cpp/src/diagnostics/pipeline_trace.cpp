@@ -0,0 +1,216 @@
+#include "cameraunlock/diagnostics/pipeline_trace.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+#ifdef _WIN32
+#include <Windows.h>
+#include <TraceLoggingProvider.h>
+
+// {7C5A0F3E-2B1D-4E8A-9F61-3D2C8B4A5E17}
+TRACELOGGING_DEFINE_PROVIDER(g_cameraunlockPipelineProvider, "CameraUnlock.Pipeline",
+    (0x7c5a0f3e, 0x2b1d, 0x4e8a, 0x9f, 0x61, 0x3d, 0x2c, 0x8b, 0x4a, 0x5e, 0x17));
+#endif
+
+namespace cameraunlock {
+
+namespace {
+
+constexpr size_t kArrival = static_cast<size_t>(TraceStage::Arrival);
+constexpr size_t kPublish = static_cast<size_t>(TraceStage::Publish);
+constexpr size_t kProcessBegin = static_cast<size_t>(TraceStage::ProcessBegin);
+constexpr size_t kProcessEnd = static_cast<size_t>(TraceStage::ProcessEnd);
+constexpr size_t kPresent = static_cast<size_t>(TraceStage::Present);
+
+// Start and end stage of each span, in TraceSpan order
+constexpr size_t kSpanStages[PipelineTraceSummary::kSpanCount][2] = {
+    {kArrival, kPublish},
+    {kPublish, kProcessBegin},
+    {kProcessBegin, kProcessEnd},
+    {kProcessEnd, kPresent},
+    {kArrival, kPresent},
+};
+
+constexpr const char* kSpanNames[PipelineTraceSummary::kSpanCount] = {
+    "receive", "wait", "process", "present", "total"
+};
+
+TraceSpanStats SummarizeSpan(std::vector<int64_t>& values) {
+    TraceSpanStats stats;
+    if (values.empty()) return stats;
+    std::sort(values.begin(), values.end());
+    auto at = [&](double q) {
+        size_t i = static_cast<size_t>(q * static_cast<double>(values.size()));
+        return static_cast<double>(values[std::min(i, values.size() - 1)]);
+    };
+    stats.count = values.size();
+    stats.p50Us = at(0.50);
+    stats.p90Us = at(0.90);
+    stats.p99Us = at(0.99);
+    stats.maxUs = static_cast<double>(values.back());
+    double sum = 0.0;
+    for (int64_t v : values) sum += static_cast<double>(v);
+    stats.meanUs = sum / static_cast<double>(values.size());
+    return stats;
+}
+
+#ifdef _WIN32
+// Registered on first use, unregistered when the module unloads
+struct EtwRegistration {
+    bool registered = false;
+    EtwRegistration() { registered = SUCCEEDED(TraceLoggingRegister(g_cameraunlockPipelineProvider)); }
+    ~EtwRegistration() {
+        if (registered) TraceLoggingUnregister(g_cameraunlockPipelineProvider);
+    }
+};
+
+bool EtwRegistered() {
+    static EtwRegistration registration;
+    return registration.registered;
+}
+#endif
+
+}  // namespace
+
+void PipelineTrace::BeginSample(uint64_t sampleId, int64_t arrivalUs, int64_t publishUs) {
+    if (sampleId == 0) return;
+    Slot& slot = m_slots[sampleId % kCapacity];
+    // Close the slot to readers while its stamps are replaced
+    slot.id.store(0, std::memory_order_release);
+    slot.us[kArrival].store(arrivalUs, std::memory_order_relaxed);
+    slot.us[kPublish].store(publishUs, std::memory_order_relaxed);
+    for (size_t i = kProcessBegin; i < kStageCount; ++i) {
+        slot.us[i].store(0, std::memory_order_relaxed);
+    }
+    slot.id.store(sampleId, std::memory_order_release);
+}
+
+void PipelineTrace::Mark(uint64_t sampleId, TraceStage stage, int64_t us) {
+    if (sampleId == 0 || stage >= TraceStage::Count) return;
+    Slot& slot = m_slots[sampleId % kCapacity];
+    if (slot.id.load(std::memory_order_acquire) != sampleId) return;
+    int64_t empty = 0;
+    slot.us[static_cast<size_t>(stage)].compare_exchange_strong(empty, us, std::memory_order_relaxed);
+}
+
+void PipelineTrace::MarkProcessed(uint64_t sampleId, int64_t beginUs, int64_t endUs) {
+    Mark(sampleId, TraceStage::ProcessBegin, beginUs);
+    Mark(sampleId, TraceStage::ProcessEnd, endUs);
+    m_lastProcessed.store(sampleId, std::memory_order_release);
+}
+
+void PipelineTrace::MarkPresent(int64_t presentUs) {
+    const uint64_t sampleId = m_lastProcessed.load(std::memory_order_acquire);
+    if (sampleId == 0) return;
+    Slot& slot = m_slots[sampleId % kCapacity];
+    if (slot.id.load(std::memory_order_acquire) != sampleId) return;
+    int64_t empty = 0;
+    if (slot.us[kPresent].compare_exchange_strong(empty, presentUs, std::memory_order_relaxed) &&
+        m_etw.load(std::memory_order_relaxed)) {
+        EmitEtw(sampleId);
+    }
+}
+
+void PipelineTrace::Reset() {
+    for (Slot& slot : m_slots) {
+        slot.id.store(0, std::memory_order_release);
+    }
+    m_lastProcessed.store(0, std::memory_order_relaxed);
+}
+
+bool PipelineTrace::ReadSlot(size_t index, uint64_t& id, int64_t (&us)[kStageCount]) const {
+    const Slot& slot = m_slots[index];
+    id = slot.id.load(std::memory_order_acquire);
+    if (id == 0) return false;
+    for (size_t i = 0; i < kStageCount; ++i) {
+        us[i] = slot.us[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot.id.load(std::memory_order_relaxed) == id;
+}
+
+PipelineTraceSummary PipelineTrace::Summarize() const {
+    std::vector<int64_t> values[PipelineTraceSummary::kSpanCount];
+    PipelineTraceSummary summary;
+    for (size_t i = 0; i < kCapacity; ++i) {
+        uint64_t id;
+        int64_t us[kStageCount];
+        if (!ReadSlot(i, id, us)) continue;
+        ++summary.samples;
+        for (size_t span = 0; span < PipelineTraceSummary::kSpanCount; ++span) {
+            const int64_t from = us[kSpanStages[span][0]];
+            const int64_t to = us[kSpanStages[span][1]];
+            if (from != 0 && to != 0 && to >= from) {
+                values[span].push_back(to - from);
+            }
+        }
+    }
+    for (size_t span = 0; span < PipelineTraceSummary::kSpanCount; ++span) {
+        summary.spans[span] = SummarizeSpan(values[span]);
+    }
+    return summary;
+}
+
+bool PipelineTrace::WriteChromeTrace(const std::string& path) const {
+    FILE* f = std::fopen(path.c_str(), "w");
+    if (!f) return false;
+
+    std::fprintf(f, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+    // Name the lanes; the total span is left out as it overlaps the others
+    for (size_t span = 0; span < static_cast<size_t>(TraceSpan::Total); ++span) {
+        std::fprintf(f, "%s{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %zu, "
+                        "\"args\": {\"name\": \"%s\"}}", span == 0 ? "" : ",\n", span + 1, kSpanNames[span]);
+    }
+    for (size_t i = 0; i < kCapacity; ++i) {
+        uint64_t id;
+        int64_t us[kStageCount];
+        if (!ReadSlot(i, id, us)) continue;
+        for (size_t span = 0; span < static_cast<size_t>(TraceSpan::Total); ++span) {
+            const int64_t from = us[kSpanStages[span][0]];
+            const int64_t to = us[kSpanStages[span][1]];
+            if (from == 0 || to == 0 || to < from) continue;
+            std::fprintf(f, ",\n{\"name\": \"%s\", \"cat\": \"cameraunlock\", \"ph\": \"X\", \"pid\": 1, "
+                            "\"tid\": %zu, \"ts\": %lld, \"dur\": %lld, \"args\": {\"sample\": %llu}}",
+                         kSpanNames[span], span + 1, static_cast<long long>(from),
+                         static_cast<long long>(to - from), static_cast<unsigned long long>(id));
+        }
+    }
+    std::fprintf(f, "\n]}\n");
+    const bool ok = std::ferror(f) == 0;
+    return std::fclose(f) == 0 && ok;
+}
+
+bool PipelineTrace::SetEtwEnabled(bool enabled) {
+#ifdef _WIN32
+    if (enabled && !EtwRegistered()) return false;
+    m_etw.store(enabled, std::memory_order_relaxed);
+    return true;
+#else
+    m_etw.store(false, std::memory_order_relaxed);
+    return !enabled;
+#endif
+}
+
+void PipelineTrace::EmitEtw(uint64_t sampleId) const {
+#ifdef _WIN32
+    uint64_t id;
+    int64_t us[kStageCount];
+    if (!ReadSlot(sampleId % kCapacity, id, us) || id != sampleId) return;
+    TraceLoggingWrite(g_cameraunlockPipelineProvider, "Sample",
+        TraceLoggingUInt64(id, "SampleId"),
+        TraceLoggingInt64(us[kArrival], "ArrivalUs"),
+        TraceLoggingInt64(us[kPublish], "PublishUs"),
+        TraceLoggingInt64(us[kProcessBegin], "ProcessBeginUs"),
+        TraceLoggingInt64(us[kProcessEnd], "ProcessEndUs"),
+        TraceLoggingInt64(us[kPresent], "PresentUs"));
+#else
+    (void)sampleId;
+#endif
+}
+
+const char* PipelineTrace::GetSpanName(TraceSpan span) {
+    return span < TraceSpan::Count ? kSpanNames[static_cast<size_t>(span)] : "unknown";
+}
+
+}  // namespace cameraunlock
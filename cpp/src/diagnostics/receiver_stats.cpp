@@ -0,0 +1,89 @@
+#include "cameraunlock/diagnostics/receiver_stats.h"
+
+namespace cameraunlock {
+
+constexpr int64_t ReceiverStatsSnapshot::kBucketUpperUs[];
+
+void ReceiverStats::RecordPacket(int64_t arrivalUs) {
+    m_packets.fetch_add(1, std::memory_order_relaxed);
+
+    int64_t last = m_lastArrivalUs;
+    m_lastArrivalUs = arrivalUs;
+    if (last == 0 || arrivalUs < last) {
+        return;  // First packet, or kernel timestamps reordered
+    }
+
+    int64_t interval = arrivalUs - last;
+    m_intervals.fetch_add(1, std::memory_order_relaxed);
+    m_intervalSumUs.fetch_add(static_cast<uint64_t>(interval), std::memory_order_relaxed);
+    m_buckets[BucketFor(interval)].fetch_add(1, std::memory_order_relaxed);
+
+    // Single writer, so a plain compare-then-store is enough.
+    int64_t currentMin = m_minIntervalUs.load(std::memory_order_relaxed);
+    if (currentMin == 0 || interval < currentMin) {
+        m_minIntervalUs.store(interval > 0 ? interval : 1, std::memory_order_relaxed);
+    }
+}
+
+size_t ReceiverStats::BucketFor(int64_t intervalUs) {
+    for (size_t i = 0; i < ReceiverStatsSnapshot::kBucketCount - 1; ++i) {
+        if (intervalUs < ReceiverStatsSnapshot::kBucketUpperUs[i]) {
+            return i;
+        }
+    }
+    return ReceiverStatsSnapshot::kBucketCount - 1;
+}
+
+ReceiverStatsSnapshot ReceiverStats::Snapshot() const {
+    ReceiverStatsSnapshot snap;
+    snap.packets = m_packets.load(std::memory_order_relaxed);
+    snap.malformed = m_malformed.load(std::memory_order_relaxed);
+    snap.superseded = m_superseded.load(std::memory_order_relaxed);
+    snap.reordered = m_reordered.load(std::memory_order_relaxed);
+
+    uint64_t bucketTotal = 0;
+    for (size_t i = 0; i < ReceiverStatsSnapshot::kBucketCount; ++i) {
+        snap.buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+        bucketTotal += snap.buckets[i];
+    }
+    snap.intervals = bucketTotal;
+
+    uint64_t count = m_intervals.load(std::memory_order_relaxed);
+    if (count > 0) {
+        snap.meanIntervalMs = static_cast<double>(m_intervalSumUs.load(std::memory_order_relaxed)) /
+                              static_cast<double>(count) / 1000.0;
+        snap.minIntervalMs = static_cast<double>(m_minIntervalUs.load(std::memory_order_relaxed)) / 1000.0;
+    }
+
+    if (bucketTotal > 0) {
+        // Smallest bucket whose cumulative count reaches 99%.
+        uint64_t target = bucketTotal - bucketTotal / 100;
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < ReceiverStatsSnapshot::kBucketCount; ++i) {
+            cumulative += snap.buckets[i];
+            if (cumulative >= target) {
+                size_t bound = i < ReceiverStatsSnapshot::kBucketCount - 1 ? i : i - 1;
+                snap.p99IntervalMs = static_cast<double>(ReceiverStatsSnapshot::kBucketUpperUs[bound]) / 1000.0;
+                break;
+            }
+        }
+    }
+
+    return snap;
+}
+
+void ReceiverStats::Reset() {
+    m_packets.store(0, std::memory_order_relaxed);
+    m_malformed.store(0, std::memory_order_relaxed);
+    m_superseded.store(0, std::memory_order_relaxed);
+    m_reordered.store(0, std::memory_order_relaxed);
+    m_intervals.store(0, std::memory_order_relaxed);
+    m_intervalSumUs.store(0, std::memory_order_relaxed);
+    m_minIntervalUs.store(0, std::memory_order_relaxed);
+    for (auto& bucket : m_buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    m_lastArrivalUs = 0;
+}
+
+}  // namespace cameraunlock
@@ -1,8 +1,8 @@
 #include <cameraunlock/discovery/camera_discovery.h>
 #include <cameraunlock/hooks/hook_manager.h>
+#include <cameraunlock/memory/pattern_scanner.h>
+#include <cameraunlock/memory/rtti_index.h>
 
-#include <cstdarg>
-#include <cstdio>
 #include <cstring>
 #include <cmath>
 #include <algorithm>
@@ -15,8 +15,7 @@ namespace cameraunlock::discovery {
 
 // Static storage for probe detours
 uintptr_t(__fastcall* CameraDiscovery::s_originals[kMaxProbeSlots])(void*, void*, void*, void*) = {};
-std::atomic<int> CameraDiscovery::s_callCounts[kMaxProbeSlots] = {};
-std::atomic<uintptr_t> CameraDiscovery::s_lastThis[kMaxProbeSlots] = {};
+ProbeSlotCounters CameraDiscovery::s_probeCounters[kMaxProbeSlots];
 CameraDiscovery* CameraDiscovery::s_instance = nullptr;
 std::atomic<bool> CameraDiscovery::s_calibActive{false};
 float CameraDiscovery::s_calibDeltas[3] = {};
@@ -56,19 +55,21 @@ CameraDiscovery::CameraDiscovery() {
 CameraDiscovery::~CameraDiscovery() {
     Cleanup();
     if (s_instance == this) s_instance = nullptr;
+    // Queued lines point back at this instance
+    AsyncLog::Flush();
 }
 
-void CameraDiscovery::Log(const char* fmt, ...) {
-    if (!m_log) return;
-    char buf[512];
-    va_list args;
-    va_start(args, fmt);
-    vsnprintf(buf, sizeof(buf), fmt, args);
-    va_end(args);
-    m_log(buf);
+void CameraDiscovery::WriteLog(void* context, int, const char* message) {
+    LogFn fn = static_cast<CameraDiscovery*>(context)->m_log;
+    if (fn) fn(message);
+}
+
+void CameraDiscovery::JoinScan() {
+    if (m_scanThread.joinable()) m_scanThread.join();
 }
 
 void CameraDiscovery::Start(const DiscoveryConfig& config) {
+    JoinScan();
     m_config = config;
     m_phase = Phase::FindingVtables;
     m_probeFrameCount = 0;
@@ -81,12 +82,30 @@ void CameraDiscovery::Start(const DiscoveryConfig& config) {
     m_calibFrame = 0;
     m_calibPulsing = false;
     m_candidates.clear();
+    m_watched.clear();
+    m_watchFrame = 0;
+    m_snapshotSize = 0;
+    m_scanDone.store(false);
+    m_scanStep.store(0);
 
     for (int i = 0; i < kMaxProbeSlots; i++) {
-        s_callCounts[i].store(0);
-        s_lastThis[i].store(0);
+        s_probeCounters[i].Reset();
         s_originals[i] = nullptr;
     }
+    m_probeRates.Reset(kMaxProbeSlots, config.probe_frames);
+
+    m_imageBase = 0;
+    m_hasIdentity = false;
+    m_warmStart = false;
+    if (!config.result_path.empty()) {
+        size_t imageSize = 0;
+        m_hasIdentity = memory::GetModuleRange(config.module, m_imageBase, imageSize) &&
+                        memory::GetImageIdentity(m_imageBase, imageSize, m_identity);
+        if (m_hasIdentity && TryWarmStart()) {
+            m_phase = Phase::Complete;
+            return;
+        }
+    }
 
     Log("DISC: Starting discovery with %d candidate names", (int)config.candidate_names.size());
 }
@@ -98,8 +117,18 @@ Phase CameraDiscovery::Advance() {
     switch (m_phase) {
         case Phase::FindingVtables: m_phase = RunFindVtables(); break;
         case Phase::Probing:        m_phase = RunProbing(); break;
-        case Phase::AnalyzingLayout: m_phase = RunAnalyzeLayout(); break;
+        case Phase::AnalyzingLayout:
+            m_phase = RunAnalyzeLayout();
+            if (m_phase == Phase::Complete) SaveResult();
+            break;
         // Calibration skipped — heuristic axis assignment in AnalyzeLayout
+        case Phase::Complete:
+            // A warm start has no probe window; take the first this the
+            // hooked vfunc sees
+            if (m_warmStart && m_instance.load() == 0) {
+                m_instance.store(s_probeCounters[m_activeSlot].last_this.load(std::memory_order_relaxed));
+            }
+            break;
         default: break;
     }
     return m_phase;
@@ -107,8 +136,7 @@ Phase CameraDiscovery::Advance() {
 
 void CameraDiscovery::ReportVfuncCall(int slot, void* this_ptr) {
     if (slot < 0 || slot >= kMaxProbeSlots) return;
-    s_callCounts[slot].fetch_add(1, std::memory_order_relaxed);
-    s_lastThis[slot].store(reinterpret_cast<uintptr_t>(this_ptr), std::memory_order_relaxed);
+    s_probeCounters[slot].Record(this_ptr);
 }
 
 CalibrationPulse CameraDiscovery::GetCalibrationPulse() const {
@@ -124,11 +152,64 @@ CalibrationPulse CameraDiscovery::GetCalibrationPulse() const {
     return p;
 }
 
+DiscoveryProgress CameraDiscovery::GetProgress() const {
+    // Rough share of wall time per phase: scanning is short next to the
+    // multi-second probe window, then a shorter watch before the layout
+    // analysis frame
+    constexpr float kScanEnd = 0.1f;
+    constexpr float kProbeEnd = 0.75f;
+    constexpr float kWatchEnd = 0.99f;
+
+    DiscoveryProgress p{m_phase, 0.0f, 0.0f, ""};
+    switch (m_phase) {
+        case Phase::Idle:
+            p.label = "Idle";
+            break;
+        case Phase::FindingVtables: {
+            const int step = m_scanStep.load(std::memory_order_relaxed);
+            const int names = std::max((int)m_config.candidate_names.size(), 1);
+            // The index build is one indivisible step worth half the phase
+            p.phase_fraction = step < 0 ? 0.0f : 0.5f + 0.5f * std::min(step, names) / names;
+            p.overall_fraction = kScanEnd * p.phase_fraction;
+            p.label = step < 0 ? "Indexing RTTI" : "Finding camera vtables";
+            break;
+        }
+        case Phase::Probing:
+            p.phase_fraction = m_config.probe_frames > 0
+                ? std::min(static_cast<float>(m_probeFrameCount) / m_config.probe_frames, 1.0f)
+                : 1.0f;
+            p.overall_fraction = kScanEnd + (kProbeEnd - kScanEnd) * p.phase_fraction;
+            p.label = "Probing vfuncs";
+            break;
+        case Phase::AnalyzingLayout:
+            p.phase_fraction = m_config.heatmap_frames > 0
+                ? std::min(static_cast<float>(m_watchFrame) / m_config.heatmap_frames, 1.0f)
+                : 1.0f;
+            p.overall_fraction = kProbeEnd + (kWatchEnd - kProbeEnd) * p.phase_fraction;
+            p.label = p.phase_fraction < 1.0f ? "Watching camera instances" : "Analyzing camera layout";
+            break;
+        case Phase::Calibrating:
+            p.overall_fraction = kWatchEnd;
+            p.label = "Calibrating";
+            break;
+        case Phase::Complete:
+            p.phase_fraction = 1.0f;
+            p.overall_fraction = 1.0f;
+            p.label = "Complete";
+            break;
+        case Phase::Failed:
+            p.label = "Failed";
+            break;
+    }
+    return p;
+}
+
 void CameraDiscovery::SetInstancePointer(void* ptr) {
     m_instance.store(reinterpret_cast<uintptr_t>(ptr));
 }
 
 void CameraDiscovery::Cleanup() {
+    JoinScan();
     RemoveProbeHooks();
     m_candidates.clear();
 }
@@ -138,18 +219,59 @@ void CameraDiscovery::Cleanup() {
 // ============================================================================
 
 Phase CameraDiscovery::RunFindVtables() {
+    if (!m_config.background_scan) {
+        ScanCandidates();
+        return FinishFindVtables();
+    }
+
+    // The scans take hundreds of ms on a large module; run them off the
+    // game thread and poll once per frame so starting discovery can't hitch
+    if (m_scanDone.load(std::memory_order_acquire)) {
+        JoinScan();
+        return FinishFindVtables();
+    }
+    if (!m_scanThread.joinable()) {
+        m_scanThread = std::thread([this]() {
+            ScanCandidates();
+            m_scanDone.store(true, std::memory_order_release);
+        });
+    }
+    return Phase::FindingVtables;
+}
+
+// Runs on the scan worker in background mode: touches only m_candidates
+// and m_scanStep, and never installs hooks. Its log lines go through the
+// async log like the game thread's, so the callback still runs on one thread
+void CameraDiscovery::ScanCandidates() {
+    // One pass over the module indexes every class; per-name lookups are
+    // then hash hits instead of three full scans each
+    m_scanStep.store(-1, std::memory_order_relaxed);
+    memory::RttiIndex index;
+    const bool indexed = index.Build(m_config.module);
+    if (indexed) {
+        Log("DISC: RTTI index built (%d classes)", (int)index.GetClassCount());
+    }
+
+    int step = 0;
     for (auto& name : m_config.candidate_names) {
+        m_scanStep.store(step++, std::memory_order_relaxed);
         if (m_candidates.size() >= kMaxCandidates) break;
 
         memory::VtableInfo vt{};
-        if (memory::FindVtableFromRTTI(m_config.module, name, vt, kMaxVfuncsPerCandidate)) {
+        const bool found = indexed
+            ? index.FindVtable(name, vt, kMaxVfuncsPerCandidate)
+            : memory::FindVtableFromRTTI(m_config.module, name, vt, kMaxVfuncsPerCandidate);
+        if (found) {
             Log("DISC: Found %s vtable at 0x%llX (%d vfuncs)", name.c_str(), vt.vtable_address, vt.vfunc_count);
             m_candidates.push_back({name, vt});
         } else {
             Log("DISC: %s not found via RTTI", name.c_str());
         }
     }
+    m_scanStep.store(step, std::memory_order_relaxed);
+}
 
+Phase CameraDiscovery::FinishFindVtables() {
     if (m_candidates.empty()) {
         Log("DISC: No camera classes found — failed");
         return Phase::Failed;
@@ -165,72 +287,36 @@ Phase CameraDiscovery::RunFindVtables() {
 
 Phase CameraDiscovery::RunProbing() {
     m_probeFrameCount++;
+    m_probeRates.SampleFrame(s_probeCounters);
 
     if (m_probeFrameCount < m_config.probe_frames) return Phase::Probing;
 
+    ProbeSlotSummary summaries[kMaxProbeSlots];
+    for (int slot = 0; slot < kMaxProbeSlots; slot++) {
+        summaries[slot] = m_probeRates.Summarize(slot, s_probeCounters[slot]);
+    }
+
     // Log all results
     for (int c = 0; c < (int)m_candidates.size(); c++) {
         for (int v = 0; v < m_candidates[c].vtable.vfunc_count; v++) {
-            int slot = c * kMaxVfuncsPerCandidate + v;
-            int count = s_callCounts[slot].load();
-            if (count > 0) {
-                Log("DISC: %s::vfunc[%d] called %d times (this=%p)",
-                    m_candidates[c].name.c_str(), v, count,
-                    reinterpret_cast<void*>(s_lastThis[slot].load()));
+            const ProbeSlotSummary& s = summaries[c * kMaxVfuncsPerCandidate + v];
+            if (s.total_calls > 0) {
+                Log("DISC: %s::vfunc[%d] called %u times (%.2f/frame in %d/%d frames, max %u, %d%s instances, this=%p)",
+                    m_candidates[c].name.c_str(), v, s.total_calls, s.mean_per_active,
+                    s.active_frames, s.frames, s.max_per_frame, s.instance_count,
+                    s.instance_overflow ? "+" : "", reinterpret_cast<void*>(s.last_this));
             }
         }
     }
 
-    // Selection: prefer a vfunc called at roughly per-frame rate (~60Hz).
-    // A camera update runs 1-2x per frame. Utility functions run 100s of times.
-    // Target: ~1-10 calls per frame = probe_frames to probe_frames*10 total calls.
+    // Selection: prefer a vfunc that runs nearly every frame at roughly
+    // per-frame rate on one or two objects. A camera update runs 1-2x per
+    // frame; utility functions run 100s of times over many instances.
     // Prefer the first candidate (most specific class) with a match.
-    int targetCallsLow = m_config.probe_frames;       // ~1x per frame
-    int targetCallsHigh = m_config.probe_frames * 10;  // ~10x per frame
-
-    int bestSlot = -1;
-    int bestCount = 0;
-    int bestDistance = INT_MAX;  // distance from ideal range
-
-    for (int c = 0; c < (int)m_candidates.size(); c++) {
-        int candidateBestSlot = -1;
-        int candidateBestDist = INT_MAX;
-        int candidateBestCount = 0;
-
-        for (int v = 0; v < m_candidates[c].vtable.vfunc_count; v++) {
-            int slot = c * kMaxVfuncsPerCandidate + v;
-            int count = s_callCounts[slot].load();
-            if (count == 0) continue;
-
-            // Distance from ideal per-frame range
-            int dist = 0;
-            if (count < targetCallsLow) dist = targetCallsLow - count;
-            else if (count > targetCallsHigh) dist = count - targetCallsHigh;
-            // else in range, dist = 0
-
-            if (dist < candidateBestDist || (dist == candidateBestDist && count > candidateBestCount)) {
-                candidateBestDist = dist;
-                candidateBestSlot = slot;
-                candidateBestCount = count;
-            }
-        }
-
-        // If this candidate has any calls in/near the per-frame range, use it
-        if (candidateBestSlot >= 0 && candidateBestCount >= 50) {
-            bestSlot = candidateBestSlot;
-            bestCount = candidateBestCount;
-            bestDistance = candidateBestDist;
-            break;  // prefer first candidate (most specific class)
-        }
-        // Fallback: track best overall
-        if (candidateBestSlot >= 0 && candidateBestDist < bestDistance) {
-            bestDistance = candidateBestDist;
-            bestSlot = candidateBestSlot;
-            bestCount = candidateBestCount;
-        }
-    }
+    const int slotCount = (int)m_candidates.size() * kMaxVfuncsPerCandidate;
+    const int bestSlot = SelectProbeWinner(summaries, slotCount, kMaxVfuncsPerCandidate);
 
-    if (bestSlot < 0 || bestCount == 0) {
+    if (bestSlot < 0) {
         Log("DISC: No vfuncs called during probe period — failed");
         RemoveProbeHooks();
         return Phase::Failed;
@@ -238,16 +324,18 @@ Phase CameraDiscovery::RunProbing() {
 
     int ci = bestSlot / kMaxVfuncsPerCandidate;
     int vi = bestSlot % kMaxVfuncsPerCandidate;
-    Log("DISC: Winner: %s::vfunc[%d] (%d calls)",
-        m_candidates[ci].name.c_str(), vi, bestCount);
+    Log("DISC: Winner: %s::vfunc[%d] (%u calls, %.2f/frame)",
+        m_candidates[ci].name.c_str(), vi, summaries[bestSlot].total_calls,
+        summaries[bestSlot].mean_per_active);
 
     m_activeSlot = bestSlot;
     m_activeTarget = reinterpret_cast<void*>(m_candidates[ci].vtable.vfuncs[vi]);
-    m_instance.store(s_lastThis[bestSlot].load());
+    m_instance.store(summaries[bestSlot].last_this);
 
     // Remove all probe hooks except the winner
     // (we keep the winner hooked so we continue getting this-pointers)
     auto& hm = hooks::HookManager::Instance();
+    hm.BeginBatch();
     for (int c = 0; c < (int)m_candidates.size(); c++) {
         for (int v = 0; v < m_candidates[c].vtable.vfunc_count; v++) {
             int slot = c * kMaxVfuncsPerCandidate + v;
@@ -257,6 +345,7 @@ Phase CameraDiscovery::RunProbing() {
             hm.RemoveHook(target);
         }
     }
+    hm.Commit();
 
     return Phase::AnalyzingLayout;
 }
@@ -265,6 +354,91 @@ Phase CameraDiscovery::RunProbing() {
 // Phase 3: Analyze instance memory layout
 // ============================================================================
 
+// Copy instance memory so analysis never dereferences the game object in
+// place; a freed or undersized object faults inside the guard instead
+static bool CopyInstance(uintptr_t inst, size_t size, std::vector<float>& out) {
+    out.resize(size / sizeof(float));
+    __try {
+        memcpy(out.data(), reinterpret_cast<const void*>(inst), out.size() * sizeof(float));
+    }
+    __except (1) {
+        return false;
+    }
+    return true;
+}
+
+// Snapshot every distinct this pointer the winning vfunc saw, once per
+// frame; returns true when the watch window is over
+bool CameraDiscovery::WatchInstances() {
+    if (m_watchFrame == 0 && m_watched.empty()) {
+        std::vector<uintptr_t> addresses{m_instance.load()};
+        if (m_activeSlot >= 0) {
+            for (const auto& seen : s_probeCounters[m_activeSlot].instances) {
+                const uintptr_t p = seen.load(std::memory_order_relaxed);
+                if (p == 0 || (int)addresses.size() >= kMaxWatchedInstances) continue;
+                if (std::find(addresses.begin(), addresses.end(), p) == addresses.end()) addresses.push_back(p);
+            }
+        }
+        for (uintptr_t p : addresses) {
+            m_watched.push_back({p, {}});
+            m_watched.back().heatmap.Reset(m_snapshotSize / sizeof(float));
+        }
+        Log("DISC: Watching %d instance(s) for %d frames", (int)m_watched.size(), m_config.heatmap_frames);
+    }
+
+    for (auto& w : m_watched) {
+        if (w.address == 0) continue;
+        if (CopyInstance(w.address, m_snapshotSize, m_snapshot)) {
+            w.heatmap.AddSnapshot(m_snapshot.data());
+        } else {
+            Log("DISC: Instance %p became unreadable — dropped", reinterpret_cast<void*>(w.address));
+            w.address = 0;
+        }
+    }
+
+    return ++m_watchFrame >= m_config.heatmap_frames;
+}
+
+// The camera is the watched object whose angle-like fields actually move;
+// ties (e.g. the player never looked around) keep the probe's last this
+uintptr_t CameraDiscovery::PickWatchedInstance() {
+    uintptr_t best = m_instance.load();
+    int bestScore = -1;
+    const int skipFloats = 2;  // vtable ptr
+
+    for (const auto& w : m_watched) {
+        if (w.address == 0 || !w.heatmap.GetLatest()) continue;
+        const LayoutReport layout = ClassifyMemoryRegion(w.heatmap.GetLatest() + skipFloats,
+                                                         m_snapshotSize - skipFloats * sizeof(float));
+        int changing = 0;
+        for (size_t i = 0; i < w.heatmap.GetFloatCount(); i++) {
+            if (w.heatmap.GetChangeCount(i) > 0) changing++;
+        }
+        int hotAngles = 0;
+        for (int g = 0; g < layout.group_count; g++) {
+            if (layout.groups[g].type != FloatClass::Angle) continue;
+            const size_t first = layout.groups[g].offset / sizeof(float) + skipFloats;
+            for (int j = 0; j < layout.groups[g].count; j++) {
+                if (w.heatmap.GetChangeCount(first + j) > 0) hotAngles++;
+            }
+        }
+        Log("DISC: Instance %p: %d changing floats, %d in angle groups",
+            reinterpret_cast<void*>(w.address), changing, hotAngles);
+
+        // m_watched starts with m_instance, so it wins ties
+        if (hotAngles > bestScore) {
+            bestScore = hotAngles;
+            best = w.address;
+        }
+    }
+
+    if (best != m_instance.load()) {
+        Log("DISC: Switching to instance %p", reinterpret_cast<void*>(best));
+        m_instance.store(best);
+    }
+    return best;
+}
+
 Phase CameraDiscovery::RunAnalyzeLayout() {
     uintptr_t inst = m_instance.load();
     if (inst == 0) {
@@ -272,16 +446,28 @@ Phase CameraDiscovery::RunAnalyzeLayout() {
         return Phase::Failed;
     }
 
+    // Snapshot the instance (including the vtable ptr at +0x00, skipped below)
+    if (m_snapshotSize == 0) {
+        const int skipBytes = 8;
+        int size = std::min(m_config.instance_size, kMaxInstanceSize) & ~3;
+        if (size - skipBytes <= 0) size = 256 + skipBytes;
+        m_snapshotSize = size;
+    }
+
+    if (m_config.heatmap_frames > 0 && !WatchInstances()) return Phase::AnalyzingLayout;
+    inst = PickWatchedInstance();
+
     Log("DISC: Analyzing instance at %p (%d bytes)...",
-        reinterpret_cast<void*>(inst), m_config.instance_size);
+        reinterpret_cast<void*>(inst), m_snapshotSize);
 
-    // Read instance memory (skip vtable pointer at +0x00)
-    int skipBytes = 8;  // skip vtable ptr
-    int analyzeSize = m_config.instance_size - skipBytes;
-    if (analyzeSize <= 0) analyzeSize = 256;
+    if (!CopyInstance(inst, m_snapshotSize, m_snapshot)) {
+        Log("DISC: Instance memory unreadable — failed");
+        return Phase::Failed;
+    }
 
-    m_layout = ClassifyMemoryRegion(
-        reinterpret_cast<const void*>(inst + skipBytes), analyzeSize);
+    // Offsets are relative to the instance base, past the vtable ptr
+    const int skipBytes = 8;
+    m_layout = ClassifyMemoryRegion(m_snapshot.data() + skipBytes / sizeof(float), m_snapshotSize - skipBytes);
 
     // Adjust offsets to be relative to instance base (not the skip-adjusted pointer)
     for (int i = 0; i < m_layout.group_count; i++) {
@@ -329,13 +515,31 @@ Phase CameraDiscovery::RunAnalyzeLayout() {
         return Phase::Failed;
     }
 
-    // Read all candidate float values
+    // Read all candidate float values. If the watch saw any of them move,
+    // only those are considered: a static angle-like float is more likely
+    // a constant than the camera heading.
+    const FloatChangeHeatmap* heat = nullptr;
+    for (const auto& w : m_watched) {
+        if (w.address == inst) heat = &w.heatmap;
+    }
+    bool anyMoved = false;
+    if (heat) {
+        for (size_t off : m_candidateAngleOffsets) {
+            if (heat->GetChangeCount(off / sizeof(float)) > 0) anyMoved = true;
+        }
+    }
+
     struct AngleCandidate { size_t offset; float value; float absValue; };
     std::vector<AngleCandidate> candidates;
     for (size_t off : m_candidateAngleOffsets) {
-        float val = *reinterpret_cast<float*>(inst + off);
+        if (anyMoved && heat->GetChangeCount(off / sizeof(float)) == 0) continue;
+        float val = m_snapshot[off / sizeof(float)];
         candidates.push_back({off, val, std::fabsf(val)});
     }
+    if (anyMoved) {
+        Log("DISC: %d of %d angle candidates changed while watched",
+            (int)candidates.size(), (int)m_candidateAngleOffsets.size());
+    }
 
     // Find yaw: the angle-like float with the largest absolute value (compass heading).
     // Then assume roll/pitch/yaw are consecutive floats (standard layout in game engines).
@@ -371,9 +575,9 @@ Phase CameraDiscovery::RunAnalyzeLayout() {
     size_t rollOff  = yawOff - 2 * sizeof(float);
 
     // Read the values for logging
-    float yawVal = *reinterpret_cast<float*>(inst + yawOff);
-    float pitchVal = *reinterpret_cast<float*>(inst + pitchOff);
-    float rollVal = *reinterpret_cast<float*>(inst + rollOff);
+    float yawVal = m_snapshot[yawOff / sizeof(float)];
+    float pitchVal = m_snapshot[pitchOff / sizeof(float)];
+    float rollVal = m_snapshot[rollOff / sizeof(float)];
 
     Log("DISC: Found consecutive angles: roll=+0x%X(%.1f) pitch=+0x%X(%.1f) yaw=+0x%X(%.1f)",
         (int)rollOff, rollVal, (int)pitchOff, pitchVal, (int)yawOff, yawVal);
@@ -394,16 +598,6 @@ Phase CameraDiscovery::RunAnalyzeLayout() {
 // Phase 4: Calibrate — inject known rotation, detect which floats change
 // ============================================================================
 
-static void SnapshotAngles(uintptr_t inst, const std::vector<size_t>& offsets, std::vector<float>& out) {
-    out.resize(offsets.size());
-    __try {
-        for (size_t i = 0; i < offsets.size(); i++) {
-            out[i] = *reinterpret_cast<float*>(inst + offsets[i]);
-        }
-    }
-    __except (1) {}
-}
-
 Phase CameraDiscovery::RunCalibrating() {
     uintptr_t inst = m_instance.load();
     if (inst == 0) return Phase::Failed;
@@ -449,7 +643,7 @@ Phase CameraDiscovery::RunCalibrating() {
 
     if (m_calibFrame == settleEnd) {
         // Take pre-snapshot, then start pulse via probe detour
-        SnapshotAngles(inst, m_candidateAngleOffsets, m_preSnapshot);
+        if (!CopyInstance(inst, m_snapshotSize, m_preSnapshot)) return Phase::Failed;
 
         // Set up the pulse for the probe detour to apply on ONE axis
         s_calibDeltas[0] = s_calibDeltas[1] = s_calibDeltas[2] = 0;
@@ -464,32 +658,34 @@ Phase CameraDiscovery::RunCalibrating() {
     else if (m_calibFrame == pulseEnd) {
         // Stop pulse, take post-snapshot
         s_calibActive.store(false);
-        SnapshotAngles(inst, m_candidateAngleOffsets, m_postSnapshot);
+        if (!CopyInstance(inst, m_snapshotSize, m_postSnapshot)) return Phase::Failed;
 
         // Find the offset with the LARGEST delta — that's the axis we pulsed.
-        // Only consider offsets within the calibration target angle group
-        // (3 consecutive floats). The pulsed axis should have a much larger
-        // delta than the other two.
+        // One diff pass finds every float that moved; only offsets within
+        // the calibration target angle group (3 consecutive floats) count.
+        // The pulsed axis should have a much larger delta than the other two.
         float minDelta = 1.0f;  // ignore tiny changes (noise, mouse movement)
         size_t bestOffset = 0;
         float bestSign = 1.0f;
         float bestAbsDelta = 0;
         bool found = false;
 
-        for (size_t i = 0; i < 3; i++) {
-            size_t off = s_calibAngleOffsets[i];
-            // Find this offset in the candidate list to get its index
-            for (size_t j = 0; j < m_candidateAngleOffsets.size(); j++) {
-                if (m_candidateAngleOffsets[j] != off) continue;
-                float delta = m_postSnapshot[j] - m_preSnapshot[j];
-                float absDelta = std::fabsf(delta);
-                if (absDelta > minDelta && absDelta > bestAbsDelta) {
-                    bestAbsDelta = absDelta;
-                    bestOffset = off;
-                    bestSign = (delta > 0) ? 1.0f : -1.0f;
-                    found = true;
-                }
-                break;
+        std::vector<FloatChange> changes;
+        DiffFloatSnapshots(m_preSnapshot.data(), m_postSnapshot.data(), m_preSnapshot.size(), minDelta, changes);
+        Log("DISC: %d floats changed during pulse", (int)changes.size());
+
+        for (const auto& change : changes) {
+            const size_t off = change.index * sizeof(float);
+            if (off != s_calibAngleOffsets[0] && off != s_calibAngleOffsets[1] && off != s_calibAngleOffsets[2]) {
+                continue;
+            }
+            float delta = change.after - change.before;
+            float absDelta = std::fabsf(delta);
+            if (absDelta > bestAbsDelta) {
+                bestAbsDelta = absDelta;
+                bestOffset = off;
+                bestSign = (delta > 0) ? 1.0f : -1.0f;
+                found = true;
             }
         }
 
@@ -524,43 +720,129 @@ Phase CameraDiscovery::RunCalibrating() {
     return Phase::Calibrating;
 }
 
+// ============================================================================
+// Persisted result: skip straight to the winner on a known build
+// ============================================================================
+
+// Trust the file only if the build matches and the class's vtable still
+// resolves through its COL to the same name with the same winning function;
+// anything else falls back to a full run, which rewrites the file
+bool CameraDiscovery::TryWarmStart() {
+    DiscoveryResult saved;
+    if (!LoadDiscoveryResult(m_config.result_path, m_identity, saved)) return false;
+
+    const auto& names = m_config.candidate_names;
+    if (std::find(names.begin(), names.end(), saved.class_name) == names.end()) {
+        Log("DISC: Saved result is for %s, no longer a candidate — probing", saved.class_name.c_str());
+        return false;
+    }
+
+    memory::VtableInfo vt{};
+    const int vi = saved.vfunc_index;
+    if (vi >= kMaxVfuncsPerCandidate ||
+        !memory::ReadVtableAt(m_config.module, m_imageBase + saved.vtable_rva, saved.class_name, vt,
+                              kMaxVfuncsPerCandidate) ||
+        vi >= vt.vfunc_count || vt.vfuncs[vi] != m_imageBase + saved.vfunc_rva) {
+        Log("DISC: Saved %s::vfunc[%d] no longer matches the image — probing", saved.class_name.c_str(), vi);
+        return false;
+    }
+
+    // The winner is the only candidate, so its probe slot is its vfunc index
+    m_candidates.push_back({saved.class_name, vt});
+    auto& hm = hooks::HookManager::Instance();
+    hm.BeginBatch();
+    const bool hooked = HookSlot(0, vi);
+    if (hm.Commit() != hooks::HookStatus::Ok || !hooked) {
+        Log("DISC: Failed to hook saved winner — probing");
+        RemoveProbeHooks();
+        m_candidates.clear();
+        return false;
+    }
+
+    m_activeSlot = vi;
+    m_activeTarget = reinterpret_cast<void*>(vt.vfuncs[vi]);
+    m_offsets = saved.offsets;
+    m_layout = saved.layout;
+    m_warmStart = true;
+    Log("DISC: Warm start: %s::vfunc[%d], yaw=+0x%X pitch=+0x%X roll=+0x%X",
+        saved.class_name.c_str(), vi, (int)m_offsets.yaw_offset, (int)m_offsets.pitch_offset,
+        (int)m_offsets.roll_offset);
+    return true;
+}
+
+void CameraDiscovery::SaveResult() {
+    if (!m_hasIdentity || m_activeSlot < 0) return;
+
+    const int ci = m_activeSlot / kMaxVfuncsPerCandidate;
+    const int vi = m_activeSlot % kMaxVfuncsPerCandidate;
+    DiscoveryResult result;
+    result.class_name = m_candidates[ci].name;
+    result.vfunc_index = vi;
+    result.vtable_rva = static_cast<uint32_t>(m_candidates[ci].vtable.vtable_address - m_imageBase);
+    result.vfunc_rva = static_cast<uint32_t>(m_candidates[ci].vtable.vfuncs[vi] - m_imageBase);
+    result.offsets = m_offsets;
+    result.layout = m_layout;
+
+    if (SaveDiscoveryResult(m_config.result_path, m_identity, result)) {
+        Log("DISC: Saved result to %s", m_config.result_path.c_str());
+    } else {
+        Log("DISC: Failed to save result to %s", m_config.result_path.c_str());
+    }
+}
+
 // ============================================================================
 // Probe hook management
 // ============================================================================
 
-void CameraDiscovery::InstallProbeHooks() {
+// Queue one probe hook; the caller brackets it in a batch
+bool CameraDiscovery::HookSlot(int c, int v) {
     auto& hm = hooks::HookManager::Instance();
+    int slot = c * kMaxVfuncsPerCandidate + v;
+    void* target = reinterpret_cast<void*>(m_candidates[c].vtable.vfuncs[v]);
+
+    auto st = hm.CreateHook(target, reinterpret_cast<void*>(s_probeDetours[slot]),
+                             reinterpret_cast<void**>(&s_originals[slot]));
+    if (st != hooks::HookStatus::Ok) {
+        Log("DISC: Failed to hook %s::vfunc[%d]: %s",
+            m_candidates[c].name.c_str(), v, hooks::HookStatusToString(st));
+        return false;
+    }
 
-    for (int c = 0; c < (int)m_candidates.size(); c++) {
-        for (int v = 0; v < m_candidates[c].vtable.vfunc_count; v++) {
-            int slot = c * kMaxVfuncsPerCandidate + v;
-            void* target = reinterpret_cast<void*>(m_candidates[c].vtable.vfuncs[v]);
+    st = hm.EnableHook(target);
+    if (st != hooks::HookStatus::Ok) {
+        Log("DISC: Failed to enable %s::vfunc[%d]: %s",
+            m_candidates[c].name.c_str(), v, hooks::HookStatusToString(st));
+        return false;
+    }
 
-            auto st = hm.CreateHook(target, reinterpret_cast<void*>(s_probeDetours[slot]),
-                                     reinterpret_cast<void**>(&s_originals[slot]));
-            if (st != hooks::HookStatus::Ok) {
-                Log("DISC: Failed to hook %s::vfunc[%d]: %s",
-                    m_candidates[c].name.c_str(), v, hooks::HookStatusToString(st));
-                continue;
-            }
+    Log("DISC: Probing %s::vfunc[%d] at +0x%llX (slot %d)",
+        m_candidates[c].name.c_str(), v,
+        m_candidates[c].vtable.vfuncs[v] - reinterpret_cast<uintptr_t>(m_config.module), slot);
+    return true;
+}
 
-            st = hm.EnableHook(target);
-            if (st != hooks::HookStatus::Ok) {
-                Log("DISC: Failed to enable %s::vfunc[%d]: %s",
-                    m_candidates[c].name.c_str(), v, hooks::HookStatusToString(st));
-                continue;
-            }
+void CameraDiscovery::InstallProbeHooks() {
+    auto& hm = hooks::HookManager::Instance();
 
-            Log("DISC: Probing %s::vfunc[%d] at +0x%llX (slot %d)",
-                m_candidates[c].name.c_str(), v,
-                m_candidates[c].vtable.vfuncs[v] - reinterpret_cast<uintptr_t>(m_config.module), slot);
+    // Queue every enable so the game's threads are suspended once, not per hook
+    hm.BeginBatch();
+
+    for (int c = 0; c < (int)m_candidates.size(); c++) {
+        for (int v = 0; v < m_candidates[c].vtable.vfunc_count; v++) {
+            HookSlot(c, v);
         }
     }
+
+    auto st = hm.Commit();
+    if (st != hooks::HookStatus::Ok) {
+        Log("DISC: Failed to apply probe hooks: %s", hooks::HookStatusToString(st));
+    }
 }
 
 void CameraDiscovery::RemoveProbeHooks() {
     auto& hm = hooks::HookManager::Instance();
 
+    hm.BeginBatch();
     for (int c = 0; c < (int)m_candidates.size(); c++) {
         for (int v = 0; v < m_candidates[c].vtable.vfunc_count; v++) {
             void* target = reinterpret_cast<void*>(m_candidates[c].vtable.vfuncs[v]);
@@ -568,6 +850,7 @@ void CameraDiscovery::RemoveProbeHooks() {
             hm.RemoveHook(target);
         }
     }
+    hm.Commit();
 }
 
 } // namespace cameraunlock::discovery
@@ -0,0 +1,120 @@
+#include <cameraunlock/discovery/discovery_result.h>
+#include <cameraunlock/memory/rtti_vtable.h>
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+
+namespace cameraunlock::discovery {
+
+namespace {
+
+constexpr const char* kFileHeader = "# cameraunlock discovery result v1";
+
+// Next line that isn't a comment or blank, without its line ending
+bool NextLine(FILE* file, char* line, size_t size) {
+    while (fgets(line, static_cast<int>(size), file)) {
+        line[std::strcspn(line, "\r\n")] = '\0';
+        if (line[0] != '#' && line[0] != '\0') return true;
+    }
+    return false;
+}
+
+bool IsSign(float s) {
+    return s == 1.0f || s == -1.0f;
+}
+
+} // anonymous namespace
+
+bool SaveDiscoveryResult(const std::string& path, const memory::ModuleIdentity& id,
+                         const DiscoveryResult& result) {
+    if (path.empty() || !result.offsets.valid || result.class_name.empty()) return false;
+
+    FILE* file = fopen(path.c_str(), "w");
+    if (!file) return false;
+
+    const CameraOffsets& o = result.offsets;
+    fprintf(file, "%s\n", kFileHeader);
+    fprintf(file, "module %08" PRIx32 " %08" PRIx32 " %08" PRIx32 " %08" PRIx32 "\n", id.time_date_stamp,
+            id.size_of_image, id.checksum, id.header_hash);
+    fprintf(file, "class %s\n", result.class_name.c_str());
+    fprintf(file, "vfunc %d %08" PRIx32 " %08" PRIx32 "\n", result.vfunc_index, result.vtable_rva,
+            result.vfunc_rva);
+    fprintf(file, "offsets %zx %zx %zx %+.0f %+.0f %+.0f\n", o.yaw_offset, o.pitch_offset, o.roll_offset,
+            o.yaw_sign, o.pitch_sign, o.roll_sign);
+    for (int i = 0; i < result.layout.group_count; i++) {
+        const FloatGroup& g = result.layout.groups[i];
+        // %.9g round-trips every float exactly
+        fprintf(file, "group %zx %d %d %.9g %.9g %.9g %.9g\n", g.offset, static_cast<int>(g.type), g.count,
+                g.values[0], g.values[1], g.values[2], g.values[3]);
+    }
+    // A file cut short by a crash mid-write has no end line and is rejected
+    fprintf(file, "end\n");
+
+    const bool ok = fflush(file) == 0;
+    fclose(file);
+    return ok;
+}
+
+bool LoadDiscoveryResult(const std::string& path, const memory::ModuleIdentity& id,
+                         DiscoveryResult& out) {
+    if (path.empty()) return false;
+
+    FILE* file = fopen(path.c_str(), "r");
+    if (!file) return false;
+
+    DiscoveryResult result;
+    bool complete = false;
+    char line[256];
+
+    memory::ModuleIdentity fileId;
+    bool ok = NextLine(file, line, sizeof(line)) &&
+              std::sscanf(line, "module %" SCNx32 " %" SCNx32 " %" SCNx32 " %" SCNx32, &fileId.time_date_stamp,
+                          &fileId.size_of_image, &fileId.checksum, &fileId.header_hash) == 4 &&
+              fileId == id;
+
+    // Class names never contain spaces; the rest of the line is the name
+    ok = ok && NextLine(file, line, sizeof(line)) && std::strncmp(line, "class ", 6) == 0 && line[6] != '\0' &&
+         std::strchr(line + 6, ' ') == nullptr;
+    if (ok) result.class_name = line + 6;
+
+    ok = ok && NextLine(file, line, sizeof(line)) &&
+         std::sscanf(line, "vfunc %d %" SCNx32 " %" SCNx32, &result.vfunc_index, &result.vtable_rva,
+                     &result.vfunc_rva) == 3 &&
+         result.vfunc_index >= 0 && result.vfunc_index < memory::kMaxVfuncEntries;
+
+    CameraOffsets& o = result.offsets;
+    ok = ok && NextLine(file, line, sizeof(line)) &&
+         std::sscanf(line, "offsets %zx %zx %zx %f %f %f", &o.yaw_offset, &o.pitch_offset, &o.roll_offset,
+                     &o.yaw_sign, &o.pitch_sign, &o.roll_sign) == 6 &&
+         IsSign(o.yaw_sign) && IsSign(o.pitch_sign) && IsSign(o.roll_sign);
+    o.valid = ok;
+
+    result.layout.group_count = 0;
+    while (ok && NextLine(file, line, sizeof(line))) {
+        if (std::strcmp(line, "end") == 0) {
+            complete = true;
+            break;
+        }
+        if (result.layout.group_count >= LayoutReport::kMaxGroups) {
+            ok = false;
+            break;
+        }
+        FloatGroup& g = result.layout.groups[result.layout.group_count];
+        int type = 0;
+        ok = std::sscanf(line, "group %zx %d %d %f %f %f %f", &g.offset, &type, &g.count, &g.values[0],
+                         &g.values[1], &g.values[2], &g.values[3]) == 7 &&
+             type >= static_cast<int>(FloatClass::Unknown) && type <= static_cast<int>(FloatClass::Quaternion) &&
+             g.count >= 1 && g.count <= 4;
+        g.type = static_cast<FloatClass>(type);
+        result.layout.group_count++;
+    }
+    fclose(file);
+
+    if (!ok || !complete) return false;
+    out = std::move(result);
+    return true;
+}
+
+} // namespace cameraunlock::discovery
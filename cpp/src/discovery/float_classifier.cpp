@@ -4,20 +4,274 @@
 #include <cstring>
 #include <vector>
 
+// SSE2 is baseline on x64; AVX2 is compiled in per-function and only
+// used after a runtime CPUID check, as in the pattern scanner
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CAMERAUNLOCK_FLOAT_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define CAMERAUNLOCK_FLOAT_AVX2 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define CAMERAUNLOCK_TARGET_AVX2
+#else
+#define CAMERAUNLOCK_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
 namespace cameraunlock::discovery {
 
 namespace {
 
-bool IsPlausibleFloat(float f) {
-    return std::isfinite(f) && std::fabsf(f) < 1e10f;
+// Bit the classifier sets on floats already taken by a group; kept out of
+// the range ComputeFloatMasks produces
+constexpr uint16_t kFloatClaimed = 1u << 15;
+
+// Reference for the vector paths; every test must give the same answer
+// for NaN and infinity as the ordered SIMD compares do
+uint16_t ScalarFloatMask(float f) {
+    const float a = std::fabs(f);
+    uint16_t m = 0;
+    if (a < 1e10f) m |= kFloatPlausible;
+    if (a <= 360.0f) m |= kFloatAngleRange;
+    if (a < 360.0f) m |= kFloatBelow360;
+    if (a > 0.001f) m |= kFloatNonZero;
+    if (a > 0.001f && std::fabs(a - 1.0f) > 0.001f) m |= kFloatNonTrivial;
+    if (a > 0.5f) m |= kFloatAboveHalf;
+    if (a > 1.0f) m |= kFloatLarge;
+    if (a < 100000.0f) m |= kFloatWorldRange;
+    if (std::fabs(f - 1.0f) < 0.001f) m |= kFloatIsOne;
+    if (f >= 20.0f && f <= 150.0f) m |= kFloatFovRange;
+    return m;
+}
+
+bool ScalarUnitQuat(const float* f) {
+    const float len2 = f[0] * f[0] + f[1] * f[1] + f[2] * f[2] + f[3] * f[3];
+    return std::fabs(len2 - 1.0f) < 0.01f;
+}
+
+void ScalarFloatMasks(const float* floats, size_t begin, size_t count, uint16_t* masks) {
+    for (size_t i = begin; i < count; i++) {
+        uint16_t m = ScalarFloatMask(floats[i]);
+        if (i + 3 < count && ScalarUnitQuat(floats + i)) m |= kFloatUnitQuat;
+        masks[i] = m;
+    }
+}
+
+size_t ScalarChangedFloats(const float* before, const float* after, size_t begin, size_t count,
+                           float min_delta, uint32_t* indices, size_t found) {
+    for (size_t i = begin; i < count; i++) {
+        if (std::fabs(after[i] - before[i]) > min_delta) indices[found++] = static_cast<uint32_t>(i);
+    }
+    return found;
+}
+
+#ifdef CAMERAUNLOCK_FLOAT_SSE2
+inline unsigned CountTrailingZeros(uint32_t v) {
+#ifdef _MSC_VER
+    unsigned long index = 0;
+    _BitScanForward(&index, v);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctz(v));
+#endif
+}
+
+// Lane-wise bit select: bit where the compare held, 0 elsewhere
+inline __m128i Bit(__m128 cmp, uint16_t bit) {
+    return _mm_and_si128(_mm_castps_si128(cmp), _mm_set1_epi32(bit));
+}
+
+size_t MasksSse2(const float* floats, size_t count, uint16_t* masks) {
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 eps = _mm_set1_ps(0.001f);
+
+    size_t i = 0;
+    // The unit-quaternion test reads 3 floats past each lane
+    for (; i + 4 + 3 <= count; i += 4) {
+        const __m128 f = _mm_loadu_ps(floats + i);
+        const __m128 a = _mm_and_ps(f, absMask);
+        const __m128 nonZero = _mm_cmpgt_ps(a, eps);
+        const __m128 nearUnitAbs = _mm_cmpgt_ps(_mm_and_ps(_mm_sub_ps(a, one), absMask), eps);
+
+        const __m128 f1 = _mm_loadu_ps(floats + i + 1);
+        const __m128 f2 = _mm_loadu_ps(floats + i + 2);
+        const __m128 f3 = _mm_loadu_ps(floats + i + 3);
+        __m128 len2 = _mm_add_ps(_mm_mul_ps(f, f), _mm_mul_ps(f1, f1));
+        len2 = _mm_add_ps(len2, _mm_mul_ps(f2, f2));
+        len2 = _mm_add_ps(len2, _mm_mul_ps(f3, f3));
+
+        __m128i m = Bit(_mm_cmplt_ps(a, _mm_set1_ps(1e10f)), kFloatPlausible);
+        m = _mm_or_si128(m, Bit(_mm_cmple_ps(a, _mm_set1_ps(360.0f)), kFloatAngleRange));
+        m = _mm_or_si128(m, Bit(_mm_cmplt_ps(a, _mm_set1_ps(360.0f)), kFloatBelow360));
+        m = _mm_or_si128(m, Bit(nonZero, kFloatNonZero));
+        m = _mm_or_si128(m, Bit(_mm_and_ps(nonZero, nearUnitAbs), kFloatNonTrivial));
+        m = _mm_or_si128(m, Bit(_mm_cmpgt_ps(a, _mm_set1_ps(0.5f)), kFloatAboveHalf));
+        m = _mm_or_si128(m, Bit(_mm_cmpgt_ps(a, one), kFloatLarge));
+        m = _mm_or_si128(m, Bit(_mm_cmplt_ps(a, _mm_set1_ps(100000.0f)), kFloatWorldRange));
+        m = _mm_or_si128(m, Bit(_mm_cmplt_ps(_mm_and_ps(_mm_sub_ps(f, one), absMask), eps), kFloatIsOne));
+        m = _mm_or_si128(m, Bit(_mm_and_ps(_mm_cmpge_ps(f, _mm_set1_ps(20.0f)),
+                                           _mm_cmple_ps(f, _mm_set1_ps(150.0f))), kFloatFovRange));
+        m = _mm_or_si128(m, Bit(_mm_cmplt_ps(_mm_and_ps(_mm_sub_ps(len2, one), absMask), _mm_set1_ps(0.01f)),
+                                kFloatUnitQuat));
+
+        // Every lane fits in 15 bits, so signed saturation is a plain narrow
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(masks + i), _mm_packs_epi32(m, m));
+    }
+    return i;
+}
+
+size_t ChangedSse2(const float* before, const float* after, size_t count, float min_delta, uint32_t* indices,
+                   size_t& found) {
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    const __m128 threshold = _mm_set1_ps(min_delta);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128 d = _mm_and_ps(_mm_sub_ps(_mm_loadu_ps(after + i), _mm_loadu_ps(before + i)), absMask);
+        int bits = _mm_movemask_ps(_mm_cmpgt_ps(d, threshold));
+        while (bits) {
+            const unsigned lane = CountTrailingZeros(static_cast<uint32_t>(bits));
+            indices[found++] = static_cast<uint32_t>(i + lane);
+            bits &= bits - 1;
+        }
+    }
+    return i;
+}
+#endif
+
+#ifdef CAMERAUNLOCK_FLOAT_AVX2
+CAMERAUNLOCK_TARGET_AVX2
+inline __m256i Bit(__m256 cmp, uint16_t bit) {
+    return _mm256_and_si256(_mm256_castps_si256(cmp), _mm256_set1_epi32(bit));
+}
+
+CAMERAUNLOCK_TARGET_AVX2
+size_t MasksAvx2(const float* floats, size_t count, uint16_t* masks) {
+    const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 eps = _mm256_set1_ps(0.001f);
+
+    size_t i = 0;
+    for (; i + 8 + 3 <= count; i += 8) {
+        const __m256 f = _mm256_loadu_ps(floats + i);
+        const __m256 a = _mm256_and_ps(f, absMask);
+        const __m256 nonZero = _mm256_cmp_ps(a, eps, _CMP_GT_OQ);
+        const __m256 nearUnitAbs = _mm256_cmp_ps(_mm256_and_ps(_mm256_sub_ps(a, one), absMask), eps, _CMP_GT_OQ);
+
+        const __m256 f1 = _mm256_loadu_ps(floats + i + 1);
+        const __m256 f2 = _mm256_loadu_ps(floats + i + 2);
+        const __m256 f3 = _mm256_loadu_ps(floats + i + 3);
+        // Same association as the scalar sum; no FMA so results match exactly
+        __m256 len2 = _mm256_add_ps(_mm256_mul_ps(f, f), _mm256_mul_ps(f1, f1));
+        len2 = _mm256_add_ps(len2, _mm256_mul_ps(f2, f2));
+        len2 = _mm256_add_ps(len2, _mm256_mul_ps(f3, f3));
+
+        __m256i m = Bit(_mm256_cmp_ps(a, _mm256_set1_ps(1e10f), _CMP_LT_OQ), kFloatPlausible);
+        m = _mm256_or_si256(m, Bit(_mm256_cmp_ps(a, _mm256_set1_ps(360.0f), _CMP_LE_OQ), kFloatAngleRange));
+        m = _mm256_or_si256(m, Bit(_mm256_cmp_ps(a, _mm256_set1_ps(360.0f), _CMP_LT_OQ), kFloatBelow360));
+        m = _mm256_or_si256(m, Bit(nonZero, kFloatNonZero));
+        m = _mm256_or_si256(m, Bit(_mm256_and_ps(nonZero, nearUnitAbs), kFloatNonTrivial));
+        m = _mm256_or_si256(m, Bit(_mm256_cmp_ps(a, _mm256_set1_ps(0.5f), _CMP_GT_OQ), kFloatAboveHalf));
+        m = _mm256_or_si256(m, Bit(_mm256_cmp_ps(a, one, _CMP_GT_OQ), kFloatLarge));
+        m = _mm256_or_si256(m, Bit(_mm256_cmp_ps(a, _mm256_set1_ps(100000.0f), _CMP_LT_OQ), kFloatWorldRange));
+        m = _mm256_or_si256(m, Bit(_mm256_cmp_ps(_mm256_and_ps(_mm256_sub_ps(f, one), absMask), eps, _CMP_LT_OQ),
+                                   kFloatIsOne));
+        m = _mm256_or_si256(m, Bit(_mm256_and_ps(_mm256_cmp_ps(f, _mm256_set1_ps(20.0f), _CMP_GE_OQ),
+                                                 _mm256_cmp_ps(f, _mm256_set1_ps(150.0f), _CMP_LE_OQ)),
+                                   kFloatFovRange));
+        m = _mm256_or_si256(m, Bit(_mm256_cmp_ps(_mm256_and_ps(_mm256_sub_ps(len2, one), absMask),
+                                                 _mm256_set1_ps(0.01f), _CMP_LT_OQ),
+                                   kFloatUnitQuat));
+
+        const __m128i packed = _mm_packs_epi32(_mm256_castsi256_si128(m), _mm256_extracti128_si256(m, 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(masks + i), packed);
+    }
+    return i;
+}
+
+CAMERAUNLOCK_TARGET_AVX2
+size_t ChangedAvx2(const float* before, const float* after, size_t count, float min_delta, uint32_t* indices,
+                   size_t& found) {
+    const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+    const __m256 threshold = _mm256_set1_ps(min_delta);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256 d = _mm256_and_ps(_mm256_sub_ps(_mm256_loadu_ps(after + i), _mm256_loadu_ps(before + i)),
+                                       absMask);
+        int bits = _mm256_movemask_ps(_mm256_cmp_ps(d, threshold, _CMP_GT_OQ));
+        while (bits) {
+            const unsigned lane = CountTrailingZeros(static_cast<uint32_t>(bits));
+            indices[found++] = static_cast<uint32_t>(i + lane);
+            bits &= bits - 1;
+        }
+    }
+    return i;
+}
+
+bool DetectAvx2() {
+#ifdef _MSC_VER
+    int regs[4] = {};
+    __cpuid(regs, 0);
+    if (regs[0] < 7) return false;
+    __cpuid(regs, 1);
+    const bool osxsave = (regs[2] & (1 << 27)) != 0;
+    const bool avx = (regs[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx) return false;
+    // OS must save YMM state across context switches
+    if ((_xgetbv(0) & 0x6) != 0x6) return false;
+    __cpuidex(regs, 7, 0);
+    return (regs[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+
+bool HasAvx2() {
+    static const bool supported = DetectAvx2();
+    return supported;
+}
+#endif
+
+// Indices of every float whose |after - before| > min_delta, ascending;
+// indices must hold count entries
+size_t FindChangedFloats(const float* before, const float* after, size_t count, float min_delta,
+                         uint32_t* indices) {
+    size_t found = 0;
+    size_t i = 0;
+#if defined(CAMERAUNLOCK_FLOAT_AVX2)
+    if (HasAvx2()) {
+        i = ChangedAvx2(before, after, count, min_delta, indices, found);
+    } else {
+        i = ChangedSse2(before, after, count, min_delta, indices, found);
+    }
+#elif defined(CAMERAUNLOCK_FLOAT_SSE2)
+    i = ChangedSse2(before, after, count, min_delta, indices, found);
+#endif
+    return ScalarChangedFloats(before, after, i, count, min_delta, indices, found);
 }
 
-bool IsAngleLike(float f) {
-    return std::isfinite(f) && std::fabsf(f) <= 360.0f;
+int CountBits(uint16_t masks0, uint16_t masks1, uint16_t masks2, uint16_t masks3, uint16_t bit) {
+    return ((masks0 & bit) != 0) + ((masks1 & bit) != 0) + ((masks2 & bit) != 0) + ((masks3 & bit) != 0);
 }
 
 } // namespace
 
+void ComputeFloatMasks(const float* floats, size_t count, uint16_t* masks) {
+    size_t i = 0;
+#if defined(CAMERAUNLOCK_FLOAT_AVX2)
+    if (HasAvx2()) i = MasksAvx2(floats, count, masks);
+#endif
+#if defined(CAMERAUNLOCK_FLOAT_SSE2)
+    if (i == 0) i = MasksSse2(floats, count, masks);
+#endif
+    ScalarFloatMasks(floats, i, count, masks);
+}
+
 LayoutReport ClassifyMemoryRegion(const void* region, size_t size) {
     LayoutReport report{};
     report.group_count = 0;
@@ -27,120 +281,137 @@ LayoutReport ClassifyMemoryRegion(const void* region, size_t size) {
     const size_t floatCount = size / sizeof(float);
     const float* floats = static_cast<const float*>(region);
 
-    // Track which offsets have been claimed by a group
-    std::vector<bool> claimed(floatCount, false);
+    // Every range test is done once up front; the passes below only test
+    // bits. kFloatClaimed marks floats already taken by a group.
+    std::vector<uint16_t> masks(floatCount);
+    ComputeFloatMasks(floats, floatCount, masks.data());
+    auto has = [&](size_t i, uint16_t bit) { return (masks[i] & bit) != 0; };
+    auto claim = [&](size_t i) { masks[i] |= kFloatClaimed; };
 
     // Pass 1: Find quaternions (4 consecutive floats with unit length)
     for (size_t i = 0; i + 3 < floatCount && report.group_count < LayoutReport::kMaxGroups; i++) {
-        if (claimed[i]) continue;
-        float a = floats[i], b = floats[i+1], c = floats[i+2], d = floats[i+3];
-        if (!IsPlausibleFloat(a) || !IsPlausibleFloat(b) ||
-            !IsPlausibleFloat(c) || !IsPlausibleFloat(d)) continue;
-
-        float len2 = a*a + b*b + c*c + d*d;
-        if (std::fabsf(len2 - 1.0f) < 0.01f) {
-            // At least one component should be non-trivial (not just 0,0,0,1)
-            int nonzero = 0;
-            if (std::fabsf(a) > 0.001f) nonzero++;
-            if (std::fabsf(b) > 0.001f) nonzero++;
-            if (std::fabsf(c) > 0.001f) nonzero++;
-            if (std::fabsf(d) > 0.001f) nonzero++;
-            if (nonzero >= 2) {
-                auto& g = report.groups[report.group_count++];
-                g.offset = i * sizeof(float);
-                g.type = FloatClass::Quaternion;
-                g.count = 4;
-                g.values[0] = a; g.values[1] = b; g.values[2] = c; g.values[3] = d;
-                claimed[i] = claimed[i+1] = claimed[i+2] = claimed[i+3] = true;
-            }
+        if (has(i, kFloatClaimed)) continue;
+        if (!has(i, kFloatUnitQuat)) continue;
+        if (CountBits(masks[i], masks[i+1], masks[i+2], masks[i+3], kFloatPlausible) != 4) continue;
+
+        // At least one component should be non-trivial (not just 0,0,0,1)
+        if (CountBits(masks[i], masks[i+1], masks[i+2], masks[i+3], kFloatNonZero) >= 2) {
+            auto& g = report.groups[report.group_count++];
+            g.offset = i * sizeof(float);
+            g.type = FloatClass::Quaternion;
+            g.count = 4;
+            std::memcpy(g.values, floats + i, 4 * sizeof(float));
+            claim(i); claim(i+1); claim(i+2); claim(i+3);
         }
     }
 
     // Pass 2: Find positions (3 floats with reasonable world coords, w=1.0 after)
     for (size_t i = 0; i + 3 < floatCount && report.group_count < LayoutReport::kMaxGroups; i++) {
-        if (claimed[i] || claimed[i+1] || claimed[i+2]) continue;
-        float x = floats[i], y = floats[i+1], z = floats[i+2];
-        if (!IsPlausibleFloat(x) || !IsPlausibleFloat(y) || !IsPlausibleFloat(z)) continue;
-
-        // At least one coord has magnitude > 1 (not a normalized vector)
-        bool hasLarge = std::fabsf(x) > 1.0f || std::fabsf(y) > 1.0f || std::fabsf(z) > 1.0f;
-        // All coords in reasonable world range
-        bool inRange = std::fabsf(x) < 100000.0f && std::fabsf(y) < 100000.0f && std::fabsf(z) < 100000.0f;
-        // w=1.0 at the next float (homogeneous coordinate)
-        bool hasW1 = (i + 3 < floatCount) && std::fabsf(floats[i+3] - 1.0f) < 0.001f;
-
-        if (hasLarge && inRange && hasW1) {
+        if (has(i, kFloatClaimed) || has(i+1, kFloatClaimed) || has(i+2, kFloatClaimed)) continue;
+        const uint16_t all = masks[i] & masks[i+1] & masks[i+2];
+        const uint16_t any = masks[i] | masks[i+1] | masks[i+2];
+
+        // Plausible, all in reasonable world range, at least one coord with
+        // magnitude > 1 (not a normalized vector), and w=1.0 at the next float
+        if ((all & kFloatPlausible) && (all & kFloatWorldRange) && (any & kFloatLarge) &&
+            has(i+3, kFloatIsOne)) {
             auto& g = report.groups[report.group_count++];
             g.offset = i * sizeof(float);
             g.type = FloatClass::Position;
             g.count = 3;
-            g.values[0] = x; g.values[1] = y; g.values[2] = z;
-            claimed[i] = claimed[i+1] = claimed[i+2] = true;
-            if (hasW1) claimed[i+3] = true;
+            g.values[0] = floats[i]; g.values[1] = floats[i+1]; g.values[2] = floats[i+2];
+            claim(i); claim(i+1); claim(i+2); claim(i+3);
         }
     }
 
     // Pass 3: Find Euler angle groups (3 consecutive floats in angle range, not all zero)
     for (size_t i = 0; i + 2 < floatCount && report.group_count < LayoutReport::kMaxGroups; i++) {
-        if (claimed[i] || claimed[i+1] || claimed[i+2]) continue;
-        float a = floats[i], b = floats[i+1], c = floats[i+2];
-        if (!IsAngleLike(a) || !IsAngleLike(b) || !IsAngleLike(c)) continue;
+        if (has(i, kFloatClaimed) || has(i+1, kFloatClaimed) || has(i+2, kFloatClaimed)) continue;
+        const uint16_t all = masks[i] & masks[i+1] & masks[i+2];
+        const uint16_t any = masks[i] | masks[i+1] | masks[i+2];
+        if (!(all & kFloatAngleRange)) continue;
 
         // At least one must be nonzero
-        if (std::fabsf(a) < 0.001f && std::fabsf(b) < 0.001f && std::fabsf(c) < 0.001f) continue;
+        if (!(any & kFloatNonZero)) continue;
 
-        // Distinguish from small position values: at least one should be > 1 degree
-        // or all should be < 360 and not look like a tiny position
         // Reject identity matrix basis vectors: groups where all floats are
         // exactly 0.0 or ±1.0 (e.g., (1,0,0), (0,1,0), (0,0,1))
-        bool allTrivial = true;
-        float vals[3] = {a, b, c};
-        for (int k = 0; k < 3; k++) {
-            float absv = std::fabsf(vals[k]);
-            if (absv > 0.001f && std::fabsf(absv - 1.0f) > 0.001f) {
-                allTrivial = false;
-                break;
-            }
-        }
-        if (allTrivial) continue;  // skip — this is a matrix row, not angles
+        if (!(any & kFloatNonTrivial)) continue;
 
-        bool looksLikeAngle = (std::fabsf(a) > 0.5f || std::fabsf(b) > 0.5f || std::fabsf(c) > 0.5f)
-                           && (std::fabsf(a) < 360.0f && std::fabsf(b) < 360.0f && std::fabsf(c) < 360.0f);
-
-        if (looksLikeAngle) {
+        // At least one should be > 0.5 degrees, all strictly inside ±360
+        if ((any & kFloatAboveHalf) && (all & kFloatBelow360)) {
             auto& g = report.groups[report.group_count++];
             g.offset = i * sizeof(float);
             g.type = FloatClass::Angle;
             g.count = 3;
-            g.values[0] = a; g.values[1] = b; g.values[2] = c;
-            claimed[i] = claimed[i+1] = claimed[i+2] = true;
+            g.values[0] = floats[i]; g.values[1] = floats[i+1]; g.values[2] = floats[i+2];
+            claim(i); claim(i+1); claim(i+2);
         }
     }
 
     // Pass 4: Find FOV (single float in 20..150 range, not already claimed)
     for (size_t i = 0; i < floatCount && report.group_count < LayoutReport::kMaxGroups; i++) {
-        if (claimed[i]) continue;
-        float f = floats[i];
-        if (f >= 20.0f && f <= 150.0f) {
-            // Check neighbors aren't also in this range (avoid claiming part of a vector)
-            bool neighborsFOV = false;
-            if (i > 0 && !claimed[i-1] && floats[i-1] >= 20.0f && floats[i-1] <= 150.0f)
-                neighborsFOV = true;
-            if (i+1 < floatCount && !claimed[i+1] && floats[i+1] >= 20.0f && floats[i+1] <= 150.0f)
-                neighborsFOV = true;
-
-            if (!neighborsFOV) {
-                auto& g = report.groups[report.group_count++];
-                g.offset = i * sizeof(float);
-                g.type = FloatClass::FOV;
-                g.count = 1;
-                g.values[0] = f;
-                claimed[i] = true;
-            }
+        if (has(i, kFloatClaimed) || !has(i, kFloatFovRange)) continue;
+
+        // Check neighbors aren't also in this range (avoid claiming part of a vector)
+        bool neighborsFOV = false;
+        if (i > 0 && !has(i-1, kFloatClaimed) && has(i-1, kFloatFovRange))
+            neighborsFOV = true;
+        if (i+1 < floatCount && !has(i+1, kFloatClaimed) && has(i+1, kFloatFovRange))
+            neighborsFOV = true;
+
+        if (!neighborsFOV) {
+            auto& g = report.groups[report.group_count++];
+            g.offset = i * sizeof(float);
+            g.type = FloatClass::FOV;
+            g.count = 1;
+            g.values[0] = floats[i];
+            claim(i);
         }
     }
 
     return report;
 }
 
+size_t DiffFloatSnapshots(const float* before, const float* after, size_t count, float min_delta,
+                          std::vector<FloatChange>& out) {
+    if (!before || !after || count == 0) return 0;
+
+    std::vector<uint32_t> indices(count);
+    const size_t found = FindChangedFloats(before, after, count, min_delta, indices.data());
+    out.reserve(out.size() + found);
+    for (size_t k = 0; k < found; k++) {
+        const uint32_t i = indices[k];
+        out.push_back({i, before[i], after[i]});
+    }
+    return found;
+}
+
+void FloatChangeHeatmap::Reset(size_t float_count, float min_delta) {
+    m_previous.assign(float_count, 0.0f);
+    m_counts.assign(float_count, 0);
+    m_changed.assign(float_count, 0);
+    m_minDelta = min_delta;
+    m_frames = 0;
+    m_primed = false;
+}
+
+void FloatChangeHeatmap::AddSnapshot(const float* floats) {
+    if (!floats || m_previous.empty()) return;
+
+    if (m_primed) {
+        const size_t found = FindChangedFloats(m_previous.data(), floats, m_previous.size(), m_minDelta,
+                                               m_changed.data());
+        for (size_t k = 0; k < found; k++) m_counts[m_changed[k]]++;
+        m_frames++;
+    }
+    std::memcpy(m_previous.data(), floats, m_previous.size() * sizeof(float));
+    m_primed = true;
+}
+
+float FloatChangeHeatmap::GetChangeFrequency(size_t index) const {
+    if (m_frames == 0 || index >= m_counts.size()) return 0.0f;
+    return static_cast<float>(m_counts[index]) / m_frames;
+}
+
 } // namespace cameraunlock::discovery
@@ -0,0 +1,103 @@
+#include <cameraunlock/discovery/probe_stats.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace cameraunlock::discovery {
+
+namespace {
+
+bool Qualifies(const ProbeSlotSummary& s, const ProbeSelectionCriteria& c) {
+    return s.total_calls > 0 && s.Coverage() >= c.min_coverage &&
+           s.mean_per_active >= c.min_per_active && s.mean_per_active <= c.max_per_active &&
+           s.instance_count <= c.max_instances && !s.instance_overflow;
+}
+
+// Lower is better: distance from one call per frame in log space, missed
+// frames, and extra instances all count against a slot
+float Score(const ProbeSlotSummary& s) {
+    const float rate = std::max(s.mean_per_active, 1e-3f);
+    float score = std::fabs(std::log2(rate));
+    score += 2.0f * (1.0f - s.Coverage());
+    score += 0.5f * static_cast<float>(std::max(s.instance_count - 1, 0));
+    if (s.instance_overflow) score += 4.0f;
+    return score;
+}
+
+} // anonymous namespace
+
+void ProbeRateTracker::Reset(int slot_count, int expected_frames) {
+    m_slots = std::max(slot_count, 0);
+    m_frames = 0;
+    m_previous.assign(static_cast<size_t>(m_slots), 0);
+    m_perFrame.clear();
+    m_perFrame.reserve(static_cast<size_t>(m_slots) * static_cast<size_t>(std::max(expected_frames, 0)));
+}
+
+void ProbeRateTracker::SampleFrame(const ProbeSlotCounters* counters) {
+    for (int i = 0; i < m_slots; ++i) {
+        const uint32_t now = counters[i].calls.load(std::memory_order_relaxed);
+        m_perFrame.push_back(now - m_previous[i]);
+        m_previous[i] = now;
+    }
+    ++m_frames;
+}
+
+uint32_t ProbeRateTracker::GetFrameCalls(int slot, int frame) const {
+    if (slot < 0 || slot >= m_slots || frame < 0 || frame >= m_frames) return 0;
+    return m_perFrame[static_cast<size_t>(frame) * m_slots + slot];
+}
+
+ProbeSlotSummary ProbeRateTracker::Summarize(int slot, const ProbeSlotCounters& counters) const {
+    ProbeSlotSummary s;
+    s.frames = m_frames;
+    s.instance_count = counters.GetInstanceCount();
+    s.instance_overflow = counters.instance_overflow.load(std::memory_order_relaxed) != 0;
+    s.last_this = counters.last_this.load(std::memory_order_relaxed);
+    if (slot < 0 || slot >= m_slots) return s;
+
+    for (int f = 0; f < m_frames; ++f) {
+        const uint32_t calls = m_perFrame[static_cast<size_t>(f) * m_slots + slot];
+        s.total_calls += calls;
+        if (calls > 0) ++s.active_frames;
+        s.max_per_frame = std::max(s.max_per_frame, calls);
+    }
+    if (m_frames > 0) s.mean_per_frame = static_cast<float>(s.total_calls) / m_frames;
+    if (s.active_frames > 0) s.mean_per_active = static_cast<float>(s.total_calls) / s.active_frames;
+    return s;
+}
+
+int SelectProbeWinner(const ProbeSlotSummary* summaries, int slot_count, int slots_per_candidate,
+                      const ProbeSelectionCriteria& criteria) {
+    if (slots_per_candidate <= 0) return -1;
+
+    for (int base = 0; base < slot_count; base += slots_per_candidate) {
+        int best = -1;
+        float bestScore = 0.0f;
+        const int end = std::min(base + slots_per_candidate, slot_count);
+        for (int slot = base; slot < end; ++slot) {
+            if (!Qualifies(summaries[slot], criteria)) continue;
+            const float score = Score(summaries[slot]);
+            if (best < 0 || score < bestScore) {
+                best = slot;
+                bestScore = score;
+            }
+        }
+        // Prefer the first (most specific) candidate class with a match
+        if (best >= 0) return best;
+    }
+
+    int best = -1;
+    float bestScore = 0.0f;
+    for (int slot = 0; slot < slot_count; ++slot) {
+        if (summaries[slot].total_calls == 0) continue;
+        const float score = Score(summaries[slot]);
+        if (best < 0 || score < bestScore) {
+            best = slot;
+            bestScore = score;
+        }
+    }
+    return best;
+}
+
+} // namespace cameraunlock::discovery
@@ -0,0 +1,168 @@
+#include <cameraunlock/hooks/detour_stats.h>
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+namespace cameraunlock::hooks {
+
+namespace detail {
+
+std::atomic<uint32_t> g_detourSampleInterval{16};
+
+int AcquireDetourThreadSlot() {
+    static std::atomic<uint32_t> next{0};
+    return static_cast<int>(next.fetch_add(1, std::memory_order_relaxed) % DetourStats::kThreadSlots);
+}
+
+} // namespace detail
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Calibrating the detour clock against steady_clock needs a span long
+// enough that reading the two clocks a few ns apart doesn't matter
+constexpr auto kMinCalibration = std::chrono::milliseconds(20);
+
+struct Entry {
+    DetourStats* stats;
+    std::string name;
+    void* target;
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<Entry> entries;
+    Clock::time_point reset_time = Clock::now();
+    // Calibration anchor, taken at first registration and never written
+    // again, so it is read without the mutex
+    Clock::time_point anchor_time = Clock::now();
+    uint64_t anchor_ticks = ReadDetourClock();
+};
+
+Registry& GetRegistry() {
+    static Registry registry;
+    return registry;
+}
+
+// Detour clock ticks per microsecond, measured once over at least
+// kMinCalibration since the anchor. The first caller may sleep out the rest
+// of that span, so call it before taking the registry mutex.
+double TicksPerMicrosecond() {
+    static const double ticksPerUs = [] {
+        const Registry& registry = GetRegistry();
+        auto elapsed = Clock::now() - registry.anchor_time;
+        if (elapsed < kMinCalibration) {
+            std::this_thread::sleep_for(kMinCalibration - elapsed);
+        }
+        const uint64_t ticks = ReadDetourClock();
+        elapsed = Clock::now() - registry.anchor_time;
+        const double us = std::chrono::duration<double, std::micro>(elapsed).count();
+        return static_cast<double>(ticks - registry.anchor_ticks) / us;
+    }();
+    return ticksPerUs;
+}
+
+} // anonymous namespace
+
+DetourTotals DetourStats::GetTotals() const {
+    DetourTotals totals;
+    for (const auto& slot : m_slots) {
+        totals.calls += slot.calls.load(std::memory_order_relaxed);
+        totals.sampled_calls += slot.sampled_calls.load(std::memory_order_relaxed);
+        totals.total_ticks += slot.total_ticks.load(std::memory_order_relaxed);
+        totals.self_ticks += slot.self_ticks.load(std::memory_order_relaxed);
+    }
+    return totals;
+}
+
+void DetourStats::Reset() {
+    for (auto& slot : m_slots) {
+        slot.calls.store(0, std::memory_order_relaxed);
+        slot.sampled_calls.store(0, std::memory_order_relaxed);
+        slot.total_ticks.store(0, std::memory_order_relaxed);
+        slot.self_ticks.store(0, std::memory_order_relaxed);
+    }
+}
+
+void RegisterDetourStats(DetourStats& stats, const char* name, void* target) {
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (auto& entry : registry.entries) {
+        if (entry.stats == &stats) {
+            entry.name = name ? name : "";
+            entry.target = target;
+            return;
+        }
+    }
+    registry.entries.push_back({&stats, name ? name : "", target});
+}
+
+std::vector<HookStats> CollectDetourStats() {
+    const double ticksPerUs = TicksPerMicrosecond();
+
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    const double wallUs = std::chrono::duration<double, std::micro>(Clock::now() - registry.reset_time).count();
+
+    std::vector<HookStats> report;
+    report.reserve(registry.entries.size());
+    for (const auto& entry : registry.entries) {
+        const DetourTotals totals = entry.stats->GetTotals();
+        HookStats s;
+        s.name = entry.name;
+        s.target = entry.target;
+        s.calls = totals.calls;
+        s.sampled_calls = totals.sampled_calls;
+        if (totals.sampled_calls > 0 && ticksPerUs > 0.0) {
+            const double sampled = static_cast<double>(totals.sampled_calls);
+            s.mean_total_us = static_cast<double>(totals.total_ticks) / ticksPerUs / sampled;
+            s.mean_self_us = static_cast<double>(totals.self_ticks) / ticksPerUs / sampled;
+            // Untimed calls are assumed to cost what the timed ones did
+            s.self_us = s.mean_self_us * static_cast<double>(totals.calls);
+        }
+        if (wallUs > 0.0) s.self_percent = 100.0 * s.self_us / wallUs;
+        report.push_back(std::move(s));
+    }
+
+    std::stable_sort(report.begin(), report.end(),
+                     [](const HookStats& a, const HookStats& b) { return a.self_us > b.self_us; });
+    return report;
+}
+
+void ResetDetourStats() {
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (auto& entry : registry.entries) {
+        entry.stats->Reset();
+    }
+    registry.reset_time = Clock::now();
+}
+
+void SetDetourSampleInterval(uint32_t interval) {
+    detail::g_detourSampleInterval.store(interval, std::memory_order_relaxed);
+}
+
+uint32_t GetDetourSampleInterval() {
+    return detail::g_detourSampleInterval.load(std::memory_order_relaxed);
+}
+
+std::string FormatHookStats(const std::vector<HookStats>& stats) {
+    std::string out;
+    char line[256];
+    snprintf(line, sizeof(line), "%-24s %12s %10s %10s %10s %12s %7s\n", "hook", "calls", "timed", "total us",
+             "self us", "self ms", "self %");
+    out += line;
+    for (const auto& s : stats) {
+        snprintf(line, sizeof(line), "%-24.24s %12" PRIu64 " %10" PRIu64 " %10.2f %10.2f %12.3f %7.3f\n",
+                 s.name.empty() ? "(unnamed)" : s.name.c_str(), s.calls, s.sampled_calls, s.mean_total_us,
+                 s.mean_self_us, s.self_us / 1000.0, s.self_percent);
+        out += line;
+    }
+    return out;
+}
+
+} // namespace cameraunlock::hooks
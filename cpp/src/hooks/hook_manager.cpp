@@ -4,8 +4,6 @@
 // Users should ensure MinHook is linked when using this module
 #include <MinHook.h>
 
-#include <algorithm>
-
 namespace cameraunlock::hooks {
 
 namespace {
@@ -78,6 +76,8 @@ void HookManager::Shutdown() {
     MH_Uninitialize();
 
     m_hooks.clear();
+    m_pendingRemovals.clear();
+    m_batchDepth = 0;
     m_initialized = false;
 }
 
@@ -91,7 +91,7 @@ HookStatus HookManager::CreateHook(void* target, void* detour, void** original)
         return FromMHStatus(status);
     }
 
-    m_hooks.push_back(target);
+    m_hooks.insert(target);
     return HookStatus::Ok;
 }
 
@@ -100,16 +100,23 @@ HookStatus HookManager::RemoveHook(void* target) {
         return HookStatus::ErrorNotInitialized;
     }
 
+    if (m_batchDepth > 0) {
+        // Removing an enabled hook makes MinHook suspend threads on its
+        // own, so queue the disable and remove after the batch applies
+        if (m_hooks.find(target) == m_hooks.end()) {
+            return HookStatus::ErrorNotCreated;
+        }
+        MH_QueueDisableHook(target);
+        m_pendingRemovals.push_back(target);
+        return HookStatus::Ok;
+    }
+
     MH_STATUS status = MH_RemoveHook(target);
     if (status != MH_OK) {
         return FromMHStatus(status);
     }
 
-    auto it = std::find(m_hooks.begin(), m_hooks.end(), target);
-    if (it != m_hooks.end()) {
-        m_hooks.erase(it);
-    }
-
+    m_hooks.erase(target);
     return HookStatus::Ok;
 }
 
@@ -118,6 +125,9 @@ HookStatus HookManager::EnableHook(void* target) {
         return HookStatus::ErrorNotInitialized;
     }
 
+    if (m_batchDepth > 0) {
+        return FromMHStatus(MH_QueueEnableHook(target));
+    }
     return FromMHStatus(MH_EnableHook(target));
 }
 
@@ -126,9 +136,47 @@ HookStatus HookManager::DisableHook(void* target) {
         return HookStatus::ErrorNotInitialized;
     }
 
+    if (m_batchDepth > 0) {
+        return FromMHStatus(MH_QueueDisableHook(target));
+    }
     return FromMHStatus(MH_DisableHook(target));
 }
 
+HookStatus HookManager::BeginBatch() {
+    if (!m_initialized) {
+        return HookStatus::ErrorNotInitialized;
+    }
+
+    ++m_batchDepth;
+    return HookStatus::Ok;
+}
+
+HookStatus HookManager::Commit() {
+    if (!m_initialized) {
+        return HookStatus::ErrorNotInitialized;
+    }
+    if (m_batchDepth == 0) {
+        return HookStatus::Ok;
+    }
+    if (--m_batchDepth > 0) {
+        return HookStatus::Ok;
+    }
+
+    MH_STATUS status = MH_ApplyQueued();
+
+    for (void* target : m_pendingRemovals) {
+        // A hook can be queued for removal twice; the second is a no-op
+        if (m_hooks.erase(target) == 0) continue;
+        MH_STATUS removed = MH_RemoveHook(target);
+        if (status == MH_OK && removed != MH_OK) {
+            status = removed;
+        }
+    }
+    m_pendingRemovals.clear();
+
+    return FromMHStatus(status);
+}
+
 HookStatus HookManager::EnableAllHooks() {
     if (!m_initialized) {
         return HookStatus::ErrorNotInitialized;
@@ -150,11 +198,13 @@ void HookManager::RemoveAllHooks() {
         return;
     }
 
+    // One suspension pass for the lot; removing disabled hooks needs none
+    MH_DisableHook(MH_ALL_HOOKS);
     for (void* target : m_hooks) {
-        MH_DisableHook(target);
         MH_RemoveHook(target);
     }
     m_hooks.clear();
+    m_pendingRemovals.clear();
 }
 
 // ScopedHook implementation
@@ -1,4 +1,7 @@
 #include <cameraunlock/input/hotkey_poller.h>
+#include <cameraunlock/runtime/runtime.h>
+
+#include <algorithm>
 
 #ifdef _WIN32
 #include <Windows.h>
@@ -8,72 +11,156 @@ namespace cameraunlock::input {
 
 constexpr int kKeyPressedMask = 0x8000;
 
+namespace {
+
+// Toggle/recenter ids, outside the AddHotkey range
+constexpr int kToggleId = -1;
+constexpr int kRecenterId = -2;
+
+// Generic and sided virtual key codes per modifier (the keyboard hook
+// reports sided codes, GetAsyncKeyState answers for either)
+struct ModifierKeys {
+    uint32_t flag;
+    uint8_t keys[3];
+};
+constexpr ModifierKeys kModifierKeys[] = {
+    {Modifier::Ctrl, {0x11, 0xA2, 0xA3}},   // VK_CONTROL, VK_LCONTROL, VK_RCONTROL
+    {Modifier::Shift, {0x10, 0xA0, 0xA1}},  // VK_SHIFT, VK_LSHIFT, VK_RSHIFT
+    {Modifier::Alt, {0x12, 0xA4, 0xA5}},    // VK_MENU, VK_LMENU, VK_RMENU
+    {Modifier::Win, {0x5B, 0x5C, 0x5B}},    // VK_LWIN, VK_RWIN
+};
+
+int CountModifiers(uint32_t modifiers) {
+    int count = 0;
+    for (; modifiers; modifiers &= modifiers - 1) ++count;
+    return count;
+}
+
+#ifdef _WIN32
+// Poller that owns the hook on this thread (the hook proc has no user data)
+thread_local HotkeyPoller* t_hookOwner = nullptr;
+thread_local void (*t_hookEvent)(HotkeyPoller*, int, bool) = nullptr;
+
+LRESULT CALLBACK LowLevelKeyboardProc(int code, WPARAM wParam, LPARAM lParam) {
+    if (code == HC_ACTION && t_hookOwner) {
+        const auto* info = reinterpret_cast<const KBDLLHOOKSTRUCT*>(lParam);
+        const bool down = wParam == WM_KEYDOWN || wParam == WM_SYSKEYDOWN;
+        const bool up = wParam == WM_KEYUP || wParam == WM_SYSKEYUP;
+        if ((down || up) && info->vkCode < 256) {
+            t_hookEvent(t_hookOwner, static_cast<int>(info->vkCode), down);
+        }
+    }
+    return CallNextHookEx(nullptr, code, wParam, lParam);
+}
+#endif
+
+}  // namespace
+
 HotkeyPoller::~HotkeyPoller() {
     Stop();
 }
 
 HotkeyPoller::HotkeyPoller(HotkeyPoller&& other) noexcept {
-    // Stop the other's thread first
-    other.Stop();
-
-    m_toggleKey.store(other.m_toggleKey.load());
-    m_recenterKey.store(other.m_recenterKey.load());
-    m_pollInterval.store(other.m_pollInterval.load());
-    m_toggleCallback = std::move(other.m_toggleCallback);
-    m_recenterCallback = std::move(other.m_recenterCallback);
-
-    std::lock_guard<std::mutex> lock(other.m_hotkeyMutex);
-    m_hotkeys = std::move(other.m_hotkeys);
-    m_nextHotkeyId = other.m_nextHotkeyId;
+    MoveFrom(other);
 }
 
 HotkeyPoller& HotkeyPoller::operator=(HotkeyPoller&& other) noexcept {
     if (this != &other) {
         Stop();
-        other.Stop();
-
-        m_toggleKey.store(other.m_toggleKey.load());
-        m_recenterKey.store(other.m_recenterKey.load());
-        m_pollInterval.store(other.m_pollInterval.load());
-        m_toggleCallback = std::move(other.m_toggleCallback);
-        m_recenterCallback = std::move(other.m_recenterCallback);
-
-        std::lock_guard<std::mutex> lock(other.m_hotkeyMutex);
-        m_hotkeys = std::move(other.m_hotkeys);
-        m_nextHotkeyId = other.m_nextHotkeyId;
+        MoveFrom(other);
     }
     return *this;
 }
 
+void HotkeyPoller::MoveFrom(HotkeyPoller& other) {
+    // Stop the other's thread first
+    other.Stop();
+    m_pollInterval.store(other.m_pollInterval.load());
+
+    std::lock_guard<std::mutex> otherLock(other.m_registryMutex);
+    std::lock_guard<std::mutex> lock(m_registryMutex);
+    m_toggle = std::move(other.m_toggle);
+    m_recenter = std::move(other.m_recenter);
+    m_hotkeys = std::move(other.m_hotkeys);
+    m_nextHotkeyId = other.m_nextHotkeyId;
+    m_toggleKey.store(m_toggle.vkCode);
+    m_recenterKey.store(m_recenter.vkCode);
+    PublishLocked();
+}
+
 void HotkeyPoller::SetToggleKey(int vkCode, HotkeyCallback callback) {
+    std::lock_guard<std::mutex> lock(m_registryMutex);
+    m_toggle = {kToggleId, vkCode, Modifier::None, std::move(callback)};
     m_toggleKey.store(vkCode);
-    std::lock_guard<std::mutex> lock(m_callbackMutex);
-    m_toggleCallback = std::move(callback);
+    PublishLocked();
 }
 
 void HotkeyPoller::SetRecenterKey(int vkCode, HotkeyCallback callback) {
+    std::lock_guard<std::mutex> lock(m_registryMutex);
+    m_recenter = {kRecenterId, vkCode, Modifier::None, std::move(callback)};
     m_recenterKey.store(vkCode);
-    std::lock_guard<std::mutex> lock(m_callbackMutex);
-    m_recenterCallback = std::move(callback);
+    PublishLocked();
 }
 
-int HotkeyPoller::AddHotkey(int vkCode, HotkeyCallback callback) {
-    std::lock_guard<std::mutex> lock(m_hotkeyMutex);
+int HotkeyPoller::AddHotkey(int vkCode, HotkeyCallback callback, uint32_t modifiers) {
+    std::lock_guard<std::mutex> lock(m_registryMutex);
     int id = m_nextHotkeyId++;
-    m_hotkeys.push_back({id, vkCode, false, std::move(callback)});
+    m_hotkeys.push_back({id, vkCode, modifiers, std::move(callback)});
+    PublishLocked();
     return id;
 }
 
 void HotkeyPoller::RemoveHotkey(int id) {
-    std::lock_guard<std::mutex> lock(m_hotkeyMutex);
+    std::lock_guard<std::mutex> lock(m_registryMutex);
     auto it = std::find_if(m_hotkeys.begin(), m_hotkeys.end(),
         [id](const HotkeyEntry& entry) { return entry.id == id; });
     if (it != m_hotkeys.end()) {
         m_hotkeys.erase(it);
+        PublishLocked();
     }
 }
 
-bool HotkeyPoller::Start(int pollIntervalMs) {
+void HotkeyPoller::SetToggleKeyCode(int vkCode) {
+    std::lock_guard<std::mutex> lock(m_registryMutex);
+    m_toggle.id = kToggleId;
+    m_toggle.vkCode = vkCode;
+    m_toggleKey.store(vkCode);
+    PublishLocked();
+}
+
+void HotkeyPoller::SetRecenterKeyCode(int vkCode) {
+    std::lock_guard<std::mutex> lock(m_registryMutex);
+    m_recenter.id = kRecenterId;
+    m_recenter.vkCode = vkCode;
+    m_recenterKey.store(vkCode);
+    PublishLocked();
+}
+
+void HotkeyPoller::PublishLocked() {
+    HotkeyTable table;
+    bool anyModifiers = false;
+    auto add = [&](const HotkeyEntry& entry) {
+        if (entry.vkCode <= 0 || entry.vkCode >= 256 || !entry.callback) return;
+        table.bindings.push_back(entry);
+        table.keys.push_back(static_cast<uint8_t>(entry.vkCode));
+        anyModifiers = anyModifiers || entry.modifiers != Modifier::None;
+    };
+    add(m_toggle);
+    add(m_recenter);
+    for (const auto& entry : m_hotkeys) {
+        add(entry);
+    }
+    if (anyModifiers) {
+        for (const auto& modifier : kModifierKeys) {
+            table.keys.insert(table.keys.end(), std::begin(modifier.keys), std::end(modifier.keys));
+        }
+    }
+    std::sort(table.keys.begin(), table.keys.end());
+    table.keys.erase(std::unique(table.keys.begin(), table.keys.end()), table.keys.end());
+    m_table.Publish(table);
+}
+
+bool HotkeyPoller::Start(int pollIntervalMs, const ThreadSchedulingOptions& scheduling) {
     if (m_running.load()) {
         return true;
     }
@@ -81,89 +168,268 @@ bool HotkeyPoller::Start(int pollIntervalMs) {
     m_pollInterval.store(pollIntervalMs);
     m_stopFlag.store(false);
     m_running.store(true);
+    m_backend.store(HotkeyBackend::Polling);
+    m_thread = StartScheduledThread(scheduling, m_schedulingResult, [this]() { PollLoop(); });
+    return true;
+}
 
-    // Reset key states
-    m_toggleKeyDown.store(false);
-    m_recenterKeyDown.store(false);
-    {
-        std::lock_guard<std::mutex> lock(m_hotkeyMutex);
-        for (auto& entry : m_hotkeys) {
-            entry.keyDown = false;
-        }
+bool HotkeyPoller::StartKeyboardHook(const ThreadSchedulingOptions& scheduling) {
+#ifdef _WIN32
+    if (m_running.load()) {
+        return m_backend.load() == HotkeyBackend::KeyboardHook;
     }
 
-    m_thread = std::thread(&HotkeyPoller::PollLoop, this);
+    m_stopFlag.store(false);
+    std::promise<bool> started;
+    std::future<bool> result = started.get_future();
+    m_running.store(true);
+    m_backend.store(HotkeyBackend::KeyboardHook);
+    m_thread = StartScheduledThread(scheduling, m_schedulingResult, [this, &started]() { HookLoop(started); });
+
+    if (!result.get()) {
+        m_thread.join();
+        m_backend.store(HotkeyBackend::None);
+        m_running.store(false);
+        return false;
+    }
+    return true;
+#else
+    (void)scheduling;
+    return false;
+#endif
+}
+
+bool HotkeyPoller::Start(Runtime& runtime, int pollIntervalMs) {
+    if (m_running.load()) {
+        return true;
+    }
+
+    m_pollInterval.store(pollIntervalMs);
+    m_stopFlag.store(false);
+    m_running.store(true);
+    m_backend.store(HotkeyBackend::Polling);
+    m_runtime = &runtime;
+    runtime.Call([this, &runtime]() {
+        m_schedulingResult.Set(runtime.GetSchedulingResult());
+        ResetKeyState();
+    });
+    m_runtimeTimer = runtime.AddTimer(pollIntervalMs, pollIntervalMs, [this]() { PollKeys(); });
     return true;
 }
 
+bool HotkeyPoller::StartKeyboardHook(Runtime& runtime) {
+#ifdef _WIN32
+    if (m_running.load()) {
+        return m_backend.load() == HotkeyBackend::KeyboardHook;
+    }
+
+    // Only a running loop pumps messages for the hook
+    if (!runtime.IsRunning()) {
+        return false;
+    }
+    bool installed = false;
+    runtime.Call([this, &runtime, &installed]() {
+        m_schedulingResult.Set(runtime.GetSchedulingResult());
+        ResetKeyState();
+        installed = InstallHook();
+    });
+    if (!installed) {
+        return false;
+    }
+
+    m_stopFlag.store(false);
+    m_runtime = &runtime;
+    m_backend.store(HotkeyBackend::KeyboardHook);
+    m_running.store(true);
+    return true;
+#else
+    (void)runtime;
+    return false;
+#endif
+}
+
 void HotkeyPoller::Stop() {
     if (!m_running.load()) {
         return;
     }
 
     m_stopFlag.store(true);
+    if (m_runtime) {
+        Runtime* runtime = m_runtime;
+        runtime->Call([this, runtime]() {
+            runtime->Remove(m_runtimeTimer);
+            RemoveHook();
+        });
+        m_runtimeTimer = 0;
+        m_runtime = nullptr;
+        m_backend.store(HotkeyBackend::None);
+        m_running.store(false);
+        return;
+    }
+#ifdef _WIN32
+    if (m_backend.load() == HotkeyBackend::KeyboardHook) {
+        PostThreadMessageW(m_hookThreadId.load(), WM_QUIT, 0, 0);
+    }
+#endif
 
     if (m_thread.joinable()) {
         m_thread.join();
     }
 
+    m_backend.store(HotkeyBackend::None);
     m_running.store(false);
 }
 
-void HotkeyPoller::SetToggleKeyCode(int vkCode) {
-    m_toggleKey.store(vkCode);
+void HotkeyPoller::ResetKeyState() {
+    std::fill(std::begin(m_keyDown), std::end(m_keyDown), false);
 }
 
-void HotkeyPoller::SetRecenterKeyCode(int vkCode) {
-    m_recenterKey.store(vkCode);
-}
+void HotkeyPoller::PollLoop() {
+    ResetKeyState();
+    while (!m_stopFlag.load()) {
+        PollKeys();
 
-void HotkeyPoller::CheckKey(int vkCode, std::atomic<bool>& keyDown, const HotkeyCallback& callback) {
-    if (vkCode == 0 || !callback) return;
+        int interval = m_pollInterval.load();
+        std::this_thread::sleep_for(std::chrono::milliseconds(interval));
+    }
+}
 
+void HotkeyPoller::HookLoop(std::promise<bool>& started) {
 #ifdef _WIN32
-    bool pressed = (GetAsyncKeyState(vkCode) & kKeyPressedMask) != 0;
-    if (pressed && !keyDown.load()) {
-        keyDown.store(true);
-        callback();
-    } else if (!pressed && keyDown.load()) {
-        keyDown.store(false);
+    ResetKeyState();
+
+    // Create the message queue before publishing the thread id, so Stop's
+    // WM_QUIT can't be posted to a thread without one
+    MSG msg;
+    PeekMessageW(&msg, nullptr, WM_USER, WM_USER, PM_NOREMOVE);
+    m_hookThreadId.store(GetCurrentThreadId());
+
+    const bool installed = InstallHook();
+    started.set_value(installed);
+    if (!installed) {
+        return;
+    }
+
+    // The hook proc is called from inside GetMessage; nothing else wakes us
+    while (GetMessageW(&msg, nullptr, 0, 0) > 0) {
+        TranslateMessage(&msg);
+        DispatchMessageW(&msg);
     }
+
+    RemoveHook();
+    m_hookThreadId.store(0);
+#else
+    started.set_value(false);
 #endif
 }
 
-void HotkeyPoller::PollLoop() {
-    while (!m_stopFlag.load()) {
-        Poll();
+bool HotkeyPoller::InstallHook() {
+#ifdef _WIN32
+    // The hook proc finds its poller through the thread; one per thread
+    if (t_hookOwner) {
+        return false;
+    }
 
-        int interval = m_pollInterval.load();
-        std::this_thread::sleep_for(std::chrono::milliseconds(interval));
+    // The hook must name the module containing the hook proc (this DLL)
+    HMODULE module = nullptr;
+    GetModuleHandleExW(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+                       reinterpret_cast<LPCWSTR>(&LowLevelKeyboardProc), &module);
+
+    t_hookOwner = this;
+    t_hookEvent = [](HotkeyPoller* owner, int vkCode, bool down) { owner->OnKeyEvent(vkCode, down); };
+    HHOOK hook = SetWindowsHookExW(WH_KEYBOARD_LL, LowLevelKeyboardProc, module, 0);
+    if (!hook) {
+        t_hookOwner = nullptr;
+        return false;
     }
+    m_hook = hook;
+    return true;
+#else
+    return false;
+#endif
 }
 
-void HotkeyPoller::Poll() {
-    // Check built-in keys under callback lock (avoids copying std::function)
-    {
-        std::lock_guard<std::mutex> lock(m_callbackMutex);
-        CheckKey(m_toggleKey.load(), m_toggleKeyDown, m_toggleCallback);
-        CheckKey(m_recenterKey.load(), m_recenterKeyDown, m_recenterCallback);
+void HotkeyPoller::RemoveHook() {
+#ifdef _WIN32
+    if (m_hook) {
+        UnhookWindowsHookEx(static_cast<HHOOK>(m_hook));
+        m_hook = nullptr;
+        t_hookOwner = nullptr;
     }
+#endif
+}
+
+void HotkeyPoller::Poll() {
+    if (m_running.load(std::memory_order_relaxed)) return;
+    PollKeys();
+}
+
+void HotkeyPoller::ProcessKeyEvent(int vkCode, bool down) {
+    if (m_running.load(std::memory_order_relaxed)) return;
+    OnKeyEvent(vkCode, down);
+}
 
-    // Check generic hotkeys
-    {
-        std::lock_guard<std::mutex> lock(m_hotkeyMutex);
-        for (auto& entry : m_hotkeys) {
-            if (entry.vkCode == 0 || !entry.callback) continue;
+void HotkeyPoller::PollKeys() {
+    // One acquire load unless the bindings changed
+    m_table.ReadIfChanged(m_activeVersion, m_active);
+    if (m_active.keys.empty()) return;
 
 #ifdef _WIN32
-            bool pressed = (GetAsyncKeyState(entry.vkCode) & kKeyPressedMask) != 0;
-            if (pressed && !entry.keyDown) {
-                entry.keyDown = true;
-                entry.callback();
-            } else if (!pressed && entry.keyDown) {
-                entry.keyDown = false;
-            }
+    // Sample every key first so modifiers are current when a key fires
+    uint8_t pressedEdges[256];
+    size_t edgeCount = 0;
+    for (uint8_t key : m_active.keys) {
+        const bool pressed = (GetAsyncKeyState(key) & kKeyPressedMask) != 0;
+        if (pressed && !m_keyDown[key]) {
+            pressedEdges[edgeCount++] = key;
+        }
+        m_keyDown[key] = pressed;
+    }
+    for (size_t i = 0; i < edgeCount; ++i) {
+        FireKeyDown(pressedEdges[i]);
+    }
 #endif
+}
+
+void HotkeyPoller::OnKeyEvent(int vkCode, bool down) {
+    if (vkCode <= 0 || vkCode >= 256) return;
+    m_table.ReadIfChanged(m_activeVersion, m_active);
+
+    bool& wasDown = m_keyDown[vkCode];
+    if (down && !wasDown) {
+        wasDown = true;
+        FireKeyDown(vkCode);
+    } else if (!down) {
+        wasDown = false;
+    }
+}
+
+uint32_t HotkeyPoller::HeldModifiers() const {
+    uint32_t held = Modifier::None;
+    for (const auto& modifier : kModifierKeys) {
+        for (uint8_t key : modifier.keys) {
+            if (m_keyDown[key]) held |= modifier.flag;
+        }
+    }
+    return held;
+}
+
+void HotkeyPoller::FireKeyDown(int vkCode) {
+    const uint32_t held = HeldModifiers();
+
+    // Most specific match wins: only bindings needing the most modifiers fire
+    int best = -1;
+    for (const auto& entry : m_active.bindings) {
+        if (entry.vkCode == vkCode && (entry.modifiers & ~held) == 0) {
+            best = std::max(best, CountModifiers(entry.modifiers));
+        }
+    }
+    if (best < 0) return;
+
+    for (const auto& entry : m_active.bindings) {
+        if (entry.vkCode == vkCode && (entry.modifiers & ~held) == 0 &&
+            CountModifiers(entry.modifiers) == best) {
+            entry.callback();
         }
     }
 }
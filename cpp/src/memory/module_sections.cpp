@@ -0,0 +1,150 @@
+#include <cameraunlock/memory/module_sections.h>
+#include <cameraunlock/memory/pattern_scanner.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace cameraunlock::memory {
+
+namespace {
+
+// Offsets into the on-disk/in-memory PE header layout
+constexpr size_t kDosLfanewOffset = 0x3C;
+constexpr size_t kFileHeaderSize = 20;
+constexpr size_t kSectionHeaderSize = 40;
+constexpr uint16_t kOptionalMagicPe32 = 0x10B;
+constexpr uint16_t kOptionalMagicPe32Plus = 0x20B;
+
+// Headers are hashed up to this many bytes; SizeOfHeaders is normally 0x400
+constexpr size_t kMaxHashedHeaderBytes = 4096;
+
+template <typename T>
+bool ReadAt(uintptr_t base, size_t size, size_t offset, T& out) {
+    if (offset > size || size - offset < sizeof(T)) return false;
+    std::memcpy(&out, reinterpret_cast<const void*>(base + offset), sizeof(T));
+    return true;
+}
+
+// Validates the DOS/NT signatures and returns the optional header offset
+bool FindOptionalHeader(uintptr_t base, size_t size, size_t& fileHeader, size_t& optionalHeader) {
+    uint16_t dosMagic = 0;
+    uint32_t lfanew = 0;
+    if (!ReadAt(base, size, 0, dosMagic) || dosMagic != 0x5A4D) return false;  // "MZ"
+    if (!ReadAt(base, size, kDosLfanewOffset, lfanew)) return false;
+
+    uint32_t peSignature = 0;
+    if (!ReadAt(base, size, lfanew, peSignature) || peSignature != 0x00004550) return false;  // "PE\0\0"
+
+    fileHeader = static_cast<size_t>(lfanew) + 4;
+    optionalHeader = fileHeader + kFileHeaderSize;
+    uint16_t optionalMagic = 0;
+    if (!ReadAt(base, size, optionalHeader, optionalMagic)) return false;
+    return optionalMagic == kOptionalMagicPe32 || optionalMagic == kOptionalMagicPe32Plus;
+}
+
+} // anonymous namespace
+
+bool SectionMatches(const ModuleSection& section, const SectionFilter& filter) {
+    if (!filter.name.empty() && filter.name != std::string_view(section.name)) return false;
+    if ((section.characteristics & filter.required) != filter.required) return false;
+    if ((section.characteristics & filter.excluded) != 0) return false;
+    return true;
+}
+
+bool GetImageSections(uintptr_t base, size_t size, std::vector<ModuleSection>& out) {
+    out.clear();
+    if (base == 0) return false;
+
+    size_t fileHeader = 0;
+    size_t optionalHeader = 0;
+    if (!FindOptionalHeader(base, size, fileHeader, optionalHeader)) return false;
+
+    uint16_t sectionCount = 0;
+    uint16_t optionalSize = 0;
+    if (!ReadAt(base, size, fileHeader + 2, sectionCount)) return false;
+    if (!ReadAt(base, size, fileHeader + 16, optionalSize)) return false;
+
+    const size_t table = optionalHeader + optionalSize;
+    if (table > size || (size - table) / kSectionHeaderSize < sectionCount) return false;
+
+    out.reserve(sectionCount);
+    for (uint16_t i = 0; i < sectionCount; ++i) {
+        const size_t header = table + static_cast<size_t>(i) * kSectionHeaderSize;
+        uint32_t virtualSize = 0;
+        uint32_t virtualAddress = 0;
+        uint32_t rawSize = 0;
+        uint32_t characteristics = 0;
+        ReadAt(base, size, header + 8, virtualSize);
+        ReadAt(base, size, header + 12, virtualAddress);
+        ReadAt(base, size, header + 16, rawSize);
+        ReadAt(base, size, header + 36, characteristics);
+
+        // Linkers may leave VirtualSize zero in object-style images
+        size_t mapped = virtualSize ? virtualSize : rawSize;
+        if (virtualAddress >= size) continue;
+        mapped = std::min(mapped, size - virtualAddress);
+        if (mapped == 0) continue;
+
+        ModuleSection section = {};
+        std::memcpy(section.name, reinterpret_cast<const void*>(base + header), 8);
+        section.name[8] = '\0';
+        section.base = base + virtualAddress;
+        section.size = mapped;
+        section.characteristics = characteristics;
+        out.push_back(section);
+    }
+
+    std::sort(out.begin(), out.end(), [](const ModuleSection& a, const ModuleSection& b) {
+        return a.base < b.base;
+    });
+    return true;
+}
+
+bool GetImageIdentity(uintptr_t base, size_t size, ModuleIdentity& out) {
+    out = ModuleIdentity{};
+    if (base == 0) return false;
+
+    size_t fileHeader = 0;
+    size_t optionalHeader = 0;
+    if (!FindOptionalHeader(base, size, fileHeader, optionalHeader)) return false;
+
+    // SizeOfImage, SizeOfHeaders and CheckSum sit at the same offsets in
+    // PE32 and PE32+ optional headers
+    uint32_t headerSize = 0;
+    if (!ReadAt(base, size, fileHeader + 4, out.time_date_stamp)) return false;
+    if (!ReadAt(base, size, optionalHeader + 56, out.size_of_image)) return false;
+    if (!ReadAt(base, size, optionalHeader + 60, headerSize)) return false;
+    if (!ReadAt(base, size, optionalHeader + 64, out.checksum)) return false;
+
+    // The loader rewrites ImageBase whenever ASLR relocates the image, so
+    // it hashes as zero: 8 bytes at +24 in PE32+, 4 bytes at +28 in PE32
+    uint16_t optionalMagic = 0;
+    ReadAt(base, size, optionalHeader, optionalMagic);
+    const size_t imageBaseStart = optionalHeader + (optionalMagic == kOptionalMagicPe32Plus ? 24 : 28);
+    const size_t imageBaseEnd = optionalHeader + 32;
+
+    // FNV-1a over the mapped headers
+    const size_t hashed = std::min<size_t>({headerSize, size, kMaxHashedHeaderBytes});
+    const auto* bytes = reinterpret_cast<const uint8_t*>(base);
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < hashed; ++i) {
+        const uint8_t byte = (i >= imageBaseStart && i < imageBaseEnd) ? 0 : bytes[i];
+        hash = (hash ^ byte) * 16777619u;
+    }
+    out.header_hash = hash;
+    return true;
+}
+
+bool GetModuleSections(void* module, std::vector<ModuleSection>& out) {
+    uintptr_t base = 0;
+    size_t size = 0;
+
+    if (!GetModuleRange(module, base, size)) {
+        out.clear();
+        return false;
+    }
+
+    return GetImageSections(base, size, out);
+}
+
+} // namespace cameraunlock::memory
@@ -1,14 +1,37 @@
 #include <cameraunlock/memory/pattern_scanner.h>
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
 #include <vector>
 #include <cctype>
+#include <cstdlib>
 #include <cstring>
+#include <utility>
 
 #ifdef _WIN32
 #include <Psapi.h>
 #pragma comment(lib, "psapi.lib")
 #endif
 
+// SSE2 is baseline on x64; AVX2 is compiled in per-function and only
+// used after a runtime CPUID check, so the library still loads on old CPUs
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CAMERAUNLOCK_SCAN_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define CAMERAUNLOCK_SCAN_AVX2 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define CAMERAUNLOCK_TARGET_AVX2
+#else
+#define CAMERAUNLOCK_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
 namespace cameraunlock::memory {
 
 namespace {
@@ -55,16 +78,297 @@ bool ParsePattern(std::string_view pattern, std::vector<uint8_t>& bytes, std::ve
     return !bytes.empty();
 }
 
-// Match pattern at a specific address
-bool MatchPattern(const uint8_t* data, const uint8_t* pattern, const char* mask, size_t length) {
-    for (size_t i = 0; i < length; ++i) {
-        if (mask[i] == 'x' && data[i] != pattern[i]) {
+void ChooseAnchors(CompiledPattern& out) {
+    ChoosePatternAnchors(out.bytes.data(), out.care.data(), out.bytes.size(), out.anchor, out.second,
+                         out.has_anchor);
+}
+
+inline unsigned CountTrailingZeros(uint32_t v) {
+#ifdef _MSC_VER
+    unsigned long index = 0;
+    _BitScanForward(&index, v);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctz(v));
+#endif
+}
+
+// Full compare of a candidate, 16 bytes at a time where available
+bool VerifyCandidate(const uint8_t* data, const PatternView& p) {
+    size_t i = 0;
+#ifdef CAMERAUNLOCK_SCAN_SSE2
+    for (; i + 16 <= p.length; i += 16) {
+        const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p.bytes + i));
+        const __m128i m = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p.care + i));
+        const __m128i diff = _mm_and_si128(_mm_xor_si128(d, b), m);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(diff, _mm_setzero_si128())) != 0xFFFF) {
             return false;
         }
     }
+#endif
+    for (; i < p.length; ++i) {
+        if ((data[i] ^ p.bytes[i]) & p.care[i]) return false;
+    }
     return true;
 }
 
+// Candidate start positions are [start, last]. Every vector load below
+// reads at most last + anchor + width - 1 < start + size, so no helper
+// reads past the end of the range.
+const uint8_t* ScanScalar(const uint8_t* start, const uint8_t* last, const PatternView& p) {
+    const uint8_t a = p.bytes[p.anchor];
+    const uint8_t b = p.bytes[p.second];
+    const uint8_t* cur = start;
+    while (cur <= last) {
+        const void* hit = std::memchr(cur + p.anchor, a, static_cast<size_t>(last - cur) + 1);
+        if (!hit) return nullptr;
+        const uint8_t* cand = static_cast<const uint8_t*>(hit) - p.anchor;
+        if (cand[p.second] == b && VerifyCandidate(cand, p)) return cand;
+        cur = cand + 1;
+    }
+    return nullptr;
+}
+
+#ifdef CAMERAUNLOCK_SCAN_SSE2
+const uint8_t* ScanSse2(const uint8_t* start, const uint8_t* last, const PatternView& p) {
+    const __m128i a = _mm_set1_epi8(static_cast<char>(p.bytes[p.anchor]));
+    const __m128i b = _mm_set1_epi8(static_cast<char>(p.bytes[p.second]));
+    const uint8_t* cur = start;
+    for (; last - cur >= 15; cur += 16) {
+        const __m128i da = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur + p.anchor));
+        const __m128i db = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur + p.second));
+        uint32_t hits = static_cast<uint32_t>(_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(da, a), _mm_cmpeq_epi8(db, b))));
+        while (hits) {
+            const uint8_t* cand = cur + CountTrailingZeros(hits);
+            if (VerifyCandidate(cand, p)) return cand;
+            hits &= hits - 1;
+        }
+    }
+    return cur <= last ? ScanScalar(cur, last, p) : nullptr;
+}
+#endif
+
+#ifdef CAMERAUNLOCK_SCAN_AVX2
+CAMERAUNLOCK_TARGET_AVX2
+const uint8_t* ScanAvx2(const uint8_t* start, const uint8_t* last, const PatternView& p) {
+    const __m256i a = _mm256_set1_epi8(static_cast<char>(p.bytes[p.anchor]));
+    const __m256i b = _mm256_set1_epi8(static_cast<char>(p.bytes[p.second]));
+    const uint8_t* cur = start;
+    for (; last - cur >= 31; cur += 32) {
+        const __m256i da = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cur + p.anchor));
+        const __m256i db = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cur + p.second));
+        uint32_t hits = static_cast<uint32_t>(_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(da, a), _mm256_cmpeq_epi8(db, b))));
+        while (hits) {
+            const uint8_t* cand = cur + CountTrailingZeros(hits);
+            if (VerifyCandidate(cand, p)) return cand;
+            hits &= hits - 1;
+        }
+    }
+    return cur <= last ? ScanSse2(cur, last, p) : nullptr;
+}
+
+bool DetectAvx2() {
+#ifdef _MSC_VER
+    int regs[4] = {};
+    __cpuid(regs, 0);
+    if (regs[0] < 7) return false;
+    __cpuid(regs, 1);
+    const bool osxsave = (regs[2] & (1 << 27)) != 0;
+    const bool avx = (regs[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx) return false;
+    // OS must save YMM state across context switches
+    if ((_xgetbv(0) & 0x6) != 0x6) return false;
+    __cpuidex(regs, 7, 0);
+    return (regs[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+
+bool HasAvx2() {
+    static const bool supported = DetectAvx2();
+    return supported;
+}
+#endif
+
+const uint8_t* ScanCompiled(const uint8_t* start, size_t size, const PatternView& p) {
+    if (p.length == 0 || p.length > size) return nullptr;
+    // All-wildcard pattern matches the first position
+    if (!p.has_anchor) return start;
+
+    const uint8_t* last = start + (size - p.length);
+#if defined(CAMERAUNLOCK_SCAN_AVX2)
+    if (HasAvx2()) return ScanAvx2(start, last, p);
+    return ScanSse2(start, last, p);
+#elif defined(CAMERAUNLOCK_SCAN_SSE2)
+    return ScanSse2(start, last, p);
+#else
+    return ScanScalar(start, last, p);
+#endif
+}
+
+// A single-pattern scan filters on two anchors at once, so a guessed
+// rare byte is good enough. The batch filter only sees one byte per
+// pattern, so it picks that byte from a sampled histogram of the image
+// itself: every candidate position costs a bucket lookup.
+size_t ChooseBatchAnchor(const PatternView& p, const uint32_t histogram[256]) {
+    size_t best = p.anchor;
+    for (size_t i = 0; i < p.length; ++i) {
+        if (!p.care[i]) continue;
+        const uint32_t count = histogram[p.bytes[i]];
+        const uint32_t bestCount = histogram[p.bytes[best]];
+        if (count < bestCount ||
+            (count == bestCount && PatternByteCommonness(p.bytes[i]) < PatternByteCommonness(p.bytes[best]))) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+void SampleHistogram(const uint8_t* start, size_t size, uint32_t histogram[256]) {
+    std::memset(histogram, 0, 256 * sizeof(uint32_t));
+    // Odd stride so instruction-aligned structure doesn't bias the sample
+    constexpr size_t kStride = 61;
+    for (size_t i = 0; i < size; i += kStride) {
+        ++histogram[start[i]];
+    }
+}
+
+// Anchor lookup for PatternBatch: patterns grouped by anchor byte value
+// in CSR form (offsets into a flat index list)
+struct AnchorBuckets {
+    bool present[256] = {};
+    uint32_t offsets[257] = {};
+    std::vector<uint32_t> patterns;
+};
+
+struct BatchScanState {
+    const uint8_t* start;
+    size_t size;
+    const AnchorBuckets* buckets;
+    const size_t* anchors;  // per-pattern anchor chosen for this image
+    void (*onMatch)(void* ctx, uint32_t index, const uint8_t* at);
+    void* ctx;
+};
+
+// Check every pattern anchored on data[pos]
+inline void CheckBatchPosition(const BatchScanState& s, const PatternView* patterns, size_t pos) {
+    const uint8_t value = s.start[pos];
+    const uint32_t begin = s.buckets->offsets[value];
+    const uint32_t end = s.buckets->offsets[value + 1];
+    for (uint32_t k = begin; k < end; ++k) {
+        const uint32_t index = s.buckets->patterns[k];
+        const PatternView& p = patterns[index];
+        const size_t anchor = s.anchors[index];
+        if (pos < anchor || p.length > s.size) continue;
+        const size_t candidate = pos - anchor;
+        if (candidate > s.size - p.length) continue;
+        const uint8_t* at = s.start + candidate;
+        if (at[p.second] == p.bytes[p.second] && VerifyCandidate(at, p)) {
+            s.onMatch(s.ctx, index, at);
+        }
+    }
+}
+
+void ScanBatchScalar(const BatchScanState& s, const PatternView* patterns, size_t from) {
+    for (size_t pos = from; pos < s.size; ++pos) {
+        if (s.buckets->present[s.start[pos]]) CheckBatchPosition(s, patterns, pos);
+    }
+}
+
+#ifdef CAMERAUNLOCK_SCAN_AVX2
+// Nibble tables for a shuffle-based set test: a byte is a candidate when
+// lo[byte & 0xF] & hi[byte >> 4] is non-zero. Each of the 8 bits stands
+// for a group of anchor values; a group is a product set hi-nibbles x
+// lo-nibbles, so grouping by high nibble is exact and only the merges
+// needed to fit 8 bits admit false candidates (which the bucket rejects).
+void BuildNibbleTables(const bool present[256], uint8_t lo[16], uint8_t hi[16]) {
+    struct Group {
+        uint16_t his;
+        uint16_t los;
+        int exact;
+    };
+    Group groups[16];
+    int count = 0;
+    for (int h = 0; h < 16; ++h) {
+        Group g{static_cast<uint16_t>(1u << h), 0, 0};
+        for (int l = 0; l < 16; ++l) {
+            if (present[(h << 4) | l]) {
+                g.los |= static_cast<uint16_t>(1u << l);
+                ++g.exact;
+            }
+        }
+        if (g.los) groups[count++] = g;
+    }
+
+    auto bits = [](uint16_t v) {
+        int n = 0;
+        for (; v; v &= v - 1) ++n;
+        return n;
+    };
+    while (count > 8) {
+        // Merge the pair that admits the fewest extra byte values
+        int bestA = 0, bestB = 1, bestCost = 1 << 30;
+        for (int a = 0; a < count; ++a) {
+            for (int b = a + 1; b < count; ++b) {
+                const int covered = bits(groups[a].his | groups[b].his) * bits(groups[a].los | groups[b].los);
+                const int cost = covered - groups[a].exact - groups[b].exact;
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestA = a;
+                    bestB = b;
+                }
+            }
+        }
+        groups[bestA].his |= groups[bestB].his;
+        groups[bestA].los |= groups[bestB].los;
+        groups[bestA].exact += groups[bestB].exact;
+        groups[bestB] = groups[--count];
+    }
+
+    std::memset(lo, 0, 16);
+    std::memset(hi, 0, 16);
+    for (int g = 0; g < count; ++g) {
+        const uint8_t bit = static_cast<uint8_t>(1u << g);
+        for (int n = 0; n < 16; ++n) {
+            if (groups[g].los & (1u << n)) lo[n] |= bit;
+            if (groups[g].his & (1u << n)) hi[n] |= bit;
+        }
+    }
+}
+
+CAMERAUNLOCK_TARGET_AVX2
+void ScanBatchAvx2(const BatchScanState& s, const PatternView* patterns) {
+    alignas(32) uint8_t lo[32];
+    alignas(32) uint8_t hi[32];
+    BuildNibbleTables(s.buckets->present, lo, hi);
+    // The shuffle looks up within each 128-bit lane
+    std::memcpy(lo + 16, lo, 16);
+    std::memcpy(hi + 16, hi, 16);
+    const __m256i loTable = _mm256_load_si256(reinterpret_cast<const __m256i*>(lo));
+    const __m256i hiTable = _mm256_load_si256(reinterpret_cast<const __m256i*>(hi));
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    const __m256i zero = _mm256_setzero_si256();
+
+    size_t pos = 0;
+    for (; pos + 32 <= s.size; pos += 32) {
+        const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s.start + pos));
+        const __m256i l = _mm256_shuffle_epi8(loTable, _mm256_and_si256(d, nibble));
+        const __m256i h = _mm256_shuffle_epi8(hiTable, _mm256_and_si256(_mm256_srli_epi16(d, 4), nibble));
+        uint32_t hits = ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(l, h), zero)));
+        while (hits) {
+            CheckBatchPosition(s, patterns, pos + CountTrailingZeros(hits));
+            hits &= hits - 1;
+        }
+    }
+    ScanBatchScalar(s, patterns, pos);
+}
+#endif
+
 } // anonymous namespace
 
 bool GetModuleRange(void* module, uintptr_t& base, size_t& size) {
@@ -86,45 +390,331 @@ bool GetModuleRange(void* module, uintptr_t& base, size_t& size) {
 #endif
 }
 
-void* ScanPatternInRange(uintptr_t base, size_t size, std::string_view pattern) {
-    std::vector<uint8_t> patternBytes;
-    std::vector<char> patternMask;
+bool CompilePattern(std::string_view pattern, CompiledPattern& out) {
+    std::vector<char> mask;
+    if (!ParsePattern(pattern, out.bytes, mask)) {
+        return false;
+    }
+
+    out.care.resize(mask.size());
+    for (size_t i = 0; i < mask.size(); ++i) {
+        out.care[i] = mask[i] == 'x' ? 0xFF : 0x00;
+    }
+    ChooseAnchors(out);
+    return true;
+}
+
+bool CompilePatternMask(const uint8_t* pattern, const char* mask, size_t length, CompiledPattern& out) {
+    if (!pattern || !mask || length == 0) {
+        return false;
+    }
 
-    if (!ParsePattern(pattern, patternBytes, patternMask)) {
+    out.bytes.assign(pattern, pattern + length);
+    out.care.resize(length);
+    for (size_t i = 0; i < length; ++i) {
+        out.care[i] = mask[i] == 'x' ? 0xFF : 0x00;
+    }
+    ChooseAnchors(out);
+    return true;
+}
+
+void* ScanCompiledInRange(uintptr_t base, size_t size, const PatternView& pattern) {
+    const uint8_t* start = reinterpret_cast<const uint8_t*>(base);
+    return const_cast<uint8_t*>(ScanCompiled(start, size, pattern));
+}
+
+void* ScanPatternInRange(uintptr_t base, size_t size, std::string_view pattern) {
+    CompiledPattern compiled;
+    if (!CompilePattern(pattern, compiled)) {
         return nullptr;
     }
 
-    if (patternBytes.size() > size) {
+    return ScanCompiledInRange(base, size, compiled);
+}
+
+void* ScanPatternInRange(uintptr_t base, size_t size, const PatternView& pattern) {
+    return ScanCompiledInRange(base, size, pattern);
+}
+
+void* ScanPatternMaskInRange(uintptr_t base, size_t size, const uint8_t* pattern, const char* mask, size_t length) {
+    CompiledPattern compiled;
+    if (!CompilePatternMask(pattern, mask, length, compiled)) {
         return nullptr;
     }
 
+    return ScanCompiledInRange(base, size, compiled);
+}
+
+void* ScanCompiledParallel(uintptr_t base, size_t size, const PatternView& pattern,
+                           const ParallelScanOptions& options) {
     const uint8_t* start = reinterpret_cast<const uint8_t*>(base);
-    const size_t searchSize = size - patternBytes.size();
+    const size_t length = pattern.length;
+    if (length == 0 || length > size) {
+        return nullptr;
+    }
 
-    for (size_t i = 0; i <= searchSize; ++i) {
-        if (MatchPattern(start + i, patternBytes.data(), patternMask.data(), patternBytes.size())) {
-            return const_cast<uint8_t*>(start + i);
+    unsigned threads = options.max_threads;
+    if (threads == 0) {
+        threads = std::min(std::max(std::thread::hardware_concurrency(), 1u), 4u);
+    }
+    const size_t chunkSize = std::max<size_t>(options.chunk_size, 4096);
+    const size_t candidates = size - length + 1;
+    const size_t chunkCount = (candidates + chunkSize - 1) / chunkSize;
+    if (threads <= 1 || size < options.min_parallel_size || chunkCount < 2) {
+        return ScanCompiledInRange(base, size, pattern);
+    }
+    threads = static_cast<unsigned>(std::min<size_t>(threads, chunkCount));
+
+    // Best candidate offset found so far; chunks are claimed in increasing
+    // order, so once a claimed chunk starts past it no later one can win
+    std::atomic<size_t> nextChunk{0};
+    std::atomic<size_t> best{SIZE_MAX};
+
+    auto worker = [&]() {
+        for (;;) {
+            const size_t chunk = nextChunk.fetch_add(1, std::memory_order_relaxed);
+            if (chunk >= chunkCount) return;
+            const size_t offset = chunk * chunkSize;
+            if (offset >= best.load(std::memory_order_relaxed)) return;
+
+            // Chunk covers candidate starts [offset, offset + chunkSize);
+            // the tail overlap lets a match straddle the boundary
+            const size_t chunkCandidates = std::min(chunkSize, candidates - offset);
+            const uint8_t* hit = ScanCompiled(start + offset, chunkCandidates + length - 1, pattern);
+            if (!hit) continue;
+
+            const size_t found = static_cast<size_t>(hit - start);
+            size_t current = best.load(std::memory_order_relaxed);
+            while (found < current && !best.compare_exchange_weak(current, found, std::memory_order_relaxed)) {
+            }
         }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (unsigned i = 1; i < threads; ++i) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& t : pool) {
+        t.join();
+    }
+
+    const size_t found = best.load();
+    return found == SIZE_MAX ? nullptr : const_cast<uint8_t*>(start + found);
+}
+
+namespace {
+
+// Sections come back in address order, so the first hit is the lowest.
+// A null options scans each section on the calling thread
+void* ScanSections(uintptr_t image_base, size_t image_size, const SectionFilter& filter,
+                   const PatternView& pattern, const ParallelScanOptions* options) {
+    std::vector<ModuleSection> sections;
+    if (!GetImageSections(image_base, image_size, sections)) {
+        return nullptr;
     }
 
+    for (const auto& section : sections) {
+        if (!SectionMatches(section, filter)) continue;
+        void* hit = options ? ScanCompiledParallel(section.base, section.size, pattern, *options)
+                            : ScanCompiledInRange(section.base, section.size, pattern);
+        if (hit) {
+            return hit;
+        }
+    }
     return nullptr;
 }
 
-void* ScanPatternMaskInRange(uintptr_t base, size_t size, const uint8_t* pattern, const char* mask, size_t length) {
-    if (length > size) {
+} // anonymous namespace
+
+void* ScanImageSections(uintptr_t image_base, size_t image_size, const SectionFilter& filter,
+                        std::string_view pattern) {
+    CompiledPattern compiled;
+    if (!CompilePattern(pattern, compiled)) {
+        return nullptr;
+    }
+
+    return ScanSections(image_base, image_size, filter, compiled, nullptr);
+}
+
+void* ScanImageSections(uintptr_t image_base, size_t image_size, const SectionFilter& filter,
+                        const PatternView& pattern) {
+    return ScanSections(image_base, image_size, filter, pattern, nullptr);
+}
+
+void* ScanImageSectionsParallel(uintptr_t image_base, size_t image_size, const SectionFilter& filter,
+                                std::string_view pattern, const ParallelScanOptions& options) {
+    CompiledPattern compiled;
+    if (!CompilePattern(pattern, compiled)) {
+        return nullptr;
+    }
+
+    return ScanSections(image_base, image_size, filter, compiled, &options);
+}
+
+void* ScanImageSectionsParallel(uintptr_t image_base, size_t image_size, const SectionFilter& filter,
+                                const PatternView& pattern, const ParallelScanOptions& options) {
+    return ScanSections(image_base, image_size, filter, pattern, &options);
+}
+
+void* ScanPatternInSections(void* module, const SectionFilter& filter, std::string_view pattern) {
+    uintptr_t base = 0;
+    size_t size = 0;
+
+    if (!GetModuleRange(module, base, size)) {
         return nullptr;
     }
 
+    return ScanImageSections(base, size, filter, pattern);
+}
+
+void* ScanPatternInSections(void* module, const SectionFilter& filter, const PatternView& pattern) {
+    uintptr_t base = 0;
+    size_t size = 0;
+
+    if (!GetModuleRange(module, base, size)) {
+        return nullptr;
+    }
+
+    return ScanImageSections(base, size, filter, pattern);
+}
+
+int PatternBatch::Add(std::string_view pattern) {
+    CompiledPattern compiled;
+    if (!CompilePattern(pattern, compiled)) {
+        return -1;
+    }
+    return AddCompiled(std::move(compiled));
+}
+
+int PatternBatch::AddMask(const uint8_t* pattern, const char* mask, size_t length) {
+    CompiledPattern compiled;
+    if (!CompilePatternMask(pattern, mask, length, compiled)) {
+        return -1;
+    }
+    return AddCompiled(std::move(compiled));
+}
+
+int PatternBatch::Add(const PatternView& pattern) {
+    if (!pattern.bytes || !pattern.care || pattern.length == 0) {
+        return -1;
+    }
+
+    CompiledPattern compiled;
+    compiled.bytes.assign(pattern.bytes, pattern.bytes + pattern.length);
+    compiled.care.assign(pattern.care, pattern.care + pattern.length);
+    compiled.anchor = pattern.anchor;
+    compiled.second = pattern.second;
+    compiled.has_anchor = pattern.has_anchor;
+    return AddCompiled(std::move(compiled));
+}
+
+int PatternBatch::AddCompiled(CompiledPattern&& pattern) {
+    if (!pattern.has_anchor) {
+        return -1;
+    }
+    Entry entry;
+    entry.pattern = std::move(pattern);
+    m_entries.push_back(std::move(entry));
+    return static_cast<int>(m_entries.size() - 1);
+}
+
+void PatternBatch::Clear() {
+    m_entries.clear();
+}
+
+void PatternBatch::ScanRange(uintptr_t base, size_t size, bool collect_all) {
+    for (auto& entry : m_entries) {
+        entry.first = nullptr;
+        entry.count = 0;
+        entry.matches.clear();
+    }
+    if (m_entries.empty() || base == 0 || size == 0) {
+        return;
+    }
+
     const uint8_t* start = reinterpret_cast<const uint8_t*>(base);
-    const size_t searchSize = size - length;
+    uint32_t histogram[256];
+    SampleHistogram(start, size, histogram);
+
+    AnchorBuckets buckets;
+    std::vector<PatternView> patterns;
+    std::vector<size_t> anchors;
+    patterns.reserve(m_entries.size());
+    anchors.reserve(m_entries.size());
+    for (const auto& entry : m_entries) {
+        const size_t anchor = ChooseBatchAnchor(entry.pattern, histogram);
+        const uint8_t value = entry.pattern.bytes[anchor];
+        buckets.present[value] = true;
+        ++buckets.offsets[value + 1];
+        patterns.push_back(entry.pattern);
+        anchors.push_back(anchor);
+    }
+    for (int v = 0; v < 256; ++v) {
+        buckets.offsets[v + 1] += buckets.offsets[v];
+    }
+    buckets.patterns.resize(m_entries.size());
+    uint32_t fill[256];
+    std::memcpy(fill, buckets.offsets, sizeof(fill));
+    for (uint32_t i = 0; i < m_entries.size(); ++i) {
+        buckets.patterns[fill[patterns[i].bytes[anchors[i]]]++] = i;
+    }
 
-    for (size_t i = 0; i <= searchSize; ++i) {
-        if (MatchPattern(start + i, pattern, mask, length)) {
-            return const_cast<uint8_t*>(start + i);
-        }
+    struct Context {
+        std::vector<Entry>* entries;
+        bool collectAll;
+    } ctx{&m_entries, collect_all};
+
+    BatchScanState state;
+    state.start = start;
+    state.size = size;
+    state.buckets = &buckets;
+    state.anchors = anchors.data();
+    state.ctx = &ctx;
+    state.onMatch = [](void* raw, uint32_t index, const uint8_t* at) {
+        auto* c = static_cast<Context*>(raw);
+        Entry& entry = (*c->entries)[index];
+        void* address = const_cast<uint8_t*>(at);
+        // Positions are visited in order and each pattern has a fixed
+        // anchor offset, so the first hit is the lowest address
+        if (entry.count == 0) entry.first = address;
+        ++entry.count;
+        if (c->collectAll) entry.matches.push_back(address);
+    };
+
+#ifdef CAMERAUNLOCK_SCAN_AVX2
+    if (HasAvx2()) {
+        ScanBatchAvx2(state, patterns.data());
+        return;
     }
+#endif
+    ScanBatchScalar(state, patterns.data(), 0);
+}
 
-    return nullptr;
+bool PatternBatch::ScanModule(void* module, bool collect_all) {
+    uintptr_t base = 0;
+    size_t size = 0;
+
+    if (!GetModuleRange(module, base, size)) {
+        return false;
+    }
+
+    ScanRange(base, size, collect_all);
+    return true;
+}
+
+void* PatternBatch::GetFirstMatch(size_t index) const {
+    return index < m_entries.size() ? m_entries[index].first : nullptr;
+}
+
+size_t PatternBatch::GetMatchCount(size_t index) const {
+    return index < m_entries.size() ? m_entries[index].count : 0;
+}
+
+const std::vector<void*>& PatternBatch::GetMatches(size_t index) const {
+    static const std::vector<void*> kEmpty;
+    return index < m_entries.size() ? m_entries[index].matches : kEmpty;
 }
 
 void* ScanPattern(void* module, std::string_view pattern) {
@@ -135,7 +725,43 @@ void* ScanPattern(void* module, std::string_view pattern) {
         return nullptr;
     }
 
-    return ScanPatternInRange(base, size, pattern);
+    CompiledPattern compiled;
+    if (!CompilePattern(pattern, compiled)) {
+        return nullptr;
+    }
+
+    return ScanCompiledInRange(base, size, compiled);
+}
+
+void* ScanPattern(void* module, const PatternView& pattern) {
+    uintptr_t base = 0;
+    size_t size = 0;
+
+    if (!GetModuleRange(module, base, size)) {
+        return nullptr;
+    }
+
+    return ScanCompiledInRange(base, size, pattern);
+}
+
+void* ScanPatternParallel(void* module, std::string_view pattern, const ParallelScanOptions& options) {
+    CompiledPattern compiled;
+    if (!CompilePattern(pattern, compiled)) {
+        return nullptr;
+    }
+
+    return ScanPatternParallel(module, compiled, options);
+}
+
+void* ScanPatternParallel(void* module, const PatternView& pattern, const ParallelScanOptions& options) {
+    uintptr_t base = 0;
+    size_t size = 0;
+
+    if (!GetModuleRange(module, base, size)) {
+        return nullptr;
+    }
+
+    return ScanCompiledParallel(base, size, pattern, options);
 }
 
 void* ScanPatternMask(void* module, const uint8_t* pattern, const char* mask, size_t length) {
@@ -146,7 +772,12 @@ void* ScanPatternMask(void* module, const uint8_t* pattern, const char* mask, si
         return nullptr;
     }
 
-    return ScanPatternMaskInRange(base, size, pattern, mask, length);
+    CompiledPattern compiled;
+    if (!CompilePatternMask(pattern, mask, length, compiled)) {
+        return nullptr;
+    }
+
+    return ScanCompiledInRange(base, size, compiled);
 }
 
 void* ResolveRIPRelative(void* instruction, int offset_position, int instruction_length) {
@@ -168,34 +799,51 @@ void* FindRTTIDescriptor(void* module, std::string_view class_name) {
         return nullptr;
     }
 
-    // Empty / over-long names cannot match. Guarding here also stops the
-    // unsigned `size - class_name.size()` below from underflowing into a
-    // huge value and walking past the end of the module image.
-    if (class_name.empty() || class_name.size() > size) {
-        return nullptr;
-    }
+    return FindRTTIDescriptorInImage(base, size, class_name);
+}
 
-    // Search for the class name string in the module
+void* FindRTTIDescriptorInImage(uintptr_t image_base, size_t image_size, std::string_view class_name) {
     // RTTI type descriptor starts with vtable pointer followed by spare data, then name
-    const uint8_t* start = reinterpret_cast<const uint8_t*>(base);
+    // The structure layout is:
+    // - vtable pointer (8 bytes on x64)
+    // - spare data pointer (8 bytes on x64)
+    // - name string (variable length, null terminated)
+    // so a name hit is only usable at least that far into the image
+    const size_t type_info_offset = sizeof(void*) * 2;  // 16 bytes on x64
+
+    // Empty / over-long names cannot match. Guarding here also keeps the
+    // range arithmetic below from underflowing.
+    if (image_base == 0 || class_name.empty() || class_name.size() + type_info_offset > image_size) {
+        return nullptr;
+    }
 
-    const size_t maxStart = size - class_name.size();
-    for (size_t i = 0; i <= maxStart; ++i) {
-        if (std::memcmp(start + i, class_name.data(), class_name.size()) == 0) {
-            // Found the name string - this is inside the type_info structure
-            // The structure layout is:
-            // - vtable pointer (8 bytes on x64)
-            // - spare data pointer (8 bytes on x64)
-            // - name string (variable length, null terminated)
-            // We found the name, so go back to find the start of type_info
-            const size_t type_info_offset = sizeof(void*) * 2;  // 16 bytes on x64
-            if (i >= type_info_offset) {
-                return const_cast<uint8_t*>(start + i - type_info_offset);
+    CompiledPattern compiled;
+    const std::vector<char> mask(class_name.size(), 'x');
+    CompilePatternMask(reinterpret_cast<const uint8_t*>(class_name.data()), mask.data(), class_name.size(), compiled);
+
+    auto found = [&](void* hit) -> void* {
+        return hit ? static_cast<uint8_t*>(hit) - type_info_offset : nullptr;
+    };
+
+    // Type descriptors live in .data; skipping code and resources keeps
+    // this from walking the whole image
+    std::vector<ModuleSection> sections;
+    if (GetImageSections(image_base, image_size, sections)) {
+        const SectionFilter filter = SectionFilter::InitializedData();
+        for (const auto& section : sections) {
+            if (!SectionMatches(section, filter)) continue;
+            const uintptr_t from = std::max(section.base, image_base + type_info_offset);
+            const uintptr_t end = section.base + section.size;
+            if (from >= end) continue;
+            if (void* hit = ScanCompiledInRange(from, end - from, compiled)) {
+                return found(hit);
             }
         }
+        return nullptr;
     }
 
-    return nullptr;
+    // No parseable headers: search everything past the first descriptor slot
+    return found(ScanCompiledInRange(image_base + type_info_offset, image_size - type_info_offset, compiled));
 }
 
 } // namespace cameraunlock::memory
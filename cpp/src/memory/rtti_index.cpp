@@ -0,0 +1,225 @@
+#include <cameraunlock/memory/rtti_index.h>
+#include <cameraunlock/memory/module_sections.h>
+#include <cameraunlock/memory/pattern_scanner.h>
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace cameraunlock::memory {
+
+namespace {
+
+// MSVC x64 CompleteObjectLocator
+struct ColFields {
+    uint32_t signature;        // 1 for x64
+    uint32_t offset;           // offset of this vtable in complete class
+    uint32_t cdOffset;         // constructor displacement
+    uint32_t pTypeDescriptor;  // RVA of TypeDescriptor
+    uint32_t pClassDescriptor; // RVA of ClassHierarchyDescriptor
+    uint32_t pSelf;            // RVA of this COL
+};
+
+// TypeDescriptor name follows its vtable and spare pointers
+constexpr size_t kTypeNameOffset = sizeof(void*) * 2;
+constexpr size_t kMaxTypeNameLength = 1024;
+
+// Module-relative [begin, end) ranges matching filter, or the whole image
+std::vector<std::pair<size_t, size_t>> SectionRanges(uintptr_t base, size_t size, const SectionFilter& filter) {
+    std::vector<std::pair<size_t, size_t>> ranges;
+    std::vector<ModuleSection> sections;
+    if (GetImageSections(base, size, sections)) {
+        for (const auto& section : sections) {
+            if (!SectionMatches(section, filter)) continue;
+            const size_t begin = section.base - base;
+            ranges.emplace_back(begin, begin + section.size);
+        }
+        return ranges;
+    }
+    ranges.emplace_back(0, size);
+    return ranges;
+}
+
+// Length of a plausible mangled type name at p, or 0
+size_t TypeNameLength(const uint8_t* p, size_t available) {
+    const size_t limit = std::min(available, kMaxTypeNameLength);
+    for (size_t i = 0; i < limit; ++i) {
+        if (p[i] == 0) {
+            return (i >= 6 && p[i - 1] == '@' && p[i - 2] == '@') ? i : 0;
+        }
+        if (p[i] < 0x20 || p[i] > 0x7E) return 0;
+    }
+    return 0;
+}
+
+} // anonymous namespace
+
+bool RttiIndex::Build(void* module) {
+    uintptr_t base = 0;
+    size_t size = 0;
+
+    if (!GetModuleRange(module, base, size)) {
+        Clear();
+        return false;
+    }
+
+    return BuildImage(base, size);
+}
+
+void RttiIndex::Clear() {
+    m_base = 0;
+    m_size = 0;
+    m_byName.clear();
+    m_classes.clear();
+    m_colToVtable.clear();
+}
+
+bool RttiIndex::BuildImage(uintptr_t image_base, size_t image_size) {
+    Clear();
+    if (image_base == 0 || image_size <= kTypeNameOffset) return false;
+    m_base = image_base;
+    m_size = image_size;
+
+    const uint8_t* start = reinterpret_cast<const uint8_t*>(image_base);
+
+    // Pass 1: TypeDescriptor names (".?AV" classes and ".?AU" structs) in
+    // initialized data
+    const uint8_t prefix[] = {'.', '?', 'A'};
+    CompiledPattern compiled;
+    CompilePatternMask(prefix, "xxx", sizeof(prefix), compiled);
+
+    std::unordered_map<uint32_t, size_t> byTd;  // TD RVA -> class index
+    for (const auto& range : SectionRanges(image_base, image_size, SectionFilter::InitializedData())) {
+        size_t pos = std::max(range.first, kTypeNameOffset);
+        while (pos < range.second) {
+            void* hit = ScanCompiledInRange(image_base + pos, range.second - pos, compiled);
+            if (!hit) break;
+            const size_t at = static_cast<const uint8_t*>(hit) - start;
+            const size_t length = TypeNameLength(start + at, range.second - at);
+            if (length == 0 || (start[at + 3] != 'V' && start[at + 3] != 'U')) {
+                pos = at + 1;
+                continue;
+            }
+
+            const uint32_t tdRva = static_cast<uint32_t>(at - kTypeNameOffset);
+            if (byTd.find(tdRva) == byTd.end()) {
+                RttiClass cls;
+                cls.name.assign(reinterpret_cast<const char*>(start + at), length);
+                cls.type_descriptor = image_base + tdRva;
+                byTd.emplace(tdRva, m_classes.size());
+                m_classes.push_back(std::move(cls));
+            }
+            pos = at + length + 1;
+        }
+    }
+
+    // Pass 2: 8-byte slots in read-only data that point at a COL whose
+    // self-reference checks out and whose descriptor was indexed above.
+    // The slot is vtable[-1], so this finds COLs and vtables together.
+    for (const auto& range : SectionRanges(image_base, image_size, SectionFilter::ReadOnlyData())) {
+        for (size_t i = range.first; i + 2 * sizeof(uintptr_t) <= range.second; i += sizeof(uintptr_t)) {
+            uintptr_t value = 0;
+            std::memcpy(&value, start + i, sizeof(value));
+            if (value < image_base || image_size < sizeof(ColFields) ||
+                value - image_base > image_size - sizeof(ColFields)) {
+                continue;
+            }
+
+            const size_t colRva = value - image_base;
+            if (colRva % 4 != 0) continue;
+            ColFields col;
+            std::memcpy(&col, start + colRva, sizeof(col));
+            if (col.signature != 1 || col.pSelf != colRva) continue;
+
+            auto it = byTd.find(col.pTypeDescriptor);
+            if (it == byTd.end()) continue;
+
+            const uint32_t vtableRva = static_cast<uint32_t>(i + sizeof(uintptr_t));
+            // First slot wins, matching the linear scan in rtti_vtable.cpp
+            if (!m_colToVtable.emplace(static_cast<uint32_t>(colRva), vtableRva).second) continue;
+
+            RttiClass& cls = m_classes[it->second];
+            cls.cols.push_back(value);
+            cls.vtables.push_back(image_base + vtableRva);
+        }
+    }
+
+    // Sort for FindContaining, then index by name; the views point into
+    // strings that no longer move
+    std::sort(m_classes.begin(), m_classes.end(),
+              [](const RttiClass& a, const RttiClass& b) { return a.name < b.name; });
+    m_byName.reserve(m_classes.size());
+    for (size_t i = 0; i < m_classes.size(); ++i) {
+        m_byName.emplace(std::string_view(m_classes[i].name), i);
+    }
+    return true;
+}
+
+const RttiClass* RttiIndex::FindMangled(std::string_view mangled_name) const {
+    auto it = m_byName.find(mangled_name);
+    return it == m_byName.end() ? nullptr : &m_classes[it->second];
+}
+
+const RttiClass* RttiIndex::FindClass(std::string_view class_name) const {
+    std::string mangled = ".?AV";
+    mangled += class_name;
+    mangled += "@@";
+    if (const RttiClass* cls = FindMangled(mangled)) return cls;
+
+    mangled[3] = 'U';
+    return FindMangled(mangled);
+}
+
+size_t RttiIndex::FindContaining(std::string_view fragment, std::vector<const RttiClass*>& out) const {
+    out.clear();
+    for (const auto& cls : m_classes) {
+        if (cls.name.find(fragment) != std::string::npos) {
+            out.push_back(&cls);
+        }
+    }
+    return out.size();
+}
+
+uintptr_t RttiIndex::GetVtableForCol(uintptr_t col) const {
+    if (col < m_base || col - m_base >= m_size) return 0;
+    auto it = m_colToVtable.find(static_cast<uint32_t>(col - m_base));
+    return it == m_colToVtable.end() ? 0 : m_base + it->second;
+}
+
+bool RttiIndex::FindVtable(std::string_view class_name, VtableInfo& info, int max_vfuncs) const {
+    const RttiClass* cls = FindClass(class_name);
+    if (!cls || cls->vtables.empty()) return false;
+    if (max_vfuncs > kMaxVfuncEntries) max_vfuncs = kMaxVfuncEntries;
+
+    // Prefer the complete object's primary vtable over secondary bases
+    size_t pick = 0;
+    for (size_t i = 0; i < cls->cols.size(); ++i) {
+        uint32_t offset = 0;
+        std::memcpy(&offset, reinterpret_cast<const void*>(cls->cols[i] + 4), sizeof(offset));
+        if (offset == 0) {
+            pick = i;
+            break;
+        }
+    }
+
+    const uintptr_t vtable = cls->vtables[pick];
+    info.col_address = cls->cols[pick];
+    info.vtable_address = vtable;
+    info.vfunc_count = 0;
+
+    // Read vfunc entries, stopping at non-code addresses or the image end
+    for (int v = 0; v < max_vfuncs; v++) {
+        const uintptr_t slot = vtable + v * sizeof(uintptr_t);
+        if (slot - m_base > m_size - sizeof(uintptr_t)) break;
+        uintptr_t funcAddr = 0;
+        std::memcpy(&funcAddr, reinterpret_cast<const void*>(slot), sizeof(funcAddr));
+        // Valid code address: within the module
+        if (funcAddr < m_base || funcAddr - m_base >= m_size) break;
+        info.vfuncs[v] = funcAddr;
+        info.vfunc_count = v + 1;
+    }
+
+    return info.vfunc_count > 0;
+}
+
+} // namespace cameraunlock::memory
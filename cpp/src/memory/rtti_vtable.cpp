@@ -1,4 +1,5 @@
 #include <cameraunlock/memory/rtti_vtable.h>
+#include <cameraunlock/memory/module_sections.h>
 #include <cameraunlock/memory/pattern_scanner.h>
 
 #ifdef _WIN32
@@ -8,6 +9,8 @@
 
 #include <cstring>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace cameraunlock::memory {
 
@@ -23,6 +26,82 @@ struct RTTICompleteObjectLocator {
 };
 #pragma pack(pop)
 
+namespace {
+
+// Module-relative [begin, end) ranges to sweep for COLs and vtables:
+// MSVC emits both into .rdata, so read-only data sections when the
+// headers parse, otherwise the whole image
+std::vector<std::pair<size_t, size_t>> ReadOnlyDataRanges(uintptr_t base, size_t modSize) {
+    std::vector<std::pair<size_t, size_t>> ranges;
+    std::vector<ModuleSection> sections;
+    if (GetImageSections(base, modSize, sections)) {
+        const SectionFilter filter = SectionFilter::ReadOnlyData();
+        for (const auto& section : sections) {
+            if (!SectionMatches(section, filter)) continue;
+            const size_t begin = section.base - base;
+            ranges.emplace_back(begin, begin + section.size);
+        }
+    }
+    if (ranges.empty()) {
+        ranges.emplace_back(0, modSize);
+    }
+    return ranges;
+}
+
+// Read vfunc entries, stopping at non-code addresses
+bool ReadVfuncs(uintptr_t base, size_t modSize, uintptr_t vtable, VtableInfo& info, int max_vfuncs) {
+    info.vtable_address = vtable;
+
+    uintptr_t codeStart = base;
+    uintptr_t codeEnd = base + modSize;
+    info.vfunc_count = 0;
+
+    for (int v = 0; v < max_vfuncs; v++) {
+        uintptr_t funcAddr = *reinterpret_cast<const uintptr_t*>(vtable + v * sizeof(uintptr_t));
+        // Valid code address: within the module
+        if (funcAddr < codeStart || funcAddr >= codeEnd) break;
+        info.vfuncs[v] = funcAddr;
+        info.vfunc_count = v + 1;
+    }
+
+    return info.vfunc_count > 0;
+}
+
+// Check a remembered vtable still belongs to mangled_name
+bool ValidateVtable(uintptr_t base, size_t modSize, uintptr_t vtable,
+                    std::string_view mangled_name, VtableInfo& info) {
+    // Size checks first so the subtractions below can't wrap
+    if (modSize < sizeof(RTTICompleteObjectLocator)) return false;
+    if (vtable < base + sizeof(uintptr_t) || vtable - base > modSize - sizeof(uintptr_t)) return false;
+
+    uintptr_t colAddr = *reinterpret_cast<const uintptr_t*>(vtable - sizeof(uintptr_t));
+    if (colAddr < base || colAddr - base > modSize - sizeof(RTTICompleteObjectLocator)) return false;
+
+    auto* col = reinterpret_cast<const RTTICompleteObjectLocator*>(colAddr);
+    if (col->signature != 1) return false;
+    if (col->pSelf != static_cast<uint32_t>(colAddr - base)) return false;
+
+    // TypeDescriptor name follows its vtable and spare pointers
+    const size_t nameRva = static_cast<size_t>(col->pTypeDescriptor) + sizeof(void*) * 2;
+    if (nameRva > modSize || modSize - nameRva < mangled_name.size()) return false;
+    if (std::memcmp(reinterpret_cast<const void*>(base + nameRva), mangled_name.data(), mangled_name.size()) != 0) {
+        return false;
+    }
+
+    info.col_address = colAddr;
+    return true;
+}
+
+std::string MangleClassName(std::string_view class_name) {
+    // Build mangled RTTI name: ".?AV<class_name>@@"
+    std::string mangled = ".?AV";
+    mangled += class_name;
+    mangled += "@@";
+    return mangled;
+}
+
+} // anonymous namespace
+
 bool FindVtableFromTypeDescriptor(void* module, void* type_descriptor,
                                   VtableInfo& info, int max_vfuncs) {
     if (!module || !type_descriptor) return false;
@@ -38,19 +117,24 @@ bool FindVtableFromTypeDescriptor(void* module, void* type_descriptor,
     // Scan the module for a COL whose pTypeDescriptor == tdRva
     const uint8_t* start = reinterpret_cast<const uint8_t*>(base);
     const RTTICompleteObjectLocator* foundCol = nullptr;
+    const auto ranges = ReadOnlyDataRanges(base, modSize);
 
-    for (size_t i = 0; i + sizeof(RTTICompleteObjectLocator) <= modSize; i += 4) {
-        auto* col = reinterpret_cast<const RTTICompleteObjectLocator*>(start + i);
+    for (const auto& range : ranges) {
+        // Section starts are page aligned, so i stays 4-byte aligned
+        for (size_t i = range.first; i + sizeof(RTTICompleteObjectLocator) <= range.second; i += 4) {
+            auto* col = reinterpret_cast<const RTTICompleteObjectLocator*>(start + i);
 
-        if (col->signature != 1) continue;  // x64 signature
-        if (col->pTypeDescriptor != tdRva) continue;
+            if (col->signature != 1) continue;  // x64 signature
+            if (col->pTypeDescriptor != tdRva) continue;
 
-        // Validate self-reference
-        uint32_t colRva = static_cast<uint32_t>(i);
-        if (col->pSelf != colRva) continue;
+            // Validate self-reference
+            uint32_t colRva = static_cast<uint32_t>(i);
+            if (col->pSelf != colRva) continue;
 
-        foundCol = col;
-        break;
+            foundCol = col;
+            break;
+        }
+        if (foundCol) break;
     }
 
     if (!foundCol) return false;
@@ -60,28 +144,15 @@ bool FindVtableFromTypeDescriptor(void* module, void* type_descriptor,
 
     // Now find the vtable: scan for a pointer to this COL.
     // vtable[-1] == &COL, so vtable == (&COL_pointer) + 8
-    for (size_t i = 0; i + sizeof(uintptr_t) <= modSize; i += 8) {
-        uintptr_t val = *reinterpret_cast<const uintptr_t*>(start + i);
-        if (val != colAddr) continue;
-
-        // This is vtable[-1]. vtable[0] starts at the next slot.
-        uintptr_t vtable = reinterpret_cast<uintptr_t>(start + i + sizeof(uintptr_t));
-        info.vtable_address = vtable;
-
-        // Read vfunc entries, stopping at non-code addresses
-        uintptr_t codeStart = base;
-        uintptr_t codeEnd = base + modSize;
-        info.vfunc_count = 0;
-
-        for (int v = 0; v < max_vfuncs; v++) {
-            uintptr_t funcAddr = *reinterpret_cast<const uintptr_t*>(vtable + v * sizeof(uintptr_t));
-            // Valid code address: within the module
-            if (funcAddr < codeStart || funcAddr >= codeEnd) break;
-            info.vfuncs[v] = funcAddr;
-            info.vfunc_count = v + 1;
+    for (const auto& range : ranges) {
+        for (size_t i = range.first; i + sizeof(uintptr_t) <= range.second; i += 8) {
+            uintptr_t val = *reinterpret_cast<const uintptr_t*>(start + i);
+            if (val != colAddr) continue;
+
+            // This is vtable[-1]. vtable[0] starts at the next slot.
+            uintptr_t vtable = reinterpret_cast<uintptr_t>(start + i + sizeof(uintptr_t));
+            return ReadVfuncs(base, modSize, vtable, info, max_vfuncs);
         }
-
-        return info.vfunc_count > 0;
     }
 
     return false;
@@ -89,10 +160,7 @@ bool FindVtableFromTypeDescriptor(void* module, void* type_descriptor,
 
 bool FindVtableFromRTTI(void* module, std::string_view class_name,
                         VtableInfo& info, int max_vfuncs) {
-    // Build mangled RTTI name: ".?AV<class_name>@@"
-    std::string mangled = ".?AV";
-    mangled += class_name;
-    mangled += "@@";
+    const std::string mangled = MangleClassName(class_name);
 
     void* td = FindRTTIDescriptor(module, mangled);
     if (!td) return false;
@@ -100,4 +168,43 @@ bool FindVtableFromRTTI(void* module, std::string_view class_name,
     return FindVtableFromTypeDescriptor(module, td, info, max_vfuncs);
 }
 
+bool ReadVtableAt(void* module, uintptr_t vtable, std::string_view class_name,
+                  VtableInfo& info, int max_vfuncs) {
+    if (max_vfuncs > kMaxVfuncEntries) max_vfuncs = kMaxVfuncEntries;
+
+    uintptr_t base = 0;
+    size_t modSize = 0;
+    if (!GetModuleRange(module, base, modSize)) return false;
+
+    return ValidateVtable(base, modSize, vtable, MangleClassName(class_name), info) &&
+           ReadVfuncs(base, modSize, vtable, info, max_vfuncs);
+}
+
+bool FindVtableFromRTTI(SignatureCache& cache, std::string_view class_name,
+                        VtableInfo& info, int max_vfuncs) {
+    const uintptr_t base = cache.GetImageBase();
+    const size_t modSize = cache.GetImageSize();
+    if (!base) return false;
+    if (max_vfuncs > kMaxVfuncEntries) max_vfuncs = kMaxVfuncEntries;
+
+    const std::string mangled = MangleClassName(class_name);
+    uintptr_t vtable = 0;
+    if (cache.Lookup(SignatureCache::EntryKind::Vtable, mangled, vtable)) {
+        if (ValidateVtable(base, modSize, vtable, mangled, info) &&
+            ReadVfuncs(base, modSize, vtable, info, max_vfuncs)) {
+            return true;
+        }
+        cache.Erase(SignatureCache::EntryKind::Vtable, mangled);
+    }
+
+    void* td = cache.FindRTTIDescriptor(mangled);
+    if (!td) return false;
+
+    // An HMODULE is the image base, so the bound base doubles as the handle
+    if (!FindVtableFromTypeDescriptor(reinterpret_cast<void*>(base), td, info, max_vfuncs)) return false;
+
+    cache.Store(SignatureCache::EntryKind::Vtable, mangled, info.vtable_address);
+    return true;
+}
+
 } // namespace cameraunlock::memory
@@ -0,0 +1,205 @@
+#include <cameraunlock/memory/signature_cache.h>
+#include <cameraunlock/memory/pattern_scanner.h>
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace cameraunlock::memory {
+
+namespace {
+
+constexpr const char* kFileHeader = "# cameraunlock signature cache v1";
+
+} // anonymous namespace
+
+uint64_t SignatureCache::HashKey(EntryKind kind, std::string_view key) {
+    // FNV-1a 64 over the kind tag and the key text
+    uint64_t hash = 14695981039346656037ull;
+    hash = (hash ^ static_cast<uint8_t>(kind)) * 1099511628211ull;
+    for (char c : key) {
+        hash = (hash ^ static_cast<uint8_t>(c)) * 1099511628211ull;
+    }
+    return hash;
+}
+
+bool SignatureCache::Open(const std::string& path, void* module) {
+    uintptr_t base = 0;
+    size_t size = 0;
+
+    if (!GetModuleRange(module, base, size)) {
+        OpenImage(path, 0, 0);
+        return false;
+    }
+
+    return OpenImage(path, base, size);
+}
+
+bool SignatureCache::OpenImage(const std::string& path, uintptr_t image_base, size_t image_size) {
+    m_path = path;
+    m_base = image_base;
+    m_size = image_size;
+    m_entries.clear();
+    m_loaded = false;
+    m_dirty = false;
+    m_hits = 0;
+    m_misses = 0;
+
+    m_bound = GetImageIdentity(image_base, image_size, m_identity);
+    if (m_bound) {
+        Load();
+    }
+    return m_bound;
+}
+
+void SignatureCache::Load() {
+    if (m_path.empty()) return;
+
+    FILE* file = fopen(m_path.c_str(), "r");
+    if (!file) return;
+
+    std::unordered_map<uint64_t, uint32_t> entries;
+    bool identityMatched = false;
+    char line[128];
+    while (fgets(line, sizeof(line), file)) {
+        if (line[0] == '#' || line[0] == '\n') continue;
+
+        ModuleIdentity id;
+        if (std::strncmp(line, "module ", 7) == 0) {
+            if (std::sscanf(line + 7, "%" SCNx32 " %" SCNx32 " %" SCNx32 " %" SCNx32, &id.time_date_stamp,
+                            &id.size_of_image, &id.checksum, &id.header_hash) != 4) {
+                break;
+            }
+            identityMatched = id == m_identity;
+            if (!identityMatched) break;
+            continue;
+        }
+
+        // Entries before a matching module line are ignored
+        if (!identityMatched) break;
+
+        uint64_t hash = 0;
+        uint32_t rva = 0;
+        if (std::sscanf(line, "%" SCNx64 " %" SCNx32, &hash, &rva) == 2 && rva < m_size) {
+            entries[hash] = rva;
+        }
+    }
+    fclose(file);
+
+    // A file for another build is dropped wholesale and rewritten on Save
+    if (identityMatched) {
+        m_entries = std::move(entries);
+        m_loaded = true;
+    } else {
+        m_dirty = true;
+    }
+}
+
+bool SignatureCache::Save() {
+    if (!m_bound || !m_dirty || m_path.empty()) {
+        return true;
+    }
+
+    FILE* file = fopen(m_path.c_str(), "w");
+    if (!file) {
+        return false;
+    }
+
+    // Sorted so rewrites of the same content are byte-identical
+    std::vector<std::pair<uint64_t, uint32_t>> sorted(m_entries.begin(), m_entries.end());
+    std::sort(sorted.begin(), sorted.end());
+
+    fprintf(file, "%s\n", kFileHeader);
+    fprintf(file, "module %08" PRIx32 " %08" PRIx32 " %08" PRIx32 " %08" PRIx32 "\n", m_identity.time_date_stamp,
+            m_identity.size_of_image, m_identity.checksum, m_identity.header_hash);
+    for (const auto& entry : sorted) {
+        fprintf(file, "%016" PRIx64 " %08" PRIx32 "\n", entry.first, entry.second);
+    }
+
+    const bool ok = fflush(file) == 0;
+    fclose(file);
+    if (ok) {
+        m_dirty = false;
+    }
+    return ok;
+}
+
+bool SignatureCache::Lookup(EntryKind kind, std::string_view key, uintptr_t& address) const {
+    if (!m_bound) return false;
+
+    auto it = m_entries.find(HashKey(kind, key));
+    if (it == m_entries.end()) return false;
+
+    address = m_base + it->second;
+    return true;
+}
+
+void SignatureCache::Store(EntryKind kind, std::string_view key, uintptr_t address) {
+    if (!m_bound || address < m_base || address - m_base >= m_size) return;
+
+    m_entries[HashKey(kind, key)] = static_cast<uint32_t>(address - m_base);
+    m_dirty = true;
+}
+
+void SignatureCache::Erase(EntryKind kind, std::string_view key) {
+    if (m_entries.erase(HashKey(kind, key)) > 0) {
+        m_dirty = true;
+    }
+}
+
+void* SignatureCache::ScanPattern(std::string_view pattern) {
+    CompiledPattern compiled;
+    if (m_base == 0 || !CompilePattern(pattern, compiled)) {
+        return nullptr;
+    }
+
+    // Re-match at the cached address; a version with the same identity
+    // has the same first match, so this is all the validation needed
+    uintptr_t cached = 0;
+    if (Lookup(EntryKind::Pattern, pattern, cached)) {
+        if (compiled.Length() <= m_size && cached - m_base <= m_size - compiled.Length() &&
+            ScanCompiledInRange(cached, compiled.Length(), compiled) == reinterpret_cast<void*>(cached)) {
+            ++m_hits;
+            return reinterpret_cast<void*>(cached);
+        }
+        Erase(EntryKind::Pattern, pattern);
+    }
+
+    ++m_misses;
+    void* hit = ScanCompiledInRange(m_base, m_size, compiled);
+    if (hit) {
+        Store(EntryKind::Pattern, pattern, reinterpret_cast<uintptr_t>(hit));
+    }
+    return hit;
+}
+
+void* SignatureCache::FindRTTIDescriptor(std::string_view class_name) {
+    if (m_base == 0 || class_name.empty()) {
+        return nullptr;
+    }
+
+    // The name follows the vtable and spare pointers in the type_info
+    const size_t nameOffset = sizeof(void*) * 2;
+    uintptr_t cached = 0;
+    if (Lookup(EntryKind::RttiDescriptor, class_name, cached)) {
+        const size_t rva = cached - m_base;
+        if (rva + nameOffset + class_name.size() <= m_size &&
+            std::memcmp(reinterpret_cast<const void*>(cached + nameOffset), class_name.data(), class_name.size()) == 0) {
+            ++m_hits;
+            return reinterpret_cast<void*>(cached);
+        }
+        Erase(EntryKind::RttiDescriptor, class_name);
+    }
+
+    ++m_misses;
+    void* td = FindRTTIDescriptorInImage(m_base, m_size, class_name);
+    if (td) {
+        Store(EntryKind::RttiDescriptor, class_name, reinterpret_cast<uintptr_t>(td));
+    }
+    return td;
+}
+
+} // namespace cameraunlock::memory
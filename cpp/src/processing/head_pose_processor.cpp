@@ -0,0 +1,125 @@
+#include "cameraunlock/processing/head_pose_processor.h"
+#include "cameraunlock/math/angle_utils.h"
+#include "cameraunlock/math/deadzone_utils.h"
+#include "cameraunlock/math/smoothing_utils.h"
+
+namespace cameraunlock {
+
+HeadPoseFrame HeadPoseProcessor::Step(const TrackingSample& sample, float delta_time) {
+    HeadPoseFrame frame;
+    if (!sample.IsValid()) {
+        return frame;
+    }
+
+    bool isNewSample = sample.sequence != m_lastSequence;
+    m_lastSequence = sample.sequence;
+    if (isNewSample) {
+        frame.flags |= HeadPoseFrame::kNewSample;
+    }
+
+    // Step 1: Interpolate all six axes against one sample-interval estimate
+    Interpolator::Value raw = {sample.yaw, sample.pitch, sample.roll, sample.x, sample.y, sample.z};
+    m_lastRaw = m_interpolationEnabled
+        ? m_interpolator.Update(raw, isNewSample, delta_time, m_maxExtrapolationFraction)
+        : raw;
+    m_hasRaw = true;
+
+    // Per-frame smoothing coefficients, shared when both settings match
+    double rotationSmoothing = math::GetEffectiveSmoothing(m_rotationSmoothing);
+    double positionSmoothing = math::GetEffectiveSmoothing(m_positionSettings.smoothing);
+    float rotationT = static_cast<float>(
+        math::CalculateSmoothingFactor(rotationSmoothing, static_cast<double>(delta_time)));
+    float positionT = positionSmoothing == rotationSmoothing
+        ? rotationT
+        : static_cast<float>(math::CalculateSmoothingFactor(positionSmoothing, static_cast<double>(delta_time)));
+
+    // Step 2: Rotation — offset, deadzone, SLERP smoothing, sensitivity
+    float yaw = m_lastRaw[0];
+    float pitch = m_lastRaw[1];
+    float roll = m_lastRaw[2];
+    m_rotationCenter.ApplyOffset(yaw, pitch, roll);
+    yaw = static_cast<float>(math::ApplyDeadzone(yaw, m_deadzone.yaw));
+    pitch = static_cast<float>(math::ApplyDeadzone(pitch, m_deadzone.pitch));
+    roll = static_cast<float>(math::ApplyDeadzone(roll, m_deadzone.roll));
+
+    math::Quat4 target = math::Quat4::FromYawPitchRoll(yaw, pitch, roll);
+    if (!m_hasSmoothedValue) {
+        m_smoothedQuat = target;
+        m_smoothedPosition = math::Vec3::Zero();
+    } else {
+        m_smoothedQuat = math::Quat4::Slerp(m_smoothedQuat, target, rotationT);
+    }
+
+    float smoothedYaw, smoothedPitch, smoothedRoll;
+    m_smoothedQuat.ToEulerYXZ(smoothedYaw, smoothedPitch, smoothedRoll);
+    frame.yaw = smoothedYaw * m_sensitivity.yaw;
+    frame.pitch = smoothedPitch * m_sensitivity.pitch;
+    frame.roll = smoothedRoll * m_sensitivity.roll;
+    if (m_sensitivity.invert_yaw) frame.yaw = -frame.yaw;
+    if (m_sensitivity.invert_pitch) frame.pitch = -frame.pitch;
+    if (m_sensitivity.invert_roll) frame.roll = -frame.roll;
+
+    // Quaternion output agrees with the Euler output; only rebuild it when
+    // sensitivity actually changed the rotation.
+    bool unitSensitivity = m_sensitivity.yaw == 1.0f && m_sensitivity.pitch == 1.0f &&
+        m_sensitivity.roll == 1.0f && !m_sensitivity.invert_yaw &&
+        !m_sensitivity.invert_pitch && !m_sensitivity.invert_roll;
+    frame.rotation = unitSensitivity
+        ? m_smoothedQuat
+        : math::Quat4::FromYawPitchRoll(frame.yaw, frame.pitch, frame.roll);
+    frame.flags |= HeadPoseFrame::kRotationValid;
+
+    // Step 3: Position — center, pivot compensation, sensitivity, smoothing, clamp
+    if (m_positionEnabled) {
+        math::Vec3 pos = math::Vec3(m_lastRaw[3], m_lastRaw[4], m_lastRaw[5]) - m_positionCenter;
+
+        if (m_trackerPivotForward > 0.0f) {
+            math::Vec3 pivot(0.0f, 0.0f, m_trackerPivotForward);
+            pos = pos - (frame.rotation.Rotate(pivot) - pivot);
+        }
+
+        const PositionSettings& ps = m_positionSettings;
+        math::Vec3 scaled(
+            (ps.invert_x ? -pos.x : pos.x) * ps.sensitivity_x,
+            (ps.invert_y ? -pos.y : pos.y) * ps.sensitivity_y,
+            (ps.invert_z ? -pos.z : pos.z) * ps.sensitivity_z);
+
+        m_smoothedPosition = m_hasSmoothedValue
+            ? math::Vec3::Lerp(m_smoothedPosition, scaled, positionT)
+            : scaled;
+
+        frame.position = math::Vec3(
+            math::Clamp(m_smoothedPosition.x, -ps.limit_x, ps.limit_x),
+            math::Clamp(m_smoothedPosition.y, -ps.limit_y, ps.limit_y),
+            math::Clamp(m_smoothedPosition.z, -ps.limit_z, ps.limit_z_back));
+        frame.flags |= HeadPoseFrame::kPositionValid;
+    }
+
+    m_hasSmoothedValue = true;
+    return frame;
+}
+
+void HeadPoseProcessor::Recenter() {
+    if (!m_hasRaw) {
+        return;
+    }
+    m_rotationCenter.SetCenter(m_lastRaw[0], m_lastRaw[1], m_lastRaw[2]);
+    m_positionCenter = math::Vec3(m_lastRaw[3], m_lastRaw[4], m_lastRaw[5]);
+    m_smoothedQuat = math::Quat4::Identity();
+    m_smoothedPosition = math::Vec3::Zero();
+    m_hasSmoothedValue = false;
+}
+
+void HeadPoseProcessor::Reset() {
+    m_interpolator.Reset();
+    m_lastRaw = Interpolator::Value{};
+    m_rotationCenter.Reset();
+    m_positionCenter = math::Vec3::Zero();
+    m_smoothedQuat = math::Quat4::Identity();
+    m_smoothedPosition = math::Vec3::Zero();
+    m_lastSequence = 0;
+    m_hasSmoothedValue = false;
+    m_hasRaw = false;
+}
+
+}  // namespace cameraunlock
@@ -0,0 +1,47 @@
+#include "cameraunlock/processing/pose_latch.h"
+#include "cameraunlock/math/angle_utils.h"
+
+namespace cameraunlock {
+
+namespace {
+
+float ClampDelta(float delta, float limit) {
+    return math::Clamp(math::NormalizeAngle(delta), -limit, limit);
+}
+
+}  // namespace
+
+void PoseLatch::SetRenderedSample(const TrackingSample& sample) {
+    // Publish renumbers the copy, so samples are matched by receive time
+    m_rendered.Publish(sample);
+}
+
+bool PoseLatch::CaptureFrameSample(TrackingSample& sample) {
+    if (!m_source || !m_source->TryGetSample(sample) || !sample.IsValid()) {
+        return false;
+    }
+    SetRenderedSample(sample);
+    return true;
+}
+
+LatchedPoseDelta PoseLatch::Latch() const {
+    LatchedPoseDelta delta;
+    TrackingSample rendered;
+    TrackingSample latest;
+    if (!m_source || !m_rendered.TryGet(rendered) || !m_source->TryGetSample(latest) || !latest.IsValid()) {
+        return delta;
+    }
+
+    delta.rendered_timestamp_us = rendered.timestamp_us;
+    delta.latest_timestamp_us = latest.timestamp_us;
+    delta.valid = true;
+    if (!delta.IsLate()) {
+        return delta;
+    }
+    delta.yaw = ClampDelta(latest.yaw - rendered.yaw, m_maxDelta);
+    delta.pitch = ClampDelta(latest.pitch - rendered.pitch, m_maxDelta);
+    delta.roll = ClampDelta(latest.roll - rendered.roll, m_maxDelta);
+    return delta;
+}
+
+}  // namespace cameraunlock
@@ -0,0 +1,118 @@
+#include "cameraunlock/processing/predictive_filter.h"
+#include "cameraunlock/math/angle_utils.h"
+
+namespace cameraunlock {
+
+namespace {
+
+// Steps longer than this are treated as a stream gap: velocity history is
+// stale, so the filter re-initializes instead of integrating across it.
+constexpr float kMaxUpdateGapSeconds = 0.25f;
+
+// Initial angular-velocity variance for the Kalman filter, (rad/s)^2.
+constexpr float kInitialVelocityVariance = 10.0f;
+
+// Exponential smoothing coefficient for a first-order low-pass at cutoff_hz.
+float LowPassAlpha(float cutoff_hz, float dt) {
+    float tau = 1.0f / (2.0f * static_cast<float>(math::kPi) * cutoff_hz);
+    return 1.0f / (1.0f + tau / dt);
+}
+
+}  // namespace
+
+void PredictiveFilter::Reset() {
+    m_filtered = math::Quat4::Identity();
+    m_lastMeasurement = math::Quat4::Identity();
+    m_velocity = math::Vec3::Zero();
+    m_lastTimestampUs = 0;
+    m_initialized = false;
+    m_p00 = m_p01 = m_p11 = 0.0f;
+}
+
+void PredictiveFilter::Update(const math::Quat4& measurement, int64_t timestamp_us) {
+    float dt = static_cast<float>(timestamp_us - m_lastTimestampUs) * 1e-6f;
+
+    if (!m_initialized || dt > kMaxUpdateGapSeconds) {
+        m_filtered = measurement.Normalized();
+        m_lastMeasurement = m_filtered;
+        m_velocity = math::Vec3::Zero();
+        m_lastTimestampUs = timestamp_us;
+        m_initialized = true;
+        m_p00 = m_constantVelocity.measurement_noise;
+        m_p01 = 0.0f;
+        m_p11 = kInitialVelocityVariance;
+        return;
+    }
+    if (dt <= 0.0f) {
+        return;
+    }
+
+    switch (m_mode) {
+        case RotationFilterMode::OneEuro:
+            UpdateOneEuro(measurement, dt);
+            break;
+        case RotationFilterMode::ConstantVelocity:
+            UpdateConstantVelocity(measurement, dt);
+            break;
+        case RotationFilterMode::Exponential:
+            // TrackingProcessor handles exponential smoothing itself; track
+            // the raw measurement so Predict stays meaningful.
+            m_velocity = (m_lastMeasurement.Inverse() * measurement).ToRotationVector() * (1.0f / dt);
+            m_filtered = measurement.Normalized();
+            break;
+    }
+    m_lastMeasurement = measurement.Normalized();
+    m_lastTimestampUs = timestamp_us;
+}
+
+void PredictiveFilter::UpdateOneEuro(const math::Quat4& measurement, float dt) {
+    // Raw body-frame angular velocity between consecutive measurements.
+    // Differencing against the filtered estimate would fold its lag into
+    // the velocity and overshoot when predicting.
+    math::Vec3 rawVelocity = (m_lastMeasurement.Inverse() * measurement).ToRotationVector() * (1.0f / dt);
+
+    float derivativeAlpha = LowPassAlpha(m_oneEuro.derivative_cutoff_hz, dt);
+    m_velocity = math::Vec3::Lerp(m_velocity, rawVelocity, derivativeAlpha);
+
+    float cutoff = m_oneEuro.min_cutoff_hz + m_oneEuro.beta * m_velocity.Magnitude();
+    m_filtered = math::Quat4::Slerp(m_filtered, measurement, LowPassAlpha(cutoff, dt)).Normalized();
+}
+
+void PredictiveFilter::UpdateConstantVelocity(const math::Quat4& measurement, float dt) {
+    // Predict: integrate velocity, grow covariance (white-noise acceleration).
+    math::Quat4 predicted = (m_filtered * math::Quat4::FromRotationVector(m_velocity * dt)).Normalized();
+
+    float q = m_constantVelocity.process_noise;
+    float dt2 = dt * dt;
+    float p00 = m_p00 + dt * (2.0f * m_p01 + dt * m_p11) + q * dt2 * dt / 3.0f;
+    float p01 = m_p01 + dt * m_p11 + q * dt2 * 0.5f;
+    float p11 = m_p11 + q * dt;
+
+    // Correct with the orientation residual (body frame, per axis).
+    math::Vec3 residual = (predicted.Inverse() * measurement).ToRotationVector();
+    float s = p00 + m_constantVelocity.measurement_noise;
+    float k0 = p00 / s;
+    float k1 = p01 / s;
+
+    m_filtered = (predicted * math::Quat4::FromRotationVector(residual * k0)).Normalized();
+    m_velocity = m_velocity + residual * k1;
+
+    m_p00 = (1.0f - k0) * p00;
+    m_p01 = (1.0f - k0) * p01;
+    m_p11 = p11 - k1 * p01;
+}
+
+math::Quat4 PredictiveFilter::Predict(int64_t target_us) const {
+    if (!m_initialized) {
+        return math::Quat4::Identity();
+    }
+
+    float ahead = static_cast<float>(target_us - m_lastTimestampUs) * 1e-6f;
+    ahead = math::Clamp(ahead, 0.0f, m_maxPredictionSeconds);
+    if (ahead <= 0.0f) {
+        return m_filtered;
+    }
+    return (m_filtered * math::Quat4::FromRotationVector(m_velocity * ahead)).Normalized();
+}
+
+}  // namespace cameraunlock
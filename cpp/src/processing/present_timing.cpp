@@ -0,0 +1,110 @@
+#include "cameraunlock/processing/present_timing.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace cameraunlock {
+
+namespace {
+
+// Intervals needed before the median is trusted
+constexpr size_t kMinIntervals = 4;
+
+template <size_t N>
+int64_t Median(const int64_t (&values)[N], size_t count) {
+    int64_t sorted[N];
+    std::copy(values, values + count, sorted);
+    std::nth_element(sorted, sorted + count / 2, sorted + count);
+    return sorted[count / 2];
+}
+
+}  // namespace
+
+void PresentTimingSampler::RecordPresent(int64_t present_us, uint32_t present_id) {
+    if (m_presentCount > 0) {
+        const size_t prev = (m_presentNext + kHistory - 1) % kHistory;
+        const int64_t interval = present_us - m_presentUs[prev];
+        if (interval > 0 && interval <= kMaxIntervalUs) {
+            m_intervalUs[m_intervalNext] = interval;
+            m_intervalNext = (m_intervalNext + 1) % kHistory;
+            if (m_intervalCount < kHistory) ++m_intervalCount;
+            PublishInterval();
+        }
+    }
+
+    m_presentUs[m_presentNext] = present_us;
+    m_presentIds[m_presentNext] = present_id;
+    m_presentNext = (m_presentNext + 1) % kHistory;
+    if (m_presentCount < kHistory) ++m_presentCount;
+    m_lastPresent.store(present_us, std::memory_order_release);
+}
+
+void PresentTimingSampler::RecordScanout(uint32_t present_id, int64_t scanout_us) {
+    if (present_id == 0 || present_id == m_lastScanoutId) {
+        return;
+    }
+    for (size_t i = 0; i < m_presentCount; ++i) {
+        if (m_presentIds[i] != present_id) {
+            continue;
+        }
+        const int64_t latency = scanout_us - m_presentUs[i];
+        if (latency <= 0 || latency > kMaxIntervalUs) {
+            return;
+        }
+        m_lastScanoutId = present_id;
+        m_latencyUs[m_latencyNext] = latency;
+        m_latencyNext = (m_latencyNext + 1) % kLatencyHistory;
+        if (m_latencyCount < kLatencyHistory) ++m_latencyCount;
+        m_latency.store(Median(m_latencyUs, m_latencyCount), std::memory_order_release);
+        return;
+    }
+}
+
+void PresentTimingSampler::Reset() {
+    m_presentNext = 0;
+    m_presentCount = 0;
+    m_intervalNext = 0;
+    m_intervalCount = 0;
+    m_latencyNext = 0;
+    m_latencyCount = 0;
+    m_lastScanoutId = 0;
+    m_lastPresent.store(0, std::memory_order_release);
+    m_interval.store(0, std::memory_order_release);
+    m_latency.store(0, std::memory_order_release);
+}
+
+PresentTimingEstimate PresentTimingSampler::GetEstimate() const {
+    PresentTimingEstimate e;
+    e.last_present_us = m_lastPresent.load(std::memory_order_acquire);
+    e.frame_interval_us = m_interval.load(std::memory_order_acquire);
+    e.scanout_latency_us = m_latency.load(std::memory_order_acquire);
+    return e;
+}
+
+int64_t PresentTimingSampler::PredictNextDisplayTime(int64_t now_us) const {
+    const PresentTimingEstimate e = GetEstimate();
+    if (e.last_present_us == 0 || e.frame_interval_us <= 0) {
+        return 0;
+    }
+    // The next Present is due one interval after the last; if that moment
+    // has already passed (a slow frame, or asked late), the frame will land
+    // on a later slot
+    const int64_t elapsed = std::max<int64_t>(now_us - e.last_present_us, 0);
+    const int64_t slots = elapsed / e.frame_interval_us + 1;
+    return e.last_present_us + slots * e.frame_interval_us + e.scanout_latency_us;
+}
+
+int64_t PresentTimingSampler::PredictNextDisplayTime() const {
+    const int64_t now = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    return PredictNextDisplayTime(now);
+}
+
+void PresentTimingSampler::PublishInterval() {
+    if (m_intervalCount < kMinIntervals) {
+        return;
+    }
+    m_interval.store(Median(m_intervalUs, m_intervalCount), std::memory_order_release);
+}
+
+}  // namespace cameraunlock
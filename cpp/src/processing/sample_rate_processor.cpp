@@ -0,0 +1,158 @@
+#include "cameraunlock/processing/sample_rate_processor.h"
+
+#include <algorithm>
+
+namespace cameraunlock {
+
+namespace {
+// As for SharedTrackingSample: a retry needs a whole Publish inside one read
+constexpr int kMaxPoseReadAttempts = 8;
+
+void StoreQuat(std::atomic<float>* out, const math::Quat4& q) {
+    out[0].store(q.x, std::memory_order_relaxed);
+    out[1].store(q.y, std::memory_order_relaxed);
+    out[2].store(q.z, std::memory_order_relaxed);
+    out[3].store(q.w, std::memory_order_relaxed);
+}
+
+math::Quat4 LoadQuat(const std::atomic<float>* in) {
+    return math::Quat4(in[0].load(std::memory_order_relaxed), in[1].load(std::memory_order_relaxed),
+                       in[2].load(std::memory_order_relaxed), in[3].load(std::memory_order_relaxed));
+}
+}  // namespace
+
+void SampleRateProcessor::OnSample(const TrackingSample& sample) {
+    ApplyCommands();
+    if (!sample.IsValid() || sample.sequence == m_pair.latest.sequence) {
+        return;
+    }
+
+    // Step the filter by the real sample interval, capped so a dropout
+    // doesn't count as one enormous frame; the first sample seeds it
+    const int64_t sampleUs = sample.MeasurementUs();
+    const int64_t intervalUs = sampleUs - m_lastSampleUs;
+    const bool continuous = m_pair.latest.IsValid() && intervalUs > 0 && intervalUs <= kMaxSampleGapUs;
+    const float deltaTime = m_pair.latest.IsValid() && intervalUs > 0
+        ? static_cast<float>(std::min(intervalUs, kMaxSampleGapUs)) * 1e-6f
+        : 0.0f;
+    m_lastSampleUs = sampleUs;
+
+    ProcessedPose pose;
+    pose.rotation = m_processor.ProcessQuat(sample.yaw, sample.pitch, sample.roll, deltaTime);
+    pose.timestamp_us = sampleUs;
+    pose.sequence = sample.sequence;
+
+    // Across a gap there is nothing to blend from; Evaluate holds the pose
+    m_pair.previous = continuous ? m_pair.latest : pose;
+    m_pair.latest = pose;
+    Publish(m_pair);
+}
+
+bool SampleRateProcessor::Evaluate(int64_t render_us, math::Quat4& rotation) const {
+    PosePair pair;
+    if (!TryRead(pair)) {
+        return false;
+    }
+
+    const math::Quat4& a = pair.previous.rotation;
+    const math::Quat4& b = pair.latest.rotation;
+    const int64_t intervalUs = pair.latest.timestamp_us - pair.previous.timestamp_us;
+    if (intervalUs <= 0) {
+        rotation = b;
+        return true;
+    }
+
+    float t = static_cast<float>(render_us - m_renderDelayUs - pair.previous.timestamp_us) /
+              static_cast<float>(intervalUs);
+    t = std::clamp(t, 0.0f, 1.0f + m_maxExtrapolationFraction);
+
+    // Normalized lerp on the shorter arc: the poses are one tracker
+    // interval apart, where it is indistinguishable from SLERP
+    const float sign = a.Dot(b) < 0.0f ? -1.0f : 1.0f;
+    rotation = math::Quat4(a.x + t * (sign * b.x - a.x), a.y + t * (sign * b.y - a.y),
+                           a.z + t * (sign * b.z - a.z), a.w + t * (sign * b.w - a.w))
+                   .Normalized();
+    return true;
+}
+
+bool SampleRateProcessor::TryGetLatest(ProcessedPose& pose) const {
+    PosePair pair;
+    if (!TryRead(pair)) {
+        return false;
+    }
+    pose = pair.latest;
+    return true;
+}
+
+bool SampleRateProcessor::Recenter() {
+    return m_commands.TryPush(Command::Recenter);
+}
+
+bool SampleRateProcessor::Reset() {
+    return m_commands.TryPush(Command::Reset);
+}
+
+void SampleRateProcessor::ApplyCommands() {
+    Command command;
+    while (m_commands.TryPop(command)) {
+        switch (command) {
+            case Command::Recenter:
+                m_processor.Recenter();
+                break;
+            case Command::Reset:
+                // The published pair stays until the next sample replaces it
+                m_processor.Reset();
+                m_pair = PosePair();
+                m_lastSampleUs = 0;
+                break;
+        }
+    }
+}
+
+void SampleRateProcessor::Slot::Store(const PosePair& pair) {
+    StoreQuat(latest, pair.latest.rotation);
+    StoreQuat(previous, pair.previous.rotation);
+    latest_us.store(pair.latest.timestamp_us, std::memory_order_relaxed);
+    previous_us.store(pair.previous.timestamp_us, std::memory_order_relaxed);
+    latest_sequence.store(pair.latest.sequence, std::memory_order_relaxed);
+    previous_sequence.store(pair.previous.sequence, std::memory_order_relaxed);
+}
+
+void SampleRateProcessor::Slot::Load(PosePair& pair) const {
+    pair.latest.rotation = LoadQuat(latest);
+    pair.previous.rotation = LoadQuat(previous);
+    pair.latest.timestamp_us = latest_us.load(std::memory_order_relaxed);
+    pair.previous.timestamp_us = previous_us.load(std::memory_order_relaxed);
+    pair.latest.sequence = latest_sequence.load(std::memory_order_relaxed);
+    pair.previous.sequence = previous_sequence.load(std::memory_order_relaxed);
+}
+
+void SampleRateProcessor::Publish(const PosePair& pair) {
+    // Odd latch: readers use slot 1 while slot 0 is rewritten.
+    uint32_t latch = m_latch.load(std::memory_order_relaxed);
+    m_latch.store(latch + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    m_slots[0].Store(pair);
+
+    // Even latch: readers use slot 0 while slot 1 catches up.
+    m_latch.store(latch + 2, std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_release);
+    m_slots[1].Store(pair);
+}
+
+bool SampleRateProcessor::TryRead(PosePair& pair) const {
+    for (int attempt = 0; attempt < kMaxPoseReadAttempts; ++attempt) {
+        uint32_t latch = m_latch.load(std::memory_order_acquire);
+        PosePair p;
+        m_slots[latch & 1u].Load(p);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (m_latch.load(std::memory_order_relaxed) == latch) {
+            if (!p.latest.IsValid()) return false;
+            pair = p;
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace cameraunlock
@@ -6,21 +6,71 @@
 namespace cameraunlock {
 
 TrackingPose TrackingProcessor::Process(float yaw, float pitch, float roll, float delta_time) {
-    // Step 1: Apply center offset
-    m_centerManager.ApplyOffset(yaw, pitch, roll);
+    SyncSettings();
+    return ApplyOutputStages(FilterRotation(yaw, pitch, roll, delta_time));
+}
 
-    // Step 2: Apply deadzone
-    yaw = static_cast<float>(math::ApplyDeadzone(yaw, m_deadzone.yaw));
-    pitch = static_cast<float>(math::ApplyDeadzone(pitch, m_deadzone.pitch));
-    roll = static_cast<float>(math::ApplyDeadzone(roll, m_deadzone.roll));
+TrackingPose TrackingProcessor::ProcessPredicted(float yaw, float pitch, float roll,
+                                                 int64_t sample_us, int64_t target_us) {
+    SyncSettings();
+    return ApplyOutputStages(PredictRotation(yaw, pitch, roll, sample_us, target_us));
+}
+
+TrackingPose TrackingProcessor::Process(const TrackingSample& sample, float delta_time) {
+    if (!m_trace) {
+        return Process(sample.yaw, sample.pitch, sample.roll, delta_time);
+    }
+    const int64_t beginUs = TrackingPose::CurrentTimestamp();
+    TrackingPose pose = Process(sample.yaw, sample.pitch, sample.roll, delta_time);
+    m_trace->MarkProcessed(sample.sequence, beginUs, TrackingPose::CurrentTimestamp());
+    return pose;
+}
+
+TrackingPose TrackingProcessor::ProcessPredicted(const TrackingSample& sample, int64_t target_us) {
+    if (!m_trace) {
+        return ProcessPredicted(sample.yaw, sample.pitch, sample.roll, sample.MeasurementUs(), target_us);
+    }
+    const int64_t beginUs = TrackingPose::CurrentTimestamp();
+    TrackingPose pose = ProcessPredicted(sample.yaw, sample.pitch, sample.roll, sample.MeasurementUs(), target_us);
+    m_trace->MarkProcessed(sample.sequence, beginUs, TrackingPose::CurrentTimestamp());
+    return pose;
+}
+
+math::Quat4 TrackingProcessor::ProcessQuat(float yaw, float pitch, float roll, float delta_time) {
+    SyncSettings();
+    return ApplySensitivity(FilterRotation(yaw, pitch, roll, delta_time));
+}
+
+math::Quat4 TrackingProcessor::ProcessQuatPredicted(float yaw, float pitch, float roll,
+                                                    int64_t sample_us, int64_t target_us) {
+    SyncSettings();
+    return ApplySensitivity(PredictRotation(yaw, pitch, roll, sample_us, target_us));
+}
+
+void TrackingProcessor::SyncSettings() {
+    TrackingProcessorSettings settings;
+    if (m_settingsChannel && m_settingsChannel->ReadIfChanged(m_settingsVersion, settings)) {
+        m_sensitivity = settings.sensitivity;
+        m_deadzone = settings.deadzone;
+        m_smoothingFactor = settings.smoothing;
+    }
+}
+
+math::Quat4 TrackingProcessor::FilterRotation(float yaw, float pitch, float roll, float delta_time) {
+    if (m_filterMode != RotationFilterMode::Exponential) {
+        // Predictive modes run on timestamps; advance a private clock by the
+        // frame delta and filter without predicting ahead.
+        m_syntheticClockUs += static_cast<int64_t>(static_cast<double>(delta_time) * 1e6);
+        return PredictRotation(yaw, pitch, roll, m_syntheticClockUs, m_syntheticClockUs);
+    }
+
+    math::Quat4 target = ApplyInputStages(yaw, pitch, roll);
 
     // Step 3: Apply smoothing via quaternion SLERP.
     // SLERP follows the shortest arc on the unit sphere, avoiding the gimbal
     // artifacts that per-axis Euler smoothing can introduce at compound angles.
     double effective_smoothing = math::GetEffectiveSmoothing(m_smoothingFactor);
 
-    math::Quat4 target = math::Quat4::FromYawPitchRoll(yaw, pitch, roll);
-
     if (!m_hasSmoothedValue) {
         m_smoothedQuat = target;
         m_hasSmoothedValue = true;
@@ -30,9 +80,54 @@ TrackingPose TrackingProcessor::Process(float yaw, float pitch, float roll, floa
         m_smoothedQuat = math::Quat4::Slerp(m_smoothedQuat, target, t);
     }
 
+    return m_smoothedQuat;
+}
+
+math::Quat4 TrackingProcessor::PredictRotation(float yaw, float pitch, float roll,
+                                               int64_t sample_us, int64_t target_us) {
+    bool isNewSample = !m_filter.HasValue() || sample_us > m_filter.GetLastTimestamp();
+
+    if (isNewSample) {
+        math::Quat4 target = ApplyInputStages(yaw, pitch, roll);
+
+        if (m_filterMode == RotationFilterMode::Exponential) {
+            if (!m_hasSmoothedValue) {
+                m_smoothedQuat = target;
+                m_hasSmoothedValue = true;
+            } else {
+                double dt = static_cast<double>(sample_us - m_filter.GetLastTimestamp()) * 1e-6;
+                float t = static_cast<float>(math::CalculateSmoothingFactor(
+                    math::GetEffectiveSmoothing(m_smoothingFactor), dt));
+                m_smoothedQuat = math::Quat4::Slerp(m_smoothedQuat, target, t);
+            }
+            // Filter tracks the smoothed output so prediction uses its velocity.
+            m_filter.Update(m_smoothedQuat, sample_us);
+        } else {
+            m_filter.Update(target, sample_us);
+            m_smoothedQuat = m_filter.GetFiltered();
+            m_hasSmoothedValue = true;
+        }
+    }
+
+    return m_filter.Predict(target_us);
+}
+
+math::Quat4 TrackingProcessor::ApplyInputStages(float yaw, float pitch, float roll) {
+    // Step 1: Apply center offset
+    m_centerManager.ApplyOffset(yaw, pitch, roll);
+
+    // Step 2: Apply deadzone
+    yaw = static_cast<float>(math::ApplyDeadzone(yaw, m_deadzone.yaw));
+    pitch = static_cast<float>(math::ApplyDeadzone(pitch, m_deadzone.pitch));
+    roll = static_cast<float>(math::ApplyDeadzone(roll, m_deadzone.roll));
+
+    return math::Quat4::FromYawPitchRoll(yaw, pitch, roll);
+}
+
+TrackingPose TrackingProcessor::ApplyOutputStages(const math::Quat4& rotation) const {
     // Decompose back to Euler for sensitivity application
     float smoothedYaw, smoothedPitch, smoothedRoll;
-    m_smoothedQuat.ToEulerYXZ(smoothedYaw, smoothedPitch, smoothedRoll);
+    rotation.ToEulerYXZ(smoothedYaw, smoothedPitch, smoothedRoll);
 
     // Step 4: Apply sensitivity
     float out_yaw = smoothedYaw * m_sensitivity.yaw;
@@ -46,22 +141,53 @@ TrackingPose TrackingProcessor::Process(float yaw, float pitch, float roll, floa
     return TrackingPose(out_yaw, out_pitch, out_roll);
 }
 
+math::Quat4 TrackingProcessor::ApplySensitivity(const math::Quat4& rotation) const {
+    float scalePitch = m_sensitivity.invert_pitch ? -m_sensitivity.pitch : m_sensitivity.pitch;
+    float scaleYaw = m_sensitivity.invert_yaw ? -m_sensitivity.yaw : m_sensitivity.yaw;
+    float scaleRoll = m_sensitivity.invert_roll ? -m_sensitivity.roll : m_sensitivity.roll;
+
+    if (scalePitch == 1.0f && scaleYaw == 1.0f && scaleRoll == 1.0f) {
+        return rotation;
+    }
+
+    math::Vec3 v = rotation.ToRotationVector();
+    return math::Quat4::FromRotationVector(
+        math::Vec3(v.x * scalePitch, v.y * scaleYaw, v.z * scaleRoll));
+}
+
+void TrackingProcessor::SetFilterMode(RotationFilterMode mode) {
+    m_filterMode = mode;
+    m_filter.SetMode(mode);
+    m_smoothedQuat = math::Quat4::Identity();
+    m_hasSmoothedValue = false;
+    m_syntheticClockUs = 0;
+}
+
 void TrackingProcessor::Recenter() {
     float yaw, pitch, roll;
     m_smoothedQuat.ToEulerYXZ(yaw, pitch, roll);
     m_centerManager.SetCenter(yaw, pitch, roll);
+    // The filter's frame just moved; drop its velocity rather than read the
+    // recenter step as head motion.
+    if (m_filterMode != RotationFilterMode::Exponential) {
+        m_filter.Reset();
+        m_hasSmoothedValue = false;
+    }
 }
 
 void TrackingProcessor::RecenterTo(float yaw, float pitch, float roll) {
     m_centerManager.SetCenter(yaw, pitch, roll);
     m_smoothedQuat = math::Quat4::Identity();
     m_hasSmoothedValue = false;
+    m_filter.Reset();
 }
 
 void TrackingProcessor::Reset() {
     m_centerManager.Reset();
     m_smoothedQuat = math::Quat4::Identity();
     m_hasSmoothedValue = false;
+    m_filter.Reset();
+    m_syntheticClockUs = 0;
 }
 
 }  // namespace cameraunlock
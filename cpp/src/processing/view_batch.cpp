@@ -0,0 +1,106 @@
+#include "cameraunlock/processing/view_batch.h"
+
+#include <cmath>
+
+namespace cameraunlock {
+
+namespace {
+
+// One instantiation per combination of optional inputs; the flags are
+// compile-time so the loop body carries no per-view branches.
+template <bool kHasEye, bool kHasScale, bool kHasRotation>
+void ProcessBatchKernel(const math::Quat4& head, const math::Vec3& headPos,
+                        const ViewBatchInput& in, size_t count, const ViewBatchOutput& out) {
+    for (size_t i = 0; i < count; ++i) {
+        // Head rotation for this view: nlerp(identity, head, scale)
+        float hx = head.x, hy = head.y, hz = head.z, hw = head.w;
+        if (kHasScale) {
+            float s = in.rotation_scale[i];
+            hx *= s;
+            hy *= s;
+            hz *= s;
+            hw = 1.0f + (hw - 1.0f) * s;
+            float inv = 1.0f / std::sqrt(hx * hx + hy * hy + hz * hz + hw * hw);
+            hx *= inv;
+            hy *= inv;
+            hz *= inv;
+            hw *= inv;
+        }
+
+        // Position: head position + rotated head-local offset
+        float ox = in.offset_x[i] + (kHasEye ? in.eye_offset[i] : 0.0f);
+        float oy = in.offset_y[i];
+        float oz = in.offset_z[i];
+
+        float x2 = hx + hx, y2 = hy + hy, z2 = hz + hz;
+        float xx2 = hx * x2, yy2 = hy * y2, zz2 = hz * z2;
+        float xy2 = hx * y2, xz2 = hx * z2, yz2 = hy * z2;
+        float wx2 = hw * x2, wy2 = hw * y2, wz2 = hw * z2;
+
+        out.position_x[i] = headPos.x + (1.0f - yy2 - zz2) * ox + (xy2 - wz2) * oy + (xz2 + wy2) * oz;
+        out.position_y[i] = headPos.y + (xy2 + wz2) * ox + (1.0f - xx2 - zz2) * oy + (yz2 - wx2) * oz;
+        out.position_z[i] = headPos.z + (xz2 - wy2) * ox + (yz2 + wx2) * oy + (1.0f - xx2 - yy2) * oz;
+
+        // Rotation: head * view
+        if (kHasRotation) {
+            float bx = in.rotation_x[i], by = in.rotation_y[i];
+            float bz = in.rotation_z[i], bw = in.rotation_w[i];
+            out.rotation_x[i] = hw * bx + hx * bw + hy * bz - hz * by;
+            out.rotation_y[i] = hw * by - hx * bz + hy * bw + hz * bx;
+            out.rotation_z[i] = hw * bz + hx * by - hy * bx + hz * bw;
+            out.rotation_w[i] = hw * bw - hx * bx - hy * by - hz * bz;
+        } else {
+            out.rotation_x[i] = hx;
+            out.rotation_y[i] = hy;
+            out.rotation_z[i] = hz;
+            out.rotation_w[i] = hw;
+        }
+    }
+}
+
+template <bool kHasEye, bool kHasScale>
+void DispatchRotation(const math::Quat4& head, const math::Vec3& headPos,
+                      const ViewBatchInput& in, size_t count, const ViewBatchOutput& out) {
+    if (in.rotation_x && in.rotation_y && in.rotation_z && in.rotation_w) {
+        ProcessBatchKernel<kHasEye, kHasScale, true>(head, headPos, in, count, out);
+    } else {
+        ProcessBatchKernel<kHasEye, kHasScale, false>(head, headPos, in, count, out);
+    }
+}
+
+template <bool kHasEye>
+void DispatchScale(const math::Quat4& head, const math::Vec3& headPos,
+                   const ViewBatchInput& in, size_t count, const ViewBatchOutput& out) {
+    if (in.rotation_scale) {
+        DispatchRotation<kHasEye, true>(head, headPos, in, count, out);
+    } else {
+        DispatchRotation<kHasEye, false>(head, headPos, in, count, out);
+    }
+}
+
+}  // namespace
+
+void ProcessBatch(const math::Quat4& head_rotation, const math::Vec3& head_position,
+                  const ViewBatchInput& views, size_t count, const ViewBatchOutput& out) {
+    if (count == 0 || !views.offset_x || !views.offset_y || !views.offset_z) {
+        return;
+    }
+
+    // Shortest-arc form so rotation_scale interpolates the short way
+    math::Quat4 head = head_rotation.w < 0.0f ? head_rotation.Negated() : head_rotation;
+
+    if (views.eye_offset) {
+        DispatchScale<true>(head, head_position, views, count, out);
+    } else {
+        DispatchScale<false>(head, head_position, views, count, out);
+    }
+}
+
+void ProcessBatch(const HeadPoseFrame& frame, const ViewBatchInput& views, size_t count,
+                  const ViewBatchOutput& out) {
+    math::Quat4 rotation = frame.IsRotationValid() ? frame.rotation : math::Quat4::Identity();
+    math::Vec3 position = frame.IsPositionValid() ? frame.position : math::Vec3::Zero();
+    ProcessBatch(rotation, position, views, count, out);
+}
+
+}  // namespace cameraunlock
@@ -0,0 +1,74 @@
+#include "cameraunlock/protocol/capture_file.h"
+
+#include <cstring>
+
+namespace cameraunlock {
+
+constexpr char CaptureFormat::kMagic[8];
+
+namespace {
+constexpr size_t kWriteBufferSize = 64 * 1024;
+}
+
+CaptureWriter::~CaptureWriter() {
+    Close();
+}
+
+bool CaptureWriter::Open(const std::string& path) {
+    Close();
+
+#ifdef _MSC_VER
+    if (fopen_s(&m_file, path.c_str(), "wb") != 0) {
+        m_file = nullptr;
+    }
+#else
+    m_file = std::fopen(path.c_str(), "wb");
+#endif
+    if (m_file == nullptr) {
+        return false;
+    }
+    std::setvbuf(m_file, nullptr, _IOFBF, kWriteBufferSize);
+
+    unsigned char header[CaptureFormat::kHeaderSize] = {};
+    std::memcpy(header, CaptureFormat::kMagic, sizeof(CaptureFormat::kMagic));
+    uint32_t version = CaptureFormat::kVersion;
+    std::memcpy(header + 8, &version, sizeof(version));
+
+    if (std::fwrite(header, 1, sizeof(header), m_file) != sizeof(header)) {
+        Close();
+        return false;
+    }
+    m_records = 0;
+    return true;
+}
+
+void CaptureWriter::Close() {
+    if (m_file != nullptr) {
+        std::fclose(m_file);
+        m_file = nullptr;
+    }
+}
+
+bool CaptureWriter::Append(const void* data, size_t length, int64_t arrivalUs) {
+    if (m_file == nullptr) {
+        return false;
+    }
+    if (length > CaptureFormat::kMaxPayloadSize) {
+        length = CaptureFormat::kMaxPayloadSize;
+    }
+
+    unsigned char record[CaptureFormat::kRecordHeaderSize];
+    uint16_t length16 = static_cast<uint16_t>(length);
+    std::memcpy(record, &arrivalUs, sizeof(arrivalUs));
+    std::memcpy(record + 8, &length16, sizeof(length16));
+
+    if (std::fwrite(record, 1, sizeof(record), m_file) != sizeof(record) ||
+        std::fwrite(data, 1, length, m_file) != length) {
+        Close();
+        return false;
+    }
+    ++m_records;
+    return true;
+}
+
+}  // namespace cameraunlock
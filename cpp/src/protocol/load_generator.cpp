@@ -0,0 +1,428 @@
+#include "cameraunlock/protocol/load_generator.h"
+#include "cameraunlock/config/ini_reader.h"
+#include "cameraunlock/protocol/opentrack_packet.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+namespace cameraunlock {
+
+namespace {
+constexpr double kTwoPi = 6.283185307179586;
+constexpr int64_t kNoEnd = std::numeric_limits<int64_t>::max();
+
+// Spacing assumed between capture records when the capture has only one
+constexpr int64_t kDefaultCaptureGapUs = 4000;
+
+// Duplicates trail their original by up to this much
+constexpr uint64_t kDuplicateSpreadUs = 1000;
+
+int64_t MsToUs(double ms) {
+    return static_cast<int64_t>(std::llround(ms * 1000.0));
+}
+
+void WriteDouble(uint8_t* out, size_t offset, double value) {
+    std::memcpy(out + offset, &value, sizeof(double));
+}
+}  // namespace
+
+bool LoadGenerator::LoadProfile(const std::string& path) {
+    IniReader ini;
+    if (!ini.Open(path)) {
+        return false;
+    }
+
+    std::vector<LoadPhase> phases;
+    LoadPhase phase;
+    for (int i = 1;; ++i) {
+        char section[32];
+        std::snprintf(section, sizeof(section), "phase%d", i);
+        const int64_t durationMs = ini.ReadInt64(section, "duration_ms", -1);
+        if (durationMs < 0) {
+            break;
+        }
+        phase.durationMs = durationMs;
+        phase.rateHz = ini.ReadDouble(section, "rate_hz", phase.rateHz);
+        phase.senders = ini.ReadInt(section, "senders", phase.senders);
+        phase.jitterMs = ini.ReadDouble(section, "jitter_ms", phase.jitterMs);
+        phase.burstIntervalMs = ini.ReadDouble(section, "burst_interval_ms", phase.burstIntervalMs);
+        phase.burstHoldMs = ini.ReadDouble(section, "burst_hold_ms", phase.burstHoldMs);
+        phase.loss = ini.ReadDouble(section, "loss", phase.loss);
+        phase.reorder = ini.ReadDouble(section, "reorder", phase.reorder);
+        phase.reorderDepth = ini.ReadInt(section, "reorder_depth", phase.reorderDepth);
+        phase.duplicate = ini.ReadDouble(section, "duplicate", phase.duplicate);
+        phase.malformed = ini.ReadDouble(section, "malformed", phase.malformed);
+        phase.outOfRange = ini.ReadDouble(section, "out_of_range", phase.outOfRange);
+        phase.yawAmplitude = ini.ReadDouble(section, "yaw_amplitude", phase.yawAmplitude);
+        phase.pitchAmplitude = ini.ReadDouble(section, "pitch_amplitude", phase.pitchAmplitude);
+        phase.rollAmplitude = ini.ReadDouble(section, "roll_amplitude", phase.rollAmplitude);
+        phase.positionAmplitudeCm = ini.ReadDouble(section, "position_amplitude_cm", phase.positionAmplitudeCm);
+        phase.motionHz = ini.ReadDouble(section, "motion_hz", phase.motionHz);
+        phase.extended = ini.ReadBool(section, "extended", phase.extended);
+        phases.push_back(phase);
+    }
+    if (phases.empty()) {
+        return false;
+    }
+
+    const std::string seed = ini.ReadString("generator", "seed");
+    if (!seed.empty()) {
+        m_seed = std::strtoull(seed.c_str(), nullptr, 0);
+    }
+    m_loop = ini.ReadBool("generator", "loop", m_loop);
+    const std::string capture = ini.ReadString("generator", "capture");
+    if (!capture.empty() && !UseCapture(capture)) {
+        return false;
+    }
+
+    m_phases = std::move(phases);
+    return true;
+}
+
+bool LoadGenerator::UseCapture(const std::string& path) {
+    m_capture.Close();
+    if (path.empty()) {
+        return true;
+    }
+    if (!m_capture.Open(path)) {
+        return false;
+    }
+
+    // One pass for the timeline: first and last arrival, record count
+    const uint8_t* data;
+    size_t length;
+    int64_t arrivalUs;
+    uint64_t records = 0;
+    int64_t lastUs = 0;
+    while (m_capture.NextRaw(data, length, arrivalUs)) {
+        if (records == 0) {
+            m_captureFirstUs = arrivalUs;
+        }
+        lastUs = std::max(lastUs, arrivalUs);
+        ++records;
+    }
+    if (records == 0) {
+        m_capture.Close();
+        return false;
+    }
+    m_captureGapUs = records > 1
+        ? std::max<int64_t>(1, (lastUs - m_captureFirstUs) / static_cast<int64_t>(records - 1))
+        : kDefaultCaptureGapUs;
+    m_captureSpanUs = lastUs - m_captureFirstUs + m_captureGapUs;
+    m_capture.Rewind();
+    return true;
+}
+
+void LoadGenerator::Begin() {
+    // SplitMix64 state; a zero seed is as good as any other
+    m_rng = m_seed;
+    m_sequence = 0;
+    m_order = 0;
+    m_counters = LoadCounters();
+    m_pending = decltype(m_pending)();
+    m_finished = m_phases.empty();
+    if (!m_finished) {
+        BeginPhase(0, 0);
+    }
+}
+
+void LoadGenerator::BeginPhase(size_t index, int64_t startUs) {
+    const LoadPhase& phase = m_phases[index];
+    m_phase = index;
+    m_phaseStartUs = startUs;
+    m_phaseEndUs = phase.durationMs > 0 ? startUs + phase.durationMs * 1000 : kNoEnd;
+    m_phaseCount = 0;
+    m_nextNominalUs = startUs;
+
+    if (m_capture.IsOpen()) {
+        m_periodUs = m_captureGapUs;
+        m_captureOffsetUs = startUs;
+        m_capture.Rewind();
+        PeekCapture();
+    } else {
+        const double rateHz = phase.rateHz > 0.0 ? phase.rateHz : 1.0;
+        m_periodUs = std::max<int64_t>(1, static_cast<int64_t>(std::llround(1000000.0 / rateHz)));
+    }
+}
+
+bool LoadGenerator::PeekCapture() {
+    if (!m_capture.NextRaw(m_peekData, m_peekLength, m_peekUs)) {
+        // Wrap: the next pass starts one span later
+        m_capture.Rewind();
+        m_captureOffsetUs += m_captureSpanUs;
+        if (!m_capture.NextRaw(m_peekData, m_peekLength, m_peekUs)) {
+            return false;
+        }
+    }
+    m_nextNominalUs = m_captureOffsetUs + std::max<int64_t>(0, m_peekUs - m_captureFirstUs);
+    return true;
+}
+
+bool LoadGenerator::Next(GeneratedDatagram& out) {
+    while (!m_finished) {
+        // Every fault only delays, so nothing still unscheduled can be due
+        // before the next clean datagram (or the next phase's start)
+        const int64_t horizon = std::min(m_nextNominalUs, m_phaseEndUs);
+        if (!m_pending.empty() && m_pending.top().dueUs <= horizon) {
+            break;
+        }
+        GeneratedDatagram datagram;
+        if (NextNominal(datagram)) {
+            Schedule(datagram);
+        } else if (m_phase + 1 < m_phases.size()) {
+            BeginPhase(m_phase + 1, m_phaseEndUs);
+        } else if (m_loop) {
+            BeginPhase(0, m_phaseEndUs);
+        } else {
+            m_finished = true;
+        }
+    }
+    if (m_pending.empty()) {
+        return false;
+    }
+    out = m_pending.top().datagram;
+    m_pending.pop();
+    ++m_counters.emitted;
+    return true;
+}
+
+bool LoadGenerator::NextNominal(GeneratedDatagram& out) {
+    if (m_nextNominalUs >= m_phaseEndUs) {
+        return false;
+    }
+    const LoadPhase& phase = m_phases[m_phase];
+    out.sourceUs = m_nextNominalUs;
+    out.sequence = ++m_sequence;
+    out.kind = DatagramKind::Valid;
+
+    if (m_capture.IsOpen()) {
+        out.sender = 0;
+        out.length = static_cast<uint16_t>(std::min(m_peekLength, GeneratedDatagram::kMaxSize));
+        std::memcpy(out.data, m_peekData, out.length);
+        ++m_phaseCount;
+        PeekCapture();
+        return true;
+    }
+
+    const int senders = std::clamp(phase.senders, 1, LoadSender::kMaxSenders);
+    out.sender = static_cast<uint16_t>(m_phaseCount % static_cast<uint64_t>(senders));
+    TrackingPose pose;
+    PositionData position;
+    PoseAt(phase, out.sender, out.sourceUs, pose, position);
+    out.length = static_cast<uint16_t>(phase.extended
+        ? EncodeExtendedPacket(pose, position, out.sequence, out.sourceUs, out.data)
+        : EncodePacket(pose, position, out.data));
+
+    // Senders share each period evenly: slot + sender / senders periods in
+    ++m_phaseCount;
+    const double rateHz = phase.rateHz > 0.0 ? phase.rateHz : 1.0;
+    const double periods = static_cast<double>(m_phaseCount / static_cast<uint64_t>(senders)) +
+                           static_cast<double>(m_phaseCount % static_cast<uint64_t>(senders)) / senders;
+    m_nextNominalUs = m_phaseStartUs + static_cast<int64_t>(std::llround(periods * 1000000.0 / rateHz));
+    return true;
+}
+
+void LoadGenerator::Schedule(GeneratedDatagram& datagram) {
+    const LoadPhase& phase = m_phases[m_phase];
+    ++m_counters.nominal;
+    if (Chance(phase.loss)) {
+        ++m_counters.lost;
+        return;
+    }
+
+    int64_t due = datagram.sourceUs;
+    const int64_t burstIntervalUs = MsToUs(phase.burstIntervalMs);
+    const int64_t burstHoldUs = MsToUs(phase.burstHoldMs);
+    if (burstIntervalUs > 0 && burstHoldUs > 0) {
+        const int64_t intoInterval = (due - m_phaseStartUs) % burstIntervalUs;
+        if (intoInterval < burstHoldUs) {
+            due += burstHoldUs - intoInterval;
+            ++m_counters.burstHeld;
+        }
+    }
+    if (phase.jitterMs > 0.0) {
+        due += static_cast<int64_t>(Uniform() * phase.jitterMs * 1000.0);
+    }
+    if (Chance(phase.reorder)) {
+        const uint64_t depth = static_cast<uint64_t>(std::max(1, phase.reorderDepth));
+        due += static_cast<int64_t>(1 + Random() % depth) * m_periodUs;
+        ++m_counters.reordered;
+    }
+
+    const double fault = (phase.malformed > 0.0 || phase.outOfRange > 0.0) ? Uniform() : 1.0;
+    if (fault < phase.malformed) {
+        Corrupt(datagram);
+    } else if (fault < phase.malformed + phase.outOfRange) {
+        Poison(datagram);
+    }
+
+    datagram.dueUs = due;
+    Push(datagram);
+
+    if (Chance(phase.duplicate)) {
+        if (datagram.kind == DatagramKind::Valid) {
+            datagram.kind = DatagramKind::Duplicate;
+        }
+        datagram.dueUs = due + static_cast<int64_t>(Random() % kDuplicateSpreadUs);
+        Push(datagram);
+        ++m_counters.duplicated;
+    }
+}
+
+void LoadGenerator::Push(const GeneratedDatagram& datagram) {
+    m_pending.push(Pending{datagram.dueUs, m_order++, datagram});
+}
+
+void LoadGenerator::Corrupt(GeneratedDatagram& datagram) {
+    datagram.kind = DatagramKind::Malformed;
+    ++m_counters.malformed;
+    const size_t shortLength = 1 + Random() % (OpenTrackPacket::kMinPacketSize - 1);
+    switch (Random() % 3) {
+        case 0:  // Empty datagram
+            datagram.length = 0;
+            break;
+        case 1:  // Truncated packet
+            datagram.length = static_cast<uint16_t>(std::min<size_t>(shortLength, datagram.length));
+            break;
+        default:  // Short junk
+            datagram.length = static_cast<uint16_t>(shortLength);
+            for (size_t i = 0; i < shortLength; ++i) {
+                datagram.data[i] = static_cast<uint8_t>(Random());
+            }
+            break;
+    }
+}
+
+void LoadGenerator::Poison(GeneratedDatagram& datagram) {
+    datagram.kind = DatagramKind::OutOfRange;
+    ++m_counters.outOfRange;
+    if (OpenTrackPacket::IsExtended(datagram.data, datagram.length)) {
+        // Float fields: NaN, infinity, or finite but absurd
+        const size_t offset = OpenTrackPacket::kExtendedPoseOffset + (Random() % 6) * sizeof(float);
+        float value;
+        switch (Random() % 4) {
+            case 0: value = std::numeric_limits<float>::quiet_NaN(); break;
+            case 1: value = std::numeric_limits<float>::infinity(); break;
+            case 2: value = -std::numeric_limits<float>::infinity(); break;
+            default: value = (Random() & 1) ? 1e6f : -1e6f; break;  // Parses; absurd
+        }
+        std::memcpy(datagram.data + offset, &value, sizeof(value));
+        return;
+    }
+    if (datagram.length < OpenTrackPacket::kMinPacketSize) {
+        std::memset(datagram.data + datagram.length, 0, OpenTrackPacket::kMinPacketSize - datagram.length);
+        datagram.length = static_cast<uint16_t>(OpenTrackPacket::kMinPacketSize);
+    }
+
+    // Any of the six fields: x, y, z, yaw, pitch, roll
+    const size_t offset = (Random() % 6) * sizeof(double);
+    double value;
+    switch (Random() % 5) {
+        case 0: value = std::numeric_limits<double>::quiet_NaN(); break;
+        case 1: value = std::numeric_limits<double>::infinity(); break;
+        case 2: value = -std::numeric_limits<double>::infinity(); break;
+        case 3: value = 1e300; break;  // Finite, overflows float
+        default: value = (Random() & 1) ? 1e6 : -1e6; break;  // Parses; absurd
+    }
+    WriteDouble(datagram.data, offset, value);
+}
+
+uint64_t LoadGenerator::Random() {
+    // SplitMix64: tiny, fast, and identical on every platform
+    uint64_t z = (m_rng += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+double LoadGenerator::Uniform() {
+    return static_cast<double>(Random() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+bool LoadGenerator::Chance(double probability) {
+    return probability > 0.0 && Uniform() < probability;
+}
+
+void LoadGenerator::PoseAt(const LoadPhase& phase, int sender, int64_t sourceUs,
+                           TrackingPose& pose, PositionData& position) {
+    const double theta = kTwoPi * phase.motionHz * (static_cast<double>(sourceUs) / 1000000.0) +
+                         0.7 * sender;
+    pose = TrackingPose(static_cast<float>(phase.yawAmplitude * std::sin(theta)),
+                        static_cast<float>(phase.pitchAmplitude * std::sin(1.7 * theta + 1.0)),
+                        static_cast<float>(phase.rollAmplitude * std::sin(0.6 * theta + 2.0)),
+                        sourceUs);
+    const double meters = phase.positionAmplitudeCm * 0.01;
+    position = PositionData(static_cast<float>(meters * std::sin(theta + 0.5)),
+                            static_cast<float>(meters * std::sin(1.3 * theta + 1.5)),
+                            static_cast<float>(meters * std::sin(0.9 * theta + 2.5)),
+                            sourceUs);
+}
+
+size_t LoadGenerator::EncodePacket(const TrackingPose& pose, const PositionData& position,
+                                   uint8_t* out) {
+    // OpenTrack sends centimeters; PositionData is meters
+    WriteDouble(out, OpenTrackPacket::kPosXOffset, position.x * 100.0);
+    WriteDouble(out, OpenTrackPacket::kPosYOffset, position.y * 100.0);
+    WriteDouble(out, OpenTrackPacket::kPosZOffset, position.z * 100.0);
+    WriteDouble(out, OpenTrackPacket::kYawOffset, pose.yaw);
+    WriteDouble(out, OpenTrackPacket::kPitchOffset, pose.pitch);
+    WriteDouble(out, OpenTrackPacket::kRollOffset, pose.roll);
+    return OpenTrackPacket::kMinPacketSize;
+}
+
+size_t LoadGenerator::EncodeExtendedPacket(const TrackingPose& pose, const PositionData& position,
+                                           uint64_t sequence, int64_t sourceUs, uint8_t* out) {
+    OpenTrackPacket::ExtendedHeader header;
+    header.sequence = static_cast<uint16_t>(sequence);
+    header.send_us = static_cast<uint32_t>(sourceUs);
+    OpenTrackPacket::EncodeExtended(out, header, position.x * 100.0f, position.y * 100.0f,
+                                    position.z * 100.0f, pose.yaw, pose.pitch, pose.roll);
+    return OpenTrackPacket::kExtendedPacketSize;
+}
+
+bool LoadSender::Open(const char* host, uint16_t port, int senders) {
+    Close();
+    m_target = {};
+    m_target.sin_family = AF_INET;
+    m_target.sin_port = htons(port);
+    if (host == nullptr || inet_pton(AF_INET, host, &m_target.sin_addr) != 1) {
+        return false;
+    }
+
+    m_senders = std::clamp(senders, 1, kMaxSenders);
+    for (int i = 0; i < m_senders; ++i) {
+        if (!m_sockets[i].Open(0)) {
+            Close();
+            return false;
+        }
+    }
+    return true;
+}
+
+void LoadSender::Close() {
+    for (int i = 0; i < m_senders; ++i) {
+        m_sockets[i].Close();
+    }
+    m_senders = 0;
+}
+
+bool LoadSender::Send(const GeneratedDatagram& datagram) {
+    if (m_senders == 0) {
+        return false;
+    }
+    const UdpSocket& socket = m_sockets[datagram.sender % m_senders];
+    const int sent = sendto(socket.GetHandle(), reinterpret_cast<const char*>(datagram.data),
+                            datagram.length, 0, reinterpret_cast<const sockaddr*>(&m_target),
+                            sizeof(m_target));
+    if (sent != static_cast<int>(datagram.length)) {
+        ++m_sendErrors;
+        return false;
+    }
+    return true;
+}
+
+}  // namespace cameraunlock
@@ -86,4 +86,43 @@ bool OpenTrackPacket::TryParseAll(const void* data, size_t length, TrackingPose&
     return true;
 }
 
+bool OpenTrackPacket::IsExtended(const void* data, size_t length) {
+    if (data == nullptr || length < kExtendedPacketSize || length >= kMinPacketSize) {
+        return false;
+    }
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    return bytes[0] == kExtendedMagic && bytes[1] == kExtendedVersion;
+}
+
+OpenTrackPacket::Format OpenTrackPacket::TryParseAny(const void* data, size_t length, TrackingPose& pose,
+                                                     PositionData& position, ExtendedHeader& header) {
+    if (!IsExtended(data, length)) {
+        return TryParseAll(data, length, pose, position) ? Format::OpenTrack : Format::Invalid;
+    }
+
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    float values[6];  // X, Y, Z (cm), Yaw, Pitch, Roll
+    std::memcpy(values, bytes + kExtendedPoseOffset, sizeof(values));
+    // Already float, so finite values can't overflow on the way to meters
+    for (float v : values) {
+        if (!std::isfinite(v)) return Format::Invalid;
+    }
+
+    std::memcpy(&header.sequence, bytes + kSequenceOffset, sizeof(header.sequence));
+    std::memcpy(&header.send_us, bytes + kSendTimeOffset, sizeof(header.send_us));
+    pose = TrackingPose(values[3], values[4], values[5]);
+    position = PositionData(values[0] * 0.01f, values[1] * 0.01f, values[2] * 0.01f);
+    return Format::Extended;
+}
+
+void OpenTrackPacket::EncodeExtended(uint8_t out[kExtendedPacketSize], const ExtendedHeader& header,
+                                     float x, float y, float z, float yaw, float pitch, float roll) {
+    const float values[6] = {x, y, z, yaw, pitch, roll};
+    out[0] = kExtendedMagic;
+    out[1] = kExtendedVersion;
+    std::memcpy(out + kSequenceOffset, &header.sequence, sizeof(header.sequence));
+    std::memcpy(out + kSendTimeOffset, &header.send_us, sizeof(header.send_us));
+    std::memcpy(out + kExtendedPoseOffset, values, sizeof(values));
+}
+
 }  // namespace cameraunlock
@@ -24,9 +24,14 @@ bool PollingUdpReceiver::Initialize(uint16_t port) {
     m_initialized = true;
     m_lastReceiveTimeMs = 0;
     m_packetsReceived = 0;
+    m_packetsMalformed = 0;
     m_bytesReceived = 0;
+    m_packetsDiscarded = 0;
+    m_lastPollDiscarded = 0;
+    m_packetsReordered = 0;
+    m_timeline.Reset();
     m_isRemoteConnection = false;
-    m_hasData = false;
+    m_sample.Reset();
     m_hasOffset = false;
     std::memset(m_receiveBuffer, 0, sizeof(m_receiveBuffer));
 
@@ -38,6 +43,7 @@ void PollingUdpReceiver::Shutdown() {
         return;
     }
 
+    m_capture.Close();
     m_socket.Close();
     m_initialized = false;
 }
@@ -47,75 +53,88 @@ bool PollingUdpReceiver::Poll() {
         return false;
     }
 
-    bool receivedAny = false;
-    int packetsThisFrame = 0;
-    constexpr int kMaxPacketsPerFrame = 1000;  // Safety limit
-
-    SOCKET sock = m_socket.GetHandle();
-
-    // Drain ALL pending packets, keeping only the latest
-    // This prevents lag from buffered packets when sender is faster than game fps
-    while (packetsThisFrame < kMaxPacketsPerFrame) {
-        sockaddr_in senderAddr;
-#ifdef _WIN32
-        int senderAddrLen = sizeof(senderAddr);
-#else
-        socklen_t senderAddrLen = sizeof(senderAddr);
-#endif
-
-        int bytesReceived = recvfrom(
-            sock,
+    // Drain ALL pending packets but publish the newest accepted one only.
+    // This prevents lag from buffered packets when sender is faster than game fps,
+    // and keeps a post-hitch backlog from costing one sample per stale packet.
+    // Every datagram goes through the timeline in arrival order, so a late
+    // or duplicate extended packet at the tail doesn't hide an older
+    // acceptable one.
+    sockaddr_in senderAddr = {};
+    int datagramsRead = 0;
+    uint64_t bytesRead = 0;
+    Selection selection;
+    selection.receiver = this;
+    if (m_capture.IsOpen()) {
+        ReceiveCapturing(senderAddr, datagramsRead, bytesRead, selection);
+    } else {
+        // Without per-datagram timestamps the whole batch arrives now
+        selection.arrivalUs = TrackingPose::CurrentTimestamp();
+        m_socket.ReceiveLatest(
             m_receiveBuffer,
             static_cast<int>(sizeof(m_receiveBuffer)),
-            0,
-            reinterpret_cast<sockaddr*>(&senderAddr),
-            &senderAddrLen
+            senderAddr,
+            kMaxPacketsPerFrame,
+            datagramsRead,
+            bytesRead,
+            &SelectFilter,
+            &selection
         );
+    }
 
-        if (bytesReceived == SOCKET_ERROR) {
-#ifdef _WIN32
-            int error = WSAGetLastError();
-            if (error == WSAEWOULDBLOCK) {
-                break;  // No more data available
-            }
-#else
-            if (errno == EWOULDBLOCK || errno == EAGAIN) {
-                break;  // No more data available
-            }
-#endif
-            break;  // Other error
-        }
+    const int wellFormed = datagramsRead - selection.malformed;
+    const int accepted = wellFormed - selection.reordered;
+    m_packetsReceived += static_cast<uint64_t>(wellFormed);
+    m_packetsMalformed += static_cast<uint64_t>(selection.malformed);
+    m_packetsReordered += static_cast<uint64_t>(selection.reordered);
+    m_bytesReceived += bytesRead;
+    m_lastPollDiscarded = accepted > 1 ? accepted - 1 : 0;
+    m_packetsDiscarded += static_cast<uint64_t>(m_lastPollDiscarded);
 
-        if (bytesReceived == 0) {
-            break;
-        }
+    if (!selection.found) {
+        return false;
+    }
 
-        packetsThisFrame++;
+    m_isRemoteConnection = IsRemoteAddress(senderAddr);
+    m_lastReceiveTimeMs = GetCurrentTimeMs();
+    m_sample.Publish(selection.sample);
 
-        if (ParsePacket(m_receiveBuffer, bytesReceived)) {
-            m_packetsReceived++;
-            m_bytesReceived += static_cast<uint64_t>(bytesReceived);
-            receivedAny = true;
+    return true;
+}
 
-            m_isRemoteConnection = IsRemoteAddress(senderAddr);
+void PollingUdpReceiver::ReceiveCapturing(sockaddr_in& senderAddr, int& datagramsRead, uint64_t& bytesRead,
+                                          Selection& selection) {
+    datagramsRead = 0;
+    bytesRead = 0;
+
+    // Every datagram is recorded, and judged at its own arrival time so the
+    // published sample matches what replaying the capture produces.
+    char scratch[kMaxBufferSize];
+    while (datagramsRead < kMaxPacketsPerFrame) {
+        int64_t arrivalUs = 0;
+        sockaddr_in addr = {};
+        int received = m_socket.ReceiveTimestamped(scratch, static_cast<int>(sizeof(scratch)), addr, arrivalUs);
+        if (received == SOCKET_ERROR || received == 0) {
+            break;
+        }
+        m_capture.Append(scratch, static_cast<size_t>(received), arrivalUs);
+        ++datagramsRead;
+        bytesRead += static_cast<uint64_t>(received);
+        selection.arrivalUs = arrivalUs;
+        if (Select(scratch, received, selection)) {
+            senderAddr = addr;
         }
     }
-
-    if (receivedAny) {
-        m_lastReceiveTimeMs = GetCurrentTimeMs();
-    }
-
-    return receivedAny;
 }
 
 bool PollingUdpReceiver::GetPose(TrackingPose& pose) const {
-    if (!m_hasData) {
+    TrackingSample sample;
+    if (!m_sample.TryGet(sample)) {
         return false;
     }
 
-    float yaw = m_yaw;
-    float pitch = m_pitch;
-    float roll = m_roll;
+    float yaw = sample.yaw;
+    float pitch = sample.pitch;
+    float roll = sample.roll;
 
     if (m_hasOffset) {
         yaw -= m_yawOffset;
@@ -128,24 +147,26 @@ bool PollingUdpReceiver::GetPose(TrackingPose& pose) const {
 }
 
 bool PollingUdpReceiver::GetRawRotation(float& yaw, float& pitch, float& roll) const {
-    if (!m_hasData) {
+    TrackingSample sample;
+    if (!m_sample.TryGet(sample)) {
         return false;
     }
 
-    yaw = m_yaw;
-    pitch = m_pitch;
-    roll = m_roll;
+    yaw = sample.yaw;
+    pitch = sample.pitch;
+    roll = sample.roll;
     return true;
 }
 
 bool PollingUdpReceiver::GetRotation(float& yaw, float& pitch, float& roll) const {
-    if (!m_hasData) {
+    TrackingSample sample;
+    if (!m_sample.TryGet(sample)) {
         return false;
     }
 
-    yaw = m_yaw;
-    pitch = m_pitch;
-    roll = m_roll;
+    yaw = sample.yaw;
+    pitch = sample.pitch;
+    roll = sample.roll;
 
     if (m_hasOffset) {
         yaw -= m_yawOffset;
@@ -157,10 +178,11 @@ bool PollingUdpReceiver::GetRotation(float& yaw, float& pitch, float& roll) cons
 }
 
 void PollingUdpReceiver::Recenter() {
-    if (m_hasData) {
-        m_yawOffset = m_yaw;
-        m_pitchOffset = m_pitch;
-        m_rollOffset = m_roll;
+    TrackingSample sample;
+    if (m_sample.TryGet(sample)) {
+        m_yawOffset = sample.yaw;
+        m_pitchOffset = sample.pitch;
+        m_rollOffset = sample.roll;
         m_hasOffset = true;
     }
 }
@@ -182,33 +204,49 @@ bool PollingUdpReceiver::IsConnected() const {
 }
 
 bool PollingUdpReceiver::GetPosition(float& x, float& y, float& z) const {
-    if (!m_hasPosition) {
+    TrackingSample sample;
+    if (!m_sample.TryGet(sample)) {
         return false;
     }
-    x = m_posX;
-    y = m_posY;
-    z = m_posZ;
+    x = sample.x;
+    y = sample.y;
+    z = sample.z;
     return true;
 }
 
-bool PollingUdpReceiver::ParsePacket(const char* buffer, int bytesReceived) {
+bool PollingUdpReceiver::SelectFilter(void* context, const char* data, int size) {
+    Selection& selection = *static_cast<Selection*>(context);
+    return selection.receiver->Select(data, size, selection);
+}
+
+bool PollingUdpReceiver::Select(const char* data, int size, Selection& selection) {
     // Use shared OpenTrack packet parsing (rotation + position)
     TrackingPose pose;
     PositionData position;
-    if (!OpenTrackPacket::TryParseAll(buffer, static_cast<size_t>(bytesReceived), pose, position)) {
+    OpenTrackPacket::ExtendedHeader header;
+    const OpenTrackPacket::Format format = OpenTrackPacket::TryParseAny(
+        data, static_cast<size_t>(size), pose, position, header);
+    if (format == OpenTrackPacket::Format::Invalid) {
+        ++selection.malformed;
         return false;
     }
 
-    m_yaw = pose.yaw;
-    m_pitch = pose.pitch;
-    m_roll = pose.roll;
-    m_hasData = true;
-
-    m_posX = position.x;
-    m_posY = position.y;
-    m_posZ = position.z;
-    m_hasPosition = true;
+    int64_t sourceUs = 0;
+    if (format == OpenTrackPacket::Format::Extended && !m_timeline.Accept(header, selection.arrivalUs, sourceUs)) {
+        ++selection.reordered;
+        return false;
+    }
 
+    TrackingSample& sample = selection.sample;
+    sample.yaw = pose.yaw;
+    sample.pitch = pose.pitch;
+    sample.roll = pose.roll;
+    sample.x = position.x;
+    sample.y = position.y;
+    sample.z = position.z;
+    sample.timestamp_us = selection.arrivalUs;
+    sample.source_us = sourceUs;
+    selection.found = true;
     return true;
 }
 
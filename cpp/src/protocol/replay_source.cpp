@@ -0,0 +1,272 @@
+#include "cameraunlock/protocol/replay_source.h"
+#include "cameraunlock/protocol/capture_file.h"
+#include "cameraunlock/protocol/opentrack_packet.h"
+#include "cameraunlock/data/position_data.h"
+
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace cameraunlock {
+
+ReplaySource::~ReplaySource() {
+    Close();
+}
+
+bool ReplaySource::Open(const std::string& path) {
+    Close();
+    m_failed = true;
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) ||
+        static_cast<uint64_t>(fileSize.QuadPart) < CaptureFormat::kHeaderSize) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        CloseHandle(file);
+        return false;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    m_file = file;
+    m_mapping = mapping;
+    m_data = static_cast<const uint8_t*>(view);
+    m_size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < CaptureFormat::kHeaderSize) {
+        close(fd);
+        return false;
+    }
+    void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  // The mapping keeps the file alive
+    if (view == MAP_FAILED) {
+        return false;
+    }
+    madvise(view, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+    m_data = static_cast<const uint8_t*>(view);
+    m_size = static_cast<size_t>(st.st_size);
+#endif
+
+    uint32_t version = 0;
+    std::memcpy(&version, m_data + 8, sizeof(version));
+    if (std::memcmp(m_data, CaptureFormat::kMagic, sizeof(CaptureFormat::kMagic)) != 0 ||
+        version != CaptureFormat::kVersion) {
+        Close();
+        m_failed = true;
+        return false;
+    }
+
+    m_failed = false;
+    Rewind();
+    return true;
+}
+
+void ReplaySource::Close() {
+#ifdef _WIN32
+    if (m_data != nullptr) {
+        UnmapViewOfFile(m_data);
+    }
+    if (m_mapping != nullptr) {
+        CloseHandle(static_cast<HANDLE>(m_mapping));
+    }
+    if (m_file != nullptr) {
+        CloseHandle(static_cast<HANDLE>(m_file));
+    }
+#else
+    if (m_data != nullptr) {
+        munmap(const_cast<uint8_t*>(m_data), m_size);
+    }
+#endif
+    m_data = nullptr;
+    m_size = 0;
+    m_offset = 0;
+    m_file = nullptr;
+    m_mapping = nullptr;
+    m_failed = false;
+    m_realtime = false;
+    m_sample.Reset();
+    m_yawOffset = m_pitchOffset = m_rollOffset = 0.0f;
+}
+
+void ReplaySource::Rewind() {
+    m_offset = m_data != nullptr ? CaptureFormat::kHeaderSize : 0;
+    m_parsed = 0;
+    m_malformed = 0;
+    m_reordered = 0;
+    m_timeline.Reset();
+}
+
+bool ReplaySource::PeekArrival(int64_t& arrivalUs) const {
+    if (m_data == nullptr || m_size - m_offset < CaptureFormat::kRecordHeaderSize) {
+        return false;
+    }
+    std::memcpy(&arrivalUs, m_data + m_offset, sizeof(arrivalUs));
+    return true;
+}
+
+bool ReplaySource::NextRaw(const uint8_t*& data, size_t& length, int64_t& arrivalUs) {
+    if (!PeekArrival(arrivalUs)) {
+        m_offset = m_size;
+        return false;
+    }
+
+    uint16_t length16 = 0;
+    std::memcpy(&length16, m_data + m_offset + 8, sizeof(length16));
+    size_t payload = m_offset + CaptureFormat::kRecordHeaderSize;
+    if (m_size - payload < length16) {
+        m_offset = m_size;  // Truncated tail (capture interrupted mid-write)
+        return false;
+    }
+
+    data = m_data + payload;
+    length = length16;
+    m_offset = payload + length16;
+    return true;
+}
+
+bool ReplaySource::ParseRecord(const uint8_t* data, size_t length, int64_t arrivalUs,
+                               TrackingSample& sample) {
+    TrackingPose pose;
+    PositionData position;
+    OpenTrackPacket::ExtendedHeader header;
+    const OpenTrackPacket::Format format = OpenTrackPacket::TryParseAny(data, length, pose, position, header);
+    if (format == OpenTrackPacket::Format::Invalid) {
+        ++m_malformed;
+        return false;
+    }
+    int64_t sourceUs = 0;
+    if (format == OpenTrackPacket::Format::Extended && !m_timeline.Accept(header, arrivalUs, sourceUs)) {
+        ++m_reordered;
+        return false;
+    }
+
+    sample.yaw = pose.yaw;
+    sample.pitch = pose.pitch;
+    sample.roll = pose.roll;
+    sample.x = position.x;
+    sample.y = position.y;
+    sample.z = position.z;
+    sample.timestamp_us = arrivalUs;
+    sample.source_us = sourceUs;
+    sample.sequence = ++m_parsed;
+    return true;
+}
+
+bool ReplaySource::Next(TrackingSample& sample) {
+    const uint8_t* data;
+    size_t length;
+    int64_t arrivalUs;
+    while (NextRaw(data, length, arrivalUs)) {
+        if (ParseRecord(data, length, arrivalUs, sample)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ReplaySource::BeginRealtime(int64_t nowUs) {
+    Rewind();
+    m_sample.Reset();
+
+    int64_t firstArrivalUs = 0;
+    m_rebaseUs = PeekArrival(firstArrivalUs) ? nowUs - firstArrivalUs : 0;
+    m_realtime = true;
+}
+
+bool ReplaySource::Update(int64_t nowUs) {
+    if (!m_realtime) {
+        return false;
+    }
+
+    bool published = false;
+    TrackingSample latest;
+    int64_t arrivalUs;
+    while (PeekArrival(arrivalUs) && arrivalUs + m_rebaseUs <= nowUs) {
+        const uint8_t* data;
+        size_t length;
+        if (!NextRaw(data, length, arrivalUs)) {
+            break;
+        }
+        if (ParseRecord(data, length, arrivalUs, latest)) {
+            published = true;
+        }
+    }
+
+    if (published) {
+        latest.timestamp_us += m_rebaseUs;
+        if (latest.source_us != 0) latest.source_us += m_rebaseUs;
+        m_sample.Publish(latest);
+    }
+    return published;
+}
+
+int64_t ReplaySource::GetLastReceiveTimestamp() const {
+    TrackingSample sample;
+    return m_sample.TryGet(sample) ? sample.timestamp_us : 0;
+}
+
+bool ReplaySource::IsReceiving() const {
+    int64_t lastUs = GetLastReceiveTimestamp();
+    if (lastUs == 0) return false;
+
+    int64_t elapsedMs = (TrackingPose::CurrentTimestamp() - lastUs) / 1000;
+    return elapsedMs < kConnectionTimeoutMs;
+}
+
+bool ReplaySource::GetRotation(float& yaw, float& pitch, float& roll) const {
+    TrackingSample sample;
+    if (!m_sample.TryGet(sample)) {
+        return false;
+    }
+    yaw = sample.yaw - m_yawOffset;
+    pitch = sample.pitch - m_pitchOffset;
+    roll = sample.roll - m_rollOffset;
+    return true;
+}
+
+bool ReplaySource::GetPosition(float& x, float& y, float& z) const {
+    TrackingSample sample;
+    if (!m_sample.TryGet(sample)) {
+        return false;
+    }
+    x = sample.x;
+    y = sample.y;
+    z = sample.z;
+    return true;
+}
+
+void ReplaySource::Recenter() {
+    TrackingSample sample;
+    if (m_sample.TryGet(sample)) {
+        m_yawOffset = sample.yaw;
+        m_pitchOffset = sample.pitch;
+        m_rollOffset = sample.roll;
+    }
+}
+
+}  // namespace cameraunlock
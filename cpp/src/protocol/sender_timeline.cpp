@@ -0,0 +1,58 @@
+#include "cameraunlock/protocol/sender_timeline.h"
+
+#include <algorithm>
+
+namespace cameraunlock {
+
+bool SenderTimeline::Accept(const OpenTrackPacket::ExtendedHeader& header, int64_t arrivalUs,
+                            int64_t& sourceUs) {
+    if (!m_hasSender || arrivalUs - m_lastArrivalUs > kRestartGapUs) {
+        Restart(header, arrivalUs);
+    } else {
+        // Serial-number arithmetic: both counters wrap
+        const int16_t ahead = static_cast<int16_t>(header.sequence - m_lastSequence);
+        const int32_t sendDeltaUs = static_cast<int32_t>(header.send_us - m_lastSendRaw);
+        // A late datagram is behind on both counters; a sequence reset with
+        // the send clock still advancing is a restarted sender
+        if (ahead <= -kReorderWindow || sendDeltaUs < -kRestartGapUs || (ahead <= 0 && sendDeltaUs > 0)) {
+            Restart(header, arrivalUs);
+        } else if (ahead <= 0) {
+            return false;
+        } else {
+            m_sendUs += sendDeltaUs;
+            m_lastSequence = header.sequence;
+            m_lastSendRaw = header.send_us;
+        }
+    }
+    m_lastArrivalUs = arrivalUs;
+
+    const int64_t offsetUs = arrivalUs - m_sendUs;
+    if (arrivalUs - m_windowStartUs >= kWindowUs) {
+        m_previousMinUs = m_windowMinUs;
+        m_hasPrevious = true;
+        m_windowStartUs = arrivalUs;
+        m_windowMinUs = offsetUs;
+    } else {
+        m_windowMinUs = std::min(m_windowMinUs, offsetUs);
+    }
+    m_offsetUs = m_hasPrevious ? std::min(m_windowMinUs, m_previousMinUs) : m_windowMinUs;
+    // The window minimum includes this packet, so this is never after arrivalUs
+    sourceUs = m_sendUs + m_offsetUs;
+    return true;
+}
+
+void SenderTimeline::Reset() {
+    *this = SenderTimeline();
+}
+
+void SenderTimeline::Restart(const OpenTrackPacket::ExtendedHeader& header, int64_t arrivalUs) {
+    Reset();
+    m_hasSender = true;
+    m_lastSequence = header.sequence;
+    m_lastSendRaw = header.send_us;
+    m_sendUs = header.send_us;
+    m_windowStartUs = arrivalUs;
+    m_windowMinUs = arrivalUs - m_sendUs;
+}
+
+}  // namespace cameraunlock
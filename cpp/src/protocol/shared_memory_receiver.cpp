@@ -0,0 +1,221 @@
+#include "cameraunlock/protocol/shared_memory_receiver.h"
+
+#include <cmath>
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#endif
+
+namespace cameraunlock {
+
+namespace {
+
+// FreeTrack 2.0 heap as published by OpenTrack (freetrackclient/fttypes.h).
+// Rotation in radians, translation in millimeters.
+struct FTData {
+    uint32_t DataID;
+    int32_t CamWidth;
+    int32_t CamHeight;
+    float Yaw;      // Positive to the left
+    float Pitch;    // Positive up
+    float Roll;     // Positive to the left
+    float X;
+    float Y;
+    float Z;
+    float RawYaw;
+    float RawPitch;
+    float RawRoll;
+    float RawX;
+    float RawY;
+    float RawZ;
+    float X1, Y1, X2, Y2, X3, Y3, X4, Y4;
+};
+
+struct FTHeap {
+    FTData data;
+    int32_t GameID;
+    unsigned char table[8];
+    int32_t GameID2;
+};
+
+static_assert(sizeof(FTData) == 92, "FTData layout must match FreeTrack");
+static_assert(sizeof(FTHeap) == 108, "FTHeap layout must match FreeTrack");
+
+constexpr float kRadToDeg = 57.29577951308232f;
+constexpr float kMmToMeters = 0.001f;
+
+}  // namespace
+
+SharedMemoryReceiver::~SharedMemoryReceiver() {
+    Stop();
+}
+
+bool SharedMemoryReceiver::Start() {
+    if (m_view != nullptr) {
+        return true;
+    }
+
+#ifdef _WIN32
+    // Create-or-open: whichever of game and OpenTrack starts first makes the
+    // mapping, and the other attaches to it.
+    HANDLE mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                                        0, sizeof(FTHeap), kMappingName);
+    if (mapping == nullptr) {
+        m_failed = true;
+        return false;
+    }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, sizeof(FTHeap));
+    if (view == nullptr) {
+        CloseHandle(mapping);
+        m_failed = true;
+        return false;
+    }
+
+    HANDLE mutex = CreateMutexA(nullptr, FALSE, kMutexName);
+    if (mutex == nullptr) {
+        UnmapViewOfFile(view);
+        CloseHandle(mapping);
+        m_failed = true;
+        return false;
+    }
+
+    m_mapping = mapping;
+    m_mutex = mutex;
+    m_view = view;
+    m_failed = false;
+    m_lastDataId = static_cast<const FTHeap*>(view)->data.DataID;
+    return true;
+#else
+    m_failed = true;
+    return false;
+#endif
+}
+
+void SharedMemoryReceiver::Stop() {
+#ifdef _WIN32
+    if (m_view != nullptr) {
+        UnmapViewOfFile(m_view);
+    }
+    if (m_mapping != nullptr) {
+        CloseHandle(static_cast<HANDLE>(m_mapping));
+    }
+    if (m_mutex != nullptr) {
+        CloseHandle(static_cast<HANDLE>(m_mutex));
+    }
+#endif
+    m_view = nullptr;
+    m_mapping = nullptr;
+    m_mutex = nullptr;
+    m_failed = false;
+
+    m_lastDataId = 0;
+    m_snapshot.Reset();
+    std::lock_guard<std::mutex> lock(m_centerMutex);
+    m_center.Reset();
+}
+
+bool SharedMemoryReceiver::Poll() {
+    if (m_view == nullptr) {
+        return false;
+    }
+    const FTHeap* heap = static_cast<const FTHeap*>(m_view);
+    const bool haveSnapshot = m_snapshot.GetSequence() != 0;
+
+    // OpenTrack bumps DataID after writing each pose, so an unchanged one
+    // means the snapshot is still current. A changed one can't tell a torn
+    // copy from a whole one (the next write may already be under way);
+    // only the writer's mutex can.
+    const uint32_t dataId = *reinterpret_cast<const volatile uint32_t*>(&heap->data.DataID);
+    if (dataId == m_lastDataId) {
+        return haveSnapshot;  // Nothing new, or OpenTrack has not written yet
+    }
+
+    FTData data;
+#ifdef _WIN32
+    HANDLE mutex = static_cast<HANDLE>(m_mutex);
+    DWORD wait = WaitForSingleObject(mutex, 0);
+    if (wait != WAIT_OBJECT_0 && wait != WAIT_ABANDONED) {
+        return haveSnapshot;  // Writer busy; keep last frame's pose
+    }
+    std::memcpy(&data, &heap->data, sizeof(data));
+    ReleaseMutex(mutex);
+#else
+    std::memcpy(&data, &heap->data, sizeof(data));
+#endif
+
+    if (!std::isfinite(data.Yaw) || !std::isfinite(data.Pitch) || !std::isfinite(data.Roll) ||
+        !std::isfinite(data.X) || !std::isfinite(data.Y) || !std::isfinite(data.Z)) {
+        return haveSnapshot;
+    }
+    m_lastDataId = data.DataID;
+
+    // Undo OpenTrack's FreeTrack conversion (yaw/pitch negated, degrees to
+    // radians, centimeters to millimeters).
+    TrackingSample sample;
+    sample.yaw = -data.Yaw * kRadToDeg;
+    sample.pitch = -data.Pitch * kRadToDeg;
+    sample.roll = data.Roll * kRadToDeg;
+    sample.x = data.X * kMmToMeters;
+    sample.y = data.Y * kMmToMeters;
+    sample.z = data.Z * kMmToMeters;
+    sample.timestamp_us = TrackingPose::CurrentTimestamp();
+    m_snapshot.Publish(sample);
+    return true;
+}
+
+bool SharedMemoryReceiver::TryGetSample(TrackingSample& sample) const {
+    return m_snapshot.TryGet(sample);
+}
+
+int64_t SharedMemoryReceiver::GetLastReceiveTimestamp() const {
+    TrackingSample sample;
+    return m_snapshot.TryGet(sample) ? sample.timestamp_us : 0;
+}
+
+bool SharedMemoryReceiver::IsReceiving() const {
+    int64_t lastUs = GetLastReceiveTimestamp();
+    if (lastUs == 0) return false;
+
+    int64_t elapsedMs = (TrackingPose::CurrentTimestamp() - lastUs) / 1000;
+    return elapsedMs < kConnectionTimeoutMs;
+}
+
+bool SharedMemoryReceiver::GetRotation(float& yaw, float& pitch, float& roll) const {
+    TrackingSample sample;
+    if (!m_snapshot.TryGet(sample)) {
+        return false;
+    }
+
+    TrackingSample center;
+    if (!m_center.TryGet(center)) {
+        center = TrackingSample{};
+    }
+    yaw = sample.yaw - center.yaw;
+    pitch = sample.pitch - center.pitch;
+    roll = sample.roll - center.roll;
+    return true;
+}
+
+bool SharedMemoryReceiver::GetPosition(float& x, float& y, float& z) const {
+    TrackingSample sample;
+    if (!m_snapshot.TryGet(sample)) {
+        return false;
+    }
+    x = sample.x;
+    y = sample.y;
+    z = sample.z;
+    return true;
+}
+
+void SharedMemoryReceiver::Recenter() {
+    TrackingSample sample;
+    if (m_snapshot.TryGet(sample)) {
+        std::lock_guard<std::mutex> lock(m_centerMutex);
+        m_center.Publish(sample);
+    }
+}
+
+}  // namespace cameraunlock
@@ -0,0 +1,278 @@
+#include "cameraunlock/protocol/shared_udp_receiver.h"
+
+#include <chrono>
+#include <new>
+#include <string>
+#include <thread>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <unordered_map>
+#endif
+
+namespace cameraunlock {
+
+// Lives in shared memory on Windows: only lock-free atomics and PODs, and
+// a version check so DLLs built from different library versions refuse to
+// share a hub rather than misread it.
+struct SharedUdpReceiver::Hub {
+    static constexpr uint32_t kMagic = 0x42485543;  // "CUHB"
+    static constexpr uint32_t kVersion = 1;
+
+    std::atomic<uint32_t> ready{0};
+    uint32_t magic = kMagic;
+    uint32_t version = kVersion;
+    uint32_t size = sizeof(Hub);
+
+    std::atomic<uint32_t> refCount{0};
+    std::atomic<uint32_t> owner{0};     // Token of the consumer holding the socket, 0 = none
+    std::atomic<uint32_t> nextToken{0};
+    std::atomic<uint32_t> bindFailed{0};
+    std::atomic<uint32_t> remote{0};
+
+    SharedTrackingSample sample;
+
+    bool IsCompatible() const {
+        return magic == kMagic && version == kVersion && size == sizeof(Hub);
+    }
+};
+
+namespace {
+
+constexpr int kHubReadyTimeoutMs = 1000;
+
+#ifndef _WIN32
+std::mutex g_localHubsMutex;
+std::unordered_map<uint16_t, std::unique_ptr<SharedUdpReceiver::Hub>> g_localHubs;
+#endif
+
+}  // namespace
+
+SharedUdpReceiver::~SharedUdpReceiver() {
+    Stop();
+}
+
+bool SharedUdpReceiver::Start(uint16_t port) {
+    if (m_hub != nullptr) {
+        return true;
+    }
+    m_port = port;
+
+#ifdef _WIN32
+    std::string name = "Local\\CameraUnlockReceiverHub." +
+                       std::to_string(GetCurrentProcessId()) + "." + std::to_string(port);
+    HANDLE mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                                        0, sizeof(Hub), name.c_str());
+    if (mapping == nullptr) {
+        m_failed = true;
+        return false;
+    }
+    bool created = GetLastError() != ERROR_ALREADY_EXISTS;
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(Hub));
+    if (view == nullptr) {
+        CloseHandle(mapping);
+        m_failed = true;
+        return false;
+    }
+
+    Hub* hub;
+    if (created) {
+        hub = new (view) Hub();
+        hub->ready.store(1, std::memory_order_release);
+    } else {
+        hub = static_cast<Hub*>(view);
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(kHubReadyTimeoutMs);
+        while (hub->ready.load(std::memory_order_acquire) == 0 &&
+               std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::yield();
+        }
+        if (hub->ready.load(std::memory_order_acquire) == 0 || !hub->IsCompatible()) {
+            if (m_log) {
+                m_log("Receiver hub for port " + std::to_string(port) +
+                      " is from an incompatible library version");
+            }
+            UnmapViewOfFile(view);
+            CloseHandle(mapping);
+            m_failed = true;
+            return false;
+        }
+    }
+    m_mapping = mapping;
+#else
+    Hub* hub;
+    {
+        std::lock_guard<std::mutex> lock(g_localHubsMutex);
+        auto& slot = g_localHubs[port];
+        if (!slot) {
+            slot.reset(new Hub());
+            slot->ready.store(1, std::memory_order_release);
+        }
+        hub = slot.get();
+    }
+#endif
+
+    m_hub = hub;
+    m_failed = false;
+    m_token = hub->nextToken.fetch_add(1, std::memory_order_relaxed) + 1;
+    hub->refCount.fetch_add(1, std::memory_order_acq_rel);
+
+    AdoptIfOrphaned();
+    return true;
+}
+
+void SharedUdpReceiver::Stop() {
+    if (m_hub == nullptr) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_ownerMutex);
+        if (m_receiver) {
+            // Socket is closed before ownership is released, so the adopter
+            // can bind immediately and there is never a second writer.
+            m_receiver->Stop();
+            m_receiver.reset();
+            uint32_t token = m_token;
+            m_hub->owner.compare_exchange_strong(token, 0, std::memory_order_acq_rel);
+        }
+    }
+
+    if (m_hub->refCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        m_hub->sample.Reset();
+        m_hub->bindFailed.store(0, std::memory_order_relaxed);
+        m_hub->remote.store(0, std::memory_order_relaxed);
+    }
+
+#ifdef _WIN32
+    UnmapViewOfFile(m_hub);
+    CloseHandle(static_cast<HANDLE>(m_mapping));
+    m_mapping = nullptr;
+#endif
+    m_hub = nullptr;
+    m_token = 0;
+    m_failed = false;
+
+    std::lock_guard<std::mutex> lock(m_centerMutex);
+    m_center.Reset();
+}
+
+bool SharedUdpReceiver::IsOwner() const {
+    return m_hub != nullptr && m_hub->owner.load(std::memory_order_acquire) == m_token;
+}
+
+bool SharedUdpReceiver::AdoptIfOrphaned() {
+    if (m_hub == nullptr) {
+        return false;
+    }
+    if (m_hub->owner.load(std::memory_order_acquire) != 0) {
+        return IsOwner();
+    }
+
+    std::lock_guard<std::mutex> lock(m_ownerMutex);
+    if (m_receiver) {
+        return IsOwner();
+    }
+
+    uint32_t expected = 0;
+    if (m_hub->owner.compare_exchange_strong(expected, m_token, std::memory_order_acq_rel)) {
+        BecomeOwner();
+        return true;
+    }
+    return false;
+}
+
+void SharedUdpReceiver::BecomeOwner() {
+    Hub* hub = m_hub;
+    m_receiver.reset(new UdpReceiver());
+    UdpReceiver* receiver = m_receiver.get();
+
+    if (m_log) {
+        receiver->SetLog(m_log);
+    }
+    receiver->SetSampleCallback([hub, receiver](const TrackingSample& sample) {
+        hub->remote.store(receiver->IsRemoteConnection() ? 1u : 0u, std::memory_order_relaxed);
+        hub->bindFailed.store(0, std::memory_order_relaxed);
+        // Centering is per consumer, so the hub carries the raw pose only
+        TrackingSample raw = sample;
+        raw.center_yaw = raw.center_pitch = raw.center_roll = 0.0f;
+        hub->sample.Publish(raw);
+    });
+
+    // A failed bind keeps retrying inside UdpReceiver while we stay owner.
+    bool started = receiver->Start(m_port);
+    hub->bindFailed.store(started ? 0u : 1u, std::memory_order_relaxed);
+}
+
+bool SharedUdpReceiver::TryGetSample(TrackingSample& sample) const {
+    if (m_hub == nullptr || !m_hub->sample.TryGet(sample)) {
+        return false;
+    }
+
+    TrackingSample center;
+    if (m_center.TryGet(center)) {
+        sample.center_yaw = center.yaw;
+        sample.center_pitch = center.pitch;
+        sample.center_roll = center.roll;
+    }
+    return true;
+}
+
+int64_t SharedUdpReceiver::GetLastReceiveTimestamp() const {
+    TrackingSample sample;
+    return TryGetSample(sample) ? sample.timestamp_us : 0;
+}
+
+bool SharedUdpReceiver::IsReceiving() const {
+    int64_t lastUs = GetLastReceiveTimestamp();
+    if (lastUs == 0) return false;
+
+    int64_t elapsedMs = (TrackingPose::CurrentTimestamp() - lastUs) / 1000;
+    return elapsedMs < UdpReceiver::kConnectionTimeoutMs;
+}
+
+bool SharedUdpReceiver::IsRemoteConnection() const {
+    return m_hub != nullptr && m_hub->remote.load(std::memory_order_relaxed) != 0;
+}
+
+bool SharedUdpReceiver::IsFailed() const {
+    if (m_hub == nullptr) {
+        return m_failed;
+    }
+    return m_hub->bindFailed.load(std::memory_order_relaxed) != 0;
+}
+
+bool SharedUdpReceiver::GetRotation(float& yaw, float& pitch, float& roll) const {
+    TrackingSample sample;
+    if (!TryGetSample(sample)) {
+        return false;
+    }
+
+    yaw = sample.yaw - sample.center_yaw;
+    pitch = sample.pitch - sample.center_pitch;
+    roll = sample.roll - sample.center_roll;
+    return true;
+}
+
+bool SharedUdpReceiver::GetPosition(float& x, float& y, float& z) const {
+    TrackingSample sample;
+    if (!TryGetSample(sample)) {
+        return false;
+    }
+    x = sample.x;
+    y = sample.y;
+    z = sample.z;
+    return true;
+}
+
+void SharedUdpReceiver::Recenter() {
+    TrackingSample sample;
+    if (m_hub != nullptr && m_hub->sample.TryGet(sample)) {
+        std::lock_guard<std::mutex> lock(m_centerMutex);
+        m_center.Publish(sample);
+    }
+}
+
+}  // namespace cameraunlock
@@ -0,0 +1,167 @@
+#include "cameraunlock/protocol/socket_waiter.h"
+
+#ifndef _WIN32
+#include <poll.h>
+#endif
+
+namespace cameraunlock {
+
+SocketWaiter::~SocketWaiter() {
+    Close();
+}
+
+#ifdef _WIN32
+
+bool SocketWaiter::Open(SOCKET sock) {
+    if (IsOpen()) {
+        return true;
+    }
+    if (sock == INVALID_SOCKET) {
+        return false;
+    }
+
+    m_socketEvent = WSACreateEvent();
+    m_stopEvent = WSACreateEvent();
+    if (m_socketEvent == WSA_INVALID_EVENT || m_stopEvent == WSA_INVALID_EVENT) {
+        Close();
+        return false;
+    }
+
+    // FD_READ is re-armed by each recvfrom while data remains queued.
+    if (WSAEventSelect(sock, m_socketEvent, FD_READ) == SOCKET_ERROR) {
+        Close();
+        return false;
+    }
+
+    m_socket = sock;
+    return true;
+}
+
+void SocketWaiter::Close() {
+    if (m_socket != INVALID_SOCKET) {
+        // Detach from the event; the socket stays non-blocking.
+        WSAEventSelect(m_socket, nullptr, 0);
+        m_socket = INVALID_SOCKET;
+    }
+    if (m_socketEvent != WSA_INVALID_EVENT) {
+        WSACloseEvent(m_socketEvent);
+        m_socketEvent = WSA_INVALID_EVENT;
+    }
+    if (m_stopEvent != WSA_INVALID_EVENT) {
+        WSACloseEvent(m_stopEvent);
+        m_stopEvent = WSA_INVALID_EVENT;
+    }
+}
+
+SocketWaiter::WaitResult SocketWaiter::Wait(int timeoutMs) {
+    if (!IsOpen()) {
+        return WaitResult::Error;
+    }
+
+    // Stop event first so a signal wins over pending data.
+    WSAEVENT events[2] = {m_stopEvent, m_socketEvent};
+    DWORD timeout = timeoutMs < 0 ? WSA_INFINITE : static_cast<DWORD>(timeoutMs);
+    DWORD result = WSAWaitForMultipleEvents(2, events, FALSE, timeout, FALSE);
+
+    if (result == WSA_WAIT_EVENT_0) {
+        return WaitResult::Signaled;
+    }
+    if (result == WSA_WAIT_EVENT_0 + 1) {
+        WSANETWORKEVENTS networkEvents;
+        // Resets m_socketEvent.
+        WSAEnumNetworkEvents(m_socket, m_socketEvent, &networkEvents);
+        return WaitResult::Readable;
+    }
+    if (result == WSA_WAIT_TIMEOUT) {
+        return WaitResult::Timeout;
+    }
+    return WaitResult::Error;
+}
+
+void SocketWaiter::Signal() {
+    if (m_stopEvent != WSA_INVALID_EVENT) {
+        WSASetEvent(m_stopEvent);
+    }
+}
+
+#else
+
+bool SocketWaiter::Open(SOCKET sock) {
+    if (IsOpen()) {
+        return true;
+    }
+    if (sock == INVALID_SOCKET) {
+        return false;
+    }
+
+    if (pipe(m_pipe) != 0) {
+        m_pipe[0] = m_pipe[1] = -1;
+        return false;
+    }
+    for (int fd : m_pipe) {
+        int flags = fcntl(fd, F_GETFL, 0);
+        if (flags == -1 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) == -1 ||
+            fcntl(fd, F_SETFD, FD_CLOEXEC) == -1) {
+            Close();
+            return false;
+        }
+    }
+
+    m_socket = sock;
+    return true;
+}
+
+void SocketWaiter::Close() {
+    m_socket = INVALID_SOCKET;
+    for (int& fd : m_pipe) {
+        if (fd != -1) {
+            close(fd);
+            fd = -1;
+        }
+    }
+}
+
+SocketWaiter::WaitResult SocketWaiter::Wait(int timeoutMs) {
+    if (!IsOpen()) {
+        return WaitResult::Error;
+    }
+
+    pollfd fds[2] = {};
+    fds[0].fd = m_pipe[0];
+    fds[0].events = POLLIN;
+    fds[1].fd = m_socket;
+    fds[1].events = POLLIN;
+
+    int result;
+    do {
+        result = poll(fds, 2, timeoutMs);
+    } while (result < 0 && errno == EINTR);
+
+    if (result < 0) {
+        return WaitResult::Error;
+    }
+    if (result == 0) {
+        return WaitResult::Timeout;
+    }
+    // The pipe byte is never drained, which keeps the signal sticky.
+    if (fds[0].revents & POLLIN) {
+        return WaitResult::Signaled;
+    }
+    if (fds[1].revents & (POLLIN | POLLERR)) {
+        return WaitResult::Readable;
+    }
+    return WaitResult::Error;
+}
+
+void SocketWaiter::Signal() {
+    if (m_pipe[1] != -1) {
+        const char byte = 1;
+        // A full pipe already means "signaled", so the result is irrelevant.
+        ssize_t written = write(m_pipe[1], &byte, 1);
+        (void)written;
+    }
+}
+
+#endif
+
+}  // namespace cameraunlock
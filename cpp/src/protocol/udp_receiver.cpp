@@ -1,6 +1,7 @@
 #include "cameraunlock/protocol/udp_receiver.h"
 #include "cameraunlock/protocol/opentrack_packet.h"
 #include "cameraunlock/data/position_data.h"
+#include "cameraunlock/runtime/runtime.h"
 #include <chrono>
 #include <string>
 
@@ -8,13 +9,21 @@ namespace cameraunlock {
 
 namespace {
 constexpr int kRetrySleepIncrementMs = 100;
+constexpr int kFallbackPollIntervalMs = 1;
 }
 
 UdpReceiver::~UdpReceiver() {
     Stop();
+    // Queued lines point at this receiver's callback
+    AsyncLog::Flush();
 }
 
-bool UdpReceiver::Start(uint16_t port) {
+void UdpReceiver::WriteLog(void* context, int, const char* message) {
+    auto* self = static_cast<UdpReceiver*>(context);
+    if (self->m_log) self->m_log(message);
+}
+
+bool UdpReceiver::Start(uint16_t port, const ThreadSchedulingOptions& scheduling) {
     if (m_running.load(std::memory_order_acquire)) {
         return true;
     }
@@ -24,13 +33,13 @@ bool UdpReceiver::Start(uint16_t port) {
 
     m_failed.store(false, std::memory_order_release);
     m_port = port;
+    m_scheduling = scheduling;
+    m_mmcssTask = scheduling.mmcssTask ? scheduling.mmcssTask : "";
+    m_scheduling.mmcssTask = scheduling.mmcssTask ? m_mmcssTask.c_str() : nullptr;
 
     if (!m_socket.Open(port)) {
         m_failed.store(true, std::memory_order_release);
-        if (m_log) {
-            m_log("Failed to bind UDP port " + std::to_string(port) +
-                  " -- will retry every " + std::to_string(kRetryIntervalMs / 1000) + "s");
-        }
+        Log("Failed to bind UDP port %u -- will retry every %ds", port, kRetryIntervalMs / 1000);
         StartRetryLoop();
         return false;
     }
@@ -39,6 +48,69 @@ bool UdpReceiver::Start(uint16_t port) {
     return true;
 }
 
+bool UdpReceiver::Start(Runtime& runtime, uint16_t port) {
+    if (m_running.load(std::memory_order_acquire)) {
+        return true;
+    }
+    if (m_retrying.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    m_failed.store(false, std::memory_order_release);
+    m_port = port;
+    m_runtime = &runtime;
+
+    if (!m_socket.Open(port)) {
+        m_failed.store(true, std::memory_order_release);
+        Log("Failed to bind UDP port %u -- will retry every %ds", port, kRetryIntervalMs / 1000);
+        m_retrying.store(true, std::memory_order_release);
+        m_retryAttempts = 0;
+        runtime.Call([this]() { ScheduleRuntimeRetry(); });
+        return false;
+    }
+
+    runtime.Call([this]() { BindOnRuntime(); });
+    return true;
+}
+
+void UdpReceiver::BindOnRuntime() {
+    PrepareReceive();
+    m_schedulingResult.Set(m_runtime->GetSchedulingResult());
+    m_stopFlag.store(false, std::memory_order_release);
+    m_running.store(true, std::memory_order_release);
+    m_runtimeSource = m_runtime->AddSocket(m_socket.GetHandle(), [this]() { DrainSocket(); });
+    if (m_runtimeSource == 0) {
+        Log("Runtime has no free wait slots -- UDP socket not registered");
+    }
+}
+
+void UdpReceiver::ScheduleRuntimeRetry() {
+    // One-shot timers re-armed per attempt, so the id is only written on
+    // the runtime thread
+    m_retryTimer = m_runtime->AddTimer(kRetryIntervalMs, 0, [this]() { RetryOnRuntime(); });
+}
+
+void UdpReceiver::RetryOnRuntime() {
+    m_retryTimer = 0;
+    if (!m_retrying.load(std::memory_order_acquire)) return;
+
+    const int attemptsPerLog = kRetryLogIntervalMs / kRetryIntervalMs;
+    m_retryAttempts++;
+
+    if (m_socket.Open(m_port)) {
+        m_failed.store(false, std::memory_order_release);
+        m_retrying.store(false, std::memory_order_release);
+        BindOnRuntime();
+        Log("Bound UDP port %u after %d retries", m_port, m_retryAttempts);
+        return;
+    }
+
+    if (m_retryAttempts % attemptsPerLog == 0) {
+        Log("Still waiting for UDP port %u (%ds elapsed)", m_port, m_retryAttempts * kRetryIntervalMs / 1000);
+    }
+    ScheduleRuntimeRetry();
+}
+
 void UdpReceiver::StartRetryLoop() {
     m_retrying.store(true, std::memory_order_release);
     m_retryThread = std::thread(&UdpReceiver::RetryThread, this);
@@ -73,58 +145,125 @@ void UdpReceiver::RetryThread() {
             // m_running and tear it down through the normal path.
             StartReceiverThread();
 
-            if (m_log) {
-                m_log("Bound UDP port " + std::to_string(m_port) +
-                      " after " + std::to_string(attempts) + " retries");
-            }
+            Log("Bound UDP port %u after %d retries", m_port, attempts);
             return;
         }
 
-        if (attempts % attemptsPerLog == 0 && m_log) {
-            int elapsedSec = attempts * kRetryIntervalMs / 1000;
-            m_log("Still waiting for UDP port " + std::to_string(m_port) +
-                  " (" + std::to_string(elapsedSec) + "s elapsed)");
+        if (attempts % attemptsPerLog == 0) {
+            Log("Still waiting for UDP port %u (%ds elapsed)", m_port, attempts * kRetryIntervalMs / 1000);
+        }
+    }
+}
+
+void UdpReceiver::PrepareReceive() {
+    if (m_wantKernelTimestamps) {
+        bool enabled = m_socket.EnableReceiveTimestamps();
+        m_kernelTimestamps.store(enabled, std::memory_order_release);
+        if (!enabled) {
+            Log("Kernel receive timestamps unavailable -- using receive-thread time");
+        }
+    }
+
+    m_stats.Reset();
+    m_timeline.Reset();
+    m_lastReadSequence.store(0, std::memory_order_relaxed);
+
+    if (!m_capturePath.empty()) {
+        bool opened = m_capture.Open(m_capturePath);
+        m_capturing.store(opened, std::memory_order_release);
+        if (!opened) {
+            Log("Failed to open capture file %s", m_capturePath);
         }
     }
 }
 
 void UdpReceiver::StartReceiverThread() {
+    PrepareReceive();
+
+    if (!m_waiter.Open(m_socket.GetHandle())) {
+        Log("Failed to create UDP wait objects -- falling back to 1 ms polling");
+    }
+
     m_stopFlag.store(false, std::memory_order_release);
     m_running.store(true, std::memory_order_release);
-    m_thread = std::thread(&UdpReceiver::ReceiverThread, this);
+    m_thread = StartScheduledThread(m_scheduling, m_schedulingResult, [this]() { ReceiverThread(); });
+}
+
+ThreadSchedulingResult UdpReceiver::GetSchedulingResult() const {
+    return m_schedulingResult.Get();
 }
 
 void UdpReceiver::Stop() {
     m_retrying.store(false, std::memory_order_release);
+    if (m_runtime) {
+        // Unregister from the runtime thread so a retry or drain callback
+        // can't be mid-flight while the registrations are torn down
+        Runtime* runtime = m_runtime;
+        runtime->Call([this, runtime]() {
+            runtime->Remove(m_retryTimer);
+            runtime->Remove(m_runtimeSource);
+            m_retryTimer = 0;
+            m_runtimeSource = 0;
+        });
+        m_runtime = nullptr;
+        m_running.store(false, std::memory_order_release);
+    }
     if (m_retryThread.joinable()) {
         m_retryThread.join();
     }
 
     if (m_running.load(std::memory_order_acquire)) {
         m_stopFlag.store(true, std::memory_order_release);
+        m_waiter.Signal();
         if (m_thread.joinable()) {
             m_thread.join();
         }
         m_running.store(false, std::memory_order_release);
     }
 
+    m_capture.Close();
+    m_capturing.store(false, std::memory_order_release);
+    m_waiter.Close();
     m_socket.Close();
+    m_kernelTimestamps.store(false, std::memory_order_release);
 
     m_failed.store(false, std::memory_order_release);
-    m_trackingData.Reset();
-    m_yawOffset.store(0.0f, std::memory_order_relaxed);
-    m_pitchOffset.store(0.0f, std::memory_order_relaxed);
-    m_rollOffset.store(0.0f, std::memory_order_relaxed);
-    m_posX.store(0.0f, std::memory_order_relaxed);
-    m_posY.store(0.0f, std::memory_order_relaxed);
-    m_posZ.store(0.0f, std::memory_order_relaxed);
-    m_hasPosition.store(false, std::memory_order_relaxed);
-    m_lastReceiveTimestamp.store(0, std::memory_order_relaxed);
+    m_sample.Reset();
+    m_history.Reset();
+    m_historyCursor = 0;
+    // No receive thread is left to consume, so this thread can drain
+    m_centerCommands.Clear();
+    m_centerYaw = 0.0f;
+    m_centerPitch = 0.0f;
+    m_centerRoll = 0.0f;
     m_isRemoteConnection.store(false, std::memory_order_relaxed);
 }
 
+void UdpReceiver::NoteRead(uint64_t sequence) const {
+    // Skip the store when nothing changed so repeated reads of one sample
+    // don't keep pulling the line away from the receive thread.
+    uint64_t last = m_lastReadSequence.load(std::memory_order_relaxed);
+    while (sequence > last &&
+           !m_lastReadSequence.compare_exchange_weak(last, sequence, std::memory_order_relaxed)) {
+    }
+}
+
+bool UdpReceiver::ReadSample(TrackingSample& sample) const {
+    if (!m_sample.TryGet(sample)) {
+        return false;
+    }
+    NoteRead(sample.sequence);
+    return true;
+}
+
+int64_t UdpReceiver::GetLastReceiveTimestamp() const {
+    // Peeking at the timestamp doesn't consume the sample.
+    TrackingSample sample;
+    return m_sample.TryGet(sample) ? sample.timestamp_us : 0;
+}
+
 bool UdpReceiver::IsReceiving() const {
-    int64_t lastTs = m_lastReceiveTimestamp.load(std::memory_order_acquire);
+    int64_t lastTs = GetLastReceiveTimestamp();
     if (lastTs == 0) return false;
 
     auto now = std::chrono::steady_clock::now();
@@ -136,97 +275,177 @@ bool UdpReceiver::IsReceiving() const {
 }
 
 bool UdpReceiver::GetRotation(float& yaw, float& pitch, float& roll) const {
-    float rawYaw, rawPitch, rawRoll;
-    if (!m_trackingData.Get(rawYaw, rawPitch, rawRoll)) {
+    TrackingSample sample;
+    if (!ReadSample(sample)) {
         return false;
     }
 
-    yaw = rawYaw - m_yawOffset.load(std::memory_order_relaxed);
-    pitch = rawPitch - m_pitchOffset.load(std::memory_order_relaxed);
-    roll = rawRoll - m_rollOffset.load(std::memory_order_relaxed);
+    yaw = sample.yaw - sample.center_yaw;
+    pitch = sample.pitch - sample.center_pitch;
+    roll = sample.roll - sample.center_roll;
 
     return true;
 }
 
 bool UdpReceiver::GetPosition(float& x, float& y, float& z) const {
-    if (!m_hasPosition.load(std::memory_order_relaxed)) {
+    TrackingSample sample;
+    if (!ReadSample(sample)) {
         return false;
     }
-    x = m_posX.load(std::memory_order_relaxed);
-    y = m_posY.load(std::memory_order_relaxed);
-    z = m_posZ.load(std::memory_order_relaxed);
+    x = sample.x;
+    y = sample.y;
+    z = sample.z;
     return true;
 }
 
+size_t UdpReceiver::ReadNewSamples(TrackingSample* out, size_t maxCount) {
+    size_t count = m_history.ReadSince(m_historyCursor, out, maxCount);
+    if (count > 0) {
+        NoteRead(out[count - 1].sequence);
+    }
+    return count;
+}
+
 void UdpReceiver::Recenter() {
-    float yaw, pitch, roll;
-    if (m_trackingData.Get(yaw, pitch, roll)) {
-        m_yawOffset.store(yaw, std::memory_order_relaxed);
-        m_pitchOffset.store(pitch, std::memory_order_relaxed);
-        m_rollOffset.store(roll, std::memory_order_relaxed);
+    CenterCommand command;
+    command.kind = CenterCommand::Kind::Recenter;
+    PushCenterCommand(command);
+}
+
+bool UdpReceiver::ResetCenter() {
+    return PushCenterCommand(CenterCommand{});
+}
+
+bool UdpReceiver::SetCenter(float yaw, float pitch, float roll) {
+    CenterCommand command;
+    command.kind = CenterCommand::Kind::Set;
+    command.yaw = yaw;
+    command.pitch = pitch;
+    command.roll = roll;
+    return PushCenterCommand(command);
+}
+
+bool UdpReceiver::PushCenterCommand(const CenterCommand& command) {
+    if (m_centerCommands.TryPush(command)) {
+        return true;
+    }
+    Log("Center command dropped: %d already pending", static_cast<int>(kCommandCapacity));
+    return false;
+}
+
+void UdpReceiver::ApplyCenterCommands(TrackingSample& sample) {
+    // Receive thread: every command queued before this packet takes effect
+    // on it, in order
+    CenterCommand command;
+    while (m_centerCommands.TryPop(command)) {
+        switch (command.kind) {
+            case CenterCommand::Kind::Recenter:
+                m_centerYaw = sample.yaw;
+                m_centerPitch = sample.pitch;
+                m_centerRoll = sample.roll;
+                break;
+            case CenterCommand::Kind::Reset:
+                m_centerYaw = m_centerPitch = m_centerRoll = 0.0f;
+                break;
+            case CenterCommand::Kind::Set:
+                m_centerYaw = command.yaw;
+                m_centerPitch = command.pitch;
+                m_centerRoll = command.roll;
+                break;
+        }
     }
+    sample.center_yaw = m_centerYaw;
+    sample.center_pitch = m_centerPitch;
+    sample.center_roll = m_centerRoll;
 }
 
 void UdpReceiver::ReceiverThread() {
+    while (!m_stopFlag.load(std::memory_order_relaxed)) {
+        if (m_waiter.IsOpen()) {
+            SocketWaiter::WaitResult wait = m_waiter.Wait();
+            if (wait == SocketWaiter::WaitResult::Signaled ||
+                wait == SocketWaiter::WaitResult::Error) {
+                break;
+            }
+            if (wait == SocketWaiter::WaitResult::Timeout) continue;
+        } else {
+            // No wait objects (creation failed): fall back to a 1 ms poll.
+            std::this_thread::sleep_for(std::chrono::milliseconds(kFallbackPollIntervalMs));
+        }
+
+        // Drain everything queued; the waiter only fires on the transition.
+        DrainSocket();
+    }
+}
+
+void UdpReceiver::DrainSocket() {
     constexpr size_t kReceiveBufferSize = 64;
     alignas(16) char buffer[kReceiveBufferSize];
     sockaddr_in senderAddr = {};
-    int senderAddrSize = sizeof(senderAddr);
-
-    SOCKET sock = m_socket.GetHandle();
-
-#ifdef _WIN32
-    WSAPOLLFD pollFd = {};
-    pollFd.fd = sock;
-    pollFd.events = POLLIN;
-#endif
 
     while (!m_stopFlag.load(std::memory_order_relaxed)) {
-#ifdef _WIN32
-        int pollResult = WSAPoll(&pollFd, 1, 1);
-        if (pollResult < 0) break;
-        if (pollResult == 0) continue;
-
-        int bytesReceived = recvfrom(
-            sock,
-            buffer,
-            sizeof(buffer),
-            0,
-            reinterpret_cast<sockaddr*>(&senderAddr),
-            &senderAddrSize
-        );
-#else
-        socklen_t addrLen = sizeof(senderAddr);
-        int bytesReceived = recvfrom(
-            sock,
+        int64_t arrivalUs = 0;
+        int bytesReceived = m_socket.ReceiveTimestamped(
             buffer,
-            sizeof(buffer),
-            0,
-            reinterpret_cast<sockaddr*>(&senderAddr),
-            &addrLen
+            static_cast<int>(sizeof(buffer)),
+            senderAddr,
+            arrivalUs
         );
-#endif
-
-        if (bytesReceived >= static_cast<int>(OpenTrackPacket::kMinPacketSize)) {
-            TrackingPose pose;
-            PositionData position;
-            if (OpenTrackPacket::TryParseAll(buffer, bytesReceived, pose, position)) {
-                m_trackingData.Set(pose.yaw, pose.pitch, pose.roll);
-
-                // Store position data
-                m_posX.store(position.x, std::memory_order_relaxed);
-                m_posY.store(position.y, std::memory_order_relaxed);
-                m_posZ.store(position.z, std::memory_order_relaxed);
-                m_hasPosition.store(true, std::memory_order_relaxed);
-
-                m_isRemoteConnection.store(IsRemoteAddress(senderAddr), std::memory_order_relaxed);
-
-                // Update timestamp
-                auto now = std::chrono::steady_clock::now();
-                int64_t nowUs = std::chrono::duration_cast<std::chrono::microseconds>(
-                    now.time_since_epoch()).count();
-                m_lastReceiveTimestamp.store(nowUs, std::memory_order_release);
-            }
+        if (bytesReceived == SOCKET_ERROR) {
+            // WOULDBLOCK means drained; anything else is retried on the
+            // next wakeup (e.g. ICMP port-unreachable on Windows).
+            break;
+        }
+
+        if (m_capture.IsOpen()) {
+            m_capture.Append(buffer, static_cast<size_t>(bytesReceived), arrivalUs);
+        }
+
+        TrackingPose pose;
+        PositionData position;
+        OpenTrackPacket::ExtendedHeader header;
+        const OpenTrackPacket::Format format = OpenTrackPacket::TryParseAny(
+            buffer, static_cast<size_t>(bytesReceived), pose, position, header);
+        if (format == OpenTrackPacket::Format::Invalid) {
+            m_stats.RecordMalformed();
+            continue;
+        }
+        int64_t sourceUs = 0;
+        if (format == OpenTrackPacket::Format::Extended && !m_timeline.Accept(header, arrivalUs, sourceUs)) {
+            m_stats.RecordReordered();
+            continue;
+        }
+
+        m_isRemoteConnection.store(IsRemoteAddress(senderAddr), std::memory_order_relaxed);
+
+        TrackingSample sample;
+        sample.yaw = pose.yaw;
+        sample.pitch = pose.pitch;
+        sample.roll = pose.roll;
+        sample.x = position.x;
+        sample.y = position.y;
+        sample.z = position.z;
+        sample.timestamp_us = arrivalUs;
+        sample.source_us = sourceUs;
+        ApplyCenterCommands(sample);
+
+        uint64_t previous = m_sample.GetSequence();
+        if (previous != 0 && m_lastReadSequence.load(std::memory_order_relaxed) < previous) {
+            m_stats.RecordSuperseded();
+        }
+        m_stats.RecordPacket(arrivalUs);
+        // Open the trace record first so a reader can't process the sample
+        // before it exists; Publish numbers samples consecutively
+        if (PipelineTrace* trace = m_trace.load(std::memory_order_acquire)) {
+            trace->BeginSample(previous + 1, arrivalUs, TrackingPose::CurrentTimestamp());
+        }
+        m_sample.Publish(sample);
+
+        sample.sequence = m_sample.GetSequence();
+        m_history.Push(sample);
+
+        if (m_sampleCallback) {
+            m_sampleCallback(sample);
         }
     }
 }
@@ -1,12 +1,35 @@
 #include "cameraunlock/protocol/udp_socket.h"
+#include <chrono>
 #include <cstring>
 
 #ifdef _WIN32
+#include <mswsock.h>
+#include <mstcpip.h>
 #pragma comment(lib, "ws2_32.lib")
+#else
+#include <sys/uio.h>
+#include <time.h>
 #endif
 
 namespace cameraunlock {
 
+namespace {
+
+int64_t SteadyNowUs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Kernel timestamps come from a different clock (QPC on Windows, realtime
+// on POSIX). Map them onto steady_clock by their age relative to "now";
+// a negative age (clock skew) is treated as "just arrived".
+int64_t SteadyFromAge(int64_t ageUs) {
+    int64_t now = SteadyNowUs();
+    return ageUs > 0 ? now - ageUs : now;
+}
+
+}  // namespace
+
 UdpSocket::~UdpSocket() {
     Close();
 }
@@ -76,7 +99,260 @@ bool UdpSocket::Open(uint16_t port) {
     return true;
 }
 
+int UdpSocket::ReceiveLatest(char* buffer, int size, sockaddr_in& sender, int maxDatagrams,
+                             int& datagramsRead, uint64_t& bytesRead, DatagramFilter accept,
+                             void* context, int* datagramsRejected) {
+    datagramsRead = 0;
+    bytesRead = 0;
+    int rejected = 0;
+    if (datagramsRejected) *datagramsRejected = 0;
+    if (m_socket == INVALID_SOCKET || buffer == nullptr || size <= 0) {
+        return 0;
+    }
+
+    int latestSize = 0;
+
+#ifdef __linux__
+    const int slotSize = size < kMaxBatchDatagramSize ? size : kMaxBatchDatagramSize;
+    alignas(16) char slots[kReceiveBatchSize][kMaxBatchDatagramSize];
+    sockaddr_in addrs[kReceiveBatchSize];
+    iovec iovs[kReceiveBatchSize];
+    mmsghdr msgs[kReceiveBatchSize];
+
+    while (datagramsRead < maxDatagrams) {
+        int batch = maxDatagrams - datagramsRead;
+        if (batch > kReceiveBatchSize) batch = kReceiveBatchSize;
+
+        std::memset(msgs, 0, sizeof(mmsghdr) * static_cast<size_t>(batch));
+        for (int i = 0; i < batch; ++i) {
+            iovs[i].iov_base = slots[i];
+            iovs[i].iov_len = static_cast<size_t>(slotSize);
+            msgs[i].msg_hdr.msg_iov = &iovs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+            msgs[i].msg_hdr.msg_name = &addrs[i];
+            msgs[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+        }
+
+        int count = recvmmsg(m_socket, msgs, static_cast<unsigned int>(batch), MSG_DONTWAIT, nullptr);
+        if (count <= 0) {
+            break;  // EAGAIN (drained) or error
+        }
+
+        int newest = -1;
+        for (int i = 0; i < count; ++i) {
+            bytesRead += msgs[i].msg_len;
+            if (!accept || accept(context, slots[i], static_cast<int>(msgs[i].msg_len))) {
+                newest = i;
+            } else {
+                ++rejected;
+            }
+        }
+        datagramsRead += count;
+
+        if (newest >= 0) {
+            latestSize = static_cast<int>(msgs[newest].msg_len);
+            std::memcpy(buffer, slots[newest], static_cast<size_t>(latestSize));
+            sender = addrs[newest];
+        }
+
+        if (count < batch) {
+            break;  // Queue drained
+        }
+    }
+#else
+    // With a filter, read into scratch so a rejected datagram can't
+    // overwrite the last kept one
+    alignas(16) char scratch[kMaxBatchDatagramSize];
+    char* target = accept ? scratch : buffer;
+    const int targetSize = accept ? (size < kMaxBatchDatagramSize ? size : kMaxBatchDatagramSize) : size;
+    while (datagramsRead < maxDatagrams) {
+        sockaddr_in addr;
+#ifdef _WIN32
+        int addrLen = sizeof(addr);
+#else
+        socklen_t addrLen = sizeof(addr);
+#endif
+        int received = recvfrom(m_socket, target, targetSize, 0,
+                                reinterpret_cast<sockaddr*>(&addr), &addrLen);
+#ifdef _WIN32
+        if (received == SOCKET_ERROR && WSAGetLastError() == WSAEMSGSIZE) {
+            received = targetSize;  // Oversized datagram, truncated into buffer
+        }
+#endif
+        if (received == SOCKET_ERROR || received == 0) {
+            break;  // WOULDBLOCK (drained) or error
+        }
+
+        ++datagramsRead;
+        bytesRead += static_cast<uint64_t>(received);
+        if (accept) {
+            if (!accept(context, scratch, received)) {
+                ++rejected;
+                continue;
+            }
+            std::memcpy(buffer, scratch, static_cast<size_t>(received));
+        }
+        latestSize = received;
+        sender = addr;
+    }
+#endif
+
+    if (datagramsRejected) *datagramsRejected = rejected;
+    return latestSize;
+}
+
+bool UdpSocket::EnableReceiveTimestamps() {
+    if (m_socket == INVALID_SOCKET) {
+        return false;
+    }
+    if (m_timestamps) {
+        return true;
+    }
+
+#ifdef _WIN32
+#ifdef SIO_TIMESTAMPING
+    TIMESTAMPING_CONFIG config = {};
+    config.Flags = TIMESTAMPING_FLAG_RX;
+    DWORD bytes = 0;
+    if (WSAIoctl(m_socket, SIO_TIMESTAMPING, &config, sizeof(config),
+                 nullptr, 0, &bytes, nullptr, nullptr) == SOCKET_ERROR) {
+        return false;  // Pre-1903 Windows or unsupported stack
+    }
+
+    GUID recvMsgGuid = WSAID_WSARECVMSG;
+    LPFN_WSARECVMSG recvMsg = nullptr;
+    if (WSAIoctl(m_socket, SIO_GET_EXTENSION_FUNCTION_POINTER,
+                 &recvMsgGuid, sizeof(recvMsgGuid), &recvMsg, sizeof(recvMsg),
+                 &bytes, nullptr, nullptr) == SOCKET_ERROR || recvMsg == nullptr) {
+        return false;
+    }
+
+    m_recvMsg = reinterpret_cast<void*>(recvMsg);
+    m_timestamps = true;
+    return true;
+#else
+    return false;  // SDK predates SIO_TIMESTAMPING
+#endif
+#else
+    int enable = 1;
+#ifdef SO_TIMESTAMPNS
+    if (setsockopt(m_socket, SOL_SOCKET, SO_TIMESTAMPNS, &enable, sizeof(enable)) != 0) {
+        return false;
+    }
+#else
+    if (setsockopt(m_socket, SOL_SOCKET, SO_TIMESTAMP, &enable, sizeof(enable)) != 0) {
+        return false;
+    }
+#endif
+    m_timestamps = true;
+    return true;
+#endif
+}
+
+int UdpSocket::ReceiveTimestamped(char* buffer, int size, sockaddr_in& sender, int64_t& arrivalUs) {
+    arrivalUs = 0;
+
+    if (!m_timestamps) {
+#ifdef _WIN32
+        int addrLen = sizeof(sender);
+#else
+        socklen_t addrLen = sizeof(sender);
+#endif
+        int received = recvfrom(m_socket, buffer, size, 0,
+                                reinterpret_cast<sockaddr*>(&sender), &addrLen);
+        if (received != SOCKET_ERROR) {
+            arrivalUs = SteadyNowUs();
+        }
+        return received;
+    }
+
+#ifdef _WIN32
+    WSABUF data;
+    data.buf = buffer;
+    data.len = static_cast<ULONG>(size);
+    char control[WSA_CMSG_SPACE(sizeof(UINT64))] = {};
+
+    WSAMSG msg = {};
+    msg.name = reinterpret_cast<LPSOCKADDR>(&sender);
+    msg.namelen = sizeof(sender);
+    msg.lpBuffers = &data;
+    msg.dwBufferCount = 1;
+    msg.Control.buf = control;
+    msg.Control.len = sizeof(control);
+
+    DWORD received = 0;
+    auto recvMsg = reinterpret_cast<LPFN_WSARECVMSG>(m_recvMsg);
+    if (recvMsg(m_socket, &msg, &received, nullptr, nullptr) == SOCKET_ERROR) {
+        return SOCKET_ERROR;
+    }
+
+    for (WSACMSGHDR* cmsg = WSA_CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = WSA_CMSG_NXTHDR(&msg, cmsg)) {
+        if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SO_TIMESTAMP) {
+            UINT64 packetQpc;
+            std::memcpy(&packetQpc, WSA_CMSG_DATA(cmsg), sizeof(packetQpc));
+            LARGE_INTEGER nowQpc, frequency;
+            QueryPerformanceCounter(&nowQpc);
+            QueryPerformanceFrequency(&frequency);
+            int64_t ageTicks = nowQpc.QuadPart - static_cast<int64_t>(packetQpc);
+            arrivalUs = SteadyFromAge(ageTicks * 1000000 / frequency.QuadPart);
+        }
+    }
+#else
+    iovec data;
+    data.iov_base = buffer;
+    data.iov_len = static_cast<size_t>(size);
+#ifdef SO_TIMESTAMPNS
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(timespec))];
+#else
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(timeval))];
+#endif
+
+    msghdr msg = {};
+    msg.msg_name = &sender;
+    msg.msg_namelen = sizeof(sender);
+    msg.msg_iov = &data;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    ssize_t received = recvmsg(m_socket, &msg, 0);
+    if (received < 0) {
+        return SOCKET_ERROR;
+    }
+
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if (cmsg->cmsg_level != SOL_SOCKET) continue;
+
+        int64_t packetUs = 0;
+#ifdef SO_TIMESTAMPNS
+        if (cmsg->cmsg_type != SCM_TIMESTAMPNS) continue;
+        timespec ts;
+        std::memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+        packetUs = static_cast<int64_t>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+#else
+        if (cmsg->cmsg_type != SCM_TIMESTAMP) continue;
+        timeval tv;
+        std::memcpy(&tv, CMSG_DATA(cmsg), sizeof(tv));
+        packetUs = static_cast<int64_t>(tv.tv_sec) * 1000000 + tv.tv_usec;
+#endif
+        timespec now;
+        clock_gettime(CLOCK_REALTIME, &now);
+        int64_t nowUs = static_cast<int64_t>(now.tv_sec) * 1000000 + now.tv_nsec / 1000;
+        arrivalUs = SteadyFromAge(nowUs - packetUs);
+    }
+#endif
+
+    if (arrivalUs == 0) {
+        arrivalUs = SteadyNowUs();  // No timestamp attached to this datagram
+    }
+    return static_cast<int>(received);
+}
+
 void UdpSocket::Close() {
+    m_timestamps = false;
+#ifdef _WIN32
+    m_recvMsg = nullptr;
+#endif
     if (m_socket != INVALID_SOCKET) {
 #ifdef _WIN32
         closesocket(m_socket);
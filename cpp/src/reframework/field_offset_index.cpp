@@ -0,0 +1,178 @@
+#include <cameraunlock/reframework/field_offset_index.h>
+#include <cameraunlock/reframework/game_state_probing.h>
+#include <cameraunlock/reframework/log_callback.h>
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <unordered_map>
+#include <utility>
+
+namespace cameraunlock::reframework {
+
+namespace {
+
+constexpr const char* kFileHeader = "# cameraunlock field offset cache v1";
+
+// Parent chain walked when the field is inherited
+constexpr int kMaxTypeDepth = 16;
+
+uint64_t HashPath(const std::string& path) {
+    // FNV-1a 64, as in the signature cache
+    uint64_t hash = 14695981039346656037ull;
+    for (char c : path) {
+        hash = (hash ^ static_cast<uint8_t>(c)) * 1099511628211ull;
+    }
+    return hash;
+}
+
+}  // namespace
+
+int FieldOffsetIndex::Add(const char* path) {
+    m_entries.push_back({path ? path : "", kUnresolved});
+    return static_cast<int>(m_entries.size()) - 1;
+}
+
+FieldOffsetIndex::TdbIdentity FieldOffsetIndex::GetIdentity(::reframework::API::TDB* tdb) {
+    TdbIdentity id;
+    id.types = tdb->get_num_types();
+    id.methods = tdb->get_num_methods();
+    id.fields = tdb->get_num_fields();
+    id.strings = tdb->get_strings_size();
+    return id;
+}
+
+uint32_t FieldOffsetIndex::ResolveThroughTdb(::reframework::API::TDB* tdb, const std::string& path) {
+    const size_t dot = path.rfind('.');
+    if (dot == std::string::npos || dot == 0 || dot + 1 == path.size()) return kUnresolved;
+    const std::string typeName = path.substr(0, dot);
+    const char* fieldName = path.c_str() + dot + 1;
+
+    auto type = FindType(tdb, typeName.c_str());
+    for (int depth = 0; type && depth < kMaxTypeDepth; ++depth) {
+        if (auto field = type->find_field(fieldName)) {
+            if (field->is_static()) return kUnresolved;
+            return field->get_offset_from_base();
+        }
+        type = type->get_parent_type();
+    }
+    return kUnresolved;
+}
+
+size_t FieldOffsetIndex::Resolve(::reframework::API::TDB* tdb, const char* cachePath) {
+    m_cachePath = cachePath ? cachePath : "";
+    m_cacheHits = 0;
+    m_tdbResolves = 0;
+    if (!tdb) return 0;
+
+    const TdbIdentity identity = GetIdentity(tdb);
+    std::vector<uint32_t> cached;
+    const bool loaded = !m_cachePath.empty() && Load(identity, cached);
+
+    size_t resolved = 0;
+    bool changed = !loaded;
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+        Entry& entry = m_entries[i];
+        if (loaded && cached[i] != kUnresolved) {
+            entry.offset = cached[i];
+            ++m_cacheHits;
+        } else {
+            entry.offset = ResolveThroughTdb(tdb, entry.path);
+            ++m_tdbResolves;
+            changed |= entry.offset != kUnresolved;
+            if (entry.offset == kUnresolved) {
+                Log(LogLevel::Warning, "FieldOffsetIndex: %s not found", entry.path.c_str());
+            }
+        }
+        if (entry.offset != kUnresolved) ++resolved;
+    }
+
+    if (changed && !m_cachePath.empty() && !Save(identity)) {
+        Log(LogLevel::Warning, "FieldOffsetIndex: could not write %s", m_cachePath.c_str());
+    }
+    Log(LogLevel::Info, "FieldOffsetIndex: %zu/%zu fields (%zu cached, %zu from TDB)", resolved,
+        m_entries.size(), m_cacheHits, m_tdbResolves);
+    return resolved;
+}
+
+size_t FieldOffsetIndex::Validate(::reframework::API::TDB* tdb) {
+    if (!tdb) return 0;
+    size_t mismatches = 0;
+    for (Entry& entry : m_entries) {
+        const uint32_t live = ResolveThroughTdb(tdb, entry.path);
+        if (live == entry.offset) continue;
+        Log(LogLevel::Warning, "FieldOffsetIndex: %s offset 0x%X, TDB says 0x%X", entry.path.c_str(),
+            entry.offset, live);
+        entry.offset = live;
+        ++mismatches;
+    }
+    if (mismatches > 0 && !m_cachePath.empty()) Save(GetIdentity(tdb));
+    return mismatches;
+}
+
+bool FieldOffsetIndex::Load(const TdbIdentity& identity, std::vector<uint32_t>& offsets) const {
+    FILE* file = fopen(m_cachePath.c_str(), "r");
+    if (!file) return false;
+
+    std::unordered_map<uint64_t, uint32_t> entries;
+    bool identityMatched = false;
+    char line[128];
+    while (fgets(line, sizeof(line), file)) {
+        if (line[0] == '#' || line[0] == '\n') continue;
+
+        if (std::strncmp(line, "tdb ", 4) == 0) {
+            TdbIdentity id;
+            if (std::sscanf(line + 4, "%" SCNx32 " %" SCNx32 " %" SCNx32 " %" SCNx32, &id.types, &id.methods,
+                            &id.fields, &id.strings) != 4) {
+                break;
+            }
+            identityMatched = id == identity;
+            if (!identityMatched) break;
+            continue;
+        }
+
+        // Entries before a matching tdb line are ignored
+        if (!identityMatched) break;
+
+        uint64_t hash = 0;
+        uint32_t offset = 0;
+        if (std::sscanf(line, "%" SCNx64 " %" SCNx32, &hash, &offset) == 2) {
+            entries[hash] = offset;
+        }
+    }
+    fclose(file);
+    if (!identityMatched) return false;
+
+    offsets.assign(m_entries.size(), kUnresolved);
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+        auto it = entries.find(HashPath(m_entries[i].path));
+        if (it != entries.end()) offsets[i] = it->second;
+    }
+    return true;
+}
+
+bool FieldOffsetIndex::Save(const TdbIdentity& identity) const {
+    FILE* file = fopen(m_cachePath.c_str(), "w");
+    if (!file) return false;
+
+    // Sorted so rewrites of the same content are byte-identical
+    std::vector<std::pair<uint64_t, uint32_t>> sorted;
+    for (const Entry& entry : m_entries) {
+        if (entry.offset != kUnresolved) sorted.emplace_back(HashPath(entry.path), entry.offset);
+    }
+    std::sort(sorted.begin(), sorted.end());
+
+    fprintf(file, "%s\n", kFileHeader);
+    fprintf(file, "tdb %08" PRIx32 " %08" PRIx32 " %08" PRIx32 " %08" PRIx32 "\n", identity.types,
+            identity.methods, identity.fields, identity.strings);
+    for (const auto& entry : sorted) {
+        fprintf(file, "%016" PRIx64 " %08" PRIx32 "\n", entry.first, entry.second);
+    }
+
+    const bool ok = fflush(file) == 0;
+    fclose(file);
+    return ok;
+}
+
+} // namespace cameraunlock::reframework
@@ -5,7 +5,12 @@
 #include <windows.h>
 #include <cstring>
 #include <cstdio>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace cameraunlock::reframework {
 
@@ -17,38 +22,141 @@ static const char* s_defaultCandidates[] = {
 static const char* const* s_candidates = s_defaultCandidates;
 static int s_candidateCount = sizeof(s_defaultCandidates) / sizeof(s_defaultCandidates[0]);
 
+namespace {
+
+using TypeDefinition = ::reframework::API::TypeDefinition;
+using Method = ::reframework::API::Method;
+
+struct MethodKey {
+    TypeDefinition* type;
+    std::string_view name;
+    bool operator==(const MethodKey& o) const { return type == o.type && name == o.name; }
+};
+
+struct MethodKeyHash {
+    size_t operator()(const MethodKey& k) const {
+        return std::hash<const void*>()(k.type) ^ (std::hash<std::string_view>()(k.name) * 31);
+    }
+};
+
+// Resolution cache behind FindType/FindMethod/FindSingleton. The TDB never
+// changes while the game runs, so type and method lookups are kept, misses
+// included, until the namespace candidates change. For singletons only the
+// winning full name is kept, and only on a hit (a manager created later is
+// still found); instances are never cached, because the game recreates
+// managers and a stale pointer would dangle. Keys and returned
+// names point into `interned`, which is never cleared, so names handed out
+// stay valid for the life of the process.
+struct ResolutionCache {
+    std::shared_mutex mutex;
+    std::unordered_set<std::string> interned;
+    std::unordered_map<std::string_view, TypeDefinition*> types;          // base name -> type
+    std::unordered_map<MethodKey, Method*, MethodKeyHash> methods;
+    std::unordered_map<std::string_view, const char*> singletonNames;     // base name -> full name
+};
+
+ResolutionCache& Cache() {
+    static ResolutionCache cache;
+    return cache;
+}
+
+// Caller holds the exclusive lock
+const char* Intern(ResolutionCache& cache, std::string_view s) {
+    return cache.interned.emplace(s).first->c_str();
+}
+
+// Returns the interned full name
+const char* CacheSingletonName(ResolutionCache& cache, const char* baseName, const char* fullName) {
+    std::unique_lock lock(cache.mutex);
+    const char* name = Intern(cache, fullName);
+    cache.singletonNames[Intern(cache, baseName)] = name;
+    return name;
+}
+
+}  // namespace
+
 void SetNamespaceCandidates(const char* const* candidates, int count) {
+    auto& cache = Cache();
+    std::unique_lock lock(cache.mutex);
     s_candidates = candidates;
     s_candidateCount = count;
+    cache.types.clear();
+    cache.singletonNames.clear();
+}
+
+void InvalidateResolutionCache() {
+    auto& cache = Cache();
+    std::unique_lock lock(cache.mutex);
+    cache.singletonNames.clear();
 }
 
 ::reframework::API::TypeDefinition* FindType(
     ::reframework::API::TDB* tdb, const char* baseName) {
+    auto& cache = Cache();
+    {
+        std::shared_lock lock(cache.mutex);
+        auto it = cache.types.find(baseName);
+        if (it != cache.types.end()) return it->second;
+    }
+
     // Try without prefix first (e.g., "via.Application")
     auto type = tdb->find_type(baseName);
-    if (type) return type;
-
-    for (int i = 0; i < s_candidateCount; i++) {
+    for (int i = 0; !type && i < s_candidateCount; i++) {
         std::string fullName = std::string(s_candidates[i]) + "." + baseName;
         type = tdb->find_type(fullName.c_str());
-        if (type) return type;
     }
-    return nullptr;
+
+    std::unique_lock lock(cache.mutex);
+    cache.types[Intern(cache, baseName)] = type;
+    return type;
 }
 
 const char* FindSingleton(const ::reframework::API* api, const char* baseName) {
-    static char buf[256];
+    auto& cache = Cache();
+    {
+        std::shared_lock lock(cache.mutex);
+        auto it = cache.singletonNames.find(baseName);
+        if (it != cache.singletonNames.end()) return it->second;
+    }
+
+    char buf[256];
     for (int i = 0; i < s_candidateCount; i++) {
         snprintf(buf, sizeof(buf), "%s.%s", s_candidates[i], baseName);
-        if (api->get_managed_singleton(buf)) return buf;
+        if (api->get_managed_singleton(buf)) {
+            return CacheSingletonName(cache, baseName, buf);
+        }
     }
     return nullptr;
 }
 
+void* FindSingletonInstance(const ::reframework::API* api, const char* baseName) {
+    const char* name = FindSingleton(api, baseName);
+    return name ? GetSingletonInstance(api, name) : nullptr;
+}
+
+void* GetSingletonInstance(const ::reframework::API* api, const char* fullName) {
+    return api->get_managed_singleton(fullName);
+}
+
 ::reframework::API::Method* FindMethod(
     ::reframework::API::TypeDefinition* type, const char* names[], int count) {
+    auto& cache = Cache();
     for (int i = 0; i < count; i++) {
-        auto m = type->find_method(names[i]);
+        Method* m = nullptr;
+        bool known = false;
+        {
+            std::shared_lock lock(cache.mutex);
+            auto it = cache.methods.find(MethodKey{type, names[i]});
+            if (it != cache.methods.end()) {
+                m = it->second;
+                known = true;
+            }
+        }
+        if (!known) {
+            m = type->find_method(names[i]);
+            std::unique_lock lock(cache.mutex);
+            cache.methods[MethodKey{type, Intern(cache, names[i])}] = m;
+        }
         if (m) return m;
     }
     return nullptr;
@@ -72,14 +180,9 @@ bool ProbeManager(
     auto singleton = FindSingleton(api, typeName);
     if (!singleton) return false;
 
-    // Store a persistent copy of the singleton name
-    static char singletonBufs[16][256];
-    static int singletonBufIdx = 0;
-    strncpy(singletonBufs[singletonBufIdx], singleton, 255);
-    singletonBufs[singletonBufIdx][255] = '\0';
+    // Interned: stays valid even after the cache is invalidated
     out.method = method;
-    out.singletonName = singletonBufs[singletonBufIdx];
-    singletonBufIdx = (singletonBufIdx + 1) % 16;
+    out.singletonName = singleton;
 
     Log(LogLevel::Info, "Probe OK: %s -> %s (singleton: %s)", label, methodNames[0], out.singletonName);
     return true;
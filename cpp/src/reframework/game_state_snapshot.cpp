@@ -0,0 +1,105 @@
+#include <cameraunlock/reframework/game_state_snapshot.h>
+#include <cameraunlock/reframework/log_callback.h>
+
+#include <chrono>
+
+namespace cameraunlock::reframework {
+
+namespace {
+
+int64_t SteadyNowUs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+}  // namespace
+
+GameStateSnapshot& GameStateSnapshot::Instance() {
+    static GameStateSnapshot instance;
+    return instance;
+}
+
+int GameStateSnapshot::AddProbe(const MethodCheck& check, GameStateProbeKind kind, const char* label,
+                                uint32_t intervalMs) {
+    std::lock_guard lock(m_mutex);
+    const size_t index = m_count.load(std::memory_order_relaxed);
+    if (index >= kMaxProbes) {
+        Log(LogLevel::Warning, "GameStateSnapshot: probe table full, '%s' not added", label ? label : "?");
+        return -1;
+    }
+    Probe& probe = m_probes[index];
+    probe.check = check;
+    probe.kind = kind;
+    probe.label = label ? label : "probe";
+    probe.intervalUs = static_cast<int64_t>(intervalMs) * 1000;
+    probe.lastRunUs = 0;
+    probe.due = true;
+    probe.hasResult.store(false, std::memory_order_relaxed);
+    probe.value.store(kind == GameStateProbeKind::Pointer ? 1 : 0, std::memory_order_relaxed);
+    // Publish the slot only once it's fully set up
+    m_count.store(index + 1, std::memory_order_release);
+    return static_cast<int>(index);
+}
+
+void GameStateSnapshot::Update(const ::reframework::API* api, void* vmCtx) {
+    std::lock_guard lock(m_mutex);
+    const size_t count = m_count.load(std::memory_order_relaxed);
+    const bool diag = m_diag.load(std::memory_order_relaxed);
+    const int64_t now = SteadyNowUs();
+
+    for (size_t i = 0; i < count; ++i) {
+        Probe& probe = m_probes[i];
+        if (!probe.due && now - probe.lastRunUs < probe.intervalUs) continue;
+
+        uint64_t value = 0;
+        switch (probe.kind) {
+            case GameStateProbeKind::Bool:
+                value = InvokeBool(api, vmCtx, probe.check, diag, probe.label) ? 1 : 0;
+                break;
+            case GameStateProbeKind::Int:
+                value = InvokeInt(api, vmCtx, probe.check, diag, probe.label);
+                break;
+            case GameStateProbeKind::Pointer:
+                value = reinterpret_cast<uintptr_t>(InvokePointer(api, vmCtx, probe.check, diag, probe.label));
+                break;
+        }
+        probe.value.store(value, std::memory_order_relaxed);
+        probe.hasResult.store(true, std::memory_order_release);
+        probe.lastRunUs = now;
+        probe.due = false;
+    }
+}
+
+void GameStateSnapshot::RefreshAll() {
+    std::lock_guard lock(m_mutex);
+    const size_t count = m_count.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < count; ++i) m_probes[i].due = true;
+}
+
+const GameStateSnapshot::Probe* GameStateSnapshot::Find(int id) const {
+    if (id < 0 || static_cast<size_t>(id) >= m_count.load(std::memory_order_acquire)) return nullptr;
+    return &m_probes[id];
+}
+
+bool GameStateSnapshot::GetBool(int id) const {
+    const Probe* probe = Find(id);
+    return probe && probe->value.load(std::memory_order_relaxed) != 0;
+}
+
+uint32_t GameStateSnapshot::GetInt(int id) const {
+    const Probe* probe = Find(id);
+    return probe ? static_cast<uint32_t>(probe->value.load(std::memory_order_relaxed)) : 0;
+}
+
+void* GameStateSnapshot::GetPointer(int id) const {
+    const Probe* probe = Find(id);
+    return probe ? reinterpret_cast<void*>(static_cast<uintptr_t>(probe->value.load(std::memory_order_relaxed)))
+                 : reinterpret_cast<void*>(1);
+}
+
+bool GameStateSnapshot::HasResult(int id) const {
+    const Probe* probe = Find(id);
+    return probe && probe->hasResult.load(std::memory_order_acquire);
+}
+
+} // namespace cameraunlock::reframework
@@ -1,23 +1,28 @@
 #include <cameraunlock/reframework/log_callback.h>
-#include <cstdio>
-#include <cstdarg>
+
+#include <atomic>
 
 namespace cameraunlock::reframework {
 
-static LogCallbackFn g_logCallback = nullptr;
+static std::atomic<LogCallbackFn> g_logCallback{nullptr};
 
 void SetLogCallback(LogCallbackFn fn) {
-    g_logCallback = fn;
+    // Lines already queued go to the callback they were logged for
+    AsyncLog::Flush();
+    g_logCallback.store(fn, std::memory_order_release);
 }
 
-void Log(LogLevel level, const char* fmt, ...) {
-    if (!g_logCallback) return;
-    char buffer[512];
-    va_list args;
-    va_start(args, fmt);
-    vsnprintf(buffer, sizeof(buffer), fmt, args);
-    va_end(args);
-    g_logCallback(level, buffer);
+namespace log_detail {
+
+bool HasCallback() {
+    return g_logCallback.load(std::memory_order_relaxed) != nullptr;
 }
 
+void Deliver(void*, int level, const char* message) {
+    LogCallbackFn fn = g_logCallback.load(std::memory_order_acquire);
+    if (fn) fn(static_cast<LogLevel>(level), message);
+}
+
+} // namespace log_detail
+
 } // namespace cameraunlock::reframework
@@ -1,5 +1,19 @@
 #include <cameraunlock/reframework/managed_utils.h>
 
+#include <cstring>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
+// The plugin DLLs are x64, where SSE2 is baseline
+#if defined(__SSE2__) || defined(_M_X64)
+#define CAMERAUNLOCK_UTF16_SSE2 1
+#include <emmintrin.h>
+#endif
+
 namespace cameraunlock::reframework {
 
 static const std::vector<void*> s_emptyArgs{};
@@ -8,45 +22,184 @@ const std::vector<void*>& EmptyArgs() {
     return s_emptyArgs;
 }
 
-void ReadManagedString(void* stringPtr, char* out, size_t outSize) {
-    if (!stringPtr || outSize == 0) { if (out) out[0] = 0; return; }
-    const wchar_t* wstr = reinterpret_cast<const wchar_t*>(
-        reinterpret_cast<uint8_t*>(stringPtr) + 0x14);
+namespace {
+
+using TypeDefinition = ::reframework::API::TypeDefinition;
+using Method = ::reframework::API::Method;
+
+// Longest string ReadManagedString trusts the length header for
+constexpr int32_t kMaxManagedStringLength = 1 << 20;
+
+struct OverloadKey {
+    std::string_view type;
+    std::string_view method;
+    uint32_t params;
+    bool operator==(const OverloadKey& o) const {
+        return params == o.params && type == o.type && method == o.method;
+    }
+};
+
+struct OverloadKeyHash {
+    size_t operator()(const OverloadKey& k) const {
+        const size_t h = std::hash<std::string_view>()(k.type) * 31 ^ std::hash<std::string_view>()(k.method);
+        return h * 31 ^ k.params;
+    }
+};
+
+// Lookups use views of the caller's strings; stored keys point into
+// `interned`, so hits never allocate.
+struct MethodCache {
+    std::shared_mutex mutex;
+    std::unordered_set<std::string> interned;
+    std::unordered_map<OverloadKey, Method*, OverloadKeyHash> overloads;
+    std::unordered_map<TypeDefinition*, Method*> arrayGetValue;  // array type -> GetValue
+};
+
+MethodCache& Cache() {
+    static MethodCache cache;
+    return cache;
+}
+
+// Caller holds the exclusive lock
+std::string_view Intern(MethodCache& cache, const char* s) {
+    return *cache.interned.emplace(s).first;
+}
+
+// Appends one code point if it fits, leaving room for the terminator
+bool PutUtf8(uint32_t cp, char* out, size_t& pos, size_t limit) {
+    if (cp < 0x80) {
+        if (pos + 1 > limit) return false;
+        out[pos++] = (char)cp;
+    } else if (cp < 0x800) {
+        if (pos + 2 > limit) return false;
+        out[pos++] = (char)(0xC0 | (cp >> 6));
+        out[pos++] = (char)(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        if (pos + 3 > limit) return false;
+        out[pos++] = (char)(0xE0 | (cp >> 12));
+        out[pos++] = (char)(0x80 | ((cp >> 6) & 0x3F));
+        out[pos++] = (char)(0x80 | (cp & 0x3F));
+    } else {
+        if (pos + 4 > limit) return false;
+        out[pos++] = (char)(0xF0 | (cp >> 18));
+        out[pos++] = (char)(0x80 | ((cp >> 12) & 0x3F));
+        out[pos++] = (char)(0x80 | ((cp >> 6) & 0x3F));
+        out[pos++] = (char)(0x80 | (cp & 0x3F));
+    }
+    return true;
+}
+
+} // namespace
+
+size_t Utf16ToUtf8(const char16_t* in, size_t count, std::span<char> out) {
+    if (out.empty()) return 0;
+    char* dst = out.data();
+    const size_t limit = out.size() - 1;
+    size_t pos = 0;
     size_t i = 0;
-    for (; i + 1 < outSize && wstr[i]; i++) {
-        wchar_t c = wstr[i];
-        out[i] = (c >= 32 && c < 127) ? (char)c : '?';
+    if (!in) count = 0;
+
+    while (i < count) {
+#if CAMERAUNLOCK_UTF16_SSE2
+        // 8 non-NUL ASCII units narrow straight to 8 bytes
+        if (i + 8 <= count && pos + 8 <= limit) {
+            const __m128i units = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i high = _mm_and_si128(units, _mm_set1_epi16((short)0xFF80));
+            const int ascii = _mm_movemask_epi8(_mm_cmpeq_epi16(high, zero));
+            const int nul = _mm_movemask_epi8(_mm_cmpeq_epi16(units, zero));
+            if (ascii == 0xFFFF && nul == 0) {
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + pos), _mm_packus_epi16(units, units));
+                pos += 8;
+                i += 8;
+                continue;
+            }
+        }
+#endif
+        uint32_t cp = in[i];
+        if (cp == 0) break;
+        size_t used = 1;
+        if (cp >= 0xD800 && cp <= 0xDFFF) {
+            const uint32_t next = i + 1 < count ? in[i + 1] : 0;
+            if (cp <= 0xDBFF && next >= 0xDC00 && next <= 0xDFFF) {
+                cp = 0x10000 + ((cp - 0xD800) << 10) + (next - 0xDC00);
+                used = 2;
+            } else {
+                cp = 0xFFFD;
+            }
+        }
+        if (!PutUtf8(cp, dst, pos, limit)) break;
+        i += used;
     }
-    out[i] = 0;
+    dst[pos] = 0;
+    return pos;
 }
 
-void* CallMethod(::reframework::API::Method* method, void* obj) {
-    auto ret = method->invoke(reinterpret_cast<::reframework::API::ManagedObject*>(obj), s_emptyArgs);
-    return ret.ptr;
+void ReadManagedString(void* stringPtr, char* out, size_t outSize) {
+    if (!out || outSize == 0) return;
+    if (!stringPtr) { out[0] = 0; return; }
+    const uint8_t* base = reinterpret_cast<const uint8_t*>(stringPtr);
+    int32_t length = 0;
+    std::memcpy(&length, base + 0x10, sizeof(length));
+    if (length < 0 || length > kMaxManagedStringLength) length = 0;
+    Utf16ToUtf8(reinterpret_cast<const char16_t*>(base + 0x14), (size_t)length,
+                std::span<char>(out, outSize));
 }
 
 ::reframework::API::ManagedObject* ArrayGetValue(
     ::reframework::API::ManagedObject* arr, int i) {
     if (!arr) return nullptr;
-    std::vector<void*> idxArgs = { (void*)(uintptr_t)i };
-    auto ret = arr->invoke("GetValue", idxArgs);
+    auto type = arr->get_type_definition();
+    if (!type) return nullptr;
+
+    auto& cache = Cache();
+    Method* getValue = nullptr;
+    bool known = false;
+    {
+        std::shared_lock lock(cache.mutex);
+        auto it = cache.arrayGetValue.find(type);
+        if (it != cache.arrayGetValue.end()) {
+            getValue = it->second;
+            known = true;
+        }
+    }
+    if (!known) {
+        getValue = type->find_method("GetValue");
+        std::unique_lock lock(cache.mutex);
+        cache.arrayGetValue[type] = getValue;
+    }
+    if (!getValue) return nullptr;
+
+    auto ret = Invoke(getValue, arr, i);
     if (ret.exception_thrown) return nullptr;
     return reinterpret_cast<::reframework::API::ManagedObject*>(ret.ptr);
 }
 
 ::reframework::API::Method* FindMethodByParamCount(
     const char* typeName, const char* methodName, uint32_t paramCount) {
+    auto& cache = Cache();
+    {
+        std::shared_lock lock(cache.mutex);
+        auto it = cache.overloads.find(OverloadKey{typeName, methodName, paramCount});
+        if (it != cache.overloads.end()) return it->second;
+    }
+
+    Method* found = nullptr;
     const auto& api = ::reframework::API::get();
-    auto type = api->tdb()->find_type(typeName);
-    if (!type) return nullptr;
-    for (auto m : type->get_methods()) {
-        if (!m) continue;
-        const char* name = m->get_name();
-        if (!name || strcmp(name, methodName) != 0) continue;
-        if (m->get_num_params() != paramCount) continue;
-        return m;
-    }
-    return nullptr;
+    if (auto type = api->tdb()->find_type(typeName)) {
+        for (auto m : type->get_methods()) {
+            if (!m) continue;
+            const char* name = m->get_name();
+            if (!name || strcmp(name, methodName) != 0) continue;
+            if (m->get_num_params() != paramCount) continue;
+            found = m;
+            break;
+        }
+    }
+
+    std::unique_lock lock(cache.mutex);
+    cache.overloads[OverloadKey{Intern(cache, typeName), Intern(cache, methodName), paramCount}] = found;
+    return found;
 }
 
 } // namespace cameraunlock::reframework
@@ -0,0 +1,551 @@
+#include "cameraunlock/runtime/runtime.h"
+
+#include <algorithm>
+#include <memory>
+
+#ifndef _WIN32
+#include <poll.h>
+#endif
+
+namespace cameraunlock {
+
+namespace {
+
+thread_local const Runtime* t_currentRuntime = nullptr;
+
+// Back-off when the wait itself fails (e.g. a handle closed while registered)
+constexpr int kWaitErrorBackoffMs = 1;
+
+template <typename T>
+bool ErasePending(std::vector<T>& pending, int id) {
+    auto it = std::find_if(pending.begin(), pending.end(), [id](const T& item) { return item.id == id; });
+    if (it == pending.end()) {
+        return false;
+    }
+    pending.erase(it);
+    return true;
+}
+
+}  // namespace
+
+Runtime::~Runtime() {
+    Stop();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (Source& source : m_sources) {
+        ReleaseSource(source);
+    }
+    for (Source& source : m_pendingSources) {
+        ReleaseSource(source);
+    }
+    CloseWake();
+}
+
+bool Runtime::Start(const ThreadSchedulingOptions& scheduling) {
+    if (m_thread.joinable()) {
+        return true;
+    }
+    if (!OpenWake()) {
+        return false;
+    }
+
+    m_stopFlag.store(false, std::memory_order_release);
+    m_running.store(true, std::memory_order_release);
+    m_thread = StartScheduledThread(scheduling, m_schedulingResult, [this]() { Run(); });
+    return true;
+}
+
+void Runtime::Stop() {
+    if (!m_thread.joinable()) {
+        return;
+    }
+    m_stopFlag.store(true, std::memory_order_release);
+    Wake();
+    m_thread.join();
+}
+
+bool Runtime::IsRuntimeThread() const {
+    return t_currentRuntime == this;
+}
+
+int Runtime::AddSocket(SOCKET sock, Callback onReadable) {
+    if (sock == INVALID_SOCKET || !onReadable) {
+        return 0;
+    }
+
+    Source source{};
+    source.kind = SourceKind::Socket;
+    source.socket = sock;
+    source.callback = std::move(onReadable);
+#ifdef _WIN32
+    source.handle = WSACreateEvent();
+    if (source.handle == WSA_INVALID_EVENT) {
+        return 0;
+    }
+    // FD_READ is re-armed by each recvfrom while data remains queued.
+    if (WSAEventSelect(sock, source.handle, FD_READ | FD_CLOSE) == SOCKET_ERROR) {
+        WSACloseEvent(source.handle);
+        return 0;
+    }
+#else
+    source.fd = sock;
+#endif
+
+    int id = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_waitSourceCount < kMaxWaitSources) {
+            id = source.id = m_nextId++;
+            m_pendingSources.push_back(std::move(source));
+            ++m_waitSourceCount;
+        }
+    }
+    if (id == 0) {
+        ReleaseSource(source);
+        return 0;
+    }
+    Wake();
+    return id;
+}
+
+#ifdef _WIN32
+int Runtime::AddWaitHandle(HANDLE handle, Callback onSignaled) {
+    if (!handle || handle == INVALID_HANDLE_VALUE || !onSignaled) {
+        return 0;
+    }
+    Source source{};
+    source.kind = SourceKind::Handle;
+    source.socket = INVALID_SOCKET;
+    source.handle = handle;
+    source.callback = std::move(onSignaled);
+#else
+int Runtime::AddWaitHandle(int fd, Callback onReadable) {
+    if (fd < 0 || !onReadable) {
+        return 0;
+    }
+    Source source{};
+    source.kind = SourceKind::Handle;
+    source.socket = INVALID_SOCKET;
+    source.fd = fd;
+    source.callback = std::move(onReadable);
+#endif
+
+    int id = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_waitSourceCount < kMaxWaitSources) {
+            id = source.id = m_nextId++;
+            m_pendingSources.push_back(std::move(source));
+            ++m_waitSourceCount;
+        }
+    }
+    if (id != 0) {
+        Wake();
+    }
+    return id;
+}
+
+int Runtime::AddTimer(int delayMs, int periodMs, Callback onExpired) {
+    if (!onExpired) {
+        return 0;
+    }
+    Timer timer{};
+    timer.deadline = Clock::now() + std::chrono::milliseconds(std::max(delayMs, 0));
+    timer.periodMs = std::max(periodMs, 0);
+    timer.callback = std::move(onExpired);
+
+    int id;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        id = timer.id = m_nextId++;
+        m_pendingTimers.push_back(std::move(timer));
+        ++m_timerCount;
+    }
+    Wake();
+    return id;
+}
+
+void Runtime::Remove(int id) {
+    if (id <= 0) {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (auto it = m_pendingSources.begin(); it != m_pendingSources.end(); ++it) {
+        if (it->id == id) {
+            ReleaseSource(*it);
+            m_pendingSources.erase(it);
+            --m_waitSourceCount;
+            return;
+        }
+    }
+    if (ErasePending(m_pendingTimers, id)) {
+        --m_timerCount;
+        return;
+    }
+
+    if (IsRuntimeThread()) {
+        // Flagged now so it won't fire later in this pass; freed by Compact
+        lock.unlock();
+        MarkRemoved(id);
+        return;
+    }
+
+    if (m_running.load(std::memory_order_acquire)) {
+        m_pendingRemovals.push_back(id);
+        const uint64_t generation = ++m_requestGeneration;
+        lock.unlock();
+        Wake();
+        lock.lock();
+        m_applied.wait(lock, [&] {
+            return m_appliedGeneration >= generation || !m_running.load(std::memory_order_acquire);
+        });
+        if (m_appliedGeneration >= generation) {
+            return;
+        }
+        m_pendingRemovals.erase(std::remove(m_pendingRemovals.begin(), m_pendingRemovals.end(), id),
+                                m_pendingRemovals.end());
+    }
+
+    // Loop not running: nothing can be dispatching
+    for (auto it = m_sources.begin(); it != m_sources.end(); ++it) {
+        if (it->id == id) {
+            ReleaseSource(*it);
+            m_sources.erase(it);
+            --m_waitSourceCount;
+            return;
+        }
+    }
+    if (ErasePending(m_timers, id)) {
+        --m_timerCount;
+    }
+}
+
+void Runtime::Post(Callback fn) {
+    if (!fn) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_posted.push_back(std::move(fn));
+    }
+    Wake();
+}
+
+void Runtime::Call(Callback fn) {
+    if (!fn) {
+        return;
+    }
+    if (IsRuntimeThread() || !IsRunning()) {
+        fn();
+        return;
+    }
+
+    // Shared with the posted wrapper, which may outlive this call if the
+    // runtime stops before running it
+    struct CallState {
+        Callback fn;
+        std::atomic<bool> claimed{false};
+        bool done = false;
+    };
+    auto state = std::make_shared<CallState>();
+    state->fn = std::move(fn);
+    Post([this, state]() {
+        if (state->claimed.exchange(true)) return;
+        state->fn();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            state->done = true;
+        }
+        m_applied.notify_all();
+    });
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_applied.wait(lock, [&] { return state->done || !m_running.load(std::memory_order_acquire); });
+    if (state->done) {
+        return;
+    }
+    // Stopped first. Posted work only runs inside the loop, so the wrapper
+    // hasn't started and never will in this run
+    lock.unlock();
+    if (!state->claimed.exchange(true)) {
+        state->fn();
+    }
+}
+
+size_t Runtime::GetRegistrationCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_waitSourceCount + m_timerCount;
+}
+
+void Runtime::Run() {
+    t_currentRuntime = this;
+#ifdef _WIN32
+    // Create the message queue so hooks installed on this thread work
+    MSG msg;
+    PeekMessageW(&msg, nullptr, WM_USER, WM_USER, PM_NOREMOVE);
+#endif
+
+    for (;;) {
+        ApplyPending();
+        if (m_stopFlag.load(std::memory_order_acquire)) {
+            break;
+        }
+        WaitAndDispatch(WaitTimeoutMs());
+        RunTimers();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_running.store(false, std::memory_order_release);
+    }
+    m_applied.notify_all();
+    t_currentRuntime = nullptr;
+}
+
+void Runtime::ApplyPending() {
+    std::vector<Callback> posted;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (Source& source : m_pendingSources) {
+            m_sources.push_back(std::move(source));
+        }
+        m_pendingSources.clear();
+        for (Timer& timer : m_pendingTimers) {
+            m_timers.push_back(std::move(timer));
+        }
+        m_pendingTimers.clear();
+        for (int id : m_pendingRemovals) {
+            for (Source& source : m_sources) {
+                if (source.id == id) source.removed = true;
+            }
+            for (Timer& timer : m_timers) {
+                if (timer.id == id) timer.removed = true;
+            }
+        }
+        m_pendingRemovals.clear();
+        posted.swap(m_posted);
+        m_appliedGeneration = m_requestGeneration;
+    }
+    m_applied.notify_all();
+
+    for (Callback& fn : posted) {
+        fn();
+    }
+    // After posted work, so sources it removed are gone before the wait
+    Compact();
+}
+
+int Runtime::WaitTimeoutMs() const {
+    bool any = false;
+    Clock::time_point nearest;
+    for (const Timer& timer : m_timers) {
+        if (timer.removed) continue;
+        if (!any || timer.deadline < nearest) {
+            nearest = timer.deadline;
+            any = true;
+        }
+    }
+    if (!any) {
+        return -1;
+    }
+    const auto remaining = std::chrono::duration_cast<std::chrono::microseconds>(nearest - Clock::now()).count();
+    // Round up so the timer is due when the wait returns
+    return remaining <= 0 ? 0 : static_cast<int>((remaining + 999) / 1000);
+}
+
+void Runtime::RunTimers() {
+    const Clock::time_point now = Clock::now();
+    // Timers added by callbacks wait in m_pendingTimers, so size is stable
+    for (size_t i = 0; i < m_timers.size(); ++i) {
+        Timer& timer = m_timers[i];
+        if (timer.removed || timer.deadline > now) continue;
+        if (timer.periodMs > 0) {
+            timer.deadline += std::chrono::milliseconds(timer.periodMs);
+            // After a stall, skip the missed periods instead of firing in a burst
+            if (timer.deadline <= now) {
+                timer.deadline = now + std::chrono::milliseconds(timer.periodMs);
+            }
+        } else {
+            timer.removed = true;
+        }
+        timer.callback();
+    }
+}
+
+void Runtime::MarkRemoved(int id) {
+    for (Source& source : m_sources) {
+        if (source.id == id) source.removed = true;
+    }
+    for (Timer& timer : m_timers) {
+        if (timer.id == id) timer.removed = true;
+    }
+}
+
+void Runtime::Compact() {
+    size_t released = 0;
+    for (Source& source : m_sources) {
+        if (source.removed) {
+            ReleaseSource(source);
+            ++released;
+        }
+    }
+    m_sources.erase(std::remove_if(m_sources.begin(), m_sources.end(),
+                                   [](const Source& source) { return source.removed; }),
+                    m_sources.end());
+    const size_t timers = m_timers.size();
+    m_timers.erase(std::remove_if(m_timers.begin(), m_timers.end(),
+                                  [](const Timer& timer) { return timer.removed; }),
+                   m_timers.end());
+    const size_t expired = timers - m_timers.size();
+    if (released > 0 || expired > 0) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_waitSourceCount -= released;
+        m_timerCount -= expired;
+    }
+}
+
+#ifdef _WIN32
+
+bool Runtime::OpenWake() {
+    if (!m_wakeEvent) {
+        m_wakeEvent = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+    }
+    return m_wakeEvent != nullptr;
+}
+
+void Runtime::CloseWake() {
+    if (m_wakeEvent) {
+        CloseHandle(m_wakeEvent);
+        m_wakeEvent = nullptr;
+    }
+}
+
+void Runtime::Wake() {
+    if (m_wakeEvent) {
+        SetEvent(m_wakeEvent);
+    }
+}
+
+void Runtime::ReleaseSource(Source& source) {
+    if (source.kind == SourceKind::Socket && source.handle) {
+        // Detach from the event; the socket stays non-blocking.
+        WSAEventSelect(source.socket, nullptr, 0);
+        WSACloseEvent(source.handle);
+        source.handle = nullptr;
+    }
+}
+
+void Runtime::WaitAndDispatch(int timeoutMs) {
+    HANDLE handles[kMaxWaitSources + 1];
+    const DWORD count = static_cast<DWORD>(m_sources.size() + 1);
+    handles[0] = m_wakeEvent;
+    for (size_t i = 0; i < m_sources.size(); ++i) {
+        handles[i + 1] = m_sources[i].handle;
+    }
+
+    const DWORD timeout = timeoutMs < 0 ? INFINITE : static_cast<DWORD>(timeoutMs);
+    const DWORD result = MsgWaitForMultipleObjectsEx(count, handles, timeout, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+
+    if (result == WAIT_FAILED) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(kWaitErrorBackoffMs));
+        return;
+    }
+    if (result > WAIT_OBJECT_0 && result < WAIT_OBJECT_0 + count) {
+        // The wait reports the first signaled handle; check the rest too
+        for (DWORD i = result - WAIT_OBJECT_0; i < count; ++i) {
+            Source& source = m_sources[i - 1];
+            if (source.removed) continue;
+            if (i != result - WAIT_OBJECT_0 && WaitForSingleObject(handles[i], 0) != WAIT_OBJECT_0) continue;
+            if (source.kind == SourceKind::Socket) {
+                WSANETWORKEVENTS networkEvents;
+                // Resets the socket's event.
+                WSAEnumNetworkEvents(source.socket, source.handle, &networkEvents);
+            }
+            source.callback();
+        }
+    }
+
+    // Messages are pumped every pass; this is what runs low-level hooks
+    MSG msg;
+    while (PeekMessageW(&msg, nullptr, 0, 0, PM_REMOVE)) {
+        if (msg.message == WM_QUIT) continue;
+        TranslateMessage(&msg);
+        DispatchMessageW(&msg);
+    }
+}
+
+#else
+
+bool Runtime::OpenWake() {
+    if (m_wakePipe[0] >= 0) {
+        return true;
+    }
+    if (pipe(m_wakePipe) != 0) {
+        m_wakePipe[0] = m_wakePipe[1] = -1;
+        return false;
+    }
+    fcntl(m_wakePipe[0], F_SETFL, O_NONBLOCK);
+    fcntl(m_wakePipe[1], F_SETFL, O_NONBLOCK);
+    return true;
+}
+
+void Runtime::CloseWake() {
+    for (int& fd : m_wakePipe) {
+        if (fd >= 0) {
+            close(fd);
+            fd = -1;
+        }
+    }
+}
+
+void Runtime::Wake() {
+    if (m_wakePipe[1] >= 0) {
+        const char byte = 1;
+        // A full pipe already means a pending wakeup.
+        ssize_t written = write(m_wakePipe[1], &byte, 1);
+        (void)written;
+    }
+}
+
+void Runtime::ReleaseSource(Source&) {
+}
+
+void Runtime::WaitAndDispatch(int timeoutMs) {
+    pollfd fds[kMaxWaitSources + 1];
+    const size_t count = m_sources.size() + 1;
+    fds[0] = {m_wakePipe[0], POLLIN, 0};
+    for (size_t i = 0; i < m_sources.size(); ++i) {
+        fds[i + 1] = {m_sources[i].fd, POLLIN, 0};
+    }
+
+    const int ready = poll(fds, static_cast<nfds_t>(count), timeoutMs);
+    if (ready < 0) {
+        if (errno != EINTR) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(kWaitErrorBackoffMs));
+        }
+        return;
+    }
+    if (ready == 0) {
+        return;
+    }
+
+    if (fds[0].revents != 0) {
+        char drain[64];
+        while (read(m_wakePipe[0], drain, sizeof(drain)) > 0) {
+        }
+    }
+    for (size_t i = 1; i < count; ++i) {
+        Source& source = m_sources[i - 1];
+        if (fds[i].revents == 0 || source.removed) continue;
+        if (fds[i].revents & POLLNVAL) {
+            // Closed without Remove(); drop it rather than spin on it
+            source.removed = true;
+            continue;
+        }
+        source.callback();
+    }
+}
+
+#endif
+
+}  // namespace cameraunlock
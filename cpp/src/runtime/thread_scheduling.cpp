@@ -0,0 +1,204 @@
+#include "cameraunlock/runtime/thread_scheduling.h"
+
+#include <string>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+#endif
+
+namespace cameraunlock {
+
+namespace {
+
+#ifdef _WIN32
+
+using AvSetMmThreadCharacteristicsWFn = HANDLE(WINAPI*)(LPCWSTR, LPDWORD);
+using AvRevertMmThreadCharacteristicsFn = BOOL(WINAPI*)(HANDLE);
+
+HMODULE AvrtModule() {
+    // Kept loaded for the process lifetime; revert needs it at thread exit.
+    static HMODULE module = LoadLibraryW(L"avrt.dll");
+    return module;
+}
+
+SchedulingStatus ApplyPriority(ThreadPriority priority) {
+    int value = THREAD_PRIORITY_NORMAL;
+    switch (priority) {
+        case ThreadPriority::Normal:       return SchedulingStatus::NotRequested;
+        case ThreadPriority::AboveNormal:  value = THREAD_PRIORITY_ABOVE_NORMAL; break;
+        case ThreadPriority::Highest:      value = THREAD_PRIORITY_HIGHEST; break;
+        case ThreadPriority::TimeCritical: value = THREAD_PRIORITY_TIME_CRITICAL; break;
+    }
+    return SetThreadPriority(GetCurrentThread(), value) ? SchedulingStatus::Applied
+                                                        : SchedulingStatus::Failed;
+}
+
+SchedulingStatus ApplyAffinity(uint64_t mask) {
+    DWORD_PTR applied = SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(mask));
+    return applied != 0 ? SchedulingStatus::Applied : SchedulingStatus::Failed;
+}
+
+SchedulingStatus ApplyMmcss(const char* task, void*& handle) {
+    HMODULE avrt = AvrtModule();
+    auto setFn = avrt ? reinterpret_cast<AvSetMmThreadCharacteristicsWFn>(
+        GetProcAddress(avrt, "AvSetMmThreadCharacteristicsW")) : nullptr;
+    if (setFn == nullptr) {
+        return SchedulingStatus::Unsupported;
+    }
+
+    // Task names are plain ASCII registry keys.
+    std::wstring wideTask;
+    for (const char* c = task; *c != '\0'; ++c) {
+        wideTask.push_back(static_cast<wchar_t>(static_cast<unsigned char>(*c)));
+    }
+
+    DWORD taskIndex = 0;
+    HANDLE mmcss = setFn(wideTask.c_str(), &taskIndex);
+    if (mmcss == nullptr) {
+        return SchedulingStatus::Failed;
+    }
+    handle = mmcss;
+    return SchedulingStatus::Applied;
+}
+
+#else
+
+SchedulingStatus ApplyPriority(ThreadPriority priority) {
+    if (priority == ThreadPriority::Normal) {
+        return SchedulingStatus::NotRequested;
+    }
+
+    if (priority == ThreadPriority::TimeCritical) {
+        sched_param param = {};
+        param.sched_priority = sched_get_priority_min(SCHED_FIFO);
+        return pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0
+            ? SchedulingStatus::Applied : SchedulingStatus::Failed;
+    }
+
+#ifdef __linux__
+    // On Linux niceness is per thread when addressed by TID.
+    int nice = priority == ThreadPriority::Highest ? -10 : -5;
+    pid_t tid = static_cast<pid_t>(syscall(SYS_gettid));
+    return setpriority(PRIO_PROCESS, static_cast<id_t>(tid), nice) == 0
+        ? SchedulingStatus::Applied : SchedulingStatus::Failed;
+#else
+    return SchedulingStatus::Unsupported;
+#endif
+}
+
+SchedulingStatus ApplyAffinity(uint64_t mask) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu = 0; cpu < 64; ++cpu) {
+        if (mask & (uint64_t{1} << cpu)) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0
+        ? SchedulingStatus::Applied : SchedulingStatus::Failed;
+#else
+    (void)mask;
+    return SchedulingStatus::Unsupported;
+#endif
+}
+
+SchedulingStatus ApplyMmcss(const char*, void*&) {
+    return SchedulingStatus::Unsupported;
+}
+
+#endif
+
+}  // namespace
+
+ThreadSchedulingResult ApplyCurrentThreadScheduling(const ThreadSchedulingOptions& options,
+                                                    void*& mmcssHandle) {
+    ThreadSchedulingResult result;
+    mmcssHandle = nullptr;
+
+    // MMCSS first: the service manages the thread's priority while it is
+    // registered and would clobber an explicit one, so that is only the
+    // fallback when registration is unavailable.
+    if (options.mmcssTask != nullptr && options.mmcssTask[0] != '\0') {
+        result.mmcss = ApplyMmcss(options.mmcssTask, mmcssHandle);
+    }
+    if (result.mmcss == SchedulingStatus::Applied && options.priority != ThreadPriority::Normal) {
+        result.priority = SchedulingStatus::Superseded;
+    } else {
+        result.priority = ApplyPriority(options.priority);
+    }
+    if (options.affinityMask != 0) {
+        result.affinity = ApplyAffinity(options.affinityMask);
+    }
+    return result;
+}
+
+void RevertCurrentThreadScheduling(void* mmcssHandle) {
+#ifdef _WIN32
+    if (mmcssHandle == nullptr) {
+        return;
+    }
+    HMODULE avrt = AvrtModule();
+    auto revertFn = avrt ? reinterpret_cast<AvRevertMmThreadCharacteristicsFn>(
+        GetProcAddress(avrt, "AvRevertMmThreadCharacteristics")) : nullptr;
+    if (revertFn != nullptr) {
+        revertFn(static_cast<HANDLE>(mmcssHandle));
+    }
+#else
+    (void)mmcssHandle;
+#endif
+}
+
+void ThreadSchedulingSlot::Reset(const ThreadSchedulingOptions& options) {
+    ThreadSchedulingResult pending;
+    if (options.priority != ThreadPriority::Normal) {
+        pending.priority = SchedulingStatus::Pending;
+    }
+    if (options.affinityMask != 0) {
+        pending.affinity = SchedulingStatus::Pending;
+    }
+    if (options.mmcssTask != nullptr && options.mmcssTask[0] != '\0') {
+        pending.mmcss = SchedulingStatus::Pending;
+    }
+    Set(pending);
+}
+
+void ThreadSchedulingSlot::Set(const ThreadSchedulingResult& result) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_result = result;
+}
+
+ThreadSchedulingResult ThreadSchedulingSlot::Get() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_result;
+}
+
+std::thread StartScheduledThread(const ThreadSchedulingOptions& options,
+                                 ThreadSchedulingSlot& result,
+                                 std::function<void()> body) {
+    result.Reset(options);
+
+    // The MMCSS task name is copied; the caller's string may not outlive
+    // the start call
+    std::string mmcssTask = options.mmcssTask != nullptr ? options.mmcssTask : "";
+    return std::thread([options = options, mmcssTask, &result, body = std::move(body)]() mutable {
+        if (options.mmcssTask != nullptr) {
+            options.mmcssTask = mmcssTask.c_str();
+        }
+        void* mmcssHandle = nullptr;
+        result.Set(ApplyCurrentThreadScheduling(options, mmcssHandle));
+        body();
+        RevertCurrentThreadScheduling(mmcssHandle);
+    });
+}
+
+}  // namespace cameraunlock
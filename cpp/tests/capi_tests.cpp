@@ -0,0 +1,135 @@
+// C ABI tests (built with CAMERAUNLOCK_BUILD_CAPI).
+//
+// Run against the shared library through its exported functions only, the
+// way a managed mod loads it. The checks pin the null-handle contract, that
+// the default settings match HeadPoseProcessor's, and one loopback datagram
+// through cu_tracker_step into the caller's frame.
+
+#include "cameraunlock/capi/cameraunlock_capi.h"
+#include "cameraunlock/processing/head_pose_processor.h"
+#include "cameraunlock/protocol/udp_socket.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+namespace {
+
+int g_failures = 0;
+
+void Check(bool cond, const char* name) {
+    if (cond) {
+        std::cout << "  [PASS] " << name << "\n";
+    } else {
+        std::cout << "  [FAIL] " << name << "\n";
+        ++g_failures;
+    }
+}
+
+}  // namespace
+
+int RunCapiTests() {
+    std::cout << "C API tests\n";
+
+    Check(cu_get_api_version() == CU_API_VERSION, "library reports the header's API version");
+
+    // Null handles are ignored and read as no data
+    {
+        cu_frame frame;
+        std::memset(&frame, 0xff, sizeof(frame));
+        cu_sample sample;
+        Check(cu_tracker_step(nullptr, 0.016f, &frame) == 0 && frame.sequence == 0 && frame.flags == 0,
+              "step on a null tracker clears the frame");
+        Check(cu_tracker_get_sample(nullptr, &sample) == 0 && sample.sequence == 0,
+              "null tracker has no sample");
+        Check(cu_tracker_start(nullptr, 4242) == 0, "null tracker does not start");
+        cu_tracker_stop(nullptr);
+        cu_tracker_recenter(nullptr);
+        cu_tracker_reset(nullptr);
+        cu_tracker_set_settings(nullptr, nullptr);
+        cu_tracker_destroy(nullptr);
+    }
+
+    {
+        const cameraunlock::HeadPoseProcessor processor;
+        cu_settings settings;
+        cu_get_default_settings(&settings);
+        Check(settings.sensitivity_yaw == processor.GetSensitivity().yaw &&
+              settings.smoothing == processor.GetSmoothing() &&
+              settings.position_enabled == (processor.IsPositionEnabled() ? 1 : 0) &&
+              settings.position_limit_z_back == processor.GetPositionSettings().limit_z_back &&
+              settings.tracker_pivot_forward == processor.GetTrackerPivotForward() &&
+              settings.max_extrapolation_fraction == processor.GetMaxExtrapolationFraction(),
+              "default settings match HeadPoseProcessor");
+    }
+
+    // One datagram through receive and step
+    {
+        constexpr uint16_t kCapiTestPort = 47441;
+        cu_tracker* tracker = cu_tracker_create();
+        Check(tracker != nullptr, "tracker created");
+
+        cu_frame frame;
+        Check(cu_tracker_step(tracker, 0.016f, &frame) == 0 && frame.sequence == 0 &&
+              (frame.receiver_flags & CU_RECEIVER_RUNNING) == 0,
+              "stopped tracker steps without a pose");
+
+        cameraunlock::UdpSocket sender;
+        if (cu_tracker_start(tracker, kCapiTestPort) == 1 && sender.Open(0)) {
+            cu_settings settings;
+            cu_get_default_settings(&settings);
+            settings.sensitivity_yaw = 2.0f;
+            settings.interpolation_enabled = 0;
+            cu_tracker_set_settings(tracker, &settings);
+
+            sockaddr_in addr = {};
+            addr.sin_family = AF_INET;
+            addr.sin_port = htons(kCapiTestPort);
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            double pkt[6] = {0.0, 0.0, 0.0, 10.0, 0.0, 0.0};
+            bool received = false;
+            cu_sample sample = {};
+            for (int i = 0; i < 20 && !received; ++i) {
+                sendto(sender.GetHandle(), reinterpret_cast<const char*>(pkt), sizeof(pkt), 0,
+                       reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+                for (int j = 0; j < 20 && !received; ++j) {
+                    received = cu_tracker_get_sample(tracker, &sample) == 1;
+                    if (!received) std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                }
+            }
+            Check(received && sample.sequence != 0 && std::fabs(sample.yaw - 10.0f) < 1e-4f,
+                  "raw sample reaches the caller");
+
+            Check(cu_tracker_step(tracker, 0.016f, &frame) == 1, "step returns a valid rotation");
+            Check(frame.sequence == sample.sequence && frame.sample_timestamp_us == sample.timestamp_us &&
+                  frame.sample_age_us >= 0,
+                  "frame carries the sample's sequence and age");
+            Check((frame.flags & CU_FRAME_NEW_SAMPLE) != 0 && (frame.flags & CU_FRAME_ROTATION_VALID) != 0 &&
+                  (frame.receiver_flags & CU_RECEIVER_RUNNING) != 0 &&
+                  (frame.receiver_flags & CU_RECEIVER_RECEIVING) != 0,
+                  "frame and receiver flags");
+            Check(std::fabs(frame.yaw - 20.0f) < 1e-3f, "settings apply (yaw sensitivity 2x)");
+            Check(std::fabs(frame.rot_x * frame.rot_x + frame.rot_y * frame.rot_y +
+                            frame.rot_z * frame.rot_z + frame.rot_w * frame.rot_w - 1.0f) < 1e-4f,
+                  "rotation is a unit quaternion");
+
+            cu_tracker_step(tracker, 0.016f, &frame);
+            Check((frame.flags & CU_FRAME_NEW_SAMPLE) == 0, "repeated sample is not new");
+
+            cu_tracker_recenter(tracker);
+            cu_tracker_step(tracker, 0.016f, &frame);
+            Check(std::fabs(frame.yaw) < 1e-3f, "recenter zeroes the current pose");
+
+            cu_tracker_stop(tracker);
+            cu_tracker_step(tracker, 0.016f, &frame);
+            Check((frame.receiver_flags & CU_RECEIVER_RUNNING) == 0, "stop clears the running flag");
+        } else {
+            std::cout << "  [SKIP] C API test port unavailable\n";
+        }
+        cu_tracker_destroy(tracker);
+    }
+
+    return g_failures;
+}
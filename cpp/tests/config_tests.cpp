@@ -0,0 +1,156 @@
+// INI reader tests.
+//
+// IniReader reads the file once and answers every Read* from its index, with
+// GetPrivateProfileString's rules on every platform. The file is rewritten
+// between checks without reopening to prove reads never go back to disk.
+// ConfigWatcher must collapse a burst of writes into one re-parse of the
+// final contents and ignore other files in the same directory.
+
+#include "cameraunlock/config/config_watcher.h"
+#include "cameraunlock/config/ini_reader.h"
+#include "cameraunlock/runtime/settings_channel.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <thread>
+
+namespace {
+
+int g_failures = 0;
+
+void Check(bool cond, const char* name) {
+    if (cond) {
+        std::cout << "  [PASS] " << name << "\n";
+    } else {
+        std::cout << "  [FAIL] " << name << "\n";
+        ++g_failures;
+    }
+}
+
+bool WriteFile(const char* path, const char* text) {
+    FILE* file = fopen(path, "wb");
+    if (!file) return false;
+    fputs(text, file);
+    return fclose(file) == 0;
+}
+
+template <typename Pred>
+bool WaitFor(Pred pred, int timeoutMs) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (!pred()) {
+        if (std::chrono::steady_clock::now() > deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return true;
+}
+
+}  // namespace
+
+int RunConfigTests() {
+    using cameraunlock::IniReader;
+
+    std::cout << "Config tests\n";
+
+    const char* path = "cameraunlock_test_config.ini";
+    WriteFile(path,
+              "\xEF\xBB\xBF; comment\r\n"
+              "orphan=1\r\n"
+              "[General]\r\n"
+              "  Name = Head Tracking  \r\n"
+              "Quoted=\"  spaced  \"\r\n"
+              "Empty=\r\n"
+              "Sensitivity=1.5\r\n"
+              "Port = 4242\r\n"
+              "Big=9000000000\r\n"
+              "Key=0x77\r\n"
+              "Enabled=Yes\r\n"
+              "Port=1111\r\n"
+              "# not a comment\n"
+              "#Hash=1\n"
+              "[ Hotkeys ]\n"
+              "toggle=0x2D\n"
+              "NotANumber=abc\n");
+
+    IniReader ini;
+    Check(ini.Open(path), "open reads the file");
+    std::remove(path);
+
+    Check(ini.ReadString("General", "Name") == "Head Tracking", "values are trimmed");
+    Check(ini.ReadString("general", "NAME") == "Head Tracking", "names are case-insensitive");
+    Check(ini.ReadString("General", "Quoted") == "  spaced  ", "surrounding quotes removed");
+    Check(ini.ReadString("General", "Empty", "dflt").empty(), "empty value is not the default");
+    Check(ini.ReadString("General", "Missing", "dflt") == "dflt", "missing key gives the default");
+    Check(ini.ReadString("", "orphan", "dflt") == "dflt", "keys before any section are ignored");
+    Check(ini.ReadInt("General", "Port") == 4242, "first occurrence of a key wins");
+    Check(ini.ReadFloat("General", "Sensitivity") == 1.5f, "float read");
+    Check(ini.ReadInt64("General", "Big") == 9000000000LL, "int64 read");
+    Check(ini.ReadHex("General", "Key") == 0x77, "hex read");
+    Check(ini.ReadBool("General", "Enabled"), "bool read");
+    Check(ini.ReadHex("Hotkeys", "Toggle") == 0x2D, "section names are trimmed");
+    Check(ini.ReadInt("Hotkeys", "NotANumber", 7) == 7, "unparseable number gives the default");
+    Check(ini.ReadInt("General", "Empty", 7) == 7, "empty number gives the default");
+    Check(ini.ReadInt("General", "#Hash") == 1, "'#' lines are keys, as with the profile API");
+    Check(ini.GetEntryCount() == 12, "comments and orphans not indexed");
+
+    // Reads come from memory: the file is gone
+    Check(ini.ReadInt("General", "Port") == 4242, "reads don't touch the disk");
+    Check(!ini.Reload() && ini.ReadInt("General", "Port") == 4242, "failed reload keeps contents");
+
+    WriteFile(path, "[General]\nPort=5555\n");
+    Check(ini.Reload() && ini.ReadInt("General", "Port") == 5555 && ini.GetEntryCount() == 1,
+          "reload re-reads the file");
+
+    WriteFile(path, "[General]\nPort=6666\n");
+    ini.RefreshModTime();
+    Check(ini.ReadInt("General", "Port") == 6666, "RefreshModTime picks up new values");
+
+    IniReader moved = std::move(ini);
+    Check(moved.ReadInt("General", "Port") == 6666, "index survives a move");
+    moved.Close();
+    Check(moved.ReadInt("General", "Port", 3) == 3 && !moved.IsOpen(), "close drops the index");
+    std::remove(path);
+
+    Check(!IniReader().Open("cameraunlock_missing.ini"), "missing file fails to open");
+
+    {
+        using cameraunlock::ConfigWatcher;
+        using cameraunlock::SettingsChannel;
+
+        WriteFile(path, "[General]\nPort=1\n");
+        SettingsChannel<int> channel(1);
+        ConfigWatcher watcher;
+        const bool started = watcher.Start(path, [&](const IniReader& ini) {
+            channel.Publish(ini.ReadInt("General", "Port"));
+        }, 100);
+        Check(started && watcher.IsRunning(), "watcher starts");
+
+        const char* other = "cameraunlock_test_other.ini";
+        WriteFile(other, "[General]\nPort=9\n");
+        std::this_thread::sleep_for(std::chrono::milliseconds(250));
+        Check(watcher.GetReloadCount() == 0, "watcher ignores other files");
+        std::remove(other);
+
+        // Editor-style burst: truncate-and-write several times back to back
+        WriteFile(path, "[General]\nPort=2\n");
+        WriteFile(path, "[General]\nPort=");
+        WriteFile(path, "[General]\nPort=3\n");
+        uint64_t seen = 1;
+        int port = 0;
+        const bool reloaded = WaitFor([&] { return channel.ReadIfChanged(seen, port); }, 3000);
+        Check(reloaded && port == 3, "watcher publishes the final contents");
+        std::this_thread::sleep_for(std::chrono::milliseconds(250));
+        Check(watcher.GetReloadCount() == 1, "write burst is debounced into one reload");
+
+        WriteFile(path, "[General]\nPort=4\n");
+        Check(WaitFor([&] { return channel.ReadIfChanged(seen, port); }, 3000) && port == 4,
+              "watcher picks up a later write");
+
+        watcher.Stop();
+        Check(!watcher.IsRunning(), "watcher stops");
+        std::remove(path);
+    }
+
+    return g_failures;
+}
@@ -0,0 +1,174 @@
+// Shared tracking data tests.
+//
+// SharedTrackingSample is read by the game/render threads while the receiver
+// thread publishes into it. The contract is that a reader always sees every
+// field of a sample from the same Publish call - never yaw from one packet
+// and position from the next. The concurrent test below publishes samples
+// whose fields are all derived from one counter and fails on any mix, and
+// on any read that reports no data while a sample exists.
+// TrackingSampleRing has the same contract per slot, plus in-order delivery
+// of everything a consumer has not fallen too far behind on.
+
+#include "cameraunlock/data/tracking_pose.h"
+#include "cameraunlock/data/tracking_sample_ring.h"
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+
+namespace {
+
+int g_failures = 0;
+
+void Check(bool cond, const char* name) {
+    if (cond) {
+        std::cout << "  [PASS] " << name << "\n";
+    } else {
+        std::cout << "  [FAIL] " << name << "\n";
+        ++g_failures;
+    }
+}
+
+cameraunlock::TrackingSample MakeSample(uint32_t n) {
+    cameraunlock::TrackingSample s;
+    float f = static_cast<float>(n % 100000u);
+    s.yaw = f;
+    s.pitch = f + 1.0f;
+    s.roll = f + 2.0f;
+    s.x = f + 3.0f;
+    s.y = f + 4.0f;
+    s.z = f + 5.0f;
+    s.timestamp_us = static_cast<int64_t>(n % 100000u);
+    return s;
+}
+
+bool IsCoherent(const cameraunlock::TrackingSample& s) {
+    float f = s.yaw;
+    return s.pitch == f + 1.0f && s.roll == f + 2.0f &&
+           s.x == f + 3.0f && s.y == f + 4.0f && s.z == f + 5.0f &&
+           s.timestamp_us == static_cast<int64_t>(f);
+}
+
+}  // namespace
+
+int RunDataTests() {
+    using cameraunlock::SharedTrackingSample;
+    using cameraunlock::TrackingSample;
+    using cameraunlock::TrackingSampleRing;
+
+    std::cout << "Data tests\n";
+
+    {
+        SharedTrackingSample shared;
+        TrackingSample out;
+        Check(!shared.TryGet(out), "empty sample reports no data");
+
+        shared.Publish(MakeSample(7));
+        Check(shared.TryGet(out) && out.sequence == 1 && out.yaw == 7.0f && out.z == 12.0f,
+              "published sample readable with sequence 1");
+
+        shared.Publish(MakeSample(8));
+        Check(shared.TryGet(out) && out.sequence == 2 && out.yaw == 8.0f,
+              "second publish advances sequence");
+        Check(shared.GetSequence() == 2, "GetSequence matches latest publish");
+
+        shared.Reset();
+        Check(!shared.TryGet(out) && shared.GetSequence() == 0, "reset clears sample");
+    }
+
+    // Concurrent publish/read: every successful read must be coherent and
+    // sequence numbers must never go backwards.
+    {
+        SharedTrackingSample shared;
+        shared.Publish(MakeSample(0));
+        std::atomic<bool> done{false};
+        std::thread writer([&] {
+            for (uint32_t n = 0; n < 200000u; ++n) {
+                shared.Publish(MakeSample(n));
+            }
+            done.store(true, std::memory_order_release);
+        });
+
+        bool coherent = true;
+        bool monotonic = true;
+        bool available = true;
+        uint64_t lastSeq = 0;
+        while (!done.load(std::memory_order_acquire)) {
+            TrackingSample s;
+            if (shared.TryGet(s)) {
+                coherent = coherent && IsCoherent(s);
+                monotonic = monotonic && s.sequence >= lastSeq;
+                lastSeq = s.sequence;
+            } else {
+                available = false;
+            }
+        }
+        writer.join();
+
+        Check(coherent, "concurrent reads never observe a torn sample");
+        Check(monotonic, "concurrent reads see non-decreasing sequence");
+        Check(available, "concurrent reads never miss an existing sample");
+    }
+
+    {
+        TrackingSampleRing ring;
+        TrackingSample out[TrackingSampleRing::kCapacity];
+        uint64_t cursor = 0;
+        Check(ring.ReadSince(cursor, out, TrackingSampleRing::kCapacity) == 0,
+              "empty ring returns nothing");
+
+        for (uint32_t n = 1; n <= 3; ++n) ring.Push(MakeSample(n));
+        size_t count = ring.ReadSince(cursor, out, TrackingSampleRing::kCapacity);
+        Check(count == 3 && out[0].yaw == 1.0f && out[2].yaw == 3.0f,
+              "ring returns new samples oldest first");
+        Check(ring.ReadSince(cursor, out, TrackingSampleRing::kCapacity) == 0,
+              "ring cursor advances past consumed samples");
+
+        for (uint32_t n = 4; n <= 100; ++n) ring.Push(MakeSample(n));
+        count = ring.ReadSince(cursor, out, TrackingSampleRing::kCapacity);
+        Check(count == TrackingSampleRing::kCapacity &&
+              out[0].yaw == static_cast<float>(100 - TrackingSampleRing::kCapacity + 1) &&
+              out[count - 1].yaw == 100.0f,
+              "lapped consumer gets the newest kCapacity samples");
+
+        for (uint32_t n = 101; n <= 110; ++n) ring.Push(MakeSample(n));
+        count = ring.ReadSince(cursor, out, 4);
+        Check(count == 4 && out[0].yaw == 107.0f && out[3].yaw == 110.0f,
+              "maxCount keeps the newest samples");
+    }
+
+    // Concurrent push/read: samples must be coherent and strictly ordered.
+    {
+        TrackingSampleRing ring;
+        std::atomic<bool> done{false};
+        std::thread writer([&] {
+            for (uint32_t n = 1; n <= 200000u; ++n) {
+                ring.Push(MakeSample(n));
+            }
+            done.store(true, std::memory_order_release);
+        });
+
+        bool coherent = true;
+        bool ordered = true;
+        uint64_t cursor = 0;
+        int64_t last = -1;
+        TrackingSample out[TrackingSampleRing::kCapacity];
+        while (!done.load(std::memory_order_acquire)) {
+            size_t count = ring.ReadSince(cursor, out, TrackingSampleRing::kCapacity);
+            for (size_t i = 0; i < count; ++i) {
+                coherent = coherent && IsCoherent(out[i]);
+                int64_t ts = out[i].timestamp_us;
+                // MakeSample wraps at 100000; allow that one discontinuity.
+                ordered = ordered && (ts > last || last - ts > 50000);
+                last = ts;
+            }
+        }
+        writer.join();
+
+        Check(coherent, "concurrent ring reads never observe a torn sample");
+        Check(ordered, "concurrent ring reads are strictly ordered");
+    }
+
+    return g_failures;
+}
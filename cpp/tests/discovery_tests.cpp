@@ -0,0 +1,348 @@
+// Camera discovery probe statistics tests.
+//
+// Probe counters must count calls and distinct this pointers correctly
+// when hammered from several threads at once. The rate tracker turns
+// per-frame samples into coverage and calls-per-frame figures, and
+// winner selection must pick the per-frame camera update over utility
+// vfuncs that run too often, too rarely, or across many instances.
+// The vectorized float tests must agree with a scalar reference on every
+// lane, including NaN, infinities and values sitting on each threshold;
+// the classifier must find groups deep inside a 4 KB object, and the
+// snapshot diff and change heatmap must report exactly the floats that moved.
+// A saved discovery result must read back exactly for the same build and
+// be refused for another build or when truncated.
+
+#include "cameraunlock/discovery/discovery_result.h"
+#include "cameraunlock/discovery/float_classifier.h"
+#include "cameraunlock/discovery/probe_stats.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <iostream>
+#include <limits>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int g_failures = 0;
+
+void Check(bool cond, const char* name) {
+    if (cond) {
+        std::cout << "  [PASS] " << name << "\n";
+    } else {
+        std::cout << "  [FAIL] " << name << "\n";
+        ++g_failures;
+    }
+}
+
+void* FakeThis(uintptr_t id) {
+    return reinterpret_cast<void*>(0x10000 + id * 0x200);
+}
+
+uint16_t ReferenceMask(const float* f, size_t i, size_t count) {
+    using namespace cameraunlock::discovery;
+    const float v = f[i];
+    const float a = std::fabs(v);
+    uint16_t m = 0;
+    if (std::isfinite(v) && a < 1e10f) m |= kFloatPlausible;
+    if (std::isfinite(v) && a <= 360.0f) m |= kFloatAngleRange;
+    if (a < 360.0f) m |= kFloatBelow360;
+    if (a > 0.001f) m |= kFloatNonZero;
+    if (a > 0.001f && std::fabs(a - 1.0f) > 0.001f) m |= kFloatNonTrivial;
+    if (a > 0.5f) m |= kFloatAboveHalf;
+    if (a > 1.0f) m |= kFloatLarge;
+    if (a < 100000.0f) m |= kFloatWorldRange;
+    if (std::fabs(v - 1.0f) < 0.001f) m |= kFloatIsOne;
+    if (v >= 20.0f && v <= 150.0f) m |= kFloatFovRange;
+    if (i + 3 < count) {
+        const float len2 = f[i] * f[i] + f[i+1] * f[i+1] + f[i+2] * f[i+2] + f[i+3] * f[i+3];
+        if (std::fabs(len2 - 1.0f) < 0.01f) m |= kFloatUnitQuat;
+    }
+    return m;
+}
+
+bool HasGroup(const cameraunlock::discovery::LayoutReport& r, size_t offset,
+              cameraunlock::discovery::FloatClass type) {
+    for (int i = 0; i < r.group_count; ++i) {
+        if (r.groups[i].offset == offset && r.groups[i].type == type) return true;
+    }
+    return false;
+}
+
+} // namespace
+
+int RunDiscoveryTests() {
+    using namespace cameraunlock::discovery;
+
+    std::cout << "Discovery tests\n";
+
+    {
+        ProbeSlotCounters counters;
+        for (int i = 0; i < 10; ++i) counters.Record(FakeThis(1));
+        counters.Record(FakeThis(2));
+        counters.Record(FakeThis(1));
+        Check(counters.calls.load() == 12, "probe counter: counts every call");
+        Check(counters.GetInstanceCount() == 2, "probe counter: repeat this pointers counted once");
+        Check(counters.last_this.load() == reinterpret_cast<uintptr_t>(FakeThis(1)), "probe counter: tracks last this");
+
+        for (uintptr_t i = 0; i < 20; ++i) counters.Record(FakeThis(100 + i));
+        Check(counters.GetInstanceCount() == ProbeSlotCounters::kMaxInstances &&
+                  counters.instance_overflow.load() > 0,
+              "probe counter: instance set overflow flagged");
+
+        counters.Reset();
+        Check(counters.calls.load() == 0 && counters.GetInstanceCount() == 0 &&
+                  counters.instance_overflow.load() == 0,
+              "probe counter: reset clears everything");
+    }
+
+    {
+        ProbeSlotCounters counters[2];
+        const int kThreads = 4;
+        const int kCalls = 20000;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kThreads; ++t) {
+            threads.emplace_back([&counters, t]() {
+                for (int i = 0; i < kCalls; ++i) {
+                    counters[0].Record(FakeThis(static_cast<uintptr_t>(t)));
+                    counters[1].Record(FakeThis(static_cast<uintptr_t>(i % 2)));
+                }
+            });
+        }
+        for (auto& th : threads) th.join();
+        Check(counters[0].calls.load() == kThreads * kCalls && counters[1].calls.load() == kThreads * kCalls,
+              "probe counter: no lost increments across threads");
+        Check(counters[0].GetInstanceCount() == kThreads && counters[0].instance_overflow.load() == 0,
+              "probe counter: concurrent inserts keep instances distinct");
+        Check(counters[1].GetInstanceCount() == 2, "probe counter: racing identical inserts not duplicated");
+    }
+
+    {
+        // Slot 0: 1 call every frame. Slot 1: 3 calls on every other frame.
+        // Slot 2: never called.
+        ProbeSlotCounters counters[3];
+        ProbeRateTracker tracker;
+        tracker.Reset(3, 10);
+        for (int frame = 0; frame < 10; ++frame) {
+            counters[0].Record(FakeThis(1));
+            if (frame % 2 == 0) {
+                for (int i = 0; i < 3; ++i) counters[1].Record(FakeThis(2));
+            }
+            tracker.SampleFrame(counters);
+        }
+
+        const ProbeSlotSummary a = tracker.Summarize(0, counters[0]);
+        const ProbeSlotSummary b = tracker.Summarize(1, counters[1]);
+        const ProbeSlotSummary c = tracker.Summarize(2, counters[2]);
+        Check(tracker.GetFrameCount() == 10 && tracker.GetFrameCalls(1, 0) == 3 && tracker.GetFrameCalls(1, 1) == 0,
+              "rate tracker: per-frame deltas recorded");
+        Check(a.total_calls == 10 && a.active_frames == 10 && a.mean_per_active == 1.0f && a.Coverage() == 1.0f,
+              "rate tracker: steady per-frame slot");
+        Check(b.total_calls == 15 && b.active_frames == 5 && b.max_per_frame == 3 && b.mean_per_active == 3.0f &&
+                  b.mean_per_frame == 1.5f,
+              "rate tracker: bursty slot");
+        Check(c.total_calls == 0 && c.active_frames == 0 && c.Coverage() == 0.0f, "rate tracker: idle slot");
+    }
+
+    {
+        auto make = [](uint32_t calls, int active, int frames, int instances) {
+            ProbeSlotSummary s;
+            s.total_calls = calls;
+            s.frames = frames;
+            s.active_frames = active;
+            s.mean_per_frame = frames ? static_cast<float>(calls) / frames : 0.0f;
+            s.mean_per_active = active ? static_cast<float>(calls) / active : 0.0f;
+            s.instance_count = instances;
+            return s;
+        };
+
+        // Candidate 0 (slots 0-3): a hot utility vfunc and a rarely-called one
+        // Candidate 1 (slots 4-7): many-instance per-frame vfunc, camera update
+        ProbeSlotSummary summaries[8] = {};
+        summaries[0] = make(180 * 300, 180, 180, 1);
+        summaries[1] = make(40, 20, 180, 1);
+        summaries[4] = make(180 * 2, 180, 180, 30);
+        summaries[4].instance_overflow = true;
+        summaries[6] = make(180, 178, 180, 1);
+        summaries[7] = make(360, 180, 180, 1);
+        Check(SelectProbeWinner(summaries, 8, 4) == 6, "selection: per-frame single-instance vfunc wins");
+
+        summaries[2] = make(185, 180, 180, 1);
+        Check(SelectProbeWinner(summaries, 8, 4) == 2, "selection: first candidate class preferred");
+
+        ProbeSlotSummary fallback[4] = {};
+        fallback[0] = make(180 * 300, 180, 180, 1);
+        fallback[1] = make(60, 30, 180, 1);
+        Check(SelectProbeWinner(fallback, 4, 4) == 1, "selection: falls back to closest-to-per-frame slot");
+
+        ProbeSlotSummary idle[4] = {};
+        Check(SelectProbeWinner(idle, 4, 4) == -1, "selection: nothing called");
+    }
+
+    {
+        // Threshold edges, specials, and unit quaternions at every lane
+        // alignment, in a length that leaves a scalar tail
+        const float inf = std::numeric_limits<float>::infinity();
+        const float nan = std::numeric_limits<float>::quiet_NaN();
+        const float specials[] = {0.0f, -0.0f, 1.0f, -1.0f, 1.0005f, 0.9995f, 0.001f, 0.5f, 0.50001f,
+                                  20.0f, 19.999f, 150.0f, 150.01f, 360.0f, -360.0f, 359.99f, 1e10f,
+                                  9.9e9f, 100000.0f, 99999.0f, inf, -inf, nan, 0.7071068f, 45.0f};
+        std::vector<float> data(1003);
+        uint32_t state = 12345;
+        for (size_t i = 0; i < data.size(); ++i) {
+            state = state * 1664525u + 1013904223u;
+            if (state % 3 == 0) {
+                data[i] = specials[(state >> 8) % (sizeof(specials) / sizeof(specials[0]))];
+            } else {
+                data[i] = (static_cast<float>(state >> 8) / 16777216.0f - 0.5f) * 800.0f;
+            }
+        }
+        for (size_t q = 100; q < 140; q += 5) {
+            data[q] = 0.5f; data[q+1] = 0.5f; data[q+2] = -0.5f; data[q+3] = 0.5f;
+        }
+
+        std::vector<uint16_t> masks(data.size());
+        cameraunlock::discovery::ComputeFloatMasks(data.data(), data.size(), masks.data());
+        size_t mismatches = 0;
+        for (size_t i = 0; i < data.size(); ++i) {
+            if (masks[i] != ReferenceMask(data.data(), i, data.size())) ++mismatches;
+        }
+        Check(mismatches == 0, "float masks: vector lanes match scalar reference");
+        Check((masks[100] & kFloatUnitQuat) && (masks[105] & kFloatUnitQuat), "float masks: unit quaternions flagged");
+    }
+
+    {
+        // 4 KB camera object with every group past the old 512-byte limit
+        std::vector<float> object(1024, 0.0f);
+        const size_t posIndex = 300, quatIndex = 700, angleIndex = 900, fovIndex = 1000;
+        object[posIndex] = 1250.0f; object[posIndex+1] = -40.5f; object[posIndex+2] = 310.0f;
+        object[posIndex+3] = 1.0f;
+        object[quatIndex] = 0.0f; object[quatIndex+1] = 0.7071068f;
+        object[quatIndex+2] = 0.0f; object[quatIndex+3] = 0.7071068f;
+        object[angleIndex] = 0.0f; object[angleIndex+1] = 12.5f; object[angleIndex+2] = 271.0f;
+        object[fovIndex] = 90.0f;
+        // Out-of-range neighbours so no zero-padded window turns the
+        // angles or FOV into an earlier angle triple
+        for (size_t i : {angleIndex - 2, angleIndex - 1, fovIndex - 2, fovIndex - 1, fovIndex + 1, fovIndex + 2}) {
+            object[i] = 5000.0f;
+        }
+        object[500] = 1.0f; object[501] = 0.0f; object[502] = 0.0f;  // matrix row, not angles
+
+        const LayoutReport r = ClassifyMemoryRegion(object.data(), object.size() * sizeof(float));
+        Check(r.group_count == 4, "classifier: four groups in 4 KB object");
+        Check(HasGroup(r, posIndex * 4, FloatClass::Position), "classifier: position with w=1");
+        Check(HasGroup(r, quatIndex * 4, FloatClass::Quaternion), "classifier: quaternion");
+        Check(HasGroup(r, angleIndex * 4, FloatClass::Angle), "classifier: angle triple");
+        Check(HasGroup(r, fovIndex * 4, FloatClass::FOV), "classifier: FOV");
+    }
+
+    {
+        std::vector<float> before(1027, 3.0f);
+        std::vector<float> after = before;
+        after[0] = 4.0f;
+        after[7] = 2.0f;
+        after[8] = 10.0f;
+        after[500] += 0.01f;  // below threshold
+        after[1026] = -3.0f;
+
+        std::vector<FloatChange> changes;
+        const size_t n = DiffFloatSnapshots(before.data(), after.data(), before.size(), 0.1f, changes);
+        Check(n == 4 && changes.size() == 4, "snapshot diff: changed floats found");
+        Check(n == 4 && changes[0].index == 0 && changes[1].index == 7 && changes[2].index == 8 &&
+                  changes[3].index == 1026 && changes[3].before == 3.0f && changes[3].after == -3.0f,
+              "snapshot diff: indices and values in order");
+
+        changes.clear();
+        Check(DiffFloatSnapshots(before.data(), after.data(), before.size(), 0.0f, changes) == 5,
+              "snapshot diff: zero threshold sees every change");
+    }
+
+    {
+        FloatChangeHeatmap heatmap;
+        heatmap.Reset(64);
+        std::vector<float> frame(64, 1.0f);
+        for (int f = 0; f < 5; ++f) {
+            frame[10] = static_cast<float>(f);
+            if (f == 3) frame[20] = 2.0f;
+            heatmap.AddSnapshot(frame.data());
+        }
+        Check(heatmap.GetFrameCount() == 4, "heatmap: first snapshot primes only");
+        Check(heatmap.GetChangeCount(10) == 4 && heatmap.GetChangeFrequency(10) == 1.0f,
+              "heatmap: every-frame field is hot");
+        Check(heatmap.GetChangeCount(20) == 1 && heatmap.GetChangeCount(30) == 0 &&
+                  heatmap.GetChangeFrequency(20) == 0.25f,
+              "heatmap: one-off and static fields");
+        Check(heatmap.GetLatest() != nullptr && heatmap.GetLatest()[10] == 4.0f, "heatmap: keeps latest snapshot");
+    }
+
+    {
+        const char* path = "cameraunlock_test_discovery.txt";
+        std::remove(path);
+
+        cameraunlock::memory::ModuleIdentity id;
+        id.time_date_stamp = 0x5f3e2a10;
+        id.size_of_image = 0x02a4c000;
+        id.checksum = 0x02a51b3c;
+        id.header_hash = 0x9e3779b9;
+
+        DiscoveryResult saved;
+        saved.class_name = "CCustomCamera";
+        saved.vfunc_index = 5;
+        saved.vtable_rva = 0x01c2a4f8;
+        saved.vfunc_rva = 0x00734b20;
+        saved.offsets = {0x1c4, 0x1c0, 0x1bc, -1.0f, 1.0f, -1.0f, true};
+        saved.layout.group_count = 2;
+        saved.layout.groups[0] = {0x1bc, FloatClass::Angle, 3, {0.1f, -12.345678f, 187.25f, 0.0f}};
+        saved.layout.groups[1] = {0x200, FloatClass::FOV, 1, {70.0f, 0.0f, 0.0f, 0.0f}};
+
+        DiscoveryResult loaded;
+        Check(!LoadDiscoveryResult(path, id, loaded), "discovery result: missing file is a miss");
+        Check(SaveDiscoveryResult(path, id, saved), "discovery result: saved");
+        const bool ok = LoadDiscoveryResult(path, id, loaded);
+        Check(ok && loaded.class_name == saved.class_name && loaded.vfunc_index == 5 &&
+                  loaded.vtable_rva == saved.vtable_rva && loaded.vfunc_rva == saved.vfunc_rva,
+              "discovery result: winner reads back");
+        Check(ok && loaded.offsets.valid && loaded.offsets.yaw_offset == 0x1c4 && loaded.offsets.pitch_offset == 0x1c0 &&
+                  loaded.offsets.roll_offset == 0x1bc && loaded.offsets.yaw_sign == -1.0f &&
+                  loaded.offsets.pitch_sign == 1.0f && loaded.offsets.roll_sign == -1.0f,
+              "discovery result: offsets and signs read back");
+        Check(ok && loaded.layout.group_count == 2 && loaded.layout.groups[0].offset == 0x1bc &&
+                  loaded.layout.groups[0].type == FloatClass::Angle && loaded.layout.groups[0].count == 3 &&
+                  loaded.layout.groups[0].values[1] == -12.345678f && loaded.layout.groups[1].type == FloatClass::FOV &&
+                  loaded.layout.groups[1].values[0] == 70.0f,
+              "discovery result: layout reads back exactly");
+
+        cameraunlock::memory::ModuleIdentity patched = id;
+        patched.time_date_stamp++;
+        DiscoveryResult untouched;
+        Check(!LoadDiscoveryResult(path, patched, untouched) && untouched.class_name.empty(),
+              "discovery result: another build is refused");
+
+        // Drop the end line, as a crash mid-write would
+        std::string text;
+        {
+            std::ifstream in(path);
+            std::stringstream ss;
+            ss << in.rdbuf();
+            text = ss.str();
+        }
+        text.resize(text.rfind("end\n"));
+        {
+            std::ofstream out(path, std::ios::trunc);
+            out << text;
+        }
+        Check(!LoadDiscoveryResult(path, id, loaded), "discovery result: truncated file is refused");
+
+        DiscoveryResult invalid = saved;
+        invalid.offsets.valid = false;
+        Check(!SaveDiscoveryResult(path, id, invalid), "discovery result: invalid offsets are not saved");
+        std::remove(path);
+    }
+
+    return g_failures;
+}
@@ -0,0 +1,201 @@
+// Detour instrumentation tests.
+//
+// Every call through an instrumented detour must be counted, and one in
+// each sample interval timed. Self time has to leave out the trampoline
+// call and nested instrumented detours, but only once when a nested detour
+// runs inside the original. Counters hammered from several threads must
+// add up, and the report must rank hooks by self time and reset cleanly.
+
+#include "cameraunlock/hooks/detour_stats.h"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int g_failures = 0;
+
+void Check(bool cond, const char* name) {
+    if (cond) {
+        std::cout << "  [PASS] " << name << "\n";
+    } else {
+        std::cout << "  [FAIL] " << name << "\n";
+        ++g_failures;
+    }
+}
+
+using cameraunlock::hooks::CallOriginal;
+using cameraunlock::hooks::HookStats;
+using cameraunlock::hooks::InstrumentedDetour;
+
+void SpinUs(int us) {
+    const auto end = std::chrono::steady_clock::now() + std::chrono::microseconds(us);
+    while (std::chrono::steady_clock::now() < end) {
+    }
+}
+
+const HookStats* Find(const std::vector<HookStats>& report, const char* name) {
+    for (const auto& s : report) {
+        if (s.name == name) return &s;
+    }
+    return nullptr;
+}
+
+// Stand-ins for trampolines and detours
+int OriginalAdd(int a, int b) {
+    return a + b;
+}
+
+int CountedDetour(int a, int b) {
+    return CallOriginal(&OriginalAdd, a, b);
+}
+
+void SlowOriginal() {
+    SpinUs(2000);
+}
+
+void CheapDetour() {
+    CallOriginal(&SlowOriginal);
+}
+
+void InnerDetour() {
+    SpinUs(1000);
+}
+
+void OuterDetour() {
+    InstrumentedDetour<&InnerDetour>::Function();
+}
+
+void OriginalCallingInner() {
+    InstrumentedDetour<&InnerDetour>::Function();
+}
+
+void BusyOuterDetour() {
+    SpinUs(1000);
+    CallOriginal(&OriginalCallingInner);
+}
+
+void ThreadedDetour() {
+}
+
+} // anonymous namespace
+
+int RunHooksTests() {
+    using namespace cameraunlock::hooks;
+    std::cout << "\nHooks Tests\n";
+    std::cout << "-----------\n";
+
+    const uint32_t defaultInterval = GetDetourSampleInterval();
+    Check(defaultInterval > 1, "detour stats: sampling is on by default");
+
+    using Counted = InstrumentedDetour<&CountedDetour>;
+    RegisterDetourStats(Counted::Stats(), "counted", reinterpret_cast<void*>(&OriginalAdd));
+    {
+        SetDetourSampleInterval(1);
+        int sum = 0;
+        for (int i = 0; i < 100; ++i) sum += Counted::Function(i, 1);
+        Check(sum == 5050, "detour stats: wrapper forwards arguments and result");
+
+        DetourTotals t = Counted::Stats().GetTotals();
+        Check(t.calls == 100 && t.sampled_calls == 100, "detour stats: interval 1 times every call");
+
+        Counted::Stats().Reset();
+        SetDetourSampleInterval(4);
+        for (int i = 0; i < 100; ++i) Counted::Function(i, 1);
+        t = Counted::Stats().GetTotals();
+        Check(t.calls == 100 && t.sampled_calls == 25, "detour stats: interval 4 times one call in four");
+
+        Counted::Stats().Reset();
+        SetDetourSampleInterval(0);
+        for (int i = 0; i < 100; ++i) Counted::Function(i, 1);
+        t = Counted::Stats().GetTotals();
+        Check(t.calls == 100 && t.sampled_calls == 0 && t.total_ticks == 0,
+              "detour stats: interval 0 only counts calls");
+    }
+
+    SetDetourSampleInterval(1);
+    RegisterDetourStats(InstrumentedDetour<&CheapDetour>::Stats(), "cheap", nullptr);
+    RegisterDetourStats(InstrumentedDetour<&InnerDetour>::Stats(), "inner", nullptr);
+    RegisterDetourStats(InstrumentedDetour<&OuterDetour>::Stats(), "outer", nullptr);
+    RegisterDetourStats(InstrumentedDetour<&BusyOuterDetour>::Stats(), "busy outer", nullptr);
+    ResetDetourStats();
+    {
+        for (int i = 0; i < 5; ++i) InstrumentedDetour<&CheapDetour>::Function();
+        std::vector<HookStats> report = CollectDetourStats();
+        const HookStats* cheap = Find(report, "cheap");
+        Check(cheap && cheap->calls == 5 && cheap->mean_total_us >= 1900.0,
+              "detour stats: total time includes the original");
+        Check(cheap && cheap->mean_self_us < cheap->mean_total_us * 0.25,
+              "detour stats: self time leaves out the original");
+    }
+
+    ResetDetourStats();
+    {
+        for (int i = 0; i < 5; ++i) InstrumentedDetour<&OuterDetour>::Function();
+        std::vector<HookStats> report = CollectDetourStats();
+        const HookStats* outer = Find(report, "outer");
+        const HookStats* inner = Find(report, "inner");
+        Check(inner && inner->calls == 5 && inner->mean_self_us >= 900.0,
+              "detour stats: nested detour keeps its own time");
+        Check(outer && inner && outer->mean_total_us >= inner->mean_total_us &&
+                  outer->mean_self_us < inner->mean_self_us * 0.25,
+              "detour stats: nested detour is left out of its parent's self time");
+        Check(!report.empty() && report.front().name == "inner", "detour stats: report ranks by self time");
+    }
+
+    ResetDetourStats();
+    {
+        for (int i = 0; i < 5; ++i) InstrumentedDetour<&BusyOuterDetour>::Function();
+        std::vector<HookStats> report = CollectDetourStats();
+        const HookStats* outer = Find(report, "busy outer");
+        const HookStats* inner = Find(report, "inner");
+        Check(inner && inner->calls == 5, "detour stats: detour inside the original is counted");
+        Check(outer && outer->mean_self_us >= 900.0 && outer->mean_total_us >= 1900.0,
+              "detour stats: detour inside the original is subtracted once");
+    }
+
+    ResetDetourStats();
+    {
+        std::vector<HookStats> report = CollectDetourStats();
+        const HookStats* inner = Find(report, "inner");
+        Check(inner && inner->calls == 0 && inner->self_us == 0.0, "detour stats: reset zeroes the counters");
+    }
+
+    using Threaded = InstrumentedDetour<&ThreadedDetour>;
+    RegisterDetourStats(Threaded::Stats(), "threaded", nullptr);
+    {
+        SetDetourSampleInterval(8);
+        constexpr int kThreads = 4;
+        constexpr int kCalls = 20000;
+        std::vector<std::thread> threads;
+        for (int i = 0; i < kThreads; ++i) {
+            threads.emplace_back([] {
+                for (int c = 0; c < kCalls; ++c) Threaded::Function();
+            });
+        }
+        for (auto& t : threads) t.join();
+        const DetourTotals t = Threaded::Stats().GetTotals();
+        Check(t.calls == static_cast<uint64_t>(kThreads) * kCalls,
+              "detour stats: calls from several threads add up");
+        Check(t.sampled_calls == static_cast<uint64_t>(kThreads) * kCalls / 8,
+              "detour stats: each thread samples on its own count");
+    }
+
+    {
+        RegisterDetourStats(Threaded::Stats(), "renamed", nullptr);
+        std::vector<HookStats> report = CollectDetourStats();
+        Check(Find(report, "renamed") && !Find(report, "threaded"), "detour stats: registering again renames");
+
+        const std::string table = FormatHookStats(report);
+        Check(table.find("renamed") != std::string::npos && table.find("counted") != std::string::npos &&
+                  table.find("self %") != std::string::npos,
+              "detour stats: table lists every hook");
+    }
+
+    SetDetourSampleInterval(defaultInterval);
+    return g_failures;
+}
@@ -0,0 +1,119 @@
+// Hotkey poller tests.
+//
+// Key events are fed through ProcessKeyEvent, the same path the keyboard
+// hook uses, so binding resolution is exercised without a Windows keyboard:
+// callbacks fire once per down edge, chords need their modifiers held, the
+// most specific chord on a key wins, and registration changes made from
+// another thread reach the reader without it taking a lock.
+
+#include "cameraunlock/input/hotkey_poller.h"
+
+#include <atomic>
+#include <iostream>
+#include <thread>
+
+namespace {
+
+int g_failures = 0;
+
+void Check(bool cond, const char* name) {
+    if (cond) {
+        std::cout << "  [PASS] " << name << "\n";
+    } else {
+        std::cout << "  [FAIL] " << name << "\n";
+        ++g_failures;
+    }
+}
+
+// Sided codes, as the low-level hook reports them
+constexpr int kLeftCtrl = 0xA2;
+constexpr int kRightShift = 0xA1;
+
+void Tap(cameraunlock::input::HotkeyPoller& poller, int vkCode) {
+    poller.ProcessKeyEvent(vkCode, true);
+    poller.ProcessKeyEvent(vkCode, false);
+}
+
+}  // namespace
+
+int RunInputTests() {
+    using cameraunlock::input::HotkeyPoller;
+    namespace Modifier = cameraunlock::input::Modifier;
+    namespace VK = cameraunlock::input::VK;
+
+    std::cout << "Input tests\n";
+
+    {
+        HotkeyPoller poller;
+        int toggles = 0;
+        int recenters = 0;
+        poller.SetToggleKey(VK::F10, [&] { ++toggles; });
+        poller.SetRecenterKey(VK::Home, [&] { ++recenters; });
+
+        poller.ProcessKeyEvent(VK::F10, true);
+        poller.ProcessKeyEvent(VK::F10, true);  // auto-repeat
+        Check(toggles == 1, "hotkey fires once per down edge");
+        poller.ProcessKeyEvent(VK::F10, false);
+        Tap(poller, VK::F10);
+        Check(toggles == 2 && recenters == 0, "release re-arms the key");
+
+        poller.SetRecenterKeyCode(VK::End);
+        Tap(poller, VK::Home);
+        Tap(poller, VK::End);
+        Check(recenters == 1 && poller.GetRecenterKeyCode() == VK::End, "rebinding takes effect");
+    }
+
+    {
+        HotkeyPoller poller;
+        int plain = 0;
+        int ctrl = 0;
+        int ctrlShift = 0;
+        poller.AddHotkey(VK::F5, [&] { ++plain; });
+        poller.AddHotkey(VK::F5, [&] { ++ctrl; }, Modifier::Ctrl);
+        const int id = poller.AddHotkey(VK::F5, [&] { ++ctrlShift; }, Modifier::Ctrl | Modifier::Shift);
+
+        Tap(poller, VK::F5);
+        Check(plain == 1 && ctrl == 0 && ctrlShift == 0, "chord needs its modifiers held");
+
+        poller.ProcessKeyEvent(kLeftCtrl, true);
+        Tap(poller, VK::F5);
+        Check(plain == 1 && ctrl == 1 && ctrlShift == 0, "most specific chord wins");
+
+        poller.ProcessKeyEvent(kRightShift, true);
+        Tap(poller, VK::F5);
+        Check(ctrl == 1 && ctrlShift == 1, "either side of a modifier counts");
+
+        poller.RemoveHotkey(id);
+        Tap(poller, VK::F5);
+        Check(ctrl == 2 && ctrlShift == 1, "removed chord falls back to the next match");
+
+        poller.ProcessKeyEvent(kLeftCtrl, false);
+        poller.ProcessKeyEvent(kRightShift, false);
+        Tap(poller, VK::F5);
+        Check(plain == 2, "released modifiers stop matching");
+    }
+
+    {
+        // Registration churn on one thread while another feeds events
+        HotkeyPoller poller;
+        std::atomic<int> fired{0};
+        poller.AddHotkey(VK::F1, [&] { fired.fetch_add(1); });
+        std::atomic<bool> done{false};
+        std::thread writer([&] {
+            for (int i = 0; i < 2000; ++i) {
+                const int id = poller.AddHotkey(VK::F2, [] {});
+                poller.RemoveHotkey(id);
+            }
+            done.store(true);
+        });
+        int taps = 0;
+        while (!done.load() || taps < 100) {
+            Tap(poller, VK::F1);
+            ++taps;
+        }
+        writer.join();
+        Check(fired.load() == taps, "events are delivered during registration changes");
+    }
+
+    return g_failures;
+}
@@ -1 +1,148 @@
-// Math utility tests - placeholder
+// Math utility tests.
+//
+// Checks the math::fast kernels against the std:: functions over their
+// documented domains, so the error bound in fast_math.h stays true, and
+// pins the Quat4 operations (SIMD or scalar, whichever is built) to a
+// plain scalar reference.
+
+#include "cameraunlock/math/fast_math.h"
+#include "cameraunlock/math/quat4.h"
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+
+namespace {
+
+int g_failures = 0;
+
+void Check(bool cond, const char* name) {
+    if (cond) {
+        std::cout << "  [PASS] " << name << "\n";
+    } else {
+        std::cout << "  [FAIL] " << name << "\n";
+        ++g_failures;
+    }
+}
+
+using cameraunlock::math::Quat4;
+using cameraunlock::math::Vec3;
+
+// Scalar reference versions of the Quat4 operations with SIMD paths.
+Quat4 RefMultiply(const Quat4& a, const Quat4& b) {
+    return Quat4(
+        a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+        a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+        a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+        a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z);
+}
+
+Vec3 RefRotate(const Quat4& q, const Vec3& v) {
+    Quat4 p = RefMultiply(RefMultiply(q, Quat4(v.x, v.y, v.z, 0.0f)), q.Inverse());
+    return Vec3(p.x, p.y, p.z);
+}
+
+float MaxDiff(const Quat4& a, const Quat4& b) {
+    return std::fmax(std::fmax(std::fabs(a.x - b.x), std::fabs(a.y - b.y)),
+                     std::fmax(std::fabs(a.z - b.z), std::fabs(a.w - b.w)));
+}
+
+// Deterministic pseudo-random numbers in [-1, 1]
+float NextUnit(uint32_t& state) {
+    state = state * 1664525u + 1013904223u;
+    return static_cast<float>(state >> 8) / 8388608.0f - 1.0f;
+}
+
+}  // namespace
+
+int RunMathTests() {
+    namespace fast = cameraunlock::math::fast;
+
+    std::cout << "\nMath tests:\n";
+
+    // SinCos over head-tracking angles and well beyond
+    {
+        double worst = 0.0;
+        for (int i = -1000000; i <= 1000000; ++i) {
+            float x = static_cast<float>(i) * 0.001f;  // +-1000 rad
+            float s, c;
+            fast::SinCos(x, s, c);
+            double es = std::fabs(static_cast<double>(s) - std::sin(static_cast<double>(x)));
+            double ec = std::fabs(static_cast<double>(c) - std::cos(static_cast<double>(x)));
+            if (es > worst) worst = es;
+            if (ec > worst) worst = ec;
+        }
+        Check(worst < 1e-7, "fast::SinCos max error < 1e-7");
+    }
+
+    // Exp over the smoothing range (relative error)
+    {
+        double worst = 0.0;
+        for (int i = -86999; i < 88000; ++i) {
+            float x = static_cast<float>(i) * 0.001f;
+            double ref = std::exp(static_cast<double>(x));
+            double err = std::fabs(static_cast<double>(fast::Exp(x)) - ref) / ref;
+            if (err > worst) worst = err;
+        }
+        Check(worst < 1e-7, "fast::Exp max relative error < 1e-7");
+    }
+
+    // Acos over [-1, 1]
+    {
+        double worst = 0.0;
+        for (int i = -100000; i <= 100000; ++i) {
+            float x = static_cast<float>(i) * 1e-5f;
+            double err = std::fabs(static_cast<double>(fast::Acos(x)) - std::acos(static_cast<double>(x)));
+            if (err > worst) worst = err;
+        }
+        Check(worst < 5e-7, "fast::Acos max error < 5e-7");
+        Check(fast::Acos(1.5f) == 0.0f, "fast::Acos clamps input");
+    }
+
+    // Slerp stays continuous across the nlerp threshold
+    {
+        Quat4 a = Quat4::Identity();
+        Quat4 b = Quat4::FromYawPitchRoll(3.6f, 0.0f, 0.0f);  // dot just above threshold
+        Quat4 c = Quat4::FromYawPitchRoll(3.7f, 0.0f, 0.0f);  // just below
+        float yb, pb, rb, yc, pc, rc;
+        Quat4::Slerp(a, b, 0.25f).ToEulerYXZ(yb, pb, rb);
+        Quat4::Slerp(a, c, 0.25f).ToEulerYXZ(yc, pc, rc);
+        Check(std::fabs(yb - 0.9f) < 1e-4f && std::fabs(yc - 0.925f) < 1e-4f,
+              "Slerp/nlerp agree within 1e-4 deg around threshold");
+    }
+
+    // Quat4 operations match the scalar reference
+    {
+#if defined(CAMERAUNLOCK_SIMD_SSE)
+        std::cout << "  (Quat4 backend: SSE2)\n";
+#elif defined(CAMERAUNLOCK_SIMD_NEON)
+        std::cout << "  (Quat4 backend: NEON)\n";
+#else
+        std::cout << "  (Quat4 backend: scalar)\n";
+#endif
+        Check(sizeof(Quat4) == 16 && alignof(Quat4) == 16, "Quat4: 16 bytes, 16-byte aligned");
+
+        uint32_t rng = 12345u;
+        float mulErr = 0.0f, rotErr = 0.0f, normErr = 0.0f, dotErr = 0.0f;
+        for (int i = 0; i < 10000; ++i) {
+            Quat4 a = Quat4(NextUnit(rng), NextUnit(rng), NextUnit(rng), NextUnit(rng)).Normalized();
+            Quat4 b = Quat4(NextUnit(rng), NextUnit(rng), NextUnit(rng), NextUnit(rng)).Normalized();
+            Vec3 v(NextUnit(rng) * 2.0f, NextUnit(rng) * 2.0f, NextUnit(rng) * 2.0f);
+
+            mulErr = std::fmax(mulErr, MaxDiff(a * b, RefMultiply(a, b)));
+            rotErr = std::fmax(rotErr, (a.Rotate(v) - RefRotate(a, v)).Magnitude());
+
+            Quat4 raw(a.x * 3.0f, a.y * 3.0f, a.z * 3.0f, a.w * 3.0f);
+            normErr = std::fmax(normErr, MaxDiff(raw.Normalized(), a));
+
+            float ref = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+            dotErr = std::fmax(dotErr, std::fabs(a.Dot(b) - ref));
+        }
+        Check(mulErr < 1e-6f, "Quat4::Multiply matches scalar reference");
+        Check(rotErr < 1e-5f, "Quat4::Rotate matches scalar reference");
+        Check(normErr < 1e-6f, "Quat4::Normalized matches scalar reference");
+        Check(dotErr < 1e-6f, "Quat4::Dot matches scalar reference");
+    }
+
+    return g_failures;
+}
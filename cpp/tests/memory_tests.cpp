@@ -0,0 +1,469 @@
+// Memory scanning tests.
+//
+// The vectorized scanner must agree with a plain byte-by-byte reference
+// for every placement, including matches that straddle vector blocks and
+// land in the scalar tail at the very end of the range. The batch scanner
+// must report the same first match and count as scanning one at a time.
+// Section-aware scans run against a synthetic PE image built in memory,
+// and chunked parallel scans must return the same lowest match as a
+// serial scan regardless of thread count. The signature cache is driven
+// through cold, warm, stale-entry and rebuilt-module launches. Pattern
+// literals are checked at compile time and must scan like their strings.
+// The RTTI index is built over a synthetic image with hand-laid type
+// descriptors, COLs and vtables, including decoys it must reject.
+
+#include "cameraunlock/memory/pattern_literal.h"
+#include "cameraunlock/memory/pattern_scanner.h"
+#include "cameraunlock/memory/rtti_index.h"
+#include "cameraunlock/memory/signature_cache.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+int g_failures = 0;
+
+using cameraunlock::memory::CountPatternBytes;
+
+static_assert(CountPatternBytes("48 8B 05 ?? ?? ?? ??") == 7, "wildcards count as bytes");
+static_assert(CountPatternBytes("488B ? E8") == 4, "adjacent pairs and single ? accepted");
+static_assert(CountPatternBytes("48 8") == 0 && CountPatternBytes("4G") == 0 && CountPatternBytes("") == 0,
+              "malformed patterns rejected");
+
+constexpr auto kLiteral = CU_PATTERN("48 8B 05 ?? ?? ?? ?? 48 85 C0 74 1F");
+static_assert(kLiteral.kLength == 12 && kLiteral.bytes[1] == 0x8B && kLiteral.care[3] == 0 &&
+                  kLiteral.care[11] == 0xFF,
+              "literal bytes and mask built at compile time");
+static_assert(kLiteral.has_anchor && kLiteral.bytes[kLiteral.anchor] == 0x05, "anchor precomputed");
+
+void Check(bool cond, const char* name) {
+    if (cond) {
+        std::cout << "  [PASS] " << name << "\n";
+    } else {
+        std::cout << "  [FAIL] " << name << "\n";
+        ++g_failures;
+    }
+}
+
+const uint8_t* ReferenceScan(const std::vector<uint8_t>& data, const uint8_t* pattern, const char* mask, size_t length) {
+    if (length > data.size()) return nullptr;
+    for (size_t i = 0; i + length <= data.size(); ++i) {
+        bool match = true;
+        for (size_t j = 0; j < length && match; ++j) {
+            if (mask[j] == 'x' && data[i + j] != pattern[j]) match = false;
+        }
+        if (match) return data.data() + i;
+    }
+    return nullptr;
+}
+
+// Deterministic code-like filler: lots of 0x00/0x48/0x8B so the anchor
+// search has plenty of near-misses to reject
+std::vector<uint8_t> MakeImage(size_t size, uint32_t seed) {
+    static const uint8_t kCommon[] = {0x00, 0x48, 0x8B, 0x89, 0xCC, 0x05, 0x0D, 0xE8};
+    std::vector<uint8_t> data(size);
+    uint32_t state = seed;
+    for (size_t i = 0; i < size; ++i) {
+        state = state * 1664525u + 1013904223u;
+        data[i] = kCommon[(state >> 24) % sizeof(kCommon)];
+    }
+    return data;
+}
+
+template <typename T>
+void Put(std::vector<uint8_t>& image, size_t offset, T value) {
+    std::memcpy(image.data() + offset, &value, sizeof(T));
+}
+
+struct TestSection {
+    const char* name;
+    uint32_t rva;
+    uint32_t size;
+    uint32_t characteristics;
+};
+
+// Minimal mapped PE32+ image: DOS header, NT headers, section table
+std::vector<uint8_t> MakePeImage(size_t imageSize, const TestSection* sections, uint16_t count) {
+    std::vector<uint8_t> image(imageSize, 0);
+    const size_t lfanew = 0x80;
+    const uint16_t optionalSize = 240;
+    Put<uint16_t>(image, 0, 0x5A4D);
+    Put<uint32_t>(image, 0x3C, static_cast<uint32_t>(lfanew));
+    Put<uint32_t>(image, lfanew, 0x00004550);
+    Put<uint16_t>(image, lfanew + 4, 0x8664);
+    Put<uint16_t>(image, lfanew + 6, count);
+    Put<uint16_t>(image, lfanew + 20, optionalSize);
+    Put<uint32_t>(image, lfanew + 8, 0x5F3A1C00);              // TimeDateStamp
+    Put<uint16_t>(image, lfanew + 24, 0x20B);
+    Put<uint32_t>(image, lfanew + 24 + 56, static_cast<uint32_t>(imageSize));  // SizeOfImage
+    Put<uint32_t>(image, lfanew + 24 + 60, 0x400);             // SizeOfHeaders
+    const size_t table = lfanew + 24 + optionalSize;
+    for (uint16_t i = 0; i < count; ++i) {
+        const size_t header = table + i * 40u;
+        std::memcpy(image.data() + header, sections[i].name, std::strlen(sections[i].name));
+        Put<uint32_t>(image, header + 8, sections[i].size);
+        Put<uint32_t>(image, header + 12, sections[i].rva);
+        Put<uint32_t>(image, header + 16, sections[i].size);
+        Put<uint32_t>(image, header + 36, sections[i].characteristics);
+    }
+    return image;
+}
+
+void PutBytes(std::vector<uint8_t>& image, size_t offset, const void* bytes, size_t length) {
+    std::memcpy(image.data() + offset, bytes, length);
+}
+
+}  // namespace
+
+int RunMemoryTests() {
+    using namespace cameraunlock::memory;
+
+    std::cout << "Memory tests\n";
+
+    {
+        std::vector<uint8_t> data = MakeImage(4096, 1);
+        const uint8_t sig[] = {0x48, 0x8B, 0x05, 0x11, 0x22, 0x33, 0x44, 0xE8};
+        for (size_t j = 0; j < sizeof(sig); ++j) data[1000 + j] = sig[j];
+        const auto base = reinterpret_cast<uintptr_t>(data.data());
+
+        void* hit = ScanPatternInRange(base, data.size(), "48 8B 05 ?? ?? ?? ?? E8");
+        const uint8_t mask_pattern[] = {0x48, 0x8B, 0x05, 0, 0, 0, 0, 0xE8};
+        const uint8_t* expected = ReferenceScan(data, mask_pattern, "xxx????x", sizeof(mask_pattern));
+        Check(hit != nullptr && hit == expected, "String pattern finds first match");
+        Check(hit == ScanPatternMaskInRange(base, data.size(), mask_pattern, "xxx????x", sizeof(mask_pattern)),
+              "String and mask forms agree");
+        Check(ScanPatternInRange(base, data.size(), "48 8B 05 11 22 33 45") == nullptr,
+              "Absent pattern returns nullptr");
+        Check(ScanPatternInRange(base, data.size(), "48 8B 0") == nullptr, "Malformed pattern rejected");
+        Check(ScanPatternInRange(base, data.size(), "?? ??") == data.data(), "All-wildcard pattern matches start");
+    }
+
+    {
+        // Every placement near block boundaries and the end of the range
+        bool allAgree = true;
+        const uint8_t pattern[] = {0xD1, 0x48, 0x00, 0x7A, 0x8B, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00,
+                                   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x9E};
+        const char mask[] = "xx?xx????????????xx";
+        for (size_t size : {19u, 20u, 31u, 33u, 64u, 95u, 257u}) {
+            for (size_t pos = 0; pos + sizeof(pattern) <= size; ++pos) {
+                std::vector<uint8_t> data = MakeImage(size, static_cast<uint32_t>(size * 31 + pos));
+                for (size_t j = 0; j < sizeof(pattern); ++j) {
+                    if (mask[j] == 'x') data[pos + j] = pattern[j];
+                }
+                const void* hit = ScanPatternMaskInRange(reinterpret_cast<uintptr_t>(data.data()), data.size(),
+                                                         pattern, mask, sizeof(pattern));
+                if (hit != ReferenceScan(data, pattern, mask, sizeof(pattern))) allAgree = false;
+            }
+        }
+        Check(allAgree, "Scanner matches reference at every placement");
+    }
+
+    {
+        // Anchors made of common bytes only: many candidates, first must win
+        std::vector<uint8_t> data = MakeImage(1 << 16, 7);
+        const uint8_t pattern[] = {0x48, 0x8B, 0x00, 0x48};
+        const void* hit = ScanPatternMaskInRange(reinterpret_cast<uintptr_t>(data.data()), data.size(),
+                                                 pattern, "xxxx", sizeof(pattern));
+        Check(hit == ReferenceScan(data, pattern, "xxxx", sizeof(pattern)), "Common-byte pattern finds first match");
+
+        const uint8_t tooLong[] = {0x48, 0x8B};
+        Check(ScanPatternMaskInRange(reinterpret_cast<uintptr_t>(data.data()), 1, tooLong, "xx", 2) == nullptr,
+              "Pattern longer than range returns nullptr");
+    }
+
+    {
+        std::vector<uint8_t> data = MakeImage(100000, 3);
+        const uint8_t sigA[] = {0x48, 0x8B, 0x05, 0x71, 0x62};
+        const uint8_t sigB[] = {0x40, 0x53, 0x48, 0x83, 0xEC, 0x20};
+        for (size_t j = 0; j < sizeof(sigA); ++j) data[5000 + j] = sigA[j];
+        for (size_t at : {777u, 40001u, 99990u}) {
+            for (size_t j = 0; j < sizeof(sigB); ++j) data[at + j] = sigB[j];
+        }
+        const auto base = reinterpret_cast<uintptr_t>(data.data());
+
+        PatternBatch batch;
+        const int a = batch.Add("48 8B 05 ?? 62");
+        const int b = batch.Add("40 53 48 83 EC 20");
+        const int missing = batch.Add("DE AD BE EF");
+        const int common = batch.Add("48 8B");
+        Check(batch.Add("?? ??") == -1 && batch.Add("4") == -1, "Batch rejects unusable patterns");
+        Check(batch.GetPatternCount() == 4, "Batch keeps valid patterns");
+
+        batch.ScanRange(base, data.size(), true);
+        Check(batch.GetFirstMatch(a) == data.data() + 5000 && batch.GetMatchCount(a) == 1,
+              "Batch finds unique signature");
+        Check(batch.GetFirstMatch(b) == data.data() + 777 && batch.GetMatchCount(b) == 3,
+              "Batch reports ambiguous signature count");
+        Check(batch.GetMatches(b).size() == 3 && batch.GetMatches(b)[2] == data.data() + 99990,
+              "Batch collects all matches in order");
+        Check(batch.GetFirstMatch(missing) == nullptr && batch.GetMatchCount(missing) == 0,
+              "Batch reports missing signature");
+
+        size_t refCount = 0;
+        for (size_t i = 0; i + 1 < data.size(); ++i) {
+            if (data[i] == 0x48 && data[i + 1] == 0x8B) ++refCount;
+        }
+        Check(batch.GetFirstMatch(common) == ScanPatternInRange(base, data.size(), "48 8B") &&
+                  batch.GetMatchCount(common) == refCount,
+              "Batch matches single scans for common pattern");
+
+        batch.ScanRange(base, data.size());
+        Check(batch.GetMatches(b).empty() && batch.GetMatchCount(b) == 3, "Rescan without collect_all keeps counts only");
+        Check(batch.GetMatchCount(99) == 0 && batch.GetFirstMatch(99) == nullptr, "Out-of-range index is empty");
+    }
+
+    {
+        // Sections listed out of order to check the parser sorts them
+        const TestSection layout[] = {
+            {".data", 0x4000, 0x1800, kSectionInitializedData | kSectionRead | kSectionWrite},
+            {".text", 0x1000, 0x2000, kSectionCode | kSectionExecute | kSectionRead},
+            {".rdata", 0x3000, 0x1000, kSectionInitializedData | kSectionRead},
+        };
+        std::vector<uint8_t> image = MakePeImage(0x6000, layout, 3);
+        const auto base = reinterpret_cast<uintptr_t>(image.data());
+
+        std::vector<ModuleSection> sections;
+        const bool parsed = GetImageSections(base, image.size(), sections);
+        Check(parsed && sections.size() == 3 && std::strcmp(sections[0].name, ".text") == 0 &&
+                  sections[0].base == base + 0x1000 && sections[2].size == 0x1800,
+              "PE section table parsed in address order");
+
+        const uint8_t sig[] = {0x40, 0x53, 0x48, 0x83, 0xEC, 0x20};
+        PutBytes(image, 0x400, sig, sizeof(sig));   // header slack
+        PutBytes(image, 0x1F00, sig, sizeof(sig));  // .text
+        PutBytes(image, 0x3100, sig, sizeof(sig));  // .rdata
+        Check(ScanImageSections(base, image.size(), SectionFilter::Executable(), "40 53 48 83 EC 20") ==
+                  image.data() + 0x1F00,
+              "Executable filter skips headers");
+        Check(ScanImageSections(base, image.size(), SectionFilter::Named(".rdata"), "40 53 ?? 83") ==
+                  image.data() + 0x3100,
+              "Named section filter");
+        Check(ScanImageSections(base, image.size(), SectionFilter::Named(".data"), "40 53 48 83") == nullptr,
+              "Filtered scan misses other sections");
+        ParallelScanOptions split;
+        split.max_threads = 2;
+        split.chunk_size = 4096;
+        split.min_parallel_size = 0;
+        Check(ScanImageSectionsParallel(base, image.size(), SectionFilter::Executable(), "40 53 48 83 EC 20", split) ==
+                  image.data() + 0x1F00,
+              "Opt-in parallel section scan agrees");
+        Check(SectionMatches(sections[1], SectionFilter::ReadOnlyData()) &&
+                  !SectionMatches(sections[2], SectionFilter::ReadOnlyData()),
+              "Read-only filter excludes writable data");
+
+        const char name[] = ".?AVGuiCrosshairData@@";
+        PutBytes(image, 0x1800, name, sizeof(name));  // string literal copy in code
+        PutBytes(image, 0x4230, name, sizeof(name));  // type descriptor name
+        Check(FindRTTIDescriptorInImage(base, image.size(), name) == image.data() + 0x4220,
+              "RTTI lookup limited to data sections");
+
+        std::vector<uint8_t> bogus = MakeImage(4096, 9);
+        Check(!GetImageSections(reinterpret_cast<uintptr_t>(bogus.data()), bogus.size(), sections) && sections.empty(),
+              "Non-PE range rejected");
+        Put<uint16_t>(image, 0x80 + 6, 0xFFFF);
+        Check(!GetImageSections(base, image.size(), sections), "Truncated section table rejected");
+    }
+
+    {
+        std::vector<uint8_t> data = MakeImage(3u << 20, 11);
+        const uint8_t sig[] = {0x4C, 0x8D, 0x3D, 0x55, 0x66, 0x77, 0x88, 0xC3};
+        CompiledPattern compiled;
+        CompilePattern("4C 8D 3D ?? 66 77 88 C3", compiled);
+        const auto base = reinterpret_cast<uintptr_t>(data.data());
+
+        ParallelScanOptions options;
+        options.max_threads = 4;
+        options.chunk_size = 64u << 10;
+        options.min_parallel_size = 0;
+
+        // Matches in late chunks plus one straddling a chunk boundary:
+        // the straddling one is lowest and must win every time
+        bool agree = true;
+        for (size_t at : {(3u << 20) - 8u, 2000000u, (20u << 16) - 3u}) {
+            PutBytes(data, at, sig, sizeof(sig));
+            for (int run = 0; run < 8; ++run) {
+                if (ScanCompiledParallel(base, data.size(), compiled, options) !=
+                    ScanCompiledInRange(base, data.size(), compiled)) {
+                    agree = false;
+                }
+            }
+        }
+        Check(agree && ScanCompiledParallel(base, data.size(), compiled, options) == data.data() + (20u << 16) - 3u,
+              "Parallel scan returns lowest match");
+
+        std::vector<uint8_t> clean = MakeImage(1u << 20, 12);
+        Check(ScanCompiledParallel(reinterpret_cast<uintptr_t>(clean.data()), clean.size(), compiled, options) == nullptr,
+              "Parallel scan reports miss");
+    }
+
+    {
+        const TestSection layout[] = {
+            {".text", 0x1000, 0x2000, kSectionCode | kSectionExecute | kSectionRead},
+            {".data", 0x3000, 0x1000, kSectionInitializedData | kSectionRead | kSectionWrite},
+        };
+        std::vector<uint8_t> image = MakePeImage(0x4000, layout, 2);
+        const auto base = reinterpret_cast<uintptr_t>(image.data());
+        const uint8_t sig[] = {0x48, 0x8B, 0x0D, 0x10, 0x20, 0x30, 0x40, 0xE8};
+        const char* pattern = "48 8B 0D ?? ?? ?? ?? E8";
+        const char name[] = ".?AVCCustomCamera@@";
+        PutBytes(image, 0x1200, sig, sizeof(sig));
+        PutBytes(image, 0x3050, name, sizeof(name));
+        const char* path = "cameraunlock_test_sigcache.txt";
+        std::remove(path);
+
+        SignatureCache cold;
+        const bool bound = cold.OpenImage(path, base, image.size());
+        void* hit = cold.ScanPattern(pattern);
+        void* td = cold.FindRTTIDescriptor(name);
+        Check(bound && !cold.WasLoaded() && hit == image.data() + 0x1200 && td == image.data() + 0x3040 &&
+                  cold.GetMissCount() == 2 && cold.GetHitCount() == 0,
+              "Cold cache resolves by scanning");
+        Check(cold.Save(), "Cache file written");
+
+        SignatureCache warm;
+        warm.OpenImage(path, base, image.size());
+        Check(warm.WasLoaded() && warm.GetEntryCount() == 2 && warm.ScanPattern(pattern) == hit &&
+                  warm.FindRTTIDescriptor(name) == td && warm.GetHitCount() == 2 && warm.GetMissCount() == 0,
+              "Warm cache answers without scanning");
+
+        // Signature moved without a header change: entry fails re-validation
+        std::memset(image.data() + 0x1200, 0x90, sizeof(sig));
+        PutBytes(image, 0x1800, sig, sizeof(sig));
+        Check(warm.ScanPattern(pattern) == image.data() + 0x1800 && warm.GetMissCount() == 1,
+              "Stale entry is rescanned");
+        warm.Save();
+
+        SignatureCache reread;
+        reread.OpenImage(path, base, image.size());
+        Check(reread.ScanPattern(pattern) == image.data() + 0x1800 && reread.GetHitCount() == 1,
+              "Corrected entry persisted");
+
+        // ASLR relocation: the loader rewrites ImageBase, nothing else changes
+        ModuleIdentity before;
+        ModuleIdentity after;
+        Put<uint64_t>(image, 0x80 + 24 + 24, 0x140000000ull);
+        GetImageIdentity(base, image.size(), before);
+        Put<uint64_t>(image, 0x80 + 24 + 24, 0x7FF6A2B40000ull);
+        GetImageIdentity(base, image.size(), after);
+        Check(before == after && before.header_hash != 0, "Identity ignores relocated ImageBase");
+
+        // PE32 keeps ImageBase at +28; +24 is BaseOfData and still counts
+        Put<uint16_t>(image, 0x80 + 24, 0x10B);
+        GetImageIdentity(base, image.size(), before);
+        Put<uint32_t>(image, 0x80 + 24 + 28, 0x00400000u);
+        GetImageIdentity(base, image.size(), after);
+        ModuleIdentity baseOfData;
+        Put<uint32_t>(image, 0x80 + 24 + 24, 0x2000u);
+        GetImageIdentity(base, image.size(), baseOfData);
+        Check(before == after && baseOfData != after, "PE32 identity ignores only ImageBase");
+        Put<uint16_t>(image, 0x80 + 24, 0x20B);
+        Put<uint64_t>(image, 0x80 + 24 + 24, 0x7FF6A2B40000ull);
+
+        SignatureCache relocated;
+        relocated.OpenImage(path, base, image.size());
+        Check(relocated.WasLoaded() && relocated.ScanPattern(pattern) == image.data() + 0x1800,
+              "Cache survives relocation");
+
+        // Game update: new TimeDateStamp invalidates the whole file
+        Put<uint32_t>(image, 0x80 + 8, 0x5F3A1C01);
+        SignatureCache updated;
+        updated.OpenImage(path, base, image.size());
+        Check(!updated.WasLoaded() && updated.GetEntryCount() == 0, "Module rebuild invalidates cache");
+
+        SignatureCache unbound;
+        std::vector<uint8_t> bogus = MakeImage(4096, 5);
+        Check(!unbound.OpenImage(path, reinterpret_cast<uintptr_t>(bogus.data()), bogus.size()) &&
+                  unbound.ScanPattern("48 8B") == ScanPatternInRange(reinterpret_cast<uintptr_t>(bogus.data()), bogus.size(), "48 8B") &&
+                  unbound.GetEntryCount() == 0,
+              "Unreadable headers pass through uncached");
+        std::remove(path);
+    }
+
+    {
+        std::vector<uint8_t> data = MakeImage(8192, 21);
+        const uint8_t sig[] = {0x48, 0x8B, 0x05, 0x01, 0x02, 0x03, 0x04, 0x48, 0x85, 0xC0, 0x74, 0x1F};
+        PutBytes(data, 6000, sig, sizeof(sig));
+        const auto base = reinterpret_cast<uintptr_t>(data.data());
+        const char* text = "48 8B 05 ?? ?? ?? ?? 48 85 C0 74 1F";
+
+        CompiledPattern runtime;
+        CompilePattern(text, runtime);
+        Check(runtime.anchor == kLiteral.anchor && runtime.second == kLiteral.second,
+              "Literal anchors match runtime compilation");
+        Check(ScanPatternInRange(base, data.size(), kLiteral) == data.data() + 6000 &&
+                  ScanPatternInRange(base, data.size(), CU_PATTERN("74 1F")) == ScanPatternInRange(base, data.size(), "74 1F"),
+              "Literal scans agree with string scans");
+
+        PatternBatch batch;
+        const int index = batch.Add(kLiteral);
+        batch.ScanRange(base, data.size());
+        Check(index == 0 && batch.GetFirstMatch(0) == data.data() + 6000, "Batch accepts literals");
+    }
+
+    {
+        const TestSection layout[] = {
+            {".text", 0x1000, 0x1000, kSectionCode | kSectionExecute | kSectionRead},
+            {".rdata", 0x2000, 0x1000, kSectionInitializedData | kSectionRead},
+            {".data", 0x3000, 0x1000, kSectionInitializedData | kSectionRead | kSectionWrite},
+        };
+        std::vector<uint8_t> image = MakePeImage(0x4000, layout, 3);
+        const auto base = reinterpret_cast<uintptr_t>(image.data());
+
+        // Type descriptors: name at TD + 16
+        const char camera[] = ".?AVCCustomCamera@@";
+        const char state[] = ".?AUCameraState@@";
+        const char orphan[] = ".?AVNoVtable@@";
+        PutBytes(image, 0x3020, camera, sizeof(camera));
+        PutBytes(image, 0x3120, state, sizeof(state));
+        PutBytes(image, 0x3220, orphan, sizeof(orphan));
+        PutBytes(image, 0x1400, camera, sizeof(camera));  // string copy in code, not a TD
+
+        // COLs: {signature, offset, cdOffset, TD, CHD, self}
+        auto putCol = [&](size_t rva, uint32_t offset, uint32_t td, uint32_t self) {
+            const uint32_t col[6] = {1, offset, 0, td, 0, self};
+            PutBytes(image, rva, col, sizeof(col));
+        };
+        putCol(0x2100, 8, 0x3010, 0x2100);  // secondary base, listed first
+        putCol(0x2140, 0, 0x3010, 0x2140);  // primary
+        putCol(0x2180, 0, 0x3110, 0x2180);
+        putCol(0x21C0, 0, 0x3010, 0x2000);  // bad self-reference
+
+        // vtables: slot -1 is the COL pointer
+        auto putVtable = [&](size_t slotRva, size_t colRva, size_t funcs) {
+            Put<uint64_t>(image, slotRva, base + colRva);
+            for (size_t f = 0; f < funcs; ++f) Put<uint64_t>(image, slotRva + 8 + f * 8, base + 0x1000 + f * 0x10);
+        };
+        putVtable(0x2400, 0x2100, 2);
+        putVtable(0x2500, 0x2140, 3);
+        putVtable(0x2600, 0x2180, 1);
+        putVtable(0x2700, 0x21C0, 1);
+
+        RttiIndex index;
+        const bool built = index.BuildImage(base, image.size());
+        Check(built && index.GetClassCount() == 3, "RTTI index finds data-section descriptors only");
+
+        const RttiClass* cls = index.FindClass("CCustomCamera");
+        Check(cls && cls->type_descriptor == base + 0x3010 && cls->cols.size() == 2, "Class lookup links COLs");
+        Check(index.FindClass("CameraState") == index.FindMangled(state) && index.FindClass("CameraState") != nullptr,
+              "Struct lookup falls back to .?AU");
+        Check(index.GetVtableForCol(base + 0x2140) == base + 0x2508 && index.GetVtableForCol(base + 0x21C0) == 0,
+              "COL to vtable map rejects bad self-reference");
+
+        VtableInfo vt{};
+        Check(index.FindVtable("CCustomCamera", vt, 8) && vt.vtable_address == base + 0x2508 &&
+                  vt.col_address == base + 0x2140 && vt.vfunc_count == 3 && vt.vfuncs[2] == base + 0x1020,
+              "Vtable lookup prefers primary COL");
+        Check(!index.FindVtable("NoVtable", vt) && index.FindClass("NoVtable") != nullptr,
+              "Class without vtable reports no vtable");
+
+        std::vector<const RttiClass*> matches;
+        Check(index.FindContaining("Camera", matches) == 2 && matches[0]->name < matches[1]->name,
+              "Substring lookup over names");
+    }
+
+    return g_failures;
+}
@@ -0,0 +1,624 @@
+// Processing pipeline tests.
+//
+// Covers the quaternion log/exp helpers, the predictive rotation filters
+// (a steady turn predicted to display time should land closer to the true
+// pose than the unpredicted output; a still head should settle on the
+// measurement), the interpolators' timestamp mode, the late-latch
+// pose delta and the Present-interval display-time prediction. The
+// sample-rate processor must blend its two newest poses to render time,
+// cap extrapolation, hold across a gap, apply queued commands on the next
+// sample, and hand a concurrent reader only whole pose pairs.
+
+#include "cameraunlock/math/quat4.h"
+#include "cameraunlock/processing/head_pose_processor.h"
+#include "cameraunlock/processing/pose_interpolator.h"
+#include "cameraunlock/processing/pose_latch.h"
+#include "cameraunlock/processing/position_interpolator.h"
+#include "cameraunlock/processing/position_processor.h"
+#include "cameraunlock/processing/predictive_filter.h"
+#include "cameraunlock/processing/present_timing.h"
+#include "cameraunlock/processing/sample_rate_processor.h"
+#include "cameraunlock/processing/tracking_pipeline.h"
+#include "cameraunlock/processing/tracking_processor.h"
+#include "cameraunlock/processing/view_batch.h"
+
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <thread>
+
+namespace {
+
+int g_failures = 0;
+
+void Check(bool cond, const char* name) {
+    if (cond) {
+        std::cout << "  [PASS] " << name << "\n";
+    } else {
+        std::cout << "  [FAIL] " << name << "\n";
+        ++g_failures;
+    }
+}
+
+// Yaw error (degrees) after feeding a 90 deg/s turn sampled at 250 Hz for 1 s
+// and predicting 20 ms ahead of the last sample.
+// Tracking source that hands out whatever sample the test sets
+class FakeSource : public cameraunlock::ITrackingSource {
+public:
+    cameraunlock::TrackingSample sample;
+
+    bool IsReceiving() const override { return sample.IsValid(); }
+    bool IsRemoteConnection() const override { return false; }
+    bool IsFailed() const override { return false; }
+    int64_t GetLastReceiveTimestamp() const override { return sample.timestamp_us; }
+    bool GetRotation(float& yaw, float& pitch, float& roll) const override {
+        yaw = sample.yaw; pitch = sample.pitch; roll = sample.roll;
+        return sample.IsValid();
+    }
+    bool GetPosition(float& x, float& y, float& z) const override {
+        x = sample.x; y = sample.y; z = sample.z;
+        return sample.IsValid();
+    }
+    bool TryGetSample(cameraunlock::TrackingSample& out) const override {
+        out = sample;
+        return sample.IsValid();
+    }
+    void Recenter() override {}
+};
+
+float SteadyTurnError(cameraunlock::RotationFilterMode mode, bool predict) {
+    cameraunlock::TrackingProcessor processor;
+    processor.SetFilterMode(mode);
+
+    const float rateDeg = 90.0f;
+    const int64_t stepUs = 4000;
+    const int64_t aheadUs = 20000;
+    cameraunlock::TrackingPose pose;
+    int64_t t = 0;
+    for (int i = 0; i <= 250; ++i) {
+        t = i * stepUs;
+        float yaw = rateDeg * static_cast<float>(t) * 1e-6f;
+        pose = processor.ProcessPredicted(yaw, 0.0f, 0.0f, t, predict ? t + aheadUs : t);
+    }
+    float truth = rateDeg * static_cast<float>(t + aheadUs) * 1e-6f;
+    return std::fabs(pose.yaw - truth);
+}
+
+}  // namespace
+
+int RunProcessingTests() {
+    using cameraunlock::PredictiveFilter;
+    using cameraunlock::RotationFilterMode;
+    using cameraunlock::TrackingProcessor;
+    using cameraunlock::math::Quat4;
+    using cameraunlock::math::Vec3;
+
+    std::cout << "\nProcessing tests:\n";
+
+    // Rotation vector round trip
+    {
+        Quat4 q = Quat4::FromYawPitchRoll(30.0f, -20.0f, 10.0f);
+        Quat4 back = Quat4::FromRotationVector(q.ToRotationVector());
+        Check(std::fabs(std::fabs(q.Dot(back)) - 1.0f) < 1e-5f,
+              "Rotation vector: exp(log(q)) == q");
+
+        Vec3 v = Quat4::FromRotationVector(Vec3(0.0f, 0.5f, 0.0f)).ToRotationVector();
+        Check(std::fabs(v.y - 0.5f) < 1e-5f && std::fabs(v.x) < 1e-6f,
+              "Rotation vector: log(exp(v)) == v");
+
+        Vec3 zero = Quat4::Identity().ToRotationVector();
+        Check(zero.Magnitude() < 1e-6f, "Rotation vector: identity is zero");
+    }
+
+    // Prediction beats unpredicted output on a steady turn
+    {
+        float oneEuroLag = SteadyTurnError(RotationFilterMode::OneEuro, false);
+        float oneEuroPred = SteadyTurnError(RotationFilterMode::OneEuro, true);
+        Check(oneEuroPred < oneEuroLag, "One Euro: prediction reduces latency error");
+
+        float kalmanLag = SteadyTurnError(RotationFilterMode::ConstantVelocity, false);
+        float kalmanPred = SteadyTurnError(RotationFilterMode::ConstantVelocity, true);
+        Check(kalmanPred < kalmanLag, "Constant velocity: prediction reduces latency error");
+        Check(kalmanPred < 0.5f, "Constant velocity: steady turn predicted within 0.5 deg");
+    }
+
+    // Static input converges and velocity decays
+    {
+        PredictiveFilter filter;
+        filter.SetMode(RotationFilterMode::ConstantVelocity);
+        Quat4 still = Quat4::FromYawPitchRoll(15.0f, 5.0f, 0.0f);
+        for (int i = 0; i < 500; ++i) {
+            filter.Update(still, static_cast<int64_t>(i) * 4000);
+        }
+        Check(std::fabs(filter.GetFiltered().Dot(still)) > 0.99999f,
+              "Constant velocity: static input converges");
+        Check(filter.GetAngularVelocity().Magnitude() < 1e-3f,
+              "Constant velocity: static velocity is zero");
+    }
+
+    // Prediction horizon is capped
+    {
+        PredictiveFilter filter;
+        filter.SetMode(RotationFilterMode::OneEuro);
+        filter.SetMaxPrediction(0.01f);
+        for (int i = 0; i <= 100; ++i) {
+            float yaw = 90.0f * static_cast<float>(i) * 0.004f;
+            filter.Update(Quat4::FromYawPitchRoll(yaw, 0.0f, 0.0f), static_cast<int64_t>(i) * 4000);
+        }
+        Quat4 capped = filter.Predict(filter.GetLastTimestamp() + 10000);
+        Quat4 far = filter.Predict(filter.GetLastTimestamp() + 1000000);
+        Check(std::fabs(capped.Dot(far)) > 0.999999f, "Predict: horizon clamped");
+    }
+
+    // Repeated sample timestamp only re-predicts
+    {
+        TrackingProcessor processor;
+        processor.SetFilterMode(RotationFilterMode::OneEuro);
+        processor.ProcessPredicted(0.0f, 0.0f, 0.0f, 0, 0);
+        processor.ProcessPredicted(10.0f, 0.0f, 0.0f, 4000, 4000);
+        auto first = processor.ProcessPredicted(10.0f, 0.0f, 0.0f, 4000, 4000);
+        auto second = processor.ProcessPredicted(10.0f, 0.0f, 0.0f, 4000, 4000);
+        Check(first.yaw == second.yaw, "ProcessPredicted: same sample is idempotent");
+    }
+
+    // Timestamp interpolation: 60 Hz samples, 144 Hz frames, exact playback
+    {
+        using cameraunlock::PoseInterpolator;
+        PoseInterpolator interp;
+        interp.render_delay_us = 16667;
+
+        const float rateDeg = 45.0f;
+        float maxError = 0.0f;
+        int64_t sampleUs = 0;
+        for (int64_t renderUs = 0; renderUs < 1000000; renderUs += 6944) {
+            // Latest sample available at this frame
+            sampleUs = (renderUs / 16667) * 16667;
+            float yaw = rateDeg * static_cast<float>(sampleUs) * 1e-6f;
+            auto pose = interp.UpdateTimestamped(yaw, 0.0f, 0.0f, sampleUs, renderUs);
+            if (renderUs >= 50000) {
+                float truth = rateDeg * static_cast<float>(renderUs - interp.render_delay_us) * 1e-6f;
+                float err = std::fabs(pose.yaw - truth);
+                if (err > maxError) maxError = err;
+            }
+        }
+        Check(maxError < 1e-3f, "PoseInterpolator: timestamp mode plays back exactly");
+    }
+
+    // Timestamp interpolation extrapolation is bounded
+    {
+        using cameraunlock::PositionData;
+        using cameraunlock::PositionInterpolator;
+        PositionInterpolator interp;
+        interp.SetRenderDelay(0);
+        interp.SetMaxExtrapolationFraction(0.5f);
+        interp.UpdateTimestamped(PositionData(0.0f, 0.0f, 0.0f, 10000), 10000);
+        interp.UpdateTimestamped(PositionData(1.0f, 0.0f, 0.0f, 20000), 20000);
+        auto far = interp.UpdateTimestamped(PositionData(1.0f, 0.0f, 0.0f, 20000), 90000);
+        Check(std::fabs(far.x - 1.5f) < 1e-5f, "PositionInterpolator: extrapolation capped");
+
+        // A dropout longer than the maximum interval restarts the history
+        auto resumed = interp.UpdateTimestamped(PositionData(5.0f, 0.0f, 0.0f, 900000), 900000);
+        Check(std::fabs(resumed.x - 5.0f) < 1e-5f, "PositionInterpolator: gap restarts history");
+    }
+
+    // Frame-delta mode: one interval reaches the sample, then extrapolation caps
+    {
+        cameraunlock::PoseInterpolator interp;
+        interp.Update(0.0f, 0.0f, 0.0f, true, 0.016f);
+        auto reached = interp.Update(10.0f, 0.0f, 0.0f, true, 0.016f);
+        interp.Update(10.0f, 0.0f, 0.0f, false, 0.016f);
+        auto capped = interp.Update(10.0f, 0.0f, 0.0f, false, 0.016f);
+        Check(std::fabs(reached.yaw - 10.0f) < 1e-4f && std::fabs(capped.yaw - 15.0f) < 1e-4f,
+              "PoseInterpolator: frame mode reaches sample, extrapolation capped");
+    }
+
+    // Quaternion output path agrees with the Euler path
+    {
+        TrackingProcessor eulerPath;
+        TrackingProcessor quatPath;
+        auto pose = eulerPath.Process(20.0f, -10.0f, 5.0f, 0.016f);
+        Quat4 q = quatPath.ProcessQuat(20.0f, -10.0f, 5.0f, 0.016f);
+        Quat4 expected = Quat4::FromYawPitchRoll(pose.yaw, pose.pitch, pose.roll);
+        Check(std::fabs(q.Dot(expected)) > 0.99999f, "ProcessQuat: matches Process at unit sensitivity");
+
+        cameraunlock::SensitivitySettings sens;
+        sens.yaw = 2.0f;
+        sens.invert_yaw = true;
+        eulerPath.Reset();
+        quatPath.Reset();
+        eulerPath.SetSensitivity(sens);
+        quatPath.SetSensitivity(sens);
+        pose = eulerPath.Process(25.0f, 0.0f, 0.0f, 0.016f);
+        q = quatPath.ProcessQuat(25.0f, 0.0f, 0.0f, 0.016f);
+        expected = Quat4::FromYawPitchRoll(pose.yaw, pose.pitch, pose.roll);
+        Check(std::fabs(q.Dot(expected)) > 0.99999f, "ProcessQuat: single-axis sensitivity is exact");
+    }
+
+    // Basis matches rotating the unit axes
+    {
+        Quat4 q = Quat4::FromYawPitchRoll(40.0f, 15.0f, -25.0f);
+        Vec3 right, up, forward;
+        q.ToBasis(right, up, forward);
+        Vec3 f = q.Rotate(Vec3::Forward());
+        Vec3 u = q.Rotate(Vec3::Up());
+        Vec3 r = q.Rotate(Vec3::Right());
+        Check((forward - f).Magnitude() < 1e-5f && (up - u).Magnitude() < 1e-5f &&
+                  (right - r).Magnitude() < 1e-5f,
+              "Quat4::ToBasis matches Rotate");
+    }
+
+    // Fused processor matches the separate rotation + position chain
+    {
+        cameraunlock::HeadPoseProcessor fused;
+        fused.SetInterpolationEnabled(false);
+        fused.SetSmoothing(0.4f);
+        TrackingProcessor rotation;
+        rotation.SetSmoothing(0.4f);
+        cameraunlock::PositionProcessor position;
+
+        bool match = true;
+        cameraunlock::HeadPoseFrame frame;
+        for (int i = 1; i <= 60; ++i) {
+            cameraunlock::TrackingSample sample;
+            sample.yaw = 0.5f * static_cast<float>(i);
+            sample.pitch = -0.2f * static_cast<float>(i);
+            sample.x = 0.001f * static_cast<float>(i);
+            sample.z = -0.002f * static_cast<float>(i);
+            sample.timestamp_us = i * 16667;
+            sample.sequence = static_cast<uint64_t>(i);
+
+            frame = fused.Step(sample, 0.016f);
+            auto pose = rotation.Process(sample.yaw, sample.pitch, sample.roll, 0.016f);
+            Quat4 q = Quat4::FromYawPitchRoll(pose.yaw, pose.pitch, pose.roll);
+            Vec3 pos = position.Process(
+                cameraunlock::PositionData(sample.x, sample.y, sample.z, sample.timestamp_us), q, 0.016f);
+
+            match = match && std::fabs(frame.yaw - pose.yaw) < 1e-3f &&
+                std::fabs(frame.pitch - pose.pitch) < 1e-3f &&
+                (frame.position - pos).Magnitude() < 1e-5f;
+        }
+        Check(match, "HeadPoseProcessor: matches TrackingProcessor + PositionProcessor");
+        Check(frame.IsRotationValid() && frame.IsPositionValid() && frame.IsNewSample(),
+              "HeadPoseProcessor: validity flags set");
+
+        cameraunlock::TrackingSample none;
+        Check(fused.Step(none, 0.016f).flags == 0, "HeadPoseProcessor: invalid sample has no flags");
+    }
+
+    // Batch view processing matches per-view Quat4 math
+    {
+        const size_t kViews = 5;
+        float ox[kViews] = {0.0f, 0.1f, -0.2f, 0.0f, 0.05f};
+        float oy[kViews] = {0.0f, -0.05f, 0.0f, 0.1f, 0.0f};
+        float oz[kViews] = {0.0f, 0.3f, 0.1f, 0.0f, -0.1f};
+        float eye[kViews] = {-0.032f, 0.032f, 0.0f, 0.0f, 0.0f};
+        float scale[kViews] = {1.0f, 1.0f, 0.0f, 0.5f, 1.0f};
+        Quat4 viewRot[kViews] = {
+            Quat4::Identity(), Quat4::FromYawPitchRoll(0.0f, -5.0f, 0.0f), Quat4::Identity(),
+            Quat4::FromYawPitchRoll(10.0f, 0.0f, 0.0f), Quat4::FromYawPitchRoll(0.0f, 0.0f, 90.0f)};
+        float rx[kViews], ry[kViews], rz[kViews], rw[kViews];
+        for (size_t i = 0; i < kViews; ++i) {
+            rx[i] = viewRot[i].x; ry[i] = viewRot[i].y; rz[i] = viewRot[i].z; rw[i] = viewRot[i].w;
+        }
+
+        cameraunlock::ViewBatchInput in;
+        in.offset_x = ox; in.offset_y = oy; in.offset_z = oz;
+        in.eye_offset = eye;
+        in.rotation_scale = scale;
+        in.rotation_x = rx; in.rotation_y = ry; in.rotation_z = rz; in.rotation_w = rw;
+
+        float qx[kViews], qy[kViews], qz[kViews], qw[kViews], px[kViews], py[kViews], pz[kViews];
+        cameraunlock::ViewBatchOutput out;
+        out.rotation_x = qx; out.rotation_y = qy; out.rotation_z = qz; out.rotation_w = qw;
+        out.position_x = px; out.position_y = py; out.position_z = pz;
+
+        Quat4 head = Quat4::FromYawPitchRoll(30.0f, -10.0f, 5.0f);
+        Vec3 headPos(0.01f, 0.02f, -0.03f);
+        cameraunlock::ProcessBatch(head, headPos, in, kViews, out);
+
+        bool match = true;
+        for (size_t i = 0; i < kViews; ++i) {
+            if (scale[i] != 1.0f && scale[i] != 0.0f) continue;  // nlerp-scaled; checked below
+            Quat4 h = scale[i] == 1.0f ? head : Quat4::Identity();
+            Quat4 expectedRot = h * viewRot[i];
+            Vec3 expectedPos = headPos + h.Rotate(Vec3(ox[i] + eye[i], oy[i], oz[i]));
+            Quat4 got(qx[i], qy[i], qz[i], qw[i]);
+            match = match && std::fabs(got.Dot(expectedRot)) > 0.999999f &&
+                (Vec3(px[i], py[i], pz[i]) - expectedPos).Magnitude() < 1e-5f;
+        }
+        Check(match, "ProcessBatch: matches per-view Quat4 math");
+
+        // Half scale on a pure yaw is exact under nlerp (symmetric midpoint)
+        cameraunlock::ProcessBatch(Quat4::FromYawPitchRoll(40.0f, 0.0f, 0.0f), Vec3::Zero(), in, kViews, out);
+        float yaw, pitch, roll;
+        Quat4 half = Quat4(qx[3], qy[3], qz[3], qw[3]) * viewRot[3].Inverse();
+        half.ToEulerYXZ(yaw, pitch, roll);
+        Check(std::fabs(yaw - 20.0f) < 1e-3f, "ProcessBatch: rotation_scale halves head rotation");
+
+        // Null optional arrays mean identity view, unit scale, no eye offset
+        cameraunlock::ViewBatchInput minimal;
+        minimal.offset_x = ox; minimal.offset_y = oy; minimal.offset_z = oz;
+        cameraunlock::ProcessBatch(head, headPos, minimal, kViews, out);
+        Vec3 expected = headPos + head.Rotate(Vec3(ox[1], oy[1], oz[1]));
+        Check((Vec3(px[1], py[1], pz[1]) - expected).Magnitude() < 1e-5f &&
+                  std::fabs(Quat4(qx[1], qy[1], qz[1], qw[1]).Dot(head)) > 0.999999f,
+              "ProcessBatch: optional inputs default sensibly");
+    }
+
+    // Compile-time pipeline matches TrackingProcessor
+    {
+        namespace pl = cameraunlock::pipeline;
+        cameraunlock::StandardTrackingPipeline standard;
+        standard.Get<pl::SlerpSmooth>().smoothing = 0.5f;
+        standard.Get<pl::Deadzone>().settings = cameraunlock::DeadzoneSettings::Uniform(1.0f);
+        standard.Get<pl::Sensitivity>().settings.yaw = 1.5f;
+        standard.Get<pl::Sensitivity>().settings.invert_pitch = true;
+        standard.Get<pl::CenterOffset>().center.SetCenter(2.0f, 1.0f, 0.0f);
+
+        TrackingProcessor runtime;
+        runtime.SetSmoothing(0.5f);
+        runtime.SetDeadzone(cameraunlock::DeadzoneSettings::Uniform(1.0f));
+        cameraunlock::SensitivitySettings sens;
+        sens.yaw = 1.5f;
+        sens.invert_pitch = true;
+        runtime.SetSensitivity(sens);
+        runtime.RecenterTo(2.0f, 1.0f, 0.0f);
+
+        bool match = true;
+        for (int i = 0; i < 60; ++i) {
+            float yaw = static_cast<float>(i);
+            float pitch = -0.5f * static_cast<float>(i);
+            auto a = standard.Process(yaw, pitch, 3.0f, 0.016f);
+            auto b = runtime.Process(yaw, pitch, 3.0f, 0.016f);
+            match = match && std::fabs(a.yaw - b.yaw) < 1e-4f &&
+                std::fabs(a.pitch - b.pitch) < 1e-4f && std::fabs(a.roll - b.roll) < 1e-4f;
+        }
+        Check(match, "TrackingPipeline: standard chain matches TrackingProcessor");
+
+        // A single quaternion stage returns quaternions without decomposition
+        cameraunlock::TrackingPipeline<pl::SlerpSmooth> smoothOnly;
+        Quat4 q = smoothOnly.ProcessQuat(10.0f, 0.0f, 0.0f, 0.016f);
+        Check(std::fabs(q.Dot(Quat4::FromYawPitchRoll(10.0f, 0.0f, 0.0f))) > 0.99999f,
+              "TrackingPipeline: quaternion-only pipeline");
+
+        // Empty pipeline is the identity
+        cameraunlock::TrackingPipeline<> passthrough;
+        auto p = passthrough.Process(5.0f, 6.0f, 7.0f, 0.016f);
+        Check(p.yaw == 5.0f && p.pitch == 6.0f && p.roll == 7.0f, "TrackingPipeline: empty pipeline passes through");
+
+        // Predictive stage composes
+        cameraunlock::TrackingPipeline<pl::Predict> predicted;
+        predicted.Get<pl::Predict>().filter.SetMode(RotationFilterMode::ConstantVelocity);
+        cameraunlock::TrackingPose last;
+        for (int i = 0; i <= 250; ++i) {
+            int64_t t = static_cast<int64_t>(i) * 4000;
+            last = predicted.ProcessPredicted(90.0f * static_cast<float>(t) * 1e-6f, 0.0f, 0.0f, t, t + 20000);
+        }
+        Check(std::fabs(last.yaw - 91.8f) < 0.5f, "TrackingPipeline: Predict stage extrapolates");
+    }
+
+    // Settings channel drives live tuning
+    {
+        cameraunlock::SettingsChannel<cameraunlock::TrackingProcessorSettings> channel;
+        TrackingProcessor processor;
+        processor.SetSettingsChannel(&channel);
+
+        auto before = processor.Process(10.0f, 0.0f, 0.0f, 0.016f);
+        cameraunlock::TrackingProcessorSettings tuned;
+        tuned.sensitivity.yaw = 2.0f;
+        channel.Publish(tuned);
+        auto after = processor.Process(10.0f, 0.0f, 0.0f, 0.016f);
+        Check(std::fabs(before.yaw - 10.0f) < 1e-3f && std::fabs(after.yaw - 20.0f) < 1e-3f &&
+                  processor.GetSensitivity().yaw == 2.0f,
+              "TrackingProcessor: adopts published settings");
+    }
+
+    {
+        FakeSource source;
+        cameraunlock::PoseLatch latch(&source);
+        Check(!latch.Latch().valid, "PoseLatch: invalid before any frame");
+
+        source.sample.yaw = 10.0f;
+        source.sample.pitch = -5.0f;
+        source.sample.timestamp_us = 1000;
+        source.sample.sequence = 1;
+        cameraunlock::TrackingSample used;
+        Check(latch.CaptureFrameSample(used) && used.yaw == 10.0f, "PoseLatch: capture returns the sample");
+
+        auto delta = latch.Latch();
+        Check(delta.valid && !delta.IsLate() && delta.yaw == 0.0f, "PoseLatch: no newer sample, zero delta");
+
+        source.sample.yaw = 12.5f;
+        source.sample.pitch = -4.0f;
+        source.sample.timestamp_us = 5000;
+        source.sample.sequence = 2;
+        delta = latch.Latch();
+        Check(delta.IsLate() && std::fabs(delta.yaw - 2.5f) < 1e-5f && std::fabs(delta.pitch - 1.0f) < 1e-5f,
+              "PoseLatch: delta since the rendered sample");
+
+        source.sample.yaw = 80.0f;
+        Check(std::fabs(latch.Latch().yaw - cameraunlock::PoseLatch::kDefaultMaxDelta) < 1e-5f,
+              "PoseLatch: large jumps are clamped");
+
+        // Crossing +-180 is a small turn, not a full circle
+        source.sample.yaw = 179.0f;
+        latch.SetRenderedSample(source.sample);
+        source.sample.yaw = -179.0f;
+        source.sample.timestamp_us = 9000;
+        Check(std::fabs(latch.Latch().yaw - 2.0f) < 1e-4f, "PoseLatch: delta wraps at 180");
+
+        latch.Reset();
+        Check(!latch.Latch().valid, "PoseLatch: reset forgets the frame");
+    }
+
+    // Present timing: 60 Hz presents with one hitch, then frame statistics
+    {
+        cameraunlock::PresentTimingSampler sampler;
+        Check(sampler.PredictNextDisplayTime(1000) == 0, "PresentTiming: no prediction before any present");
+
+        constexpr int64_t kFrame = 16667;
+        int64_t t = 1000000;
+        uint32_t id = 1;
+        sampler.RecordPresent(t, id++);
+        sampler.RecordPresent(t += kFrame, id++);
+        Check(sampler.PredictNextDisplayTime(t) == 0, "PresentTiming: one interval is not enough");
+        for (int i = 0; i < 8; ++i) sampler.RecordPresent(t += kFrame, id++);
+        sampler.RecordPresent(t += 4 * kFrame, id++);  // dropped frames
+        for (int i = 0; i < 3; ++i) sampler.RecordPresent(t += kFrame, id++);
+
+        auto e = sampler.GetEstimate();
+        Check(e.frame_interval_us == kFrame && e.last_present_us == t && e.scanout_latency_us == 0,
+              "PresentTiming: median interval ignores a hitch");
+        Check(sampler.PredictNextDisplayTime(t + 2000) == t + kFrame,
+              "PresentTiming: next present one interval out");
+        Check(sampler.PredictNextDisplayTime(t + 2 * kFrame + 5) == t + 3 * kFrame,
+              "PresentTiming: a late query rolls to the next slot");
+
+        // The present just made reaches the screen 9 ms later; an unknown
+        // id and an implausible latency are ignored
+        sampler.RecordScanout(id - 1, t + 9000);
+        sampler.RecordScanout(9999, t + 2000);
+        sampler.RecordScanout(id - 2, t + 1000000);
+        e = sampler.GetEstimate();
+        Check(e.scanout_latency_us == 9000, "PresentTiming: scanout latency from frame statistics");
+        Check(sampler.PredictNextDisplayTime(t + 2000) == t + kFrame + 9000,
+              "PresentTiming: prediction includes scanout latency");
+
+        // A long pause isn't an interval
+        sampler.RecordPresent(t += 1000000, id++);
+        Check(sampler.GetEstimate().frame_interval_us == kFrame, "PresentTiming: pauses are not intervals");
+
+        sampler.Reset();
+        Check(sampler.PredictNextDisplayTime(t) == 0 && sampler.GetEstimate().scanout_latency_us == 0,
+              "PresentTiming: reset clears the estimate");
+    }
+
+    // Sample-rate processing: filter per sample, blend per frame
+    {
+        using cameraunlock::ProcessedPose;
+        using cameraunlock::SampleRateProcessor;
+        using cameraunlock::TrackingSample;
+        using cameraunlock::math::Quat4;
+
+        SampleRateProcessor stage;
+        uint64_t sequence = 0;
+        auto feed = [&](float yaw, int64_t us) {
+            TrackingSample s;
+            s.yaw = yaw;
+            s.timestamp_us = us;
+            s.sequence = ++sequence;
+            stage.OnSample(s);
+        };
+        auto yawAt = [&](int64_t renderUs) {
+            Quat4 q;
+            float yaw = -999.0f, pitch = 0, roll = 0;
+            if (stage.Evaluate(renderUs, q)) q.ToEulerYXZ(yaw, pitch, roll);
+            return yaw;
+        };
+
+        Quat4 q;
+        Check(!stage.Evaluate(1000, q), "SampleRateProcessor: nothing before the first sample");
+        feed(0.0f, 1000000);
+        Check(std::fabs(yawAt(1000000)) < 1e-4f && std::fabs(yawAt(2000000)) < 1e-4f,
+              "SampleRateProcessor: one sample holds");
+
+        // Baseline smoothing always applies, so blends are checked against
+        // the processed poses: 0 (the seed) and the second sample's output
+        feed(10.0f, 1010000);
+        ProcessedPose latest;
+        float last = 0, pitch = 0, roll = 0;
+        Check(stage.TryGetLatest(latest) && latest.sequence == 2, "SampleRateProcessor: newest pose published");
+        latest.rotation.ToEulerYXZ(last, pitch, roll);
+        Check(last > 1.0f && std::fabs(yawAt(1005000) - 0.5f * last) < 0.01f,
+              "SampleRateProcessor: blends between the two newest poses");
+        Check(std::fabs(yawAt(1014000) - 1.4f * last) < 0.01f && std::fabs(yawAt(1100000) - 1.5f * last) < 0.01f,
+              "SampleRateProcessor: extrapolation capped at the max fraction");
+        stage.SetRenderDelayUs(10000);
+        Check(std::fabs(yawAt(1015000) - 0.5f * last) < 0.01f, "SampleRateProcessor: render delay interpolates");
+        stage.SetRenderDelayUs(0);
+
+        TrackingSample repeat;
+        repeat.yaw = 50.0f;
+        repeat.sequence = sequence;
+        repeat.timestamp_us = 1020000;
+        stage.OnSample(repeat);
+        Check(stage.TryGetLatest(latest) && latest.sequence == sequence && latest.timestamp_us == 1010000,
+              "SampleRateProcessor: repeated sequence ignored");
+
+        feed(20.0f, 1310000);  // 300 ms dropout
+        stage.TryGetLatest(latest);
+        latest.rotation.ToEulerYXZ(last, pitch, roll);
+        Check(std::fabs(yawAt(1300000) - last) < 1e-4f && std::fabs(yawAt(1400000) - last) < 1e-4f,
+              "SampleRateProcessor: no blending across a gap");
+
+        // Settle on 20, then recenter there
+        int64_t now = 1310000;
+        for (int i = 0; i < 200; ++i) feed(20.0f, now += 4000);
+        Check(stage.Recenter(), "SampleRateProcessor: recenter queued");
+        Check(std::fabs(yawAt(now) - 20.0f) < 0.01f, "SampleRateProcessor: command waits for the next sample");
+        // The exponential filter eases into a new center rather than jumping
+        feed(20.0f, now += 4000);
+        const float firstAfter = yawAt(now);
+        for (int i = 0; i < 200; ++i) feed(20.0f, now += 4000);
+        Check(firstAfter < 19.9f && std::fabs(yawAt(now)) < 0.01f,
+              "SampleRateProcessor: recenter applies from the next sample");
+
+        // Smoothing steps by the sample interval, so it matches a processor
+        // stepped at the same rate regardless of the game's frame rate
+        SampleRateProcessor smoothed;
+        smoothed.GetProcessor().SetSmoothing(0.5f);
+        cameraunlock::TrackingProcessor reference;
+        reference.SetSmoothing(0.5f);
+        Quat4 expected;
+        for (int i = 0; i < 50; ++i) {
+            TrackingSample s;
+            s.yaw = static_cast<float>(i);
+            s.timestamp_us = 1000000 + i * 4000;
+            s.sequence = i + 1;
+            smoothed.OnSample(s);
+            expected = reference.ProcessQuat(s.yaw, 0.0f, 0.0f, i == 0 ? 0.0f : 0.004f);
+        }
+        Check(smoothed.TryGetLatest(latest) && std::fabs(latest.rotation.Dot(expected) - 1.0f) < 1e-6f,
+              "SampleRateProcessor: filter stepped at the sample interval");
+
+        Check(smoothed.Reset(), "SampleRateProcessor: reset queued");
+        TrackingSample after;
+        after.yaw = 30.0f;
+        after.timestamp_us = 2000000;
+        after.sequence = 51;
+        smoothed.OnSample(after);
+        float yaw = 0;
+        smoothed.TryGetLatest(latest);
+        latest.rotation.ToEulerYXZ(yaw, pitch, roll);
+        Check(std::fabs(yaw - 30.0f) < 0.01f, "SampleRateProcessor: reset reseeds the filter");
+
+        // A reader racing the sample thread only ever sees whole pairs
+        SampleRateProcessor shared;
+        std::atomic<bool> done{false};
+        std::thread writer([&] {
+            for (int i = 1; i <= 20000; ++i) {
+                TrackingSample s;
+                s.yaw = static_cast<float>(i % 90);
+                s.timestamp_us = 1000000 + static_cast<int64_t>(i) * 1000;
+                s.sequence = static_cast<uint64_t>(i);
+                shared.OnSample(s);
+            }
+            done.store(true);
+        });
+        bool whole = true;
+        uint64_t lastSeen = 0;
+        while (!done.load()) {
+            if (shared.TryGetLatest(latest)) {
+                const float len = latest.rotation.Dot(latest.rotation);
+                whole = whole && latest.sequence >= lastSeen && std::fabs(len - 1.0f) < 1e-4f &&
+                        latest.timestamp_us == 1000000 + static_cast<int64_t>(latest.sequence) * 1000;
+                lastSeen = latest.sequence;
+            }
+            std::this_thread::yield();
+        }
+        writer.join();
+        Check(whole, "SampleRateProcessor: concurrent reads are never torn");
+    }
+
+    return g_failures;
+}
@@ -6,14 +6,53 @@
 // rejection of malformed input - in particular finite-but-out-of-float-range
 // doubles, which used to slip past the isnan/isinf check and become +/-inf
 // after the narrowing cast, poisoning the downstream view matrix with NaN.
+//
+// The SocketWaiter checks run over loopback and pin the receive thread's
+// wake-up contract: readable on data, signaled on Stop, quiet otherwise.
+// The ReceiveLatest check pins the polling drain: a backlog collapses to its
+// newest datagram and the rest are counted, not parsed, and with a filter a
+// malformed tail doesn't displace the newest valid datagram. The timestamp check
+// confirms kernel arrival times predate a late read instead of tracking it.
+// The SharedUdpReceiver check pins the hub hand-off: one owner binds, every
+// consumer sees its samples and keeps its own center, and a survivor adopts
+// the socket only when it asks to, never as a side effect of a read. ReceiverStats
+// checks pin the histogram bucketing and the p99 estimate. The capture
+// round trip pins the file format and both replay modes. The load generator
+// checks pin its determinism, due ordering, fault accounting, phase
+// sequencing, capture looping and profile inheritance. The pipeline trace
+// checks pin first-stamp-wins, slot reuse, and the receive -> process ->
+// present chain over loopback. The extended packet checks pin detection by
+// length and magic with the OpenTrack fallback, the sender timeline's
+// ordering and clock mapping across wraps and restarts, and the receivers
+// dropping late extended datagrams; the polling receiver must keep an
+// older accepted one when the newest is late, stamped with its capture
+// arrival time while capturing. The center command checks pin that a
+// recenter, reset or explicit center lands on the next published packet
+// together with it, and that Stop discards pending commands.
 
+#include "cameraunlock/diagnostics/pipeline_trace.h"
+#include "cameraunlock/diagnostics/receiver_stats.h"
+#include "cameraunlock/protocol/capture_file.h"
+#include "cameraunlock/protocol/load_generator.h"
 #include "cameraunlock/protocol/opentrack_packet.h"
+#include "cameraunlock/protocol/polling_udp_receiver.h"
+#include "cameraunlock/protocol/replay_source.h"
+#include "cameraunlock/protocol/sender_timeline.h"
+#include "cameraunlock/protocol/shared_udp_receiver.h"
+#include "cameraunlock/processing/tracking_processor.h"
+#include "cameraunlock/protocol/socket_waiter.h"
+#include "cameraunlock/protocol/udp_receiver.h"
+#include "cameraunlock/protocol/udp_socket.h"
 
+#include <chrono>
 #include <cmath>
 #include <cstdint>
+#include <cstdio>
 #include <cstring>
 #include <iostream>
 #include <limits>
+#include <thread>
+#include <vector>
 
 namespace {
 
@@ -101,5 +140,839 @@ int RunProtocolTests() {
               "finite-but-huge in TryParseAll rejected");
     }
 
+    // SocketWaiter wake-ups over loopback.
+    {
+        using cameraunlock::SocketWaiter;
+        using cameraunlock::UdpSocket;
+
+        UdpSocket receiver;
+        UdpSocket sender;
+        sockaddr_in addr = {};
+#ifdef _WIN32
+        int addrLen = sizeof(addr);
+#else
+        socklen_t addrLen = sizeof(addr);
+#endif
+        bool opened = receiver.Open(0) && sender.Open(0) &&
+            getsockname(receiver.GetHandle(), reinterpret_cast<sockaddr*>(&addr), &addrLen) == 0;
+        SocketWaiter waiter;
+        opened = opened && waiter.Open(receiver.GetHandle());
+        Check(opened, "waiter opens on a bound socket");
+
+        if (opened) {
+            Check(waiter.Wait(10) == SocketWaiter::WaitResult::Timeout, "idle waiter times out");
+
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            uint8_t pkt[48];
+            BuildPacket(pkt, 0, 0, 0, 1, 2, 3);
+            sendto(sender.GetHandle(), reinterpret_cast<const char*>(pkt), sizeof(pkt), 0,
+                   reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+            Check(waiter.Wait(1000) == SocketWaiter::WaitResult::Readable, "waiter wakes on datagram");
+
+            waiter.Signal();
+            Check(waiter.Wait(1000) == SocketWaiter::WaitResult::Signaled, "signal wins over pending data");
+            Check(waiter.Wait(0) == SocketWaiter::WaitResult::Signaled, "signal is sticky");
+        }
+    }
+
+    // Batched drain keeps only the newest datagram.
+    {
+        using cameraunlock::UdpSocket;
+
+        UdpSocket receiver;
+        UdpSocket sender;
+        sockaddr_in addr = {};
+#ifdef _WIN32
+        int addrLen = sizeof(addr);
+#else
+        socklen_t addrLen = sizeof(addr);
+#endif
+        bool opened = receiver.Open(0) && sender.Open(0) &&
+            getsockname(receiver.GetHandle(), reinterpret_cast<sockaddr*>(&addr), &addrLen) == 0;
+        Check(opened, "drain sockets open");
+
+        if (opened) {
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            constexpr int kBacklog = 40;
+            uint8_t pkt[48];
+            for (int i = 0; i < kBacklog; ++i) {
+                BuildPacket(pkt, 0, 0, 0, i, 0, 0);
+                sendto(sender.GetHandle(), reinterpret_cast<const char*>(pkt), sizeof(pkt), 0,
+                       reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+            }
+
+            char buffer[256];
+            sockaddr_in from = {};
+            int datagrams = 0;
+            uint64_t bytes = 0;
+            int size = receiver.ReceiveLatest(buffer, sizeof(buffer), from, 1000, datagrams, bytes);
+            TrackingPose pose;
+            Check(size == 48 && datagrams == kBacklog && bytes == 48u * kBacklog,
+                  "ReceiveLatest drains the whole backlog");
+            Check(OpenTrackPacket::TryParse(buffer, static_cast<size_t>(size), pose) &&
+                  pose.yaw == static_cast<float>(kBacklog - 1),
+                  "ReceiveLatest keeps the newest datagram");
+            Check(receiver.ReceiveLatest(buffer, sizeof(buffer), from, 1000, datagrams, bytes) == 0 &&
+                  datagrams == 0, "drained socket reports nothing queued");
+
+            // A malformed tail must not hide the last valid datagram
+            BuildPacket(pkt, 0, 0, 0, 5, 0, 0);
+            sendto(sender.GetHandle(), reinterpret_cast<const char*>(pkt), sizeof(pkt), 0,
+                   reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+            const char junk[7] = {1, 2, 3, 4, 5, 6, 7};
+            for (int i = 0; i < 3; ++i) {
+                sendto(sender.GetHandle(), junk, sizeof(junk), 0,
+                       reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+            }
+            auto wellFormed = [](void*, const char* data, int length) {
+                TrackingPose p;
+                return OpenTrackPacket::TryParse(data, static_cast<size_t>(length), p);
+            };
+            int rejected = 0;
+            size = receiver.ReceiveLatest(buffer, sizeof(buffer), from, 1000, datagrams, bytes,
+                                          wellFormed, nullptr, &rejected);
+            Check(size == 48 && datagrams == 4 && rejected == 3 &&
+                  OpenTrackPacket::TryParse(buffer, static_cast<size_t>(size), pose) && pose.yaw == 5.0f,
+                  "ReceiveLatest keeps the newest accepted datagram");
+        }
+    }
+
+    // Kernel receive timestamps reflect arrival, not the time of the read.
+    {
+        using cameraunlock::UdpSocket;
+
+        UdpSocket receiver;
+        UdpSocket sender;
+        sockaddr_in addr = {};
+#ifdef _WIN32
+        int addrLen = sizeof(addr);
+#else
+        socklen_t addrLen = sizeof(addr);
+#endif
+        bool opened = receiver.Open(0) && sender.Open(0) &&
+            getsockname(receiver.GetHandle(), reinterpret_cast<sockaddr*>(&addr), &addrLen) == 0;
+
+        if (opened && receiver.EnableReceiveTimestamps()) {
+            // Let the kernel finish enabling stamping (deferred on Linux)
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            uint8_t pkt[48];
+            BuildPacket(pkt, 0, 0, 0, 0, 0, 0);
+            sendto(sender.GetHandle(), reinterpret_cast<const char*>(pkt), sizeof(pkt), 0,
+                   reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+            char buffer[64];
+            sockaddr_in from = {};
+            int64_t arrivalUs = 0;
+            int size = receiver.ReceiveTimestamped(buffer, sizeof(buffer), from, arrivalUs);
+            int64_t ageUs = TrackingPose::CurrentTimestamp() - arrivalUs;
+            Check(size == 48 && ageUs >= 40000 && ageUs < 5000000,
+                  "kernel timestamp records arrival before a late read");
+        } else {
+            std::cout << "  [SKIP] kernel receive timestamps unsupported\n";
+        }
+    }
+
+    // Shared receiver hub: one socket, many consumers, owner hand-off.
+    {
+        using cameraunlock::SharedUdpReceiver;
+        using cameraunlock::TrackingSample;
+        using cameraunlock::UdpSocket;
+
+        constexpr uint16_t kHubTestPort = 47421;
+        auto waitForYaw = [](const SharedUdpReceiver& r, float yaw) {
+            for (int i = 0; i < 200; ++i) {
+                TrackingSample s;
+                if (r.TryGetSample(s) && s.yaw == yaw) return true;
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            }
+            return false;
+        };
+
+        SharedUdpReceiver first;
+        SharedUdpReceiver second;
+        UdpSocket sender;
+        if (first.Start(kHubTestPort) && !first.IsFailed() && sender.Open(0)) {
+            Check(second.Start(kHubTestPort) && first.IsOwner() && !second.IsOwner(),
+                  "second consumer attaches without taking the socket");
+
+            sockaddr_in addr = {};
+            addr.sin_family = AF_INET;
+            addr.sin_port = htons(kHubTestPort);
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            uint8_t pkt[48];
+            BuildPacket(pkt, 0, 0, 0, 11, 0, 0);
+            sendto(sender.GetHandle(), reinterpret_cast<const char*>(pkt), sizeof(pkt), 0,
+                   reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+            Check(waitForYaw(first, 11.0f) && waitForYaw(second, 11.0f),
+                  "both consumers read the owner's sample");
+
+            // Centering is per consumer and travels with the sample
+            second.Recenter();
+            float yaw = 0.0f, pitch = 0.0f, roll = 0.0f;
+            TrackingSample centered;
+            Check(second.TryGetSample(centered) && centered.yaw == 11.0f &&
+                  centered.center_yaw == 11.0f && second.GetRotation(yaw, pitch, roll) && yaw == 0.0f,
+                  "recenter is reported in the consumer's sample");
+            Check(first.GetRotation(yaw, pitch, roll) && yaw == 11.0f,
+                  "recentering one consumer leaves the others alone");
+
+            first.Stop();
+            TrackingSample s;
+            second.TryGetSample(s);
+            Check(!second.IsOwner(), "reads never adopt the socket");
+            Check(second.AdoptIfOrphaned() && second.IsOwner(),
+                  "survivor adopts the socket when asked after the owner stops");
+
+            BuildPacket(pkt, 0, 0, 0, 22, 0, 0);
+            bool received = false;
+            for (int i = 0; i < 20 && !received; ++i) {
+                sendto(sender.GetHandle(), reinterpret_cast<const char*>(pkt), sizeof(pkt), 0,
+                       reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+                received = waitForYaw(second, 22.0f);
+            }
+            Check(received, "adopted socket keeps publishing");
+            second.Stop();
+        } else {
+            std::cout << "  [SKIP] hub test port unavailable\n";
+        }
+    }
+
+    // Receive-path statistics.
+    {
+        using cameraunlock::ReceiverStats;
+        using cameraunlock::ReceiverStatsSnapshot;
+
+        ReceiverStats stats;
+        int64_t t = 1000000;
+        stats.RecordPacket(t);
+        for (int i = 0; i < 99; ++i) {
+            t += 8333;  // 120 Hz
+            stats.RecordPacket(t);
+        }
+        t += 50000;     // One 50 ms stall
+        stats.RecordPacket(t);
+        stats.RecordMalformed();
+        stats.RecordSuperseded();
+
+        ReceiverStatsSnapshot snap = stats.Snapshot();
+        Check(snap.packets == 101 && snap.malformed == 1 && snap.superseded == 1,
+              "stats count packets, malformed, superseded");
+        Check(snap.intervals == 100 && snap.buckets[6] == 99 && snap.buckets[8] == 1,
+              "stats bucket intervals on the log scale");
+        Check(std::fabs(snap.minIntervalMs - 8.333) < 1e-6, "stats track min interval");
+        Check(std::fabs(snap.meanIntervalMs - (99 * 8.333 + 50.0) / 100.0) < 1e-6,
+              "stats track mean interval");
+        Check(snap.p99IntervalMs == 16.0, "stats p99 is the 99th-percentile bucket bound");
+
+        stats.Reset();
+        snap = stats.Snapshot();
+        Check(snap.packets == 0 && snap.intervals == 0 && snap.p99IntervalMs == 0.0,
+              "stats reset clears counters");
+    }
+
+    // Capture and replay round trip.
+    {
+        using cameraunlock::CaptureWriter;
+        using cameraunlock::ReplaySource;
+        using cameraunlock::TrackingSample;
+
+        const char* path = "cameraunlock_capture_test.bin";
+        CaptureWriter writer;
+        bool opened = writer.Open(path);
+        Check(opened, "capture file opens");
+        if (opened) {
+            uint8_t pkt[48];
+            BuildPacket(pkt, 100, 0, 0, 1, 0, 0);
+            writer.Append(pkt, sizeof(pkt), 1000);
+            writer.Append(pkt, 10, 1500);  // Truncated datagram
+            BuildPacket(pkt, 200, 0, 0, 2, 0, 0);
+            writer.Append(pkt, sizeof(pkt), 9000);
+            BuildPacket(pkt, 300, 0, 0, 3, 0, 0);
+            writer.Append(pkt, sizeof(pkt), 17000);
+            writer.Close();
+
+            ReplaySource replay;
+            Check(replay.Open(path), "replay maps the capture");
+
+            TrackingSample s;
+            bool fast = replay.Next(s) && s.yaw == 1.0f && s.x == 1.0f && s.timestamp_us == 1000 &&
+                        replay.Next(s) && s.yaw == 2.0f && s.timestamp_us == 9000 &&
+                        replay.Next(s) && s.yaw == 3.0f && s.sequence == 3 &&
+                        !replay.Next(s) && replay.IsAtEnd();
+            Check(fast, "fast replay yields every valid record with recorded timestamps");
+            Check(replay.GetMalformedCount() == 1, "fast replay counts malformed records");
+
+            const int64_t start = 5000000;
+            replay.BeginRealtime(start);
+            bool realtime = replay.Update(start) && replay.TryGetSample(s) && s.yaw == 1.0f &&
+                            s.timestamp_us == start &&
+                            !replay.Update(start + 7000) &&
+                            replay.Update(start + 16000) && replay.TryGetSample(s) && s.yaw == 3.0f &&
+                            s.timestamp_us == start + 16000;
+            Check(realtime, "real-time replay publishes records as they come due");
+            replay.Close();
+        }
+        std::remove(path);
+
+        ReplaySource bogus;
+        Check(!bogus.Open("cameraunlock_missing_capture.bin") && bogus.IsFailed(),
+              "replay rejects a missing file");
+    }
+
+    // Load generator: deterministic, ordered, faults accounted for.
+    {
+        using cameraunlock::DatagramKind;
+        using cameraunlock::GeneratedDatagram;
+        using cameraunlock::LoadGenerator;
+        using cameraunlock::LoadPhase;
+
+        LoadPhase phase;
+        phase.durationMs = 4000;
+        phase.rateHz = 500.0;
+        phase.senders = 3;
+        phase.jitterMs = 2.0;
+        phase.burstIntervalMs = 250.0;
+        phase.burstHoldMs = 30.0;
+        phase.loss = 0.1;
+        phase.reorder = 0.05;
+        phase.duplicate = 0.05;
+        phase.malformed = 0.05;
+        phase.outOfRange = 0.05;
+
+        auto run = [&](uint64_t seed, std::vector<GeneratedDatagram>& out) {
+            LoadGenerator generator;
+            generator.SetSeed(seed);
+            generator.AddPhase(phase);
+            generator.Begin();
+            GeneratedDatagram d;
+            while (generator.Next(d)) out.push_back(d);
+            return generator.GetCounters();
+        };
+        std::vector<GeneratedDatagram> a, b, c;
+        const auto counters = run(42, a);
+        run(42, b);
+        run(43, c);
+
+        bool same = a.size() == b.size();
+        for (size_t i = 0; same && i < a.size(); ++i) {
+            same = a[i].dueUs == b[i].dueUs && a[i].length == b[i].length &&
+                   std::memcmp(a[i].data, b[i].data, a[i].length) == 0;
+        }
+        Check(same, "generator is deterministic for a seed");
+        bool differs = a.size() != c.size();
+        for (size_t i = 0; !differs && i < a.size(); ++i) differs = a[i].dueUs != c[i].dueUs;
+        Check(differs, "another seed gives another schedule");
+
+        bool ordered = true;
+        bool sendersCycle = true;
+        for (size_t i = 1; i < a.size(); ++i) {
+            ordered = ordered && a[i].dueUs >= a[i - 1].dueUs;
+            sendersCycle = sendersCycle && a[i].sender == (a[i].sequence - 1) % 3;
+        }
+        Check(ordered && sendersCycle, "datagrams come out in due order and senders interleave");
+
+        Check(counters.nominal == 6000 && counters.emitted == a.size() &&
+              counters.emitted == counters.nominal - counters.lost + counters.duplicated,
+              "every nominal datagram is emitted, lost or duplicated");
+        Check(counters.lost > 480 && counters.lost < 720 && counters.reordered > 0 &&
+              counters.burstHeld > 0, "fault rates follow the phase");
+
+        bool faultsRejected = true;
+        bool cleanMatches = true;
+        uint64_t absurd = 0;
+        for (const GeneratedDatagram& d : a) {
+            TrackingPose pose;
+            PositionData pos;
+            const bool parsed = OpenTrackPacket::TryParseAll(d.data, d.length, pose, pos);
+            if (d.kind == DatagramKind::Malformed) {
+                faultsRejected = faultsRejected && !parsed;
+            } else if (d.kind == DatagramKind::OutOfRange) {
+                if (parsed) ++absurd;
+            } else {
+                TrackingPose expected;
+                PositionData expectedPos;
+                LoadGenerator::PoseAt(phase, d.sender, d.sourceUs, expected, expectedPos);
+                cleanMatches = cleanMatches && parsed && pose.yaw == expected.yaw &&
+                               std::fabs(pos.x - expectedPos.x) < 1e-6f;
+            }
+        }
+        Check(faultsRejected, "malformed datagrams never parse");
+        Check(absurd > 0 && absurd < counters.outOfRange, "out-of-range mixes rejected and absurd values");
+        Check(cleanMatches, "clean datagrams carry the reference motion");
+
+        // Phases run back to back at their own rates
+        LoadGenerator phased;
+        LoadPhase slow;
+        slow.durationMs = 100;
+        slow.rateHz = 100.0;
+        LoadPhase fast = slow;
+        fast.rateHz = 1000.0;
+        phased.AddPhase(slow);
+        phased.AddPhase(fast);
+        phased.Begin();
+        GeneratedDatagram d;
+        int slowCount = 0;
+        int fastCount = 0;
+        while (phased.Next(d)) {
+            (d.dueUs < 100000 ? slowCount : fastCount)++;
+        }
+        Check(slowCount == 10 && fastCount == 100, "phases run in order at their own rates");
+
+        // Extended packets through a sender timeline: every late copy dropped
+        LoadGenerator extended;
+        LoadPhase ext;
+        ext.durationMs = 2000;
+        ext.reorder = 0.05;
+        ext.duplicate = 0.05;
+        ext.malformed = 0.02;
+        ext.extended = true;
+        extended.AddPhase(ext);
+        extended.Begin();
+        cameraunlock::SenderTimeline timeline;
+        uint64_t newest = 0;
+        uint64_t dropped = 0;
+        bool monotonic = true;
+        bool allExtended = true;
+        while (extended.Next(d)) {
+            TrackingPose pose;
+            PositionData pos;
+            OpenTrackPacket::ExtendedHeader header;
+            const auto format = OpenTrackPacket::TryParseAny(d.data, d.length, pose, pos, header);
+            if (d.kind == DatagramKind::Malformed) continue;
+            allExtended = allExtended && format == OpenTrackPacket::Format::Extended &&
+                          header.sequence == static_cast<uint16_t>(d.sequence);
+            int64_t sourceUs;
+            if (timeline.Accept(header, 1000000 + d.dueUs, sourceUs)) {
+                monotonic = monotonic && d.sequence > newest;
+                newest = d.sequence;
+            } else {
+                ++dropped;
+            }
+        }
+        Check(allExtended, "extended phase sends sequence-stamped extended packets");
+        Check(monotonic && dropped >= extended.GetCounters().duplicated,
+              "timeline passes only newer sequences and drops the late copies");
+    }
+
+    // Load generator over a capture and from a profile.
+    {
+        using cameraunlock::CaptureWriter;
+        using cameraunlock::GeneratedDatagram;
+        using cameraunlock::LoadGenerator;
+        using cameraunlock::LoadPhase;
+
+        const char* capturePath = "cameraunlock_loadgen_capture.bin";
+        CaptureWriter writer;
+        if (writer.Open(capturePath)) {
+            uint8_t pkt[48];
+            for (int i = 0; i < 3; ++i) {
+                BuildPacket(pkt, 0, 0, 0, i + 1, 0, 0);
+                writer.Append(pkt, sizeof(pkt), 50000 + i * 10000);
+            }
+            writer.Close();
+        }
+
+        LoadGenerator generator;
+        LoadPhase phase;
+        phase.durationMs = 60;
+        generator.AddPhase(phase);
+        bool loaded = generator.UseCapture(capturePath);
+        generator.Begin();
+        std::vector<GeneratedDatagram> out;
+        GeneratedDatagram d;
+        while (generator.Next(d)) out.push_back(d);
+        TrackingPose pose;
+        bool looped = loaded && out.size() == 6;
+        for (size_t i = 0; looped && i < out.size(); ++i) {
+            looped = out[i].dueUs == static_cast<int64_t>(i) * 10000 &&
+                     OpenTrackPacket::TryParse(out[i].data, out[i].length, pose) &&
+                     pose.yaw == static_cast<float>(i % 3 + 1);
+        }
+        Check(looped, "capture stream loops with its own spacing");
+        std::remove(capturePath);
+
+        const char* profilePath = "cameraunlock_loadgen_profile.ini";
+        if (FILE* f = std::fopen(profilePath, "w")) {
+            std::fputs("[generator]\nseed = 7\n\n[phase1]\nduration_ms = 50\nrate_hz = 200\n\n"
+                       "[phase2]\nduration_ms = 50\nloss = 1\n\n[phase4]\nduration_ms = 50\n", f);
+            std::fclose(f);
+        }
+        LoadGenerator scripted;
+        bool profiled = scripted.LoadProfile(profilePath) && scripted.GetSeed() == 7 &&
+                        scripted.GetPhases().size() == 2 && scripted.GetPhases()[1].rateHz == 200.0;
+        scripted.Begin();
+        int emitted = 0;
+        while (scripted.Next(d)) ++emitted;
+        Check(profiled && emitted == 10 && scripted.GetCounters().lost == 10,
+              "profile phases inherit from the previous one");
+        std::remove(profilePath);
+    }
+
+    // Pipeline trace: stage stamps, spans and slot reuse.
+    {
+        using cameraunlock::PipelineTrace;
+        using cameraunlock::TraceSpan;
+        using cameraunlock::TraceStage;
+
+        auto* trace = new PipelineTrace;
+        for (uint64_t id = 1; id <= 100; ++id) {
+            const int64_t t = static_cast<int64_t>(id) * 10000;
+            trace->BeginSample(id, t, t + 50);
+            trace->MarkProcessed(id, t + 1000, t + 1000 + static_cast<int64_t>(id));
+            trace->MarkProcessed(id, t + 5000, t + 6000);  // Later frame: ignored
+            trace->MarkPresent(t + 3000);
+            trace->MarkPresent(t + 9000);                  // Repeat present: ignored
+        }
+        trace->Mark(5000, TraceStage::Present, 1);          // Never opened: ignored
+
+        auto summary = trace->Summarize();
+        const auto& process = summary.Get(TraceSpan::Process);
+        Check(summary.samples == 100 && summary.Get(TraceSpan::Receive).p50Us == 50.0 &&
+              summary.Get(TraceSpan::Wait).maxUs == 950.0 && summary.Get(TraceSpan::Total).p99Us == 3000.0,
+              "trace keeps the first stamp of each stage");
+        Check(process.count == 100 && process.p50Us == 51.0 && process.maxUs == 100.0 &&
+              process.meanUs == 50.5, "trace span percentiles");
+
+        // A sample kCapacity later takes the slot over
+        trace->BeginSample(1 + PipelineTrace::kCapacity, 50, 60);
+        trace->Mark(1, TraceStage::ProcessBegin, 70);
+        summary = trace->Summarize();
+        Check(summary.samples == 100 && summary.Get(TraceSpan::Process).count == 99,
+              "reused slot drops the older sample");
+
+        const char* path = "cameraunlock_trace_test.json";
+        bool wrote = trace->WriteChromeTrace(path);
+        std::string json;
+        if (FILE* f = std::fopen(path, "r")) {
+            char chunk[4096];
+            size_t n;
+            while ((n = std::fread(chunk, 1, sizeof(chunk), f)) > 0) json.append(chunk, n);
+            std::fclose(f);
+        }
+        std::remove(path);
+        Check(wrote && json.find("\"traceEvents\"") != std::string::npos &&
+              json.find("\"name\": \"process\"") != std::string::npos && json.rfind("]}") != std::string::npos,
+              "trace exports Chrome trace events");
+
+        trace->Reset();
+        Check(trace->Summarize().samples == 0, "trace reset forgets every record");
+        delete trace;
+    }
+
+    // Pipeline trace end to end: receiver -> processor -> present.
+    {
+        using cameraunlock::PipelineTrace;
+        using cameraunlock::TraceSpan;
+        using cameraunlock::TrackingProcessor;
+        using cameraunlock::TrackingSample;
+        using cameraunlock::UdpReceiver;
+        using cameraunlock::UdpSocket;
+        constexpr uint16_t kTraceTestPort = 47431;
+
+        auto* trace = new PipelineTrace;
+        UdpReceiver receiver;
+        receiver.SetPipelineTrace(trace);
+        TrackingProcessor processor;
+        processor.SetPipelineTrace(trace);
+        UdpSocket sender;
+        if (receiver.Start(kTraceTestPort) && !receiver.IsFailed() && sender.Open(0)) {
+            sockaddr_in addr = {};
+            addr.sin_family = AF_INET;
+            addr.sin_port = htons(kTraceTestPort);
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            uint64_t processed = 0;
+            for (int i = 0; i < 5; ++i) {
+                uint8_t pkt[48];
+                BuildPacket(pkt, 0, 0, 0, i, 0, 0);
+                sendto(sender.GetHandle(), reinterpret_cast<const char*>(pkt), sizeof(pkt), 0,
+                       reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+                TrackingSample sample;
+                for (int wait = 0; wait < 200; ++wait) {
+                    if (receiver.TryGetSample(sample) && sample.sequence > processed) break;
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                if (sample.sequence > processed) {
+                    processed = sample.sequence;
+                    processor.Process(sample, 0.016f);
+                    trace->MarkPresent(TrackingPose::CurrentTimestamp());
+                }
+            }
+            const auto summary = trace->Summarize();
+            Check(processed == 5 && summary.samples == 5 && summary.Get(TraceSpan::Total).count == 5 &&
+                  summary.Get(TraceSpan::Total).p50Us >= summary.Get(TraceSpan::Process).p50Us,
+                  "every received sample is traced to its present");
+        } else {
+            std::cout << "  [SKIP] trace test port unavailable\n";
+        }
+        receiver.Stop();
+        delete trace;
+    }
+
+    // Extended packet: detection, round trip, fallback.
+    {
+        using ExtendedHeader = OpenTrackPacket::ExtendedHeader;
+        using Format = OpenTrackPacket::Format;
+
+        uint8_t ext[OpenTrackPacket::kExtendedPacketSize];
+        ExtendedHeader header;
+        header.sequence = 0xfffe;
+        header.send_us = 123456789u;
+        OpenTrackPacket::EncodeExtended(ext, header, 10.0f, -20.0f, 30.0f, 15.0f, -5.0f, 2.5f);
+        TrackingPose pose;
+        PositionData pos;
+        ExtendedHeader parsed;
+        Check(OpenTrackPacket::TryParseAny(ext, sizeof(ext), pose, pos, parsed) == Format::Extended &&
+              parsed.sequence == 0xfffe && parsed.send_us == 123456789u,
+              "extended header round-trips");
+        Check(pose.yaw == 15.0f && pose.pitch == -5.0f && pose.roll == 2.5f &&
+              std::fabs(pos.x - 0.1f) < 1e-6f && std::fabs(pos.y + 0.2f) < 1e-6f,
+              "extended pose decoded (cm -> m)");
+
+        uint8_t legacy[64] = {};
+        BuildPacket(legacy, 100, 0, 0, 7, 0, 0);
+        legacy[0] = OpenTrackPacket::kExtendedMagic;  // magic alone doesn't make it extended
+        Check(OpenTrackPacket::TryParseAny(legacy, 48, pose, pos, parsed) == Format::OpenTrack &&
+              pose.yaw == 7.0f,
+              "48-byte packet parses as OpenTrack");
+
+        uint8_t bad[OpenTrackPacket::kExtendedPacketSize];
+        std::memcpy(bad, ext, sizeof(bad));
+        bad[1] = 2;
+        Check(OpenTrackPacket::TryParseAny(bad, sizeof(bad), pose, pos, parsed) == Format::Invalid,
+              "unknown extended version rejected");
+        bad[1] = OpenTrackPacket::kExtendedVersion;
+        const float nan = std::numeric_limits<float>::quiet_NaN();
+        std::memcpy(bad + OpenTrackPacket::kExtendedPoseOffset + 12, &nan, sizeof(nan));
+        Check(OpenTrackPacket::TryParseAny(bad, sizeof(bad), pose, pos, parsed) == Format::Invalid,
+              "NaN extended rotation rejected");
+        Check(OpenTrackPacket::TryParseAny(ext, sizeof(ext) - 1, pose, pos, parsed) == Format::Invalid,
+              "truncated extended packet rejected");
+    }
+
+    // Sender timeline: ordering and clock mapping.
+    {
+        using cameraunlock::SenderTimeline;
+        using ExtendedHeader = OpenTrackPacket::ExtendedHeader;
+
+        auto header = [](uint16_t sequence, uint32_t sendUs) {
+            ExtendedHeader h;
+            h.sequence = sequence;
+            h.send_us = sendUs;
+            return h;
+        };
+
+        // 4 ms sender period, 1 ms base latency plus up to 3 ms jitter
+        SenderTimeline timeline;
+        const int64_t clockOffsetUs = 5000000;
+        const int jitterUs[] = {0, 3000, 1200, 2500, 400, 2900, 1700, 100};
+        bool accepted = true;
+        bool uniform = true;
+        int64_t lastSourceUs = 0;
+        for (int i = 0; i < 8; ++i) {
+            const uint32_t sendUs = 0xffff0000u + static_cast<uint32_t>(i) * 4000u;  // wraps mid-run
+            const int64_t arrivalUs = clockOffsetUs + 1000 + i * 4000 + jitterUs[i];
+            int64_t sourceUs = 0;
+            accepted = timeline.Accept(header(static_cast<uint16_t>(65533 + i), sendUs), arrivalUs, sourceUs) &&
+                       accepted;
+            if (i >= 1) uniform = uniform && sourceUs - lastSourceUs == 4000;
+            lastSourceUs = sourceUs;
+        }
+        Check(accepted, "in-order packets accepted across sequence and clock wrap");
+        Check(uniform, "mapped send times keep the sender's spacing despite jitter");
+
+        int64_t sourceUs = 0;
+        Check(!timeline.Accept(header(4, 0xffff0000u + 7 * 4000u), clockOffsetUs + 40000, sourceUs),
+              "duplicate sequence dropped");
+        Check(!timeline.Accept(header(1, 0xffff0000u + 4 * 4000u), clockOffsetUs + 41000, sourceUs),
+              "late sequence dropped");
+        // Restarted bridge: sequence back to 0, send clock still running
+        const uint32_t restartSendUs = 0xffff0000u + 20 * 4000u;
+        Check(timeline.Accept(header(0, restartSendUs), clockOffsetUs + 90000, sourceUs) &&
+              sourceUs == clockOffsetUs + 90000,
+              "sender restart resynchronizes");
+        Check(timeline.Accept(header(1, restartSendUs + 4000u), clockOffsetUs + 108000, sourceUs) &&
+              sourceUs == clockOffsetUs + 94000,
+              "restarted sender maps onto its least-delayed packet");
+    }
+
+    // Extended packets through the receiver: late ones counted and dropped.
+    {
+        using cameraunlock::TrackingSample;
+        using cameraunlock::UdpReceiver;
+        using cameraunlock::UdpSocket;
+        constexpr uint16_t kExtendedTestPort = 47433;
+
+        UdpReceiver receiver;
+        UdpSocket sender;
+        if (receiver.Start(kExtendedTestPort) && !receiver.IsFailed() && sender.Open(0)) {
+            sockaddr_in addr = {};
+            addr.sin_family = AF_INET;
+            addr.sin_port = htons(kExtendedTestPort);
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            auto send = [&](uint16_t sequence, uint32_t sendUs, float yaw) {
+                uint8_t pkt[OpenTrackPacket::kExtendedPacketSize];
+                OpenTrackPacket::ExtendedHeader header;
+                header.sequence = sequence;
+                header.send_us = sendUs;
+                OpenTrackPacket::EncodeExtended(pkt, header, 0, 0, 0, yaw, 0, 0);
+                sendto(sender.GetHandle(), reinterpret_cast<const char*>(pkt), sizeof(pkt), 0,
+                       reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+            };
+            auto waitFor = [&](auto done) {
+                for (int i = 0; i < 200 && !done(); ++i) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                }
+                return done();
+            };
+
+            send(10, 1000, 1.0f);
+            send(12, 9000, 3.0f);
+            send(11, 5000, 2.0f);  // Overtaken
+            send(12, 9000, 3.0f);  // Duplicate
+            Check(waitFor([&] { return receiver.GetStats().reordered == 2; }) &&
+                  receiver.GetStats().packets == 2,
+                  "receiver drops late and duplicate extended packets");
+            TrackingSample sample;
+            Check(receiver.TryGetSample(sample) && sample.yaw == 3.0f && sample.source_us != 0 &&
+                  sample.source_us <= sample.timestamp_us && sample.MeasurementUs() == sample.source_us,
+                  "published sample carries the mapped send time");
+
+            uint8_t pkt[48];
+            BuildPacket(pkt, 0, 0, 0, 4, 0, 0);
+            sendto(sender.GetHandle(), reinterpret_cast<const char*>(pkt), sizeof(pkt), 0,
+                   reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+            Check(waitFor([&] { return receiver.TryGetSample(sample) && sample.yaw == 4.0f; }) &&
+                  sample.source_us == 0 && sample.MeasurementUs() == sample.timestamp_us,
+                  "OpenTrack packets still accepted alongside");
+        } else {
+            std::cout << "  [SKIP] extended test port unavailable\n";
+        }
+        receiver.Stop();
+    }
+
+    // Polling receiver: a late tail doesn't hide the newest accepted packet.
+    {
+        using cameraunlock::PollingUdpReceiver;
+        using cameraunlock::ReplaySource;
+        using cameraunlock::TrackingSample;
+        using cameraunlock::UdpSocket;
+        constexpr uint16_t kPollingTestPort = 47437;
+        const char* capturePath = "cameraunlock_polling_capture.bin";
+
+        PollingUdpReceiver receiver;
+        UdpSocket sender;
+        if (receiver.Initialize(kPollingTestPort) && sender.Open(0)) {
+            sockaddr_in addr = {};
+            addr.sin_family = AF_INET;
+            addr.sin_port = htons(kPollingTestPort);
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            auto send = [&](uint16_t sequence, uint32_t sendUs, float yaw) {
+                uint8_t pkt[OpenTrackPacket::kExtendedPacketSize];
+                OpenTrackPacket::ExtendedHeader header;
+                header.sequence = sequence;
+                header.send_us = sendUs;
+                OpenTrackPacket::EncodeExtended(pkt, header, 0, 0, 0, yaw, 0, 0);
+                sendto(sender.GetHandle(), reinterpret_cast<const char*>(pkt), sizeof(pkt), 0,
+                       reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+            };
+
+            send(10, 1000, 1.0f);
+            send(12, 9000, 3.0f);
+            send(11, 5000, 2.0f);  // Overtaken, and newest in the queue
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            float yaw = 0.0f, pitch = 0.0f, roll = 0.0f;
+            Check(receiver.Poll() && receiver.GetRawRotation(yaw, pitch, roll) && yaw == 3.0f &&
+                  receiver.GetPacketsReordered() == 1 && receiver.GetLastPollDiscarded() == 1,
+                  "polling receiver keeps the newest accepted packet behind a late one");
+
+            if (receiver.StartCapture(capturePath)) {
+                send(13, 13000, 4.0f);
+                send(12, 9000, 3.0f);  // Duplicate
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                TrackingSample polled;
+                bool polledOk = receiver.Poll() && receiver.TryGetSample(polled);
+                receiver.StopCapture();
+
+                ReplaySource replay;
+                TrackingSample replayed;
+                Check(polledOk && polled.yaw == 4.0f && replay.Open(capturePath) &&
+                      replay.Next(replayed) && replayed.yaw == 4.0f &&
+                      replayed.timestamp_us == polled.timestamp_us,
+                      "capturing poll stamps the sample with its recorded arrival");
+                replay.Close();
+            }
+            std::remove(capturePath);
+        } else {
+            std::cout << "  [SKIP] polling test port unavailable\n";
+        }
+        receiver.Shutdown();
+    }
+
+    // Center commands: applied by the receive thread with the next packet.
+    {
+        using cameraunlock::TrackingSample;
+        using cameraunlock::UdpReceiver;
+        using cameraunlock::UdpSocket;
+        constexpr uint16_t kCenterTestPort = 47435;
+
+        UdpReceiver receiver;
+        UdpSocket sender;
+        if (receiver.Start(kCenterTestPort) && !receiver.IsFailed() && sender.Open(0)) {
+            sockaddr_in addr = {};
+            addr.sin_family = AF_INET;
+            addr.sin_port = htons(kCenterTestPort);
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            uint64_t seen = 0;
+            TrackingSample sample;
+            // Send one packet and wait until it is published
+            auto sendYaw = [&](double yaw, double pitch) {
+                uint8_t pkt[48];
+                BuildPacket(pkt, 0, 0, 0, yaw, pitch, 0);
+                sendto(sender.GetHandle(), reinterpret_cast<const char*>(pkt), sizeof(pkt), 0,
+                       reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+                for (int i = 0; i < 200; ++i) {
+                    if (receiver.TryGetSample(sample) && sample.sequence > seen) break;
+                    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                }
+                const bool published = sample.sequence > seen;
+                seen = sample.sequence;
+                return published;
+            };
+            float yaw = 0, pitch = 0, roll = 0;
+
+            sendYaw(10.0, 4.0);
+            receiver.Recenter();
+            Check(receiver.GetRotation(yaw, pitch, roll) && yaw == 10.0f,
+                  "pending recenter leaves the published sample alone");
+            Check(sendYaw(12.0, 5.0) && receiver.GetRotation(yaw, pitch, roll) && yaw == 0.0f && pitch == 0.0f &&
+                  sample.center_yaw == 12.0f && sample.center_pitch == 5.0f,
+                  "recenter lands on the next packet with it");
+            Check(sendYaw(15.0, 5.0) && receiver.GetRotation(yaw, pitch, roll) && yaw == 3.0f,
+                  "center persists across packets");
+
+            Check(receiver.SetCenter(5.0f, 1.0f, 0.0f) && sendYaw(15.0, 5.0) &&
+                  receiver.GetRotation(yaw, pitch, roll) && yaw == 10.0f && pitch == 4.0f,
+                  "explicit center applies");
+            receiver.Recenter();
+            Check(receiver.ResetCenter() && sendYaw(20.0, 5.0) && receiver.GetRotation(yaw, pitch, roll) &&
+                  yaw == 20.0f && sample.center_yaw == 0.0f,
+                  "queued commands apply in order (recenter then reset)");
+
+            // Nothing arrives, so nothing drains
+            int accepted = 0;
+            for (size_t i = 0; i < UdpReceiver::kCommandCapacity + 2; ++i) {
+                if (receiver.SetCenter(1.0f, 0.0f, 0.0f)) ++accepted;
+            }
+            Check(accepted == static_cast<int>(UdpReceiver::kCommandCapacity), "full command queue refuses");
+            receiver.Stop();
+            Check(receiver.ResetCenter(), "stop discards pending commands");
+        } else {
+            std::cout << "  [SKIP] center test port unavailable\n";
+        }
+        receiver.Stop();
+    }
+
     return g_failures;
 }
@@ -0,0 +1,396 @@
+// Overlay primitive tests.
+//
+// The CPU side of the instanced SDF primitives mirrors the pixel shader:
+// distances must be exact for each shape, coverage must be a one-pixel
+// ramp centred on the edge, and the quad a primitive expands to must
+// contain every pixel the shape can touch. The native DX12 draw context
+// must emit one primitive per shape and keep its storage across frames,
+// and the overlay timing windows must report exact min/avg/p99 and render
+// their stats line with the built-in font. Text lays out on the 5x7 font
+// grid and glyph instances light exactly the font's texels. The batched GUI marker
+// compensation must agree with the single-marker form, and a cached
+// FrameProjectionContext must project and unproject consistently. The
+// shader source is scanned for reserved HLSL words used as names, which
+// D3DCompile would only reject at runtime, in the game.
+
+#include "cameraunlock/rendering/crosshair_projection.h"
+#include "cameraunlock/rendering/dx12_native_overlay.h"
+#include "cameraunlock/rendering/gui_marker_compensation.h"
+#include "cameraunlock/rendering/overlay_font.h"
+#include "cameraunlock/rendering/overlay_primitives.h"
+#include "cameraunlock/rendering/overlay_timing.h"
+
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+namespace {
+
+int g_failures = 0;
+
+void Check(bool cond, const char* name) {
+    if (cond) {
+        std::cout << "  [PASS] " << name << "\n";
+    } else {
+        std::cout << "  [FAIL] " << name << "\n";
+        ++g_failures;
+    }
+}
+
+bool Near(float a, float b, float eps = 1e-4f) {
+    return std::fabs(a - b) <= eps;
+}
+
+bool IsIdentChar(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+// HLSL types and keywords that D3DCompile refuses as a variable name
+bool IsReservedHlslWord(const std::string& word) {
+    static const char* const kReserved[] = {
+        "half", "double", "float", "int", "uint", "bool", "dword", "vector", "matrix",
+        "min16float", "min10float", "min16int", "min12int", "min16uint", "string",
+        "sampler", "texture", "in", "out", "inout", "point", "line", "triangle",
+        "lineadj", "triangleadj", "linear", "centroid", "nointerpolation",
+        "noperspective", "sample", "precise", "shared", "groupshared", "static",
+        "uniform", "volatile", "const", "register", "packoffset", "pass", "technique",
+        "compile", "discard", "row_major", "column_major", "snorm", "unorm", "extern",
+        "inline", "interface", "class", "struct", "cbuffer", "tbuffer", "typedef",
+        "return", "true", "false", "NULL", "asm", "namespace", "sizeof",
+    };
+    for (const char* r : kReserved) {
+        if (word == r) return true;
+    }
+    return false;
+}
+
+// Name declared with a reserved word (e.g. "float half = ..."), or empty.
+// Catches the class of mistake that makes D3DCompile reject the source,
+// which the overlays only report as a failed compile at runtime.
+std::string FindReservedHlslDeclaration(const std::string& src) {
+    static const char* const kScalarTypes[] = {"float", "int", "uint", "bool", "half", "double"};
+    std::string previous;
+    for (size_t i = 0; i < src.size();) {
+        if (!IsIdentChar(src[i]) || (i > 0 && (IsIdentChar(src[i - 1]) || src[i - 1] == '.'))) {
+            if (!std::isspace(static_cast<unsigned char>(src[i]))) previous.clear();
+            ++i;
+            continue;
+        }
+        size_t end = i;
+        while (end < src.size() && IsIdentChar(src[end])) ++end;
+        const std::string word = src.substr(i, end - i);
+        bool previousIsType = false;
+        for (const char* t : kScalarTypes) {
+            // float, float2, float4x4, ...
+            if (previous.compare(0, std::strlen(t), t) == 0 &&
+                previous.find_first_not_of("1234x", std::strlen(t)) == std::string::npos) {
+                previousIsType = true;
+            }
+        }
+        if (previousIsType && IsReservedHlslWord(word)) return word;
+        previous = word;
+        i = end;
+    }
+    return {};
+}
+
+// Every pixel with non-zero coverage lies inside the primitive's bounds
+bool BoundsCoverShape(const cameraunlock::rendering::OverlayPrimitive& p) {
+    using namespace cameraunlock::rendering;
+    const OverlayPrimitiveBounds b = GetOverlayPrimitiveBounds(p);
+    for (int y = -40; y < 140; ++y) {
+        for (int x = -40; x < 140; ++x) {
+            const float px = x + 0.5f, py = y + 0.5f;
+            if (OverlayPrimitiveCoverage(p, px, py) <= 0.0f) continue;
+            if (px < b.x0 || px > b.x1 || py < b.y0 || py > b.y1) return false;
+        }
+    }
+    return true;
+}
+
+// Stand-in draw context for the stats line: records the backing rect and
+// the text handed to DrawString
+struct StatsLineRecorder {
+    int rects = 0;
+    float rectW = 0.0f, rectH = 0.0f;
+    int strings = 0;
+    std::string text;
+    float scale = 0.0f;
+    void DrawRect(float, float, float w, float h, cameraunlock::rendering::Rgba) {
+        ++rects;
+        rectW = w;
+        rectH = h;
+    }
+    void DrawString(float, float, const char* s, cameraunlock::rendering::Rgba, float textScale) {
+        ++strings;
+        text = s;
+        scale = textScale;
+    }
+};
+
+} // namespace
+
+int RunRenderingTests() {
+    using namespace cameraunlock::rendering;
+
+    std::cout << "Rendering tests\n";
+
+    {
+        const OverlayPrimitive line = MakeLinePrimitive(10, 20, 50, 20, 0xFFFFFFFF, 4.0f);
+        Check(Near(OverlayPrimitiveDistance(line, 30, 20), -2.0f), "line: centre is half thickness inside");
+        Check(Near(OverlayPrimitiveDistance(line, 30, 25), 3.0f), "line: distance across the line");
+        Check(Near(OverlayPrimitiveDistance(line, 55, 20), 5.0f), "line: butt cap past the end");
+
+        const OverlayPrimitive diagonal = MakeLinePrimitive(0, 0, 30, 40, 0xFFFFFFFF, 2.0f);
+        Check(Near(OverlayPrimitiveDistance(diagonal, 15 + 4, 20 - 3), 4.0f), "line: rotated frame");
+    }
+
+    {
+        const OverlayPrimitive dot = MakeCirclePrimitive(50, 50, 10, 0xFFFFFFFF);
+        Check(Near(OverlayPrimitiveDistance(dot, 50, 50), -10.0f) && Near(OverlayPrimitiveDistance(dot, 50, 65), 5.0f),
+              "circle: signed distance");
+
+        const OverlayPrimitive ring = MakeRingPrimitive(50, 50, 10, 2, 0xFFFFFFFF);
+        Check(Near(OverlayPrimitiveDistance(ring, 59, 50), -1.0f), "ring: inside the band");
+        Check(Near(OverlayPrimitiveDistance(ring, 50, 50), 8.0f) && Near(OverlayPrimitiveDistance(ring, 63, 50), 3.0f),
+              "ring: hole and outside");
+
+        const OverlayPrimitive rect = MakeRectPrimitive(10, 10, 20, 10, 0xFFFFFFFF);
+        Check(Near(OverlayPrimitiveDistance(rect, 20, 15), -5.0f) && Near(OverlayPrimitiveDistance(rect, 33, 24), 5.0f),
+              "rect: inside and corner distance");
+    }
+
+    {
+        // Pixel-aligned edge: the pixel just inside is fully covered, the
+        // one just outside is empty, and a half-covered centre reads 0.5
+        const OverlayPrimitive rect = MakeRectPrimitive(10, 10, 20, 10, 0xFFFFFFFF);
+        Check(Near(OverlayPrimitiveCoverage(rect, 10.5f, 15.5f), 1.0f) &&
+                  Near(OverlayPrimitiveCoverage(rect, 9.5f, 15.5f), 0.0f),
+              "coverage: crisp on pixel-aligned edges");
+        Check(Near(OverlayPrimitiveCoverage(rect, 10.0f, 15.0f), 0.5f), "coverage: half on the edge");
+
+        OverlayPrimitive soft = rect;
+        soft.softness = 4.0f;
+        Check(Near(OverlayPrimitiveCoverage(soft, 9.0f, 15.0f), 0.25f) && Near(OverlayPrimitiveCoverage(soft, 11.0f, 15.0f), 0.75f),
+              "coverage: softness widens the ramp");
+    }
+
+    {
+        Check(BoundsCoverShape(MakeLinePrimitive(5, 90, 80, 10, 0xFFFFFFFF, 3.0f)) &&
+                  BoundsCoverShape(MakeCirclePrimitive(40, 40, 17.5f, 0xFFFFFFFF)) &&
+                  BoundsCoverShape(MakeRingPrimitive(60, 30, 25, 3, 0xFFFFFFFF)) &&
+                  BoundsCoverShape(MakeRectPrimitive(12.25f, 7.5f, 33, 51, 0xFFFFFFFF)),
+              "bounds: quad contains every covered pixel");
+    }
+
+    {
+        DX12DrawContext dc;
+        dc.Reset(1920, 1080);
+        dc.DrawCross(960, 540, 12.0f, 0xFFFFFFFF, 1.5f, 4.0f);
+        dc.DrawDot(960, 540, 2.0f, 0xFF0000FF);
+        dc.DrawLine(5, 5, 5, 5, 0xFFFFFFFF);  // degenerate, dropped
+        Check(dc.Primitives().size() == 5 && dc.Primitives()[4].kind == OverlayPrimitiveKind::Circle,
+              "dx12 context: one primitive per shape");
+        dc.DrawCross(0, 0, 4.0f, 0xFFFFFFFF, 1.0f, 4.0f);
+        Check(dc.Primitives().size() == 5,
+              "dx12 context: cross with no arm left draws nothing");
+
+        const OverlayPrimitive* storage = dc.Primitives().data();
+        dc.Reset(1280, 720);
+        Check(dc.Primitives().empty() && dc.Width() == 1280 && dc.Height() == 720, "dx12 context: reset clears");
+        for (int i = 0; i < 5; ++i) dc.DrawRect(0, 0, 1, 1, 0xFFFFFFFF);
+        Check(dc.Primitives().data() == storage, "dx12 context: storage reused across frames");
+
+        Check(DX12RingSegmentInstances(1) == 1024 && DX12RingSegmentInstances(1024) == 1024 &&
+                  DX12RingSegmentInstances(1025) == 2048,
+              "dx12 ring: segments round up to 1K instances");
+    }
+
+    {
+        Check(OverlayFontGlyphIndex(' ') == 1 && OverlayFontGlyphIndex('A') == 34 &&
+                  OverlayFontGlyphIndex('~') == 95 && OverlayFontGlyphIndex('\t') == OverlayFontGlyphIndex('?'),
+              "font: atlas cells follow ASCII, unprintables draw as '?'");
+
+        // 'I' is ".###." on its top row
+        const uint32_t I = OverlayFontGlyphIndex('I');
+        Check(!OverlayFontTexel(I, 0, 0) && OverlayFontTexel(I, 1, 0) && OverlayFontTexel(I, 2, 3) &&
+                  !OverlayFontTexel(I, 5, 0) && !OverlayFontTexel(I, 2, 7),
+              "font: texel lookup");
+        Check(OverlayFontTexel(kOverlayFontSolidGlyph, 0, 0) && OverlayFontTexel(kOverlayFontSolidGlyph, 4, 6) &&
+                  !OverlayFontTexel(kOverlayFontSolidGlyph, 5, 0),
+              "font: solid cell is lit inside the glyph box");
+
+        bool allInked = true;
+        for (char c = '!'; c <= '~'; ++c) {
+            bool lit = false;
+            for (int i = 0; i < 35; ++i) lit |= OverlayFontTexel(OverlayFontGlyphIndex(c), i % 5, i / 5);
+            allInked &= lit;
+        }
+        Check(allInked, "font: every printable glyph has ink");
+
+        int quads = 0;
+        OverlayGlyphQuad last = {};
+        const float width = LayoutOverlayText(10, 20, "A B\nCD", 2.0f, [&](const OverlayGlyphQuad& q) {
+            ++quads;
+            last = q;
+        });
+        Check(quads == 4 && Near(width, 36.0f) && Near(last.x, 22.0f) && Near(last.y, 38.0f) &&
+                  Near(last.w, 10.0f) && Near(last.h, 14.0f) && last.glyph == OverlayFontGlyphIndex('D'),
+              "font: layout advances, skips spaces and wraps on newline");
+        float w = 0.0f, h = 0.0f;
+        MeasureOverlayText("A B\nCD", 2.0f, &w, &h);
+        Check(Near(w, 36.0f) && Near(h, 32.0f), "font: measure matches layout");
+
+        const std::string hlsl = OverlayFontHLSL();
+        size_t entries = 0;
+        for (size_t at = hlsl.find("uint2(0x"); at != std::string::npos; at = hlsl.find("uint2(0x", at + 1)) ++entries;
+        Check(entries == kOverlayFontGlyphCount && hlsl.find("uint2(0xFFFFFFFFu,0x7u)") != std::string::npos,
+              "font: shader table has every cell, solid first");
+        Check(FindReservedHlslDeclaration("float2 p; float half = 1;") == "half" &&
+                  FindReservedHlslDeclaration("float halfWidth = i.half;").empty(),
+              "hlsl: reserved-word check finds declarations only");
+        Check(FindReservedHlslDeclaration(hlsl + kOverlayPrimitiveHLSL).empty(),
+              "hlsl: primitive shader declares no reserved names");
+
+        DX12DrawContext dc;
+        dc.Reset(640, 480);
+        dc.DrawString(8, 8, "I I", 0xFFFFFFFF, 3.0f);
+        const OverlayPrimitive& glyph = dc.Primitives()[0];
+        Check(dc.Primitives().size() == 2 && glyph.kind == OverlayPrimitiveKind::Glyph && BoundsCoverShape(glyph),
+              "glyph: one instance per visible character");
+        // Texel (1, 0) of 'I' is lit, (0, 0) is not; each texel is 3 px
+        Check(Near(OverlayPrimitiveCoverage(glyph, 8 + 4.5f, 8 + 1.5f), 1.0f) &&
+                  Near(OverlayPrimitiveCoverage(glyph, 8 + 1.5f, 8 + 1.5f), 0.0f) &&
+                  Near(OverlayPrimitiveCoverage(glyph, 8 + 16.5f, 8 + 1.5f), 0.0f),
+              "glyph: coverage follows the font texels");
+    }
+
+    {
+        OverlayTimingWindow window;
+        Check(window.Summarize().samples == 0 && window.Summarize().p99_us == 0.0f, "timing: empty window");
+
+        for (int i = 1; i <= 100; ++i) window.Record(static_cast<float>(i));
+        OverlayTimingSummary s = window.Summarize();
+        Check(s.samples == 100 && Near(s.min_us, 1.0f) && Near(s.avg_us, 50.5f) && Near(s.p99_us, 99.0f),
+              "timing: min/avg/p99 over a partial window");
+
+        // Overwrite the oldest samples once the ring is full
+        for (size_t i = 0; i < kOverlayTimingSamples; ++i) window.Record(7.0f);
+        s = window.Summarize();
+        Check(s.samples == kOverlayTimingSamples && Near(s.min_us, 7.0f) && Near(s.p99_us, 7.0f),
+              "timing: ring drops old samples");
+
+        window.Record(500.0f);
+        Check(Near(window.Summarize().p99_us, 7.0f), "timing: one outlier in 120 falls past p99");
+        window.Record(600.0f);
+        Check(Near(window.Summarize().p99_us, 500.0f), "timing: two outliers reach p99");
+    }
+
+    {
+        OverlayTimings timings;
+        timings.callback_cpu.Record(12.0f);
+        timings.upload_cpu.Record(3.4f);
+        char line[96];
+        const size_t len = FormatOverlayTimingLine(timings.Summarize(), line, sizeof(line));
+        Check(std::strcmp(line, "CPU 12/12/12 UP 3/3/3 GPU - US") == 0 && len == std::strlen(line),
+              "timing: stats line format");
+
+        char tiny[8];
+        const size_t cut = FormatOverlayTimingLine(timings.Summarize(), tiny, sizeof(tiny));
+        Check(cut == 7 && std::strlen(tiny) == 7, "timing: stats line truncates");
+
+        StatsLineRecorder recorder;
+        DrawOverlayTimingLine(recorder, timings.Summarize());
+        float textW = 0.0f, textH = 0.0f;
+        MeasureOverlayText(line, recorder.scale, &textW, &textH);
+        Check(recorder.strings == 1 && recorder.text == line && recorder.rects == 1 &&
+              Near(recorder.rectW, textW + 8.0f) && Near(recorder.rectH, textH + 8.0f),
+              "timing: stats line drawn as one string over a fitted backing");
+    }
+
+    {
+        GuiMarkerInput frame;
+        frame.yawDeg = 20.0f;
+        frame.pitchDeg = -8.0f;
+        frame.rollDeg = 5.0f;
+        frame.posX = 0.05f;
+        frame.fovDegY = 60.0f;
+
+        constexpr size_t kMarkers = 37;
+        float gx[kMarkers], gy[kMarkers], depth[kMarkers];
+        for (size_t i = 0; i < kMarkers; ++i) {
+            gx[i] = -900.0f + 50.0f * i;
+            gy[i] = 400.0f - 21.0f * i;
+            depth[i] = 0.5f + 0.25f * i;
+        }
+        depth[3] = -1.0f;  // behind the camera
+
+        float dx[kMarkers], dy[kMarkers];
+        uint8_t valid[kMarkers];
+        const GuiMarkerBatch batch(frame);
+        batch.Compute({gx, gy, depth}, kMarkers, {dx, dy, valid});
+
+        bool same = true;
+        for (size_t i = 0; i < kMarkers; ++i) {
+            GuiMarkerInput one = frame;
+            one.gxNative = gx[i];
+            one.gyNative = gy[i];
+            one.assumedDepth = depth[i];
+            const GuiMarkerResult r = ComputeGuiMarkerCompensation(one);
+            // The vectorized loop may round slightly differently from scalar code
+            same = same && r.valid == (valid[i] != 0) && Near(r.deltaX, dx[i], 1e-3f) && Near(r.deltaY, dy[i], 1e-3f);
+        }
+        Check(same && batch.IsValid(), "gui batch: matches the single-marker form");
+        Check(valid[3] == 0 && dx[3] == 0.0f && dy[3] == 0.0f, "gui batch: marker behind camera is invalid");
+
+        batch.Compute({gx, gy, nullptr}, kMarkers, {dx, dy, nullptr});
+        const GuiMarkerResult first = batch.Compute(gx[0], gy[0]);
+        Check(first.valid && Near(first.deltaX, dx[0], 1e-3f) && Near(first.deltaY, dy[0], 1e-3f),
+              "gui batch: null depth uses assumedDepth");
+
+        GuiMarkerInput still;
+        const GuiMarkerResult none = GuiMarkerBatch(still).Compute(300.0f, -200.0f);
+        Check(none.valid && Near(none.deltaX, 0.0f, 1e-3f) && Near(none.deltaY, 0.0f, 1e-3f),
+              "gui batch: no head motion, no delta");
+
+        GuiMarkerInput badFov;
+        badFov.fovDegY = 5.0f;
+        GuiMarkerBatch rejected(badFov);
+        rejected.Compute({gx, gy, nullptr}, kMarkers, {dx, dy, valid});
+        Check(!rejected.IsValid() && valid[0] == 0 && dx[0] == 0.0f, "gui batch: out-of-range FOV rejects all");
+    }
+
+    {
+        CrosshairProjectionParams params;
+        params.yawOffset = 25.0f;
+        params.pitchOffset = -12.0f;
+        params.rollOffset = 6.0f;
+        const FrameProjectionContext ctx = BuildFrameProjectionContext(params);
+
+        const ScreenPosition aim = ProjectCrosshair(ctx);
+        const ScreenPosition once = ProjectCrosshair(params);
+        Check(aim.valid && aim.x == once.x && aim.y == once.y, "projection: context and one-shot crosshair agree");
+
+        // Body aim is the native screen centre
+        const ScreenPosition centre = ProjectNativeScreenPoint(ctx, 960.0f, 540.0f);
+        Check(Near(centre.x, aim.x, 1e-2f) && Near(centre.y, aim.y, 1e-2f), "projection: native centre is body aim");
+
+        float dir[3];
+        UnprojectToDirection(ctx, 300.0f, 800.0f, dir);
+        const ScreenPosition back = ProjectDirection(ctx, dir);
+        Check(Near(back.x, 300.0f, 1e-2f) && Near(back.y, 800.0f, 1e-2f), "projection: unproject round-trips");
+
+        const FrameProjectionContext still = BuildFrameProjectionContext(CrosshairProjectionParams{});
+        const ScreenPosition same = ProjectNativeScreenPoint(still, 1500.0f, 100.0f);
+        Check(Near(same.x, 1500.0f, 1e-2f) && Near(same.y, 100.0f, 1e-2f), "projection: no head motion is identity");
+
+        CrosshairProjectionParams straightUp;
+        straightUp.pitchOffset = 90.0f;
+        const ScreenPosition up = ProjectNativeScreenPoint(BuildFrameProjectionContext(straightUp), 10.0f, 10.0f);
+        Check(up.valid && up.x == 960.0f && up.y == 540.0f, "projection: degenerate basis projects to centre");
+    }
+
+    return g_failures;
+}
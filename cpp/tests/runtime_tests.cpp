@@ -0,0 +1,375 @@
+// Thread scheduling and settings channel tests.
+//
+// Scheduling requests are best-effort and depend on OS privileges, so the
+// contract under test is the reporting: untouched settings say so, the
+// body runs on the configured thread, and a refusal is reported rather
+// than silently ignored. Starting a scheduled thread must not wait for it,
+// so the result reads as pending until the thread has applied it. The settings channel is hammered from a
+// publisher thread while the reader checks every snapshot is whole.
+// The shared Runtime is checked for what its clients rely on: timers and
+// posted work run on its thread, a socket wakes it, and Remove() returns
+// only once the callback can no longer run. The async log must format
+// deferred arguments exactly as printf would, keep each producer's lines
+// in order, and hold back a chatty call site. The SPSC queue must refuse
+// pushes when full and hand a consumer thread every item in order.
+
+#include "cameraunlock/config/config_watcher.h"
+#include "cameraunlock/diagnostics/async_log.h"
+#include "cameraunlock/protocol/udp_socket.h"
+#include "cameraunlock/runtime/runtime.h"
+#include "cameraunlock/runtime/settings_channel.h"
+#include "cameraunlock/runtime/spsc_queue.h"
+#include "cameraunlock/runtime/thread_scheduling.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int g_failures = 0;
+
+void Check(bool cond, const char* name) {
+    if (cond) {
+        std::cout << "  [PASS] " << name << "\n";
+    } else {
+        std::cout << "  [FAIL] " << name << "\n";
+        ++g_failures;
+    }
+}
+
+template <typename Pred>
+bool WaitFor(Pred pred, int timeoutMs) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (!pred()) {
+        if (std::chrono::steady_clock::now() > deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    return true;
+}
+
+struct LogCapture {
+    std::mutex mutex;
+    std::vector<std::string> lines;
+
+    static void Write(void* context, int, const char* message) {
+        auto* self = static_cast<LogCapture*>(context);
+        std::lock_guard<std::mutex> lock(self->mutex);
+        self->lines.emplace_back(message);
+    }
+};
+
+}  // namespace
+
+int RunRuntimeTests() {
+    using cameraunlock::SchedulingStatus;
+    using cameraunlock::StartScheduledThread;
+    using cameraunlock::ThreadPriority;
+    using cameraunlock::ThreadSchedulingOptions;
+    using cameraunlock::ThreadSchedulingResult;
+    using cameraunlock::ThreadSchedulingSlot;
+
+    std::cout << "Runtime tests\n";
+
+    {
+        std::atomic<bool> ran{false};
+        ThreadSchedulingSlot slot;
+        std::thread thread = StartScheduledThread({}, slot, [&] { ran.store(true); });
+        thread.join();
+        ThreadSchedulingResult result = slot.Get();
+        Check(ran.load(), "scheduled thread runs its body");
+        Check(result.priority == SchedulingStatus::NotRequested &&
+              result.affinity == SchedulingStatus::NotRequested &&
+              result.mmcss == SchedulingStatus::NotRequested && result.AllApplied(),
+              "default options request nothing");
+    }
+
+    {
+        ThreadSchedulingOptions options;
+        options.affinityMask = 1;
+        options.priority = ThreadPriority::TimeCritical;
+        options.mmcssTask = "Games";
+        ThreadSchedulingSlot slot;
+        std::atomic<bool> release{false};
+        std::thread thread = StartScheduledThread(options, slot, [&] {
+            while (!release.load()) std::this_thread::yield();
+        });
+        // Readable while the thread runs: each setting is pending or final,
+        // never reported as unrequested
+        ThreadSchedulingResult early = slot.Get();
+        Check(early.priority != SchedulingStatus::NotRequested &&
+              early.affinity != SchedulingStatus::NotRequested &&
+              early.mmcss != SchedulingStatus::NotRequested,
+              "result is readable while the thread runs");
+        release.store(true);
+        thread.join();
+        ThreadSchedulingResult result = slot.Get();
+        Check(!result.IsPending(), "result is final once the thread ran");
+        Check(result.affinity != SchedulingStatus::NotRequested &&
+              result.priority != SchedulingStatus::NotRequested &&
+              result.mmcss != SchedulingStatus::NotRequested,
+              "every requested setting reports an outcome");
+#ifndef _WIN32
+        Check(result.mmcss == SchedulingStatus::Unsupported, "MMCSS reports unsupported off Windows");
+        Check(result.priority != SchedulingStatus::Superseded,
+              "priority is applied when MMCSS is unavailable");
+#endif
+    }
+
+    {
+        ThreadSchedulingOptions options;
+        options.priority = ThreadPriority::Highest;
+        options.affinityMask = 1;
+        ThreadSchedulingSlot slot;
+        slot.Reset(options);
+        ThreadSchedulingResult pending = slot.Get();
+        Check(pending.IsPending() && !pending.AllApplied() &&
+              pending.priority == SchedulingStatus::Pending &&
+              pending.affinity == SchedulingStatus::Pending &&
+              pending.mmcss == SchedulingStatus::NotRequested,
+              "unapplied settings read as pending");
+    }
+
+    // Settings channel: torn-free snapshots under concurrent publishing
+    {
+        struct Snapshot {
+            uint64_t a = 0;
+            uint64_t b = 0;
+            uint64_t c = 0;
+        };
+        cameraunlock::SettingsChannel<Snapshot> channel;
+        const uint64_t kPublishes = 20000;
+
+        std::atomic<bool> done{false};
+        std::thread publisher([&] {
+            for (uint64_t i = 1; i <= kPublishes; ++i) {
+                channel.Publish(Snapshot{i, i * 2, i * 3});
+            }
+            done.store(true);
+        });
+
+        uint64_t seen = 0;
+        Snapshot snap;
+        bool consistent = true;
+        bool monotonic = true;
+        while (!done.load() || channel.GetVersion() != seen) {
+            uint64_t previous = seen;
+            if (channel.ReadIfChanged(seen, snap)) {
+                consistent = consistent && snap.b == snap.a * 2 && snap.c == snap.a * 3;
+                monotonic = monotonic && seen > previous;
+            }
+        }
+        publisher.join();
+
+        Check(consistent, "settings channel: snapshots are never torn");
+        Check(monotonic, "settings channel: versions only move forward");
+        Check(snap.a == kPublishes, "settings channel: reader ends on latest");
+        Check(!channel.ReadIfChanged(seen, snap), "settings channel: unchanged read is a no-op");
+        Check(channel.GetRetiredCount() <= 1, "settings channel: retired snapshots reclaimed");
+    }
+
+    // SPSC queue: bounded, FIFO, and whole items across threads
+    {
+        struct Item {
+            uint64_t a = 0;
+            uint64_t b = 0;
+        };
+        cameraunlock::SpscQueue<Item, 8> queue;
+        Item item;
+        Check(!queue.TryPop(item), "spsc queue: starts empty");
+        bool pushed = true;
+        for (uint64_t i = 0; i < 8; ++i) pushed = pushed && queue.TryPush(Item{i, 0});
+        Check(pushed && !queue.TryPush(Item{99, 0}) && queue.GetSize() == 8, "spsc queue: full push refused");
+        Check(queue.TryPop(item) && item.a == 0 && queue.TryPush(Item{8, 0}), "spsc queue: pop frees a slot");
+        queue.Clear();
+        Check(queue.GetSize() == 0 && !queue.TryPop(item), "spsc queue: clear drops pending items");
+
+        const uint64_t kItems = 200000;
+        std::thread producer([&] {
+            for (uint64_t i = 1; i <= kItems; ++i) {
+                while (!queue.TryPush(Item{i, i * 3})) std::this_thread::yield();
+            }
+        });
+        uint64_t expected = 1;
+        bool ordered = true;
+        while (expected <= kItems) {
+            if (!queue.TryPop(item)) {
+                std::this_thread::yield();
+                continue;
+            }
+            ordered = ordered && item.a == expected && item.b == expected * 3;
+            ++expected;
+        }
+        producer.join();
+        Check(ordered, "spsc queue: consumer sees every item whole and in order");
+    }
+
+    // Shared runtime: timers, posted work, sockets and synchronous removal
+    {
+        using cameraunlock::Runtime;
+
+        Runtime runtime;
+        std::atomic<int> early{0};
+        runtime.AddTimer(0, 0, [&] { early.fetch_add(1); });
+        Check(runtime.Start() && runtime.IsRunning(), "runtime starts");
+        Check(WaitFor([&] { return early.load() == 1; }, 1000), "timer added before Start fires");
+
+        std::atomic<bool> onThread{false};
+        runtime.Call([&] { onThread.store(runtime.IsRuntimeThread()); });
+        Check(onThread.load() && !runtime.IsRuntimeThread(), "Call runs on the runtime thread");
+        Check(runtime.GetRegistrationCount() == 0, "one-shot timer unregisters itself");
+
+        std::atomic<int> ticks{0};
+        const int periodic = runtime.AddTimer(5, 5, [&] { ticks.fetch_add(1); });
+        Check(WaitFor([&] { return ticks.load() >= 3; }, 2000), "periodic timer repeats");
+        runtime.Remove(periodic);
+        const int afterRemove = ticks.load();
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        Check(ticks.load() == afterRemove, "Remove is synchronous");
+
+        std::atomic<bool> posted{false};
+        runtime.Post([&] { posted.store(runtime.IsRuntimeThread()); });
+        Check(WaitFor([&] { return posted.load(); }, 1000), "posted work runs on the runtime thread");
+
+        using cameraunlock::UdpSocket;
+        UdpSocket receiver;
+        UdpSocket sender;
+        sockaddr_in addr = {};
+#ifdef _WIN32
+        int addrLen = sizeof(addr);
+#else
+        socklen_t addrLen = sizeof(addr);
+#endif
+        bool opened = receiver.Open(0) && sender.Open(0) &&
+            getsockname(receiver.GetHandle(), reinterpret_cast<sockaddr*>(&addr), &addrLen) == 0;
+        std::atomic<int> datagrams{0};
+        const int source = opened ? runtime.AddSocket(receiver.GetHandle(), [&] {
+            char buffer[16];
+            sockaddr_in from = {};
+            int64_t arrivalUs = 0;
+            while (receiver.ReceiveTimestamped(buffer, sizeof(buffer), from, arrivalUs) != SOCKET_ERROR) {
+                datagrams.fetch_add(1);
+            }
+        }) : 0;
+        Check(source != 0, "socket registers with the runtime");
+        if (source != 0) {
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            const char payload[4] = {1, 2, 3, 4};
+            for (int i = 0; i < 2; ++i) {
+                sendto(sender.GetHandle(), payload, sizeof(payload), 0,
+                       reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+            }
+            Check(WaitFor([&] { return datagrams.load() == 2; }, 2000), "readable socket wakes the runtime");
+            runtime.Remove(source);
+        }
+
+        // Watcher on the runtime instead of its own thread
+        const char* path = "cameraunlock_test_runtime.ini";
+        FILE* file = fopen(path, "wb");
+        if (file) {
+            fputs("[General]\nPort=1\n", file);
+            fclose(file);
+        }
+        std::atomic<int> port{0};
+        cameraunlock::ConfigWatcher watcher;
+        const bool watching = watcher.Start(runtime, path, [&](const cameraunlock::IniReader& ini) {
+            port.store(ini.ReadInt("General", "Port"));
+        }, 50);
+        Check(watching && watcher.IsRunning(), "watcher starts on the runtime");
+        file = fopen(path, "wb");
+        if (file) {
+            fputs("[General]\nPort=7\n", file);
+            fclose(file);
+        }
+        Check(WaitFor([&] { return port.load() == 7; }, 3000), "runtime watcher reloads");
+        watcher.Stop();
+        std::remove(path);
+
+        Check(runtime.GetRegistrationCount() == 0, "clients unregister on Stop");
+        runtime.Stop();
+        Check(!runtime.IsRunning(), "runtime stops");
+    }
+
+    // Async log: deferred formatting, per-thread order, per-site limits
+    {
+        using cameraunlock::AsyncLog;
+
+        LogCapture capture;
+        char expected[256];
+        void* ptr = &capture;
+        snprintf(expected, sizeof(expected), "%d %u %5.2f %s %p 0x%llX [%*s] %zu %c %% %+.0f",
+                 -7, 42u, 3.14159, "text", ptr, 0xABCDull, 6, "pad", size_t{9}, 'q', 12.6);
+        AsyncLog::Write(&LogCapture::Write, &capture, 0, "%d %u %5.2f %s %p 0x%llX [%*s] %zu %c %% %+.0f",
+                        -7, 42u, 3.14159, "text", ptr, 0xABCDull, 6, "pad", size_t{9}, 'q', 12.6f);
+
+        char scratch[16];
+        std::strcpy(scratch, "before");
+        AsyncLog::Write(&LogCapture::Write, &capture, 0, "copied %s / %s", scratch, std::string("owned"));
+        std::strcpy(scratch, "after");
+        AsyncLog::Flush();
+        {
+            std::lock_guard<std::mutex> lock(capture.mutex);
+            Check(capture.lines.size() == 2 && capture.lines[0] == expected, "async log formats like printf");
+            Check(capture.lines.size() == 2 && capture.lines[1] == "copied before / owned",
+                  "async log copies string arguments");
+            capture.lines.clear();
+        }
+
+        const int kThreads = 4;
+        const int kPerThread = 15;
+        std::vector<std::thread> producers;
+        for (int t = 0; t < kThreads; ++t) {
+            producers.emplace_back([&capture, t] {
+                for (int i = 0; i < kPerThread; ++i) {
+                    AsyncLog::Write(&LogCapture::Write, &capture, 0, "thread %d line %d", t, i);
+                }
+            });
+        }
+        for (auto& producer : producers) producer.join();
+        AsyncLog::Flush();
+        {
+            std::lock_guard<std::mutex> lock(capture.mutex);
+            bool ordered = capture.lines.size() == static_cast<size_t>(kThreads * kPerThread);
+            int next[kThreads] = {};
+            for (const std::string& line : capture.lines) {
+                int t = -1;
+                int i = -1;
+                ordered = ordered && sscanf(line.c_str(), "thread %d line %d", &t, &i) == 2 &&
+                          t >= 0 && t < kThreads && i == next[t]++;
+            }
+            Check(ordered, "async log keeps each producer's lines in order");
+            capture.lines.clear();
+        }
+
+        // One call site: the format pointer is what identifies it
+        const char* const chatty = "chatty %d";
+        const uint64_t suppressedBefore = AsyncLog::GetSuppressedCount();
+        for (int i = 0; i < 50; ++i) {
+            AsyncLog::Write(&LogCapture::Write, &capture, 0, chatty, i);
+        }
+        AsyncLog::Flush();
+        {
+            std::lock_guard<std::mutex> lock(capture.mutex);
+            Check(capture.lines.size() == AsyncLog::kSiteBurst &&
+                  AsyncLog::GetSuppressedCount() - suppressedBefore == 50 - AsyncLog::kSiteBurst,
+                  "async log rate-limits a call site");
+            capture.lines.clear();
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(AsyncLog::kSiteWindowMs + 50));
+        AsyncLog::Write(&LogCapture::Write, &capture, 0, chatty, 50);
+        AsyncLog::Flush();
+        {
+            std::lock_guard<std::mutex> lock(capture.mutex);
+            Check(capture.lines.size() == 1 && capture.lines[0] == "chatty 50 [30 similar suppressed]",
+                  "suppressed count is reported on the site's next line");
+        }
+    }
+
+    return g_failures;
+}
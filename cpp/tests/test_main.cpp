@@ -1,6 +1,19 @@
 #include <iostream>
 
+int RunConfigTests();
+int RunDataTests();
+int RunDiscoveryTests();
+int RunHooksTests();
+int RunInputTests();
+int RunMathTests();
+int RunMemoryTests();
 int RunProtocolTests();
+int RunProcessingTests();
+int RunRenderingTests();
+int RunRuntimeTests();
+#ifdef CAMERAUNLOCK_TEST_CAPI
+int RunCapiTests();
+#endif
 
 // Simple test runner - expand with a proper framework if needed
 int main() {
@@ -8,7 +21,20 @@ int main() {
     std::cout << "=====================\n";
 
     int failures = 0;
+    failures += RunConfigTests();
+    failures += RunDataTests();
+    failures += RunDiscoveryTests();
+    failures += RunHooksTests();
+    failures += RunInputTests();
+    failures += RunMathTests();
+    failures += RunMemoryTests();
     failures += RunProtocolTests();
+    failures += RunProcessingTests();
+    failures += RunRenderingTests();
+    failures += RunRuntimeTests();
+#ifdef CAMERAUNLOCK_TEST_CAPI
+    failures += RunCapiTests();
+#endif
 
     if (failures == 0) {
         std::cout << "All tests passed!\n";